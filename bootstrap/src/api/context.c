@@ -3,38 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 
-static void *vitte_default_alloc(void *user, size_t size) {
-    (void)user;
-    return malloc(size == 0u ? 1u : size);
-}
-
-static void *vitte_default_realloc(void *user, void *pointer, size_t size) {
-    (void)user;
-    return realloc(pointer, size == 0u ? 1u : size);
-}
-
-static void vitte_default_free(void *user, void *pointer) {
-    (void)user;
-    free(pointer);
-}
-
-void vitte_allocator_default(vitte_allocator_t *allocator) {
-    if (allocator == NULL) {
-        return;
-    }
-
-    allocator->user = NULL;
-    allocator->alloc = vitte_default_alloc;
-    allocator->realloc = vitte_default_realloc;
-    allocator->free = vitte_default_free;
-}
-
-bool vitte_allocator_is_valid(const vitte_allocator_t *allocator) {
-    return allocator != NULL &&
-        allocator->alloc != NULL &&
-        allocator->realloc != NULL &&
-        allocator->free != NULL;
-}
+#include "../intern/intern.h"
 
 void *vitte_context_alloc(vitte_context_t *context, size_t size) {
     if (context == NULL || !vitte_allocator_is_valid(&context->allocator)) {
@@ -77,6 +46,7 @@ vitte_status_t vitte_context_init(
     const vitte_api_config_t *config
 ) {
     vitte_api_config_t defaults;
+    vitte_allocator_t interner_allocator;
 
     if (context == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
@@ -107,6 +77,35 @@ vitte_status_t vitte_context_init(
     context->sysroot_path = config->sysroot_path;
     vitte_error_init(&context->last_error);
 
+    if (vitte_memory_account_init(&context->memory, &context->allocator) != VITTE_STATUS_OK) {
+        context->initialized = false;
+        vitte_error_set(
+            &context->last_error,
+            VITTE_STATUS_ERROR_INTERNAL,
+            "VITTE_API_E_MEMORY",
+            "failed to initialize memory accounting"
+        );
+        return VITTE_STATUS_ERROR_INTERNAL;
+    }
+
+    vitte_context_tagged_allocator(context, VITTE_MEMORY_INTERNER, &interner_allocator);
+    context->interner = (vitte_interner_t *)interner_allocator.alloc(interner_allocator.user, sizeof(*context->interner));
+    if (context->interner == NULL || vitte_interner_init(context->interner, &interner_allocator) != VITTE_STATUS_OK) {
+        if (context->interner != NULL) {
+            interner_allocator.free(interner_allocator.user, context->interner);
+        }
+        context->interner = NULL;
+        vitte_memory_account_destroy(&context->memory);
+        context->initialized = false;
+        vitte_error_set(
+            &context->last_error,
+            VITTE_STATUS_ERROR_OUT_OF_MEMORY,
+            "VITTE_API_E_INTERNER",
+            "failed to initialize identifier interner"
+        );
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+
     return VITTE_STATUS_OK;
 }
 
@@ -161,6 +160,14 @@ void vitte_context_destroy(vitte_context_t *context) {
 
     owns_context = context->owns_context;
     allocator = context->allocator;
+    if (context->interner != NULL) {
+        vitte_allocator_t interner_allocator;
+
+        vitte_context_tagged_allocator(context, VITTE_MEMORY_INTERNER, &interner_allocator);
+        vitte_interner_destroy(context->interner);
+        interner_allocator.free(interner_allocator.user, context->interner);
+    }
+    vitte_memory_account_destroy(&context->memory);
     memset(context, 0, sizeof(*context));
 
     if (owns_context && vitte_allocator_is_valid(&allocator)) {
@@ -188,6 +195,51 @@ const vitte_allocator_t *vitte_context_allocator_const(const vitte_context_t *co
     return context != NULL ? &context->allocator : NULL;
 }
 
+vitte_interner_t *vitte_context_interner(vitte_context_t *context) {
+    return context != NULL ? context->interner : NULL;
+}
+
+vitte_status_t vitte_context_reset_interner(vitte_context_t *context) {
+    vitte_allocator_t interner_allocator;
+    vitte_interner_t *fresh;
+
+    if (!vitte_context_is_initialized(context) || context->interner == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_STATE;
+    }
+    /* The new interner is built first, so a failure keeps the old one usable. */
+    vitte_context_tagged_allocator(context, VITTE_MEMORY_INTERNER, &interner_allocator);
+    fresh = (vitte_interner_t *)interner_allocator.alloc(interner_allocator.user, sizeof(*fresh));
+    if (fresh == NULL || vitte_interner_init(fresh, &interner_allocator) != VITTE_STATUS_OK) {
+        if (fresh != NULL) {
+            interner_allocator.free(interner_allocator.user, fresh);
+        }
+        vitte_context_set_error(
+            context,
+            VITTE_STATUS_ERROR_OUT_OF_MEMORY,
+            "VITTE_API_E_INTERNER",
+            "failed to initialize identifier interner",
+            NULL
+        );
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    vitte_interner_destroy(context->interner);
+    interner_allocator.free(interner_allocator.user, context->interner);
+    context->interner = fresh;
+    return VITTE_STATUS_OK;
+}
+
+vitte_memory_account_t *vitte_context_memory(vitte_context_t *context) {
+    return context != NULL && context->initialized ? &context->memory : NULL;
+}
+
+void vitte_context_tagged_allocator(
+    vitte_context_t *context,
+    vitte_memory_subsystem_t subsystem,
+    vitte_allocator_t *allocator
+) {
+    vitte_memory_account_allocator(vitte_context_memory(context), subsystem, allocator);
+}
+
 const vitte_error_t *vitte_context_last_error(const vitte_context_t *context) {
     return context != NULL ? &context->last_error : vitte_error_last();
 }
@@ -5,22 +5,12 @@
 #include <stddef.h>
 
 #include "error.h"
+#include "memory.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-typedef void *(*vitte_alloc_fn)(void *user, size_t size);
-typedef void *(*vitte_realloc_fn)(void *user, void *pointer, size_t size);
-typedef void (*vitte_free_fn)(void *user, void *pointer);
-
-typedef struct vitte_allocator {
-    void *user;
-    vitte_alloc_fn alloc;
-    vitte_realloc_fn realloc;
-    vitte_free_fn free;
-} vitte_allocator_t;
-
 typedef struct vitte_api_config {
     vitte_allocator_t allocator;
     const char *root_path;
@@ -28,6 +18,8 @@ typedef struct vitte_api_config {
     bool deterministic;
 } vitte_api_config_t;
 
+struct vitte_interner;
+
 typedef struct vitte_context {
     bool initialized;
     bool owns_context;
@@ -36,11 +28,11 @@ typedef struct vitte_context {
     vitte_error_t last_error;
     const char *root_path;
     const char *sysroot_path;
+    struct vitte_interner *interner;
+    /* Tagged allocators point into this, so a context must not be moved. */
+    vitte_memory_account_t memory;
 } vitte_context_t;
 
-void vitte_allocator_default(vitte_allocator_t *allocator);
-bool vitte_allocator_is_valid(const vitte_allocator_t *allocator);
-
 void *vitte_context_alloc(vitte_context_t *context, size_t size);
 void *vitte_context_realloc(vitte_context_t *context, void *pointer, size_t size);
 void vitte_context_free(vitte_context_t *context, void *pointer);
@@ -64,6 +56,20 @@ bool vitte_context_is_initialized(const vitte_context_t *context);
 
 vitte_allocator_t *vitte_context_allocator(vitte_context_t *context);
 const vitte_allocator_t *vitte_context_allocator_const(const vitte_context_t *context);
+struct vitte_interner *vitte_context_interner(vitte_context_t *context);
+/*
+ * Replaces the interner with an empty one, freeing every interned string;
+ * on failure the old one stays in place. Only for callers that know nothing
+ * still points into it, such as a compile server between requests.
+ */
+vitte_status_t vitte_context_reset_interner(vitte_context_t *context);
+vitte_memory_account_t *vitte_context_memory(vitte_context_t *context);
+/* An allocator over the context's that charges `subsystem`; the default one for NULL. */
+void vitte_context_tagged_allocator(
+    vitte_context_t *context,
+    vitte_memory_subsystem_t subsystem,
+    vitte_allocator_t *allocator
+);
 
 const vitte_error_t *vitte_context_last_error(const vitte_context_t *context);
 void vitte_context_set_error(
@@ -0,0 +1,288 @@
+#if defined(__unix__) || defined(__APPLE__)
+/* getrusage is POSIX, not C17. */
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "memory.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+/* Tagged allocations carry their size so free and realloc can uncharge it. */
+typedef union vitte_memory_header {
+    size_t size;
+    max_align_t align;
+} vitte_memory_header_t;
+
+static const char *const vitte_memory_subsystem_names[VITTE_MEMORY_SUBSYSTEM_COUNT] = {
+    "source",
+    "tokens",
+    "ast",
+    "modules",
+    "sema",
+    "hir",
+    "ir",
+    "interner",
+    "driver"
+};
+
+static void *vitte_default_alloc(void *user, size_t size) {
+    (void)user;
+    return malloc(size == 0u ? 1u : size);
+}
+
+static void *vitte_default_realloc(void *user, void *pointer, size_t size) {
+    (void)user;
+    return realloc(pointer, size == 0u ? 1u : size);
+}
+
+static void vitte_default_free(void *user, void *pointer) {
+    (void)user;
+    free(pointer);
+}
+
+void vitte_allocator_default(vitte_allocator_t *allocator) {
+    if (allocator == NULL) {
+        return;
+    }
+
+    allocator->user = NULL;
+    allocator->alloc = vitte_default_alloc;
+    allocator->realloc = vitte_default_realloc;
+    allocator->free = vitte_default_free;
+}
+
+bool vitte_allocator_is_valid(const vitte_allocator_t *allocator) {
+    return allocator != NULL &&
+        allocator->alloc != NULL &&
+        allocator->realloc != NULL &&
+        allocator->free != NULL;
+}
+
+const char *vitte_memory_subsystem_name(vitte_memory_subsystem_t subsystem) {
+    return (size_t)subsystem < VITTE_MEMORY_SUBSYSTEM_COUNT ? vitte_memory_subsystem_names[subsystem] : "unknown";
+}
+
+static void vitte_memory_stats_add(vitte_memory_stats_t *stats, size_t bytes_reserved, size_t bytes_used) {
+    stats->bytes_reserved += bytes_reserved;
+    stats->bytes_used += bytes_used;
+    if (stats->bytes_reserved > stats->peak_bytes_reserved) {
+        stats->peak_bytes_reserved = stats->bytes_reserved;
+    }
+    if (stats->bytes_used > stats->peak_bytes_used) {
+        stats->peak_bytes_used = stats->bytes_used;
+    }
+}
+
+static void vitte_memory_stats_remove(vitte_memory_stats_t *stats, size_t bytes_reserved, size_t bytes_used) {
+    stats->bytes_reserved -= bytes_reserved < stats->bytes_reserved ? bytes_reserved : stats->bytes_reserved;
+    stats->bytes_used -= bytes_used < stats->bytes_used ? bytes_used : stats->bytes_used;
+}
+
+void vitte_memory_account_charge(
+    vitte_memory_account_t *account,
+    vitte_memory_subsystem_t subsystem,
+    size_t bytes_reserved,
+    size_t bytes_used
+) {
+    if (account == NULL || !account->initialized || (size_t)subsystem >= VITTE_MEMORY_SUBSYSTEM_COUNT) {
+        return;
+    }
+    vitte_parallel_mutex_lock(&account->lock);
+    vitte_memory_stats_add(&account->subsystems[subsystem], bytes_reserved, bytes_used);
+    vitte_memory_stats_add(&account->total, bytes_reserved, bytes_used);
+    if (bytes_reserved != 0u) {
+        account->subsystems[subsystem].allocation_count++;
+        account->total.allocation_count++;
+    }
+    vitte_parallel_mutex_unlock(&account->lock);
+}
+
+void vitte_memory_account_release(
+    vitte_memory_account_t *account,
+    vitte_memory_subsystem_t subsystem,
+    size_t bytes_reserved,
+    size_t bytes_used
+) {
+    if (account == NULL || !account->initialized || (size_t)subsystem >= VITTE_MEMORY_SUBSYSTEM_COUNT) {
+        return;
+    }
+    vitte_parallel_mutex_lock(&account->lock);
+    vitte_memory_stats_remove(&account->subsystems[subsystem], bytes_reserved, bytes_used);
+    vitte_memory_stats_remove(&account->total, bytes_reserved, bytes_used);
+    vitte_parallel_mutex_unlock(&account->lock);
+}
+
+static void *vitte_memory_tagged_alloc(void *user, size_t size) {
+    vitte_memory_tag_t *tag = (vitte_memory_tag_t *)user;
+    vitte_allocator_t *base = &tag->account->base;
+    vitte_memory_header_t *header;
+
+    if (size > SIZE_MAX - sizeof(*header)) {
+        return NULL;
+    }
+    header = (vitte_memory_header_t *)base->alloc(base->user, sizeof(*header) + size);
+    if (header == NULL) {
+        return NULL;
+    }
+    header->size = size;
+    vitte_memory_account_charge(tag->account, tag->subsystem, size, tag->counts_used ? size : 0u);
+    return header + 1;
+}
+
+static void vitte_memory_tagged_free(void *user, void *pointer) {
+    vitte_memory_tag_t *tag = (vitte_memory_tag_t *)user;
+    vitte_allocator_t *base = &tag->account->base;
+    vitte_memory_header_t *header;
+
+    if (pointer == NULL) {
+        return;
+    }
+    header = (vitte_memory_header_t *)pointer - 1;
+    vitte_memory_account_release(tag->account, tag->subsystem, header->size, tag->counts_used ? header->size : 0u);
+    base->free(base->user, header);
+}
+
+static void *vitte_memory_tagged_realloc(void *user, void *pointer, size_t size) {
+    vitte_memory_tag_t *tag = (vitte_memory_tag_t *)user;
+    vitte_allocator_t *base = &tag->account->base;
+    vitte_memory_header_t *header;
+    size_t old_size;
+
+    if (pointer == NULL) {
+        return vitte_memory_tagged_alloc(user, size);
+    }
+    if (size > SIZE_MAX - sizeof(*header)) {
+        return NULL;
+    }
+    header = (vitte_memory_header_t *)pointer - 1;
+    old_size = header->size;
+    header = (vitte_memory_header_t *)base->realloc(base->user, header, sizeof(*header) + size);
+    if (header == NULL) {
+        return NULL;
+    }
+    header->size = size;
+    vitte_memory_account_release(tag->account, tag->subsystem, old_size, tag->counts_used ? old_size : 0u);
+    vitte_memory_account_charge(tag->account, tag->subsystem, size, tag->counts_used ? size : 0u);
+    return header + 1;
+}
+
+vitte_status_t vitte_memory_account_init(vitte_memory_account_t *account, const vitte_allocator_t *base) {
+    size_t index;
+    vitte_status_t status;
+
+    if (account == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    memset(account, 0, sizeof(*account));
+    if (base != NULL && vitte_allocator_is_valid(base)) {
+        account->base = *base;
+    } else {
+        vitte_allocator_default(&account->base);
+    }
+    for (index = 0u; index < VITTE_MEMORY_SUBSYSTEM_COUNT; index++) {
+        account->tags[index].account = account;
+        account->tags[index].subsystem = (vitte_memory_subsystem_t)index;
+        account->tags[index].counts_used = true;
+        account->block_tags[index] = account->tags[index];
+        account->block_tags[index].counts_used = false;
+    }
+    status = vitte_parallel_mutex_init(&account->lock);
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
+    account->initialized = true;
+    return VITTE_STATUS_OK;
+}
+
+void vitte_memory_account_destroy(vitte_memory_account_t *account) {
+    if (account == NULL || !account->initialized) {
+        return;
+    }
+    vitte_parallel_mutex_destroy(&account->lock);
+    memset(account, 0, sizeof(*account));
+}
+
+void vitte_memory_account_allocator(
+    vitte_memory_account_t *account,
+    vitte_memory_subsystem_t subsystem,
+    vitte_allocator_t *allocator
+) {
+    if (allocator == NULL) {
+        return;
+    }
+    if (account == NULL || !account->initialized || (size_t)subsystem >= VITTE_MEMORY_SUBSYSTEM_COUNT) {
+        vitte_allocator_default(allocator);
+        return;
+    }
+    allocator->user = &account->tags[subsystem];
+    allocator->alloc = vitte_memory_tagged_alloc;
+    allocator->realloc = vitte_memory_tagged_realloc;
+    allocator->free = vitte_memory_tagged_free;
+}
+
+vitte_memory_tag_t *vitte_memory_block_allocator(
+    const vitte_allocator_t *allocator,
+    vitte_allocator_t *block_allocator
+) {
+    vitte_memory_tag_t *tag;
+
+    if (allocator == NULL || block_allocator == NULL) {
+        return NULL;
+    }
+    *block_allocator = *allocator;
+    if (allocator->alloc != vitte_memory_tagged_alloc) {
+        return NULL;
+    }
+    tag = (vitte_memory_tag_t *)allocator->user;
+    tag = &tag->account->block_tags[tag->subsystem];
+    block_allocator->user = tag;
+    return tag;
+}
+
+void vitte_memory_account_snapshot(
+    vitte_memory_account_t *account,
+    vitte_memory_stats_t *subsystems,
+    vitte_memory_stats_t *total
+) {
+    if (subsystems != NULL) {
+        memset(subsystems, 0, VITTE_MEMORY_SUBSYSTEM_COUNT * sizeof(*subsystems));
+    }
+    if (total != NULL) {
+        memset(total, 0, sizeof(*total));
+    }
+    if (account == NULL || !account->initialized) {
+        return;
+    }
+    vitte_parallel_mutex_lock(&account->lock);
+    if (subsystems != NULL) {
+        memcpy(subsystems, account->subsystems, sizeof(account->subsystems));
+    }
+    if (total != NULL) {
+        *total = account->total;
+    }
+    vitte_parallel_mutex_unlock(&account->lock);
+}
+
+size_t vitte_memory_peak_rss_bytes(void) {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0 || usage.ru_maxrss < 0) {
+        return 0u;
+    }
+#if defined(__APPLE__)
+    return (size_t)usage.ru_maxrss;
+#else
+    /* Linux and the BSDs report kilobytes. */
+    return (size_t)usage.ru_maxrss * 1024u;
+#endif
+#else
+    return 0u;
+#endif
+}
@@ -0,0 +1,131 @@
+#ifndef VITTE_BOOTSTRAP_API_MEMORY_H
+#define VITTE_BOOTSTRAP_API_MEMORY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "error.h"
+#include "../parallel/parallel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void *(*vitte_alloc_fn)(void *user, size_t size);
+typedef void *(*vitte_realloc_fn)(void *user, void *pointer, size_t size);
+typedef void (*vitte_free_fn)(void *user, void *pointer);
+
+typedef struct vitte_allocator {
+    void *user;
+    vitte_alloc_fn alloc;
+    vitte_realloc_fn realloc;
+    vitte_free_fn free;
+} vitte_allocator_t;
+
+/* Who owns a byte, for --mem-stats. */
+typedef enum vitte_memory_subsystem {
+    VITTE_MEMORY_SOURCE = 0,
+    VITTE_MEMORY_TOKENS,
+    VITTE_MEMORY_AST,
+    VITTE_MEMORY_MODULES,
+    VITTE_MEMORY_SEMA,
+    VITTE_MEMORY_HIR,
+    VITTE_MEMORY_IR,
+    VITTE_MEMORY_INTERNER,
+    VITTE_MEMORY_DRIVER,
+    VITTE_MEMORY_SUBSYSTEM_COUNT
+} vitte_memory_subsystem_t;
+
+/*
+ * `bytes_reserved` is what the subsystem holds from the system allocator (or
+ * has mapped); `bytes_used` is the part of it handed out to callers. The two
+ * only differ for arenas.
+ */
+typedef struct vitte_memory_stats {
+    size_t bytes_reserved;
+    size_t peak_bytes_reserved;
+    size_t bytes_used;
+    size_t peak_bytes_used;
+    size_t allocation_count;
+} vitte_memory_stats_t;
+
+struct vitte_memory_account;
+
+/* The `user` of a tagged allocator. */
+typedef struct vitte_memory_tag {
+    struct vitte_memory_account *account;
+    vitte_memory_subsystem_t subsystem;
+    /* False for arena blocks: the arena reports how much of them is used. */
+    bool counts_used;
+} vitte_memory_tag_t;
+
+/* Per-subsystem counters over one base allocator; safe to share across threads. */
+typedef struct vitte_memory_account {
+    bool initialized;
+    vitte_allocator_t base;
+    vitte_memory_tag_t tags[VITTE_MEMORY_SUBSYSTEM_COUNT];
+    vitte_memory_tag_t block_tags[VITTE_MEMORY_SUBSYSTEM_COUNT];
+    vitte_memory_stats_t subsystems[VITTE_MEMORY_SUBSYSTEM_COUNT];
+    vitte_memory_stats_t total;
+    vitte_parallel_mutex_t lock;
+} vitte_memory_account_t;
+
+void vitte_allocator_default(vitte_allocator_t *allocator);
+bool vitte_allocator_is_valid(const vitte_allocator_t *allocator);
+
+const char *vitte_memory_subsystem_name(vitte_memory_subsystem_t subsystem);
+
+vitte_status_t vitte_memory_account_init(vitte_memory_account_t *account, const vitte_allocator_t *base);
+void vitte_memory_account_destroy(vitte_memory_account_t *account);
+
+/*
+ * Fills `allocator` with one that draws from the account's base allocator and
+ * charges `subsystem`. A NULL or uninitialized account yields the default
+ * allocator, so callers need not care whether accounting is on.
+ */
+void vitte_memory_account_allocator(
+    vitte_memory_account_t *account,
+    vitte_memory_subsystem_t subsystem,
+    vitte_allocator_t *allocator
+);
+
+/*
+ * For arenas: returns the tag behind a tagged `allocator` and fills
+ * `block_allocator` with its reserve-only sibling, so block memory counts as
+ * reserved and the arena reports its own use. Returns NULL (and copies the
+ * allocator) for any other allocator.
+ */
+vitte_memory_tag_t *vitte_memory_block_allocator(
+    const vitte_allocator_t *allocator,
+    vitte_allocator_t *block_allocator
+);
+
+/* For memory that does not come from an allocator, such as mapped files. */
+void vitte_memory_account_charge(
+    vitte_memory_account_t *account,
+    vitte_memory_subsystem_t subsystem,
+    size_t bytes_reserved,
+    size_t bytes_used
+);
+void vitte_memory_account_release(
+    vitte_memory_account_t *account,
+    vitte_memory_subsystem_t subsystem,
+    size_t bytes_reserved,
+    size_t bytes_used
+);
+
+/* Copies the counters; `subsystems` may be NULL. */
+void vitte_memory_account_snapshot(
+    vitte_memory_account_t *account,
+    vitte_memory_stats_t *subsystems,
+    vitte_memory_stats_t *total
+);
+
+/* Peak resident set size of the process in bytes, or 0 when unknown. */
+size_t vitte_memory_peak_rss_bytes(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VITTE_BOOTSTRAP_API_MEMORY_H */
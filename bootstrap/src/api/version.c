@@ -1,5 +1,15 @@
 #include "version.h"
 
+#include <inttypes.h>
+#include <stdio.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define VITTE_VERSION_HAVE_PTHREADS 1
+#endif
+
+#include "../util/util.h"
+
 static const vitte_version_t g_vitte_version = {
     VITTE_VERSION_MAJOR,
     VITTE_VERSION_MINOR,
@@ -36,3 +46,36 @@ const char *vitte_version_string(void) {
 const char *vitte_build_kind(void) {
     return g_vitte_version.build_kind;
 }
+
+static char g_vitte_build_id[17];
+
+static void vitte_build_id_compute(void) {
+    uint64_t hash = vitte_util_hash_text(VITTE_UTIL_HASH_SEED, g_vitte_version.string);
+    FILE *file = fopen("/proc/self/exe", "rb");
+
+    if (file != NULL) {
+        unsigned char buffer[16384];
+        size_t count;
+
+        while ((count = fread(buffer, 1u, sizeof(buffer), file)) > 0u) {
+            hash = vitte_util_hash_bytes(hash, buffer, count);
+        }
+        fclose(file);
+    } else {
+        hash = vitte_util_hash_text(hash, __DATE__ " " __TIME__);
+    }
+    snprintf(g_vitte_build_id, sizeof(g_vitte_build_id), "%016" PRIx64, hash);
+}
+
+const char *vitte_build_id(void) {
+#ifdef VITTE_VERSION_HAVE_PTHREADS
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+
+    pthread_once(&once, vitte_build_id_compute);
+#else
+    if (g_vitte_build_id[0] == '\0') {
+        vitte_build_id_compute();
+    }
+#endif
+    return g_vitte_build_id;
+}
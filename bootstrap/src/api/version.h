@@ -29,6 +29,14 @@ uint32_t vitte_abi_version(void);
 const char *vitte_version_string(void);
 const char *vitte_build_kind(void);
 
+/*
+ * Identifies this exact compiler binary: 16 hex digits hashing the running
+ * executable (read through /proc/self/exe) and the version string. Where the
+ * executable cannot be read, the compile date and time of this file stand in.
+ * Computed on the first call; safe to call from several threads.
+ */
+const char *vitte_build_id(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,38 +27,39 @@ static size_t vitte_arena_next_capacity(const vitte_arena_t *arena, size_t minim
     return capacity;
 }
 
-static size_t vitte_arena_used_bytes(const vitte_arena_t *arena) {
-    const vitte_arena_block_t *block;
-    size_t used = 0u;
-
-    if (arena == NULL) {
-        return 0u;
+/*
+ * Reports `bytes_used` to the memory account. Called when a block is added
+ * and on reset and destroy rather than per allocation, so the account lags
+ * by at most the unused tail of the current block.
+ */
+static void vitte_arena_sync_memory(vitte_arena_t *arena, size_t used) {
+    vitte_memory_tag_t *tag = arena->memory_tag;
+
+    if (tag == NULL || used == arena->memory_used) {
+        return;
     }
-
-    for (block = arena->first; block != NULL; block = block->next) {
-        used += block->offset;
+    if (used > arena->memory_used) {
+        vitte_memory_account_charge(tag->account, tag->subsystem, 0u, used - arena->memory_used);
+    } else {
+        vitte_memory_account_release(tag->account, tag->subsystem, 0u, arena->memory_used - used);
     }
-
-    return used;
+    arena->memory_used = used;
 }
 
-static void vitte_arena_recompute_storage_stats(vitte_arena_t *arena) {
-    vitte_arena_block_t *block;
-    size_t reserved = 0u;
-    size_t blocks = 0u;
+/* Frees `block` and its successors, keeping the statistics and the memory account in step. */
+static void vitte_arena_release_chain(vitte_arena_t *arena, vitte_arena_block_t *block) {
+    vitte_memory_tag_t *tag = arena->memory_tag;
 
-    if (arena == NULL) {
-        return;
-    }
+    while (block != NULL) {
+        vitte_arena_block_t *next = block->next;
 
-    for (block = arena->first; block != NULL; block = block->next) {
-        reserved += block->capacity;
-        blocks++;
+        vitte_arena_stats_release_block(&arena->stats, block->capacity);
+        if (block->mapped && tag != NULL) {
+            vitte_memory_account_release(tag->account, tag->subsystem, block->capacity, 0u);
+        }
+        vitte_arena_block_destroy(&arena->block_allocator, block);
+        block = next;
     }
-
-    arena->stats.bytes_reserved = reserved;
-    arena->stats.block_count = blocks;
-    vitte_arena_stats_set_usage(&arena->stats, vitte_arena_used_bytes(arena));
 }
 
 static bool vitte_arena_append_block(vitte_arena_t *arena, size_t capacity) {
@@ -68,7 +69,14 @@ static bool vitte_arena_append_block(vitte_arena_t *arena, size_t capacity) {
         return false;
     }
 
-    block = vitte_arena_block_create(&arena->config.allocator, capacity);
+    vitte_arena_sync_memory(arena, arena->stats.bytes_used);
+    block = NULL;
+    if (arena->config.huge_pages && capacity >= VITTE_ARENA_HUGE_PAGE_SIZE) {
+        block = vitte_arena_block_create_mapped(&arena->block_allocator, capacity);
+    }
+    if (block == NULL) {
+        block = vitte_arena_block_create(&arena->block_allocator, capacity);
+    }
     if (block == NULL) {
         vitte_arena_stats_record_failed_alloc(&arena->stats);
         vitte_arena_set_error(
@@ -88,6 +96,10 @@ static bool vitte_arena_append_block(vitte_arena_t *arena, size_t capacity) {
     }
     arena->current = block;
     vitte_arena_stats_record_block(&arena->stats, block->capacity);
+    /* Mapped memory bypasses the block allocator, so charge it here. */
+    if (block->mapped && arena->memory_tag != NULL) {
+        vitte_memory_account_charge(arena->memory_tag->account, arena->memory_tag->subsystem, block->capacity, 0u);
+    }
     return true;
 }
 
@@ -102,6 +114,7 @@ void vitte_arena_config_init(vitte_arena_config_t *config) {
     config->max_block_size = 0u;
     config->reset_policy = VITTE_ARENA_RESET_KEEP_FIRST_BLOCK;
     config->clear_on_reset = false;
+    config->huge_pages = false;
 }
 
 vitte_status_t vitte_arena_init(
@@ -127,6 +140,7 @@ vitte_status_t vitte_arena_init(
     if (arena->config.initial_block_size == 0u) {
         arena->config.initial_block_size = VITTE_ARENA_DEFAULT_BLOCK_SIZE;
     }
+    arena->memory_tag = vitte_memory_block_allocator(&arena->config.allocator, &arena->block_allocator);
 
     vitte_arena_stats_init(&arena->stats);
     vitte_error_init(&arena->last_error);
@@ -185,7 +199,10 @@ void vitte_arena_destroy(vitte_arena_t *arena) {
 
     owns_arena = arena->owns_arena;
     allocator = arena->config.allocator;
-    vitte_arena_block_destroy_chain(&allocator, arena->first);
+    /* Report the final use first so the account's peak sees it. */
+    vitte_arena_sync_memory(arena, arena->stats.bytes_used);
+    vitte_arena_sync_memory(arena, 0u);
+    vitte_arena_release_chain(arena, arena->first);
     memset(arena, 0, sizeof(*arena));
 
     if (owns_arena && vitte_allocator_is_valid(&allocator)) {
@@ -214,9 +231,11 @@ void *vitte_arena_alloc(
     size_t size,
     size_t alignment
 ) {
+    vitte_arena_block_t *block;
     void *memory;
     size_t aligned_offset;
     size_t needed;
+    size_t offset;
 
     if (!vitte_arena_is_initialized(arena) || size == 0u) {
         return NULL;
@@ -231,6 +250,18 @@ void *vitte_arena_alloc(
         return NULL;
     }
 
+    /* Fast path: bump the current block when the request fits. */
+    block = arena->current;
+    if (block != NULL) {
+        offset = block->offset;
+        aligned_offset = (offset + alignment - 1u) & ~(alignment - 1u);
+        if (aligned_offset >= offset && aligned_offset <= block->capacity && size <= block->capacity - aligned_offset) {
+            block->offset = aligned_offset + size;
+            vitte_arena_stats_record_alloc(&arena->stats, block->offset - offset);
+            return block->memory + aligned_offset;
+        }
+    }
+
     needed = size;
     if (arena->current != NULL) {
         if (!vitte_arena_align_forward(arena->current->offset, alignment, &aligned_offset)) {
@@ -248,6 +279,7 @@ void *vitte_arena_alloc(
         }
     }
 
+    offset = arena->current->offset;
     memory = vitte_arena_block_alloc(arena->current, size, alignment);
     if (memory == NULL) {
         vitte_arena_stats_record_failed_alloc(&arena->stats);
@@ -255,8 +287,8 @@ void *vitte_arena_alloc(
         return NULL;
     }
 
-    vitte_arena_stats_set_usage(&arena->stats, vitte_arena_used_bytes(arena));
-    arena->stats.allocation_count++;
+    /* Alignment padding counts as used, as it always has. */
+    vitte_arena_stats_record_alloc(&arena->stats, arena->current->offset - offset);
     return memory;
 }
 
@@ -291,34 +323,50 @@ bool vitte_arena_contains(const vitte_arena_t *arena, const void *pointer) {
 }
 
 void vitte_arena_reset(vitte_arena_t *arena) {
-    vitte_arena_block_t *keep;
-
     if (!vitte_arena_is_initialized(arena)) {
         return;
     }
 
     if (arena->config.reset_policy == VITTE_ARENA_RESET_RELEASE_ALL_BLOCKS) {
-        vitte_arena_block_destroy_chain(&arena->config.allocator, arena->first);
-        arena->first = NULL;
-        arena->current = NULL;
+        vitte_arena_truncate(arena, NULL, 0u, 0u);
     } else {
-        keep = arena->first;
-        if (keep != NULL) {
-            vitte_arena_block_destroy_chain(&arena->config.allocator, keep->next);
-            keep->next = NULL;
-            if (arena->config.clear_on_reset) {
-                memset(keep->memory, 0, keep->capacity);
-            }
-            keep->offset = 0u;
-            arena->current = keep;
+        vitte_arena_truncate(arena, arena->first, 0u, 0u);
+        if (arena->first != NULL && arena->config.clear_on_reset) {
+            memset(arena->first->memory, 0, arena->first->capacity);
         }
     }
 
-    vitte_arena_recompute_storage_stats(arena);
     vitte_arena_stats_record_reset(&arena->stats, 0u);
     vitte_error_reset(&arena->last_error);
 }
 
+void vitte_arena_truncate(
+    vitte_arena_t *arena,
+    vitte_arena_block_t *keep,
+    size_t offset,
+    size_t bytes_used
+) {
+    if (!vitte_arena_is_initialized(arena)) {
+        return;
+    }
+
+    /* Report the use being dropped first so the account's peak sees it. */
+    vitte_arena_sync_memory(arena, arena->stats.bytes_used);
+    if (keep == NULL) {
+        vitte_arena_release_chain(arena, arena->first);
+        arena->first = NULL;
+        arena->current = NULL;
+    } else {
+        vitte_arena_release_chain(arena, keep->next);
+        keep->next = NULL;
+        keep->offset = offset <= keep->capacity ? offset : keep->capacity;
+        arena->current = keep;
+    }
+
+    vitte_arena_stats_set_usage(&arena->stats, bytes_used);
+    vitte_arena_sync_memory(arena, arena->stats.bytes_used);
+}
+
 const vitte_arena_stats_t *vitte_arena_stats(const vitte_arena_t *arena) {
     return arena != NULL ? &arena->stats : NULL;
 }
@@ -26,12 +26,19 @@ typedef struct vitte_arena_config {
     size_t max_block_size;
     vitte_arena_reset_policy_t reset_policy;
     bool clear_on_reset;
+    /* Map blocks of VITTE_ARENA_HUGE_PAGE_SIZE or more with huge pages when the OS allows. */
+    bool huge_pages;
 } vitte_arena_config_t;
 
 typedef struct vitte_arena {
     bool initialized;
     bool owns_arena;
     vitte_arena_config_t config;
+    /* Blocks come from here; see vitte_memory_block_allocator. */
+    vitte_allocator_t block_allocator;
+    /* Set when the allocator is tagged; receives `bytes_used` in block steps. */
+    vitte_memory_tag_t *memory_tag;
+    size_t memory_used;
     vitte_arena_block_t *first;
     vitte_arena_block_t *current;
     vitte_arena_stats_t stats;
@@ -69,6 +76,19 @@ bool vitte_arena_reserve(vitte_arena_t *arena, size_t capacity);
 bool vitte_arena_contains(const vitte_arena_t *arena, const void *pointer);
 void vitte_arena_reset(vitte_arena_t *arena);
 
+/*
+ * Frees every block after `keep` (all of them when `keep` is NULL), rewinds
+ * `keep` to `offset` and makes it current, and sets the used byte count to
+ * `bytes_used`. Reset and checkpoint rollback are built on it; it only walks
+ * the blocks it frees.
+ */
+void vitte_arena_truncate(
+    vitte_arena_t *arena,
+    vitte_arena_block_t *keep,
+    size_t offset,
+    size_t bytes_used
+);
+
 const vitte_arena_stats_t *vitte_arena_stats(const vitte_arena_t *arena);
 const vitte_error_t *vitte_arena_last_error(const vitte_arena_t *arena);
 void vitte_arena_clear_error(vitte_arena_t *arena);
@@ -1,8 +1,21 @@
+#if defined(__unix__) || defined(__APPLE__)
+/* mmap is POSIX; anonymous and huge-page mappings are BSD and Linux extensions. */
+#define _DEFAULT_SOURCE
+#define _DARWIN_C_SOURCE
+#endif
+
 #include "block.h"
 
 #include <stdint.h>
 #include <string.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
 bool vitte_arena_alignment_is_valid(size_t alignment) {
     return alignment != 0u && (alignment & (alignment - 1u)) == 0u;
 }
@@ -46,6 +59,71 @@ vitte_arena_block_t *vitte_arena_block_create(
 
     block->capacity = capacity;
     block->offset = 0u;
+    block->mapped = false;
+    block->next = NULL;
+    return block;
+}
+
+static void *vitte_arena_block_map(size_t size) {
+#if (defined(__unix__) || defined(__APPLE__)) && defined(MAP_ANONYMOUS)
+    void *memory;
+
+#if defined(MAP_HUGETLB)
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (memory != MAP_FAILED) {
+        return memory;
+    }
+#endif
+    /* No reserved huge pages: take normal pages and let THP promote them. */
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return NULL;
+    }
+#if defined(MADV_HUGEPAGE)
+    (void)madvise(memory, size, MADV_HUGEPAGE);
+#endif
+    return memory;
+#else
+    (void)size;
+    return NULL;
+#endif
+}
+
+static void vitte_arena_block_unmap(void *memory, size_t size) {
+#if (defined(__unix__) || defined(__APPLE__)) && defined(MAP_ANONYMOUS)
+    (void)munmap(memory, size);
+#else
+    (void)memory;
+    (void)size;
+#endif
+}
+
+vitte_arena_block_t *vitte_arena_block_create_mapped(
+    const vitte_allocator_t *allocator,
+    size_t capacity
+) {
+    vitte_arena_block_t *block;
+    size_t size;
+
+    if (!vitte_allocator_is_valid(allocator) || capacity == 0u ||
+        !vitte_arena_align_forward(capacity, VITTE_ARENA_HUGE_PAGE_SIZE, &size)) {
+        return NULL;
+    }
+
+    block = (vitte_arena_block_t *)allocator->alloc(allocator->user, sizeof(*block));
+    if (block == NULL) {
+        return NULL;
+    }
+
+    block->memory = (unsigned char *)vitte_arena_block_map(size);
+    if (block->memory == NULL) {
+        allocator->free(allocator->user, block);
+        return NULL;
+    }
+
+    block->capacity = size;
+    block->offset = 0u;
+    block->mapped = true;
     block->next = NULL;
     return block;
 }
@@ -58,7 +136,11 @@ void vitte_arena_block_destroy(
         return;
     }
 
-    allocator->free(allocator->user, block->memory);
+    if (block->mapped) {
+        vitte_arena_block_unmap(block->memory, block->capacity);
+    } else {
+        allocator->free(allocator->user, block->memory);
+    }
     memset(block, 0, sizeof(*block));
     allocator->free(allocator->user, block);
 }
@@ -14,9 +14,14 @@ typedef struct vitte_arena_block {
     unsigned char *memory;
     size_t capacity;
     size_t offset;
+    /* Memory was mapped with vitte_arena_block_create_mapped, not allocated. */
+    bool mapped;
     struct vitte_arena_block *next;
 } vitte_arena_block_t;
 
+/* Huge-page mappings are made in multiples of this size. */
+#define VITTE_ARENA_HUGE_PAGE_SIZE ((size_t)2u << 20)
+
 bool vitte_arena_alignment_is_valid(size_t alignment);
 bool vitte_arena_align_forward(size_t value, size_t alignment, size_t *aligned);
 
@@ -25,6 +30,17 @@ vitte_arena_block_t *vitte_arena_block_create(
     size_t capacity
 );
 
+/*
+ * Like vitte_arena_block_create, but maps `capacity` rounded up to
+ * VITTE_ARENA_HUGE_PAGE_SIZE directly from the OS, asking for huge pages
+ * (MAP_HUGETLB, else transparent huge pages via madvise). Only the block
+ * header comes from `allocator`. Returns NULL where mapping is unavailable.
+ */
+vitte_arena_block_t *vitte_arena_block_create_mapped(
+    const vitte_allocator_t *allocator,
+    size_t capacity
+);
+
 void vitte_arena_block_destroy(
     const vitte_allocator_t *allocator,
     vitte_arena_block_t *block
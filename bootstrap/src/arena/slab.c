@@ -0,0 +1,122 @@
+#include "slab.h"
+
+#include <string.h>
+
+/* Class `index` holds objects of `(index + 1) * VITTE_ARENA_SLAB_GRANULE` bytes. */
+static size_t vitte_arena_slab_class_index(size_t size) {
+    return size == 0u ? 0u : (size - 1u) / VITTE_ARENA_SLAB_GRANULE;
+}
+
+static void *vitte_arena_slab_refill(vitte_arena_slab_t *slab, vitte_arena_slab_class_t *size_class, size_t object_size) {
+    unsigned char *run;
+    size_t run_size = VITTE_ARENA_SLAB_RUN_SIZE - VITTE_ARENA_SLAB_RUN_SIZE % object_size;
+
+    run = (unsigned char *)vitte_arena_alloc(slab->arena, run_size, VITTE_ARENA_SLAB_GRANULE);
+    if (run == NULL) {
+        return NULL;
+    }
+
+    /* The tail of the previous run, if any, is too small for an object and is left behind. */
+    size_class->run = run + object_size;
+    size_class->run_end = run + run_size;
+    return run;
+}
+
+bool vitte_arena_slab_init(vitte_arena_slab_t *slab, vitte_arena_t *arena) {
+    if (slab == NULL || !vitte_arena_is_initialized(arena)) {
+        return false;
+    }
+
+    memset(slab, 0, sizeof(*slab));
+    slab->arena = arena;
+    slab->initialized = true;
+    return true;
+}
+
+void *vitte_arena_slab_alloc(vitte_arena_slab_t *slab, size_t size) {
+    vitte_arena_slab_class_t *size_class;
+    size_t index;
+    size_t object_size;
+    void *object;
+
+    if (!vitte_arena_slab_is_initialized(slab) || size == 0u) {
+        return NULL;
+    }
+
+    if (size > VITTE_ARENA_SLAB_MAX_SIZE) {
+        object = vitte_arena_alloc(slab->arena, size, VITTE_ARENA_SLAB_GRANULE);
+        if (object != NULL) {
+            slab->large_allocation_count++;
+        }
+        return object;
+    }
+
+    index = vitte_arena_slab_class_index(size);
+    size_class = &slab->classes[index];
+    object_size = (index + 1u) * VITTE_ARENA_SLAB_GRANULE;
+    if (size_class->free_list != NULL) {
+        object = size_class->free_list;
+        size_class->free_list = size_class->free_list->next;
+        size_class->cached_count--;
+    } else if (size_class->run != size_class->run_end) {
+        object = size_class->run;
+        size_class->run += object_size;
+    } else {
+        object = vitte_arena_slab_refill(slab, size_class, object_size);
+        if (object == NULL) {
+            return NULL;
+        }
+    }
+
+    size_class->allocation_count++;
+    return object;
+}
+
+void vitte_arena_slab_free(vitte_arena_slab_t *slab, void *object, size_t size) {
+    vitte_arena_slab_class_t *size_class;
+    vitte_arena_pool_node_t *node;
+
+    /* Large objects belong to the arena alone and are dropped with it. */
+    if (!vitte_arena_slab_is_initialized(slab) || object == NULL || size == 0u || size > VITTE_ARENA_SLAB_MAX_SIZE) {
+        return;
+    }
+
+    size_class = &slab->classes[vitte_arena_slab_class_index(size)];
+    node = (vitte_arena_pool_node_t *)object;
+    node->next = size_class->free_list;
+    size_class->free_list = node;
+    size_class->free_count++;
+    size_class->cached_count++;
+}
+
+void vitte_arena_slab_reset(vitte_arena_slab_t *slab) {
+    if (slab == NULL) {
+        return;
+    }
+
+    memset(slab->classes, 0, sizeof(slab->classes));
+    slab->large_allocation_count = 0u;
+}
+
+bool vitte_arena_slab_is_initialized(const vitte_arena_slab_t *slab) {
+    return slab != NULL && slab->initialized && vitte_arena_is_initialized(slab->arena);
+}
+
+vitte_arena_slab_stats_t vitte_arena_slab_stats(const vitte_arena_slab_t *slab) {
+    vitte_arena_slab_stats_t stats;
+    size_t index;
+
+    memset(&stats, 0, sizeof(stats));
+    if (slab == NULL) {
+        return stats;
+    }
+
+    for (index = 0u; index < VITTE_ARENA_SLAB_CLASS_COUNT; index++) {
+        stats.allocation_count += slab->classes[index].allocation_count;
+        stats.free_count += slab->classes[index].free_count;
+        stats.cached_object_count += slab->classes[index].cached_count;
+    }
+    stats.allocation_count += slab->large_allocation_count;
+    stats.large_allocation_count = slab->large_allocation_count;
+    return stats;
+}
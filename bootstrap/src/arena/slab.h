@@ -0,0 +1,67 @@
+#ifndef VITTE_BOOTSTRAP_ARENA_SLAB_H
+#define VITTE_BOOTSTRAP_ARENA_SLAB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "arena.h"
+#include "pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Objects are rounded up to a multiple of the granule, which keeps them max-aligned. */
+#define VITTE_ARENA_SLAB_GRANULE VITTE_ARENA_DEFAULT_ALIGNMENT
+#define VITTE_ARENA_SLAB_CLASS_COUNT ((size_t)16u)
+#define VITTE_ARENA_SLAB_MAX_SIZE (VITTE_ARENA_SLAB_GRANULE * VITTE_ARENA_SLAB_CLASS_COUNT)
+/* Each class carves objects from runs of this many bytes taken from the arena. */
+#define VITTE_ARENA_SLAB_RUN_SIZE ((size_t)4096u)
+
+typedef struct vitte_arena_slab_class {
+    vitte_arena_pool_node_t *free_list;
+    unsigned char *run;
+    unsigned char *run_end;
+    size_t allocation_count;
+    size_t free_count;
+    size_t cached_count;
+} vitte_arena_slab_class_t;
+
+typedef struct vitte_arena_slab_stats {
+    size_t allocation_count;
+    size_t free_count;
+    size_t cached_object_count;
+    /* Requests above VITTE_ARENA_SLAB_MAX_SIZE, served by the arena directly. */
+    size_t large_allocation_count;
+} vitte_arena_slab_stats_t;
+
+/*
+ * Size-class allocator over an arena for small nodes that come and go, such
+ * as scope bindings during lowering. Freed objects go on their class's free
+ * list and are handed out again before the arena is touched; everything is
+ * still released with the arena. Unlike vitte_arena_pool_t it serves any
+ * size, and frees are O(1) with no ownership or double-free checks, so the
+ * caller must pass the size it allocated with.
+ */
+typedef struct vitte_arena_slab {
+    vitte_arena_t *arena;
+    vitte_arena_slab_class_t classes[VITTE_ARENA_SLAB_CLASS_COUNT];
+    size_t large_allocation_count;
+    bool initialized;
+} vitte_arena_slab_t;
+
+bool vitte_arena_slab_init(vitte_arena_slab_t *slab, vitte_arena_t *arena);
+
+void *vitte_arena_slab_alloc(vitte_arena_slab_t *slab, size_t size);
+void vitte_arena_slab_free(vitte_arena_slab_t *slab, void *object, size_t size);
+
+/* Forgets free lists and runs; call it after resetting or rolling back the arena. */
+void vitte_arena_slab_reset(vitte_arena_slab_t *slab);
+bool vitte_arena_slab_is_initialized(const vitte_arena_slab_t *slab);
+vitte_arena_slab_stats_t vitte_arena_slab_stats(const vitte_arena_slab_t *slab);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VITTE_BOOTSTRAP_ARENA_SLAB_H */
@@ -3,6 +3,8 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include "../util/util.h"
+
 static const size_t VITTE_AST_DEFAULT_MAX_DEPTH = 256u;
 
 static void vitte_ast_set_error(
@@ -328,15 +330,152 @@ const char *vitte_ast_decl_name(const vitte_ast_decl_t *decl) {
     return NULL;
 }
 
+/*
+ * Name index over one module's declarations and exports. Slots hold node
+ * pointers and are probed linearly; entries sharing a key stay in list order
+ * along the probe chain, so lookups return the same node as a list walk.
+ */
+struct vitte_ast_module_index {
+    const vitte_ast_node_t *decl_last;
+    size_t decl_count;
+    const vitte_ast_node_t *export_last;
+    size_t export_count;
+    size_t mask;
+    const vitte_ast_node_t **decls;
+    const vitte_ast_node_t **exports;
+    const vitte_ast_node_t **local_exports;
+};
+
+static size_t vitte_ast_hash_name(const char *name) {
+    return (size_t)vitte_util_hash_text(VITTE_UTIL_HASH_SEED, name);
+}
+
+static const char *vitte_ast_export_public_name(const vitte_ast_node_t *export_decl) {
+    return export_decl->as.export_decl.export_name;
+}
+
+static const char *vitte_ast_export_local_name(const vitte_ast_node_t *export_decl) {
+    return export_decl->as.export_decl.local_name;
+}
+
+static void vitte_ast_index_insert(
+    const vitte_ast_node_t **slots,
+    size_t mask,
+    const vitte_ast_node_t *node,
+    const char *name
+) {
+    size_t position = vitte_ast_hash_name(name) & mask;
+
+    while (slots[position] != NULL) {
+        position = (position + 1u) & mask;
+    }
+    slots[position] = node;
+}
+
+/* Returns the slot after `position` holding a node whose `key` is `name`, or the empty slot ending the chain. */
+static size_t vitte_ast_index_next(
+    const vitte_ast_node_t *const *slots,
+    size_t mask,
+    size_t position,
+    const char *(*key)(const vitte_ast_node_t *),
+    const char *name
+) {
+    while (slots[position] != NULL) {
+        const char *slot_name = key(slots[position]);
+        if (slot_name == name || strcmp(slot_name, name) == 0) {
+            return position;
+        }
+        position = (position + 1u) & mask;
+    }
+    return position;
+}
+
+/* Returns the module's index while it still matches the declaration and export lists. */
+static const vitte_ast_module_index_t *vitte_ast_module_current_index(const vitte_ast_module_t *module) {
+    const vitte_ast_module_index_t *index = module->as.module.index;
+
+    if (index == NULL ||
+        index->decl_last != module->as.module.declarations.last ||
+        index->decl_count != module->as.module.declarations.count ||
+        index->export_last != module->as.module.exports.last ||
+        index->export_count != module->as.module.exports.count) {
+        return NULL;
+    }
+    return index;
+}
+
+vitte_status_t vitte_ast_module_build_index(vitte_ast_t *ast, vitte_ast_module_t *module) {
+    vitte_ast_module_index_t *index;
+    const vitte_ast_node_t *node;
+    size_t capacity = 16u;
+    size_t count;
+
+    if (!vitte_ast_is_initialized(ast) || module == NULL || module->kind != VITTE_AST_NODE_MODULE) {
+        vitte_ast_set_error(ast, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_AST_E_INDEX", "invalid module index request", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    if (vitte_ast_module_current_index(module) != NULL) {
+        return VITTE_STATUS_OK;
+    }
+    count = module->as.module.declarations.count + module->as.module.exports.count;
+    while (capacity < count * 2u) {
+        capacity *= 2u;
+    }
+    index = (vitte_ast_module_index_t *)vitte_arena_alloc_zeroed(ast->arena, sizeof(*index), _Alignof(vitte_ast_module_index_t));
+    if (index != NULL) {
+        index->decls = (const vitte_ast_node_t **)vitte_arena_alloc_zeroed(
+            ast->arena,
+            capacity * 3u * sizeof(*index->decls),
+            _Alignof(const vitte_ast_node_t *)
+        );
+    }
+    if (index == NULL || index->decls == NULL) {
+        vitte_ast_set_error(ast, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_AST_E_OOM", "unable to allocate module index", module->as.module.name);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    index->exports = index->decls + capacity;
+    index->local_exports = index->exports + capacity;
+    index->mask = capacity - 1u;
+    for (node = module->as.module.declarations.first; node != NULL; node = node->next) {
+        const char *name = vitte_ast_decl_name(node);
+        if (name != NULL) {
+            vitte_ast_index_insert(index->decls, index->mask, node, name);
+        }
+    }
+    for (node = module->as.module.exports.first; node != NULL; node = node->next) {
+        if (node->kind != VITTE_AST_NODE_EXPORT_DECL) {
+            continue;
+        }
+        if (node->as.export_decl.export_name != NULL) {
+            vitte_ast_index_insert(index->exports, index->mask, node, node->as.export_decl.export_name);
+        }
+        if (node->as.export_decl.local_name != NULL) {
+            vitte_ast_index_insert(index->local_exports, index->mask, node, node->as.export_decl.local_name);
+        }
+    }
+    index->decl_last = module->as.module.declarations.last;
+    index->decl_count = module->as.module.declarations.count;
+    index->export_last = module->as.module.exports.last;
+    index->export_count = module->as.module.exports.count;
+    module->as.module.index = index;
+    return VITTE_STATUS_OK;
+}
+
 const vitte_ast_decl_t *vitte_ast_module_find_decl(const vitte_ast_module_t *module, const char *name) {
     const vitte_ast_node_t *decl;
+    const vitte_ast_module_index_t *index;
 
     if (module == NULL || module->kind != VITTE_AST_NODE_MODULE || name == NULL) {
         return NULL;
     }
+    index = vitte_ast_module_current_index(module);
+    if (index != NULL) {
+        size_t position = vitte_ast_hash_name(name) & index->mask;
+        return index->decls[vitte_ast_index_next(index->decls, index->mask, position, vitte_ast_decl_name, name)];
+    }
     for (decl = module->as.module.declarations.first; decl != NULL; decl = decl->next) {
         const char *decl_name = vitte_ast_decl_name(decl);
-        if (decl_name != NULL && strcmp(decl_name, name) == 0) {
+        if (decl_name != NULL && (decl_name == name || strcmp(decl_name, name) == 0)) {
             return decl;
         }
     }
@@ -359,6 +498,7 @@ bool vitte_ast_module_decl_is_exported(
     const vitte_ast_decl_t *decl
 ) {
     const vitte_ast_node_t *export_decl;
+    const vitte_ast_module_index_t *index;
     const char *decl_name;
 
     if (module == NULL || module->kind != VITTE_AST_NODE_MODULE || decl == NULL) {
@@ -386,6 +526,13 @@ bool vitte_ast_module_decl_is_exported(
     if (decl_name == NULL) {
         return false;
     }
+    index = vitte_ast_module_current_index(module);
+    if (index != NULL) {
+        size_t position = vitte_ast_hash_name(decl_name) & index->mask;
+        return index->local_exports[vitte_ast_index_next(
+            index->local_exports, index->mask, position, vitte_ast_export_local_name, decl_name
+        )] != NULL;
+    }
     for (export_decl = module->as.module.exports.first; export_decl != NULL; export_decl = export_decl->next) {
         if (export_decl->kind == VITTE_AST_NODE_EXPORT_DECL &&
             export_decl->as.export_decl.local_name != NULL &&
@@ -402,21 +549,41 @@ const vitte_ast_decl_t *vitte_ast_module_find_exported_decl(
 ) {
     const vitte_ast_node_t *export_decl;
     const vitte_ast_decl_t *decl;
+    const vitte_ast_module_index_t *index;
 
     if (module == NULL || module->kind != VITTE_AST_NODE_MODULE || export_name == NULL) {
         return NULL;
     }
-    for (export_decl = module->as.module.exports.first; export_decl != NULL; export_decl = export_decl->next) {
-        const vitte_ast_decl_t *target;
+    index = vitte_ast_module_current_index(module);
+    if (index != NULL) {
+        size_t position = vitte_ast_hash_name(export_name) & index->mask;
 
-        if (export_decl->kind != VITTE_AST_NODE_EXPORT_DECL ||
-            export_decl->as.export_decl.export_name == NULL ||
-            strcmp(export_decl->as.export_decl.export_name, export_name) != 0) {
-            continue;
+        for (;;) {
+            const vitte_ast_decl_t *target;
+
+            position = vitte_ast_index_next(index->exports, index->mask, position, vitte_ast_export_public_name, export_name);
+            if (index->exports[position] == NULL) {
+                break;
+            }
+            target = vitte_ast_export_decl_target(module, index->exports[position]);
+            if (target != NULL) {
+                return target;
+            }
+            position = (position + 1u) & index->mask;
         }
-        target = vitte_ast_export_decl_target(module, export_decl);
-        if (target != NULL) {
-            return target;
+    } else {
+        for (export_decl = module->as.module.exports.first; export_decl != NULL; export_decl = export_decl->next) {
+            const vitte_ast_decl_t *target;
+
+            if (export_decl->kind != VITTE_AST_NODE_EXPORT_DECL ||
+                export_decl->as.export_decl.export_name == NULL ||
+                strcmp(export_decl->as.export_decl.export_name, export_name) != 0) {
+                continue;
+            }
+            target = vitte_ast_export_decl_target(module, export_decl);
+            if (target != NULL) {
+                return target;
+            }
         }
     }
 
@@ -447,6 +614,7 @@ static bool vitte_ast_module_export_is_duplicate(
 ) {
     const char *decl_name;
     const vitte_ast_node_t *previous;
+    const vitte_ast_module_index_t *index;
 
     if (module == NULL || export_decl == NULL || target_decl == NULL || public_name == NULL) {
         return false;
@@ -457,6 +625,22 @@ static bool vitte_ast_module_export_is_duplicate(
         vitte_ast_export_matches(target_decl, public_name, target_decl, decl_name)) {
         return true;
     }
+    index = vitte_ast_module_current_index(module);
+    if (index != NULL) {
+        size_t position = vitte_ast_hash_name(public_name) & index->mask;
+
+        for (;;) {
+            position = vitte_ast_index_next(index->exports, index->mask, position, vitte_ast_export_public_name, public_name);
+            previous = index->exports[position];
+            if (previous == NULL || previous == export_decl) {
+                return false;
+            }
+            if (vitte_ast_export_decl_target(module, previous) == target_decl) {
+                return true;
+            }
+            position = (position + 1u) & index->mask;
+        }
+    }
     for (previous = module->as.module.exports.first; previous != NULL && previous != export_decl; previous = previous->next) {
         const vitte_ast_decl_t *previous_target;
         const char *previous_public_name;
@@ -544,6 +728,7 @@ vitte_ast_module_t *vitte_ast_make_module(vitte_ast_builder_t *builder, const ch
     vitte_ast_list_init(&node->as.module.exports);
     vitte_ast_list_init(&node->as.module.declarations);
     node->as.module.export_all = false;
+    node->as.module.index = NULL;
     builder->ast->root = node;
     return node;
 }
@@ -75,6 +75,7 @@ typedef vitte_ast_node_t vitte_ast_decl_t;
 typedef vitte_ast_node_t vitte_ast_stmt_t;
 typedef vitte_ast_node_t vitte_ast_expr_t;
 typedef vitte_ast_node_t vitte_ast_type_ref_t;
+typedef struct vitte_ast_module_index vitte_ast_module_index_t;
 
 typedef struct vitte_ast_list {
     vitte_ast_node_t *first;
@@ -94,6 +95,7 @@ struct vitte_ast_node {
             vitte_ast_list_t exports;
             vitte_ast_list_t declarations;
             bool export_all;
+            vitte_ast_module_index_t *index;
         } module;
 
         struct {
@@ -297,6 +299,7 @@ const vitte_ast_decl_t *vitte_ast_export_decl_target(const vitte_ast_module_t *m
 bool vitte_ast_module_decl_is_exported(const vitte_ast_module_t *module, const vitte_ast_decl_t *decl);
 const vitte_ast_decl_t *vitte_ast_module_find_exported_decl(const vitte_ast_module_t *module, const char *export_name);
 size_t vitte_ast_module_visit_exports(const vitte_ast_module_t *module, vitte_ast_export_visit_fn callback, void *user);
+vitte_status_t vitte_ast_module_build_index(vitte_ast_t *ast, vitte_ast_module_t *module);
 void vitte_ast_dump(const vitte_ast_node_t *node, FILE *stream, size_t max_depth);
 
 void vitte_ast_builder_init(vitte_ast_builder_t *builder, vitte_ast_t *ast);
@@ -159,6 +159,34 @@ vitte_status_t vitte_c17_backend_emit_ir_to_buffer(
     return vitte_c17_backend_emit_with_writer(backend, ir, &writer, result);
 }
 
+vitte_status_t vitte_c17_backend_emit_ir_to_stream(
+    vitte_c17_backend_t *backend,
+    const vitte_ir_t *ir,
+    FILE *stream,
+    vitte_c17_emit_result_t *result
+) {
+    vitte_c17_writer_t writer;
+    vitte_status_t status;
+
+    if (stream == NULL) {
+        vitte_c17_backend_set_error(backend, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_C17_E_FILE", "missing C17 output stream", NULL);
+        if (result != NULL) {
+            result->status = VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+        }
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = vitte_c17_writer_init_file(&writer, stream, backend != NULL ? &backend->options : NULL);
+    if (status != VITTE_STATUS_OK) {
+        vitte_c17_backend_set_error(backend, status, "VITTE_C17_E_WRITER", "failed to initialize C17 stream writer", NULL);
+        if (result != NULL) {
+            result->status = status;
+        }
+        return status;
+    }
+    return vitte_c17_backend_emit_with_writer(backend, ir, &writer, result);
+}
+
 vitte_status_t vitte_c17_backend_emit_ir_to_file(
     vitte_c17_backend_t *backend,
     const vitte_ir_t *ir,
@@ -166,7 +194,6 @@ vitte_status_t vitte_c17_backend_emit_ir_to_file(
     vitte_c17_emit_result_t *result
 ) {
     FILE *stream;
-    vitte_c17_writer_t writer;
     vitte_status_t status;
 
     if (output_path == NULL) {
@@ -186,10 +213,7 @@ vitte_status_t vitte_c17_backend_emit_ir_to_file(
         return VITTE_STATUS_ERROR_IO;
     }
 
-    status = vitte_c17_writer_init_file(&writer, stream, backend != NULL ? &backend->options : NULL);
-    if (status == VITTE_STATUS_OK) {
-        status = vitte_c17_backend_emit_with_writer(backend, ir, &writer, result);
-    }
+    status = vitte_c17_backend_emit_ir_to_stream(backend, ir, stream, result);
     if (fclose(stream) != 0 && status == VITTE_STATUS_OK) {
         vitte_c17_backend_set_error(backend, VITTE_STATUS_ERROR_IO, "VITTE_C17_E_FILE", "failed to close C17 output file", output_path);
         status = VITTE_STATUS_ERROR_IO;
@@ -200,3 +224,44 @@ vitte_status_t vitte_c17_backend_emit_ir_to_file(
 
     return status;
 }
+
+vitte_status_t vitte_c17_backend_emit_ir_to_directory(
+    vitte_c17_backend_t *backend,
+    const vitte_ir_t *ir,
+    const char *directory,
+    vitte_c17_unit_list_t *units,
+    vitte_c17_emit_result_t *result
+) {
+    vitte_c17_program_t program;
+    vitte_status_t status;
+
+    if (result != NULL) {
+        vitte_c17_emit_result_init(result);
+    }
+    if (!vitte_c17_backend_is_initialized(backend) || ir == NULL || directory == NULL || units == NULL) {
+        vitte_c17_backend_set_error(backend, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_C17_E_BACKEND", "missing initialized C17 backend, input, unit directory, or unit list", NULL);
+        if (result != NULL) {
+            result->status = VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+        }
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    vitte_c17_program_init_ir(&program, ir, &backend->options);
+    status = vitte_c17_program_emit_units(&program, directory, units);
+    if (status != VITTE_STATUS_OK) {
+        vitte_error_copy(&backend->last_error, vitte_c17_program_last_error(&program));
+        if (result != NULL) {
+            result->status = status;
+        }
+        return status;
+    }
+
+    if (result != NULL) {
+        result->status = VITTE_STATUS_OK;
+        result->functions_emitted = program.function_count;
+        result->units_emitted = units->count;
+        result->files_written = program.files_written;
+    }
+    vitte_error_reset(&backend->last_error);
+    return VITTE_STATUS_OK;
+}
@@ -7,6 +7,7 @@
 #include "../../api/error.h"
 #include "../../ir/ir.h"
 #include "options.h"
+#include "units.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -17,6 +18,8 @@ typedef struct vitte_c17_emit_result {
     size_t bytes_written;
     size_t lines_written;
     size_t functions_emitted;
+    size_t units_emitted;
+    size_t files_written;
 } vitte_c17_emit_result_t;
 
 typedef struct vitte_c17_backend {
@@ -50,6 +53,27 @@ vitte_status_t vitte_c17_backend_emit_ir_to_file(
     vitte_c17_emit_result_t *result
 );
 
+/* Emits the whole program into an open `stream`, e.g. a pipe to the C compiler; the caller closes it. */
+vitte_status_t vitte_c17_backend_emit_ir_to_stream(
+    vitte_c17_backend_t *backend,
+    const vitte_ir_t *ir,
+    FILE *stream,
+    vitte_c17_emit_result_t *result
+);
+
+/*
+ * Emits one translation unit per Vitte module into the existing `directory`
+ * (see `vitte_c17_program_emit_units`). `units` receives the unit stems;
+ * unchanged files keep their timestamps.
+ */
+vitte_status_t vitte_c17_backend_emit_ir_to_directory(
+    vitte_c17_backend_t *backend,
+    const vitte_ir_t *ir,
+    const char *directory,
+    vitte_c17_unit_list_t *units,
+    vitte_c17_emit_result_t *result
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,46 @@ static void vitte_c17_module_set_error(
     }
 }
 
+static const char *const vitte_c17_known_texts[VITTE_C17_NAME_COUNT] = {
+    "main",
+    "vitte_host_runtime_available",
+    "vitte_host_read_file",
+    "vitte_host_write_file",
+    "vitte_host_append_file",
+    "vitte_host_file_exists",
+    "vitte_host_is_file",
+    "vitte_host_is_directory",
+    "vitte_host_list_directory",
+    "vitte_host_mkdir_all",
+    "vitte_host_system",
+    "vitte_host_emit_llvm_object",
+    "vitte_host_emit_assembly_object",
+    "vitte_host_verify_native_object",
+    "vitte_host_link_executable",
+    "vitte_host_run_executable",
+    "print",
+    "println",
+    "eprint",
+    "eprintln",
+    "panic",
+    "assert",
+    "len",
+    "slice",
+    "find",
+    "to_string",
+    "to_string_int",
+    "to_string_i64",
+    "to_string_u64",
+    "to_string_usize",
+    "==",
+    "!=",
+    "+",
+    "<",
+    "<=",
+    ">",
+    ">="
+};
+
 void vitte_c17_module_init_ir(
     vitte_c17_module_t *module,
     const vitte_ir_module_t *ir_module,
@@ -32,9 +72,20 @@ void vitte_c17_module_init_ir(
     memset(module, 0, sizeof(*module));
     module->ir_module = ir_module;
     module->unit = unit;
+    if (ir_module != NULL) {
+        size_t index;
+        for (index = 0u; index < VITTE_C17_NAME_COUNT; index++) {
+            const char *text = vitte_c17_known_texts[index];
+            module->known_names[index] = vitte_interner_find(ir_module->interner, text, strlen(text));
+        }
+    }
     vitte_error_init(&module->last_error);
 }
 
+static bool vitte_c17_is_name(const vitte_c17_module_t *module, const char *name, vitte_c17_known_name_t known) {
+    return name != NULL && name == module->known_names[known];
+}
+
 const vitte_error_t *vitte_c17_module_last_error(const vitte_c17_module_t *module) {
     return module != NULL ? &module->last_error : vitte_error_last();
 }
@@ -151,8 +202,8 @@ static vitte_status_t vitte_c17_emit_c_string(vitte_c17_writer_t *writer, const
     return vitte_c17_write_char(writer, '"');
 }
 
-static bool vitte_c17_is_main_name(const char *name) {
-    return name != NULL && strcmp(name, "main") == 0;
+static bool vitte_c17_is_main_name(const vitte_c17_module_t *module, const char *name) {
+    return vitte_c17_is_name(module, name, VITTE_C17_NAME_MAIN);
 }
 
 static bool vitte_c17_is_list_type(const vitte_ir_type_t *type) {
@@ -170,32 +221,39 @@ static vitte_status_t vitte_c17_emit_ir_value_ref(
 static vitte_status_t vitte_c17_emit_statement_line_end(vitte_c17_writer_t *writer);
 
 static const char *vitte_c17_function_source_name(const vitte_ir_function_t *function) {
-    if (function != NULL && function->source != NULL && function->source->kind == VITTE_HIR_FUNCTION &&
-        function->source->as.function.source_name != NULL) {
-        return function->source->as.function.source_name;
+    if (function != NULL && function->source_name != NULL) {
+        return function->source_name;
     }
     return function != NULL ? function->name : NULL;
 }
 
-static const char *vitte_c17_host_intrinsic_helper(const vitte_ir_function_t *function) {
+static const char *vitte_c17_host_intrinsic_helper(const vitte_c17_module_t *module, const vitte_ir_function_t *function) {
+    static const char *const helpers[] = {
+        "vitte_c17_host_runtime_available",
+        "vitte_c17_host_read_file",
+        "vitte_c17_host_write_file",
+        "vitte_c17_host_append_file",
+        "vitte_c17_host_file_exists",
+        "vitte_c17_host_is_file",
+        "vitte_c17_host_is_directory",
+        "vitte_c17_host_list_directory",
+        "vitte_c17_host_mkdir_all",
+        "vitte_c17_host_system",
+        "vitte_c17_host_emit_llvm_object",
+        "vitte_c17_host_emit_assembly_object",
+        "vitte_c17_host_verify_native_object",
+        "vitte_c17_host_link_executable",
+        "vitte_c17_host_run_executable"
+    };
     const char *name = vitte_c17_function_source_name(function);
+    size_t index;
 
     if (name == NULL) return NULL;
-    if (strcmp(name, "vitte_host_runtime_available") == 0) return "vitte_c17_host_runtime_available";
-    if (strcmp(name, "vitte_host_read_file") == 0) return "vitte_c17_host_read_file";
-    if (strcmp(name, "vitte_host_write_file") == 0) return "vitte_c17_host_write_file";
-    if (strcmp(name, "vitte_host_append_file") == 0) return "vitte_c17_host_append_file";
-    if (strcmp(name, "vitte_host_file_exists") == 0) return "vitte_c17_host_file_exists";
-    if (strcmp(name, "vitte_host_is_file") == 0) return "vitte_c17_host_is_file";
-    if (strcmp(name, "vitte_host_is_directory") == 0) return "vitte_c17_host_is_directory";
-    if (strcmp(name, "vitte_host_list_directory") == 0) return "vitte_c17_host_list_directory";
-    if (strcmp(name, "vitte_host_mkdir_all") == 0) return "vitte_c17_host_mkdir_all";
-    if (strcmp(name, "vitte_host_system") == 0) return "vitte_c17_host_system";
-    if (strcmp(name, "vitte_host_emit_llvm_object") == 0) return "vitte_c17_host_emit_llvm_object";
-    if (strcmp(name, "vitte_host_emit_assembly_object") == 0) return "vitte_c17_host_emit_assembly_object";
-    if (strcmp(name, "vitte_host_verify_native_object") == 0) return "vitte_c17_host_verify_native_object";
-    if (strcmp(name, "vitte_host_link_executable") == 0) return "vitte_c17_host_link_executable";
-    if (strcmp(name, "vitte_host_run_executable") == 0) return "vitte_c17_host_run_executable";
+    for (index = 0u; index < sizeof(helpers) / sizeof(helpers[0]); index++) {
+        if (vitte_c17_is_name(module, name, (vitte_c17_known_name_t)(VITTE_C17_NAME_HOST_RUNTIME_AVAILABLE + index))) {
+            return helpers[index];
+        }
+    }
     return NULL;
 }
 
@@ -259,13 +317,93 @@ static vitte_status_t vitte_c17_make_symbol_name(
     return VITTE_STATUS_OK;
 }
 
+/*
+ * Under a unit plan every IR function keeps its own name; duplicates get the
+ * ordinal in their prefix so they cannot collide with another function.
+ */
+static vitte_status_t vitte_c17_make_function_name(
+    vitte_c17_module_t *module,
+    const vitte_ir_function_t *function,
+    const char *name,
+    char *output,
+    size_t output_capacity
+) {
+    const vitte_c17_unit_symbol_t *symbol;
+    char prefix[32];
+
+    if (module->plan == NULL) {
+        return vitte_c17_make_symbol_name(module, "vitte_fn_", name, function->id, output, output_capacity);
+    }
+    symbol = vitte_c17_unit_plan_find_function(module->plan, function);
+    if (symbol == NULL) {
+        vitte_c17_module_set_error(module, VITTE_STATUS_ERROR_BACKEND, "VITTE_C17_E_NAME", "IR function is missing from the C17 unit plan", name);
+        return VITTE_STATUS_ERROR_BACKEND;
+    }
+    if (symbol->ordinal == 0u) {
+        return vitte_c17_make_internal_name("vitte_fn_", function->name, output, output_capacity, &module->last_error);
+    }
+    (void)snprintf(prefix, sizeof(prefix), "vitte_fn%" PRIu32 "_", symbol->ordinal);
+    return vitte_c17_make_internal_name(prefix, function->name, output, output_capacity, &module->last_error);
+}
+
+static void vitte_c17_module_note_value_base(vitte_c17_module_t *module, const vitte_ir_value_t *value) {
+    if (value != NULL && (value->kind == VITTE_IR_VALUE_LOCAL || value->kind == VITTE_IR_VALUE_INSTRUCTION) &&
+        value->id < module->value_base) {
+        module->value_base = value->id;
+    }
+}
+
+/* Records the first parameter, value and block ids of `function` for unit-relative names. */
+static void vitte_c17_module_begin_function(vitte_c17_module_t *module, const vitte_ir_function_t *function) {
+    const vitte_ir_value_t *parameter;
+    const vitte_ir_block_t *block;
+
+    if (module->plan == NULL || function == NULL) {
+        return;
+    }
+    module->parameter_base = UINT32_MAX;
+    module->value_base = UINT32_MAX;
+    module->block_base = UINT32_MAX;
+    for (parameter = function->first_parameter; parameter != NULL; parameter = parameter->next) {
+        if (parameter->id < module->parameter_base) {
+            module->parameter_base = parameter->id;
+        }
+    }
+    for (block = function->first_block; block != NULL; block = block->next) {
+        const vitte_ir_instruction_t *instruction;
+
+        if (block->id < module->block_base) {
+            module->block_base = block->id;
+        }
+        for (instruction = block->first; instruction != NULL; instruction = instruction->next) {
+            size_t index;
+
+            vitte_c17_module_note_value_base(module, instruction->result);
+            for (index = 0u; index < instruction->operand_count; index++) {
+                vitte_c17_module_note_value_base(module, instruction->operands[index]);
+            }
+        }
+    }
+}
+
+static uint32_t vitte_c17_module_relative_id(uint32_t id, uint32_t base, const vitte_c17_module_t *module) {
+    return module->plan != NULL && base != UINT32_MAX && id >= base ? id - base : id;
+}
+
 static vitte_status_t vitte_c17_make_block_label(
     vitte_c17_module_t *module,
     const vitte_ir_block_t *block,
     char *output,
     size_t output_capacity
 ) {
-    return vitte_c17_make_symbol_name(module, "vitte_block_", block != NULL ? block->name : "block", block != NULL ? block->id : 0u, output, output_capacity);
+    return vitte_c17_make_symbol_name(
+        module,
+        "vitte_block_",
+        block != NULL ? block->name : "block",
+        block != NULL ? vitte_c17_module_relative_id(block->id, module->block_base, module) : 0u,
+        output,
+        output_capacity
+    );
 }
 
 static vitte_status_t vitte_c17_make_value_name(
@@ -281,14 +419,28 @@ static vitte_status_t vitte_c17_make_value_name(
 
     switch (value->kind) {
         case VITTE_IR_VALUE_LOCAL:
-            return vitte_c17_make_symbol_name(module, "vitte_local_", value->name, value->id, output, output_capacity);
+            return vitte_c17_make_symbol_name(
+                module,
+                "vitte_local_",
+                value->name,
+                vitte_c17_module_relative_id(value->id, module->value_base, module),
+                output,
+                output_capacity
+            );
         case VITTE_IR_VALUE_CONST_INT:
         case VITTE_IR_VALUE_CONST_STRING:
         case VITTE_IR_VALUE_INSTRUCTION:
-            return vitte_c17_make_symbol_name(module, "vitte_tmp_", value->name != NULL ? value->name : "tmp", value->id, output, output_capacity);
+            return vitte_c17_make_symbol_name(
+                module,
+                "vitte_tmp_",
+                value->name != NULL ? value->name : "tmp",
+                vitte_c17_module_relative_id(value->id, module->value_base, module),
+                output,
+                output_capacity
+            );
         case VITTE_IR_VALUE_FUNCTION_REF:
             if (value->as.function != NULL) {
-                if (vitte_c17_is_main_name(value->as.function->name)) {
+                if (vitte_c17_is_main_name(module, value->as.function->name)) {
                     if (output_capacity < sizeof("main")) {
                         vitte_c17_module_set_error(module, VITTE_STATUS_ERROR_BACKEND, "VITTE_C17_E_NAME", "C17 symbol name buffer is too small", value->name);
                         return VITTE_STATUS_ERROR_BACKEND;
@@ -296,11 +448,18 @@ static vitte_status_t vitte_c17_make_value_name(
                     memcpy(output, "main", sizeof("main"));
                     return VITTE_STATUS_OK;
                 }
-                return vitte_c17_make_symbol_name(module, "vitte_fn_", value->name, value->as.function->id, output, output_capacity);
+                return vitte_c17_make_function_name(module, value->as.function, value->name, output, output_capacity);
             }
             return vitte_c17_sanitize_identifier(value->name, output, output_capacity, &module->last_error);
         case VITTE_IR_VALUE_PARAMETER:
-            return vitte_c17_make_symbol_name(module, "vitte_param_", value->name, value->id, output, output_capacity);
+            return vitte_c17_make_symbol_name(
+                module,
+                "vitte_param_",
+                value->name,
+                vitte_c17_module_relative_id(value->id, module->parameter_base, module),
+                output,
+                output_capacity
+            );
         case VITTE_IR_VALUE_ERROR:
         case VITTE_IR_VALUE_COUNT:
         default:
@@ -401,22 +560,18 @@ static vitte_status_t vitte_c17_emit_aggregate_ref(
     return status;
 }
 
-static bool vitte_c17_ir_builtin_supported(const char *name) {
-    return name != NULL &&
-        (strcmp(name, "print") == 0 ||
-        strcmp(name, "println") == 0 ||
-        strcmp(name, "eprint") == 0 ||
-        strcmp(name, "eprintln") == 0 ||
-        strcmp(name, "panic") == 0 ||
-        strcmp(name, "assert") == 0 ||
-        strcmp(name, "len") == 0 ||
-        strcmp(name, "slice") == 0 ||
-        strcmp(name, "find") == 0 ||
-        strcmp(name, "to_string") == 0 ||
-        strcmp(name, "to_string_int") == 0 ||
-        strcmp(name, "to_string_i64") == 0 ||
-        strcmp(name, "to_string_u64") == 0 ||
-        strcmp(name, "to_string_usize") == 0);
+static bool vitte_c17_ir_builtin_supported(const vitte_c17_module_t *module, const char *name) {
+    size_t index;
+
+    if (name == NULL) {
+        return false;
+    }
+    for (index = VITTE_C17_NAME_PRINT; index <= VITTE_C17_NAME_TO_STRING_USIZE; index++) {
+        if (vitte_c17_is_name(module, name, (vitte_c17_known_name_t)index)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 static vitte_status_t vitte_c17_emit_ir_builtin_call(
@@ -429,12 +584,12 @@ static vitte_status_t vitte_c17_emit_ir_builtin_call(
     const vitte_ir_value_t *argument = instruction->operand_count > 1u ? instruction->operands[1] : NULL;
     vitte_status_t status;
 
-    if (name == NULL || !vitte_c17_ir_builtin_supported(name)) {
+    if (name == NULL || !vitte_c17_ir_builtin_supported(module, name)) {
         vitte_c17_module_set_error(module, VITTE_STATUS_ERROR_BACKEND, "VITTE_C17_E_CALL", "unsupported builtin function for C17 IR emission", name);
         return VITTE_STATUS_ERROR_BACKEND;
     }
 
-    if (strcmp(name, "print") == 0) {
+    if (vitte_c17_is_name(module, name, VITTE_C17_NAME_PRINT)) {
         status = vitte_c17_write_string(writer, "fputs(");
         if (status != VITTE_STATUS_OK) {
             return status;
@@ -449,7 +604,7 @@ static vitte_status_t vitte_c17_emit_ir_builtin_call(
         }
         return vitte_c17_emit_statement_line_end(writer);
     }
-    if (strcmp(name, "println") == 0) {
+    if (vitte_c17_is_name(module, name, VITTE_C17_NAME_PRINTLN)) {
         status = vitte_c17_write_string(writer, "puts(");
         if (status != VITTE_STATUS_OK) {
             return status;
@@ -464,7 +619,7 @@ static vitte_status_t vitte_c17_emit_ir_builtin_call(
         }
         return vitte_c17_emit_statement_line_end(writer);
     }
-    if (strcmp(name, "eprint") == 0) {
+    if (vitte_c17_is_name(module, name, VITTE_C17_NAME_EPRINT)) {
         status = vitte_c17_write_string(writer, "fputs(");
         if (status != VITTE_STATUS_OK) {
             return status;
@@ -479,7 +634,7 @@ static vitte_status_t vitte_c17_emit_ir_builtin_call(
         }
         return vitte_c17_emit_statement_line_end(writer);
     }
-    if (strcmp(name, "eprintln") == 0) {
+    if (vitte_c17_is_name(module, name, VITTE_C17_NAME_EPRINTLN)) {
         status = vitte_c17_write_string(writer, "fprintf(stderr, \"%s\\n\", ");
         if (status != VITTE_STATUS_OK) {
             return status;
@@ -494,7 +649,7 @@ static vitte_status_t vitte_c17_emit_ir_builtin_call(
         }
         return vitte_c17_emit_statement_line_end(writer);
     }
-    if (strcmp(name, "panic") == 0) {
+    if (vitte_c17_is_name(module, name, VITTE_C17_NAME_PANIC)) {
         status = vitte_c17_write_string(writer, "fprintf(stderr, \"%s\\n\", ");
         if (status != VITTE_STATUS_OK) {
             return status;
@@ -517,7 +672,7 @@ static vitte_status_t vitte_c17_emit_ir_builtin_call(
         }
         return vitte_c17_emit_statement_line_end(writer);
     }
-    if (strcmp(name, "assert") == 0) {
+    if (vitte_c17_is_name(module, name, VITTE_C17_NAME_ASSERT)) {
         status = vitte_c17_write_string(writer, "assert(");
         if (status != VITTE_STATUS_OK) {
             return status;
@@ -532,7 +687,7 @@ static vitte_status_t vitte_c17_emit_ir_builtin_call(
         }
         return vitte_c17_emit_statement_line_end(writer);
     }
-    if (strcmp(name, "find") == 0) {
+    if (vitte_c17_is_name(module, name, VITTE_C17_NAME_FIND)) {
         if (instruction->result == NULL || instruction->operand_count < 3u) {
             return vitte_c17_emit_statement_line_end(writer);
         }
@@ -557,9 +712,9 @@ static vitte_status_t vitte_c17_emit_ir_builtin_call(
         if (status != VITTE_STATUS_OK) return status;
         return vitte_c17_emit_statement_line_end(writer);
     }
-    if (strcmp(name, "to_string") == 0 || strcmp(name, "to_string_int") == 0 ||
-        strcmp(name, "to_string_i64") == 0 || strcmp(name, "to_string_u64") == 0 ||
-        strcmp(name, "to_string_usize") == 0) {
+    if (vitte_c17_is_name(module, name, VITTE_C17_NAME_TO_STRING) || vitte_c17_is_name(module, name, VITTE_C17_NAME_TO_STRING_INT) ||
+        vitte_c17_is_name(module, name, VITTE_C17_NAME_TO_STRING_I64) || vitte_c17_is_name(module, name, VITTE_C17_NAME_TO_STRING_U64) ||
+        vitte_c17_is_name(module, name, VITTE_C17_NAME_TO_STRING_USIZE)) {
         if (instruction->result == NULL || instruction->result->type == NULL || instruction->result->type->kind == VITTE_IR_TYPE_VOID || argument == NULL) {
             return vitte_c17_emit_statement_line_end(writer);
         }
@@ -573,7 +728,7 @@ static vitte_status_t vitte_c17_emit_ir_builtin_call(
         if (status != VITTE_STATUS_OK) return status;
         return vitte_c17_emit_statement_line_end(writer);
     }
-    if (strcmp(name, "slice") == 0) {
+    if (vitte_c17_is_name(module, name, VITTE_C17_NAME_SLICE)) {
         if (instruction->operand_count <= 1u ||
             instruction->operands[1] == NULL ||
             instruction->operands[1]->type == NULL ||
@@ -624,10 +779,10 @@ static vitte_status_t vitte_c17_emit_ir_call(
     }
 
     callee = instruction->operands[0];
-    builtin = callee != NULL && callee->kind == VITTE_IR_VALUE_FUNCTION_REF && callee->as.function == NULL && vitte_c17_ir_builtin_supported(callee->name);
+    builtin = callee != NULL && callee->kind == VITTE_IR_VALUE_FUNCTION_REF && callee->as.function == NULL && vitte_c17_ir_builtin_supported(module, callee->name);
     assign_result = instruction->result != NULL && instruction->result->type != NULL && instruction->result->type->kind != VITTE_IR_TYPE_VOID;
 
-    if (builtin && strcmp(callee->name, "len") == 0) {
+    if (builtin && vitte_c17_is_name(module, callee->name, VITTE_C17_NAME_LEN)) {
         if (assign_result) {
             status = vitte_c17_emit_ir_value_ref(module, writer, instruction->result);
             if (status != VITTE_STATUS_OK) {
@@ -846,7 +1001,7 @@ static vitte_status_t vitte_c17_emit_ir_instruction(
                 instruction->operands[0]->type->kind == VITTE_IR_TYPE_STRING_PTR &&
                 instruction->operands[1]->type->kind == VITTE_IR_TYPE_STRING_PTR) {
                 if (instruction->operator_text != NULL &&
-                    (strcmp(instruction->operator_text, "==") == 0 || strcmp(instruction->operator_text, "!=") == 0)) {
+                    (vitte_c17_is_name(module, instruction->operator_text, VITTE_C17_NAME_EQ) || vitte_c17_is_name(module, instruction->operator_text, VITTE_C17_NAME_NE))) {
                     status = vitte_c17_write_string(writer, "vitte_string_equal(");
                     if (status != VITTE_STATUS_OK) return status;
                     status = vitte_c17_emit_ir_value_ref(module, writer, instruction->operands[0]);
@@ -855,9 +1010,9 @@ static vitte_status_t vitte_c17_emit_ir_instruction(
                     if (status != VITTE_STATUS_OK) return status;
                     status = vitte_c17_emit_ir_value_ref(module, writer, instruction->operands[1]);
                     if (status != VITTE_STATUS_OK) return status;
-                    status = vitte_c17_write_format(writer, ") %s true", strcmp(instruction->operator_text, "==") == 0 ? "==" : "!=");
+                    status = vitte_c17_write_format(writer, ") %s true", vitte_c17_is_name(module, instruction->operator_text, VITTE_C17_NAME_EQ) ? "==" : "!=");
                     if (status != VITTE_STATUS_OK) return status;
-                } else if (instruction->operator_text != NULL && strcmp(instruction->operator_text, "+") == 0) {
+                } else if (instruction->operator_text != NULL && vitte_c17_is_name(module, instruction->operator_text, VITTE_C17_NAME_ADD)) {
                     status = vitte_c17_write_string(writer, "vitte_string_concat(");
                     if (status != VITTE_STATUS_OK) return status;
                     status = vitte_c17_emit_ir_value_ref(module, writer, instruction->operands[0]);
@@ -869,8 +1024,8 @@ static vitte_status_t vitte_c17_emit_ir_instruction(
                     status = vitte_c17_write_char(writer, ')');
                     if (status != VITTE_STATUS_OK) return status;
                 } else if (instruction->operator_text != NULL &&
-                    (strcmp(instruction->operator_text, "<") == 0 || strcmp(instruction->operator_text, "<=") == 0 ||
-                        strcmp(instruction->operator_text, ">") == 0 || strcmp(instruction->operator_text, ">=") == 0)) {
+                    (vitte_c17_is_name(module, instruction->operator_text, VITTE_C17_NAME_LT) || vitte_c17_is_name(module, instruction->operator_text, VITTE_C17_NAME_LE) ||
+                        vitte_c17_is_name(module, instruction->operator_text, VITTE_C17_NAME_GT) || vitte_c17_is_name(module, instruction->operator_text, VITTE_C17_NAME_GE))) {
                     status = vitte_c17_write_string(writer, "vitte_string_compare(");
                     if (status != VITTE_STATUS_OK) return status;
                     status = vitte_c17_emit_ir_value_ref(module, writer, instruction->operands[0]);
@@ -894,7 +1049,7 @@ static vitte_status_t vitte_c17_emit_ir_instruction(
                 instruction->operator_text != NULL) {
                 if (instruction->result != NULL && instruction->result->type != NULL &&
                     instruction->result->type->kind == VITTE_IR_TYPE_AGGREGATE_PTR) {
-                    if (strcmp(instruction->operator_text, "+") == 0 &&
+                    if (vitte_c17_is_name(module, instruction->operator_text, VITTE_C17_NAME_ADD) &&
                         vitte_c17_is_list_type(instruction->operands[0]->type) &&
                         vitte_c17_is_list_type(instruction->operands[1]->type)) {
                         status = vitte_c17_write_string(writer, "vitte_aggregate_concat(");
@@ -1168,7 +1323,8 @@ static vitte_status_t vitte_c17_emit_ir_function_signature(
         vitte_c17_module_set_error(module, VITTE_STATUS_ERROR_BACKEND, "VITTE_C17_E_FUNCTION", "missing IR function", NULL);
         return VITTE_STATUS_ERROR_BACKEND;
     }
-    if (vitte_c17_is_main_name(function->name)) {
+    vitte_c17_module_begin_function(module, function);
+    if (vitte_c17_is_main_name(module, function->name)) {
         status = vitte_c17_write_string(
             writer,
             (vitte_c17_is_bootstrap_compiler_source(module) || function->parameter_count > 0u) ?
@@ -1178,7 +1334,7 @@ static vitte_status_t vitte_c17_emit_ir_function_signature(
             return status;
         }
         return VITTE_STATUS_OK;
-    } else if (vitte_c17_make_symbol_name(module, "vitte_fn_", function->name, function->id, function_name, sizeof(function_name)) != VITTE_STATUS_OK) {
+    } else if (vitte_c17_make_function_name(module, function, function->name, function_name, sizeof(function_name)) != VITTE_STATUS_OK) {
         return module->last_error.status;
     }
     status = vitte_c17_emit_ir_type(module, writer, function->return_type);
@@ -1250,7 +1406,7 @@ static vitte_status_t vitte_c17_emit_ir_function_body(
     char entry_label[128];
     vitte_status_t status;
 
-    if (function != NULL && vitte_c17_is_main_name(function->name) && vitte_c17_is_bootstrap_compiler_source(module)) {
+    if (function != NULL && vitte_c17_is_main_name(module, function->name) && vitte_c17_is_bootstrap_compiler_source(module)) {
         const char *lines[] = {
             "static void vitte_stage0_ensure_parent_dirs(const char *path) {",
             "    char scratch[4096];",
@@ -2031,7 +2187,7 @@ static vitte_status_t vitte_c17_emit_ir_function_body(
         return status;
     }
 
-    host_intrinsic_helper = vitte_c17_host_intrinsic_helper(function);
+    host_intrinsic_helper = vitte_c17_host_intrinsic_helper(module, function);
     if (host_intrinsic_helper != NULL) {
         return vitte_c17_emit_host_intrinsic_return(module, writer, function, host_intrinsic_helper);
     }
@@ -2040,7 +2196,7 @@ static vitte_status_t vitte_c17_emit_ir_function_body(
     if (status != VITTE_STATUS_OK) {
         return status;
     }
-    if (vitte_c17_is_main_name(function->name)) {
+    if (vitte_c17_is_main_name(module, function->name)) {
         const vitte_ir_value_t *parameter;
         for (parameter = function->first_parameter; parameter != NULL; parameter = parameter->next) {
             status = vitte_c17_emit_ir_type(module, writer, parameter->type);
@@ -2263,28 +2419,21 @@ static vitte_status_t vitte_c17_emit_ir_form(vitte_c17_module_t *module, vitte_c
     return status;
 }
 
-static vitte_status_t vitte_c17_module_emit_ir(vitte_c17_module_t *module, vitte_c17_writer_t *writer) {
+vitte_status_t vitte_c17_module_emit_types(vitte_c17_module_t *module, vitte_c17_writer_t *writer) {
     const vitte_ir_pick_t *pick;
     const vitte_ir_form_t *form;
-    const vitte_ir_global_t *global;
-    const vitte_ir_function_t *function;
     vitte_status_t status;
 
-    if (module->ir_module == NULL) {
-        vitte_c17_module_set_error(module, VITTE_STATUS_ERROR_BACKEND, "VITTE_C17_E_MODULE", "C17 backend expected IR module root", NULL);
-        return VITTE_STATUS_ERROR_BACKEND;
-    }
-
-    status = vitte_c17_translation_unit_emit_prelude(module->unit, writer);
-    if (status != VITTE_STATUS_OK) {
-        return status;
+    if (module == NULL || writer == NULL || module->ir_module == NULL) {
+        vitte_c17_module_set_error(module, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_C17_E_MODULE", "missing C17 module or writer", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
 
     for (pick = module->ir_module->first_pick; pick != NULL; pick = pick->next) {
         const vitte_ir_pick_t *previous_pick;
         bool already_emitted = false;
         for (previous_pick = module->ir_module->first_pick; previous_pick != NULL && previous_pick != pick; previous_pick = previous_pick->next) {
-            if (previous_pick->name != NULL && pick->name != NULL && strcmp(previous_pick->name, pick->name) == 0) {
+            if (previous_pick->name != NULL && previous_pick->name == pick->name) {
                 already_emitted = true;
                 break;
             }
@@ -2306,7 +2455,7 @@ static vitte_status_t vitte_c17_module_emit_ir(vitte_c17_module_t *module, vitte
         const vitte_ir_form_t *previous_form;
         bool already_emitted = false;
         for (previous_form = module->ir_module->first_form; previous_form != NULL && previous_form != form; previous_form = previous_form->next) {
-            if (previous_form->name != NULL && form->name != NULL && strcmp(previous_form->name, form->name) == 0) {
+            if (previous_form->name != NULL && previous_form->name == form->name) {
                 already_emitted = true;
                 break;
             }
@@ -2319,13 +2468,64 @@ static vitte_status_t vitte_c17_module_emit_ir(vitte_c17_module_t *module, vitte
         status = vitte_c17_write_newline(writer);
         if (status != VITTE_STATUS_OK) return status;
     }
+    return VITTE_STATUS_OK;
+}
+
+vitte_status_t vitte_c17_module_emit_global(
+    vitte_c17_module_t *module,
+    vitte_c17_writer_t *writer,
+    const vitte_ir_global_t *global
+) {
+    vitte_status_t status = vitte_c17_emit_ir_global(module, writer, global);
+
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
+    return vitte_c17_write_newline(writer);
+}
+
+vitte_status_t vitte_c17_module_emit_prototype(
+    vitte_c17_module_t *module,
+    vitte_c17_writer_t *writer,
+    const vitte_ir_function_t *function
+) {
+    return vitte_c17_emit_ir_function_prototype(module, writer, function);
+}
+
+vitte_status_t vitte_c17_module_emit_function(
+    vitte_c17_module_t *module,
+    vitte_c17_writer_t *writer,
+    const vitte_ir_function_t *function
+) {
+    vitte_status_t status = vitte_c17_emit_ir_function_body(module, writer, function);
+
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
+    return vitte_c17_write_newline(writer);
+}
+
+static vitte_status_t vitte_c17_module_emit_ir(vitte_c17_module_t *module, vitte_c17_writer_t *writer) {
+    const vitte_ir_global_t *global;
+    const vitte_ir_function_t *function;
+    vitte_status_t status;
+
+    if (module->ir_module == NULL) {
+        vitte_c17_module_set_error(module, VITTE_STATUS_ERROR_BACKEND, "VITTE_C17_E_MODULE", "C17 backend expected IR module root", NULL);
+        return VITTE_STATUS_ERROR_BACKEND;
+    }
+
+    status = vitte_c17_translation_unit_emit_prelude(module->unit, writer);
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
+    status = vitte_c17_module_emit_types(module, writer);
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
 
     for (global = module->ir_module->first_global; global != NULL; global = global->next) {
-        status = vitte_c17_emit_ir_global(module, writer, global);
-        if (status != VITTE_STATUS_OK) {
-            return status;
-        }
-        status = vitte_c17_write_newline(writer);
+        status = vitte_c17_module_emit_global(module, writer, global);
         if (status != VITTE_STATUS_OK) {
             return status;
         }
@@ -2343,11 +2543,7 @@ static vitte_status_t vitte_c17_module_emit_ir(vitte_c17_module_t *module, vitte
         }
     }
     for (function = module->ir_module->first_function; function != NULL; function = function->next) {
-        status = vitte_c17_emit_ir_function_body(module, writer, function);
-        if (status != VITTE_STATUS_OK) {
-            return status;
-        }
-        status = vitte_c17_write_newline(writer);
+        status = vitte_c17_module_emit_function(module, writer, function);
         if (status != VITTE_STATUS_OK) {
             return status;
         }
@@ -4,15 +4,74 @@
 #include "../../api/error.h"
 #include "../../ir/ir.h"
 #include "translation_unit.h"
+#include "units.h"
 #include "writer.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Names the emitter tests IR names against; see `vitte_c17_module_t.known_names`. */
+typedef enum vitte_c17_known_name {
+    VITTE_C17_NAME_MAIN,
+    VITTE_C17_NAME_HOST_RUNTIME_AVAILABLE,
+    VITTE_C17_NAME_HOST_READ_FILE,
+    VITTE_C17_NAME_HOST_WRITE_FILE,
+    VITTE_C17_NAME_HOST_APPEND_FILE,
+    VITTE_C17_NAME_HOST_FILE_EXISTS,
+    VITTE_C17_NAME_HOST_IS_FILE,
+    VITTE_C17_NAME_HOST_IS_DIRECTORY,
+    VITTE_C17_NAME_HOST_LIST_DIRECTORY,
+    VITTE_C17_NAME_HOST_MKDIR_ALL,
+    VITTE_C17_NAME_HOST_SYSTEM,
+    VITTE_C17_NAME_HOST_EMIT_LLVM_OBJECT,
+    VITTE_C17_NAME_HOST_EMIT_ASSEMBLY_OBJECT,
+    VITTE_C17_NAME_HOST_VERIFY_NATIVE_OBJECT,
+    VITTE_C17_NAME_HOST_LINK_EXECUTABLE,
+    VITTE_C17_NAME_HOST_RUN_EXECUTABLE,
+    VITTE_C17_NAME_PRINT,
+    VITTE_C17_NAME_PRINTLN,
+    VITTE_C17_NAME_EPRINT,
+    VITTE_C17_NAME_EPRINTLN,
+    VITTE_C17_NAME_PANIC,
+    VITTE_C17_NAME_ASSERT,
+    VITTE_C17_NAME_LEN,
+    VITTE_C17_NAME_SLICE,
+    VITTE_C17_NAME_FIND,
+    VITTE_C17_NAME_TO_STRING,
+    VITTE_C17_NAME_TO_STRING_INT,
+    VITTE_C17_NAME_TO_STRING_I64,
+    VITTE_C17_NAME_TO_STRING_U64,
+    VITTE_C17_NAME_TO_STRING_USIZE,
+    VITTE_C17_NAME_EQ,
+    VITTE_C17_NAME_NE,
+    VITTE_C17_NAME_ADD,
+    VITTE_C17_NAME_LT,
+    VITTE_C17_NAME_LE,
+    VITTE_C17_NAME_GT,
+    VITTE_C17_NAME_GE,
+    VITTE_C17_NAME_COUNT
+} vitte_c17_known_name_t;
+
+/*
+ * With a unit plan, C names no longer embed IR ids: functions are named after
+ * the IR function (see `vitte_c17_unit_symbol_t.ordinal`) and parameters,
+ * locals and labels are numbered from the function's first id, so a unit's
+ * text only changes when its own module does.
+ */
 typedef struct vitte_c17_module {
     const vitte_ir_module_t *ir_module;
     vitte_c17_translation_unit_t *unit;
+    const vitte_c17_unit_plan_t *plan;
+    vitte_ir_value_id_t parameter_base;
+    vitte_ir_value_id_t value_base;
+    vitte_ir_block_id_t block_base;
+    /*
+     * IR names live in the module's interner, so each known name is looked up
+     * there once and then compared by address. A name the module never
+     * interned stays NULL and matches nothing.
+     */
+    const char *known_names[VITTE_C17_NAME_COUNT];
     vitte_error_t last_error;
 } vitte_c17_module_t;
 
@@ -25,6 +84,24 @@ void vitte_c17_module_init_ir(
 const vitte_error_t *vitte_c17_module_last_error(const vitte_c17_module_t *module);
 vitte_status_t vitte_c17_module_emit(vitte_c17_module_t *module, vitte_c17_writer_t *writer);
 
+/* Pieces of `vitte_c17_module_emit`, used to write one translation unit per module. */
+vitte_status_t vitte_c17_module_emit_types(vitte_c17_module_t *module, vitte_c17_writer_t *writer);
+vitte_status_t vitte_c17_module_emit_global(
+    vitte_c17_module_t *module,
+    vitte_c17_writer_t *writer,
+    const vitte_ir_global_t *global
+);
+vitte_status_t vitte_c17_module_emit_prototype(
+    vitte_c17_module_t *module,
+    vitte_c17_writer_t *writer,
+    const vitte_ir_function_t *function
+);
+vitte_status_t vitte_c17_module_emit_function(
+    vitte_c17_module_t *module,
+    vitte_c17_writer_t *writer,
+    const vitte_ir_function_t *function
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -153,3 +153,25 @@ vitte_status_t vitte_c17_make_internal_name(
     }
     return VITTE_STATUS_OK;
 }
+
+const char *vitte_c17_symbol_owner(const char *name, size_t *length) {
+    static const char prefix[] = "__vitte_import__";
+    const char *owner;
+    const char *end;
+
+    if (length != NULL) {
+        *length = 0u;
+    }
+    if (name == NULL || strncmp(name, prefix, sizeof(prefix) - 1u) != 0) {
+        return NULL;
+    }
+    owner = name + sizeof(prefix) - 1u;
+    end = strstr(owner, "__");
+    if (end == NULL || end == owner) {
+        return NULL;
+    }
+    if (length != NULL) {
+        *length = (size_t)(end - owner);
+    }
+    return owner;
+}
@@ -32,6 +32,13 @@ vitte_status_t vitte_c17_make_internal_name(
     vitte_error_t *error
 );
 
+/*
+ * Flattening lowers imported declarations to `__vitte_import__<module>__<name>`.
+ * Returns the `<module>` part of such a symbol and its length, or NULL for
+ * declarations of the root module.
+ */
+const char *vitte_c17_symbol_owner(const char *name, size_t *length);
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,7 @@ void vitte_c17_options_init(vitte_c17_options_t *options) {
     options->emit_includes = true;
     options->emit_main_wrapper = false;
     options->emit_debug_comments = false;
+    options->split_units = false;
 }
 
 vitte_status_t vitte_c17_options_validate(const vitte_c17_options_t *options, vitte_error_t *error) {
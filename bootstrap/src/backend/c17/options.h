@@ -23,6 +23,7 @@ typedef struct vitte_c17_options {
     bool emit_includes;
     bool emit_main_wrapper;
     bool emit_debug_comments;
+    bool split_units;
 } vitte_c17_options_t;
 
 void vitte_c17_options_init(vitte_c17_options_t *options);
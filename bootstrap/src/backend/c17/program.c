@@ -1,5 +1,7 @@
 #include "program.h"
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "module.h"
@@ -71,3 +73,286 @@ vitte_status_t vitte_c17_program_emit(vitte_c17_program_t *program, vitte_c17_wr
     program->module_count = 1u;
     return VITTE_STATUS_OK;
 }
+
+static bool vitte_c17_program_files_equal(const char *left_path, const char *right_path) {
+    FILE *left = fopen(left_path, "rb");
+    FILE *right = left != NULL ? fopen(right_path, "rb") : NULL;
+    char left_chunk[4096];
+    char right_chunk[4096];
+    bool equal = left != NULL && right != NULL;
+
+    while (equal) {
+        size_t left_size = fread(left_chunk, 1u, sizeof(left_chunk), left);
+        size_t right_size = fread(right_chunk, 1u, sizeof(right_chunk), right);
+
+        if (left_size != right_size || memcmp(left_chunk, right_chunk, left_size) != 0) {
+            equal = false;
+        } else if (left_size < sizeof(left_chunk)) {
+            break;
+        }
+    }
+    if (left != NULL) {
+        fclose(left);
+    }
+    if (right != NULL) {
+        fclose(right);
+    }
+    return equal;
+}
+
+typedef enum vitte_c17_unit_file_kind {
+    VITTE_C17_UNIT_FILE_PROGRAM_HEADER = 0,
+    VITTE_C17_UNIT_FILE_HEADER,
+    VITTE_C17_UNIT_FILE_SOURCE
+} vitte_c17_unit_file_kind_t;
+
+typedef struct vitte_c17_unit_emitter {
+    vitte_c17_program_t *program;
+    vitte_c17_translation_unit_t unit;
+    vitte_c17_module_t module;
+    vitte_c17_unit_plan_t plan;
+    size_t *marks;
+} vitte_c17_unit_emitter_t;
+
+static vitte_status_t vitte_c17_program_emit_guard(vitte_c17_writer_t *writer, const char *stem, bool open) {
+    char guard[VITTE_C17_UNIT_STEM_CAPACITY + 16u];
+    size_t index;
+    vitte_status_t status;
+
+    (void)snprintf(guard, sizeof(guard), "VITTE_UNIT_%s_H", stem);
+    for (index = 0u; guard[index] != '\0'; index++) {
+        if (guard[index] >= 'a' && guard[index] <= 'z') {
+            guard[index] = (char)(guard[index] - 'a' + 'A');
+        }
+    }
+    if (!open) {
+        return vitte_c17_write_format(writer, "#endif /* %s */", guard);
+    }
+    status = vitte_c17_write_format(writer, "#ifndef %s", guard);
+    if (status == VITTE_STATUS_OK) status = vitte_c17_write_newline(writer);
+    if (status == VITTE_STATUS_OK) status = vitte_c17_write_format(writer, "#define %s", guard);
+    if (status == VITTE_STATUS_OK) status = vitte_c17_write_newline(writer);
+    return status;
+}
+
+/* Prototypes of functions in other units that `unit` calls, in first-use order. */
+static vitte_status_t vitte_c17_program_emit_imports(
+    vitte_c17_unit_emitter_t *emitter,
+    vitte_c17_writer_t *writer,
+    size_t unit_index
+) {
+    const vitte_c17_unit_t *unit = &emitter->plan.units[unit_index];
+    size_t function_index;
+    vitte_status_t status = VITTE_STATUS_OK;
+
+    for (function_index = 0u; status == VITTE_STATUS_OK && function_index < unit->function_count; function_index++) {
+        const vitte_ir_block_t *block;
+
+        for (block = unit->functions[function_index]->first_block; status == VITTE_STATUS_OK && block != NULL; block = block->next) {
+            const vitte_ir_instruction_t *instruction;
+
+            for (instruction = block->first; status == VITTE_STATUS_OK && instruction != NULL; instruction = instruction->next) {
+                size_t operand;
+
+                for (operand = 0u; status == VITTE_STATUS_OK && operand < instruction->operand_count; operand++) {
+                    const vitte_ir_value_t *value = instruction->operands[operand];
+                    const vitte_c17_unit_symbol_t *symbol;
+
+                    if (value == NULL || value->kind != VITTE_IR_VALUE_FUNCTION_REF || value->as.function == NULL) {
+                        continue;
+                    }
+                    symbol = vitte_c17_unit_plan_find_function(&emitter->plan, value->as.function);
+                    if (symbol == NULL || symbol->unit == unit_index || emitter->marks[symbol->index] == unit_index + 1u) {
+                        continue;
+                    }
+                    emitter->marks[symbol->index] = unit_index + 1u;
+                    status = vitte_c17_module_emit_prototype(&emitter->module, writer, symbol->function);
+                }
+            }
+        }
+    }
+    return status;
+}
+
+static vitte_status_t vitte_c17_program_emit_unit_file(
+    vitte_c17_unit_emitter_t *emitter,
+    vitte_c17_writer_t *writer,
+    vitte_c17_unit_file_kind_t kind,
+    size_t unit_index
+) {
+    const vitte_c17_unit_t *unit = kind == VITTE_C17_UNIT_FILE_PROGRAM_HEADER ? NULL : &emitter->plan.units[unit_index];
+    size_t index;
+    vitte_status_t status;
+
+    switch (kind) {
+        case VITTE_C17_UNIT_FILE_PROGRAM_HEADER:
+            status = vitte_c17_program_emit_guard(writer, "program", true);
+            if (status == VITTE_STATUS_OK) status = vitte_c17_translation_unit_emit_prelude(&emitter->unit, writer);
+            if (status == VITTE_STATUS_OK) status = vitte_c17_module_emit_types(&emitter->module, writer);
+            if (status == VITTE_STATUS_OK) status = vitte_c17_program_emit_guard(writer, "program", false);
+            break;
+        case VITTE_C17_UNIT_FILE_HEADER:
+            status = vitte_c17_program_emit_guard(writer, unit->stem, true);
+            if (status == VITTE_STATUS_OK) status = vitte_c17_write_string(writer, "#include \"" VITTE_C17_UNIT_PROGRAM_HEADER "\"");
+            if (status == VITTE_STATUS_OK) status = vitte_c17_write_newline(writer);
+            if (status == VITTE_STATUS_OK) status = vitte_c17_write_newline(writer);
+            for (index = 0u; status == VITTE_STATUS_OK && index < unit->function_count; index++) {
+                status = vitte_c17_module_emit_prototype(&emitter->module, writer, unit->functions[index]);
+            }
+            if (status == VITTE_STATUS_OK) status = vitte_c17_write_newline(writer);
+            if (status == VITTE_STATUS_OK) status = vitte_c17_program_emit_guard(writer, unit->stem, false);
+            break;
+        case VITTE_C17_UNIT_FILE_SOURCE:
+        default:
+            status = vitte_c17_write_format(writer, "#include \"%s.h\"", unit->stem);
+            if (status == VITTE_STATUS_OK) status = vitte_c17_write_newline(writer);
+            if (status == VITTE_STATUS_OK) status = vitte_c17_write_newline(writer);
+            if (status == VITTE_STATUS_OK) status = vitte_c17_program_emit_imports(emitter, writer, unit_index);
+            if (status == VITTE_STATUS_OK) status = vitte_c17_write_newline(writer);
+            for (index = 0u; status == VITTE_STATUS_OK && index < unit->global_count; index++) {
+                status = vitte_c17_module_emit_global(&emitter->module, writer, unit->globals[index]);
+            }
+            for (index = 0u; status == VITTE_STATUS_OK && index < unit->function_count; index++) {
+                status = vitte_c17_module_emit_function(&emitter->module, writer, unit->functions[index]);
+            }
+            break;
+    }
+    if (status == VITTE_STATUS_OK) {
+        status = vitte_c17_write_newline(writer);
+    }
+    return status;
+}
+
+/* Writes one file through a temporary sibling and only replaces the original when it changed. */
+static vitte_status_t vitte_c17_program_write_unit_file(
+    vitte_c17_unit_emitter_t *emitter,
+    const char *directory,
+    const char *name,
+    vitte_c17_unit_file_kind_t kind,
+    size_t unit_index
+) {
+    vitte_c17_program_t *program = emitter->program;
+    char path[4096];
+    char temporary_path[4096 + 8];
+    vitte_c17_writer_t writer;
+    FILE *stream;
+    vitte_status_t status;
+    int written = snprintf(path, sizeof(path), "%s/%s", directory, name);
+
+    if (written < 0 || (size_t)written >= sizeof(path)) {
+        vitte_c17_program_set_error(program, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_C17_E_FILE", "C17 unit path is too long", name);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    (void)snprintf(temporary_path, sizeof(temporary_path), "%s.tmp", path);
+    stream = fopen(temporary_path, "wb");
+    if (stream == NULL) {
+        vitte_c17_program_set_error(program, VITTE_STATUS_ERROR_IO, "VITTE_C17_E_FILE", "failed to open C17 unit file", temporary_path);
+        return VITTE_STATUS_ERROR_IO;
+    }
+    status = vitte_c17_writer_init_file(&writer, stream, &program->options);
+    if (status == VITTE_STATUS_OK) {
+        status = vitte_c17_program_emit_unit_file(emitter, &writer, kind, unit_index);
+        if (status != VITTE_STATUS_OK && vitte_error_is_set(vitte_c17_writer_last_error(&writer))) {
+            vitte_error_copy(&program->last_error, vitte_c17_writer_last_error(&writer));
+        } else if (status != VITTE_STATUS_OK) {
+            vitte_error_copy(&program->last_error, vitte_c17_module_last_error(&emitter->module));
+        }
+    }
+    if (status == VITTE_STATUS_OK) {
+        status = vitte_c17_writer_flush(&writer);
+        if (status != VITTE_STATUS_OK) {
+            vitte_error_copy(&program->last_error, vitte_c17_writer_last_error(&writer));
+        }
+    }
+    if (fclose(stream) != 0 && status == VITTE_STATUS_OK) {
+        vitte_c17_program_set_error(program, VITTE_STATUS_ERROR_IO, "VITTE_C17_E_FILE", "failed to close C17 unit file", temporary_path);
+        status = VITTE_STATUS_ERROR_IO;
+    }
+    if (status != VITTE_STATUS_OK) {
+        (void)remove(temporary_path);
+        return status;
+    }
+    if (vitte_c17_program_files_equal(temporary_path, path)) {
+        (void)remove(temporary_path);
+        return VITTE_STATUS_OK;
+    }
+    if (rename(temporary_path, path) != 0) {
+        (void)remove(temporary_path);
+        vitte_c17_program_set_error(program, VITTE_STATUS_ERROR_IO, "VITTE_C17_E_FILE", "failed to replace C17 unit file", path);
+        return VITTE_STATUS_ERROR_IO;
+    }
+    program->files_written++;
+    return VITTE_STATUS_OK;
+}
+
+vitte_status_t vitte_c17_program_emit_units(
+    vitte_c17_program_t *program,
+    const char *directory,
+    vitte_c17_unit_list_t *units
+) {
+    vitte_c17_unit_emitter_t emitter;
+    char name[VITTE_C17_UNIT_STEM_CAPACITY + 4u];
+    vitte_status_t status;
+    size_t index;
+
+    if (program == NULL || directory == NULL || units == NULL) {
+        vitte_c17_program_set_error(program, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_C17_E_PROGRAM", "missing C17 program, unit directory, or unit list", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    if (program->ir == NULL || !vitte_ir_is_initialized(program->ir) || program->ir->module == NULL) {
+        vitte_c17_program_set_error(program, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_C17_E_IR", "C17 backend requires an initialized IR with a module", NULL);
+        return VITTE_STATUS_ERROR_INVALID_STATE;
+    }
+    status = vitte_c17_options_validate(&program->options, &program->last_error);
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
+
+    memset(&emitter, 0, sizeof(emitter));
+    emitter.program = program;
+    program->options.split_units = true;
+    vitte_c17_translation_unit_init(&emitter.unit, &program->options);
+    vitte_c17_module_init_ir(&emitter.module, program->ir->module, &emitter.unit);
+    vitte_c17_unit_plan_init(&emitter.plan);
+    status = vitte_c17_unit_plan_build(&emitter.plan, program->ir->module);
+    if (status != VITTE_STATUS_OK) {
+        vitte_error_copy(&program->last_error, vitte_c17_unit_plan_last_error(&emitter.plan));
+        vitte_c17_unit_plan_destroy(&emitter.plan);
+        return status;
+    }
+    emitter.module.plan = &emitter.plan;
+    emitter.marks = (size_t *)calloc(emitter.plan.symbol_count + 1u, sizeof(*emitter.marks));
+    units->stems = (char (*)[VITTE_C17_UNIT_STEM_CAPACITY])calloc(emitter.plan.unit_count, sizeof(*units->stems));
+    if (emitter.marks == NULL || units->stems == NULL) {
+        free(emitter.marks);
+        vitte_c17_unit_list_destroy(units);
+        vitte_c17_unit_plan_destroy(&emitter.plan);
+        vitte_c17_program_set_error(program, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_C17_E_PROGRAM", "failed to allocate C17 unit list", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+
+    status = vitte_c17_program_write_unit_file(&emitter, directory, VITTE_C17_UNIT_PROGRAM_HEADER, VITTE_C17_UNIT_FILE_PROGRAM_HEADER, 0u);
+    for (index = 0u; status == VITTE_STATUS_OK && index < emitter.plan.unit_count; index++) {
+        const char *stem = emitter.plan.units[index].stem;
+
+        (void)snprintf(name, sizeof(name), "%s.h", stem);
+        status = vitte_c17_program_write_unit_file(&emitter, directory, name, VITTE_C17_UNIT_FILE_HEADER, index);
+        if (status == VITTE_STATUS_OK) {
+            (void)snprintf(name, sizeof(name), "%s.c", stem);
+            status = vitte_c17_program_write_unit_file(&emitter, directory, name, VITTE_C17_UNIT_FILE_SOURCE, index);
+        }
+        if (status == VITTE_STATUS_OK) {
+            memcpy(units->stems[index], stem, sizeof(units->stems[index]));
+            units->count++;
+            program->function_count += emitter.plan.units[index].function_count;
+        }
+    }
+    if (status == VITTE_STATUS_OK) {
+        program->module_count = emitter.plan.unit_count;
+    } else {
+        vitte_c17_unit_list_destroy(units);
+    }
+    free(emitter.marks);
+    vitte_c17_unit_plan_destroy(&emitter.plan);
+    return status;
+}
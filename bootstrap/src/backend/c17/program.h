@@ -6,6 +6,7 @@
 #include "../../api/error.h"
 #include "../../ir/ir.h"
 #include "options.h"
+#include "units.h"
 #include "writer.h"
 
 #ifdef __cplusplus
@@ -16,6 +17,8 @@ typedef struct vitte_c17_program {
     const vitte_ir_t *ir;
     vitte_c17_options_t options;
     size_t module_count;
+    size_t files_written;
+    size_t function_count;
     vitte_error_t last_error;
 } vitte_c17_program_t;
 
@@ -28,6 +31,19 @@ void vitte_c17_program_init_ir(
 const vitte_error_t *vitte_c17_program_last_error(const vitte_c17_program_t *program);
 vitte_status_t vitte_c17_program_emit(vitte_c17_program_t *program, vitte_c17_writer_t *writer);
 
+/*
+ * Writes the program as one translation unit per Vitte module into the
+ * existing `directory`: `vitte_program.h` (prelude and shared types), then a
+ * `<stem>.h` with the unit's prototypes and a `<stem>.c` with its globals and
+ * bodies. Files whose content did not change are left untouched;
+ * `files_written` counts the others. `units` receives the stems, root first.
+ */
+vitte_status_t vitte_c17_program_emit_units(
+    vitte_c17_program_t *program,
+    const char *directory,
+    vitte_c17_unit_list_t *units
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,291 @@
+#include "units.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "naming.h"
+#include "../../util/util.h"
+
+static void vitte_c17_unit_plan_set_error(
+    vitte_c17_unit_plan_t *plan,
+    vitte_status_t status,
+    const char *code,
+    const char *message,
+    const char *details
+) {
+    if (plan != NULL) {
+        vitte_error_set_details(&plan->last_error, status, code, message, details);
+    }
+}
+
+void vitte_c17_unit_list_init(vitte_c17_unit_list_t *list) {
+    if (list != NULL) {
+        memset(list, 0, sizeof(*list));
+    }
+}
+
+void vitte_c17_unit_list_destroy(vitte_c17_unit_list_t *list) {
+    if (list != NULL) {
+        free(list->stems);
+        vitte_c17_unit_list_init(list);
+    }
+}
+
+void vitte_c17_unit_plan_init(vitte_c17_unit_plan_t *plan) {
+    if (plan == NULL) {
+        return;
+    }
+    memset(plan, 0, sizeof(*plan));
+    vitte_error_init(&plan->last_error);
+}
+
+void vitte_c17_unit_plan_destroy(vitte_c17_unit_plan_t *plan) {
+    size_t index;
+
+    if (plan == NULL) {
+        return;
+    }
+    for (index = 0u; index < plan->unit_count; index++) {
+        free((void *)plan->units[index].functions);
+        free((void *)plan->units[index].globals);
+    }
+    free(plan->units);
+    free(plan->unit_slots);
+    free(plan->symbols);
+    free(plan->symbol_slots);
+    vitte_c17_unit_plan_init(plan);
+}
+
+const vitte_error_t *vitte_c17_unit_plan_last_error(const vitte_c17_unit_plan_t *plan) {
+    return plan != NULL ? &plan->last_error : vitte_error_last();
+}
+
+static size_t vitte_c17_unit_slot_capacity(size_t count) {
+    size_t capacity = 16u;
+
+    while (capacity < count * 2u) {
+        capacity *= 2u;
+    }
+    return capacity;
+}
+
+static bool vitte_c17_unit_append_function(vitte_c17_unit_t *unit, const vitte_ir_function_t *function) {
+    if (unit->function_count == unit->function_capacity) {
+        size_t capacity = unit->function_capacity == 0u ? 8u : unit->function_capacity * 2u;
+        const vitte_ir_function_t **functions = (const vitte_ir_function_t **)realloc(
+            (void *)unit->functions,
+            capacity * sizeof(*functions)
+        );
+
+        if (functions == NULL) {
+            return false;
+        }
+        unit->functions = functions;
+        unit->function_capacity = capacity;
+    }
+    unit->functions[unit->function_count++] = function;
+    return true;
+}
+
+static bool vitte_c17_unit_append_global(vitte_c17_unit_t *unit, const vitte_ir_global_t *global) {
+    if (unit->global_count == unit->global_capacity) {
+        size_t capacity = unit->global_capacity == 0u ? 8u : unit->global_capacity * 2u;
+        const vitte_ir_global_t **globals = (const vitte_ir_global_t **)realloc(
+            (void *)unit->globals,
+            capacity * sizeof(*globals)
+        );
+
+        if (globals == NULL) {
+            return false;
+        }
+        unit->globals = globals;
+        unit->global_capacity = capacity;
+    }
+    unit->globals[unit->global_count++] = global;
+    return true;
+}
+
+static vitte_status_t vitte_c17_unit_add(vitte_c17_unit_plan_t *plan, const char *owner, size_t owner_length, size_t *index) {
+    vitte_c17_unit_t *unit;
+
+    if (owner_length + 3u > VITTE_C17_UNIT_STEM_CAPACITY) {
+        vitte_c17_unit_plan_set_error(plan, VITTE_STATUS_ERROR_BACKEND, "VITTE_C17_E_UNIT", "module name is too long for a C17 unit file", owner);
+        return VITTE_STATUS_ERROR_BACKEND;
+    }
+    unit = &plan->units[plan->unit_count];
+    memset(unit, 0, sizeof(*unit));
+    if (owner == NULL) {
+        memcpy(unit->stem, VITTE_C17_UNIT_ROOT_STEM, sizeof(VITTE_C17_UNIT_ROOT_STEM));
+    } else {
+        unit->stem[0] = 'm';
+        unit->stem[1] = '_';
+        memcpy(unit->stem + 2u, owner, owner_length);
+        unit->stem[owner_length + 2u] = '\0';
+    }
+    *index = plan->unit_count++;
+    return VITTE_STATUS_OK;
+}
+
+static vitte_status_t vitte_c17_unit_for_symbol(vitte_c17_unit_plan_t *plan, const char *name, size_t *index) {
+    size_t owner_length;
+    const char *owner = vitte_c17_symbol_owner(name, &owner_length);
+    size_t mask = plan->unit_slot_capacity - 1u;
+    size_t position;
+    vitte_status_t status;
+
+    if (owner == NULL) {
+        *index = 0u;
+        return VITTE_STATUS_OK;
+    }
+    position = (size_t)vitte_util_hash_bytes(VITTE_UTIL_HASH_SEED, owner, owner_length) & mask;
+    while (plan->unit_slots[position] != 0u) {
+        const char *stem = plan->units[plan->unit_slots[position] - 1u].stem + 2u;
+
+        if (strncmp(stem, owner, owner_length) == 0 && stem[owner_length] == '\0') {
+            *index = plan->unit_slots[position] - 1u;
+            return VITTE_STATUS_OK;
+        }
+        position = (position + 1u) & mask;
+    }
+    status = vitte_c17_unit_add(plan, owner, owner_length, index);
+    if (status == VITTE_STATUS_OK) {
+        plan->unit_slots[position] = *index + 1u;
+    }
+    return status;
+}
+
+static uint32_t vitte_c17_unit_name_ordinal(
+    vitte_c17_unit_plan_t *plan,
+    size_t *name_slots,
+    size_t capacity,
+    size_t symbol_index
+) {
+    /* IR function names are interned, so equal names share one address. */
+    const char *name = plan->symbols[symbol_index].function->name;
+    size_t mask = capacity - 1u;
+    size_t position = vitte_util_hash_pointer(name) & mask;
+    uint32_t ordinal = 0u;
+
+    while (name_slots[position] != 0u) {
+        const vitte_c17_unit_symbol_t *previous = &plan->symbols[name_slots[position] - 1u];
+
+        if (previous->function->name == name) {
+            ordinal = previous->ordinal + 1u;
+            break;
+        }
+        position = (position + 1u) & mask;
+    }
+    /* The slot keeps the newest symbol so the next duplicate counts on from it. */
+    name_slots[position] = symbol_index + 1u;
+    return ordinal;
+}
+
+vitte_status_t vitte_c17_unit_plan_build(vitte_c17_unit_plan_t *plan, const vitte_ir_module_t *module) {
+    const vitte_ir_function_t *function;
+    const vitte_ir_global_t *global;
+    size_t *name_slots;
+    size_t function_count = 0u;
+    size_t global_count = 0u;
+    size_t index;
+    vitte_status_t status;
+
+    if (plan == NULL || module == NULL) {
+        vitte_c17_unit_plan_set_error(plan, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_C17_E_UNIT", "missing C17 unit plan or IR module", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    for (function = module->first_function; function != NULL; function = function->next) {
+        function_count++;
+    }
+    for (global = module->first_global; global != NULL; global = global->next) {
+        global_count++;
+    }
+
+    plan->unit_capacity = function_count + global_count + 1u;
+    plan->units = (vitte_c17_unit_t *)calloc(plan->unit_capacity, sizeof(*plan->units));
+    plan->unit_slot_capacity = vitte_c17_unit_slot_capacity(plan->unit_capacity);
+    plan->unit_slots = (size_t *)calloc(plan->unit_slot_capacity, sizeof(*plan->unit_slots));
+    plan->symbols = (vitte_c17_unit_symbol_t *)calloc(function_count + 1u, sizeof(*plan->symbols));
+    plan->symbol_slot_capacity = vitte_c17_unit_slot_capacity(function_count + 1u);
+    plan->symbol_slots = (size_t *)calloc(plan->symbol_slot_capacity, sizeof(*plan->symbol_slots));
+    name_slots = (size_t *)calloc(plan->symbol_slot_capacity, sizeof(*name_slots));
+    if (plan->units == NULL || plan->unit_slots == NULL || plan->symbols == NULL ||
+        plan->symbol_slots == NULL || name_slots == NULL) {
+        free(name_slots);
+        vitte_c17_unit_plan_set_error(plan, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_C17_E_UNIT", "failed to allocate C17 unit plan", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+
+    status = vitte_c17_unit_add(plan, NULL, 0u, &index);
+    for (function = module->first_function; status == VITTE_STATUS_OK && function != NULL; function = function->next) {
+        vitte_c17_unit_symbol_t *symbol = &plan->symbols[plan->symbol_count];
+        vitte_c17_unit_t *unit;
+        size_t mask = plan->symbol_slot_capacity - 1u;
+        size_t position = vitte_util_hash_pointer(function) & mask;
+
+        if (function->name == NULL) {
+            vitte_c17_unit_plan_set_error(plan, VITTE_STATUS_ERROR_BACKEND, "VITTE_C17_E_UNIT", "IR function without a name", NULL);
+            status = VITTE_STATUS_ERROR_BACKEND;
+            break;
+        }
+        status = vitte_c17_unit_for_symbol(plan, function->name, &index);
+        if (status != VITTE_STATUS_OK) {
+            break;
+        }
+        unit = &plan->units[index];
+        if (!vitte_c17_unit_append_function(unit, function)) {
+            status = VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        symbol->function = function;
+        symbol->index = plan->symbol_count;
+        symbol->unit = index;
+        symbol->ordinal = vitte_c17_unit_name_ordinal(plan, name_slots, plan->symbol_slot_capacity, plan->symbol_count);
+        while (plan->symbol_slots[position] != 0u) {
+            position = (position + 1u) & mask;
+        }
+        plan->symbol_slots[position] = ++plan->symbol_count;
+    }
+    for (global = module->first_global; status == VITTE_STATUS_OK && global != NULL; global = global->next) {
+        vitte_c17_unit_t *unit;
+
+        status = vitte_c17_unit_for_symbol(plan, global->name, &index);
+        if (status != VITTE_STATUS_OK) {
+            break;
+        }
+        unit = &plan->units[index];
+        if (!vitte_c17_unit_append_global(unit, global)) {
+            status = VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        }
+    }
+    free(name_slots);
+    if (status == VITTE_STATUS_ERROR_OUT_OF_MEMORY) {
+        vitte_c17_unit_plan_set_error(plan, status, "VITTE_C17_E_UNIT", "failed to allocate C17 unit plan", NULL);
+    }
+    if (status == VITTE_STATUS_OK) {
+        vitte_error_reset(&plan->last_error);
+    }
+    return status;
+}
+
+const vitte_c17_unit_symbol_t *vitte_c17_unit_plan_find_function(
+    const vitte_c17_unit_plan_t *plan,
+    const vitte_ir_function_t *function
+) {
+    size_t mask;
+    size_t position;
+
+    if (plan == NULL || function == NULL || plan->symbol_slot_capacity == 0u) {
+        return NULL;
+    }
+    mask = plan->symbol_slot_capacity - 1u;
+    position = vitte_util_hash_pointer(function) & mask;
+    while (plan->symbol_slots[position] != 0u) {
+        const vitte_c17_unit_symbol_t *symbol = &plan->symbols[plan->symbol_slots[position] - 1u];
+
+        if (symbol->function == function) {
+            return symbol;
+        }
+        position = (position + 1u) & mask;
+    }
+    return NULL;
+}
@@ -0,0 +1,81 @@
+#ifndef VITTE_BOOTSTRAP_BACKEND_C17_UNITS_H
+#define VITTE_BOOTSTRAP_BACKEND_C17_UNITS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../api/error.h"
+#include "../../ir/ir.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VITTE_C17_UNIT_STEM_CAPACITY ((size_t)192u)
+#define VITTE_C17_UNIT_ROOT_STEM "root"
+#define VITTE_C17_UNIT_PROGRAM_HEADER "vitte_program.h"
+
+/*
+ * One translation unit per Vitte module of the flattened program. Unit 0 is
+ * the root module; imported modules follow in the order their first
+ * declaration appears in the IR.
+ */
+typedef struct vitte_c17_unit {
+    char stem[VITTE_C17_UNIT_STEM_CAPACITY];
+    const vitte_ir_function_t **functions;
+    size_t function_count;
+    size_t function_capacity;
+    const vitte_ir_global_t **globals;
+    size_t global_count;
+    size_t global_capacity;
+} vitte_c17_unit_t;
+
+/*
+ * `ordinal` disambiguates IR functions sharing a name (0 for the first one),
+ * so C names depend only on the function's own name and never on IR ids.
+ */
+typedef struct vitte_c17_unit_symbol {
+    const vitte_ir_function_t *function;
+    size_t index;
+    size_t unit;
+    uint32_t ordinal;
+} vitte_c17_unit_symbol_t;
+
+typedef struct vitte_c17_unit_plan {
+    vitte_c17_unit_t *units;
+    size_t unit_count;
+    size_t unit_capacity;
+    size_t *unit_slots;
+    size_t unit_slot_capacity;
+    vitte_c17_unit_symbol_t *symbols;
+    size_t symbol_count;
+    size_t *symbol_slots;
+    size_t symbol_slot_capacity;
+    vitte_error_t last_error;
+} vitte_c17_unit_plan_t;
+
+/* File stems of the units written for a split program, root first. */
+typedef struct vitte_c17_unit_list {
+    char (*stems)[VITTE_C17_UNIT_STEM_CAPACITY];
+    size_t count;
+} vitte_c17_unit_list_t;
+
+void vitte_c17_unit_list_init(vitte_c17_unit_list_t *list);
+void vitte_c17_unit_list_destroy(vitte_c17_unit_list_t *list);
+
+void vitte_c17_unit_plan_init(vitte_c17_unit_plan_t *plan);
+void vitte_c17_unit_plan_destroy(vitte_c17_unit_plan_t *plan);
+const vitte_error_t *vitte_c17_unit_plan_last_error(const vitte_c17_unit_plan_t *plan);
+
+/* Assigns every function and global of `module` to the unit of its owning Vitte module. */
+vitte_status_t vitte_c17_unit_plan_build(vitte_c17_unit_plan_t *plan, const vitte_ir_module_t *module);
+const vitte_c17_unit_symbol_t *vitte_c17_unit_plan_find_function(
+    const vitte_c17_unit_plan_t *plan,
+    const vitte_ir_function_t *function
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VITTE_BOOTSTRAP_BACKEND_C17_UNITS_H */
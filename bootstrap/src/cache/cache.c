@@ -0,0 +1,2051 @@
+#include "cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "../api/version.h"
+#include "../util/util.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#define VITTE_CACHE_HAVE_GETPID 1
+#define VITTE_CACHE_HAVE_POSIX_FS 1
+#endif
+
+#define VITTE_CACHE_MAGIC "VTMCACHE"
+
+/*
+ * Entry layout: a fixed header, the module's string table (NUL-terminated
+ * strings, deduplicated), one kind byte per AST node, then varint-encoded
+ * node records and module metadata. Node and string references are stored
+ * as index + 1 so that zero encodes NULL.
+ */
+typedef struct vitte_cache_header {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t abi_version;
+    uint64_t key_high;
+    uint64_t key_low;
+    uint64_t string_bytes;
+    uint64_t string_count;
+    uint64_t node_count;
+    uint64_t record_bytes;
+    uint64_t payload_hash;
+} vitte_cache_header_t;
+
+/* Sections of one entry, located from its header. */
+typedef struct vitte_cache_entry {
+    const char *strings;
+    size_t string_bytes;
+    size_t string_count;
+    const unsigned char *kinds;
+    size_t node_count;
+    const unsigned char *records;
+    size_t record_bytes;
+} vitte_cache_entry_t;
+
+typedef enum vitte_cache_resident_kind {
+    VITTE_CACHE_RESIDENT_MODULE = 0,
+    VITTE_CACHE_RESIDENT_GRAPH
+} vitte_cache_resident_kind_t;
+
+/*
+ * Resident tier: entries chained in power-of-two buckets by key. Module
+ * entries keep their located sections, so a hit decodes straight from
+ * memory. Entries are only freed by a trim or on destroy, never while a
+ * build may be decoding from them.
+ */
+typedef struct vitte_cache_resident_entry {
+    vitte_cache_key_t key;
+    vitte_cache_resident_kind_t kind;
+    char *data;
+    size_t size;
+    size_t used;
+    vitte_cache_entry_t sections;
+    struct vitte_cache_resident_entry *next;
+} vitte_cache_resident_entry_t;
+
+struct vitte_cache_resident {
+    vitte_cache_resident_entry_t **buckets;
+    size_t bucket_count;
+    size_t count;
+    size_t bytes;
+    size_t limit;
+    size_t clock;
+};
+
+typedef enum vitte_cache_field_kind {
+    VITTE_CACHE_FIELD_END = 0,
+    VITTE_CACHE_FIELD_STRING,
+    VITTE_CACHE_FIELD_NODE,
+    VITTE_CACHE_FIELD_LIST,
+    VITTE_CACHE_FIELD_BOOL,
+    VITTE_CACHE_FIELD_INT,
+    VITTE_CACHE_FIELD_IMPORT_KIND
+} vitte_cache_field_kind_t;
+
+typedef struct vitte_cache_field {
+    unsigned char kind;
+    unsigned short offset;
+} vitte_cache_field_t;
+
+#define VITTE_CACHE_FIELD(field_kind, member) { VITTE_CACHE_FIELD_##field_kind, (unsigned short)offsetof(vitte_ast_node_t, as.member) }
+#define VITTE_CACHE_FIELDS_END { VITTE_CACHE_FIELD_END, 0u }
+
+/* Serialized payload of each node kind; the module index is rebuilt after loading. */
+static const vitte_cache_field_t vitte_cache_error_fields[] = { VITTE_CACHE_FIELD(STRING, error_node.message), VITTE_CACHE_FIELDS_END };
+static const vitte_cache_field_t vitte_cache_module_fields[] = {
+    VITTE_CACHE_FIELD(STRING, module.name), VITTE_CACHE_FIELD(LIST, module.imports), VITTE_CACHE_FIELD(LIST, module.exports),
+    VITTE_CACHE_FIELD(LIST, module.declarations), VITTE_CACHE_FIELD(BOOL, module.export_all), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_import_fields[] = {
+    VITTE_CACHE_FIELD(STRING, import_decl.path), VITTE_CACHE_FIELD(STRING, import_decl.alias),
+    VITTE_CACHE_FIELD(BOOL, import_decl.relative), VITTE_CACHE_FIELD(IMPORT_KIND, import_decl.import_kind), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_export_fields[] = {
+    VITTE_CACHE_FIELD(STRING, export_decl.local_name), VITTE_CACHE_FIELD(STRING, export_decl.export_name), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_proc_fields[] = {
+    VITTE_CACHE_FIELD(STRING, proc_decl.name), VITTE_CACHE_FIELD(BOOL, proc_decl.exported), VITTE_CACHE_FIELD(STRING, proc_decl.lowered_name),
+    VITTE_CACHE_FIELD(LIST, proc_decl.parameters), VITTE_CACHE_FIELD(NODE, proc_decl.return_type), VITTE_CACHE_FIELD(NODE, proc_decl.body),
+    VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_param_fields[] = {
+    VITTE_CACHE_FIELD(STRING, param_decl.name), VITTE_CACHE_FIELD(NODE, param_decl.type),
+    VITTE_CACHE_FIELD(BOOL, param_decl.mutable_value), VITTE_CACHE_FIELD(BOOL, param_decl.by_ref), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_const_fields[] = {
+    VITTE_CACHE_FIELD(STRING, const_decl.name), VITTE_CACHE_FIELD(BOOL, const_decl.exported), VITTE_CACHE_FIELD(STRING, const_decl.lowered_name),
+    VITTE_CACHE_FIELD(NODE, const_decl.type), VITTE_CACHE_FIELD(NODE, const_decl.value), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_pick_fields[] = {
+    VITTE_CACHE_FIELD(STRING, pick_decl.name), VITTE_CACHE_FIELD(BOOL, pick_decl.exported), VITTE_CACHE_FIELD(LIST, pick_decl.variants),
+    VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_pick_variant_fields[] = { VITTE_CACHE_FIELD(STRING, pick_variant.name), VITTE_CACHE_FIELDS_END };
+static const vitte_cache_field_t vitte_cache_form_fields[] = {
+    VITTE_CACHE_FIELD(STRING, form_decl.name), VITTE_CACHE_FIELD(BOOL, form_decl.exported), VITTE_CACHE_FIELD(LIST, form_decl.fields),
+    VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_form_field_fields[] = {
+    VITTE_CACHE_FIELD(STRING, form_field.name), VITTE_CACHE_FIELD(NODE, form_field.type), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_block_stmt_fields[] = { VITTE_CACHE_FIELD(LIST, block_stmt.statements), VITTE_CACHE_FIELDS_END };
+static const vitte_cache_field_t vitte_cache_give_fields[] = { VITTE_CACHE_FIELD(NODE, give_stmt.value), VITTE_CACHE_FIELDS_END };
+static const vitte_cache_field_t vitte_cache_let_fields[] = {
+    VITTE_CACHE_FIELD(STRING, let_stmt.name), VITTE_CACHE_FIELD(NODE, let_stmt.type), VITTE_CACHE_FIELD(NODE, let_stmt.value),
+    VITTE_CACHE_FIELD(BOOL, let_stmt.mutable_value), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_assign_fields[] = {
+    VITTE_CACHE_FIELD(NODE, assign_stmt.target), VITTE_CACHE_FIELD(NODE, assign_stmt.value), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_expr_stmt_fields[] = { VITTE_CACHE_FIELD(NODE, expr_stmt.value), VITTE_CACHE_FIELDS_END };
+static const vitte_cache_field_t vitte_cache_if_stmt_fields[] = {
+    VITTE_CACHE_FIELD(NODE, if_stmt.condition), VITTE_CACHE_FIELD(NODE, if_stmt.then_branch), VITTE_CACHE_FIELD(NODE, if_stmt.else_branch),
+    VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_while_fields[] = {
+    VITTE_CACHE_FIELD(NODE, while_stmt.condition), VITTE_CACHE_FIELD(NODE, while_stmt.body), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_empty_fields[] = { VITTE_CACHE_FIELDS_END };
+static const vitte_cache_field_t vitte_cache_for_fields[] = {
+    VITTE_CACHE_FIELD(STRING, for_stmt.name), VITTE_CACHE_FIELD(NODE, for_stmt.iterable), VITTE_CACHE_FIELD(NODE, for_stmt.body),
+    VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_integer_fields[] = { VITTE_CACHE_FIELD(INT, integer_literal.value), VITTE_CACHE_FIELDS_END };
+static const vitte_cache_field_t vitte_cache_string_fields[] = { VITTE_CACHE_FIELD(STRING, string_literal.value), VITTE_CACHE_FIELDS_END };
+static const vitte_cache_field_t vitte_cache_identifier_fields[] = {
+    VITTE_CACHE_FIELD(STRING, identifier.name), VITTE_CACHE_FIELD(STRING, identifier.lowered_name), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_binary_fields[] = {
+    VITTE_CACHE_FIELD(STRING, binary_expr.operator_text), VITTE_CACHE_FIELD(NODE, binary_expr.left), VITTE_CACHE_FIELD(NODE, binary_expr.right),
+    VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_call_fields[] = {
+    VITTE_CACHE_FIELD(NODE, call_expr.callee), VITTE_CACHE_FIELD(LIST, call_expr.arguments), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_list_fields[] = { VITTE_CACHE_FIELD(LIST, list_expr.elements), VITTE_CACHE_FIELDS_END };
+static const vitte_cache_field_t vitte_cache_record_fields[] = {
+    VITTE_CACHE_FIELD(STRING, record_expr.type_name), VITTE_CACHE_FIELD(LIST, record_expr.fields), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_record_field_fields[] = {
+    VITTE_CACHE_FIELD(STRING, record_field.name), VITTE_CACHE_FIELD(NODE, record_field.value), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_cast_fields[] = {
+    VITTE_CACHE_FIELD(NODE, cast_expr.value), VITTE_CACHE_FIELD(NODE, cast_expr.type), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_index_fields[] = {
+    VITTE_CACHE_FIELD(NODE, index_expr.base), VITTE_CACHE_FIELD(NODE, index_expr.index), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_if_expr_fields[] = {
+    VITTE_CACHE_FIELD(NODE, if_expr.condition), VITTE_CACHE_FIELD(NODE, if_expr.then_value), VITTE_CACHE_FIELD(NODE, if_expr.else_value),
+    VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_member_fields[] = {
+    VITTE_CACHE_FIELD(NODE, member_expr.base), VITTE_CACHE_FIELD(STRING, member_expr.member), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_block_expr_fields[] = {
+    VITTE_CACHE_FIELD(LIST, block_expr.statements), VITTE_CACHE_FIELD(NODE, block_expr.value), VITTE_CACHE_FIELDS_END
+};
+static const vitte_cache_field_t vitte_cache_type_name_fields[] = { VITTE_CACHE_FIELD(STRING, type_name.name), VITTE_CACHE_FIELDS_END };
+
+static const vitte_cache_field_t *const vitte_cache_node_fields[VITTE_AST_NODE_COUNT] = {
+    [VITTE_AST_NODE_ERROR] = vitte_cache_error_fields,
+    [VITTE_AST_NODE_MODULE] = vitte_cache_module_fields,
+    [VITTE_AST_NODE_IMPORT_DECL] = vitte_cache_import_fields,
+    [VITTE_AST_NODE_EXPORT_DECL] = vitte_cache_export_fields,
+    [VITTE_AST_NODE_PROC_DECL] = vitte_cache_proc_fields,
+    [VITTE_AST_NODE_PARAM_DECL] = vitte_cache_param_fields,
+    [VITTE_AST_NODE_CONST_DECL] = vitte_cache_const_fields,
+    [VITTE_AST_NODE_PICK_DECL] = vitte_cache_pick_fields,
+    [VITTE_AST_NODE_PICK_VARIANT] = vitte_cache_pick_variant_fields,
+    [VITTE_AST_NODE_FORM_DECL] = vitte_cache_form_fields,
+    [VITTE_AST_NODE_FORM_FIELD] = vitte_cache_form_field_fields,
+    [VITTE_AST_NODE_BLOCK_STMT] = vitte_cache_block_stmt_fields,
+    [VITTE_AST_NODE_GIVE_STMT] = vitte_cache_give_fields,
+    [VITTE_AST_NODE_LET_STMT] = vitte_cache_let_fields,
+    [VITTE_AST_NODE_ASSIGN_STMT] = vitte_cache_assign_fields,
+    [VITTE_AST_NODE_EXPR_STMT] = vitte_cache_expr_stmt_fields,
+    [VITTE_AST_NODE_IF_STMT] = vitte_cache_if_stmt_fields,
+    [VITTE_AST_NODE_WHILE_STMT] = vitte_cache_while_fields,
+    [VITTE_AST_NODE_BREAK_STMT] = vitte_cache_empty_fields,
+    [VITTE_AST_NODE_CONTINUE_STMT] = vitte_cache_empty_fields,
+    [VITTE_AST_NODE_FOR_STMT] = vitte_cache_for_fields,
+    [VITTE_AST_NODE_INTEGER_LITERAL] = vitte_cache_integer_fields,
+    [VITTE_AST_NODE_STRING_LITERAL] = vitte_cache_string_fields,
+    [VITTE_AST_NODE_IDENTIFIER] = vitte_cache_identifier_fields,
+    [VITTE_AST_NODE_BINARY_EXPR] = vitte_cache_binary_fields,
+    [VITTE_AST_NODE_CALL_EXPR] = vitte_cache_call_fields,
+    [VITTE_AST_NODE_LIST_EXPR] = vitte_cache_list_fields,
+    [VITTE_AST_NODE_RECORD_EXPR] = vitte_cache_record_fields,
+    [VITTE_AST_NODE_RECORD_FIELD] = vitte_cache_record_field_fields,
+    [VITTE_AST_NODE_CAST_EXPR] = vitte_cache_cast_fields,
+    [VITTE_AST_NODE_INDEX_EXPR] = vitte_cache_index_fields,
+    [VITTE_AST_NODE_IF_EXPR] = vitte_cache_if_expr_fields,
+    [VITTE_AST_NODE_MEMBER_EXPR] = vitte_cache_member_fields,
+    [VITTE_AST_NODE_BLOCK_EXPR] = vitte_cache_block_expr_fields,
+    [VITTE_AST_NODE_TYPE_NAME] = vitte_cache_type_name_fields
+};
+
+typedef struct vitte_cache_buffer {
+    unsigned char *data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} vitte_cache_buffer_t;
+
+typedef struct vitte_cache_encoder {
+    vitte_cache_buffer_t strings;
+    vitte_cache_buffer_t records;
+    const vitte_ast_node_t **nodes;
+    size_t node_count;
+    size_t node_capacity;
+    size_t *node_slots;
+    size_t node_slot_capacity;
+    size_t *string_offsets;
+    size_t string_count;
+    size_t string_capacity;
+    size_t *string_slots;
+    size_t string_slot_capacity;
+    bool failed;
+} vitte_cache_encoder_t;
+
+typedef struct vitte_cache_decoder {
+    const unsigned char *cursor;
+    const unsigned char *end;
+    const char **strings;
+    size_t string_count;
+    vitte_ast_node_t **nodes;
+    size_t node_count;
+    bool failed;
+} vitte_cache_decoder_t;
+
+static void vitte_cache_set_error(
+    vitte_error_t *error,
+    vitte_status_t status,
+    const char *code,
+    const char *message,
+    const char *details
+) {
+    if (error != NULL) {
+        vitte_error_set_details(error, status, code, message, details);
+    }
+}
+
+void vitte_cache_key_init(vitte_cache_key_t *key) {
+    if (key == NULL) {
+        return;
+    }
+    key->high = 0x6a09e667f3bcc908u;
+    key->low = VITTE_UTIL_HASH_SEED;
+    vitte_cache_key_add_size(key, VITTE_CACHE_FORMAT_VERSION);
+    vitte_cache_key_add_text(key, vitte_version_string());
+    vitte_cache_key_add_text(key, vitte_build_id());
+}
+
+/* Two independent 64-bit streams: FNV-1a and a multiply-rotate mix. */
+void vitte_cache_key_add(vitte_cache_key_t *key, const void *data, size_t size) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    uint64_t high;
+    size_t index;
+
+    if (key == NULL || (data == NULL && size > 0u)) {
+        return;
+    }
+    high = key->high;
+    for (index = 0u; index < size; index++) {
+        high = (high ^ bytes[index]) * 0x9e3779b97f4a7c15u;
+        high = (high << 27) | (high >> 37);
+    }
+    key->high = high;
+    key->low = vitte_util_hash_bytes(key->low, data, size);
+}
+
+void vitte_cache_key_add_text(vitte_cache_key_t *key, const char *text) {
+    if (text == NULL) {
+        vitte_cache_key_add(key, "", 1u);
+        return;
+    }
+    vitte_cache_key_add(key, text, strlen(text) + 1u);
+}
+
+void vitte_cache_key_add_size(vitte_cache_key_t *key, size_t value) {
+    uint64_t wide = (uint64_t)value;
+    vitte_cache_key_add(key, &wide, sizeof(wide));
+}
+
+void vitte_cache_key_add_key(vitte_cache_key_t *key, const vitte_cache_key_t *value) {
+    if (value != NULL) {
+        vitte_cache_key_add(key, &value->high, sizeof(value->high));
+        vitte_cache_key_add(key, &value->low, sizeof(value->low));
+    }
+}
+
+bool vitte_cache_key_equal(const vitte_cache_key_t *left, const vitte_cache_key_t *right) {
+    return left != NULL && right != NULL && left->high == right->high && left->low == right->low;
+}
+
+bool vitte_cache_key_is_zero(const vitte_cache_key_t *key) {
+    return key == NULL || (key->high == 0u && key->low == 0u);
+}
+
+static void vitte_cache_key_add_tree(vitte_cache_key_t *key, const vitte_ast_node_t *node) {
+    const vitte_cache_field_t *field;
+    unsigned char marker;
+
+    if (node == NULL || (size_t)node->kind >= (size_t)VITTE_AST_NODE_COUNT) {
+        marker = 0u;
+        vitte_cache_key_add(key, &marker, 1u);
+        return;
+    }
+    marker = (unsigned char)(node->kind + 1);
+    vitte_cache_key_add(key, &marker, 1u);
+    for (field = vitte_cache_node_fields[node->kind]; field->kind != VITTE_CACHE_FIELD_END; field++) {
+        const unsigned char *slot = (const unsigned char *)node + field->offset;
+
+        if (node->kind == VITTE_AST_NODE_PROC_DECL && field->offset == offsetof(vitte_ast_node_t, as.proc_decl.body)) {
+            continue;
+        }
+        switch (field->kind) {
+            case VITTE_CACHE_FIELD_STRING: {
+                const char *text;
+                memcpy(&text, slot, sizeof(text));
+                marker = text != NULL ? 1u : 0u;
+                vitte_cache_key_add(key, &marker, 1u);
+                if (text != NULL) {
+                    vitte_cache_key_add_text(key, text);
+                }
+                break;
+            }
+            case VITTE_CACHE_FIELD_NODE: {
+                const vitte_ast_node_t *child;
+                memcpy(&child, slot, sizeof(child));
+                vitte_cache_key_add_tree(key, child);
+                break;
+            }
+            case VITTE_CACHE_FIELD_LIST: {
+                vitte_ast_list_t list;
+                const vitte_ast_node_t *item;
+                memcpy(&list, slot, sizeof(list));
+                vitte_cache_key_add_size(key, list.count);
+                for (item = list.first; item != NULL; item = item->next) {
+                    vitte_cache_key_add_tree(key, item);
+                }
+                break;
+            }
+            case VITTE_CACHE_FIELD_BOOL: {
+                bool value;
+                memcpy(&value, slot, sizeof(value));
+                marker = value ? 1u : 0u;
+                vitte_cache_key_add(key, &marker, 1u);
+                break;
+            }
+            case VITTE_CACHE_FIELD_INT: {
+                int64_t value;
+                memcpy(&value, slot, sizeof(value));
+                vitte_cache_key_add(key, &value, sizeof(value));
+                break;
+            }
+            case VITTE_CACHE_FIELD_IMPORT_KIND: {
+                vitte_ast_import_kind_t value;
+                memcpy(&value, slot, sizeof(value));
+                vitte_cache_key_add_size(key, (size_t)value);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void vitte_cache_key_add_interface(vitte_cache_key_t *key, const vitte_ast_node_t *module) {
+    if (key != NULL) {
+        vitte_cache_key_add_tree(key, module);
+    }
+}
+
+static size_t vitte_cache_resident_bucket(
+    const struct vitte_cache_resident *resident,
+    const vitte_cache_key_t *key,
+    vitte_cache_resident_kind_t kind
+) {
+    return (size_t)(key->low ^ key->high ^ (uint64_t)kind) & (resident->bucket_count - 1u);
+}
+
+static void vitte_cache_resident_destroy(struct vitte_cache_resident *resident) {
+    size_t index;
+
+    if (resident == NULL) {
+        return;
+    }
+    for (index = 0u; index < resident->bucket_count; index++) {
+        vitte_cache_resident_entry_t *entry = resident->buckets[index];
+
+        while (entry != NULL) {
+            vitte_cache_resident_entry_t *next = entry->next;
+
+            free(entry->data);
+            free(entry);
+            entry = next;
+        }
+    }
+    free(resident->buckets);
+    free(resident);
+}
+
+/* Called with the cache lock held; a hit counts as a use for eviction. */
+static vitte_cache_resident_entry_t *vitte_cache_resident_find(
+    struct vitte_cache_resident *resident,
+    const vitte_cache_key_t *key,
+    vitte_cache_resident_kind_t kind
+) {
+    vitte_cache_resident_entry_t *entry;
+
+    if (resident == NULL) {
+        return NULL;
+    }
+    for (entry = resident->buckets[vitte_cache_resident_bucket(resident, key, kind)]; entry != NULL; entry = entry->next) {
+        if (entry->kind == kind && vitte_cache_key_equal(&entry->key, key)) {
+            entry->used = ++resident->clock;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void vitte_cache_resident_grow(struct vitte_cache_resident *resident) {
+    size_t bucket_count = resident->bucket_count * 2u;
+    vitte_cache_resident_entry_t **buckets;
+    size_t index;
+
+    buckets = (vitte_cache_resident_entry_t **)calloc(bucket_count, sizeof(*buckets));
+    if (buckets == NULL) {
+        return;
+    }
+    for (index = 0u; index < resident->bucket_count; index++) {
+        vitte_cache_resident_entry_t *entry = resident->buckets[index];
+
+        while (entry != NULL) {
+            vitte_cache_resident_entry_t *next = entry->next;
+            size_t position = (size_t)(entry->key.low ^ entry->key.high ^ (uint64_t)entry->kind) & (bucket_count - 1u);
+
+            entry->next = buckets[position];
+            buckets[position] = entry;
+            entry = next;
+        }
+    }
+    free(resident->buckets);
+    resident->buckets = buckets;
+    resident->bucket_count = bucket_count;
+}
+
+/*
+ * Copies `data` into the resident tier; `sections` (modules only) point into
+ * `data` and are rebased onto the copy. An existing module entry is kept, as
+ * keys are content addressed and a build may be decoding from it; a graph
+ * entry is replaced. Failing to allocate only loses residency.
+ */
+static void vitte_cache_resident_admit(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    vitte_cache_resident_kind_t kind,
+    const char *data,
+    size_t size,
+    const vitte_cache_entry_t *sections
+) {
+    struct vitte_cache_resident *resident = cache->resident;
+    vitte_cache_resident_entry_t *entry;
+    vitte_cache_resident_entry_t *existing;
+    char *copy;
+
+    if (resident == NULL) {
+        return;
+    }
+    copy = (char *)malloc(size > 0u ? size : 1u);
+    entry = (vitte_cache_resident_entry_t *)calloc(1u, sizeof(*entry));
+    if (copy == NULL || entry == NULL) {
+        free(copy);
+        free(entry);
+        return;
+    }
+    memcpy(copy, data, size);
+    entry->key = *key;
+    entry->kind = kind;
+    entry->data = copy;
+    entry->size = size;
+    if (sections != NULL) {
+        entry->sections = *sections;
+        entry->sections.strings = copy + (sections->strings - data);
+        entry->sections.kinds = (const unsigned char *)copy + (sections->kinds - (const unsigned char *)data);
+        entry->sections.records = (const unsigned char *)copy + (sections->records - (const unsigned char *)data);
+    }
+
+    vitte_parallel_mutex_lock(&cache->lock);
+    existing = vitte_cache_resident_find(resident, key, kind);
+    if (existing != NULL && kind == VITTE_CACHE_RESIDENT_GRAPH) {
+        resident->bytes = resident->bytes - existing->size + size;
+        free(existing->data);
+        existing->data = copy;
+        existing->size = size;
+        copy = NULL;
+    } else if (existing == NULL) {
+        size_t position;
+
+        if (resident->count >= resident->bucket_count) {
+            vitte_cache_resident_grow(resident);
+        }
+        entry->used = ++resident->clock;
+        position = vitte_cache_resident_bucket(resident, key, kind);
+        entry->next = resident->buckets[position];
+        resident->buckets[position] = entry;
+        resident->count++;
+        resident->bytes += size;
+        copy = NULL;
+        entry = NULL;
+    }
+    vitte_parallel_mutex_unlock(&cache->lock);
+    free(copy);
+    free(entry);
+}
+
+vitte_status_t vitte_cache_enable_resident(vitte_cache_t *cache, size_t limit) {
+    struct vitte_cache_resident *resident;
+
+    if (!vitte_cache_is_initialized(cache)) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    if (cache->resident != NULL) {
+        cache->resident->limit = limit != 0u ? limit : VITTE_CACHE_DEFAULT_RESIDENT_LIMIT;
+        return VITTE_STATUS_OK;
+    }
+    resident = (struct vitte_cache_resident *)calloc(1u, sizeof(*resident));
+    if (resident != NULL) {
+        resident->bucket_count = 64u;
+        resident->buckets = (vitte_cache_resident_entry_t **)calloc(resident->bucket_count, sizeof(*resident->buckets));
+    }
+    if (resident == NULL || resident->buckets == NULL) {
+        free(resident);
+        vitte_cache_set_error(&cache->last_error, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_CACHE_E_ALLOC", "failed to allocate resident cache", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    resident->limit = limit != 0u ? limit : VITTE_CACHE_DEFAULT_RESIDENT_LIMIT;
+    cache->resident = resident;
+    return VITTE_STATUS_OK;
+}
+
+void vitte_cache_trim_resident(vitte_cache_t *cache) {
+    struct vitte_cache_resident *resident;
+
+    if (!vitte_cache_is_initialized(cache) || cache->resident == NULL) {
+        return;
+    }
+    resident = cache->resident;
+    vitte_parallel_mutex_lock(&cache->lock);
+    while (resident->bytes > resident->limit && resident->count > 0u) {
+        vitte_cache_resident_entry_t **oldest = NULL;
+        vitte_cache_resident_entry_t *victim;
+        size_t index;
+
+        for (index = 0u; index < resident->bucket_count; index++) {
+            vitte_cache_resident_entry_t **link;
+
+            for (link = &resident->buckets[index]; *link != NULL; link = &(*link)->next) {
+                if (oldest == NULL || (*link)->used < (*oldest)->used) {
+                    oldest = link;
+                }
+            }
+        }
+        victim = *oldest;
+        *oldest = victim->next;
+        resident->count--;
+        resident->bytes -= victim->size;
+        free(victim->data);
+        free(victim);
+    }
+    vitte_parallel_mutex_unlock(&cache->lock);
+}
+
+vitte_status_t vitte_cache_init(vitte_cache_t *cache, const char *directory) {
+    size_t length;
+    vitte_status_t status;
+
+    if (cache == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    memset(cache, 0, sizeof(*cache));
+    vitte_error_init(&cache->last_error);
+    if (directory != NULL) {
+        length = strlen(directory);
+        if (length == 0u || length >= sizeof(cache->directory)) {
+            vitte_cache_set_error(&cache->last_error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_CACHE_E_PATH", "invalid cache directory", directory);
+            return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+        }
+        memcpy(cache->directory, directory, length + 1u);
+    }
+    cache->object_limit = VITTE_CACHE_DEFAULT_OBJECT_LIMIT;
+    status = vitte_parallel_mutex_init(&cache->lock);
+    if (status != VITTE_STATUS_OK) {
+        vitte_cache_set_error(&cache->last_error, status, "VITTE_CACHE_E_LOCK", "failed to initialize cache lock", NULL);
+        return status;
+    }
+    cache->initialized = true;
+    return VITTE_STATUS_OK;
+}
+
+
+void vitte_cache_destroy(vitte_cache_t *cache) {
+    if (cache == NULL) {
+        return;
+    }
+    vitte_cache_resident_destroy(cache->resident);
+    vitte_parallel_mutex_destroy(&cache->lock);
+    memset(cache, 0, sizeof(*cache));
+}
+
+bool vitte_cache_is_initialized(const vitte_cache_t *cache) {
+    return cache != NULL && cache->initialized;
+}
+
+bool vitte_cache_has_directory(const vitte_cache_t *cache) {
+    return vitte_cache_is_initialized(cache) && cache->directory[0] != '\0';
+}
+
+const vitte_error_t *vitte_cache_last_error(const vitte_cache_t *cache) {
+    return cache != NULL ? &cache->last_error : vitte_error_last();
+}
+
+void vitte_cache_stats(vitte_cache_t *cache, vitte_cache_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (!vitte_cache_is_initialized(cache)) {
+        return;
+    }
+    vitte_parallel_mutex_lock(&cache->lock);
+    *stats = cache->stats;
+    stats->resident_bytes = cache->resident != NULL ? cache->resident->bytes : 0u;
+    vitte_parallel_mutex_unlock(&cache->lock);
+}
+
+void vitte_cache_set_object_limit(vitte_cache_t *cache, size_t limit) {
+    if (vitte_cache_is_initialized(cache)) {
+        cache->object_limit = limit != 0u ? limit : VITTE_CACHE_DEFAULT_OBJECT_LIMIT;
+    }
+}
+
+static void vitte_cache_count(vitte_cache_t *cache, size_t *counter, size_t *bytes, size_t byte_count) {
+    vitte_parallel_mutex_lock(&cache->lock);
+    (*counter)++;
+    if (bytes != NULL) {
+        *bytes += byte_count;
+    }
+    vitte_parallel_mutex_unlock(&cache->lock);
+}
+
+/* `<cache>/<subdirectory>/<32 hex digits of key><extension>`; `directory` receives the parent. */
+static vitte_status_t vitte_cache_file_path(
+    const vitte_cache_t *cache,
+    const char *subdirectory,
+    const vitte_cache_key_t *key,
+    const char *extension,
+    vitte_fs_path_t *directory,
+    vitte_fs_path_t *path
+) {
+    vitte_fs_path_t root;
+    char name[64];
+    vitte_status_t status;
+
+    status = vitte_fs_path_from_cstr(&root, cache->directory);
+    if (status == VITTE_STATUS_OK) {
+        status = vitte_fs_path_join(directory, &root, subdirectory);
+    }
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
+    (void)snprintf(
+        name,
+        sizeof(name),
+        "%016llx%016llx%s",
+        (unsigned long long)key->high,
+        (unsigned long long)key->low,
+        extension
+    );
+    return vitte_fs_path_join(path, directory, name);
+}
+
+vitte_status_t vitte_cache_entry_path(
+    const vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    vitte_fs_path_t *path
+) {
+    vitte_fs_path_t directory;
+
+    if (!vitte_cache_is_initialized(cache) || key == NULL || path == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    return vitte_cache_file_path(cache, VITTE_CACHE_MODULE_DIRECTORY, key, VITTE_CACHE_MODULE_EXTENSION, &directory, path);
+}
+
+/* Concurrent writers of the same file each rename a private temporary file into place. */
+static vitte_status_t vitte_cache_publish(
+    const vitte_fs_path_t *directory,
+    const vitte_fs_path_t *path,
+    const void *data,
+    size_t size,
+    vitte_error_t *error
+) {
+    char temp_path[VITTE_FS_MAX_PATH + 64u];
+    unsigned long process_id = 0u;
+    vitte_status_t status;
+
+#ifdef VITTE_CACHE_HAVE_GETPID
+    process_id = (unsigned long)getpid();
+#endif
+    (void)snprintf(temp_path, sizeof(temp_path), "%s.%lu.%lx.tmp", path->text, process_id, (unsigned long)(uintptr_t)data);
+    status = vitte_fs_create_directories(directory->text, error);
+    if (status == VITTE_STATUS_OK) {
+        status = vitte_fs_write_all(temp_path, data, size, NULL, error);
+    }
+    if (status == VITTE_STATUS_OK && rename(temp_path, path->text) != 0) {
+        (void)remove(temp_path);
+        vitte_cache_set_error(error, VITTE_STATUS_ERROR_IO, "VITTE_CACHE_E_WRITE", "failed to publish cache entry", path->text);
+        status = VITTE_STATUS_ERROR_IO;
+    }
+    return status;
+}
+
+static bool vitte_cache_buffer_reserve(vitte_cache_buffer_t *buffer, size_t extra) {
+    unsigned char *data;
+    size_t capacity;
+
+    if (buffer->failed) {
+        return false;
+    }
+    if (buffer->size + extra <= buffer->capacity) {
+        return true;
+    }
+    capacity = buffer->capacity == 0u ? 4096u : buffer->capacity;
+    while (capacity < buffer->size + extra) {
+        capacity *= 2u;
+    }
+    data = (unsigned char *)realloc(buffer->data, capacity);
+    if (data == NULL) {
+        buffer->failed = true;
+        return false;
+    }
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return true;
+}
+
+static void vitte_cache_buffer_put(vitte_cache_buffer_t *buffer, const void *data, size_t size) {
+    if (vitte_cache_buffer_reserve(buffer, size)) {
+        memcpy(buffer->data + buffer->size, data, size);
+        buffer->size += size;
+    }
+}
+
+static void vitte_cache_put_varint(vitte_cache_buffer_t *buffer, uint64_t value) {
+    unsigned char bytes[10];
+    size_t count = 0u;
+
+    do {
+        unsigned char byte = (unsigned char)(value & 0x7fu);
+        value >>= 7;
+        bytes[count++] = value != 0u ? (unsigned char)(byte | 0x80u) : byte;
+    } while (value != 0u);
+    vitte_cache_buffer_put(buffer, bytes, count);
+}
+
+/* Guards against torn or bit-flipped entries; structural checks alone cannot see a changed name. */
+static uint64_t vitte_cache_hash_payload(const unsigned char *data, size_t size) {
+    return vitte_util_hash_bytes(VITTE_UTIL_HASH_SEED, data, size);
+}
+
+/* Node and string slots hold index + 1, keyed by address and text; grown at half load. */
+static size_t vitte_cache_node_position(const vitte_cache_encoder_t *encoder, const vitte_ast_node_t *node) {
+    size_t mask = encoder->node_slot_capacity - 1u;
+    size_t position = vitte_util_hash_pointer(node) & mask;
+
+    while (encoder->node_slots[position] != 0u && encoder->nodes[encoder->node_slots[position] - 1u] != node) {
+        position = (position + 1u) & mask;
+    }
+    return position;
+}
+
+static bool vitte_cache_encoder_grow_nodes(vitte_cache_encoder_t *encoder) {
+    size_t capacity;
+    size_t index;
+
+    if (encoder->node_count + 1u > encoder->node_capacity) {
+        const vitte_ast_node_t **nodes;
+
+        capacity = encoder->node_capacity == 0u ? 1024u : encoder->node_capacity * 2u;
+        nodes = (const vitte_ast_node_t **)realloc((void *)encoder->nodes, capacity * sizeof(*nodes));
+        if (nodes == NULL) {
+            return false;
+        }
+        encoder->nodes = nodes;
+        encoder->node_capacity = capacity;
+    }
+    if ((encoder->node_count + 1u) * 2u <= encoder->node_slot_capacity) {
+        return true;
+    }
+    capacity = encoder->node_slot_capacity == 0u ? 2048u : encoder->node_slot_capacity * 2u;
+    free(encoder->node_slots);
+    encoder->node_slots = (size_t *)calloc(capacity, sizeof(*encoder->node_slots));
+    if (encoder->node_slots == NULL) {
+        encoder->node_slot_capacity = 0u;
+        return false;
+    }
+    encoder->node_slot_capacity = capacity;
+    for (index = 0u; index < encoder->node_count; index++) {
+        encoder->node_slots[vitte_cache_node_position(encoder, encoder->nodes[index])] = index + 1u;
+    }
+    return true;
+}
+
+static void vitte_cache_encoder_add_node(vitte_cache_encoder_t *encoder, const vitte_ast_node_t *node) {
+    size_t position;
+
+    if (node == NULL || encoder->failed) {
+        return;
+    }
+    if (encoder->node_slot_capacity != 0u &&
+        encoder->node_slots[vitte_cache_node_position(encoder, node)] != 0u) {
+        return;
+    }
+    if (!vitte_cache_encoder_grow_nodes(encoder)) {
+        encoder->failed = true;
+        return;
+    }
+    position = vitte_cache_node_position(encoder, node);
+    encoder->nodes[encoder->node_count++] = node;
+    encoder->node_slots[position] = encoder->node_count;
+}
+
+static uint64_t vitte_cache_node_ref(const vitte_cache_encoder_t *encoder, const vitte_ast_node_t *node) {
+    return node != NULL ? (uint64_t)encoder->node_slots[vitte_cache_node_position(encoder, node)] : 0u;
+}
+
+static size_t vitte_cache_string_position(const vitte_cache_encoder_t *encoder, const char *text) {
+    size_t mask = encoder->string_slot_capacity - 1u;
+    size_t position = (size_t)vitte_util_hash_text(VITTE_UTIL_HASH_SEED, text) & mask;
+
+    while (encoder->string_slots[position] != 0u &&
+           strcmp((const char *)encoder->strings.data + encoder->string_offsets[encoder->string_slots[position] - 1u], text) != 0) {
+        position = (position + 1u) & mask;
+    }
+    return position;
+}
+
+static bool vitte_cache_encoder_grow_strings(vitte_cache_encoder_t *encoder) {
+    size_t capacity;
+    size_t index;
+
+    if (encoder->string_count + 1u > encoder->string_capacity) {
+        size_t *offsets;
+
+        capacity = encoder->string_capacity == 0u ? 512u : encoder->string_capacity * 2u;
+        offsets = (size_t *)realloc(encoder->string_offsets, capacity * sizeof(*offsets));
+        if (offsets == NULL) {
+            return false;
+        }
+        encoder->string_offsets = offsets;
+        encoder->string_capacity = capacity;
+    }
+    if ((encoder->string_count + 1u) * 2u <= encoder->string_slot_capacity) {
+        return true;
+    }
+    capacity = encoder->string_slot_capacity == 0u ? 1024u : encoder->string_slot_capacity * 2u;
+    free(encoder->string_slots);
+    encoder->string_slots = (size_t *)calloc(capacity, sizeof(*encoder->string_slots));
+    if (encoder->string_slots == NULL) {
+        encoder->string_slot_capacity = 0u;
+        return false;
+    }
+    encoder->string_slot_capacity = capacity;
+    for (index = 0u; index < encoder->string_count; index++) {
+        const char *text = (const char *)encoder->strings.data + encoder->string_offsets[index];
+        encoder->string_slots[vitte_cache_string_position(encoder, text)] = index + 1u;
+    }
+    return true;
+}
+
+static uint64_t vitte_cache_string_ref(vitte_cache_encoder_t *encoder, const char *text) {
+    size_t position;
+    size_t offset;
+
+    if (text == NULL || encoder->failed) {
+        return 0u;
+    }
+    if (!vitte_cache_encoder_grow_strings(encoder)) {
+        encoder->failed = true;
+        return 0u;
+    }
+    position = vitte_cache_string_position(encoder, text);
+    if (encoder->string_slots[position] != 0u) {
+        return (uint64_t)encoder->string_slots[position];
+    }
+    offset = encoder->strings.size;
+    vitte_cache_buffer_put(&encoder->strings, text, strlen(text) + 1u);
+    if (encoder->strings.failed) {
+        encoder->failed = true;
+        return 0u;
+    }
+    encoder->string_offsets[encoder->string_count++] = offset;
+    encoder->string_slots[position] = encoder->string_count;
+    return (uint64_t)encoder->string_count;
+}
+
+static void vitte_cache_collect_children(vitte_cache_encoder_t *encoder, const vitte_ast_node_t *node) {
+    const vitte_cache_field_t *field;
+
+    vitte_cache_encoder_add_node(encoder, node->next);
+    for (field = vitte_cache_node_fields[node->kind]; field->kind != VITTE_CACHE_FIELD_END; field++) {
+        const unsigned char *slot = (const unsigned char *)node + field->offset;
+
+        if (field->kind == VITTE_CACHE_FIELD_NODE) {
+            const vitte_ast_node_t *child;
+            memcpy(&child, slot, sizeof(child));
+            vitte_cache_encoder_add_node(encoder, child);
+        } else if (field->kind == VITTE_CACHE_FIELD_LIST) {
+            vitte_ast_list_t list;
+            memcpy(&list, slot, sizeof(list));
+            vitte_cache_encoder_add_node(encoder, list.first);
+            vitte_cache_encoder_add_node(encoder, list.last);
+        }
+    }
+}
+
+static void vitte_cache_encode_node(vitte_cache_encoder_t *encoder, const vitte_ast_node_t *node) {
+    vitte_cache_buffer_t *out = &encoder->records;
+    const vitte_cache_field_t *field;
+
+    vitte_cache_put_varint(out, vitte_cache_string_ref(encoder, node->span.source_name));
+    vitte_cache_put_varint(out, node->span.start_offset);
+    vitte_cache_put_varint(out, node->span.end_offset);
+    vitte_cache_put_varint(out, node->span.start_line);
+    vitte_cache_put_varint(out, node->span.start_column);
+    vitte_cache_put_varint(out, node->span.end_line);
+    vitte_cache_put_varint(out, node->span.end_column);
+    vitte_cache_put_varint(out, node->span.valid ? 1u : 0u);
+    vitte_cache_put_varint(out, vitte_cache_node_ref(encoder, node->next));
+    for (field = vitte_cache_node_fields[node->kind]; field->kind != VITTE_CACHE_FIELD_END; field++) {
+        const unsigned char *slot = (const unsigned char *)node + field->offset;
+
+        switch (field->kind) {
+            case VITTE_CACHE_FIELD_STRING: {
+                const char *text;
+                memcpy(&text, slot, sizeof(text));
+                vitte_cache_put_varint(out, vitte_cache_string_ref(encoder, text));
+                break;
+            }
+            case VITTE_CACHE_FIELD_NODE: {
+                const vitte_ast_node_t *child;
+                memcpy(&child, slot, sizeof(child));
+                vitte_cache_put_varint(out, vitte_cache_node_ref(encoder, child));
+                break;
+            }
+            case VITTE_CACHE_FIELD_LIST: {
+                vitte_ast_list_t list;
+                memcpy(&list, slot, sizeof(list));
+                vitte_cache_put_varint(out, vitte_cache_node_ref(encoder, list.first));
+                vitte_cache_put_varint(out, vitte_cache_node_ref(encoder, list.last));
+                vitte_cache_put_varint(out, list.count);
+                break;
+            }
+            case VITTE_CACHE_FIELD_BOOL: {
+                bool value;
+                memcpy(&value, slot, sizeof(value));
+                vitte_cache_put_varint(out, value ? 1u : 0u);
+                break;
+            }
+            case VITTE_CACHE_FIELD_INT: {
+                int64_t value;
+                uint64_t bits;
+                memcpy(&value, slot, sizeof(value));
+                memcpy(&bits, &value, sizeof(bits));
+                /* Zigzag keeps small negative literals short. */
+                vitte_cache_put_varint(out, (bits << 1) ^ (value < 0 ? ~(uint64_t)0u : 0u));
+                break;
+            }
+            case VITTE_CACHE_FIELD_IMPORT_KIND: {
+                vitte_ast_import_kind_t value;
+                memcpy(&value, slot, sizeof(value));
+                vitte_cache_put_varint(out, (uint64_t)value);
+                break;
+            }
+            default:
+                encoder->failed = true;
+                break;
+        }
+    }
+}
+
+static void vitte_cache_encoder_destroy(vitte_cache_encoder_t *encoder) {
+    free(encoder->strings.data);
+    free(encoder->records.data);
+    free((void *)encoder->nodes);
+    free(encoder->node_slots);
+    free(encoder->string_offsets);
+    free(encoder->string_slots);
+    memset(encoder, 0, sizeof(*encoder));
+}
+
+static bool vitte_cache_encode_module(
+    vitte_cache_encoder_t *encoder,
+    const vitte_ast_t *ast,
+    const vitte_module_t *module
+) {
+    size_t index;
+
+    vitte_cache_encoder_add_node(encoder, ast->root);
+    for (index = 0u; index < encoder->node_count && !encoder->failed; index++) {
+        if ((size_t)encoder->nodes[index]->kind >= (size_t)VITTE_AST_NODE_COUNT) {
+            encoder->failed = true;
+            break;
+        }
+        vitte_cache_collect_children(encoder, encoder->nodes[index]);
+    }
+    for (index = 0u; index < encoder->node_count && !encoder->failed; index++) {
+        vitte_cache_encode_node(encoder, encoder->nodes[index]);
+    }
+    vitte_cache_put_varint(&encoder->records, vitte_cache_string_ref(encoder, module->module_name));
+    vitte_cache_put_varint(&encoder->records, module->token_count);
+    vitte_cache_put_varint(&encoder->records, module->import_count);
+    for (index = 0u; index < module->import_count; index++) {
+        vitte_cache_put_varint(&encoder->records, vitte_cache_string_ref(encoder, module->imports[index].module_name));
+        vitte_cache_put_varint(&encoder->records, module->imports[index].relative ? 1u : 0u);
+    }
+    return !encoder->failed && !encoder->strings.failed && !encoder->records.failed;
+}
+
+static bool vitte_cache_locate_entry(
+    const char *data,
+    size_t size,
+    const vitte_cache_key_t *key,
+    vitte_cache_entry_t *entry
+) {
+    vitte_cache_header_t header;
+    size_t payload;
+    size_t count = 0u;
+    size_t index;
+
+    if (size < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    payload = size - sizeof(header);
+    if (memcmp(header.magic, VITTE_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.format_version != VITTE_CACHE_FORMAT_VERSION ||
+        header.abi_version != VITTE_ABI_VERSION ||
+        header.key_high != key->high ||
+        header.key_low != key->low ||
+        header.string_bytes > payload ||
+        header.node_count > payload - header.string_bytes ||
+        header.record_bytes != payload - header.string_bytes - header.node_count ||
+        header.payload_hash != vitte_cache_hash_payload((const unsigned char *)data + sizeof(header), payload)) {
+        return false;
+    }
+    entry->strings = data + sizeof(header);
+    entry->string_bytes = (size_t)header.string_bytes;
+    entry->string_count = (size_t)header.string_count;
+    entry->kinds = (const unsigned char *)entry->strings + entry->string_bytes;
+    entry->node_count = (size_t)header.node_count;
+    entry->records = entry->kinds + entry->node_count;
+    entry->record_bytes = (size_t)header.record_bytes;
+    if (entry->string_bytes != 0u && entry->strings[entry->string_bytes - 1u] != '\0') {
+        return false;
+    }
+    for (index = 0u; index < entry->string_bytes; index++) {
+        count += entry->strings[index] == '\0' ? 1u : 0u;
+    }
+    return count == entry->string_count;
+}
+
+vitte_status_t vitte_cache_store_module(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    const vitte_ast_t *ast,
+    const vitte_module_t *module,
+    vitte_error_t *error
+) {
+    vitte_cache_encoder_t encoder;
+    vitte_cache_header_t header;
+    vitte_cache_buffer_t file;
+    vitte_cache_entry_t sections;
+    vitte_fs_path_t directory;
+    vitte_fs_path_t path;
+    size_t index;
+    vitte_status_t status = VITTE_STATUS_OK;
+
+    if (!vitte_cache_is_initialized(cache) || key == NULL || !vitte_ast_is_initialized(ast) || ast->root == NULL ||
+        !vitte_module_is_initialized(module)) {
+        vitte_cache_set_error(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_CACHE_E_ARGUMENT", "invalid module cache store", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    if (vitte_cache_has_directory(cache)) {
+        status = vitte_cache_file_path(cache, VITTE_CACHE_MODULE_DIRECTORY, key, VITTE_CACHE_MODULE_EXTENSION, &directory, &path);
+    }
+    if (status != VITTE_STATUS_OK) {
+        vitte_cache_set_error(error, status, "VITTE_CACHE_E_PATH", "cache entry path is too long", cache->directory);
+        vitte_cache_count(cache, &cache->stats.store_failure_count, NULL, 0u);
+        return status;
+    }
+
+    memset(&encoder, 0, sizeof(encoder));
+    if (!vitte_cache_encode_module(&encoder, ast, module)) {
+        vitte_cache_encoder_destroy(&encoder);
+        vitte_cache_set_error(error, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_CACHE_E_ENCODE", "failed to serialize module", module->module_name);
+        vitte_cache_count(cache, &cache->stats.store_failure_count, NULL, 0u);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, VITTE_CACHE_MAGIC, sizeof(header.magic));
+    header.format_version = VITTE_CACHE_FORMAT_VERSION;
+    header.abi_version = VITTE_ABI_VERSION;
+    header.key_high = key->high;
+    header.key_low = key->low;
+    header.string_bytes = encoder.strings.size;
+    header.string_count = encoder.string_count;
+    header.node_count = encoder.node_count;
+    header.record_bytes = encoder.records.size;
+
+    memset(&file, 0, sizeof(file));
+    vitte_cache_buffer_put(&file, &header, sizeof(header));
+    vitte_cache_buffer_put(&file, encoder.strings.data, encoder.strings.size);
+    for (index = 0u; index < encoder.node_count; index++) {
+        unsigned char kind = (unsigned char)encoder.nodes[index]->kind;
+        vitte_cache_buffer_put(&file, &kind, 1u);
+    }
+    vitte_cache_buffer_put(&file, encoder.records.data, encoder.records.size);
+    vitte_cache_encoder_destroy(&encoder);
+    if (!file.failed) {
+        header.payload_hash = vitte_cache_hash_payload(file.data + sizeof(header), file.size - sizeof(header));
+        memcpy(file.data, &header, sizeof(header));
+    }
+    if (file.failed) {
+        free(file.data);
+        vitte_cache_set_error(error, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_CACHE_E_ENCODE", "failed to serialize module", module->module_name);
+        vitte_cache_count(cache, &cache->stats.store_failure_count, NULL, 0u);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (cache->resident != NULL && vitte_cache_locate_entry((const char *)file.data, file.size, key, &sections)) {
+        vitte_cache_resident_admit(cache, key, VITTE_CACHE_RESIDENT_MODULE, (const char *)file.data, file.size, &sections);
+    }
+    if (vitte_cache_has_directory(cache)) {
+        status = vitte_cache_publish(&directory, &path, file.data, file.size, error);
+    }
+    if (status == VITTE_STATUS_OK) {
+        vitte_cache_count(cache, &cache->stats.store_count, &cache->stats.bytes_stored, file.size);
+    } else {
+        vitte_cache_count(cache, &cache->stats.store_failure_count, NULL, 0u);
+    }
+    free(file.data);
+    return status;
+}
+
+static uint64_t vitte_cache_get_varint(vitte_cache_decoder_t *decoder) {
+    uint64_t value = 0u;
+    unsigned shift = 0u;
+
+    while (!decoder->failed) {
+        unsigned char byte;
+
+        if (decoder->cursor >= decoder->end || shift > 63u) {
+            decoder->failed = true;
+            break;
+        }
+        byte = *decoder->cursor++;
+        value |= (uint64_t)(byte & 0x7fu) << shift;
+        if ((byte & 0x80u) == 0u) {
+            return value;
+        }
+        shift += 7u;
+    }
+    return 0u;
+}
+
+static const char *vitte_cache_get_string(vitte_cache_decoder_t *decoder) {
+    uint64_t ref = vitte_cache_get_varint(decoder);
+
+    if (ref == 0u || decoder->failed) {
+        return NULL;
+    }
+    if (ref > decoder->string_count) {
+        decoder->failed = true;
+        return NULL;
+    }
+    return decoder->strings != NULL ? decoder->strings[ref - 1u] : "";
+}
+
+static vitte_ast_node_t *vitte_cache_get_node(vitte_cache_decoder_t *decoder) {
+    uint64_t ref = vitte_cache_get_varint(decoder);
+
+    if (ref == 0u || decoder->failed) {
+        return NULL;
+    }
+    if (ref > decoder->node_count) {
+        decoder->failed = true;
+        return NULL;
+    }
+    return decoder->nodes != NULL ? decoder->nodes[ref - 1u] : NULL;
+}
+
+/* Decodes one node record; with no node table the record is only validated. */
+static void vitte_cache_decode_node(vitte_cache_decoder_t *decoder, vitte_ast_node_t *node, vitte_ast_node_kind_t kind) {
+    const vitte_cache_field_t *field;
+    vitte_ast_span_t span;
+    vitte_ast_node_t *next;
+
+    vitte_ast_span_init(&span);
+    span.source_name = vitte_cache_get_string(decoder);
+    span.start_offset = (size_t)vitte_cache_get_varint(decoder);
+    span.end_offset = (size_t)vitte_cache_get_varint(decoder);
+    span.start_line = (uint32_t)vitte_cache_get_varint(decoder);
+    span.start_column = (uint32_t)vitte_cache_get_varint(decoder);
+    span.end_line = (uint32_t)vitte_cache_get_varint(decoder);
+    span.end_column = (uint32_t)vitte_cache_get_varint(decoder);
+    span.valid = vitte_cache_get_varint(decoder) != 0u;
+    next = vitte_cache_get_node(decoder);
+    if (node != NULL) {
+        node->span = span;
+        node->next = next;
+    }
+    for (field = vitte_cache_node_fields[kind]; field->kind != VITTE_CACHE_FIELD_END && !decoder->failed; field++) {
+        unsigned char *slot = node != NULL ? (unsigned char *)node + field->offset : NULL;
+
+        switch (field->kind) {
+            case VITTE_CACHE_FIELD_STRING: {
+                const char *text = vitte_cache_get_string(decoder);
+                if (slot != NULL) memcpy(slot, &text, sizeof(text));
+                break;
+            }
+            case VITTE_CACHE_FIELD_NODE: {
+                vitte_ast_node_t *child = vitte_cache_get_node(decoder);
+                if (slot != NULL) memcpy(slot, &child, sizeof(child));
+                break;
+            }
+            case VITTE_CACHE_FIELD_LIST: {
+                vitte_ast_list_t list;
+                list.first = vitte_cache_get_node(decoder);
+                list.last = vitte_cache_get_node(decoder);
+                list.count = (size_t)vitte_cache_get_varint(decoder);
+                if (slot != NULL) memcpy(slot, &list, sizeof(list));
+                break;
+            }
+            case VITTE_CACHE_FIELD_BOOL: {
+                bool value = vitte_cache_get_varint(decoder) != 0u;
+                if (slot != NULL) memcpy(slot, &value, sizeof(value));
+                break;
+            }
+            case VITTE_CACHE_FIELD_INT: {
+                uint64_t bits = vitte_cache_get_varint(decoder);
+                uint64_t decoded = (bits >> 1) ^ (~(bits & 1u) + 1u);
+                int64_t value;
+                memcpy(&value, &decoded, sizeof(value));
+                if (slot != NULL) memcpy(slot, &value, sizeof(value));
+                break;
+            }
+            case VITTE_CACHE_FIELD_IMPORT_KIND: {
+                uint64_t raw = vitte_cache_get_varint(decoder);
+                vitte_ast_import_kind_t value = (vitte_ast_import_kind_t)raw;
+                if (raw > (uint64_t)VITTE_AST_IMPORT_GLOB) {
+                    decoder->failed = true;
+                }
+                if (slot != NULL) memcpy(slot, &value, sizeof(value));
+                break;
+            }
+            default:
+                decoder->failed = true;
+                break;
+        }
+    }
+}
+
+/* Walks every record and the module metadata; returns false on any malformed byte. */
+static bool vitte_cache_validate_records(const vitte_cache_entry_t *entry) {
+    vitte_cache_decoder_t decoder;
+    uint64_t import_count;
+    uint64_t index;
+
+    memset(&decoder, 0, sizeof(decoder));
+    decoder.cursor = entry->records;
+    decoder.end = entry->records + entry->record_bytes;
+    decoder.string_count = entry->string_count;
+    decoder.node_count = entry->node_count;
+    if (entry->node_count == 0u || entry->kinds[0] != (unsigned char)VITTE_AST_NODE_MODULE) {
+        return false;
+    }
+    for (index = 0u; index < entry->node_count && !decoder.failed; index++) {
+        if (entry->kinds[index] >= (unsigned char)VITTE_AST_NODE_COUNT) {
+            return false;
+        }
+        vitte_cache_decode_node(&decoder, NULL, (vitte_ast_node_kind_t)entry->kinds[index]);
+    }
+    (void)vitte_cache_get_string(&decoder);
+    (void)vitte_cache_get_varint(&decoder);
+    import_count = vitte_cache_get_varint(&decoder);
+    if (import_count > VITTE_MODULE_MAX_IMPORTS) {
+        return false;
+    }
+    for (index = 0u; index < import_count && !decoder.failed; index++) {
+        if (vitte_cache_get_string(&decoder) == NULL) {
+            return false;
+        }
+        (void)vitte_cache_get_varint(&decoder);
+    }
+    return !decoder.failed && decoder.cursor == decoder.end;
+}
+
+/*
+ * Resolves the string table. With an interner, strings become canonical
+ * context-lifetime pointers exactly as the lexer produces them; otherwise the
+ * table is copied into the AST arena.
+ */
+static bool vitte_cache_load_strings(
+    const vitte_cache_entry_t *entry,
+    vitte_ast_t *ast,
+    vitte_interner_t *interner,
+    const char **strings
+) {
+    const char *text = entry->strings;
+    char *copy = NULL;
+    size_t index;
+
+    if (interner == NULL && entry->string_bytes != 0u) {
+        copy = (char *)vitte_arena_alloc(ast->arena, entry->string_bytes, 1u);
+        if (copy == NULL) {
+            return false;
+        }
+        memcpy(copy, entry->strings, entry->string_bytes);
+        text = copy;
+    }
+    for (index = 0u; index < entry->string_count; index++) {
+        size_t length = strlen(text);
+
+        strings[index] = interner != NULL ? vitte_interner_intern(interner, text, length) : text;
+        if (strings[index] == NULL) {
+            return false;
+        }
+        text += length + 1u;
+    }
+    return true;
+}
+
+static vitte_status_t vitte_cache_apply_records(
+    const vitte_cache_entry_t *entry,
+    vitte_ast_t *ast,
+    vitte_module_t *module,
+    vitte_interner_t *interner,
+    vitte_error_t *error
+) {
+    vitte_cache_decoder_t decoder;
+    vitte_ast_span_t empty_span;
+    const char *module_name;
+    uint64_t import_count;
+    size_t index;
+    vitte_status_t status;
+
+    memset(&decoder, 0, sizeof(decoder));
+    decoder.cursor = entry->records;
+    decoder.end = entry->records + entry->record_bytes;
+    decoder.string_count = entry->string_count;
+    decoder.node_count = entry->node_count;
+    decoder.strings = (const char **)malloc((entry->string_count + 1u) * sizeof(*decoder.strings));
+    decoder.nodes = (vitte_ast_node_t **)malloc(entry->node_count * sizeof(*decoder.nodes));
+    if (decoder.strings == NULL || decoder.nodes == NULL ||
+        !vitte_cache_load_strings(entry, ast, interner, decoder.strings)) {
+        free((void *)decoder.strings);
+        free(decoder.nodes);
+        vitte_cache_set_error(error, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_CACHE_E_ALLOC", "failed to allocate cached module", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    vitte_ast_span_init(&empty_span);
+    for (index = 0u; index < entry->node_count; index++) {
+        decoder.nodes[index] = vitte_ast_alloc_node(ast, (vitte_ast_node_kind_t)entry->kinds[index], empty_span);
+        if (decoder.nodes[index] == NULL) {
+            free((void *)decoder.strings);
+            free(decoder.nodes);
+            vitte_error_copy(error, vitte_ast_last_error(ast));
+            return vitte_ast_last_error(ast)->status;
+        }
+    }
+    for (index = 0u; index < entry->node_count; index++) {
+        vitte_cache_decode_node(&decoder, decoder.nodes[index], decoder.nodes[index]->kind);
+    }
+    ast->root = decoder.nodes[0];
+    free(decoder.nodes);
+    decoder.nodes = NULL;
+
+    status = VITTE_STATUS_OK;
+    module_name = vitte_cache_get_string(&decoder);
+    module->token_count = (size_t)vitte_cache_get_varint(&decoder);
+    module->stats.token_count = module->token_count;
+    if (module_name != NULL && strcmp(module_name, module->module_name) != 0) {
+        status = vitte_module_set_name(module, module_name);
+    }
+    import_count = status == VITTE_STATUS_OK ? vitte_cache_get_varint(&decoder) : 0u;
+    for (index = 0u; index < import_count && status == VITTE_STATUS_OK; index++) {
+        const char *import_name = vitte_cache_get_string(&decoder);
+        bool relative = vitte_cache_get_varint(&decoder) != 0u;
+
+        status = vitte_module_add_import(module, import_name, relative);
+    }
+    free((void *)decoder.strings);
+    if (status != VITTE_STATUS_OK) {
+        vitte_error_copy(error, vitte_module_last_error(module));
+        return status;
+    }
+    module->ast = ast;
+    module->state = VITTE_MODULE_STATE_PARSED;
+    return VITTE_STATUS_OK;
+}
+
+vitte_status_t vitte_cache_load_module(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    vitte_ast_t *ast,
+    vitte_module_t *module,
+    vitte_interner_t *interner,
+    bool *hit,
+    vitte_error_t *error
+) {
+    vitte_fs_options_t options;
+    vitte_fs_source_storage_t storage;
+    vitte_cache_resident_entry_t *resident_entry;
+    vitte_cache_entry_t entry;
+    vitte_fs_path_t path;
+    vitte_error_t read_error;
+    char *data = NULL;
+    size_t size = 0u;
+    vitte_status_t status;
+
+    if (hit != NULL) {
+        *hit = false;
+    }
+    if (!vitte_cache_is_initialized(cache) || key == NULL || !vitte_ast_is_initialized(ast) || ast->root != NULL ||
+        !vitte_module_is_initialized(module) || hit == NULL) {
+        vitte_cache_set_error(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_CACHE_E_ARGUMENT", "invalid module cache load", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    vitte_parallel_mutex_lock(&cache->lock);
+    resident_entry = vitte_cache_resident_find(cache->resident, key, VITTE_CACHE_RESIDENT_MODULE);
+    if (resident_entry != NULL) {
+        entry = resident_entry->sections;
+        size = resident_entry->size;
+    }
+    vitte_parallel_mutex_unlock(&cache->lock);
+    if (resident_entry != NULL) {
+        /* Resident entries were validated when admitted and stay until the next trim. */
+        status = vitte_cache_apply_records(&entry, ast, module, interner, error);
+        if (status != VITTE_STATUS_OK) {
+            return status;
+        }
+        vitte_parallel_mutex_lock(&cache->lock);
+        cache->stats.hit_count++;
+        cache->stats.resident_hit_count++;
+        cache->stats.bytes_loaded += size;
+        vitte_parallel_mutex_unlock(&cache->lock);
+        *hit = true;
+        return VITTE_STATUS_OK;
+    }
+    if (!vitte_cache_has_directory(cache) || vitte_cache_entry_path(cache, key, &path) != VITTE_STATUS_OK) {
+        vitte_cache_count(cache, &cache->stats.miss_count, NULL, 0u);
+        return VITTE_STATUS_OK;
+    }
+    vitte_fs_options_init(&options);
+    options.map_sources = true;
+    vitte_error_init(&read_error);
+    if (vitte_fs_read_source(path.text, &data, &size, &storage, &options, &read_error) != VITTE_STATUS_OK) {
+        vitte_cache_count(cache, &cache->stats.miss_count, NULL, 0u);
+        return VITTE_STATUS_OK;
+    }
+    if (!vitte_cache_locate_entry(data, size, key, &entry) || !vitte_cache_validate_records(&entry)) {
+        vitte_fs_free_source(data, size, storage);
+        vitte_cache_count(cache, &cache->stats.reject_count, NULL, 0u);
+        return VITTE_STATUS_OK;
+    }
+    vitte_cache_resident_admit(cache, key, VITTE_CACHE_RESIDENT_MODULE, data, size, &entry);
+
+    status = vitte_cache_apply_records(&entry, ast, module, interner, error);
+    vitte_fs_free_source(data, size, storage);
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
+    vitte_cache_count(cache, &cache->stats.hit_count, &cache->stats.bytes_loaded, size);
+    *hit = true;
+    return VITTE_STATUS_OK;
+}
+
+void vitte_cache_graph_init(vitte_cache_graph_t *graph) {
+    if (graph != NULL) {
+        memset(graph, 0, sizeof(*graph));
+    }
+}
+
+void vitte_cache_graph_destroy(vitte_cache_graph_t *graph) {
+    size_t index;
+
+    if (graph == NULL) {
+        return;
+    }
+    for (index = 0u; index < graph->node_count; index++) {
+        free(graph->nodes[index].path);
+    }
+    free(graph->nodes);
+    free(graph->edges);
+    free(graph->slots);
+    memset(graph, 0, sizeof(*graph));
+}
+
+static size_t vitte_cache_graph_position(const vitte_cache_graph_t *graph, const char *path) {
+    size_t mask = graph->slot_capacity - 1u;
+    size_t position = (size_t)vitte_util_hash_text(VITTE_UTIL_HASH_SEED, path) & mask;
+
+    while (graph->slots[position] != 0u && strcmp(graph->nodes[graph->slots[position] - 1u].path, path) != 0) {
+        position = (position + 1u) & mask;
+    }
+    return position;
+}
+
+const vitte_cache_graph_node_t *vitte_cache_graph_find(const vitte_cache_graph_t *graph, const char *path) {
+    size_t slot;
+
+    if (graph == NULL || path == NULL || graph->slot_capacity == 0u) {
+        return NULL;
+    }
+    slot = graph->slots[vitte_cache_graph_position(graph, path)];
+    return slot != 0u ? &graph->nodes[slot - 1u] : NULL;
+}
+
+static bool vitte_cache_graph_reserve(vitte_cache_graph_t *graph) {
+    size_t capacity;
+    size_t index;
+
+    if (graph->node_count + 1u > graph->node_capacity) {
+        vitte_cache_graph_node_t *nodes;
+
+        capacity = graph->node_capacity == 0u ? 64u : graph->node_capacity * 2u;
+        nodes = (vitte_cache_graph_node_t *)realloc(graph->nodes, capacity * sizeof(*nodes));
+        if (nodes == NULL) {
+            return false;
+        }
+        graph->nodes = nodes;
+        graph->node_capacity = capacity;
+    }
+    if ((graph->node_count + 1u) * 2u <= graph->slot_capacity) {
+        return true;
+    }
+    capacity = graph->slot_capacity == 0u ? 128u : graph->slot_capacity * 2u;
+    free(graph->slots);
+    graph->slots = (size_t *)calloc(capacity, sizeof(*graph->slots));
+    if (graph->slots == NULL) {
+        graph->slot_capacity = 0u;
+        return false;
+    }
+    graph->slot_capacity = capacity;
+    for (index = 0u; index < graph->node_count; index++) {
+        graph->slots[vitte_cache_graph_position(graph, graph->nodes[index].path)] = index + 1u;
+    }
+    return true;
+}
+
+vitte_status_t vitte_cache_graph_add_node(
+    vitte_cache_graph_t *graph,
+    const char *path,
+    const vitte_cache_key_t *fingerprint,
+    const vitte_cache_key_t *interface_key,
+    size_t *index
+) {
+    vitte_cache_graph_node_t *node;
+    size_t length;
+
+    if (graph == NULL || path == NULL || path[0] == '\0' || fingerprint == NULL || interface_key == NULL ||
+        vitte_cache_graph_find(graph, path) != NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    if (!vitte_cache_graph_reserve(graph)) {
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    node = &graph->nodes[graph->node_count];
+    length = strlen(path);
+    node->path = (char *)malloc(length + 1u);
+    if (node->path == NULL) {
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    memcpy(node->path, path, length + 1u);
+    node->fingerprint = *fingerprint;
+    node->interface_key = *interface_key;
+    graph->slots[vitte_cache_graph_position(graph, path)] = graph->node_count + 1u;
+    if (index != NULL) {
+        *index = graph->node_count;
+    }
+    graph->node_count++;
+    return VITTE_STATUS_OK;
+}
+
+vitte_status_t vitte_cache_graph_add_edge(vitte_cache_graph_t *graph, size_t from, size_t to) {
+    if (graph == NULL || from >= graph->node_count || to >= graph->node_count) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    if (graph->edge_count == graph->edge_capacity) {
+        size_t capacity = graph->edge_capacity == 0u ? 256u : graph->edge_capacity * 2u;
+        vitte_cache_graph_edge_t *edges = (vitte_cache_graph_edge_t *)realloc(graph->edges, capacity * sizeof(*edges));
+
+        if (edges == NULL) {
+            return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        }
+        graph->edges = edges;
+        graph->edge_capacity = capacity;
+    }
+    graph->edges[graph->edge_count].from = from;
+    graph->edges[graph->edge_count].to = to;
+    graph->edge_count++;
+    return VITTE_STATUS_OK;
+}
+
+/*
+ * Graph files are line-oriented text so they can be inspected by hand:
+ *
+ *   vitte-graph <format> <compiler version>
+ *   node <fingerprint> <interface> <path>
+ *   edge <from node> <to node>
+ */
+static bool vitte_cache_parse_key(const char *text, vitte_cache_key_t *key) {
+    unsigned long long high = 0u;
+    unsigned long long low = 0u;
+    size_t index;
+
+    for (index = 0u; index < 32u; index++) {
+        unsigned long long digit;
+        char c = text[index];
+
+        if (c >= '0' && c <= '9') {
+            digit = (unsigned long long)(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            digit = (unsigned long long)(c - 'a' + 10);
+        } else {
+            return false;
+        }
+        if (index < 16u) {
+            high = (high << 4) | digit;
+        } else {
+            low = (low << 4) | digit;
+        }
+    }
+    key->high = (uint64_t)high;
+    key->low = (uint64_t)low;
+    return true;
+}
+
+static bool vitte_cache_parse_graph_line(vitte_cache_graph_t *graph, char *line) {
+    if (strncmp(line, "node ", 5u) == 0) {
+        vitte_cache_key_t fingerprint;
+        vitte_cache_key_t interface_key;
+
+        return strlen(line) > 72u && line[37] == ' ' && line[70] == ' ' &&
+            vitte_cache_parse_key(line + 5, &fingerprint) &&
+            vitte_cache_parse_key(line + 38, &interface_key) &&
+            vitte_cache_graph_add_node(graph, line + 71, &fingerprint, &interface_key, NULL) == VITTE_STATUS_OK;
+    }
+    if (strncmp(line, "edge ", 5u) == 0) {
+        char *end = NULL;
+        unsigned long from = strtoul(line + 5, &end, 10);
+        unsigned long to;
+
+        if (end == line + 5 || *end != ' ') {
+            return false;
+        }
+        line = end + 1;
+        to = strtoul(line, &end, 10);
+        return end != line && *end == '\0' && vitte_cache_graph_add_edge(graph, (size_t)from, (size_t)to) == VITTE_STATUS_OK;
+    }
+    return false;
+}
+
+vitte_status_t vitte_cache_load_graph(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    vitte_cache_graph_t *graph,
+    bool *hit
+) {
+    vitte_fs_options_t options;
+    vitte_fs_source_storage_t storage = VITTE_FS_SOURCE_HEAP;
+    vitte_cache_resident_entry_t *resident_entry;
+    vitte_fs_path_t directory;
+    vitte_fs_path_t path;
+    vitte_error_t read_error;
+    char header[128];
+    char *data = NULL;
+    char *line;
+    size_t size = 0u;
+    size_t header_length;
+    bool valid = true;
+
+    if (hit != NULL) {
+        *hit = false;
+    }
+    if (!vitte_cache_is_initialized(cache) || key == NULL || graph == NULL || hit == NULL || graph->node_count != 0u) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    /* Lines are split in place, so a resident graph is parsed from a private copy. */
+    vitte_parallel_mutex_lock(&cache->lock);
+    resident_entry = vitte_cache_resident_find(cache->resident, key, VITTE_CACHE_RESIDENT_GRAPH);
+    if (resident_entry != NULL) {
+        data = (char *)malloc(resident_entry->size + 1u);
+        if (data != NULL) {
+            memcpy(data, resident_entry->data, resident_entry->size);
+            data[resident_entry->size] = '\0';
+            size = resident_entry->size;
+        }
+    }
+    vitte_parallel_mutex_unlock(&cache->lock);
+    if (data == NULL) {
+        if (!vitte_cache_has_directory(cache) ||
+            vitte_cache_file_path(cache, VITTE_CACHE_GRAPH_DIRECTORY, key, VITTE_CACHE_GRAPH_EXTENSION, &directory, &path) != VITTE_STATUS_OK) {
+            return VITTE_STATUS_OK;
+        }
+        vitte_fs_options_init(&options);
+        options.map_sources = false;
+        options.null_terminate_reads = true;
+        vitte_error_init(&read_error);
+        if (vitte_fs_read_source(path.text, &data, &size, &storage, &options, &read_error) != VITTE_STATUS_OK) {
+            return VITTE_STATUS_OK;
+        }
+    }
+    (void)snprintf(header, sizeof(header), "vitte-graph %u %s\n", (unsigned)VITTE_CACHE_FORMAT_VERSION, vitte_version_string());
+    header_length = strlen(header);
+    if (storage != VITTE_FS_SOURCE_HEAP || size < header_length || memcmp(data, header, header_length) != 0 ||
+        data[size - 1u] != '\n') {
+        valid = false;
+    }
+    if (valid && resident_entry == NULL) {
+        vitte_cache_resident_admit(cache, key, VITTE_CACHE_RESIDENT_GRAPH, data, size, NULL);
+    }
+    line = data + header_length;
+    /* Heap-read sources are writable and NUL-terminated; lines are split in place. */
+    while (valid && line < data + size) {
+        char *newline = strchr(line, '\n');
+
+        if (newline == NULL) {
+            valid = false;
+            break;
+        }
+        *newline = '\0';
+        valid = vitte_cache_parse_graph_line(graph, line);
+        line = newline + 1;
+    }
+    vitte_fs_free_source(data, size, storage);
+    if (!valid) {
+        vitte_cache_graph_destroy(graph);
+        return VITTE_STATUS_OK;
+    }
+    *hit = true;
+    return VITTE_STATUS_OK;
+}
+
+vitte_status_t vitte_cache_store_graph(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    const vitte_cache_graph_t *graph,
+    vitte_error_t *error
+) {
+    vitte_cache_buffer_t file;
+    vitte_fs_path_t directory;
+    vitte_fs_path_t path;
+    char line[160];
+    size_t index;
+    vitte_status_t status = VITTE_STATUS_OK;
+
+    if (!vitte_cache_is_initialized(cache) || key == NULL || graph == NULL) {
+        vitte_cache_set_error(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_CACHE_E_ARGUMENT", "invalid dependency graph store", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    if (vitte_cache_has_directory(cache)) {
+        status = vitte_cache_file_path(cache, VITTE_CACHE_GRAPH_DIRECTORY, key, VITTE_CACHE_GRAPH_EXTENSION, &directory, &path);
+    }
+    if (status != VITTE_STATUS_OK) {
+        vitte_cache_set_error(error, status, "VITTE_CACHE_E_PATH", "cache entry path is too long", cache->directory);
+        return status;
+    }
+    memset(&file, 0, sizeof(file));
+    (void)snprintf(line, sizeof(line), "vitte-graph %u %s\n", (unsigned)VITTE_CACHE_FORMAT_VERSION, vitte_version_string());
+    vitte_cache_buffer_put(&file, line, strlen(line));
+    for (index = 0u; index < graph->node_count; index++) {
+        const vitte_cache_graph_node_t *node = &graph->nodes[index];
+
+        (void)snprintf(
+            line,
+            sizeof(line),
+            "node %016llx%016llx %016llx%016llx ",
+            (unsigned long long)node->fingerprint.high,
+            (unsigned long long)node->fingerprint.low,
+            (unsigned long long)node->interface_key.high,
+            (unsigned long long)node->interface_key.low
+        );
+        vitte_cache_buffer_put(&file, line, strlen(line));
+        vitte_cache_buffer_put(&file, node->path, strlen(node->path));
+        vitte_cache_buffer_put(&file, "\n", 1u);
+    }
+    for (index = 0u; index < graph->edge_count; index++) {
+        (void)snprintf(line, sizeof(line), "edge %lu %lu\n", (unsigned long)graph->edges[index].from, (unsigned long)graph->edges[index].to);
+        vitte_cache_buffer_put(&file, line, strlen(line));
+    }
+    if (file.failed) {
+        free(file.data);
+        vitte_cache_set_error(error, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_CACHE_E_ENCODE", "failed to serialize dependency graph", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    vitte_cache_resident_admit(cache, key, VITTE_CACHE_RESIDENT_GRAPH, (const char *)file.data, file.size, NULL);
+    if (vitte_cache_has_directory(cache)) {
+        status = vitte_cache_publish(&directory, &path, file.data, file.size, error);
+    }
+    free(file.data);
+    return status;
+}
+
+static vitte_status_t vitte_cache_copy_file(const char *from, const char *to, vitte_error_t *error) {
+    vitte_fs_options_t options;
+    struct stat info;
+    char *data = NULL;
+    size_t size = 0u;
+    vitte_status_t status;
+
+    vitte_fs_options_init(&options);
+    options.max_file_bytes = 0u;
+    status = vitte_fs_read_all_alloc(from, &data, &size, &options, error);
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
+    status = vitte_fs_write_all(to, data, size, NULL, error);
+    vitte_fs_free(data);
+    if (status == VITTE_STATUS_OK && stat(from, &info) == 0) {
+        (void)chmod(to, info.st_mode & 0777);
+    }
+    return status;
+}
+
+vitte_status_t vitte_cache_load_object(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    const char *output_path,
+    bool *hit,
+    vitte_error_t *error
+) {
+    vitte_fs_path_t directory;
+    vitte_fs_path_t path;
+    size_t size = 0u;
+    vitte_status_t status;
+
+    if (hit != NULL) {
+        *hit = false;
+    }
+    if (!vitte_cache_is_initialized(cache) || key == NULL || output_path == NULL || hit == NULL) {
+        vitte_cache_set_error(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_CACHE_E_ARGUMENT", "invalid object cache load", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    /* Objects are files handed to the linker, so they only live on disk. */
+    if (!vitte_cache_has_directory(cache) ||
+        vitte_cache_file_path(cache, VITTE_CACHE_OBJECT_DIRECTORY, key, VITTE_CACHE_OBJECT_EXTENSION, &directory, &path) != VITTE_STATUS_OK ||
+        vitte_fs_size_bytes(path.text, &size, NULL) != VITTE_STATUS_OK) {
+        vitte_cache_count(cache, &cache->stats.object_miss_count, NULL, 0u);
+        return VITTE_STATUS_OK;
+    }
+    (void)remove(output_path);
+#ifdef VITTE_CACHE_HAVE_POSIX_FS
+    /* Refresh the entry's timestamp first: eviction is least recently used first. */
+    (void)utime(path.text, NULL);
+    status = link(path.text, output_path) == 0 ? VITTE_STATUS_OK : vitte_cache_copy_file(path.text, output_path, error);
+#else
+    status = vitte_cache_copy_file(path.text, output_path, error);
+#endif
+    if (status != VITTE_STATUS_OK) {
+        vitte_cache_count(cache, &cache->stats.object_miss_count, NULL, 0u);
+        return status;
+    }
+    vitte_cache_count(cache, &cache->stats.object_hit_count, &cache->stats.bytes_loaded, size);
+    *hit = true;
+    return VITTE_STATUS_OK;
+}
+
+#ifdef VITTE_CACHE_HAVE_POSIX_FS
+typedef struct vitte_cache_object_file {
+    char name[64];
+    size_t size;
+    time_t used;
+} vitte_cache_object_file_t;
+
+static int vitte_cache_object_file_compare(const void *left, const void *right) {
+    const vitte_cache_object_file_t *a = (const vitte_cache_object_file_t *)left;
+    const vitte_cache_object_file_t *b = (const vitte_cache_object_file_t *)right;
+
+    if (a->used != b->used) {
+        return a->used < b->used ? -1 : 1;
+    }
+    return strcmp(a->name, b->name);
+}
+
+/* Called with the cache lock held so concurrent stores do not evict twice. */
+static void vitte_cache_trim_objects(vitte_cache_t *cache, const vitte_fs_path_t *directory) {
+    vitte_cache_object_file_t *files = NULL;
+    size_t count = 0u;
+    size_t capacity = 0u;
+    size_t total = 0u;
+    size_t index;
+    struct dirent *entry;
+    DIR *stream = opendir(directory->text);
+
+    if (stream == NULL) {
+        return;
+    }
+    while ((entry = readdir(stream)) != NULL) {
+        vitte_fs_path_t path;
+        struct stat info;
+        size_t length = strlen(entry->d_name);
+
+        if (length <= sizeof(VITTE_CACHE_OBJECT_EXTENSION) - 1u || length >= sizeof(files[0].name) ||
+            strcmp(entry->d_name + length - (sizeof(VITTE_CACHE_OBJECT_EXTENSION) - 1u), VITTE_CACHE_OBJECT_EXTENSION) != 0 ||
+            vitte_fs_path_join(&path, directory, entry->d_name) != VITTE_STATUS_OK || stat(path.text, &info) != 0) {
+            continue;
+        }
+        if (count == capacity) {
+            size_t next_capacity = capacity == 0u ? 64u : capacity * 2u;
+            vitte_cache_object_file_t *next = (vitte_cache_object_file_t *)realloc(files, next_capacity * sizeof(*files));
+
+            if (next == NULL) {
+                break;
+            }
+            files = next;
+            capacity = next_capacity;
+        }
+        memcpy(files[count].name, entry->d_name, length + 1u);
+        files[count].size = (size_t)info.st_size;
+        files[count].used = info.st_mtime;
+        total += files[count].size;
+        count++;
+    }
+    closedir(stream);
+    if (total > cache->object_limit) {
+        qsort(files, count, sizeof(*files), vitte_cache_object_file_compare);
+        for (index = 0u; index < count && total > cache->object_limit; index++) {
+            vitte_fs_path_t path;
+
+            if (vitte_fs_path_join(&path, directory, files[index].name) == VITTE_STATUS_OK && remove(path.text) == 0) {
+                total -= files[index].size;
+                cache->stats.object_evict_count++;
+            }
+        }
+    }
+    free(files);
+}
+#endif
+
+vitte_status_t vitte_cache_store_object(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    const char *input_path,
+    vitte_error_t *error
+) {
+    vitte_fs_options_t options;
+    vitte_fs_path_t directory;
+    vitte_fs_path_t path;
+    char *data = NULL;
+    size_t size = 0u;
+    vitte_status_t status;
+
+    if (!vitte_cache_is_initialized(cache) || key == NULL || input_path == NULL) {
+        vitte_cache_set_error(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_CACHE_E_ARGUMENT", "invalid object cache store", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    if (!vitte_cache_has_directory(cache)) {
+        return VITTE_STATUS_OK;
+    }
+    status = vitte_cache_file_path(cache, VITTE_CACHE_OBJECT_DIRECTORY, key, VITTE_CACHE_OBJECT_EXTENSION, &directory, &path);
+    if (status != VITTE_STATUS_OK) {
+        vitte_cache_set_error(error, status, "VITTE_CACHE_E_PATH", "cache entry path is too long", cache->directory);
+        return status;
+    }
+    vitte_fs_options_init(&options);
+    options.max_file_bytes = 0u;
+    status = vitte_fs_read_all_alloc(input_path, &data, &size, &options, error);
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
+    if (size > cache->object_limit) {
+        vitte_fs_free(data);
+        return VITTE_STATUS_OK;
+    }
+    status = vitte_cache_publish(&directory, &path, data, size, error);
+    vitte_fs_free(data);
+    if (status != VITTE_STATUS_OK) {
+        vitte_cache_count(cache, &cache->stats.store_failure_count, NULL, 0u);
+        return status;
+    }
+#ifdef VITTE_CACHE_HAVE_POSIX_FS
+    {
+        struct stat info;
+
+        /* Entries are hard-linked to outputs, so they keep the output's permission bits. */
+        if (stat(input_path, &info) == 0) {
+            (void)chmod(path.text, info.st_mode & 0777);
+        }
+    }
+    vitte_parallel_mutex_lock(&cache->lock);
+    cache->stats.object_store_count++;
+    cache->stats.bytes_stored += size;
+    vitte_cache_trim_objects(cache, &directory);
+    vitte_parallel_mutex_unlock(&cache->lock);
+#else
+    vitte_cache_count(cache, &cache->stats.object_store_count, &cache->stats.bytes_stored, size);
+#endif
+    return VITTE_STATUS_OK;
+}
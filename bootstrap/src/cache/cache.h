@@ -0,0 +1,214 @@
+#ifndef VITTE_BOOTSTRAP_CACHE_H
+#define VITTE_BOOTSTRAP_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../api/error.h"
+#include "../ast/ast.h"
+#include "../filesystem/filesystem.h"
+#include "../intern/intern.h"
+#include "../module/module.h"
+#include "../parallel/parallel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VITTE_CACHE_FORMAT_VERSION 1u
+#define VITTE_CACHE_MODULE_DIRECTORY "modules"
+#define VITTE_CACHE_MODULE_EXTENSION ".vmc"
+#define VITTE_CACHE_GRAPH_DIRECTORY "graphs"
+#define VITTE_CACHE_GRAPH_EXTENSION ".vdg"
+#define VITTE_CACHE_OBJECT_DIRECTORY "objects"
+#define VITTE_CACHE_OBJECT_EXTENSION ".vob"
+#define VITTE_CACHE_DEFAULT_OBJECT_LIMIT ((size_t)512u * 1024u * 1024u)
+#define VITTE_CACHE_DEFAULT_RESIDENT_LIMIT ((size_t)256u * 1024u * 1024u)
+
+typedef struct vitte_cache_key {
+    uint64_t high;
+    uint64_t low;
+} vitte_cache_key_t;
+
+typedef struct vitte_cache_stats {
+    size_t hit_count;
+    size_t miss_count;
+    size_t reject_count;
+    size_t store_count;
+    size_t store_failure_count;
+    size_t bytes_loaded;
+    size_t bytes_stored;
+    size_t object_hit_count;
+    size_t object_miss_count;
+    size_t object_store_count;
+    size_t object_evict_count;
+    size_t resident_hit_count;
+    size_t resident_bytes;
+} vitte_cache_stats_t;
+
+/*
+ * Module dependency graph of one build. `fingerprint` covers everything a
+ * module's semantic analysis depends on; a zero fingerprint marks a module
+ * whose last analysis did not complete cleanly.
+ */
+typedef struct vitte_cache_graph_node {
+    char *path;
+    vitte_cache_key_t fingerprint;
+    vitte_cache_key_t interface_key;
+} vitte_cache_graph_node_t;
+
+typedef struct vitte_cache_graph_edge {
+    size_t from;
+    size_t to;
+} vitte_cache_graph_edge_t;
+
+typedef struct vitte_cache_graph {
+    vitte_cache_graph_node_t *nodes;
+    size_t node_count;
+    size_t node_capacity;
+    vitte_cache_graph_edge_t *edges;
+    size_t edge_count;
+    size_t edge_capacity;
+    size_t *slots;
+    size_t slot_capacity;
+} vitte_cache_graph_t;
+
+struct vitte_cache_resident;
+
+typedef struct vitte_cache {
+    bool initialized;
+    char directory[VITTE_FS_MAX_PATH];
+    size_t object_limit;
+    struct vitte_cache_resident *resident;
+    vitte_parallel_mutex_t lock;
+    vitte_cache_stats_t stats;
+    vitte_error_t last_error;
+} vitte_cache_t;
+
+void vitte_cache_key_init(vitte_cache_key_t *key);
+void vitte_cache_key_add(vitte_cache_key_t *key, const void *data, size_t size);
+void vitte_cache_key_add_text(vitte_cache_key_t *key, const char *text);
+void vitte_cache_key_add_size(vitte_cache_key_t *key, size_t value);
+void vitte_cache_key_add_key(vitte_cache_key_t *key, const vitte_cache_key_t *value);
+bool vitte_cache_key_equal(const vitte_cache_key_t *left, const vitte_cache_key_t *right);
+bool vitte_cache_key_is_zero(const vitte_cache_key_t *key);
+
+/*
+ * Hashes what importers of a parsed module can observe: its name, imports,
+ * exports and every top-level declaration except procedure bodies. Spans are
+ * ignored, so moving code or editing a body leaves the key unchanged.
+ */
+void vitte_cache_key_add_interface(vitte_cache_key_t *key, const vitte_ast_node_t *module);
+
+void vitte_cache_graph_init(vitte_cache_graph_t *graph);
+void vitte_cache_graph_destroy(vitte_cache_graph_t *graph);
+vitte_status_t vitte_cache_graph_add_node(
+    vitte_cache_graph_t *graph,
+    const char *path,
+    const vitte_cache_key_t *fingerprint,
+    const vitte_cache_key_t *interface_key,
+    size_t *index
+);
+vitte_status_t vitte_cache_graph_add_edge(vitte_cache_graph_t *graph, size_t from, size_t to);
+const vitte_cache_graph_node_t *vitte_cache_graph_find(const vitte_cache_graph_t *graph, const char *path);
+
+/* A NULL `directory` makes a cache that only has the resident tier. */
+vitte_status_t vitte_cache_init(vitte_cache_t *cache, const char *directory);
+void vitte_cache_destroy(vitte_cache_t *cache);
+bool vitte_cache_is_initialized(const vitte_cache_t *cache);
+bool vitte_cache_has_directory(const vitte_cache_t *cache);
+const vitte_error_t *vitte_cache_last_error(const vitte_cache_t *cache);
+void vitte_cache_stats(vitte_cache_t *cache, vitte_cache_stats_t *stats);
+/* Bounds the total size of stored objects; 0 restores the default. */
+void vitte_cache_set_object_limit(vitte_cache_t *cache, size_t limit);
+
+/*
+ * Keeps module and dependency-graph entries in memory for the cache's
+ * lifetime, in front of the directory: a long-lived process (the compile
+ * server) then loads modules it has seen without touching the disk. `limit`
+ * bounds the resident bytes (0 selects the default) and is enforced by
+ * vitte_cache_trim_resident, which evicts least recently used entries and
+ * must not run concurrently with loads.
+ */
+vitte_status_t vitte_cache_enable_resident(vitte_cache_t *cache, size_t limit);
+void vitte_cache_trim_resident(vitte_cache_t *cache);
+
+vitte_status_t vitte_cache_entry_path(
+    const vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    vitte_fs_path_t *path
+);
+
+/*
+ * Loads the module stored under `key` into an empty `ast` and replays its
+ * module metadata (name, declared imports) into `module`. Names are interned
+ * through `interner` when given, otherwise copied into the AST arena. A
+ * missing, stale, or malformed entry leaves both untouched and reports
+ * `*hit = false`. Safe to call from several threads when the interner is
+ * locking; errors go to `error`, not the cache.
+ */
+vitte_status_t vitte_cache_load_module(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    vitte_ast_t *ast,
+    vitte_module_t *module,
+    vitte_interner_t *interner,
+    bool *hit,
+    vitte_error_t *error
+);
+
+/* Serializes a parsed module; the entry is written to a temporary file and renamed into place. */
+vitte_status_t vitte_cache_store_module(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    const vitte_ast_t *ast,
+    const vitte_module_t *module,
+    vitte_error_t *error
+);
+
+/* Loads the graph stored under `key` into an empty graph; a missing or malformed file is a miss. */
+vitte_status_t vitte_cache_load_graph(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    vitte_cache_graph_t *graph,
+    bool *hit
+);
+vitte_status_t vitte_cache_store_graph(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    const vitte_cache_graph_t *graph,
+    vitte_error_t *error
+);
+
+/*
+ * Object cache for C compiler outputs (objects or executables). `key` must
+ * cover everything the output depends on: generated C, compiler identity and
+ * flags. A hit hard-links the entry to `output_path`, falling back to a copy
+ * that keeps the entry's permission bits, and marks the entry as recently
+ * used. A miss leaves `output_path` untouched.
+ */
+vitte_status_t vitte_cache_load_object(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    const char *output_path,
+    bool *hit,
+    vitte_error_t *error
+);
+
+/*
+ * Stores a copy of `input_path` under `key`, then evicts least recently used
+ * objects until the object directory fits the configured limit.
+ */
+vitte_status_t vitte_cache_store_object(
+    vitte_cache_t *cache,
+    const vitte_cache_key_t *key,
+    const char *input_path,
+    vitte_error_t *error
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VITTE_BOOTSTRAP_CACHE_H */
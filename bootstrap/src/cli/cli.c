@@ -2,15 +2,45 @@
 
 #include <errno.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "../api/context.h"
+#include "../arena/slab.h"
 #include "../diagnostic/diagnostic.h"
 #include "../driver/driver.h"
+#include "../intern/intern.h"
+#include "../module/module.h"
+#include "../parallel/parallel.h"
+#include "../server/server.h"
+#include "../trace/trace.h"
 
-#define VITTE_CLI_USAGE "usage: vitte-bootstrap <check|build|emit-c|run> <input.vit> [-o output] [--cc cc] [--keep-c]\n"
+/* Slowest modules listed by --time-passes. */
+#define VITTE_CLI_TIME_PASSES_MODULES ((size_t)20u)
+/* Largest modules listed by --mem-stats. */
+#define VITTE_CLI_MEM_STATS_MODULES ((size_t)20u)
+
+#define VITTE_CLI_USAGE "usage: vitte-bootstrap <check|build|emit-c|run|lex-bench> <input.vit> [-o output] [--cc cc] [--keep-c] [--c-warnings] [--jobs n] [--cache-dir dir] [--cache-max-mb n] [--cache-stats] [--separate-compilation] [--repeat n] [--no-server] [--time-passes] [--trace file] [--mem-stats] [--huge-pages]\n       vitte-bootstrap arena-bench [--repeat n] [--huge-pages]\n       vitte-bootstrap serve [--socket path] [--cache-dir dir] [--cache-max-mb n]\n       vitte-bootstrap batch [input.vit...] [--manifest file] [--emit check|c|build] [-o dir] [--jobs n] [--time-passes] [--trace file] [--mem-stats]\n"
+
+/* Variables that change how a forwarded command compiles; sent with every request. */
+static const char *const vitte_cli_forwarded_env[] = { "CC", "PATH", "VITTE_JOBS" };
+
+/*
+ * State a compile server keeps between requests: one context, whose interner
+ * outlives every build, and a cache with a resident tier in front of the
+ * optional cache directory. Resolver scopes and type registries are not
+ * resident; each request's driver builds them again.
+ */
+typedef struct vitte_cli_resident {
+    vitte_context_t context;
+    vitte_cache_t cache;
+} vitte_cli_resident_t;
+
+/* Past this much interner memory, the server empties it between requests. */
+#define VITTE_CLI_RESIDENT_INTERNER_LIMIT ((size_t)64u << 20)
 
 static bool vitte_cli_streq(const char *left, const char *right) {
     return left != NULL && right != NULL && strcmp(left, right) == 0;
@@ -18,6 +48,8 @@ static bool vitte_cli_streq(const char *left, const char *right) {
 
 void vitte_cli_options_init(vitte_cli_options_t *options) {
     const char *cc;
+    const char *jobs;
+    const char *cache_dir;
 
     if (options == NULL) {
         return;
@@ -28,6 +60,15 @@ void vitte_cli_options_init(vitte_cli_options_t *options) {
     options->command_name = "help";
     cc = getenv("CC");
     options->c_compiler = cc != NULL && cc[0] != '\0' ? cc : "cc";
+    options->repeat = VITTE_CLI_DEFAULT_LEX_BENCH_REPEAT;
+    options->batch_command = VITTE_CLI_COMMAND_CHECK;
+    options->jobs = 1u;
+    jobs = getenv("VITTE_JOBS");
+    if (jobs != NULL && jobs[0] != '\0') {
+        (void)vitte_parallel_parse_jobs(jobs, &options->jobs);
+    }
+    cache_dir = getenv("VITTE_CACHE_DIR");
+    options->cache_dir = cache_dir != NULL && cache_dir[0] != '\0' ? cache_dir : NULL;
 }
 
 const char *vitte_cli_command_name(vitte_cli_command_t command) {
@@ -44,6 +85,14 @@ const char *vitte_cli_command_name(vitte_cli_command_t command) {
             return "build";
         case VITTE_CLI_COMMAND_RUN:
             return "run";
+        case VITTE_CLI_COMMAND_LEX_BENCH:
+            return "lex-bench";
+        case VITTE_CLI_COMMAND_ARENA_BENCH:
+            return "arena-bench";
+        case VITTE_CLI_COMMAND_SERVE:
+            return "serve";
+        case VITTE_CLI_COMMAND_BATCH:
+            return "batch";
         default:
             return "unknown";
     }
@@ -60,13 +109,32 @@ void vitte_cli_print_help(FILE *stream) {
     fputs("  emit-c   write lowered C17 source\n", stream);
     fputs("  build    build a native executable through a C17 compiler\n", stream);
     fputs("  run      build to a temporary executable and run it\n", stream);
+    fputs("  lex-bench  time the module lexing pass over a source file\n", stream);
+    fputs("  arena-bench  compare small-object allocations per second: arena, slab and malloc\n", stream);
+    fputs("  serve    keep a compile server on a Unix socket; check, emit-c and build forward to it\n", stream);
+    fputs("  batch    check, emit or build many inputs in one process, one JSON line per input\n", stream);
     fputs("\noptions:\n", stream);
     fputs("  -h, --help       show this help\n", stream);
     fputs("  -V, --version    show version\n", stream);
     fputs("  -o, --output     set output path\n", stream);
     fputs("  --cc             set host C compiler\n", stream);
     fputs("  --keep-c         keep sidecar C file after build/run\n", stream);
+    fputs("  --c-warnings     print the C compiler's warnings about generated C on stderr\n", stream);
     fputs("  --emit-c         accepted alias flag for build metadata\n", stream);
+    fputs("  --jobs           analysis workers and C compiler processes (default VITTE_JOBS or 1, 0 = all CPUs)\n", stream);
+    fputs("  --cache-dir      reuse parsed modules and compiled C across runs (default VITTE_CACHE_DIR, off when unset)\n", stream);
+    fputs("  --cache-max-mb   bound the compiled-object cache in MiB (default 512)\n", stream);
+    fputs("  --cache-stats    report cached, parsed, analysed and reused modules on stderr\n", stream);
+    fputs("  --separate-compilation  build one C unit per module, reusing unchanged objects\n", stream);
+    fputs("  --repeat         lex-bench and arena-bench iterations (default 20)\n", stream);
+    fputs("  --socket         compile server socket (default VITTE_SERVER_SOCKET, $XDG_RUNTIME_DIR or /tmp)\n", stream);
+    fputs("  --no-server      compile in this process even if a server is running (also VITTE_NO_SERVER)\n", stream);
+    fputs("  --manifest       batch inputs from a file, one path per line (- for stdin)\n", stream);
+    fputs("  --emit           what batch does with each input: check (default), c or build\n", stream);
+    fputs("  --time-passes    report time, bytes and arena use per stage and per module on stderr\n", stream);
+    fputs("  --trace          write per-stage and per-module spans as Chrome trace JSON (Perfetto, chrome://tracing)\n", stream);
+    fputs("  --mem-stats      report memory per subsystem and per module, and peak RSS, on stderr\n", stream);
+    fputs("  --huge-pages     map arena blocks of 2 MiB or more with huge pages where the OS allows\n", stream);
 }
 
 void vitte_cli_print_version(FILE *stream) {
@@ -89,6 +157,14 @@ static bool vitte_cli_command_from_text(const char *text, vitte_cli_command_t *c
         *command = VITTE_CLI_COMMAND_BUILD;
     } else if (vitte_cli_streq(text, "run")) {
         *command = VITTE_CLI_COMMAND_RUN;
+    } else if (vitte_cli_streq(text, "lex-bench")) {
+        *command = VITTE_CLI_COMMAND_LEX_BENCH;
+    } else if (vitte_cli_streq(text, "arena-bench")) {
+        *command = VITTE_CLI_COMMAND_ARENA_BENCH;
+    } else if (vitte_cli_streq(text, "serve")) {
+        *command = VITTE_CLI_COMMAND_SERVE;
+    } else if (vitte_cli_streq(text, "batch")) {
+        *command = VITTE_CLI_COMMAND_BATCH;
     } else {
         return false;
     }
@@ -133,6 +209,16 @@ bool vitte_cli_parse_options(int argc, char **argv, vitte_cli_options_t *options
                 fputs("vitte-bootstrap: missing input path after --\n", stderr);
                 return false;
             }
+            if (options->command == VITTE_CLI_COMMAND_BATCH) {
+                for (; index < argc; index++) {
+                    if (options->batch_input_count >= VITTE_CLI_MAX_BATCH_INPUTS) {
+                        fputs("vitte-bootstrap: too many batch inputs; list them in a --manifest file\n", stderr);
+                        return false;
+                    }
+                    options->batch_inputs[options->batch_input_count++] = argv[index];
+                }
+                break;
+            }
             if (options->input_path != NULL) {
                 fprintf(stderr, "vitte-bootstrap: unexpected argument: %s\n", argv[index]);
                 return false;
@@ -167,15 +253,171 @@ bool vitte_cli_parse_options(int argc, char **argv, vitte_cli_options_t *options
             index++;
             continue;
         }
+        if (vitte_cli_streq(argument, "--c-warnings")) {
+            options->c_warnings = true;
+            index++;
+            continue;
+        }
         if (vitte_cli_streq(argument, "--emit-c")) {
             index++;
             continue;
         }
+        if (vitte_cli_streq(argument, "--jobs") || vitte_cli_streq(argument, "-j")) {
+            index++;
+            if (index >= argc) {
+                fputs("vitte-bootstrap: missing value for --jobs\n", stderr);
+                return false;
+            }
+            if (!vitte_parallel_parse_jobs(argv[index], &options->jobs)) {
+                fprintf(stderr, "vitte-bootstrap: invalid value for --jobs: %s\n", argv[index]);
+                return false;
+            }
+            index++;
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--cache-dir")) {
+            index++;
+            if (index >= argc || argv[index][0] == '\0') {
+                fputs("vitte-bootstrap: missing value for --cache-dir\n", stderr);
+                return false;
+            }
+            options->cache_dir = argv[index++];
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--cache-max-mb")) {
+            char *end = NULL;
+            unsigned long value;
+
+            index++;
+            if (index >= argc) {
+                fputs("vitte-bootstrap: missing value for --cache-max-mb\n", stderr);
+                return false;
+            }
+            value = strtoul(argv[index], &end, 10);
+            if (end == argv[index] || *end != '\0' || value == 0ul || value > (unsigned long)(SIZE_MAX >> 20)) {
+                fprintf(stderr, "vitte-bootstrap: invalid value for --cache-max-mb: %s\n", argv[index]);
+                return false;
+            }
+            options->cache_max_mb = (size_t)value;
+            index++;
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--cache-stats")) {
+            options->cache_stats = true;
+            index++;
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--separate-compilation")) {
+            options->separate_compilation = true;
+            index++;
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--socket")) {
+            index++;
+            if (index >= argc || argv[index][0] == '\0') {
+                fputs("vitte-bootstrap: missing value for --socket\n", stderr);
+                return false;
+            }
+            options->socket_path = argv[index++];
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--time-passes")) {
+            options->time_passes = true;
+            index++;
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--mem-stats")) {
+            options->mem_stats = true;
+            index++;
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--huge-pages")) {
+            options->huge_pages = true;
+            index++;
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--trace") || strncmp(argument, "--trace=", 8u) == 0) {
+            if (argument[7] == '=') {
+                options->trace_path = argument + 8;
+            } else if (++index < argc) {
+                options->trace_path = argv[index];
+            } else {
+                options->trace_path = NULL;
+            }
+            if (options->trace_path == NULL || options->trace_path[0] == '\0') {
+                fputs("vitte-bootstrap: missing value for --trace\n", stderr);
+                return false;
+            }
+            index++;
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--no-server")) {
+            options->no_server = true;
+            index++;
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--manifest") && options->command == VITTE_CLI_COMMAND_BATCH) {
+            index++;
+            if (index >= argc || argv[index][0] == '\0') {
+                fputs("vitte-bootstrap: missing value for --manifest\n", stderr);
+                return false;
+            }
+            options->manifest_path = argv[index++];
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--emit") && options->command == VITTE_CLI_COMMAND_BATCH) {
+            index++;
+            if (index >= argc) {
+                fputs("vitte-bootstrap: missing value for --emit\n", stderr);
+                return false;
+            }
+            if (vitte_cli_streq(argv[index], "check")) {
+                options->batch_command = VITTE_CLI_COMMAND_CHECK;
+            } else if (vitte_cli_streq(argv[index], "c")) {
+                options->batch_command = VITTE_CLI_COMMAND_EMIT_C;
+            } else if (vitte_cli_streq(argv[index], "build")) {
+                options->batch_command = VITTE_CLI_COMMAND_BUILD;
+            } else {
+                fprintf(stderr, "vitte-bootstrap: invalid value for --emit: %s\n", argv[index]);
+                return false;
+            }
+            index++;
+            continue;
+        }
+        if (vitte_cli_streq(argument, "--repeat")) {
+            char *end = NULL;
+            unsigned long value;
+
+            index++;
+            if (index >= argc) {
+                fputs("vitte-bootstrap: missing value for --repeat\n", stderr);
+                return false;
+            }
+            value = strtoul(argv[index], &end, 10);
+            if (end == argv[index] || *end != '\0' || value == 0ul) {
+                fprintf(stderr, "vitte-bootstrap: invalid value for --repeat: %s\n", argv[index]);
+                return false;
+            }
+            options->repeat = (size_t)value;
+            index++;
+            continue;
+        }
         if (argument[0] == '-' && !vitte_cli_streq(argument, "-")) {
             fprintf(stderr, "vitte-bootstrap: unknown option: %s\n", argument);
             return false;
         }
-        if (options->input_path != NULL) {
+        if (options->command == VITTE_CLI_COMMAND_BATCH) {
+            if (options->batch_input_count >= VITTE_CLI_MAX_BATCH_INPUTS) {
+                fputs("vitte-bootstrap: too many batch inputs; list them in a --manifest file\n", stderr);
+                return false;
+            }
+            options->batch_inputs[options->batch_input_count++] = argument;
+            index++;
+            continue;
+        }
+        if (options->input_path != NULL ||
+            options->command == VITTE_CLI_COMMAND_SERVE ||
+            options->command == VITTE_CLI_COMMAND_ARENA_BENCH) {
             fprintf(stderr, "vitte-bootstrap: unexpected argument: %s\n", argument);
             return false;
         }
@@ -183,9 +425,16 @@ bool vitte_cli_parse_options(int argc, char **argv, vitte_cli_options_t *options
         index++;
     }
 
-    if (options->input_path == NULL &&
+    if (options->command == VITTE_CLI_COMMAND_BATCH) {
+        if (options->batch_input_count == 0u && options->manifest_path == NULL) {
+            fputs("vitte-bootstrap: missing input path\n", stderr);
+            return false;
+        }
+    } else if (options->input_path == NULL &&
         options->command != VITTE_CLI_COMMAND_HELP &&
-        options->command != VITTE_CLI_COMMAND_VERSION) {
+        options->command != VITTE_CLI_COMMAND_VERSION &&
+        options->command != VITTE_CLI_COMMAND_SERVE &&
+        options->command != VITTE_CLI_COMMAND_ARENA_BENCH) {
         fputs("vitte-bootstrap: missing input path\n", stderr);
         return false;
     }
@@ -307,6 +556,344 @@ static void vitte_cli_print_driver_failure(const vitte_driver_t *driver) {
     }
 }
 
+/*
+ * What --time-passes and --trace collect over one command: driver stage
+ * totals summed over every run, and the spans behind them.
+ */
+typedef struct vitte_cli_profile {
+    bool enabled;
+    vitte_trace_t trace;
+    vitte_driver_stage_profile_t stages[VITTE_DRIVER_STAGE_COUNT];
+    uint64_t wall_ns;
+    uint64_t cpu_ns;
+} vitte_cli_profile_t;
+
+typedef struct vitte_cli_module_time {
+    const char *path;
+    uint64_t parse_ns;
+    uint64_t sema_ns;
+} vitte_cli_module_time_t;
+
+static bool vitte_cli_profile_init(vitte_cli_profile_t *profile, const vitte_cli_options_t *options) {
+    memset(profile, 0, sizeof(*profile));
+    if (!options->time_passes && options->trace_path == NULL) {
+        return true;
+    }
+    if (vitte_trace_init(&profile->trace) != VITTE_STATUS_OK) {
+        fprintf(stderr, "vitte-bootstrap: %s\n", vitte_trace_last_error(&profile->trace)->message);
+        return false;
+    }
+    profile->enabled = true;
+    return true;
+}
+
+static vitte_trace_t *vitte_cli_profile_trace(vitte_cli_profile_t *profile) {
+    return profile->enabled ? &profile->trace : NULL;
+}
+
+/* Not locked: batch workers call it under the output lock. */
+static void vitte_cli_profile_add(vitte_cli_profile_t *profile, const vitte_driver_result_t *result) {
+    size_t index;
+
+    if (!profile->enabled || result == NULL) {
+        return;
+    }
+    for (index = 0u; index < VITTE_DRIVER_STAGE_COUNT; index++) {
+        const vitte_driver_stage_profile_t *stage = &result->stage_profiles[index];
+
+        profile->stages[index].wall_ns += stage->wall_ns;
+        profile->stages[index].cpu_ns += stage->cpu_ns;
+        profile->stages[index].bytes_in += stage->bytes_in;
+        profile->stages[index].bytes_out += stage->bytes_out;
+        profile->stages[index].arena_bytes += stage->arena_bytes;
+        profile->stages[index].runs += stage->runs;
+    }
+    profile->cpu_ns += result->cpu_ns;
+}
+
+static int vitte_cli_compare_event_paths(const void *left, const void *right) {
+    return strcmp((*(const vitte_trace_event_t *const *)left)->detail, (*(const vitte_trace_event_t *const *)right)->detail);
+}
+
+static int vitte_cli_compare_module_times(const void *left, const void *right) {
+    const vitte_cli_module_time_t *a = (const vitte_cli_module_time_t *)left;
+    const vitte_cli_module_time_t *b = (const vitte_cli_module_time_t *)right;
+    uint64_t a_total = a->parse_ns + a->sema_ns;
+    uint64_t b_total = b->parse_ns + b->sema_ns;
+
+    if (a_total != b_total) {
+        return a_total > b_total ? -1 : 1;
+    }
+    return strcmp(a->path, b->path);
+}
+
+/* Per-module parse and semantic time, from the trace's module spans. */
+static void vitte_cli_print_module_times(const vitte_trace_t *trace) {
+    const vitte_trace_event_t **events;
+    vitte_cli_module_time_t *modules;
+    size_t event_count = 0u;
+    size_t module_count = 0u;
+    size_t index;
+
+    events = (const vitte_trace_event_t **)malloc((trace->count != 0u ? trace->count : 1u) * sizeof(*events));
+    modules = (vitte_cli_module_time_t *)calloc(trace->count != 0u ? trace->count : 1u, sizeof(*modules));
+    if (events == NULL || modules == NULL) {
+        free((void *)events);
+        free(modules);
+        return;
+    }
+    for (index = 0u; index < trace->count; index++) {
+        const vitte_trace_event_t *event = &trace->events[index];
+
+        if (event->detail != NULL &&
+            ((strcmp(event->category, "unit") == 0 && strcmp(event->name, "parse") == 0) ||
+             (strcmp(event->category, "stage") == 0 &&
+              strcmp(event->name, vitte_driver_stage_name(VITTE_DRIVER_STAGE_SEMANTIC)) == 0))) {
+            events[event_count++] = event;
+        }
+    }
+    qsort((void *)events, event_count, sizeof(*events), vitte_cli_compare_event_paths);
+    for (index = 0u; index < event_count; index++) {
+        vitte_cli_module_time_t *module;
+
+        if (module_count == 0u || strcmp(modules[module_count - 1u].path, events[index]->detail) != 0) {
+            modules[module_count++].path = events[index]->detail;
+        }
+        module = &modules[module_count - 1u];
+        if (strcmp(events[index]->category, "unit") == 0) {
+            module->parse_ns += events[index]->wall_ns;
+        } else {
+            module->sema_ns += events[index]->wall_ns;
+        }
+    }
+    qsort(modules, module_count, sizeof(*modules), vitte_cli_compare_module_times);
+    if (module_count > 0u) {
+        fprintf(stderr, "  %10s %10s  %s\n", "parse ms", "sema ms", "module");
+    }
+    for (index = 0u; index < module_count && index < VITTE_CLI_TIME_PASSES_MODULES; index++) {
+        fprintf(
+            stderr,
+            "  %10.3f %10.3f  %s\n",
+            (double)modules[index].parse_ns / 1e6,
+            (double)modules[index].sema_ns / 1e6,
+            modules[index].path
+        );
+    }
+    if (module_count > VITTE_CLI_TIME_PASSES_MODULES) {
+        fprintf(stderr, "  (%zu more modules)\n", module_count - VITTE_CLI_TIME_PASSES_MODULES);
+    }
+    free((void *)events);
+    free(modules);
+}
+
+static void vitte_cli_print_time_passes(const vitte_cli_profile_t *profile) {
+    vitte_driver_stage_profile_t total;
+    size_t index;
+
+    memset(&total, 0, sizeof(total));
+    fprintf(
+        stderr,
+        "[vitte-bootstrap] time-passes: %.3f ms wall, %.3f ms cpu on driver threads\n",
+        (double)profile->wall_ns / 1e6,
+        (double)profile->cpu_ns / 1e6
+    );
+    fprintf(
+        stderr,
+        "  %-14s %10s %10s %6s %12s %12s %12s\n",
+        "stage",
+        "wall ms",
+        "cpu ms",
+        "runs",
+        "bytes in",
+        "bytes out",
+        "arena bytes"
+    );
+    for (index = 0u; index < VITTE_DRIVER_STAGE_COUNT; index++) {
+        const vitte_driver_stage_profile_t *stage = &profile->stages[index];
+
+        if (stage->runs == 0u) {
+            continue;
+        }
+        fprintf(
+            stderr,
+            "  %-14s %10.3f %10.3f %6zu %12llu %12llu %12llu\n",
+            vitte_driver_stage_name((vitte_driver_stage_t)index),
+            (double)stage->wall_ns / 1e6,
+            (double)stage->cpu_ns / 1e6,
+            stage->runs,
+            (unsigned long long)stage->bytes_in,
+            (unsigned long long)stage->bytes_out,
+            (unsigned long long)stage->arena_bytes
+        );
+        total.wall_ns += stage->wall_ns;
+        total.cpu_ns += stage->cpu_ns;
+        total.runs += stage->runs;
+    }
+    fprintf(
+        stderr,
+        "  %-14s %10.3f %10.3f %6zu\n",
+        "total",
+        (double)total.wall_ns / 1e6,
+        (double)total.cpu_ns / 1e6,
+        total.runs
+    );
+    /* Driver setup and teardown; stages on parallel workers can hide it. */
+    if (profile->wall_ns > total.wall_ns) {
+        fprintf(stderr, "  %-14s %10.3f\n", "outside stages", (double)(profile->wall_ns - total.wall_ns) / 1e6);
+    }
+    vitte_cli_print_module_times(&profile->trace);
+}
+
+/* Reports and writes what was collected; a trace that cannot be written fails the command. */
+static int vitte_cli_profile_finish(vitte_cli_profile_t *profile, const vitte_cli_options_t *options, int exit_code) {
+    if (!profile->enabled) {
+        return exit_code;
+    }
+    if (options->time_passes) {
+        vitte_cli_print_time_passes(profile);
+    }
+    if (options->trace_path != NULL && vitte_trace_write_json(&profile->trace, options->trace_path) != VITTE_STATUS_OK) {
+        const vitte_error_t *error = vitte_trace_last_error(&profile->trace);
+
+        fprintf(stderr, "vitte-bootstrap: %s %s: %s\n", error->message, options->trace_path, error->details != NULL ? error->details : "unknown error");
+        if (exit_code == VITTE_CLI_EXIT_OK) {
+            exit_code = VITTE_CLI_EXIT_ERROR;
+        }
+    }
+    vitte_trace_destroy(&profile->trace);
+    return exit_code;
+}
+
+static double vitte_cli_kib(size_t bytes) {
+    return (double)bytes / 1024.0;
+}
+
+static size_t vitte_cli_unit_memory_bytes(const vitte_driver_unit_memory_t *unit) {
+    return unit->source_bytes + unit->token_bytes_reserved + unit->ast_bytes_reserved;
+}
+
+static int vitte_cli_compare_unit_memory(const void *left, const void *right) {
+    const vitte_driver_unit_memory_t *a = *(const vitte_driver_unit_memory_t *const *)left;
+    const vitte_driver_unit_memory_t *b = *(const vitte_driver_unit_memory_t *const *)right;
+    size_t a_bytes = vitte_cli_unit_memory_bytes(a);
+    size_t b_bytes = vitte_cli_unit_memory_bytes(b);
+
+    if (a_bytes != b_bytes) {
+        return a_bytes > b_bytes ? -1 : 1;
+    }
+    return strcmp(a->path, b->path);
+}
+
+/* Source, token and AST memory of the largest modules of one run. */
+static void vitte_cli_print_unit_memory(const vitte_driver_unit_memory_t *units, size_t unit_count) {
+    const vitte_driver_unit_memory_t **sorted;
+    size_t index;
+
+    if (unit_count == 0u) {
+        return;
+    }
+    sorted = (const vitte_driver_unit_memory_t **)malloc(unit_count * sizeof(*sorted));
+    if (sorted == NULL) {
+        return;
+    }
+    for (index = 0u; index < unit_count; index++) {
+        sorted[index] = &units[index];
+    }
+    qsort((void *)sorted, unit_count, sizeof(*sorted), vitte_cli_compare_unit_memory);
+    fprintf(
+        stderr,
+        "  %10s %12s %12s %12s %12s %6s  %s\n",
+        "source KiB",
+        "tokens KiB",
+        "tok used",
+        "ast KiB",
+        "ast used",
+        "parses",
+        "module"
+    );
+    for (index = 0u; index < unit_count && index < VITTE_CLI_MEM_STATS_MODULES; index++) {
+        const vitte_driver_unit_memory_t *unit = sorted[index];
+
+        fprintf(
+            stderr,
+            "  %10.1f %12.1f %12.1f %12.1f %12.1f %6zu  %s\n",
+            vitte_cli_kib(unit->source_bytes),
+            vitte_cli_kib(unit->token_bytes_reserved),
+            vitte_cli_kib(unit->token_bytes_used),
+            vitte_cli_kib(unit->ast_bytes_reserved),
+            vitte_cli_kib(unit->ast_bytes_used),
+            unit->parses,
+            unit->path
+        );
+    }
+    if (unit_count > VITTE_CLI_MEM_STATS_MODULES) {
+        fprintf(stderr, "  (%zu more modules)\n", unit_count - VITTE_CLI_MEM_STATS_MODULES);
+    }
+    free((void *)sorted);
+}
+
+/*
+ * --mem-stats: the context's per-subsystem counters, then the per-module
+ * table when one run's `units` are at hand. Peaks cover the context's life,
+ * which for the compile server spans every request so far.
+ */
+static void vitte_cli_print_mem_stats(
+    vitte_context_t *context,
+    const vitte_driver_unit_memory_t *units,
+    size_t unit_count
+) {
+    vitte_memory_stats_t subsystems[VITTE_MEMORY_SUBSYSTEM_COUNT];
+    vitte_memory_stats_t total;
+    size_t peak_rss = vitte_memory_peak_rss_bytes();
+    size_t index;
+
+    vitte_memory_account_snapshot(vitte_context_memory(context), subsystems, &total);
+    if (peak_rss != 0u) {
+        fprintf(stderr, "[vitte-bootstrap] mem-stats: peak RSS %.1f KiB\n", vitte_cli_kib(peak_rss));
+    } else {
+        fputs("[vitte-bootstrap] mem-stats: peak RSS unavailable\n", stderr);
+    }
+    fprintf(
+        stderr,
+        "  %-10s %12s %12s %12s %12s %10s\n",
+        "subsystem",
+        "live KiB",
+        "peak KiB",
+        "used KiB",
+        "peak used",
+        "allocs"
+    );
+    for (index = 0u; index < VITTE_MEMORY_SUBSYSTEM_COUNT; index++) {
+        const vitte_memory_stats_t *stats = &subsystems[index];
+
+        if (stats->allocation_count == 0u && stats->peak_bytes_reserved == 0u) {
+            continue;
+        }
+        fprintf(
+            stderr,
+            "  %-10s %12.1f %12.1f %12.1f %12.1f %10zu\n",
+            vitte_memory_subsystem_name((vitte_memory_subsystem_t)index),
+            vitte_cli_kib(stats->bytes_reserved),
+            vitte_cli_kib(stats->peak_bytes_reserved),
+            vitte_cli_kib(stats->bytes_used),
+            vitte_cli_kib(stats->peak_bytes_used),
+            stats->allocation_count
+        );
+    }
+    /* Subsystems peak at different times, so the total's peak is measured, not summed. */
+    fprintf(
+        stderr,
+        "  %-10s %12.1f %12.1f %12.1f %12.1f %10zu\n",
+        "total",
+        vitte_cli_kib(total.bytes_reserved),
+        vitte_cli_kib(total.peak_bytes_reserved),
+        vitte_cli_kib(total.bytes_used),
+        vitte_cli_kib(total.peak_bytes_used),
+        total.allocation_count
+    );
+    vitte_cli_print_unit_memory(units, unit_count);
+}
+
 static void vitte_cli_fill_driver_options(
     const vitte_cli_options_t *options,
     vitte_driver_emit_kind_t emit_kind,
@@ -319,19 +906,45 @@ static void vitte_cli_fill_driver_options(
     driver_options->emit_kind = emit_kind;
     driver_options->c_compiler = options->c_compiler;
     driver_options->keep_intermediate_c = options->keep_intermediate_c;
+    driver_options->c_warning_stream = options->c_warnings ? stderr : NULL;
+    driver_options->jobs = options->jobs;
+    driver_options->cache_path = options->cache_dir;
+    driver_options->max_cache_bytes = options->cache_max_mb << 20;
+    driver_options->separate_compilation = options->separate_compilation;
+    driver_options->huge_pages = options->huge_pages;
+}
+
+/*
+ * The resident cache keeps serialized bytes, not interned pointers, so no
+ * name outlives the request that interned it. Emptying the interner once it
+ * passes its limit keeps a long-lived server from growing with every new
+ * name it has ever seen.
+ */
+static void vitte_cli_trim_resident_interner(vitte_cli_resident_t *resident) {
+    vitte_memory_stats_t subsystems[VITTE_MEMORY_SUBSYSTEM_COUNT];
+
+    vitte_memory_account_snapshot(vitte_context_memory(&resident->context), subsystems, NULL);
+    if (subsystems[VITTE_MEMORY_INTERNER].bytes_reserved > VITTE_CLI_RESIDENT_INTERNER_LIMIT) {
+        (void)vitte_context_reset_interner(&resident->context);
+    }
 }
 
+/* With `resident`, the build runs on the compile server's context and cache. */
 static int vitte_cli_run_driver_command(
     const vitte_cli_options_t *options,
     vitte_driver_emit_kind_t emit_kind,
-    bool run_output
+    bool run_output,
+    vitte_cli_resident_t *resident
 ) {
     vitte_api_config_t config;
-    vitte_context_t context;
+    vitte_context_t local_context;
+    vitte_context_t *context = resident != NULL ? &resident->context : &local_context;
     vitte_driver_options_t driver_options;
     vitte_driver_t driver;
     vitte_driver_input_t input;
     vitte_driver_result_t result;
+    vitte_cache_stats_t before;
+    vitte_cli_profile_t profile;
     vitte_status_t status;
     const char *effective_output_path = options->output_path;
     char *owned_output_path = NULL;
@@ -350,20 +963,32 @@ static int vitte_cli_run_driver_command(
         effective_output_path = owned_output_path;
     }
 
+    if (!vitte_cli_profile_init(&profile, options)) {
+        free(owned_output_path);
+        return VITTE_CLI_EXIT_INTERNAL;
+    }
     vitte_api_config_init(&config);
-    if (vitte_context_init(&context, &config) != VITTE_STATUS_OK) {
+    if (resident == NULL && vitte_context_init(&local_context, &config) != VITTE_STATUS_OK) {
+        vitte_trace_destroy(&profile.trace);
         free(owned_output_path);
         return VITTE_CLI_EXIT_INTERNAL;
     }
 
     vitte_cli_fill_driver_options(options, emit_kind, effective_output_path, &driver_options);
-    status = vitte_driver_init(&driver, &context, &driver_options);
+    if (resident != NULL) {
+        driver_options.shared_cache = &resident->cache;
+    }
+    driver_options.trace = vitte_cli_profile_trace(&profile);
+    status = vitte_driver_init(&driver, context, &driver_options);
     if (status != VITTE_STATUS_OK) {
         const vitte_error_t *error = vitte_driver_last_error(&driver);
         if (error != NULL && vitte_error_is_set(error)) {
             fprintf(stderr, "vitte-bootstrap: %s\n", error->message);
         }
-        vitte_context_destroy(&context);
+        if (resident == NULL) {
+            vitte_context_destroy(&local_context);
+        }
+        vitte_trace_destroy(&profile.trace);
         free(owned_output_path);
         return vitte_cli_exit_from_status(status);
     }
@@ -373,10 +998,15 @@ static int vitte_cli_run_driver_command(
     if (status != VITTE_STATUS_OK) {
         fprintf(stderr, "vitte-bootstrap: cannot open %s: %s\n", options->input_path, strerror(errno));
         vitte_driver_shutdown(&driver);
-        vitte_context_destroy(&context);
+        if (resident == NULL) {
+            vitte_context_destroy(&local_context);
+        }
+        vitte_trace_destroy(&profile.trace);
         free(owned_output_path);
         return VITTE_CLI_EXIT_ERROR;
     }
+    /* A server's cache outlives the request; report this build's share only. */
+    vitte_cache_stats(driver.module_cache, &before);
 
     vitte_driver_result_init(&result);
     if (emit_kind == VITTE_DRIVER_EMIT_CHECK) {
@@ -386,6 +1016,8 @@ static int vitte_cli_run_driver_command(
     } else {
         status = vitte_driver_build(&driver, &input, effective_output_path, &result);
     }
+    vitte_cli_profile_add(&profile, &result);
+    profile.wall_ns = result.wall_ns;
 
     if (status != VITTE_STATUS_OK) {
         vitte_cli_print_driver_failure(&driver);
@@ -395,8 +1027,6 @@ static int vitte_cli_run_driver_command(
     } else if (emit_kind == VITTE_DRIVER_EMIT_C) {
         if (effective_output_path != NULL) {
             printf("[vitte-bootstrap] wrote C17: %s\n", effective_output_path);
-        } else if (result.output.buffer != NULL) {
-            fputs(result.output.buffer, stdout);
         }
     } else {
         printf("[vitte-bootstrap] built: %s\n", effective_output_path);
@@ -404,14 +1034,882 @@ static int vitte_cli_run_driver_command(
             exit_code = vitte_cli_run_executable(effective_output_path);
         }
     }
+    if (options->cache_stats && driver.module_cache != NULL) {
+        vitte_cache_stats_t stats;
+
+        vitte_cache_stats(driver.module_cache, &stats);
+        fprintf(
+            stderr,
+            "[vitte-bootstrap] cache: %zu loaded, %zu parsed, %zu analysed, %zu reused\n",
+            stats.hit_count - before.hit_count,
+            stats.miss_count + stats.reject_count - before.miss_count - before.reject_count,
+            result.modules_analyzed,
+            result.modules_reused
+        );
+    }
+    if (options->cache_stats && driver.module_cache != NULL && emit_kind == VITTE_DRIVER_EMIT_BINARY) {
+        vitte_cache_stats_t stats;
+
+        vitte_cache_stats(driver.module_cache, &stats);
+        fprintf(
+            stderr,
+            "[vitte-bootstrap] object cache: %zu hits, %zu misses, %zu evicted\n",
+            stats.object_hit_count - before.object_hit_count,
+            stats.object_miss_count - before.object_miss_count,
+            stats.object_evict_count - before.object_evict_count
+        );
+    }
+    if (options->cache_stats && resident != NULL) {
+        vitte_cache_stats_t stats;
+
+        vitte_cache_stats(driver.module_cache, &stats);
+        fprintf(
+            stderr,
+            "[vitte-bootstrap] resident: %zu modules from memory, %zu bytes held\n",
+            stats.resident_hit_count - before.resident_hit_count,
+            stats.resident_bytes
+        );
+    }
+    if (options->cache_stats && options->separate_compilation && emit_kind == VITTE_DRIVER_EMIT_BINARY) {
+        fprintf(stderr, "[vitte-bootstrap] objects: %zu compiled, %zu reused\n", result.objects_compiled, result.objects_reused);
+    }
+    if (options->mem_stats) {
+        vitte_cli_print_mem_stats(context, result.unit_memory, result.unit_memory_count);
+    }
+    exit_code = vitte_cli_profile_finish(&profile, options, exit_code);
 
     vitte_driver_input_destroy(&input);
     vitte_driver_shutdown(&driver);
-    vitte_context_destroy(&context);
+    if (resident != NULL) {
+        vitte_cache_trim_resident(&resident->cache);
+        vitte_cli_trim_resident_interner(resident);
+    } else {
+        vitte_context_destroy(&local_context);
+    }
     free(owned_output_path);
     return exit_code;
 }
 
+static unsigned long long vitte_cli_now_ns(void) {
+    struct timespec now;
+
+    if (timespec_get(&now, TIME_UTC) != TIME_UTC) {
+        return 0ull;
+    }
+    return (unsigned long long)now.tv_sec * 1000000000ull + (unsigned long long)now.tv_nsec;
+}
+
+/*
+ * Runs the same lexing pass the driver uses for every module (token buffer,
+ * payloads and line table) `repeat` times and reports the elapsed time, so
+ * tools/bootstrap_lexer_bench.py can aggregate throughput over a tree.
+ */
+static int vitte_cli_run_lex_bench(const vitte_cli_options_t *options) {
+    vitte_api_config_t config;
+    vitte_context_t context;
+    vitte_driver_input_t input;
+    vitte_module_options_t module_options;
+    vitte_module_t *module;
+    unsigned long long started;
+    unsigned long long elapsed;
+    size_t iteration;
+    size_t token_count = 0u;
+    int exit_code = VITTE_CLI_EXIT_OK;
+
+    vitte_api_config_init(&config);
+    if (vitte_context_init(&context, &config) != VITTE_STATUS_OK) {
+        return VITTE_CLI_EXIT_INTERNAL;
+    }
+    vitte_driver_input_init(&input);
+    if (vitte_driver_input_from_file(&input, options->input_path, 0u) != VITTE_STATUS_OK) {
+        fprintf(stderr, "vitte-bootstrap: cannot open %s: %s\n", options->input_path, strerror(errno));
+        vitte_context_destroy(&context);
+        return VITTE_CLI_EXIT_ERROR;
+    }
+
+    /* The module record holds its fixed tables inline; keep it off the stack. */
+    module = (vitte_module_t *)calloc(1u, sizeof(*module));
+    if (module == NULL) {
+        vitte_driver_input_destroy(&input);
+        vitte_context_destroy(&context);
+        return VITTE_CLI_EXIT_INTERNAL;
+    }
+    vitte_module_options_init(&module_options);
+    module_options.lexer_options.interner = vitte_context_interner(&context);
+    if (vitte_module_init(module, &module_options) != VITTE_STATUS_OK ||
+        vitte_module_attach_source(module, options->input_path, (char *)input.buffer, input.size, false) != VITTE_STATUS_OK) {
+        fprintf(stderr, "vitte-bootstrap: cannot prepare %s\n", options->input_path);
+        vitte_module_destroy(module);
+        free(module);
+        vitte_driver_input_destroy(&input);
+        vitte_context_destroy(&context);
+        return VITTE_CLI_EXIT_INTERNAL;
+    }
+
+    started = vitte_cli_now_ns();
+    for (iteration = 0u; iteration < options->repeat; iteration++) {
+        vitte_status_t status = vitte_module_lex(module);
+        if (status != VITTE_STATUS_OK && !vitte_module_has_tokens(module)) {
+            fprintf(stderr, "vitte-bootstrap: lexing failed: %s\n", vitte_module_last_error(module)->message);
+            exit_code = vitte_cli_exit_from_status(status);
+            break;
+        }
+        token_count = module->token_count;
+    }
+    elapsed = vitte_cli_now_ns() - started;
+
+    if (exit_code == VITTE_CLI_EXIT_OK) {
+        printf(
+            "[vitte-bootstrap] lex-bench: %s bytes=%zu tokens=%zu repeat=%zu ns=%llu\n",
+            options->input_path,
+            input.size,
+            token_count,
+            options->repeat,
+            elapsed
+        );
+    }
+    vitte_module_destroy(module);
+    free(module);
+    vitte_driver_input_destroy(&input);
+    vitte_context_destroy(&context);
+    return exit_code;
+}
+
+/* Node sizes the front end allocates most: list cells, values, instructions. */
+static const size_t vitte_cli_arena_bench_sizes[] = { 16u, 24u, 32u, 40u, 48u, 64u, 96u, 128u };
+
+static double vitte_cli_per_second(size_t count, unsigned long long elapsed_ns) {
+    return elapsed_ns != 0ull ? (double)count * 1e9 / (double)elapsed_ns : 0.0;
+}
+
+/*
+ * Allocates VITTE_CLI_ARENA_BENCH_OBJECTS small objects `repeat` times from
+ * an arena (then resets it), from a slab (then frees them all back, so later
+ * rounds are served by the free lists) and from malloc (then frees them), and
+ * reports allocations per second for each. Every object is written so the
+ * allocations cannot be optimized away.
+ */
+static int vitte_cli_run_arena_bench(const vitte_cli_options_t *options) {
+    size_t size_count = sizeof(vitte_cli_arena_bench_sizes) / sizeof(vitte_cli_arena_bench_sizes[0]);
+    size_t total = VITTE_CLI_ARENA_BENCH_OBJECTS * options->repeat;
+    vitte_arena_config_t config;
+    vitte_arena_t arena;
+    vitte_arena_slab_t slab;
+    unsigned char **objects;
+    unsigned long long started;
+    unsigned long long arena_ns;
+    unsigned long long slab_ns;
+    unsigned long long malloc_ns;
+    size_t iteration;
+    size_t index;
+    size_t reserved;
+    size_t checksum = 0u;
+    int exit_code = VITTE_CLI_EXIT_OK;
+
+    objects = (unsigned char **)calloc(VITTE_CLI_ARENA_BENCH_OBJECTS, sizeof(*objects));
+    if (objects == NULL) {
+        return VITTE_CLI_EXIT_INTERNAL;
+    }
+    vitte_arena_config_init(&config);
+    config.huge_pages = options->huge_pages;
+    if (vitte_arena_init(&arena, &config) != VITTE_STATUS_OK || !vitte_arena_slab_init(&slab, &arena)) {
+        free(objects);
+        return VITTE_CLI_EXIT_INTERNAL;
+    }
+
+    started = vitte_cli_now_ns();
+    for (iteration = 0u; iteration < options->repeat && exit_code == VITTE_CLI_EXIT_OK; iteration++) {
+        for (index = 0u; index < VITTE_CLI_ARENA_BENCH_OBJECTS; index++) {
+            objects[index] = (unsigned char *)vitte_arena_alloc(&arena, vitte_cli_arena_bench_sizes[index % size_count], 0u);
+            if (objects[index] == NULL) {
+                exit_code = VITTE_CLI_EXIT_INTERNAL;
+                break;
+            }
+            objects[index][0] = (unsigned char)index;
+        }
+        for (index = 0u; exit_code == VITTE_CLI_EXIT_OK && index < VITTE_CLI_ARENA_BENCH_OBJECTS; index++) {
+            checksum += objects[index][0];
+        }
+        vitte_arena_reset(&arena);
+    }
+    arena_ns = vitte_cli_now_ns() - started;
+
+    vitte_arena_slab_reset(&slab);
+    started = vitte_cli_now_ns();
+    for (iteration = 0u; iteration < options->repeat && exit_code == VITTE_CLI_EXIT_OK; iteration++) {
+        for (index = 0u; index < VITTE_CLI_ARENA_BENCH_OBJECTS; index++) {
+            objects[index] = (unsigned char *)vitte_arena_slab_alloc(&slab, vitte_cli_arena_bench_sizes[index % size_count]);
+            if (objects[index] == NULL) {
+                exit_code = VITTE_CLI_EXIT_INTERNAL;
+                break;
+            }
+            objects[index][0] = (unsigned char)index;
+        }
+        for (index = 0u; exit_code == VITTE_CLI_EXIT_OK && index < VITTE_CLI_ARENA_BENCH_OBJECTS; index++) {
+            checksum += objects[index][0];
+            vitte_arena_slab_free(&slab, objects[index], vitte_cli_arena_bench_sizes[index % size_count]);
+        }
+    }
+    slab_ns = vitte_cli_now_ns() - started;
+    reserved = vitte_arena_stats(&arena)->bytes_reserved;
+
+    started = vitte_cli_now_ns();
+    for (iteration = 0u; iteration < options->repeat && exit_code == VITTE_CLI_EXIT_OK; iteration++) {
+        for (index = 0u; index < VITTE_CLI_ARENA_BENCH_OBJECTS; index++) {
+            objects[index] = (unsigned char *)malloc(vitte_cli_arena_bench_sizes[index % size_count]);
+            if (objects[index] == NULL) {
+                exit_code = VITTE_CLI_EXIT_INTERNAL;
+                break;
+            }
+            objects[index][0] = (unsigned char)index;
+        }
+        for (index = 0u; index < VITTE_CLI_ARENA_BENCH_OBJECTS && objects[index] != NULL; index++) {
+            checksum += objects[index][0];
+            free(objects[index]);
+            objects[index] = NULL;
+        }
+    }
+    malloc_ns = vitte_cli_now_ns() - started;
+
+    if (exit_code == VITTE_CLI_EXIT_OK) {
+        printf(
+            "[vitte-bootstrap] arena-bench: objects=%zu repeat=%zu huge-pages=%s "
+            "arena=%.0f/s slab=%.0f/s malloc=%.0f/s slab-reserved=%zu checksum=%zu\n",
+            VITTE_CLI_ARENA_BENCH_OBJECTS,
+            options->repeat,
+            options->huge_pages ? "on" : "off",
+            vitte_cli_per_second(total, arena_ns),
+            vitte_cli_per_second(total, slab_ns),
+            vitte_cli_per_second(total, malloc_ns),
+            reserved,
+            checksum
+        );
+    } else {
+        fputs("vitte-bootstrap: arena-bench: allocation failed\n", stderr);
+    }
+    vitte_arena_destroy(&arena);
+    free(objects);
+    return exit_code;
+}
+
+static bool vitte_cli_command_is_forwarded(vitte_cli_command_t command) {
+    return command == VITTE_CLI_COMMAND_CHECK ||
+        command == VITTE_CLI_COMMAND_EMIT_C ||
+        command == VITTE_CLI_COMMAND_BUILD;
+}
+
+/*
+ * Handles one forwarded command line inside the server. The request's
+ * --cache-dir is ignored: every request shares the server's cache.
+ */
+static int vitte_cli_serve_request(const vitte_server_request_t *request, void *user) {
+    vitte_cli_resident_t *resident = (vitte_cli_resident_t *)user;
+    vitte_cli_options_t options;
+    char *argv[VITTE_SERVER_MAX_ARGUMENTS + 2u];
+
+    argv[0] = (char *)"vitte-bootstrap";
+    memcpy(argv + 1, request->argv, (request->argc + 1u) * sizeof(*argv));
+    if (!vitte_cli_parse_options((int)request->argc + 1, argv, &options)) {
+        vitte_cli_print_help(stderr);
+        return VITTE_CLI_EXIT_USAGE;
+    }
+    if (!vitte_cli_command_is_forwarded(options.command)) {
+        fprintf(stderr, "vitte-bootstrap: the compile server does not run %s\n", options.command_name);
+        return VITTE_CLI_EXIT_USAGE;
+    }
+    return vitte_cli_run_driver_command(
+        &options,
+        options.command == VITTE_CLI_COMMAND_CHECK ? VITTE_DRIVER_EMIT_CHECK :
+            options.command == VITTE_CLI_COMMAND_EMIT_C ? VITTE_DRIVER_EMIT_C : VITTE_DRIVER_EMIT_BINARY,
+        false,
+        resident
+    );
+}
+
+static int vitte_cli_run_serve(const vitte_cli_options_t *options) {
+    vitte_api_config_t config;
+    vitte_cli_resident_t resident;
+    vitte_server_t server;
+    char socket_path[VITTE_SERVER_MAX_SOCKET_PATH];
+    const char *path = options->socket_path;
+    vitte_status_t status;
+
+    if (path == NULL) {
+        if (!vitte_server_default_socket_path(socket_path, sizeof(socket_path))) {
+            fputs("vitte-bootstrap: compile server socket path is too long\n", stderr);
+            return VITTE_CLI_EXIT_ERROR;
+        }
+        path = socket_path;
+    }
+    vitte_api_config_init(&config);
+    if (vitte_context_init(&resident.context, &config) != VITTE_STATUS_OK) {
+        return VITTE_CLI_EXIT_INTERNAL;
+    }
+    status = vitte_cache_init(&resident.cache, options->cache_dir);
+    if (status == VITTE_STATUS_OK) {
+        vitte_cache_set_object_limit(&resident.cache, options->cache_max_mb << 20);
+        status = vitte_cache_enable_resident(&resident.cache, 0u);
+    }
+    if (status != VITTE_STATUS_OK) {
+        fprintf(stderr, "vitte-bootstrap: %s\n", vitte_cache_last_error(&resident.cache)->message);
+        vitte_cache_destroy(&resident.cache);
+        vitte_context_destroy(&resident.context);
+        return vitte_cli_exit_from_status(status);
+    }
+
+    status = vitte_server_init(&server, path);
+    if (status == VITTE_STATUS_OK) {
+        printf("[vitte-bootstrap] serving on %s\n", server.socket_path);
+        fflush(stdout);
+        status = vitte_server_serve(&server, vitte_cli_serve_request, &resident);
+    }
+    if (status != VITTE_STATUS_OK) {
+        const vitte_error_t *error = vitte_server_last_error(&server);
+
+        if (error->details != NULL && error->details[0] != '\0') {
+            fprintf(stderr, "vitte-bootstrap: %s: %s\n", error->message, error->details);
+        } else {
+            fprintf(stderr, "vitte-bootstrap: %s\n", error->message);
+        }
+    } else {
+        printf("[vitte-bootstrap] server stopped after %zu requests\n", server.request_count);
+    }
+    vitte_server_destroy(&server);
+    vitte_cache_destroy(&resident.cache);
+    vitte_context_destroy(&resident.context);
+    return status == VITTE_STATUS_OK ? VITTE_CLI_EXIT_OK : vitte_cli_exit_from_status(status);
+}
+
+/* A growable line of JSON; any allocation failure sticks in `failed`. */
+typedef struct vitte_cli_text {
+    char *data;
+    size_t length;
+    size_t capacity;
+    bool failed;
+} vitte_cli_text_t;
+
+static void vitte_cli_text_append(vitte_cli_text_t *text, const char *bytes, size_t length) {
+    if (text->failed) {
+        return;
+    }
+    if (text->length + length + 1u > text->capacity) {
+        size_t capacity = text->capacity != 0u ? text->capacity : 256u;
+        char *grown;
+
+        while (text->length + length + 1u > capacity) {
+            capacity *= 2u;
+        }
+        grown = (char *)realloc(text->data, capacity);
+        if (grown == NULL) {
+            text->failed = true;
+            return;
+        }
+        text->data = grown;
+        text->capacity = capacity;
+    }
+    memcpy(text->data + text->length, bytes, length);
+    text->length += length;
+    text->data[text->length] = '\0';
+}
+
+static void vitte_cli_text_puts(vitte_cli_text_t *text, const char *bytes) {
+    vitte_cli_text_append(text, bytes, strlen(bytes));
+}
+
+static void vitte_cli_text_number(vitte_cli_text_t *text, const char *name, unsigned long long value) {
+    char buffer[64];
+    int length = snprintf(buffer, sizeof(buffer), ",\"%s\":%llu", name, value);
+
+    vitte_cli_text_append(text, buffer, (size_t)length);
+}
+
+static void vitte_cli_text_json_string(vitte_cli_text_t *text, const char *value) {
+    static const char hex[] = "0123456789abcdef";
+    const unsigned char *cursor = (const unsigned char *)(value != NULL ? value : "");
+    const unsigned char *run = cursor;
+
+    vitte_cli_text_puts(text, "\"");
+    for (; *cursor != '\0'; cursor++) {
+        char escape[7];
+
+        if (*cursor >= 0x20u && *cursor != '"' && *cursor != '\\') {
+            continue;
+        }
+        vitte_cli_text_append(text, (const char *)run, (size_t)(cursor - run));
+        escape[0] = '\\';
+        if (*cursor == '"' || *cursor == '\\') {
+            escape[1] = (char)*cursor;
+            vitte_cli_text_append(text, escape, 2u);
+        } else if (*cursor == '\n') {
+            vitte_cli_text_append(text, "\\n", 2u);
+        } else if (*cursor == '\t') {
+            vitte_cli_text_append(text, "\\t", 2u);
+        } else {
+            memcpy(escape + 1, "u00", 3u);
+            escape[4] = hex[*cursor >> 4];
+            escape[5] = hex[*cursor & 0x0fu];
+            vitte_cli_text_append(text, escape, 6u);
+        }
+        run = cursor + 1;
+    }
+    vitte_cli_text_append(text, (const char *)run, (size_t)(cursor - run));
+    vitte_cli_text_puts(text, "\"");
+}
+
+/* Appends `,"name":"value"`. */
+static void vitte_cli_text_string(vitte_cli_text_t *text, const char *name, const char *value) {
+    vitte_cli_text_puts(text, ",\"");
+    vitte_cli_text_puts(text, name);
+    vitte_cli_text_puts(text, "\":");
+    vitte_cli_text_json_string(text, value);
+}
+
+typedef struct vitte_cli_batch_item {
+    const char *input_path;
+    /* Formatted result line, set once the input is done. */
+    char *line;
+    int exit_code;
+    bool done;
+} vitte_cli_batch_item_t;
+
+/* The driver is created on a worker's first input and reused for every later one. */
+typedef struct vitte_cli_batch_worker {
+    vitte_driver_t *driver;
+    vitte_driver_result_t *result;
+    /* Failures that happen before the driver runs. */
+    vitte_error_t error;
+} vitte_cli_batch_worker_t;
+
+typedef struct vitte_cli_batch {
+    const vitte_cli_options_t *options;
+    vitte_context_t *context;
+    vitte_cache_t *cache;
+    vitte_cli_batch_item_t *items;
+    size_t count;
+    vitte_cli_batch_worker_t *workers;
+    vitte_parallel_mutex_t output_lock;
+    size_t next_output;
+    /* Stage totals are summed under `output_lock`. */
+    vitte_cli_profile_t *profile;
+} vitte_cli_batch_t;
+
+/*
+ * Reads one input path per line into `*buffer` (modified in place) and
+ * appends them to `*paths`. Blank lines and lines starting with `#` are
+ * skipped; `-` reads standard input.
+ */
+static bool vitte_cli_read_manifest(
+    const char *manifest_path,
+    char **buffer,
+    const char ***paths,
+    size_t *count
+) {
+    FILE *file = vitte_cli_streq(manifest_path, "-") ? stdin : fopen(manifest_path, "rb");
+    size_t length = 0u;
+    size_t capacity = 4096u;
+    size_t path_capacity = *count;
+    char *cursor;
+    char *text;
+
+    if (file == NULL) {
+        fprintf(stderr, "vitte-bootstrap: cannot open %s: %s\n", manifest_path, strerror(errno));
+        return false;
+    }
+    text = (char *)malloc(capacity);
+    while (text != NULL) {
+        size_t chunk = fread(text + length, 1u, capacity - length - 1u, file);
+        char *grown;
+
+        length += chunk;
+        if (length + 1u < capacity) {
+            break;
+        }
+        capacity *= 2u;
+        grown = (char *)realloc(text, capacity);
+        if (grown == NULL) {
+            free(text);
+        }
+        text = grown;
+    }
+    if (text == NULL || ferror(file)) {
+        fprintf(stderr, "vitte-bootstrap: cannot read %s\n", manifest_path);
+        free(text);
+        if (file != stdin) {
+            fclose(file);
+        }
+        return false;
+    }
+    if (file != stdin) {
+        fclose(file);
+    }
+    text[length] = '\0';
+    *buffer = text;
+
+    for (cursor = text; *cursor != '\0';) {
+        char *line = cursor;
+        char *end = strchr(cursor, '\n');
+        char *trim;
+
+        if (end != NULL) {
+            *end = '\0';
+            cursor = end + 1;
+        } else {
+            cursor += strlen(cursor);
+        }
+        trim = line + strlen(line);
+        while (trim > line && (trim[-1] == '\r' || trim[-1] == ' ' || trim[-1] == '\t')) {
+            *--trim = '\0';
+        }
+        if (line[0] == '\0' || line[0] == '#') {
+            continue;
+        }
+        if (*count == path_capacity) {
+            const char **grown;
+
+            path_capacity = path_capacity != 0u ? path_capacity * 2u : 64u;
+            grown = (const char **)realloc((void *)*paths, path_capacity * sizeof(**paths));
+            if (grown == NULL) {
+                fputs("vitte-bootstrap: out of memory reading manifest\n", stderr);
+                return false;
+            }
+            *paths = grown;
+        }
+        (*paths)[(*count)++] = line;
+    }
+    return true;
+}
+
+/* `-o DIR` puts each output in DIR; otherwise build writes next to the working directory and emit-c keeps the C in memory. */
+static char *vitte_cli_batch_output_path(const vitte_cli_options_t *options, const char *input_path) {
+    const char *suffix = options->batch_command == VITTE_CLI_COMMAND_EMIT_C ? ".c" : "";
+    char *name;
+    char *path;
+    size_t directory_length;
+    size_t name_length;
+
+    if (options->batch_command == VITTE_CLI_COMMAND_CHECK ||
+        (options->output_path == NULL && options->batch_command == VITTE_CLI_COMMAND_EMIT_C)) {
+        return NULL;
+    }
+    name = vitte_cli_default_output_path(input_path, suffix);
+    if (name == NULL || options->output_path == NULL) {
+        return name;
+    }
+    directory_length = strlen(options->output_path);
+    name_length = strlen(name);
+    path = (char *)malloc(directory_length + name_length + 2u);
+    if (path != NULL) {
+        memcpy(path, options->output_path, directory_length);
+        path[directory_length] = '/';
+        memcpy(path + directory_length + 1u, name, name_length + 1u);
+    }
+    free(name);
+    return path;
+}
+
+static void vitte_cli_batch_format(
+    vitte_cli_text_t *text,
+    const vitte_cli_batch_item_t *item,
+    const vitte_diagnostic_bag_t *diagnostics,
+    const vitte_error_t *error,
+    const vitte_driver_result_t *result,
+    vitte_status_t status,
+    const char *output_path,
+    unsigned long long elapsed
+) {
+    size_t index;
+
+    vitte_cli_text_puts(text, "{\"input\":");
+    vitte_cli_text_json_string(text, item->input_path);
+    vitte_cli_text_string(text, "status", item->exit_code == VITTE_CLI_EXIT_OK ? "ok" : "error");
+    vitte_cli_text_number(text, "exit", (unsigned long long)item->exit_code);
+    if (status == VITTE_STATUS_OK && output_path != NULL) {
+        vitte_cli_text_string(text, "output", output_path);
+    }
+    if (result != NULL) {
+        if (status != VITTE_STATUS_OK) {
+            vitte_cli_text_string(text, "stage", vitte_driver_stage_name(result->failed_stage));
+        } else if (result->output.kind == VITTE_DRIVER_EMIT_C) {
+            vitte_cli_text_number(text, "bytes", (unsigned long long)result->output.bytes_written);
+        }
+        vitte_cli_text_number(text, "errors", (unsigned long long)result->error_count);
+        vitte_cli_text_number(text, "warnings", (unsigned long long)result->warning_count);
+        vitte_cli_text_number(text, "analysed", (unsigned long long)result->modules_analyzed);
+        vitte_cli_text_number(text, "reused", (unsigned long long)result->modules_reused);
+    }
+    vitte_cli_text_number(text, "ns", elapsed);
+    if (status != VITTE_STATUS_OK && error != NULL && vitte_error_is_set(error)) {
+        vitte_cli_text_string(text, "error", error->message);
+        if (error->details != NULL && error->details[0] != '\0') {
+            vitte_cli_text_string(text, "details", error->details);
+        }
+    }
+    vitte_cli_text_puts(text, ",\"diagnostics\":[");
+    for (index = 0u; diagnostics != NULL && index < diagnostics->count; index++) {
+        const vitte_diagnostic_t *diagnostic = vitte_diagnostic_at(diagnostics, index);
+
+        vitte_cli_text_puts(text, index == 0u ? "{\"severity\":" : ",{\"severity\":");
+        vitte_cli_text_json_string(text, vitte_diagnostic_severity_name(diagnostic->severity));
+        vitte_cli_text_string(text, "code", diagnostic->code);
+        vitte_cli_text_string(text, "message", diagnostic->message);
+        if (diagnostic->details != NULL && diagnostic->details[0] != '\0') {
+            vitte_cli_text_string(text, "details", diagnostic->details);
+        }
+        if (diagnostic->source_name != NULL) {
+            vitte_cli_text_string(text, "file", diagnostic->source_name);
+        }
+        if (diagnostic->has_span) {
+            vitte_cli_text_number(text, "line", diagnostic->start_line);
+            vitte_cli_text_number(text, "column", diagnostic->start_column);
+        }
+        vitte_cli_text_puts(text, "}");
+    }
+    vitte_cli_text_puts(text, "]}\n");
+}
+
+/*
+ * Records `item`'s line and prints every finished line that has no unfinished
+ * input before it, so output follows input order whatever the schedule.
+ */
+static void vitte_cli_batch_finish(
+    vitte_cli_batch_t *batch,
+    vitte_cli_batch_item_t *item,
+    char *line,
+    const vitte_driver_result_t *result
+) {
+    vitte_parallel_mutex_lock(&batch->output_lock);
+    vitte_cli_profile_add(batch->profile, result);
+    item->line = line;
+    item->done = true;
+    while (batch->next_output < batch->count && batch->items[batch->next_output].done) {
+        vitte_cli_batch_item_t *next = &batch->items[batch->next_output++];
+
+        if (next->line != NULL) {
+            fputs(next->line, stdout);
+            free(next->line);
+            next->line = NULL;
+        } else {
+            fprintf(stderr, "vitte-bootstrap: out of memory reporting %s\n", next->input_path);
+        }
+    }
+    fflush(stdout);
+    vitte_parallel_mutex_unlock(&batch->output_lock);
+}
+
+static bool vitte_cli_batch_prepare_worker(vitte_cli_batch_t *batch, vitte_cli_batch_worker_t *worker) {
+    vitte_driver_options_t driver_options;
+    vitte_driver_emit_kind_t emit_kind;
+
+    if (worker->driver != NULL) {
+        return true;
+    }
+    worker->driver = (vitte_driver_t *)calloc(1u, sizeof(*worker->driver));
+    worker->result = (vitte_driver_result_t *)malloc(sizeof(*worker->result));
+    if (worker->driver == NULL || worker->result == NULL) {
+        vitte_error_set(&worker->error, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_CLI_E_BATCH", "failed to allocate batch worker");
+    } else {
+        emit_kind = batch->options->batch_command == VITTE_CLI_COMMAND_CHECK ? VITTE_DRIVER_EMIT_CHECK :
+            batch->options->batch_command == VITTE_CLI_COMMAND_EMIT_C ? VITTE_DRIVER_EMIT_C : VITTE_DRIVER_EMIT_BINARY;
+        vitte_cli_fill_driver_options(batch->options, emit_kind, NULL, &driver_options);
+        /* Inputs are the unit of parallelism; each pipeline stays on its worker. */
+        driver_options.jobs = 1u;
+        driver_options.shared_cache = batch->cache;
+        driver_options.trace = vitte_cli_profile_trace(batch->profile);
+        if (vitte_driver_init(worker->driver, batch->context, &driver_options) == VITTE_STATUS_OK) {
+            return true;
+        }
+        vitte_error_copy(&worker->error, vitte_driver_last_error(worker->driver));
+        vitte_driver_shutdown(worker->driver);
+    }
+    free(worker->driver);
+    free(worker->result);
+    worker->driver = NULL;
+    worker->result = NULL;
+    return false;
+}
+
+static bool vitte_cli_batch_task(size_t index, size_t worker_index, void *user) {
+    vitte_cli_batch_t *batch = (vitte_cli_batch_t *)user;
+    vitte_cli_batch_item_t *item = &batch->items[index];
+    vitte_cli_batch_worker_t *worker = &batch->workers[worker_index];
+    vitte_cli_command_t command = batch->options->batch_command;
+    vitte_driver_input_t input;
+    vitte_cli_text_t text;
+    const vitte_driver_result_t *result = NULL;
+    vitte_status_t status;
+    unsigned long long started = vitte_cli_now_ns();
+    char *output_path;
+
+    memset(&text, 0, sizeof(text));
+    vitte_error_reset(&worker->error);
+    if (!vitte_cli_batch_prepare_worker(batch, worker)) {
+        item->exit_code = vitte_cli_exit_from_status(worker->error.status);
+        vitte_cli_batch_format(&text, item, NULL, &worker->error, NULL, worker->error.status, NULL, 0ull);
+    } else {
+        output_path = vitte_cli_batch_output_path(batch->options, item->input_path);
+        vitte_driver_input_init(&input);
+        vitte_driver_result_init(worker->result);
+        status = vitte_driver_input_from_file(&input, item->input_path, 0u);
+        if (status != VITTE_STATUS_OK) {
+            vitte_error_set_details(&worker->error, status, "VITTE_CLI_E_INPUT", "cannot open input", strerror(errno));
+            item->exit_code = VITTE_CLI_EXIT_ERROR;
+            vitte_cli_batch_format(&text, item, NULL, &worker->error, NULL, status, NULL, vitte_cli_now_ns() - started);
+        } else {
+            if (command == VITTE_CLI_COMMAND_CHECK) {
+                status = vitte_driver_check(worker->driver, &input, worker->result);
+            } else if (command == VITTE_CLI_COMMAND_EMIT_C) {
+                status = vitte_driver_emit_c(worker->driver, &input, output_path, worker->result);
+            } else {
+                status = vitte_driver_build(worker->driver, &input, output_path, worker->result);
+            }
+            result = worker->result;
+            item->exit_code = status == VITTE_STATUS_OK ? VITTE_CLI_EXIT_OK : vitte_cli_exit_from_status(status);
+            vitte_cli_batch_format(
+                &text,
+                item,
+                vitte_driver_diagnostics(worker->driver),
+                vitte_driver_last_error(worker->driver),
+                worker->result,
+                status,
+                output_path,
+                vitte_cli_now_ns() - started
+            );
+        }
+        vitte_driver_input_destroy(&input);
+        free(output_path);
+    }
+    if (text.failed) {
+        free(text.data);
+        text.data = NULL;
+    }
+    vitte_cli_batch_finish(batch, item, text.data, result);
+    return true;
+}
+
+/*
+ * Runs every input through one driver per worker. All workers share the
+ * context (and so the interner) and one module cache with a resident tier, so
+ * a module imported by many inputs is parsed once and decoded from memory
+ * afterwards. Exits with the worst per-input exit code.
+ */
+static int vitte_cli_run_batch(const vitte_cli_options_t *options) {
+    vitte_api_config_t config;
+    vitte_context_t context;
+    vitte_cache_t cache;
+    vitte_cli_batch_t batch;
+    vitte_cli_profile_t profile;
+    const char **paths;
+    char *manifest = NULL;
+    size_t path_count = options->batch_input_count;
+    size_t jobs = options->jobs != 0u ? options->jobs : 1u;
+    size_t failed = 0u;
+    size_t index;
+    unsigned long long started = vitte_cli_now_ns();
+    int exit_code = VITTE_CLI_EXIT_OK;
+
+    paths = (const char **)malloc((path_count != 0u ? path_count : 1u) * sizeof(*paths));
+    if (paths == NULL) {
+        fputs("vitte-bootstrap: out of memory preparing batch\n", stderr);
+        return VITTE_CLI_EXIT_INTERNAL;
+    }
+    memcpy((void *)paths, options->batch_inputs, path_count * sizeof(*paths));
+    if (options->manifest_path != NULL && !vitte_cli_read_manifest(options->manifest_path, &manifest, &paths, &path_count)) {
+        free((void *)paths);
+        free(manifest);
+        return VITTE_CLI_EXIT_ERROR;
+    }
+
+    if (!vitte_cli_profile_init(&profile, options)) {
+        free((void *)paths);
+        free(manifest);
+        return VITTE_CLI_EXIT_INTERNAL;
+    }
+    memset(&batch, 0, sizeof(batch));
+    batch.options = options;
+    batch.profile = &profile;
+    batch.context = &context;
+    batch.cache = &cache;
+    batch.count = path_count;
+    if (jobs > path_count) {
+        jobs = path_count != 0u ? path_count : 1u;
+    }
+    batch.items = (vitte_cli_batch_item_t *)calloc(path_count != 0u ? path_count : 1u, sizeof(*batch.items));
+    batch.workers = (vitte_cli_batch_worker_t *)calloc(jobs, sizeof(*batch.workers));
+    vitte_api_config_init(&config);
+    if (batch.items == NULL || batch.workers == NULL || vitte_context_init(&context, &config) != VITTE_STATUS_OK) {
+        fputs("vitte-bootstrap: out of memory preparing batch\n", stderr);
+        vitte_trace_destroy(&profile.trace);
+        free(batch.items);
+        free(batch.workers);
+        free((void *)paths);
+        free(manifest);
+        return VITTE_CLI_EXIT_INTERNAL;
+    }
+    if (vitte_cache_init(&cache, options->cache_dir) != VITTE_STATUS_OK ||
+        vitte_cache_enable_resident(&cache, 0u) != VITTE_STATUS_OK ||
+        vitte_parallel_mutex_init(&batch.output_lock) != VITTE_STATUS_OK ||
+        (jobs > 1u && vitte_interner_enable_locking(vitte_context_interner(&context)) != VITTE_STATUS_OK)) {
+        fputs("vitte-bootstrap: cannot prepare batch\n", stderr);
+        exit_code = VITTE_CLI_EXIT_INTERNAL;
+    } else {
+        vitte_cache_set_object_limit(&cache, options->cache_max_mb << 20);
+        for (index = 0u; index < path_count; index++) {
+            batch.items[index].input_path = paths[index];
+        }
+        (void)vitte_parallel_for(path_count, jobs, vitte_cli_batch_task, &batch, NULL);
+        for (index = 0u; index < path_count; index++) {
+            if (batch.items[index].exit_code != VITTE_CLI_EXIT_OK) {
+                failed++;
+            }
+            if (batch.items[index].exit_code > exit_code) {
+                exit_code = batch.items[index].exit_code;
+            }
+        }
+        fprintf(
+            stderr,
+            "[vitte-bootstrap] batch: %zu inputs, %zu failed, %zu jobs, %llu ms\n",
+            path_count,
+            failed,
+            jobs,
+            (vitte_cli_now_ns() - started) / 1000000ull
+        );
+        if (options->cache_stats) {
+            vitte_cache_stats_t stats;
+
+            vitte_cache_stats(&cache, &stats);
+            fprintf(
+                stderr,
+                "[vitte-bootstrap] cache: %zu loaded (%zu from memory), %zu parsed\n",
+                stats.hit_count,
+                stats.resident_hit_count,
+                stats.miss_count + stats.reject_count
+            );
+        }
+    }
+    profile.wall_ns = vitte_cli_now_ns() - started;
+    if (options->mem_stats) {
+        /* Module rows belong to individual runs; a batch reports its subsystems. */
+        vitte_cli_print_mem_stats(&context, NULL, 0u);
+    }
+    exit_code = vitte_cli_profile_finish(&profile, options, exit_code);
+
+    for (index = 0u; index < jobs; index++) {
+        if (batch.workers[index].driver != NULL) {
+            vitte_driver_shutdown(batch.workers[index].driver);
+            free(batch.workers[index].driver);
+            free(batch.workers[index].result);
+        }
+    }
+    vitte_parallel_mutex_destroy(&batch.output_lock);
+    vitte_cache_destroy(&cache);
+    vitte_context_destroy(&context);
+    free(batch.items);
+    free(batch.workers);
+    free((void *)paths);
+    free(manifest);
+    return exit_code;
+}
+
 int vitte_cli_run(const vitte_cli_options_t *options) {
     if (options == NULL) {
         return VITTE_CLI_EXIT_USAGE;
@@ -425,13 +1923,21 @@ int vitte_cli_run(const vitte_cli_options_t *options) {
             vitte_cli_print_version(stdout);
             return VITTE_CLI_EXIT_OK;
         case VITTE_CLI_COMMAND_CHECK:
-            return vitte_cli_run_driver_command(options, VITTE_DRIVER_EMIT_CHECK, false);
+            return vitte_cli_run_driver_command(options, VITTE_DRIVER_EMIT_CHECK, false, NULL);
         case VITTE_CLI_COMMAND_EMIT_C:
-            return vitte_cli_run_driver_command(options, VITTE_DRIVER_EMIT_C, false);
+            return vitte_cli_run_driver_command(options, VITTE_DRIVER_EMIT_C, false, NULL);
         case VITTE_CLI_COMMAND_BUILD:
-            return vitte_cli_run_driver_command(options, VITTE_DRIVER_EMIT_BINARY, false);
+            return vitte_cli_run_driver_command(options, VITTE_DRIVER_EMIT_BINARY, false, NULL);
         case VITTE_CLI_COMMAND_RUN:
-            return vitte_cli_run_driver_command(options, VITTE_DRIVER_EMIT_BINARY, true);
+            return vitte_cli_run_driver_command(options, VITTE_DRIVER_EMIT_BINARY, true, NULL);
+        case VITTE_CLI_COMMAND_LEX_BENCH:
+            return vitte_cli_run_lex_bench(options);
+        case VITTE_CLI_COMMAND_ARENA_BENCH:
+            return vitte_cli_run_arena_bench(options);
+        case VITTE_CLI_COMMAND_SERVE:
+            return vitte_cli_run_serve(options);
+        case VITTE_CLI_COMMAND_BATCH:
+            return vitte_cli_run_batch(options);
         default:
             fprintf(stderr, "vitte-bootstrap: unknown command: %s\n", options->command_name);
             return VITTE_CLI_EXIT_USAGE;
@@ -445,5 +1951,25 @@ int vitte_cli_main(int argc, char **argv) {
         vitte_cli_print_help(stderr);
         return VITTE_CLI_EXIT_USAGE;
     }
+    if (vitte_cli_command_is_forwarded(options.command) && !options.no_server && getenv("VITTE_NO_SERVER") == NULL) {
+        char socket_path[VITTE_SERVER_MAX_SOCKET_PATH];
+        const char *path = options.socket_path;
+        int exit_code;
+
+        if (path == NULL && vitte_server_default_socket_path(socket_path, sizeof(socket_path))) {
+            path = socket_path;
+        }
+        if (path != NULL &&
+            vitte_server_forward(
+                path,
+                argc - 1,
+                argv + 1,
+                vitte_cli_forwarded_env,
+                sizeof(vitte_cli_forwarded_env) / sizeof(vitte_cli_forwarded_env[0]),
+                &exit_code
+            )) {
+            return exit_code;
+        }
+    }
     return vitte_cli_run(&options);
 }
@@ -2,6 +2,7 @@
 #define VITTE_BOOTSTRAP_CLI_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 
 #ifdef __cplusplus
@@ -9,6 +10,11 @@ extern "C" {
 #endif
 
 #define VITTE_CLI_VERSION_TEXT "vitte-bootstrap c17 0.1.0"
+#define VITTE_CLI_DEFAULT_LEX_BENCH_REPEAT ((size_t)20u)
+/* Objects allocated per arena-bench iteration. */
+#define VITTE_CLI_ARENA_BENCH_OBJECTS ((size_t)1u << 16)
+/* Inputs named on a `batch` command line; longer lists go through --manifest. */
+#define VITTE_CLI_MAX_BATCH_INPUTS ((size_t)1024u)
 
 typedef enum vitte_cli_exit_code {
     VITTE_CLI_EXIT_OK = 0,
@@ -23,7 +29,11 @@ typedef enum vitte_cli_command {
     VITTE_CLI_COMMAND_CHECK,
     VITTE_CLI_COMMAND_EMIT_C,
     VITTE_CLI_COMMAND_BUILD,
-    VITTE_CLI_COMMAND_RUN
+    VITTE_CLI_COMMAND_RUN,
+    VITTE_CLI_COMMAND_LEX_BENCH,
+    VITTE_CLI_COMMAND_ARENA_BENCH,
+    VITTE_CLI_COMMAND_SERVE,
+    VITTE_CLI_COMMAND_BATCH
 } vitte_cli_command_t;
 
 typedef struct vitte_cli_options {
@@ -32,7 +42,26 @@ typedef struct vitte_cli_options {
     const char *input_path;
     const char *output_path;
     const char *c_compiler;
+    const char *cache_dir;
+    const char *socket_path;
+    const char *manifest_path;
+    /* What `batch` does with each input: check, emit-c or build. */
+    vitte_cli_command_t batch_command;
+    const char *batch_inputs[VITTE_CLI_MAX_BATCH_INPUTS];
+    size_t batch_input_count;
+    /* Chrome trace-event JSON written after the run; NULL for none. */
+    const char *trace_path;
+    bool time_passes;
+    bool mem_stats;
     bool keep_intermediate_c;
+    bool c_warnings;
+    bool cache_stats;
+    bool separate_compilation;
+    bool huge_pages;
+    bool no_server;
+    size_t repeat;
+    size_t jobs;
+    size_t cache_max_mb;
 } vitte_cli_options_t;
 
 void vitte_cli_options_init(vitte_cli_options_t *options);
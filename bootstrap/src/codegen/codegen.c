@@ -40,7 +40,9 @@ static bool vitte_codegen_input_kind_is_valid(vitte_codegen_input_kind_t kind) {
 
 static bool vitte_codegen_output_kind_is_valid(vitte_codegen_output_kind_t kind) {
     return kind == VITTE_CODEGEN_OUTPUT_BUFFER ||
-        kind == VITTE_CODEGEN_OUTPUT_FILE;
+        kind == VITTE_CODEGEN_OUTPUT_FILE ||
+        kind == VITTE_CODEGEN_OUTPUT_DIRECTORY ||
+        kind == VITTE_CODEGEN_OUTPUT_STREAM;
 }
 
 vitte_status_t vitte_codegen_options_validate(const vitte_codegen_options_t *options, vitte_error_t *error) {
@@ -69,11 +71,15 @@ vitte_status_t vitte_codegen_options_validate(const vitte_codegen_options_t *opt
         vitte_error_set_details(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_CODEGEN_E_OUTPUT", "missing codegen output buffer", NULL);
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
-    if (options->output_kind == VITTE_CODEGEN_OUTPUT_FILE &&
+    if ((options->output_kind == VITTE_CODEGEN_OUTPUT_FILE || options->output_kind == VITTE_CODEGEN_OUTPUT_DIRECTORY) &&
         (options->output_path == NULL || options->output_path[0] == '\0')) {
         vitte_error_set_details(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_CODEGEN_E_OUTPUT", "missing codegen output path", NULL);
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
+    if (options->output_kind == VITTE_CODEGEN_OUTPUT_STREAM && options->output_stream == NULL) {
+        vitte_error_set_details(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_CODEGEN_E_OUTPUT", "missing codegen output stream", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
 
     if (error != NULL) {
         vitte_error_reset(error);
@@ -165,6 +171,10 @@ const char *vitte_codegen_output_kind_name(vitte_codegen_output_kind_t kind) {
             return "buffer";
         case VITTE_CODEGEN_OUTPUT_FILE:
             return "file";
+        case VITTE_CODEGEN_OUTPUT_DIRECTORY:
+            return "directory";
+        case VITTE_CODEGEN_OUTPUT_STREAM:
+            return "stream";
         default:
             return "unknown";
     }
@@ -208,8 +218,9 @@ static void vitte_codegen_copy_c17_result(
     result->output_kind = options->output_kind;
     result->bytes_written = c17_result != NULL ? c17_result->bytes_written : 0u;
     result->lines_written = c17_result != NULL ? c17_result->lines_written : 0u;
-    result->units_emitted = 1u;
+    result->units_emitted = c17_result != NULL && c17_result->units_emitted != 0u ? c17_result->units_emitted : 1u;
     result->functions_emitted = c17_result != NULL ? c17_result->functions_emitted : 0u;
+    result->files_written = c17_result != NULL ? c17_result->files_written : 0u;
     result->output_path = options->output_path;
     result->error_count = result->status == VITTE_STATUS_OK ? 0u : 1u;
 }
@@ -220,7 +231,9 @@ static vitte_status_t vitte_codegen_emit_ir_c17(
     char *buffer,
     size_t buffer_capacity,
     const char *output_path,
+    FILE *stream,
     vitte_codegen_output_kind_t output_kind,
+    vitte_codegen_unit_list_t *units,
     vitte_codegen_result_t *result
 ) {
     vitte_c17_options_t c17_options;
@@ -246,6 +259,7 @@ static vitte_status_t vitte_codegen_emit_ir_c17(
     effective_options.buffer = buffer;
     effective_options.buffer_capacity = buffer_capacity;
     effective_options.output_path = output_path;
+    effective_options.output_stream = stream;
     status = vitte_codegen_options_validate(&effective_options, &codegen->last_error);
     if (status != VITTE_STATUS_OK) {
         if (result != NULL) {
@@ -272,6 +286,10 @@ static vitte_status_t vitte_codegen_emit_ir_c17(
 
     if (output_kind == VITTE_CODEGEN_OUTPUT_BUFFER) {
         status = vitte_c17_backend_emit_ir_to_buffer(&backend, ir, buffer, buffer_capacity, &c17_result);
+    } else if (output_kind == VITTE_CODEGEN_OUTPUT_DIRECTORY) {
+        status = vitte_c17_backend_emit_ir_to_directory(&backend, ir, output_path, units, &c17_result);
+    } else if (output_kind == VITTE_CODEGEN_OUTPUT_STREAM) {
+        status = vitte_c17_backend_emit_ir_to_stream(&backend, ir, stream, &c17_result);
     } else {
         status = vitte_c17_backend_emit_ir_to_file(&backend, ir, output_path, &c17_result);
     }
@@ -303,7 +321,7 @@ vitte_status_t vitte_codegen_emit_ir_to_buffer(
         vitte_codegen_set_error(codegen, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_CODEGEN_E_STATE", "codegen is not initialized", NULL);
         return VITTE_STATUS_ERROR_INVALID_STATE;
     }
-    return vitte_codegen_emit_ir_c17(codegen, ir, buffer, buffer_capacity, NULL, VITTE_CODEGEN_OUTPUT_BUFFER, result);
+    return vitte_codegen_emit_ir_c17(codegen, ir, buffer, buffer_capacity, NULL, NULL, VITTE_CODEGEN_OUTPUT_BUFFER, NULL, result);
 }
 
 vitte_status_t vitte_codegen_emit_ir_to_file(
@@ -322,7 +340,56 @@ vitte_status_t vitte_codegen_emit_ir_to_file(
         vitte_codegen_set_error(codegen, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_CODEGEN_E_STATE", "codegen is not initialized", NULL);
         return VITTE_STATUS_ERROR_INVALID_STATE;
     }
-    return vitte_codegen_emit_ir_c17(codegen, ir, NULL, 0u, output_path, VITTE_CODEGEN_OUTPUT_FILE, result);
+    return vitte_codegen_emit_ir_c17(codegen, ir, NULL, 0u, output_path, NULL, VITTE_CODEGEN_OUTPUT_FILE, NULL, result);
+}
+
+vitte_status_t vitte_codegen_emit_ir_to_stream(
+    vitte_codegen_t *codegen,
+    const vitte_ir_t *ir,
+    FILE *stream,
+    vitte_codegen_result_t *result
+) {
+    if (!vitte_codegen_is_initialized(codegen)) {
+        if (result != NULL) {
+            vitte_codegen_result_init(result);
+            result->status = VITTE_STATUS_ERROR_INVALID_STATE;
+            result->input_kind = VITTE_CODEGEN_INPUT_IR;
+            result->error_count = 1u;
+        }
+        vitte_codegen_set_error(codegen, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_CODEGEN_E_STATE", "codegen is not initialized", NULL);
+        return VITTE_STATUS_ERROR_INVALID_STATE;
+    }
+    return vitte_codegen_emit_ir_c17(codegen, ir, NULL, 0u, NULL, stream, VITTE_CODEGEN_OUTPUT_STREAM, NULL, result);
+}
+
+vitte_status_t vitte_codegen_emit_ir_to_directory(
+    vitte_codegen_t *codegen,
+    const vitte_ir_t *ir,
+    const char *directory,
+    vitte_codegen_unit_list_t *units,
+    vitte_codegen_result_t *result
+) {
+    if (!vitte_codegen_is_initialized(codegen)) {
+        if (result != NULL) {
+            vitte_codegen_result_init(result);
+            result->status = VITTE_STATUS_ERROR_INVALID_STATE;
+            result->input_kind = VITTE_CODEGEN_INPUT_IR;
+            result->error_count = 1u;
+        }
+        vitte_codegen_set_error(codegen, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_CODEGEN_E_STATE", "codegen is not initialized", NULL);
+        return VITTE_STATUS_ERROR_INVALID_STATE;
+    }
+    if (units == NULL) {
+        if (result != NULL) {
+            vitte_codegen_result_init(result);
+            result->status = VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+            result->output_kind = VITTE_CODEGEN_OUTPUT_DIRECTORY;
+            result->error_count = 1u;
+        }
+        vitte_codegen_set_error(codegen, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_CODEGEN_E_OUTPUT", "missing codegen unit list", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    return vitte_codegen_emit_ir_c17(codegen, ir, NULL, 0u, directory, NULL, VITTE_CODEGEN_OUTPUT_DIRECTORY, units, result);
 }
 
 vitte_status_t vitte_codegen_emit(
@@ -359,6 +426,13 @@ vitte_status_t vitte_codegen_emit(
             result
         );
     }
+    if (codegen->options.output_kind == VITTE_CODEGEN_OUTPUT_STREAM) {
+        return vitte_codegen_emit_ir_to_stream(codegen, (const vitte_ir_t *)input, codegen->options.output_stream, result);
+    }
+    if (codegen->options.output_kind == VITTE_CODEGEN_OUTPUT_DIRECTORY) {
+        /* Directory output hands back a unit list, which only the typed helper can return. */
+        return vitte_codegen_emit_ir_to_directory(codegen, (const vitte_ir_t *)input, codegen->options.output_path, NULL, result);
+    }
     return vitte_codegen_emit_ir_to_file(
         codegen,
         (const vitte_ir_t *)input,
@@ -3,8 +3,10 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdio.h>
 
 #include "../api/error.h"
+#include "../backend/c17/units.h"
 #include "../ir/ir.h"
 
 #ifdef __cplusplus
@@ -21,15 +23,21 @@ typedef enum vitte_codegen_input_kind {
 
 typedef enum vitte_codegen_output_kind {
     VITTE_CODEGEN_OUTPUT_BUFFER = 0,
-    VITTE_CODEGEN_OUTPUT_FILE
+    VITTE_CODEGEN_OUTPUT_FILE,
+    VITTE_CODEGEN_OUTPUT_DIRECTORY,
+    VITTE_CODEGEN_OUTPUT_STREAM
 } vitte_codegen_output_kind_t;
 
+/* Translation units written by a directory emission, root first. */
+typedef vitte_c17_unit_list_t vitte_codegen_unit_list_t;
+
 typedef struct vitte_codegen_options {
     vitte_codegen_backend_t backend;
     vitte_codegen_input_kind_t input_kind;
     vitte_codegen_output_kind_t output_kind;
     const char *source_name;
     const char *output_path;
+    FILE *output_stream;
     char *buffer;
     size_t buffer_capacity;
     size_t indent_width;
@@ -46,6 +54,7 @@ typedef struct vitte_codegen_result {
     size_t lines_written;
     size_t units_emitted;
     size_t functions_emitted;
+    size_t files_written;
     const char *output_path;
     size_t error_count;
 } vitte_codegen_result_t;
@@ -85,6 +94,27 @@ vitte_status_t vitte_codegen_emit_ir_to_file(
     vitte_codegen_result_t *result
 );
 
+/* Emits C17 into an open stream (for instance the stdin of the C compiler), which the caller closes. */
+vitte_status_t vitte_codegen_emit_ir_to_stream(
+    vitte_codegen_t *codegen,
+    const vitte_ir_t *ir,
+    FILE *stream,
+    vitte_codegen_result_t *result
+);
+
+/*
+ * Emits one C translation unit per Vitte module into the existing
+ * `directory`; files whose content is unchanged are not rewritten.
+ * `files_written` in the result counts the others.
+ */
+vitte_status_t vitte_codegen_emit_ir_to_directory(
+    vitte_codegen_t *codegen,
+    const vitte_ir_t *ir,
+    const char *directory,
+    vitte_codegen_unit_list_t *units,
+    vitte_codegen_result_t *result
+);
+
 vitte_status_t vitte_codegen_emit(
     vitte_codegen_t *codegen,
     const void *input,
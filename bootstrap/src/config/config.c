@@ -55,6 +55,7 @@ void vitte_config_init(vitte_config_t *config) {
     config->limits.max_diagnostics = VITTE_CONFIG_DEFAULT_MAX_DIAGNOSTICS;
     config->limits.max_include_depth = VITTE_CONFIG_DEFAULT_MAX_INCLUDE_DEPTH;
     config->limits.max_path_length = VITTE_CONFIG_DEFAULT_MAX_PATH_LENGTH;
+    config->limits.jobs = VITTE_CONFIG_DEFAULT_JOBS;
     vitte_error_init(&config->last_error);
 }
 
@@ -132,7 +133,8 @@ vitte_status_t vitte_config_validate(vitte_config_t *config) {
         config->limits.max_ast_depth == 0u ||
         config->limits.max_diagnostics == 0u ||
         config->limits.max_include_depth == 0u ||
-        config->limits.max_path_length == 0u) {
+        config->limits.max_path_length == 0u ||
+        config->limits.jobs == 0u) {
         vitte_config_set_error(config, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_CONFIG_E_LIMIT", "config limits must be non-zero", NULL);
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
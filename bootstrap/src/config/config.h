@@ -17,6 +17,7 @@ extern "C" {
 #define VITTE_CONFIG_DEFAULT_MAX_DIAGNOSTICS ((size_t)100u)
 #define VITTE_CONFIG_DEFAULT_MAX_INCLUDE_DEPTH ((size_t)64u)
 #define VITTE_CONFIG_DEFAULT_MAX_PATH_LENGTH ((size_t)4096u)
+#define VITTE_CONFIG_DEFAULT_JOBS ((size_t)1u)
 
 typedef enum vitte_config_target {
     VITTE_CONFIG_TARGET_HOST = 0,
@@ -57,6 +58,7 @@ typedef struct vitte_config_codegen {
     bool emit_includes;
     bool emit_debug_comments;
     bool keep_intermediate_c;
+    bool separate_units;
 } vitte_config_codegen_t;
 
 typedef struct vitte_config_limits {
@@ -65,6 +67,8 @@ typedef struct vitte_config_limits {
     size_t max_diagnostics;
     size_t max_include_depth;
     size_t max_path_length;
+    size_t max_cache_bytes;
+    size_t jobs;
 } vitte_config_limits_t;
 
 typedef struct vitte_config {
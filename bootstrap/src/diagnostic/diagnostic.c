@@ -1,9 +1,12 @@
 #include "diagnostic.h"
 
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
+#include "../util/util.h"
+
 static const size_t VITTE_DIAGNOSTIC_DEFAULT_MAX = 100u;
 
 static void vitte_diagnostic_set_error(
@@ -75,46 +78,71 @@ const char *vitte_diagnostic_severity_name(vitte_diagnostic_severity_t severity)
 
 vitte_status_t vitte_diagnostic_bag_init(
     vitte_diagnostic_bag_t *bag,
-    vitte_diagnostic_t *storage,
-    size_t capacity,
+    const vitte_allocator_t *allocator,
     const vitte_diagnostic_options_t *options
 ) {
     vitte_diagnostic_options_t defaults;
+    vitte_arena_config_t text_config;
+    vitte_status_t status;
 
-    if (bag == NULL || storage == NULL || capacity == 0u) {
+    if (bag == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
 
     memset(bag, 0, sizeof(*bag));
-    bag->storage = storage;
-    bag->capacity = capacity;
+    if (allocator != NULL && vitte_allocator_is_valid(allocator)) {
+        bag->allocator = *allocator;
+    } else {
+        vitte_allocator_default(&bag->allocator);
+    }
     bag->options = options != NULL ? *options : (vitte_diagnostic_options_init(&defaults), defaults);
     if (bag->options.max_diagnostics == 0u) {
         bag->options.max_diagnostics = VITTE_DIAGNOSTIC_DEFAULT_MAX;
     }
+    vitte_arena_config_init(&text_config);
+    text_config.allocator = bag->allocator;
+    text_config.initial_block_size = 1024u;
+    status = vitte_arena_init(&bag->text, &text_config);
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
     vitte_error_init(&bag->last_error);
     bag->initialized = true;
-    vitte_diagnostic_bag_reset(bag);
+    vitte_diagnostic_counts_init(&bag->counts);
     return VITTE_STATUS_OK;
 }
 
-void vitte_diagnostic_bag_reset(vitte_diagnostic_bag_t *bag) {
-    size_t index;
-
-    if (bag == NULL || bag->storage == NULL) {
+void vitte_diagnostic_bag_destroy(vitte_diagnostic_bag_t *bag) {
+    if (bag == NULL || !bag->initialized) {
         return;
     }
 
-    for (index = 0u; index < bag->capacity; index++) {
-        vitte_diagnostic_init(&bag->storage[index]);
+    if (bag->storage != NULL) {
+        bag->allocator.free(bag->allocator.user, bag->storage);
+    }
+    if (bag->seen != NULL) {
+        bag->allocator.free(bag->allocator.user, bag->seen);
+    }
+    vitte_arena_destroy(&bag->text);
+    memset(bag, 0, sizeof(*bag));
+}
+
+void vitte_diagnostic_bag_reset(vitte_diagnostic_bag_t *bag) {
+    if (!vitte_diagnostic_bag_is_initialized(bag)) {
+        return;
     }
+
     bag->count = 0u;
+    if (bag->seen != NULL) {
+        memset(bag->seen, 0, bag->seen_capacity * sizeof(*bag->seen));
+    }
+    vitte_arena_reset(&bag->text);
     vitte_diagnostic_counts_init(&bag->counts);
     vitte_error_reset(&bag->last_error);
 }
 
 bool vitte_diagnostic_bag_is_initialized(const vitte_diagnostic_bag_t *bag) {
-    return bag != NULL && bag->initialized && bag->storage != NULL && bag->capacity > 0u;
+    return bag != NULL && bag->initialized;
 }
 
 const vitte_error_t *vitte_diagnostic_bag_last_error(const vitte_diagnostic_bag_t *bag) {
@@ -176,44 +204,142 @@ static bool vitte_diagnostic_text_is_valid(const char *text) {
     return text != NULL && text[0] != '\0';
 }
 
-static void vitte_diagnostic_copy_source_name(
-    vitte_diagnostic_t *diagnostic,
-    const char *source_name
-) {
+static const char *vitte_diagnostic_copy_text(vitte_diagnostic_bag_t *bag, const char *text) {
     size_t length;
+    char *copy;
 
-    if (diagnostic == NULL) {
-        return;
+    if (text == NULL) {
+        return NULL;
     }
-    diagnostic->source_name = NULL;
-    diagnostic->source_name_storage[0] = '\0';
+    length = strlen(text);
+    copy = (char *)vitte_arena_alloc(&bag->text, length + 1u, 1u);
+    if (copy != NULL) {
+        memcpy(copy, text, length + 1u);
+    }
+    return copy;
+}
+
+/* Most diagnostics in a row name the same file, so the last entry's copy is reused. */
+static const char *vitte_diagnostic_source_name(vitte_diagnostic_bag_t *bag, const char *source_name) {
     if (!vitte_diagnostic_text_is_valid(source_name)) {
-        return;
+        return NULL;
     }
-    length = strlen(source_name);
-    if (length >= sizeof(diagnostic->source_name_storage)) {
-        length = sizeof(diagnostic->source_name_storage) - 1u;
+    if (vitte_interner_is_initialized(bag->options.interner)) {
+        return vitte_interner_intern_cstr(bag->options.interner, source_name);
     }
-    if (length > 0u) {
-        (void)memcpy(diagnostic->source_name_storage, source_name, length);
+    if (bag->count > 0u && bag->storage[bag->count - 1u].source_name != NULL &&
+        strcmp(bag->storage[bag->count - 1u].source_name, source_name) == 0) {
+        return bag->storage[bag->count - 1u].source_name;
     }
-    diagnostic->source_name_storage[length] = '\0';
-    diagnostic->source_name = diagnostic->source_name_storage;
+    return vitte_diagnostic_copy_text(bag, source_name);
 }
 
-static void vitte_diagnostic_copy_span(vitte_diagnostic_t *diagnostic, const vitte_ast_span_t *span) {
-    if (diagnostic == NULL || span == NULL || !vitte_ast_span_is_valid(span)) {
-        return;
+static uint64_t vitte_diagnostic_hash_text(uint64_t hash, const char *text) {
+    hash = vitte_util_hash_text(hash, text != NULL ? text : "");
+    /* Terminator, so ("ab", "c") and ("a", "bc") differ. */
+    return vitte_util_hash_value(hash, 0xffu);
+}
+
+static size_t vitte_diagnostic_hash(const char *code, const vitte_ast_span_t *span) {
+    uint64_t hash = VITTE_UTIL_HASH_SEED;
+
+    hash = vitte_diagnostic_hash_text(hash, code);
+    hash = vitte_diagnostic_hash_text(hash, span->source_name);
+    hash = vitte_util_hash_value(hash, (uint64_t)span->start_offset);
+    hash = vitte_util_hash_value(hash, (uint64_t)span->end_offset);
+    hash = vitte_util_hash_value(hash, ((uint64_t)span->start_line << 32) | span->start_column);
+    hash = vitte_util_hash_value(hash, ((uint64_t)span->end_line << 32) | span->end_column);
+    return (size_t)(hash ^ (hash >> 32));
+}
+
+static bool vitte_diagnostic_same_text(const char *left, const char *right) {
+    if (left == right) {
+        return true;
+    }
+    return strcmp(left != NULL ? left : "", right != NULL ? right : "") == 0;
+}
+
+static bool vitte_diagnostic_matches(
+    const vitte_diagnostic_t *diagnostic,
+    const char *code,
+    const vitte_ast_span_t *span
+) {
+    return diagnostic->has_span &&
+        diagnostic->start_offset == span->start_offset &&
+        diagnostic->end_offset == span->end_offset &&
+        diagnostic->start_line == span->start_line &&
+        diagnostic->start_column == span->start_column &&
+        diagnostic->end_line == span->end_line &&
+        diagnostic->end_column == span->end_column &&
+        vitte_diagnostic_same_text(diagnostic->code, code) &&
+        vitte_diagnostic_same_text(diagnostic->source_name, vitte_diagnostic_text_is_valid(span->source_name) ? span->source_name : NULL);
+}
+
+/* The slot holding an entry equal to (code, span), or the empty slot where it would go. */
+static size_t *vitte_diagnostic_seen_slot(vitte_diagnostic_bag_t *bag, const char *code, const vitte_ast_span_t *span) {
+    size_t mask = bag->seen_capacity - 1u;
+    size_t position = vitte_diagnostic_hash(code, span) & mask;
+
+    while (bag->seen[position] != 0u && !vitte_diagnostic_matches(&bag->storage[bag->seen[position] - 1u], code, span)) {
+        position = (position + 1u) & mask;
     }
+    return &bag->seen[position];
+}
 
-    vitte_diagnostic_copy_source_name(diagnostic, span->source_name);
-    diagnostic->start_offset = span->start_offset;
-    diagnostic->end_offset = span->end_offset;
-    diagnostic->start_line = span->start_line;
-    diagnostic->start_column = span->start_column;
-    diagnostic->end_line = span->end_line;
-    diagnostic->end_column = span->end_column;
-    diagnostic->has_span = true;
+static void vitte_diagnostic_entry_span(const vitte_diagnostic_t *diagnostic, vitte_ast_span_t *span) {
+    vitte_ast_span_init(span);
+    span->source_name = diagnostic->source_name;
+    span->start_offset = diagnostic->start_offset;
+    span->end_offset = diagnostic->end_offset;
+    span->start_line = diagnostic->start_line;
+    span->start_column = diagnostic->start_column;
+    span->end_line = diagnostic->end_line;
+    span->end_column = diagnostic->end_column;
+    span->valid = true;
+}
+
+/* Makes room for one more entry in the storage array and the hash, which stays at most half full. */
+static vitte_status_t vitte_diagnostic_grow(vitte_diagnostic_bag_t *bag) {
+    size_t index;
+
+    if (bag->count == bag->capacity) {
+        size_t capacity = bag->capacity != 0u ? bag->capacity * 2u : VITTE_DIAGNOSTIC_INITIAL_CAPACITY;
+        vitte_diagnostic_t *storage;
+
+        if (capacity > bag->options.max_diagnostics) {
+            capacity = bag->options.max_diagnostics;
+        }
+        storage = (vitte_diagnostic_t *)bag->allocator.realloc(bag->allocator.user, bag->storage, capacity * sizeof(*storage));
+        if (storage == NULL) {
+            return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        }
+        bag->storage = storage;
+        bag->capacity = capacity;
+    }
+    if ((bag->count + 1u) * 2u > bag->seen_capacity) {
+        size_t capacity = bag->seen_capacity != 0u ? bag->seen_capacity * 2u : VITTE_DIAGNOSTIC_INITIAL_CAPACITY * 2u;
+        size_t *seen = (size_t *)bag->allocator.alloc(bag->allocator.user, capacity * sizeof(*seen));
+
+        if (seen == NULL) {
+            return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        }
+        memset(seen, 0, capacity * sizeof(*seen));
+        if (bag->seen != NULL) {
+            bag->allocator.free(bag->allocator.user, bag->seen);
+        }
+        bag->seen = seen;
+        bag->seen_capacity = capacity;
+        for (index = 0u; index < bag->count; index++) {
+            vitte_ast_span_t span;
+
+            if (!bag->storage[index].has_span) {
+                continue;
+            }
+            vitte_diagnostic_entry_span(&bag->storage[index], &span);
+            *vitte_diagnostic_seen_slot(bag, bag->storage[index].code, &span) = index + 1u;
+        }
+    }
+    return VITTE_STATUS_OK;
 }
 
 vitte_status_t vitte_diagnostic_add(
@@ -225,6 +351,8 @@ vitte_status_t vitte_diagnostic_add(
     const vitte_ast_span_t *span
 ) {
     vitte_diagnostic_t *diagnostic;
+    size_t *seen = NULL;
+    vitte_status_t status;
 
     if (!vitte_diagnostic_bag_is_initialized(bag)) {
         vitte_diagnostic_set_error(bag, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_DIAG_E_STATE", "diagnostic bag is not initialized", NULL);
@@ -239,19 +367,50 @@ vitte_status_t vitte_diagnostic_add(
     if (severity == VITTE_DIAGNOSTIC_WARNING && bag->options.warnings_as_errors) {
         severity = VITTE_DIAGNOSTIC_ERROR;
     }
-    if (bag->count >= bag->capacity || bag->count >= bag->options.max_diagnostics) {
+    if (span != NULL && !vitte_ast_span_is_valid(span)) {
+        span = NULL;
+    }
+    if (span != NULL && bag->seen != NULL && *vitte_diagnostic_seen_slot(bag, code, span) != 0u) {
+        bag->counts.duplicate_count++;
+        return VITTE_STATUS_OK;
+    }
+    if (bag->count >= bag->options.max_diagnostics) {
         bag->counts.suppressed_count++;
         vitte_diagnostic_set_error(bag, VITTE_STATUS_ERROR_UNSUPPORTED, "VITTE_DIAG_E_LIMIT", "diagnostic limit reached", code);
         return VITTE_STATUS_ERROR_UNSUPPORTED;
     }
+    status = vitte_diagnostic_grow(bag);
+    if (status != VITTE_STATUS_OK) {
+        vitte_diagnostic_set_error(bag, status, "VITTE_DIAG_E_ALLOC", "failed to grow diagnostic storage", code);
+        return status;
+    }
 
     diagnostic = &bag->storage[bag->count];
     vitte_diagnostic_init(diagnostic);
     diagnostic->severity = severity;
     diagnostic->code = code;
-    diagnostic->message = message;
-    diagnostic->details = details;
-    vitte_diagnostic_copy_span(diagnostic, span);
+    diagnostic->message = vitte_diagnostic_copy_text(bag, message);
+    diagnostic->details = vitte_diagnostic_copy_text(bag, details);
+    if (span != NULL) {
+        diagnostic->source_name = vitte_diagnostic_source_name(bag, span->source_name);
+        diagnostic->start_offset = span->start_offset;
+        diagnostic->end_offset = span->end_offset;
+        diagnostic->start_line = span->start_line;
+        diagnostic->start_column = span->start_column;
+        diagnostic->end_line = span->end_line;
+        diagnostic->end_column = span->end_column;
+        diagnostic->has_span = true;
+        seen = vitte_diagnostic_seen_slot(bag, code, span);
+    }
+    if (diagnostic->message == NULL ||
+        (details != NULL && diagnostic->details == NULL) ||
+        (span != NULL && vitte_diagnostic_text_is_valid(span->source_name) && diagnostic->source_name == NULL)) {
+        vitte_diagnostic_set_error(bag, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DIAG_E_ALLOC", "failed to copy diagnostic text", code);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    if (seen != NULL) {
+        *seen = bag->count + 1u;
+    }
     bag->count++;
     vitte_diagnostic_count(bag, severity);
     vitte_error_reset(&bag->last_error);
@@ -493,20 +652,10 @@ vitte_status_t vitte_diagnostic_merge(
     for (index = 0u; index < source->count; index++) {
         const vitte_diagnostic_t *diagnostic = &source->storage[index];
         vitte_ast_span_t span;
-        vitte_ast_span_t *span_ptr = NULL;
         vitte_status_t status;
 
         if (diagnostic->has_span) {
-            vitte_ast_span_init(&span);
-            span.source_name = diagnostic->source_name;
-            span.start_offset = diagnostic->start_offset;
-            span.end_offset = diagnostic->end_offset;
-            span.start_line = diagnostic->start_line;
-            span.start_column = diagnostic->start_column;
-            span.end_line = diagnostic->end_line;
-            span.end_column = diagnostic->end_column;
-            span.valid = true;
-            span_ptr = &span;
+            vitte_diagnostic_entry_span(diagnostic, &span);
         }
         status = vitte_diagnostic_add(
             destination,
@@ -514,13 +663,18 @@ vitte_status_t vitte_diagnostic_merge(
             diagnostic->code,
             diagnostic->message,
             diagnostic->details,
-            span_ptr
+            diagnostic->has_span ? &span : NULL
         );
+        if (status == VITTE_STATUS_ERROR_UNSUPPORTED) {
+            /* Past the destination limit: counted as suppressed, like a direct add. */
+            continue;
+        }
         if (status != VITTE_STATUS_OK) {
             return status;
         }
     }
     destination->counts.suppressed_count += source->counts.suppressed_count;
+    destination->counts.duplicate_count += source->counts.duplicate_count;
     vitte_error_reset(&destination->last_error);
     return VITTE_STATUS_OK;
 }
@@ -6,13 +6,16 @@
 #include <stdio.h>
 
 #include "../api/error.h"
+#include "../arena/arena.h"
 #include "../ast/ast.h"
+#include "../intern/intern.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#define VITTE_DIAGNOSTIC_SOURCE_NAME_CAPACITY ((size_t)4096u)
+/* Entries the storage array starts with; it doubles up to `max_diagnostics`. */
+#define VITTE_DIAGNOSTIC_INITIAL_CAPACITY ((size_t)8u)
 
 typedef enum vitte_diagnostic_severity {
     VITTE_DIAGNOSTIC_NOTE = 0,
@@ -29,6 +32,8 @@ typedef struct vitte_diagnostic_options {
     bool show_source_line;
     bool show_codes;
     bool show_details;
+    /* Borrowed; source names are interned here when set, else copied into the bag. */
+    vitte_interner_t *interner;
 } vitte_diagnostic_options_t;
 
 typedef struct vitte_diagnostic_counts {
@@ -38,15 +43,20 @@ typedef struct vitte_diagnostic_counts {
     size_t error_count;
     size_t fatal_count;
     size_t suppressed_count;
+    /* Adds dropped because an entry with the same code and span was already stored. */
+    size_t duplicate_count;
 } vitte_diagnostic_counts_t;
 
+/*
+ * `message`, `details` and `source_name` are owned by the bag (or its
+ * interner); `code` is borrowed and must be static, as every caller's is.
+ */
 typedef struct vitte_diagnostic {
     vitte_diagnostic_severity_t severity;
     const char *code;
     const char *message;
     const char *details;
     const char *source_name;
-    char source_name_storage[VITTE_DIAGNOSTIC_SOURCE_NAME_CAPACITY];
     size_t start_offset;
     size_t end_offset;
     unsigned start_line;
@@ -58,9 +68,16 @@ typedef struct vitte_diagnostic {
 
 typedef struct vitte_diagnostic_bag {
     bool initialized;
+    vitte_allocator_t allocator;
+    /* Grows on demand; pointers from vitte_diagnostic_at last until the next add. */
     vitte_diagnostic_t *storage;
     size_t capacity;
     size_t count;
+    /* Message, details and uninterned source name copies. */
+    vitte_arena_t text;
+    /* Open-addressed (code, span) hash of spanned entries: index + 1, zero when empty. */
+    size_t *seen;
+    size_t seen_capacity;
     vitte_diagnostic_counts_t counts;
     vitte_diagnostic_options_t options;
     vitte_error_t last_error;
@@ -70,13 +87,15 @@ void vitte_diagnostic_options_init(vitte_diagnostic_options_t *options);
 void vitte_diagnostic_counts_init(vitte_diagnostic_counts_t *counts);
 void vitte_diagnostic_init(vitte_diagnostic_t *diagnostic);
 
+/* Allocates nothing until the first add; `allocator` may be NULL for the default. */
 vitte_status_t vitte_diagnostic_bag_init(
     vitte_diagnostic_bag_t *bag,
-    vitte_diagnostic_t *storage,
-    size_t capacity,
+    const vitte_allocator_t *allocator,
     const vitte_diagnostic_options_t *options
 );
 
+void vitte_diagnostic_bag_destroy(vitte_diagnostic_bag_t *bag);
+/* Drops every entry, keeping the storage and the first text block for reuse. */
 void vitte_diagnostic_bag_reset(vitte_diagnostic_bag_t *bag);
 bool vitte_diagnostic_bag_is_initialized(const vitte_diagnostic_bag_t *bag);
 const vitte_error_t *vitte_diagnostic_bag_last_error(const vitte_diagnostic_bag_t *bag);
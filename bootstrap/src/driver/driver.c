@@ -1,28 +1,67 @@
 #include "driver.h"
 
 #include <ctype.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #include "../codegen/codegen.h"
 #include "../filesystem/filesystem.h"
 #include "../hir/hir.h"
 #include "../import/import.h"
+#include "../intern/intern.h"
 #include "../ir/ir.h"
 #include "../module/module.h"
+#include "../parallel/parallel.h"
 #include "../parser/parser.h"
+#include "../process/process.h"
 #include "../sema/sema.h"
+#include "../util/util.h"
 
 #define VITTE_DRIVER_MAX_IMPORTED_UNITS ((size_t)256u)
+#define VITTE_DRIVER_C_FLAG_COUNT ((size_t)4u)
+/* Compiler, flags, `-c`, `-x c`, input, `-o`, output and the terminating NULL. */
+#define VITTE_DRIVER_COMPILER_ARGC (VITTE_DRIVER_C_FLAG_COUNT + 8u)
+
+static const char *const vitte_driver_c_flags[VITTE_DRIVER_C_FLAG_COUNT] = { "-std=c17", "-Wall", "-Wextra", "-pedantic" };
 
 typedef struct vitte_driver_import_unit {
     char module_name[VITTE_IMPORT_MAX_MODULE_NAME];
     char resolved_path[VITTE_FS_MAX_PATH];
     vitte_ast_t ast;
-    vitte_module_t module;
+    /* Separate so it can be freed once flattening has read its imports. */
+    vitte_module_t *module;
+    vitte_sema_export_summary_t exports;
+    vitte_cache_key_t source_key;
+    vitte_cache_key_t interface_key;
+    vitte_cache_key_t fingerprint;
+    size_t order;
+    bool sema_reused;
+    bool sema_clean;
+    /* The unit itself came from this (tagged) allocator. */
+    vitte_allocator_t allocator;
 } vitte_driver_import_unit_t;
 
+/*
+ * Import units keyed by resolved path and by module name. Slots point at
+ * units owned by the driver's unit array; a unit is indexed once its imports
+ * are resolved.
+ */
+typedef struct vitte_driver_unit_index {
+    const vitte_driver_import_unit_t *by_path[VITTE_DRIVER_MAX_IMPORTED_UNITS * 2u];
+    const vitte_driver_import_unit_t *by_module[VITTE_DRIVER_MAX_IMPORTED_UNITS * 2u];
+} vitte_driver_unit_index_t;
+
+struct vitte_driver_profile {
+    vitte_parallel_mutex_t lock;
+    vitte_driver_stage_profile_t stages[VITTE_DRIVER_STAGE_COUNT];
+    vitte_driver_unit_memory_t *units;
+    size_t unit_count;
+    size_t unit_capacity;
+};
+
 typedef struct vitte_driver_flatten_binding {
     const char *source_module_name;
     const char *visible_name;
@@ -33,13 +72,22 @@ typedef struct vitte_driver_flatten_binding {
     struct vitte_driver_flatten_binding *next;
 } vitte_driver_flatten_binding_t;
 
+/*
+ * Bindings are indexed twice: by (source module, visible name) and by
+ * (owner module, source declaration). Both tables share one power-of-two
+ * capacity, are allocated from the lowered AST arena like the bindings, and
+ * are rebuilt at twice the size when half full.
+ */
 typedef struct vitte_driver_flatten_state {
     vitte_driver_flatten_binding_t *bindings;
+    vitte_driver_flatten_binding_t **visible_slots;
+    vitte_driver_flatten_binding_t **decl_slots;
+    size_t slot_capacity;
+    size_t binding_count;
 } vitte_driver_flatten_state_t;
 
 static const vitte_driver_import_unit_t *vitte_driver_find_import_unit_by_path(
-    vitte_driver_import_unit_t *const *units,
-    size_t unit_count,
+    const vitte_driver_unit_index_t *unit_index,
     const char *resolved_path
 );
 static vitte_status_t vitte_driver_register_target_export_visible_name(
@@ -58,6 +106,8 @@ static vitte_status_t vitte_driver_parse_imported_unit(
     const char *path,
     vitte_driver_import_unit_t *unit
 );
+static vitte_driver_import_unit_t *vitte_driver_create_import_unit(const vitte_driver_t *driver);
+static void vitte_driver_destroy_import_unit(vitte_driver_import_unit_t *unit);
 
 static void vitte_driver_set_error(
     vitte_driver_t *driver,
@@ -100,6 +150,201 @@ static vitte_status_t vitte_driver_add_diag(
     return vitte_diagnostic_add(&driver->diagnostics, severity, code, message, details, NULL);
 }
 
+static uint64_t vitte_driver_arena_bytes(const vitte_arena_t *arena) {
+    const vitte_arena_stats_t *stats = vitte_arena_stats(arena);
+
+    return stats != NULL ? (uint64_t)stats->bytes_used : 0u;
+}
+
+/*
+ * Charges the time since `start` to `stage` and records it as a span named
+ * after the stage and `detail`, usually the module path. Safe from workers.
+ */
+static void vitte_driver_profile_stage(
+    const vitte_driver_t *driver,
+    vitte_driver_stage_t stage,
+    const char *detail,
+    const vitte_trace_clock_t *start,
+    const vitte_trace_counts_t *counts
+) {
+    vitte_driver_stage_profile_t *profile;
+    vitte_trace_clock_t end;
+
+    if (driver == NULL || driver->profile == NULL || start == NULL || stage >= VITTE_DRIVER_STAGE_COUNT) {
+        return;
+    }
+    vitte_trace_clock_now(&end);
+    vitte_parallel_mutex_lock(&driver->profile->lock);
+    profile = &driver->profile->stages[stage];
+    profile->wall_ns += end.wall_ns > start->wall_ns ? end.wall_ns - start->wall_ns : 0u;
+    profile->cpu_ns += end.cpu_ns > start->cpu_ns ? end.cpu_ns - start->cpu_ns : 0u;
+    if (counts != NULL) {
+        profile->bytes_in += counts->bytes_in;
+        profile->bytes_out += counts->bytes_out;
+        profile->arena_bytes += counts->arena_bytes;
+    }
+    profile->runs++;
+    vitte_parallel_mutex_unlock(&driver->profile->lock);
+    vitte_trace_record(driver->trace, "stage", vitte_driver_stage_name(stage), detail, start, &end, counts);
+}
+
+/* Per-module span enclosing that module's stage spans. */
+static void vitte_driver_trace_unit(
+    const vitte_driver_t *driver,
+    const char *name,
+    const char *detail,
+    const vitte_trace_clock_t *start,
+    uint64_t bytes_in
+) {
+    vitte_trace_counts_t counts;
+    vitte_trace_clock_t end;
+
+    if (driver == NULL || driver->trace == NULL) {
+        return;
+    }
+    vitte_trace_clock_now(&end);
+    memset(&counts, 0, sizeof(counts));
+    counts.bytes_in = bytes_in;
+    vitte_trace_record(driver->trace, "unit", name, detail, start, &end, &counts);
+}
+
+static void vitte_driver_reset_unit_memory(struct vitte_driver_profile *profile) {
+    size_t index;
+
+    for (index = 0u; index < profile->unit_count; index++) {
+        free((char *)profile->units[index].path);
+    }
+    profile->unit_count = 0u;
+}
+
+static void vitte_driver_destroy_profile(struct vitte_driver_profile *profile) {
+    if (profile != NULL) {
+        vitte_driver_reset_unit_memory(profile);
+        free(profile->units);
+        vitte_parallel_mutex_destroy(&profile->lock);
+        free(profile);
+    }
+}
+
+static vitte_memory_account_t *vitte_driver_memory(const vitte_driver_t *driver) {
+    return driver != NULL ? vitte_context_memory(driver->context) : NULL;
+}
+
+static void vitte_driver_allocator(
+    const vitte_driver_t *driver,
+    vitte_memory_subsystem_t subsystem,
+    vitte_allocator_t *allocator
+) {
+    vitte_memory_account_allocator(vitte_driver_memory(driver), subsystem, allocator);
+}
+
+/* Arena settings for an owned AST, HIR or IR, charged to `subsystem`. */
+static void vitte_driver_arena_config(
+    const vitte_driver_t *driver,
+    vitte_memory_subsystem_t subsystem,
+    vitte_arena_config_t *config
+) {
+    vitte_arena_config_init(config);
+    vitte_driver_allocator(driver, subsystem, &config->allocator);
+    config->huge_pages = driver->huge_pages;
+}
+
+/* Zeroed `count * size` bytes charged to `subsystem`; free with vitte_driver_free. */
+static void *vitte_driver_calloc(
+    const vitte_driver_t *driver,
+    vitte_memory_subsystem_t subsystem,
+    size_t count,
+    size_t size
+) {
+    vitte_allocator_t allocator;
+    void *memory;
+
+    if (size != 0u && count > SIZE_MAX / size) {
+        return NULL;
+    }
+    vitte_driver_allocator(driver, subsystem, &allocator);
+    memory = allocator.alloc(allocator.user, count * size);
+    if (memory != NULL) {
+        memset(memory, 0, count * size);
+    }
+    return memory;
+}
+
+static void vitte_driver_free(const vitte_driver_t *driver, vitte_memory_subsystem_t subsystem, void *memory) {
+    vitte_allocator_t allocator;
+
+    if (memory == NULL) {
+        return;
+    }
+    vitte_driver_allocator(driver, subsystem, &allocator);
+    allocator.free(allocator.user, memory);
+}
+
+/*
+ * Adds a parsed module's source, token arena and AST arena to its row of the
+ * per-unit memory table. Safe from workers.
+ */
+static void vitte_driver_record_unit_memory(
+    const vitte_driver_t *driver,
+    const char *path,
+    size_t source_bytes,
+    const vitte_module_t *module,
+    const vitte_ast_t *ast
+) {
+    struct vitte_driver_profile *profile;
+    vitte_driver_unit_memory_t *row = NULL;
+    const vitte_arena_stats_t *stats;
+    size_t index;
+
+    if (driver == NULL || driver->profile == NULL || path == NULL) {
+        return;
+    }
+    profile = driver->profile;
+    vitte_parallel_mutex_lock(&profile->lock);
+    for (index = 0u; index < profile->unit_count; index++) {
+        if (strcmp(profile->units[index].path, path) == 0) {
+            row = &profile->units[index];
+            break;
+        }
+    }
+    if (row == NULL) {
+        size_t length = strlen(path);
+        char *copy;
+
+        if (profile->unit_count == profile->unit_capacity) {
+            size_t capacity = profile->unit_capacity != 0u ? profile->unit_capacity * 2u : 32u;
+            vitte_driver_unit_memory_t *grown = (vitte_driver_unit_memory_t *)realloc(profile->units, capacity * sizeof(*grown));
+
+            if (grown == NULL) {
+                vitte_parallel_mutex_unlock(&profile->lock);
+                return;
+            }
+            profile->units = grown;
+            profile->unit_capacity = capacity;
+        }
+        copy = (char *)malloc(length + 1u);
+        if (copy == NULL) {
+            vitte_parallel_mutex_unlock(&profile->lock);
+            return;
+        }
+        memcpy(copy, path, length + 1u);
+        row = &profile->units[profile->unit_count++];
+        memset(row, 0, sizeof(*row));
+        row->path = copy;
+    }
+    row->parses++;
+    row->source_bytes += source_bytes;
+    if (module != NULL && (stats = vitte_arena_stats(&module->token_arena)) != NULL) {
+        row->token_bytes_reserved += stats->bytes_reserved;
+        row->token_bytes_used += stats->bytes_used;
+    }
+    if (ast != NULL && (stats = vitte_arena_stats(ast->arena)) != NULL) {
+        row->ast_bytes_reserved += stats->bytes_reserved;
+        row->ast_bytes_used += stats->bytes_used;
+    }
+    vitte_parallel_mutex_unlock(&profile->lock);
+}
+
 static void vitte_driver_pipeline_reset(vitte_driver_pipeline_t *pipeline) {
     size_t index;
 
@@ -141,6 +386,7 @@ void vitte_driver_options_init(vitte_driver_options_t *options) {
     options->max_source_bytes = VITTE_CONFIG_DEFAULT_MAX_SOURCE_BYTES;
     options->max_ast_depth = VITTE_CONFIG_DEFAULT_MAX_AST_DEPTH;
     options->max_diagnostics = VITTE_CONFIG_DEFAULT_MAX_DIAGNOSTICS;
+    options->jobs = VITTE_CONFIG_DEFAULT_JOBS;
 }
 
 bool vitte_driver_emit_kind_is_valid(vitte_driver_emit_kind_t kind) {
@@ -233,77 +479,28 @@ vitte_status_t vitte_driver_input_from_buffer(
     return VITTE_STATUS_OK;
 }
 
-static vitte_status_t vitte_driver_file_size(FILE *stream, size_t *size) {
-    long end;
-
-    if (stream == NULL || size == NULL) {
-        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
-    }
-    if (fseek(stream, 0L, SEEK_END) != 0) {
-        return VITTE_STATUS_ERROR_IO;
-    }
-    end = ftell(stream);
-    if (end < 0L) {
-        return VITTE_STATUS_ERROR_IO;
-    }
-    if (fseek(stream, 0L, SEEK_SET) != 0) {
-        return VITTE_STATUS_ERROR_IO;
-    }
-    *size = (size_t)end;
-    return VITTE_STATUS_OK;
-}
-
 vitte_status_t vitte_driver_input_from_file(
     vitte_driver_input_t *input,
     const char *path,
     size_t max_bytes
 ) {
-    FILE *stream;
+    vitte_fs_options_t options;
+    vitte_fs_source_storage_t storage;
     char *buffer;
     size_t size;
-    size_t read_count;
     vitte_status_t status;
 
     if (input == NULL || path == NULL || path[0] == '\0') {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
 
-    stream = fopen(path, "rb");
-    if (stream == NULL) {
-        return VITTE_STATUS_ERROR_IO;
-    }
-
-    status = vitte_driver_file_size(stream, &size);
+    vitte_fs_options_init(&options);
+    options.max_file_bytes = max_bytes;
+    options.null_terminate_reads = true;
+    status = vitte_fs_read_source(path, &buffer, &size, &storage, &options, NULL);
     if (status != VITTE_STATUS_OK) {
-        (void)fclose(stream);
         return status;
     }
-    if (max_bytes != 0u && size > max_bytes) {
-        (void)fclose(stream);
-        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
-    }
-    if (size == (size_t)-1) {
-        (void)fclose(stream);
-        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
-    }
-
-    buffer = (char *)malloc(size + 1u);
-    if (buffer == NULL) {
-        (void)fclose(stream);
-        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
-    }
-
-    read_count = size > 0u ? fread(buffer, 1u, size, stream) : 0u;
-    if (read_count != size || ferror(stream) != 0) {
-        free(buffer);
-        (void)fclose(stream);
-        return VITTE_STATUS_ERROR_IO;
-    }
-    buffer[size] = '\0';
-    if (fclose(stream) != 0) {
-        free(buffer);
-        return VITTE_STATUS_ERROR_IO;
-    }
 
     vitte_driver_input_init(input);
     input->kind = VITTE_DRIVER_INPUT_FILE;
@@ -312,6 +509,7 @@ vitte_status_t vitte_driver_input_from_file(
     input->buffer = buffer;
     input->size = size;
     input->owns_buffer = true;
+    input->storage = storage;
     return VITTE_STATUS_OK;
 }
 
@@ -320,7 +518,7 @@ void vitte_driver_input_destroy(vitte_driver_input_t *input) {
         return;
     }
     if (input->owns_buffer) {
-        free((void *)input->buffer);
+        vitte_fs_free_source((void *)input->buffer, input->size, input->storage);
     }
     vitte_driver_input_init(input);
 }
@@ -386,10 +584,12 @@ static vitte_status_t vitte_driver_apply_options(
     driver->config.paths.output_path = effective_options->output_path;
     driver->config.paths.root_path = effective_options->root_path;
     driver->config.paths.sysroot_path = effective_options->sysroot_path;
+    driver->config.paths.cache_path = effective_options->cache_path;
     driver->config.target = VITTE_CONFIG_TARGET_HOST;
     driver->config.build_mode = vitte_driver_config_mode(effective_options->emit_kind);
     driver->config.codegen.c_compiler = effective_options->c_compiler != NULL ? effective_options->c_compiler : "cc";
     driver->config.codegen.keep_intermediate_c = effective_options->keep_intermediate_c;
+    driver->config.codegen.separate_units = effective_options->separate_compilation;
     driver->config.limits.max_source_bytes = effective_options->max_source_bytes != 0u ?
         effective_options->max_source_bytes :
         VITTE_CONFIG_DEFAULT_MAX_SOURCE_BYTES;
@@ -399,13 +599,18 @@ static vitte_status_t vitte_driver_apply_options(
     driver->config.limits.max_diagnostics = effective_options->max_diagnostics != 0u ?
         effective_options->max_diagnostics :
         VITTE_CONFIG_DEFAULT_MAX_DIAGNOSTICS;
+    driver->config.limits.jobs = effective_options->jobs != 0u ? effective_options->jobs : VITTE_CONFIG_DEFAULT_JOBS;
+    driver->config.limits.max_cache_bytes = effective_options->max_cache_bytes;
     driver->config.verbose = effective_options->verbose;
     driver->config.warnings_as_errors = effective_options->warnings_as_errors;
+    driver->huge_pages = effective_options->huge_pages;
+    driver->output_stream = effective_options->output_stream;
+    driver->c_warning_stream = effective_options->c_warning_stream;
 
     vitte_diagnostic_options_init(&driver->diagnostic_options);
     driver->diagnostic_options.max_diagnostics = driver->config.limits.max_diagnostics;
-    if (driver->diagnostic_options.max_diagnostics > 128u) {
-        driver->diagnostic_options.max_diagnostics = 128u;
+    if (driver->context != NULL) {
+        driver->diagnostic_options.interner = vitte_context_interner(driver->context);
     }
     driver->diagnostic_options.warnings_as_errors = effective_options->warnings_as_errors;
     driver->diagnostic_options.color_enabled = effective_options->color_diagnostics;
@@ -420,6 +625,7 @@ vitte_status_t vitte_driver_init(
     vitte_context_t *context,
     const vitte_driver_options_t *options
 ) {
+    vitte_allocator_t diagnostic_allocator;
     vitte_status_t status;
 
     if (driver == NULL) {
@@ -435,16 +641,54 @@ vitte_status_t vitte_driver_init(
     if (status != VITTE_STATUS_OK) {
         return status;
     }
-    status = vitte_diagnostic_bag_init(
-        &driver->diagnostics,
-        driver->diagnostic_storage,
-        sizeof(driver->diagnostic_storage) / sizeof(driver->diagnostic_storage[0]),
-        &driver->diagnostic_options
-    );
+    vitte_driver_allocator(driver, VITTE_MEMORY_DRIVER, &diagnostic_allocator);
+    status = vitte_diagnostic_bag_init(&driver->diagnostics, &diagnostic_allocator, &driver->diagnostic_options);
     if (status != VITTE_STATUS_OK) {
         vitte_driver_set_error(driver, status, "VITTE_DRIVER_E_DIAGNOSTIC", "failed to initialize diagnostics", NULL);
         return status;
     }
+    driver->imported_asts = (vitte_ast_t *)vitte_driver_calloc(driver, VITTE_MEMORY_AST, VITTE_MODULE_MAX_IMPORTS, sizeof(*driver->imported_asts));
+    if (driver->imported_asts == NULL) {
+        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_AST", "failed to allocate imported ASTs", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    driver->profile = (struct vitte_driver_profile *)calloc(1u, sizeof(*driver->profile));
+    status = driver->profile == NULL ? VITTE_STATUS_ERROR_OUT_OF_MEMORY : vitte_parallel_mutex_init(&driver->profile->lock);
+    if (status != VITTE_STATUS_OK) {
+        vitte_driver_set_error(driver, status, "VITTE_DRIVER_E_PROFILE", "failed to initialize stage profile", NULL);
+        free(driver->profile);
+        driver->profile = NULL;
+        vitte_driver_free(driver, VITTE_MEMORY_AST, driver->imported_asts);
+        driver->imported_asts = NULL;
+        return status;
+    }
+    driver->trace = options != NULL ? options->trace : NULL;
+    if (options != NULL && options->shared_cache != NULL) {
+        driver->module_cache = options->shared_cache;
+    } else if (driver->config.paths.cache_path != NULL && driver->config.paths.cache_path[0] != '\0') {
+        driver->module_cache = (vitte_cache_t *)calloc(1u, sizeof(*driver->module_cache));
+        if (driver->module_cache == NULL) {
+            vitte_driver_set_error(driver, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_CACHE", "failed to allocate module cache", NULL);
+            vitte_driver_destroy_profile(driver->profile);
+            driver->profile = NULL;
+            vitte_driver_free(driver, VITTE_MEMORY_AST, driver->imported_asts);
+            driver->imported_asts = NULL;
+            return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        }
+        status = vitte_cache_init(driver->module_cache, driver->config.paths.cache_path);
+        if (status != VITTE_STATUS_OK) {
+            vitte_error_copy(&driver->last_error, vitte_cache_last_error(driver->module_cache));
+            free(driver->module_cache);
+            driver->module_cache = NULL;
+            vitte_driver_destroy_profile(driver->profile);
+            driver->profile = NULL;
+            vitte_driver_free(driver, VITTE_MEMORY_AST, driver->imported_asts);
+            driver->imported_asts = NULL;
+            return status;
+        }
+        vitte_cache_set_object_limit(driver->module_cache, driver->config.limits.max_cache_bytes);
+        driver->owns_module_cache = true;
+    }
 
     driver->initialized = true;
     return VITTE_STATUS_OK;
@@ -454,6 +698,13 @@ void vitte_driver_shutdown(vitte_driver_t *driver) {
     if (driver == NULL) {
         return;
     }
+    if (driver->owns_module_cache) {
+        vitte_cache_destroy(driver->module_cache);
+        free(driver->module_cache);
+    }
+    vitte_diagnostic_bag_destroy(&driver->diagnostics);
+    vitte_driver_free(driver, VITTE_MEMORY_AST, driver->imported_asts);
+    vitte_driver_destroy_profile(driver->profile);
     memset(driver, 0, sizeof(*driver));
 }
 
@@ -534,33 +785,76 @@ static vitte_status_t vitte_driver_configure_import_resolver(
     return VITTE_STATUS_OK;
 }
 
-static vitte_status_t vitte_driver_parse_ast(
-    vitte_driver_t *driver,
+/*
+ * Cache key of a parsed module: everything the parser's output depends on,
+ * the compiler version and build id being folded in by vitte_cache_key_init.
+ */
+static void vitte_driver_module_cache_key(
+    const vitte_driver_t *driver,
+    const vitte_driver_input_t *input,
+    const vitte_module_t *module,
+    vitte_cache_key_t *key
+) {
+    vitte_cache_key_init(key);
+    vitte_cache_key_add_text(key, module->source_name);
+    vitte_cache_key_add_text(key, module->module_name);
+    vitte_cache_key_add_size(key, driver->config.limits.max_ast_depth);
+    vitte_cache_key_add_size(key, input->size);
+    vitte_cache_key_add(key, input->buffer, input->size);
+}
+
+/*
+ * Lexes and parses one source into `ast`/`module`, reporting into the given
+ * diagnostic bag and error. Only read-only driver state is used, so imported
+ * units can be parsed on worker threads with their own sinks. With a module
+ * cache, `source_key` (optional) receives the module's cache key. The module's
+ * tokens are released before a successful return.
+ */
+static vitte_status_t vitte_driver_parse_module_ast(
+    const vitte_driver_t *driver,
     const vitte_driver_input_t *input,
     vitte_ast_t *ast,
-    vitte_module_t *module
+    vitte_module_t *module,
+    vitte_diagnostic_bag_t *diagnostics,
+    vitte_error_t *error,
+    vitte_cache_key_t *source_key
 ) {
     vitte_parser_t parser;
     vitte_parser_options_t parser_options;
     vitte_parser_result_t parser_result;
+    vitte_module_options_t module_options;
+    vitte_cache_key_t cache_key;
+    vitte_trace_clock_t start;
+    vitte_trace_counts_t counts;
+    const char *detail;
+    size_t diagnostic_count;
     vitte_status_t status;
 
-    if (driver == NULL || input == NULL || ast == NULL || module == NULL) {
+    if (driver == NULL || input == NULL || ast == NULL || module == NULL || diagnostics == NULL || error == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
+    detail = input->path != NULL ? input->path : input->source_name;
+    memset(&counts, 0, sizeof(counts));
+    counts.bytes_in = input->size;
 
     vitte_parser_options_init(&parser_options);
     parser_options.max_depth = driver->config.limits.max_ast_depth;
     parser_options.recover_errors = true;
+    parser_options.lexer_options.interner = vitte_context_interner(driver->context);
     vitte_parser_result_init(&parser_result);
-    status = vitte_module_init(module, NULL);
+    vitte_module_options_init(&module_options);
+    module_options.lexer_options = parser_options.lexer_options;
+    vitte_driver_allocator(driver, VITTE_MEMORY_TOKENS, &module_options.allocator);
+    /* Module setup (a large zeroed struct) is charged to loading the source. */
+    vitte_trace_clock_now(&start);
+    status = vitte_module_init(module, &module_options);
     if (status != VITTE_STATUS_OK) {
         return status;
     }
     if (input->path != NULL && input->path[0] != '\0') {
         status = vitte_module_set_source_path(module, input->path);
         if (status != VITTE_STATUS_OK) {
-            vitte_error_copy(&driver->last_error, vitte_module_last_error(module));
+            vitte_error_copy(error, vitte_module_last_error(module));
             return status;
         }
     }
@@ -571,26 +865,114 @@ static vitte_status_t vitte_driver_parse_ast(
         input->size,
         false
     );
+    vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_LOAD_SOURCE, detail, &start, NULL);
     if (status != VITTE_STATUS_OK) {
-        vitte_error_copy(&driver->last_error, vitte_module_last_error(module));
+        vitte_error_copy(error, vitte_module_last_error(module));
+        return status;
+    }
+    if (driver->module_cache != NULL) {
+        bool hit = false;
+
+        vitte_trace_clock_now(&start);
+        vitte_driver_module_cache_key(driver, input, module, &cache_key);
+        if (source_key != NULL) {
+            *source_key = cache_key;
+        }
+        status = vitte_cache_load_module(
+            driver->module_cache,
+            &cache_key,
+            ast,
+            module,
+            parser_options.lexer_options.interner,
+            &hit,
+            error
+        );
+        if (status != VITTE_STATUS_OK) {
+            return status;
+        }
+        if (hit) {
+            status = vitte_ast_module_build_index(ast, ast->root);
+            if (status != VITTE_STATUS_OK) {
+                vitte_error_copy(error, vitte_ast_last_error(ast));
+            }
+            counts.arena_bytes = vitte_driver_arena_bytes(ast->arena);
+            vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_BUILD_AST, detail, &start, &counts);
+            if (status == VITTE_STATUS_OK) {
+                vitte_driver_record_unit_memory(driver, detail, input->size, module, ast);
+            }
+            vitte_module_release_tokens(module);
+            return status;
+        }
+        vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_BUILD_AST, detail, &start, NULL);
+    }
+    diagnostic_count = vitte_diagnostic_bag_total_count(diagnostics);
+    /* Lex once into the module token buffer; lexer errors are reported by the
+     * parser when it reaches the offending token. */
+    vitte_trace_clock_now(&start);
+    status = vitte_module_lex(module);
+    counts.bytes_out = (uint64_t)module->token_count * sizeof(*module->tokens);
+    counts.arena_bytes = vitte_driver_arena_bytes(&module->token_arena);
+    vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_LEX, detail, &start, &counts);
+    if (status != VITTE_STATUS_OK && !vitte_module_has_tokens(module)) {
+        vitte_error_copy(error, vitte_module_last_error(module));
         return status;
     }
-    status = vitte_parser_init_module(&parser, module, ast, &parser_options, &driver->diagnostics);
+    vitte_trace_clock_now(&start);
+    counts.bytes_in = counts.bytes_out;
+    counts.bytes_out = 0u;
+    status = vitte_parser_init_module(&parser, module, ast, &parser_options, diagnostics);
     if (status != VITTE_STATUS_OK) {
-        vitte_error_copy(&driver->last_error, vitte_parser_last_error(&parser));
+        vitte_error_copy(error, vitte_parser_last_error(&parser));
         return status;
     }
 
     status = vitte_parser_parse_module(&parser, &parser_result);
     if (status != VITTE_STATUS_OK) {
-        vitte_error_copy(&driver->last_error, &parser_result.last_error);
+        vitte_error_copy(error, &parser_result.last_error);
         vitte_parser_destroy(&parser);
         return status;
     }
     vitte_parser_destroy(&parser);
+    counts.arena_bytes = vitte_driver_arena_bytes(ast->arena);
+    vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_PARSE, detail, &start, &counts);
+    if (ast->root != NULL && ast->root->kind == VITTE_AST_NODE_MODULE) {
+        vitte_trace_clock_now(&start);
+        status = vitte_ast_module_build_index(ast, ast->root);
+        if (status != VITTE_STATUS_OK) {
+            vitte_error_copy(error, vitte_ast_last_error(ast));
+            return status;
+        }
+        /* Only clean parses are cached: diagnostics are not replayed on a hit.
+         * A failed store just means the next run parses again. */
+        if (driver->module_cache != NULL && vitte_diagnostic_bag_total_count(diagnostics) == diagnostic_count) {
+            vitte_error_t store_error;
+
+            vitte_error_init(&store_error);
+            (void)vitte_cache_store_module(driver->module_cache, &cache_key, ast, module, &store_error);
+        }
+        counts.bytes_in = 0u;
+        counts.arena_bytes = vitte_driver_arena_bytes(ast->arena);
+        vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_BUILD_AST, detail, &start, &counts);
+    }
+    vitte_driver_record_unit_memory(driver, detail, input->size, module, ast);
+    /* Nothing after the parser reads tokens. */
+    vitte_module_release_tokens(module);
     return VITTE_STATUS_OK;
 }
 
+static vitte_status_t vitte_driver_parse_ast(
+    vitte_driver_t *driver,
+    const vitte_driver_input_t *input,
+    vitte_ast_t *ast,
+    vitte_module_t *module,
+    vitte_cache_key_t *source_key
+) {
+    if (driver == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    return vitte_driver_parse_module_ast(driver, input, ast, module, &driver->diagnostics, &driver->last_error, source_key);
+}
+
 static vitte_status_t vitte_driver_validate_input(
     vitte_driver_t *driver,
     const vitte_driver_input_t *input
@@ -626,6 +1008,8 @@ static void vitte_driver_update_counts(vitte_driver_t *driver, vitte_driver_resu
         result->diagnostic_count = vitte_diagnostic_bag_total_count(&driver->diagnostics);
     }
     result->stages_completed = driver->pipeline.completed_count;
+    result->modules_analyzed = driver->analyzed_module_count;
+    result->modules_reused = driver->reused_module_count;
 }
 
 static void vitte_driver_set_error_from_diagnostics(
@@ -695,17 +1079,13 @@ static vitte_status_t vitte_driver_emit_c_impl(
     vitte_codegen_result_t codegen_result;
     vitte_status_t status;
 
-    vitte_config_to_codegen_options(
-        &driver->config,
-        &options,
-        result != NULL ? result->output_buffer : NULL,
-        result != NULL ? sizeof(result->output_buffer) : 0u
-    );
+    vitte_config_to_codegen_options(&driver->config, &options, NULL, 0u);
     if (output_path != NULL) {
         options.output_kind = VITTE_CODEGEN_OUTPUT_FILE;
         options.output_path = output_path;
     } else {
-        options.output_kind = VITTE_CODEGEN_OUTPUT_BUFFER;
+        options.output_kind = VITTE_CODEGEN_OUTPUT_STREAM;
+        options.output_stream = driver->output_stream != NULL ? driver->output_stream : stdout;
     }
     options.input_kind = input_kind;
 
@@ -731,21 +1111,56 @@ static vitte_status_t vitte_driver_emit_c_impl(
         result->output.bytes_written = codegen_result.bytes_written;
         result->output.lines_written = codegen_result.lines_written;
         result->output.functions_emitted = codegen_result.functions_emitted;
-        if (output_path == NULL) {
-            result->output.buffer = result->output_buffer;
-        }
     }
     vitte_codegen_destroy(&codegen);
     return VITTE_STATUS_OK;
 }
 
+/* Reads an imported module's source; `unit_start` opens the unit's parse span. */
+static vitte_status_t vitte_driver_load_unit_source(
+    const vitte_driver_t *driver,
+    const char *path,
+    vitte_driver_input_t *input,
+    vitte_trace_clock_t *unit_start
+) {
+    vitte_trace_counts_t counts;
+    vitte_status_t status;
+
+    vitte_trace_clock_now(unit_start);
+    status = vitte_driver_input_from_file(input, path, driver->config.limits.max_source_bytes);
+    memset(&counts, 0, sizeof(counts));
+    counts.bytes_out = status == VITTE_STATUS_OK ? input->size : 0u;
+    vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_LOAD_SOURCE, path, unit_start, &counts);
+    if (status == VITTE_STATUS_OK) {
+        vitte_memory_account_charge(vitte_driver_memory(driver), VITTE_MEMORY_SOURCE, input->size, input->size);
+    }
+    return status;
+}
+
+static void vitte_driver_release_unit_source(const vitte_driver_t *driver, vitte_driver_input_t *input) {
+    vitte_memory_account_release(vitte_driver_memory(driver), VITTE_MEMORY_SOURCE, input->size, input->size);
+    vitte_driver_input_destroy(input);
+}
+
+static vitte_status_t vitte_driver_validate_unit_ast(const vitte_driver_t *driver, const char *path, vitte_ast_t *ast) {
+    vitte_trace_clock_t start;
+    vitte_status_t status;
+
+    vitte_trace_clock_now(&start);
+    status = vitte_ast_validate(ast);
+    vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_VALIDATE_AST, path, &start, NULL);
+    return status;
+}
+
 static vitte_status_t vitte_driver_parse_imported_ast(
     vitte_driver_t *driver,
     const char *path,
     vitte_ast_t *ast
 ) {
     vitte_driver_input_t input;
-    vitte_module_t module;
+    vitte_module_t *module;
+    vitte_arena_config_t arena_config;
+    vitte_trace_clock_t unit_start;
     vitte_status_t status;
 
     if (driver == NULL || path == NULL || ast == NULL) {
@@ -753,27 +1168,38 @@ static vitte_status_t vitte_driver_parse_imported_ast(
     }
 
     vitte_driver_input_init(&input);
-    status = vitte_driver_input_from_file(&input, path, driver->config.limits.max_source_bytes);
+    status = vitte_driver_load_unit_source(driver, path, &input, &unit_start);
     if (status != VITTE_STATUS_OK) {
         vitte_driver_set_error(driver, status, "VITTE_DRIVER_E_IMPORT", "failed to read imported module", path);
         return status;
     }
-    status = vitte_ast_init_owned(ast, NULL);
+    /* Parsed on pool threads; the module record is too large for their stacks. */
+    module = (vitte_module_t *)vitte_driver_calloc(driver, VITTE_MEMORY_MODULES, 1u, sizeof(*module));
+    if (module == NULL) {
+        vitte_driver_release_unit_source(driver, &input);
+        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_IMPORT", "failed to allocate imported module", path);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    vitte_driver_arena_config(driver, VITTE_MEMORY_AST, &arena_config);
+    status = vitte_ast_init_owned(ast, &arena_config);
     if (status != VITTE_STATUS_OK) {
-        vitte_driver_input_destroy(&input);
+        vitte_driver_free(driver, VITTE_MEMORY_MODULES, module);
+        vitte_driver_release_unit_source(driver, &input);
         return status;
     }
-    status = vitte_driver_parse_ast(driver, &input, ast, &module);
+    status = vitte_driver_parse_ast(driver, &input, ast, module, NULL);
     if (status == VITTE_STATUS_OK) {
-        status = vitte_ast_validate(ast);
+        status = vitte_driver_validate_unit_ast(driver, path, ast);
         if (status != VITTE_STATUS_OK) {
             vitte_error_copy(&driver->last_error, vitte_ast_last_error(ast));
         }
     }
-    if (vitte_module_is_initialized(&module)) {
-        vitte_module_destroy(&module);
+    vitte_driver_trace_unit(driver, "parse", path, &unit_start, input.size);
+    if (vitte_module_is_initialized(module)) {
+        vitte_module_destroy(module);
     }
-    vitte_driver_input_destroy(&input);
+    vitte_driver_free(driver, VITTE_MEMORY_MODULES, module);
+    vitte_driver_release_unit_source(driver, &input);
     if (status != VITTE_STATUS_OK) {
         vitte_ast_destroy(ast);
     }
@@ -787,25 +1213,29 @@ static vitte_status_t vitte_driver_run_sema(
     const vitte_ast_t *imported_asts,
     size_t imported_ast_count
 ) {
-    vitte_sema_t *sema = (vitte_sema_t *)calloc(1u, sizeof(*sema));
+    vitte_sema_t *sema = (vitte_sema_t *)vitte_driver_calloc(driver, VITTE_MEMORY_SEMA, 1u, sizeof(*sema));
     vitte_sema_options_t options;
     vitte_sema_result_t result;
+    vitte_trace_clock_t start;
+    vitte_trace_counts_t counts;
     vitte_status_t status;
     size_t index;
 
     if (driver == NULL || ast == NULL || sema == NULL) {
-        free(sema);
+        vitte_driver_free(driver, VITTE_MEMORY_SEMA, sema);
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
+    vitte_trace_clock_now(&start);
 
     vitte_sema_options_init(&options);
     options.max_depth = driver->config.limits.max_ast_depth;
     options.enable_constant_folding = true;
+    vitte_driver_allocator(driver, VITTE_MEMORY_SEMA, &options.allocator);
     vitte_sema_result_init(&result);
     status = vitte_sema_init(sema, &options, &driver->diagnostics);
     if (status != VITTE_STATUS_OK) {
         vitte_error_copy(&driver->last_error, vitte_sema_last_error(sema));
-        free(sema);
+        vitte_driver_free(driver, VITTE_MEMORY_SEMA, sema);
         return status;
     }
     if (module != NULL) {
@@ -814,7 +1244,7 @@ static vitte_status_t vitte_driver_run_sema(
             if (status != VITTE_STATUS_OK) {
                 vitte_error_copy(&driver->last_error, vitte_sema_last_error(sema));
                 vitte_sema_destroy(sema);
-                free(sema);
+                vitte_driver_free(driver, VITTE_MEMORY_SEMA, sema);
                 return status;
             }
         }
@@ -826,161 +1256,535 @@ static vitte_status_t vitte_driver_run_sema(
     } else {
         vitte_error_reset(&driver->last_error);
     }
+    memset(&counts, 0, sizeof(counts));
+    counts.arena_bytes = vitte_driver_arena_bytes(&sema->types.arena);
+    vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_SEMANTIC, driver->config.paths.input_path, &start, &counts);
     vitte_sema_destroy(sema);
-    free(sema);
+    vitte_driver_free(driver, VITTE_MEMORY_SEMA, sema);
     return status;
 }
 
 static vitte_status_t vitte_driver_run_import_unit_sema(
-    vitte_driver_t *driver,
+    vitte_sema_t *sema,
+    vitte_diagnostic_bag_t *diagnostics,
+    vitte_error_t *error,
     const vitte_driver_import_unit_t *unit,
-    vitte_driver_import_unit_t *const *imported_units,
-    size_t imported_unit_count
+    const vitte_driver_unit_index_t *unit_index
 ) {
-    vitte_sema_t *sema = (vitte_sema_t *)calloc(1u, sizeof(*sema));
-    vitte_sema_options_t options;
     vitte_sema_result_t result;
     vitte_status_t status;
     size_t index;
 
-    if (driver == NULL || unit == NULL || imported_units == NULL || sema == NULL ||
+    if (sema == NULL || error == NULL || unit == NULL || unit_index == NULL ||
         !vitte_ast_is_initialized(&unit->ast) || unit->ast.root == NULL ||
-        !vitte_module_is_initialized(&unit->module)) {
-        free(sema);
+        !vitte_module_is_initialized(unit->module)) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
 
-    vitte_sema_options_init(&options);
-    options.max_depth = driver->config.limits.max_ast_depth;
-    options.enable_constant_folding = true;
+    vitte_sema_reset(sema, diagnostics);
     vitte_sema_result_init(&result);
-    status = vitte_sema_init(sema, &options, &driver->diagnostics);
-    if (status != VITTE_STATUS_OK) {
-        vitte_error_copy(&driver->last_error, vitte_sema_last_error(sema));
-        free(sema);
-        return status;
-    }
-
-    for (index = 0u; index < unit->module.import_count; index++) {
-        const vitte_module_import_t *dependency = &unit->module.imports[index];
+    for (index = 0u; index < unit->module->import_count; index++) {
+        const vitte_module_import_t *dependency = &unit->module->imports[index];
         const vitte_driver_import_unit_t *dependency_unit;
 
         if (!dependency->resolved || dependency->resolved_path[0] == '\0') {
             continue;
         }
-        dependency_unit = vitte_driver_find_import_unit_by_path(
-            imported_units,
-            imported_unit_count,
-            dependency->resolved_path
-        );
-        if (dependency_unit == NULL || !vitte_ast_is_initialized(&dependency_unit->ast) ||
-            dependency_unit->ast.root == NULL) {
-            vitte_driver_set_error(
-                driver,
+        dependency_unit = vitte_driver_find_import_unit_by_path(unit_index, dependency->resolved_path);
+        if (dependency_unit == NULL || !dependency_unit->exports.initialized) {
+            vitte_error_set_details(
+                error,
                 VITTE_STATUS_ERROR_INVALID_STATE,
                 "VITTE_DRIVER_E_IMPORT",
                 "missing imported dependency AST for semantic analysis",
                 dependency->resolved_path
             );
-            vitte_sema_destroy(sema);
-            free(sema);
             return VITTE_STATUS_ERROR_INVALID_STATE;
         }
-        status = vitte_sema_add_import_module(sema, dependency->module_name, &dependency_unit->ast);
+        status = vitte_sema_add_import_summary(sema, dependency->module_name, &dependency_unit->exports);
         if (status != VITTE_STATUS_OK) {
-            vitte_error_copy(&driver->last_error, vitte_sema_last_error(sema));
-            vitte_sema_destroy(sema);
-            free(sema);
+            vitte_error_copy(error, vitte_sema_last_error(sema));
             return status;
         }
     }
 
     status = vitte_sema_analyze(sema, &unit->ast, &result);
     if (status != VITTE_STATUS_OK) {
-        vitte_error_copy(&driver->last_error, &result.last_error);
+        vitte_error_copy(error, &result.last_error);
     } else {
-        vitte_error_reset(&driver->last_error);
+        vitte_error_reset(error);
     }
-    vitte_sema_destroy(sema);
-    free(sema);
     return status;
 }
 
-static vitte_status_t vitte_driver_run_import_graph_sema(
-    vitte_driver_t *driver,
-    vitte_driver_import_unit_t *const *imported_units,
-    size_t imported_unit_count
+/*
+ * Incremental analysis. A module's fingerprint covers its own cache key and
+ * the interface key of every module in its transitive import closure.
+ * Interface keys ignore procedure bodies, so a body-only edit re-analyses the
+ * edited module alone. Modules whose fingerprint matches the previous build's
+ * dependency graph, where they were analysed without diagnostics, skip
+ * semantic analysis.
+ */
+static void vitte_driver_graph_key(const char *root_path, vitte_cache_key_t *key) {
+    vitte_cache_key_init(key);
+    vitte_cache_key_add_text(key, "dependency-graph");
+    vitte_cache_key_add_text(key, root_path);
+}
+
+static void vitte_driver_push_import_units(
+    const vitte_module_t *module,
+    const vitte_driver_unit_index_t *unit_index,
+    size_t *marks,
+    size_t stamp,
+    size_t *stack,
+    size_t *stack_count
 ) {
     size_t index;
 
-    if (driver == NULL || imported_units == NULL) {
-        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
-    }
-    for (index = 0u; index < imported_unit_count; index++) {
-        if (imported_units[index] == NULL) {
+    for (index = 0u; index < module->import_count; index++) {
+        const vitte_module_import_t *dependency = &module->imports[index];
+        const vitte_driver_import_unit_t *unit;
+
+        if (!dependency->resolved || dependency->resolved_path[0] == '\0') {
             continue;
         }
-        if (vitte_driver_run_import_unit_sema(
-                driver,
-                imported_units[index],
-                imported_units,
-                imported_unit_count
-            ) != VITTE_STATUS_OK) {
-            return vitte_driver_last_error(driver)->status;
+        unit = vitte_driver_find_import_unit_by_path(unit_index, dependency->resolved_path);
+        if (unit != NULL && marks[unit->order] != stamp) {
+            marks[unit->order] = stamp;
+            stack[(*stack_count)++] = unit->order;
         }
     }
-    return VITTE_STATUS_OK;
 }
 
-static const char *vitte_driver_last_path_segment(const char *text) {
-    const char *last_dot;
+static void vitte_driver_module_fingerprint(
+    const vitte_driver_t *driver,
+    const vitte_module_t *module,
+    const vitte_cache_key_t *source_key,
+    vitte_driver_import_unit_t *const *units,
+    size_t unit_count,
+    const vitte_driver_unit_index_t *unit_index,
+    size_t *marks,
+    size_t stamp,
+    size_t *stack,
+    vitte_cache_key_t *fingerprint
+) {
+    size_t stack_count = 0u;
+    size_t index;
 
-    if (text == NULL) {
-        return NULL;
+    vitte_driver_push_import_units(module, unit_index, marks, stamp, stack, &stack_count);
+    while (stack_count > 0u) {
+        const vitte_driver_import_unit_t *unit = units[stack[--stack_count]];
+        vitte_driver_push_import_units(unit->module, unit_index, marks, stamp, stack, &stack_count);
+    }
+    vitte_cache_key_init(fingerprint);
+    vitte_cache_key_add_text(fingerprint, "sema");
+    vitte_cache_key_add_key(fingerprint, source_key);
+    vitte_cache_key_add_size(fingerprint, driver->config.limits.max_ast_depth);
+    /* Closure members are hashed in unit order, which is fixed by the import graph. */
+    for (index = 0u; index < unit_count; index++) {
+        if (marks[index] == stamp) {
+            vitte_cache_key_add_text(fingerprint, units[index]->resolved_path);
+            vitte_cache_key_add_key(fingerprint, &units[index]->interface_key);
+        }
     }
-    last_dot = strrchr(text, '.');
-    return last_dot != NULL ? last_dot + 1 : text;
 }
 
-static bool vitte_driver_copy_text(char *buffer, size_t capacity, const char *text) {
-    size_t length;
+static bool vitte_driver_graph_allows_reuse(
+    const vitte_cache_graph_t *graph,
+    const char *path,
+    const vitte_cache_key_t *fingerprint
+) {
+    const vitte_cache_graph_node_t *node = vitte_cache_graph_find(graph, path);
 
-    if (buffer == NULL || capacity == 0u || text == NULL) {
-        return false;
-    }
-    length = strlen(text);
-    if (length + 1u > capacity) {
-        return false;
-    }
-    (void)memcpy(buffer, text, length);
-    buffer[length] = '\0';
-    return true;
+    return node != NULL && !vitte_cache_key_is_zero(&node->fingerprint) &&
+        vitte_cache_key_equal(&node->fingerprint, fingerprint);
 }
 
-static char *vitte_driver_ast_join_name(
-    vitte_ast_t *ast,
-    const char *left,
-    const char *separator,
-    const char *right
+/*
+ * Computes interface keys and fingerprints for the root and every import unit
+ * and marks the units whose analysis can be reused. The previous graph is only
+ * needed for this decision and is released before returning.
+ */
+static vitte_status_t vitte_driver_prepare_incremental(
+    vitte_driver_t *driver,
+    const char *root_path,
+    const vitte_ast_t *root_ast,
+    const vitte_module_t *root_module,
+    const vitte_cache_key_t *root_source_key,
+    vitte_driver_import_unit_t *const *units,
+    size_t unit_count,
+    const vitte_driver_unit_index_t *unit_index,
+    vitte_cache_key_t *root_interface_key,
+    vitte_cache_key_t *root_fingerprint,
+    bool *root_reused
 ) {
-    size_t left_length;
-    size_t separator_length;
-    size_t right_length;
-    char *joined;
-
-    if (ast == NULL || left == NULL || separator == NULL || right == NULL) {
-        return NULL;
+    vitte_cache_graph_t previous;
+    vitte_cache_key_t graph_key;
+    size_t *marks;
+    size_t *stack;
+    size_t index;
+    bool hit = false;
+
+    *root_reused = false;
+    marks = (size_t *)calloc(unit_count + 1u, sizeof(*marks));
+    stack = (size_t *)malloc((unit_count + 1u) * sizeof(*stack));
+    if (marks == NULL || stack == NULL) {
+        free(marks);
+        free(stack);
+        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_CACHE", "failed to allocate dependency graph", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
     }
-    left_length = strlen(left);
-    separator_length = strlen(separator);
-    right_length = strlen(right);
-    joined = (char *)vitte_arena_alloc(ast->arena, left_length + separator_length + right_length + 1u, 1u);
-    if (joined == NULL) {
-        vitte_error_set_details(&ast->last_error, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_OOM", "failed to allocate joined import name", right);
-        return NULL;
+    for (index = 0u; index < unit_count; index++) {
+        units[index]->order = index;
+        vitte_cache_key_init(&units[index]->interface_key);
+        vitte_cache_key_add_interface(&units[index]->interface_key, units[index]->ast.root);
     }
-    (void)memcpy(joined, left, left_length);
-    (void)memcpy(joined + left_length, separator, separator_length);
+    vitte_cache_key_init(root_interface_key);
+    vitte_cache_key_add_interface(root_interface_key, root_ast->root);
+
+    vitte_cache_graph_init(&previous);
+    vitte_driver_graph_key(root_path, &graph_key);
+    (void)vitte_cache_load_graph(driver->module_cache, &graph_key, &previous, &hit);
+    for (index = 0u; index < unit_count; index++) {
+        vitte_driver_import_unit_t *unit = units[index];
+
+        vitte_driver_module_fingerprint(
+            driver,
+            unit->module,
+            &unit->source_key,
+            units,
+            unit_count,
+            unit_index,
+            marks,
+            index + 1u,
+            stack,
+            &unit->fingerprint
+        );
+        unit->sema_reused = hit && vitte_driver_graph_allows_reuse(&previous, unit->resolved_path, &unit->fingerprint);
+    }
+    vitte_driver_module_fingerprint(
+        driver,
+        root_module,
+        root_source_key,
+        units,
+        unit_count,
+        unit_index,
+        marks,
+        unit_count + 1u,
+        stack,
+        root_fingerprint
+    );
+    *root_reused = hit && vitte_driver_graph_allows_reuse(&previous, root_path, root_fingerprint);
+    vitte_cache_graph_destroy(&previous);
+    free(marks);
+    free(stack);
+    return VITTE_STATUS_OK;
+}
+
+static void vitte_driver_add_graph_edges(
+    vitte_cache_graph_t *graph,
+    size_t from,
+    const vitte_module_t *module,
+    const size_t *positions,
+    const vitte_driver_unit_index_t *unit_index
+) {
+    size_t index;
+
+    for (index = 0u; index < module->import_count; index++) {
+        const vitte_module_import_t *dependency = &module->imports[index];
+        const vitte_driver_import_unit_t *unit;
+
+        if (!dependency->resolved || dependency->resolved_path[0] == '\0') {
+            continue;
+        }
+        unit = vitte_driver_find_import_unit_by_path(unit_index, dependency->resolved_path);
+        if (unit != NULL && positions[unit->order] != SIZE_MAX) {
+            (void)vitte_cache_graph_add_edge(graph, from, positions[unit->order]);
+        }
+    }
+}
+
+/*
+ * Records this build's dependency graph. Modules that were not analysed, or
+ * whose analysis failed or reported diagnostics, get a zero fingerprint and
+ * are re-analysed next time. Failing to write the graph is not an error.
+ */
+static void vitte_driver_store_dependency_graph(
+    vitte_driver_t *driver,
+    const char *root_path,
+    const vitte_module_t *root_module,
+    const vitte_cache_key_t *root_interface_key,
+    const vitte_cache_key_t *root_fingerprint,
+    bool root_clean,
+    vitte_driver_import_unit_t *const *units,
+    size_t unit_count,
+    const vitte_driver_unit_index_t *unit_index
+) {
+    static const vitte_cache_key_t unverified = { 0u, 0u };
+    vitte_cache_graph_t graph;
+    vitte_cache_key_t graph_key;
+    vitte_error_t error;
+    size_t *positions;
+    size_t root_position = SIZE_MAX;
+    size_t index;
+
+    positions = (size_t *)malloc((unit_count + 1u) * sizeof(*positions));
+    if (positions == NULL) {
+        return;
+    }
+    vitte_cache_graph_init(&graph);
+    if (vitte_cache_graph_add_node(&graph, root_path, root_clean ? root_fingerprint : &unverified, root_interface_key, &root_position) != VITTE_STATUS_OK) {
+        root_position = SIZE_MAX;
+    }
+    for (index = 0u; index < unit_count; index++) {
+        const vitte_driver_import_unit_t *unit = units[index];
+        bool clean = unit->sema_reused || unit->sema_clean;
+
+        if (vitte_cache_graph_add_node(
+                &graph,
+                unit->resolved_path,
+                clean ? &unit->fingerprint : &unverified,
+                &unit->interface_key,
+                &positions[index]
+            ) != VITTE_STATUS_OK) {
+            positions[index] = SIZE_MAX;
+        }
+    }
+    if (root_position != SIZE_MAX) {
+        vitte_driver_add_graph_edges(&graph, root_position, root_module, positions, unit_index);
+    }
+    for (index = 0u; index < unit_count; index++) {
+        if (positions[index] != SIZE_MAX) {
+            vitte_driver_add_graph_edges(&graph, positions[index], units[index]->module, positions, unit_index);
+        }
+    }
+    vitte_error_init(&error);
+    vitte_driver_graph_key(root_path, &graph_key);
+    (void)vitte_cache_store_graph(driver->module_cache, &graph_key, &graph, &error);
+    vitte_cache_graph_destroy(&graph);
+    free(positions);
+}
+
+typedef struct vitte_driver_sema_worker {
+    vitte_sema_t sema;
+    vitte_diagnostic_bag_t *diagnostics;
+    vitte_diagnostic_bag_t owned_diagnostics;
+    vitte_error_t error;
+    size_t failed_unit;
+} vitte_driver_sema_worker_t;
+
+typedef struct vitte_driver_sema_pool {
+    const vitte_driver_t *driver;
+    vitte_driver_sema_worker_t *workers;
+    vitte_driver_import_unit_t *const *units;
+    const vitte_driver_unit_index_t *unit_index;
+} vitte_driver_sema_pool_t;
+
+static bool vitte_driver_sema_task(size_t index, size_t worker_index, void *user) {
+    vitte_driver_sema_pool_t *pool = (vitte_driver_sema_pool_t *)user;
+    vitte_driver_sema_worker_t *worker = &pool->workers[worker_index];
+    vitte_driver_import_unit_t *unit = pool->units[index];
+    vitte_trace_clock_t start;
+    vitte_trace_counts_t counts;
+    size_t diagnostic_count;
+    vitte_status_t status;
+
+    if (unit == NULL || unit->sema_reused) {
+        return true;
+    }
+    if (worker->diagnostics != NULL && worker->diagnostics->count > 0u) {
+        vitte_diagnostic_bag_reset(worker->diagnostics);
+    }
+    diagnostic_count = vitte_diagnostic_bag_total_count(worker->diagnostics);
+    vitte_trace_clock_now(&start);
+    status = vitte_driver_run_import_unit_sema(&worker->sema, worker->diagnostics, &worker->error, unit, pool->unit_index);
+    memset(&counts, 0, sizeof(counts));
+    counts.arena_bytes = vitte_driver_arena_bytes(&worker->sema.types.arena);
+    vitte_driver_profile_stage(pool->driver, VITTE_DRIVER_STAGE_SEMANTIC, unit->resolved_path, &start, &counts);
+    if (status != VITTE_STATUS_OK) {
+        worker->failed_unit = index;
+        return false;
+    }
+    unit->sema_clean = vitte_diagnostic_bag_total_count(worker->diagnostics) == diagnostic_count;
+    return true;
+}
+
+static void vitte_driver_destroy_sema_workers(
+    const vitte_driver_t *driver,
+    vitte_driver_sema_worker_t *workers,
+    size_t count
+) {
+    size_t index;
+
+    for (index = 0u; index < count; index++) {
+        vitte_sema_destroy(&workers[index].sema);
+        vitte_diagnostic_bag_destroy(&workers[index].owned_diagnostics);
+    }
+    vitte_driver_free(driver, VITTE_MEMORY_SEMA, workers);
+}
+
+/*
+ * Each import unit only reads the export summaries of its dependencies, so
+ * units are analyzed on `config.limits.jobs` workers. Every worker owns a sema
+ * workspace, reset between units, and (when running in parallel) a private
+ * diagnostic bag. Like the serial loop, the pass stops at the first failing
+ * unit in unit order, and only that unit's diagnostics and error reach the
+ * driver, so output does not depend on scheduling.
+ */
+static vitte_status_t vitte_driver_run_import_graph_sema(
+    vitte_driver_t *driver,
+    vitte_driver_import_unit_t *const *imported_units,
+    size_t imported_unit_count,
+    const vitte_driver_unit_index_t *unit_index
+) {
+    vitte_driver_sema_worker_t *workers;
+    vitte_driver_sema_pool_t pool;
+    vitte_sema_options_t options;
+    vitte_status_t status = VITTE_STATUS_OK;
+    size_t jobs;
+    size_t failed_unit = imported_unit_count;
+    size_t index;
+
+    if (driver == NULL || imported_units == NULL || unit_index == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    for (index = 0u; index < imported_unit_count; index++) {
+        vitte_driver_import_unit_t *unit = imported_units[index];
+
+        if (unit == NULL || unit->exports.initialized || !vitte_ast_is_initialized(&unit->ast)) {
+            continue;
+        }
+        status = vitte_sema_export_summary_build(&unit->exports, &unit->ast);
+        if (status != VITTE_STATUS_OK) {
+            vitte_driver_set_error(driver, status, "VITTE_DRIVER_E_IMPORT", "failed to summarize imported module exports", unit->resolved_path);
+            return status;
+        }
+    }
+    if (imported_unit_count == 0u) {
+        return VITTE_STATUS_OK;
+    }
+
+    jobs = driver->config.limits.jobs < imported_unit_count ? driver->config.limits.jobs : imported_unit_count;
+    if (jobs == 0u) {
+        jobs = 1u;
+    }
+    workers = (vitte_driver_sema_worker_t *)vitte_driver_calloc(driver, VITTE_MEMORY_SEMA, jobs, sizeof(*workers));
+    if (workers == NULL) {
+        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_SEMA", "failed to allocate semantic workspace", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    vitte_sema_options_init(&options);
+    options.max_depth = driver->config.limits.max_ast_depth;
+    options.enable_constant_folding = true;
+    vitte_driver_allocator(driver, VITTE_MEMORY_SEMA, &options.allocator);
+    for (index = 0u; index < jobs; index++) {
+        vitte_driver_sema_worker_t *worker = &workers[index];
+
+        vitte_error_init(&worker->error);
+        worker->failed_unit = imported_unit_count;
+        if (jobs == 1u) {
+            worker->diagnostics = &driver->diagnostics;
+        } else {
+            status = vitte_diagnostic_bag_init(&worker->owned_diagnostics, &driver->diagnostics.allocator, &driver->diagnostics.options);
+            if (status != VITTE_STATUS_OK) {
+                vitte_driver_set_error(driver, status, "VITTE_DRIVER_E_DIAGNOSTIC", "failed to initialize worker diagnostics", NULL);
+                vitte_driver_destroy_sema_workers(driver, workers, jobs);
+                return status;
+            }
+            worker->diagnostics = &worker->owned_diagnostics;
+        }
+        status = vitte_sema_init(&worker->sema, &options, worker->diagnostics);
+        if (status != VITTE_STATUS_OK) {
+            vitte_error_copy(&driver->last_error, vitte_sema_last_error(&worker->sema));
+            vitte_driver_destroy_sema_workers(driver, workers, jobs);
+            return status;
+        }
+    }
+
+    pool.driver = driver;
+    pool.workers = workers;
+    pool.units = imported_units;
+    pool.unit_index = unit_index;
+    (void)vitte_parallel_for(imported_unit_count, jobs, vitte_driver_sema_task, &pool, &failed_unit);
+    for (index = 0u; index < imported_unit_count && index <= failed_unit; index++) {
+        if (imported_units[index]->sema_reused) {
+            driver->reused_module_count++;
+        } else {
+            driver->analyzed_module_count++;
+        }
+    }
+
+    if (failed_unit < imported_unit_count) {
+        const vitte_driver_sema_worker_t *failed = NULL;
+
+        for (index = 0u; index < jobs && failed == NULL; index++) {
+            if (workers[index].failed_unit == failed_unit) {
+                failed = &workers[index];
+            }
+        }
+        /* Workers stop after their first failure, so the bag still holds the
+         * diagnostics of the failing unit. */
+        status = failed->error.status;
+        vitte_error_copy(&driver->last_error, &failed->error);
+        if (failed->diagnostics != &driver->diagnostics) {
+            (void)vitte_diagnostic_merge(&driver->diagnostics, failed->diagnostics);
+        }
+    } else {
+        vitte_error_reset(&driver->last_error);
+    }
+    vitte_driver_destroy_sema_workers(driver, workers, jobs);
+    return status;
+}
+
+static const char *vitte_driver_last_path_segment(const char *text) {
+    const char *last_dot;
+
+    if (text == NULL) {
+        return NULL;
+    }
+    last_dot = strrchr(text, '.');
+    return last_dot != NULL ? last_dot + 1 : text;
+}
+
+static bool vitte_driver_copy_text(char *buffer, size_t capacity, const char *text) {
+    size_t length;
+
+    if (buffer == NULL || capacity == 0u || text == NULL) {
+        return false;
+    }
+    length = strlen(text);
+    if (length + 1u > capacity) {
+        return false;
+    }
+    (void)memcpy(buffer, text, length);
+    buffer[length] = '\0';
+    return true;
+}
+
+static char *vitte_driver_ast_join_name(
+    vitte_ast_t *ast,
+    const char *left,
+    const char *separator,
+    const char *right
+) {
+    size_t left_length;
+    size_t separator_length;
+    size_t right_length;
+    char *joined;
+
+    if (ast == NULL || left == NULL || separator == NULL || right == NULL) {
+        return NULL;
+    }
+    left_length = strlen(left);
+    separator_length = strlen(separator);
+    right_length = strlen(right);
+    joined = (char *)vitte_arena_alloc(ast->arena, left_length + separator_length + right_length + 1u, 1u);
+    if (joined == NULL) {
+        vitte_error_set_details(&ast->last_error, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_OOM", "failed to allocate joined import name", right);
+        return NULL;
+    }
+    (void)memcpy(joined, left, left_length);
+    (void)memcpy(joined + left_length, separator, separator_length);
     (void)memcpy(joined + left_length + separator_length, right, right_length);
     joined[left_length + separator_length + right_length] = '\0';
     return joined;
@@ -1028,22 +1832,61 @@ static const vitte_module_import_t *vitte_driver_find_failed_module_import(
     return NULL;
 }
 
-static const vitte_driver_import_unit_t *vitte_driver_find_import_unit_by_module(
-    vitte_driver_import_unit_t *const *units,
-    size_t unit_count,
-    const char *module_name
+static size_t vitte_driver_hash_path(const char *text) {
+    return (size_t)vitte_util_hash_text(VITTE_UTIL_HASH_SEED, text);
+}
+
+/* Returns the slot holding the unit keyed by `key`, or the empty slot where it would go. */
+static size_t vitte_driver_unit_index_position(
+    const vitte_driver_import_unit_t *const *slots,
+    const char *key,
+    bool by_path
 ) {
-    size_t index;
+    size_t mask = VITTE_DRIVER_MAX_IMPORTED_UNITS * 2u - 1u;
+    size_t position = vitte_driver_hash_path(key) & mask;
 
-    if (units == NULL || module_name == NULL || module_name[0] == '\0') {
-        return NULL;
+    while (slots[position] != NULL &&
+           strcmp(by_path ? slots[position]->resolved_path : slots[position]->module_name, key) != 0) {
+        position = (position + 1u) & mask;
     }
-    for (index = 0u; index < unit_count; index++) {
-        if (units[index] != NULL && strcmp(units[index]->module_name, module_name) == 0) {
-            return units[index];
+    return position;
+}
+
+static void vitte_driver_unit_index_add(vitte_driver_unit_index_t *unit_index, const vitte_driver_import_unit_t *unit) {
+    size_t position;
+
+    if (unit->resolved_path[0] != '\0') {
+        position = vitte_driver_unit_index_position(unit_index->by_path, unit->resolved_path, true);
+        if (unit_index->by_path[position] == NULL) {
+            unit_index->by_path[position] = unit;
+        }
+    }
+    if (unit->module_name[0] != '\0') {
+        position = vitte_driver_unit_index_position(unit_index->by_module, unit->module_name, false);
+        if (unit_index->by_module[position] == NULL) {
+            unit_index->by_module[position] = unit;
         }
     }
-    return NULL;
+}
+
+static const vitte_driver_import_unit_t *vitte_driver_find_import_unit_by_path(
+    const vitte_driver_unit_index_t *unit_index,
+    const char *resolved_path
+) {
+    if (unit_index == NULL || resolved_path == NULL || resolved_path[0] == '\0') {
+        return NULL;
+    }
+    return unit_index->by_path[vitte_driver_unit_index_position(unit_index->by_path, resolved_path, true)];
+}
+
+static const vitte_driver_import_unit_t *vitte_driver_find_import_unit_by_module(
+    const vitte_driver_unit_index_t *unit_index,
+    const char *module_name
+) {
+    if (unit_index == NULL || module_name == NULL || module_name[0] == '\0') {
+        return NULL;
+    }
+    return unit_index->by_module[vitte_driver_unit_index_position(unit_index->by_module, module_name, false)];
 }
 
 static bool vitte_driver_maybe_set_ambiguous_use_path_error(
@@ -1054,7 +1897,7 @@ static bool vitte_driver_maybe_set_ambiguous_use_path_error(
     const vitte_module_import_t *failed_import;
     vitte_import_request_t request;
     vitte_import_result_t result;
-    vitte_driver_import_unit_t imported_unit;
+    vitte_driver_import_unit_t *imported_unit = NULL;
     const vitte_ast_decl_t *exported_decl;
     const char *leaf_name = NULL;
     char owner_name[VITTE_IMPORT_MAX_MODULE_NAME];
@@ -1075,7 +1918,6 @@ static bool vitte_driver_maybe_set_ambiguous_use_path_error(
         return false;
     }
 
-    memset(&imported_unit, 0, sizeof(imported_unit));
     vitte_import_request_init(&request);
     request.module_name = owner_name;
     request.importer_path = module->source_path[0] != '\0' ? module->source_path : NULL;
@@ -1087,11 +1929,15 @@ static bool vitte_driver_maybe_set_ambiguous_use_path_error(
     if (status != VITTE_STATUS_OK) {
         goto cleanup;
     }
-    status = vitte_driver_parse_imported_unit(driver, owner_name, result.resolved_path.text, &imported_unit);
-    if (status != VITTE_STATUS_OK || !vitte_ast_is_initialized(&imported_unit.ast) || imported_unit.ast.root == NULL) {
+    imported_unit = vitte_driver_create_import_unit(driver);
+    if (imported_unit == NULL) {
+        goto cleanup;
+    }
+    status = vitte_driver_parse_imported_unit(driver, owner_name, result.resolved_path.text, imported_unit);
+    if (status != VITTE_STATUS_OK || !vitte_ast_is_initialized(&imported_unit->ast) || imported_unit->ast.root == NULL) {
         goto cleanup;
     }
-    exported_decl = vitte_ast_module_find_exported_decl(imported_unit.ast.root, leaf_name);
+    exported_decl = vitte_ast_module_find_exported_decl(imported_unit->ast.root, leaf_name);
     if (exported_decl == NULL) {
         goto cleanup;
     }
@@ -1121,12 +1967,7 @@ static bool vitte_driver_maybe_set_ambiguous_use_path_error(
 
 cleanup:
     vitte_import_result_destroy(&result);
-    if (vitte_module_is_initialized(&imported_unit.module)) {
-        vitte_module_destroy(&imported_unit.module);
-    }
-    if (vitte_ast_is_initialized(&imported_unit.ast)) {
-        vitte_ast_destroy(&imported_unit.ast);
-    }
+    vitte_driver_destroy_import_unit(imported_unit);
     return matched;
 }
 
@@ -1218,25 +2059,117 @@ static vitte_ast_decl_t *vitte_driver_clone_decl_shallow(
     return NULL;
 }
 
-static const vitte_driver_flatten_binding_t *vitte_driver_flatten_find_visible_binding(
-    const vitte_driver_flatten_state_t *state,
+/* The 0xff terminator keeps ("ab", "c") and ("a", "bc") apart. */
+static size_t vitte_driver_flatten_visible_hash(const char *source_module_name, const char *visible_name) {
+    uint64_t hash = vitte_util_hash_text(VITTE_UTIL_HASH_SEED, source_module_name);
+
+    hash = vitte_util_hash_value(hash, 0xffu);
+    return (size_t)vitte_util_hash_value(vitte_util_hash_text(hash, visible_name), 0xffu);
+}
+
+static size_t vitte_driver_flatten_decl_hash(const char *owner_module_name, const vitte_ast_decl_t *source_decl) {
+    uint64_t hash = vitte_util_hash_value(vitte_util_hash_text(VITTE_UTIL_HASH_SEED, owner_module_name), 0xffu);
+
+    hash = vitte_util_hash_value(hash, (uint64_t)(uintptr_t)source_decl);
+    return (size_t)(hash ^ (hash >> 29));
+}
+
+static size_t vitte_driver_flatten_visible_position(
+    vitte_driver_flatten_binding_t *const *slots,
+    size_t capacity,
     const char *source_module_name,
     const char *visible_name
 ) {
-    const vitte_driver_flatten_binding_t *binding;
+    size_t mask = capacity - 1u;
+    size_t position = vitte_driver_flatten_visible_hash(source_module_name, visible_name) & mask;
 
-    if (state == NULL || source_module_name == NULL || visible_name == NULL) {
-        return NULL;
+    while (slots[position] != NULL &&
+           !((slots[position]->visible_name == visible_name || strcmp(slots[position]->visible_name, visible_name) == 0) &&
+             strcmp(slots[position]->source_module_name, source_module_name) == 0)) {
+        position = (position + 1u) & mask;
+    }
+    return position;
+}
+
+static size_t vitte_driver_flatten_decl_position(
+    vitte_driver_flatten_binding_t *const *slots,
+    size_t capacity,
+    const char *owner_module_name,
+    const vitte_ast_decl_t *source_decl
+) {
+    size_t mask = capacity - 1u;
+    size_t position = vitte_driver_flatten_decl_hash(owner_module_name, source_decl) & mask;
+
+    while (slots[position] != NULL &&
+           !(slots[position]->source_decl == source_decl &&
+             strcmp(slots[position]->owner_module_name, owner_module_name) == 0)) {
+        position = (position + 1u) & mask;
+    }
+    return position;
+}
+
+/*
+ * The decl table keeps the newest binding for a key, matching a walk of the
+ * newest-first list: new bindings replace an existing entry, rehashing walks
+ * the list and keeps the first one it sees.
+ */
+static void vitte_driver_flatten_index_binding(
+    vitte_driver_flatten_binding_t **visible_slots,
+    vitte_driver_flatten_binding_t **decl_slots,
+    size_t capacity,
+    vitte_driver_flatten_binding_t *binding,
+    bool newest
+) {
+    size_t position = vitte_driver_flatten_visible_position(
+        visible_slots, capacity, binding->source_module_name, binding->visible_name
+    );
+
+    if (visible_slots[position] == NULL) {
+        visible_slots[position] = binding;
+    }
+    position = vitte_driver_flatten_decl_position(decl_slots, capacity, binding->owner_module_name, binding->source_decl);
+    if (newest || decl_slots[position] == NULL) {
+        decl_slots[position] = binding;
+    }
+}
+
+static bool vitte_driver_flatten_reserve(vitte_ast_t *ast, vitte_driver_flatten_state_t *state) {
+    vitte_driver_flatten_binding_t **slots;
+    vitte_driver_flatten_binding_t *binding;
+    size_t capacity;
+
+    if ((state->binding_count + 1u) * 2u <= state->slot_capacity) {
+        return true;
+    }
+    capacity = state->slot_capacity == 0u ? 256u : state->slot_capacity * 2u;
+    slots = (vitte_driver_flatten_binding_t **)vitte_arena_alloc_zeroed(
+        ast->arena,
+        capacity * 2u * sizeof(*slots),
+        _Alignof(vitte_driver_flatten_binding_t *)
+    );
+    if (slots == NULL) {
+        return false;
     }
     for (binding = state->bindings; binding != NULL; binding = binding->next) {
-        if (binding->source_module_name != NULL &&
-            binding->visible_name != NULL &&
-            strcmp(binding->source_module_name, source_module_name) == 0 &&
-            strcmp(binding->visible_name, visible_name) == 0) {
-            return binding;
-        }
+        vitte_driver_flatten_index_binding(slots, slots + capacity, capacity, binding, false);
     }
-    return NULL;
+    state->visible_slots = slots;
+    state->decl_slots = slots + capacity;
+    state->slot_capacity = capacity;
+    return true;
+}
+
+static const vitte_driver_flatten_binding_t *vitte_driver_flatten_find_visible_binding(
+    const vitte_driver_flatten_state_t *state,
+    const char *source_module_name,
+    const char *visible_name
+) {
+    if (state == NULL || source_module_name == NULL || visible_name == NULL || state->slot_capacity == 0u) {
+        return NULL;
+    }
+    return state->visible_slots[vitte_driver_flatten_visible_position(
+        state->visible_slots, state->slot_capacity, source_module_name, visible_name
+    )];
 }
 
 static const vitte_driver_flatten_binding_t *vitte_driver_flatten_find_decl_binding(
@@ -1244,19 +2177,12 @@ static const vitte_driver_flatten_binding_t *vitte_driver_flatten_find_decl_bind
     const char *owner_module_name,
     const vitte_ast_decl_t *source_decl
 ) {
-    const vitte_driver_flatten_binding_t *binding;
-
-    if (state == NULL || owner_module_name == NULL || source_decl == NULL) {
+    if (state == NULL || owner_module_name == NULL || source_decl == NULL || state->slot_capacity == 0u) {
         return NULL;
     }
-    for (binding = state->bindings; binding != NULL; binding = binding->next) {
-        if (binding->owner_module_name != NULL &&
-            binding->source_decl == source_decl &&
-            strcmp(binding->owner_module_name, owner_module_name) == 0) {
-            return binding;
-        }
-    }
-    return NULL;
+    return state->decl_slots[vitte_driver_flatten_decl_position(
+        state->decl_slots, state->slot_capacity, owner_module_name, source_decl
+    )];
 }
 
 static char *vitte_driver_make_lowered_symbol_name(
@@ -1350,11 +2276,11 @@ static vitte_status_t vitte_driver_flatten_register_visible_binding(
         return VITTE_STATUS_ERROR_INVALID_STATE;
     }
 
-    binding = (vitte_driver_flatten_binding_t *)vitte_arena_alloc_zeroed(
+    binding = vitte_driver_flatten_reserve(ast, state) ? (vitte_driver_flatten_binding_t *)vitte_arena_alloc_zeroed(
         ast->arena,
         sizeof(*binding),
         _Alignof(vitte_driver_flatten_binding_t)
-    );
+    ) : NULL;
     if (binding == NULL) {
         vitte_error_set_details(
             &ast->last_error,
@@ -1373,6 +2299,8 @@ static vitte_status_t vitte_driver_flatten_register_visible_binding(
     binding->clone_decl = clone_decl;
     binding->next = state->bindings;
     state->bindings = binding;
+    state->binding_count++;
+    vitte_driver_flatten_index_binding(state->visible_slots, state->decl_slots, state->slot_capacity, binding, true);
     return VITTE_STATUS_OK;
 }
 
@@ -1651,34 +2579,58 @@ static vitte_status_t vitte_driver_register_target_exports(
     return context.status;
 }
 
-static const vitte_module_import_t *vitte_driver_find_module_import(
-    const vitte_module_t *module,
-    const char *module_name
-) {
-    size_t index;
 
-    if (module == NULL || module_name == NULL) {
+/* Import units and their module records are charged to "modules". */
+static vitte_driver_import_unit_t *vitte_driver_create_import_unit(const vitte_driver_t *driver) {
+    vitte_allocator_t allocator;
+    vitte_driver_import_unit_t *unit;
+
+    vitte_driver_allocator(driver, VITTE_MEMORY_MODULES, &allocator);
+    unit = (vitte_driver_import_unit_t *)allocator.alloc(allocator.user, sizeof(*unit));
+    if (unit == NULL) {
         return NULL;
     }
-    for (index = 0u; index < module->import_count; index++) {
-        if (strcmp(module->imports[index].module_name, module_name) == 0) {
-            return &module->imports[index];
-        }
+    memset(unit, 0, sizeof(*unit));
+    unit->allocator = allocator;
+    unit->module = (vitte_module_t *)allocator.alloc(allocator.user, sizeof(*unit->module));
+    if (unit->module == NULL) {
+        allocator.free(allocator.user, unit);
+        return NULL;
     }
-    return NULL;
+    memset(unit->module, 0, sizeof(*unit->module));
+    return unit;
 }
 
-static void vitte_driver_destroy_import_unit(vitte_driver_import_unit_t *unit) {
+/*
+ * Frees what only the front end reads: the module record (with its import
+ * table) and the export summary. The AST stays for lowering.
+ */
+static void vitte_driver_release_unit_module(vitte_driver_import_unit_t *unit) {
     if (unit == NULL) {
         return;
     }
-    if (vitte_module_is_initialized(&unit->module)) {
-        vitte_module_destroy(&unit->module);
+    vitte_sema_export_summary_destroy(&unit->exports);
+    if (unit->module != NULL) {
+        if (vitte_module_is_initialized(unit->module)) {
+            vitte_module_destroy(unit->module);
+        }
+        unit->allocator.free(unit->allocator.user, unit->module);
+        unit->module = NULL;
     }
+}
+
+static void vitte_driver_destroy_import_unit(vitte_driver_import_unit_t *unit) {
+    vitte_allocator_t allocator;
+
+    if (unit == NULL) {
+        return;
+    }
+    vitte_driver_release_unit_module(unit);
     if (vitte_ast_is_initialized(&unit->ast)) {
         vitte_ast_destroy(&unit->ast);
     }
-    free(unit);
+    allocator = unit->allocator;
+    allocator.free(allocator.user, unit);
 }
 
 static void vitte_driver_destroy_import_units(
@@ -1697,84 +2649,342 @@ static void vitte_driver_destroy_import_units(
     *count = 0u;
 }
 
-static const vitte_driver_import_unit_t *vitte_driver_find_import_unit_by_path(
-    vitte_driver_import_unit_t *const *units,
-    size_t unit_count,
-    const char *resolved_path
-) {
-    size_t index;
-
-    if (units == NULL || resolved_path == NULL || resolved_path[0] == '\0') {
-        return NULL;
-    }
-    for (index = 0u; index < unit_count; index++) {
-        if (units[index] != NULL &&
-            units[index]->resolved_path[0] != '\0' &&
-            strcmp(units[index]->resolved_path, resolved_path) == 0) {
-            return units[index];
-        }
-    }
-    return NULL;
-}
 
-static vitte_status_t vitte_driver_parse_imported_unit(
-    vitte_driver_t *driver,
+static vitte_status_t vitte_driver_parse_unit_file(
+    const vitte_driver_t *driver,
     const char *module_name,
     const char *path,
-    vitte_driver_import_unit_t *unit
+    vitte_driver_import_unit_t *unit,
+    vitte_diagnostic_bag_t *diagnostics,
+    vitte_error_t *error
 ) {
     vitte_driver_input_t input;
+    vitte_arena_config_t arena_config;
+    vitte_trace_clock_t unit_start;
     vitte_status_t status;
 
-    if (driver == NULL || module_name == NULL || path == NULL || unit == NULL) {
+    if (driver == NULL || module_name == NULL || path == NULL || unit == NULL || error == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
     if (!vitte_driver_copy_text(unit->module_name, sizeof(unit->module_name), module_name) ||
         !vitte_driver_copy_text(unit->resolved_path, sizeof(unit->resolved_path), path)) {
-        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_DRIVER_E_IMPORT", "import metadata is too long", path);
+        vitte_error_set_details(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_DRIVER_E_IMPORT", "import metadata is too long", path);
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
 
     vitte_driver_input_init(&input);
-    status = vitte_driver_input_from_file(&input, path, driver->config.limits.max_source_bytes);
+    status = vitte_driver_load_unit_source(driver, path, &input, &unit_start);
     if (status != VITTE_STATUS_OK) {
-        vitte_driver_set_error(driver, status, "VITTE_DRIVER_E_IMPORT", "failed to read imported module", path);
+        vitte_error_set_details(error, status, "VITTE_DRIVER_E_IMPORT", "failed to read imported module", path);
         return status;
     }
-    status = vitte_ast_init_owned(&unit->ast, NULL);
+    vitte_driver_arena_config(driver, VITTE_MEMORY_AST, &arena_config);
+    status = vitte_ast_init_owned(&unit->ast, &arena_config);
     if (status != VITTE_STATUS_OK) {
-        vitte_driver_input_destroy(&input);
+        vitte_driver_release_unit_source(driver, &input);
         return status;
     }
-    status = vitte_driver_parse_ast(driver, &input, &unit->ast, &unit->module);
+    status = vitte_driver_parse_module_ast(driver, &input, &unit->ast, unit->module, diagnostics, error, &unit->source_key);
     if (status == VITTE_STATUS_OK) {
-        status = vitte_ast_validate(&unit->ast);
+        status = vitte_driver_validate_unit_ast(driver, path, &unit->ast);
         if (status != VITTE_STATUS_OK) {
-            vitte_error_copy(&driver->last_error, vitte_ast_last_error(&unit->ast));
+            vitte_error_copy(error, vitte_ast_last_error(&unit->ast));
         }
     }
-    vitte_driver_input_destroy(&input);
+    vitte_driver_trace_unit(driver, "parse", path, &unit_start, input.size);
+    vitte_driver_release_unit_source(driver, &input);
     return status;
 }
 
+static vitte_status_t vitte_driver_parse_imported_unit(
+    vitte_driver_t *driver,
+    const char *module_name,
+    const char *path,
+    vitte_driver_import_unit_t *unit
+) {
+    if (driver == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    return vitte_driver_parse_unit_file(driver, module_name, path, unit, &driver->diagnostics, &driver->last_error);
+}
+
+/*
+ * With more than one job, the import closure is parsed ahead of the
+ * depth-first collection: units are discovered breadth-first, each wave is
+ * lexed and parsed on the worker pool, and the main thread resolves the
+ * wave's imports to find the next one. Every prefetched unit keeps its own
+ * diagnostics and error, and the collection walk adopts units in its usual
+ * order, replaying them, so unit order and reports match the serial path.
+ */
+typedef struct vitte_driver_prefetched_unit {
+    char *resolved_path;
+    vitte_driver_import_unit_t *unit;
+    vitte_status_t status;
+    vitte_error_t error;
+    vitte_diagnostic_bag_t diagnostics;
+} vitte_driver_prefetched_unit_t;
+
+typedef struct vitte_driver_import_prefetch {
+    vitte_driver_prefetched_unit_t *items;
+    size_t count;
+    size_t slots[VITTE_DRIVER_MAX_IMPORTED_UNITS * 2u];
+} vitte_driver_import_prefetch_t;
+
+typedef struct vitte_driver_parse_worker {
+    vitte_diagnostic_bag_t diagnostics;
+} vitte_driver_parse_worker_t;
+
+typedef struct vitte_driver_parse_wave {
+    const vitte_driver_t *driver;
+    vitte_driver_prefetched_unit_t *items;
+    vitte_driver_parse_worker_t *workers;
+} vitte_driver_parse_wave_t;
+
+
+/* Slots hold item index + 1; zero marks an empty slot. */
+static size_t *vitte_driver_prefetch_slot(vitte_driver_import_prefetch_t *prefetch, const char *resolved_path) {
+    size_t mask = VITTE_DRIVER_MAX_IMPORTED_UNITS * 2u - 1u;
+    size_t position = vitte_driver_hash_path(resolved_path) & mask;
+
+    while (prefetch->slots[position] != 0u &&
+           strcmp(prefetch->items[prefetch->slots[position] - 1u].resolved_path, resolved_path) != 0) {
+        position = (position + 1u) & mask;
+    }
+    return &prefetch->slots[position];
+}
+
+static void vitte_driver_prefetch_add(
+    const vitte_driver_t *driver,
+    vitte_driver_import_prefetch_t *prefetch,
+    const char *module_name,
+    const char *resolved_path
+) {
+    vitte_driver_prefetched_unit_t *item;
+    vitte_driver_import_unit_t *unit;
+    size_t *slot;
+
+    if (prefetch->count >= VITTE_DRIVER_MAX_IMPORTED_UNITS || resolved_path[0] == '\0') {
+        return;
+    }
+    slot = vitte_driver_prefetch_slot(prefetch, resolved_path);
+    if (*slot != 0u) {
+        return;
+    }
+    unit = vitte_driver_create_import_unit(driver);
+    if (unit == NULL) {
+        return;
+    }
+    if (!vitte_driver_copy_text(unit->module_name, sizeof(unit->module_name), module_name) ||
+        !vitte_driver_copy_text(unit->resolved_path, sizeof(unit->resolved_path), resolved_path)) {
+        /* Left to the collection walk, which reports the error in order. */
+        vitte_driver_destroy_import_unit(unit);
+        return;
+    }
+    item = &prefetch->items[prefetch->count];
+    memset(item, 0, sizeof(*item));
+    item->resolved_path = (char *)malloc(strlen(resolved_path) + 1u);
+    if (item->resolved_path == NULL) {
+        vitte_driver_destroy_import_unit(unit);
+        return;
+    }
+    (void)memcpy(item->resolved_path, resolved_path, strlen(resolved_path) + 1u);
+    item->unit = unit;
+    prefetch->count++;
+    *slot = prefetch->count;
+}
+
+static bool vitte_driver_parse_wave_task(size_t index, size_t worker_index, void *user) {
+    vitte_driver_parse_wave_t *wave = (vitte_driver_parse_wave_t *)user;
+    vitte_driver_prefetched_unit_t *item = &wave->items[index];
+    vitte_driver_parse_worker_t *worker = &wave->workers[worker_index];
+    size_t reported;
+
+    if (worker->diagnostics.count > 0u || worker->diagnostics.counts.suppressed_count > 0u) {
+        vitte_diagnostic_bag_reset(&worker->diagnostics);
+    }
+    vitte_error_init(&item->error);
+    item->status = vitte_driver_parse_unit_file(
+        wave->driver,
+        item->unit->module_name,
+        item->unit->resolved_path,
+        item->unit,
+        &worker->diagnostics,
+        &item->error
+    );
+    reported = worker->diagnostics.count;
+    if (reported > 0u || worker->diagnostics.counts.suppressed_count > 0u) {
+        if (vitte_diagnostic_bag_init(&item->diagnostics, &worker->diagnostics.allocator, &worker->diagnostics.options) != VITTE_STATUS_OK ||
+            vitte_diagnostic_merge(&item->diagnostics, &worker->diagnostics) != VITTE_STATUS_OK) {
+            vitte_diagnostic_bag_destroy(&item->diagnostics);
+            item->status = VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+            vitte_error_set_details(&item->error, item->status, "VITTE_DRIVER_E_IMPORT", "failed to keep imported module diagnostics", item->unit->resolved_path);
+        }
+    }
+    return true;
+}
+
+static void vitte_driver_destroy_import_prefetch(vitte_driver_import_prefetch_t *prefetch) {
+    size_t index;
+
+    if (prefetch == NULL) {
+        return;
+    }
+    for (index = 0u; index < prefetch->count; index++) {
+        if (prefetch->items[index].unit != NULL) {
+            vitte_driver_destroy_import_unit(prefetch->items[index].unit);
+        }
+        vitte_diagnostic_bag_destroy(&prefetch->items[index].diagnostics);
+        free(prefetch->items[index].resolved_path);
+    }
+    free(prefetch->items);
+    memset(prefetch, 0, sizeof(*prefetch));
+}
+
+/*
+ * Fills `prefetch` with the parsed import closure of `module`. Failures are
+ * not reported here: they stay with their unit until the collection walk
+ * reaches it, and anything that could not be prefetched is parsed serially.
+ */
+static void vitte_driver_prefetch_import_closure(
+    vitte_driver_t *driver,
+    vitte_import_resolver_t *resolver,
+    const vitte_module_t *module,
+    vitte_driver_import_prefetch_t *prefetch
+) {
+    vitte_driver_parse_worker_t *workers;
+    vitte_driver_parse_wave_t wave;
+    size_t jobs = driver->config.limits.jobs;
+    size_t wave_start = 0u;
+    size_t index;
+    bool ready = true;
+
+    memset(prefetch, 0, sizeof(*prefetch));
+    if (jobs <= 1u || module->import_count == 0u ||
+        vitte_interner_enable_locking(vitte_context_interner(driver->context)) != VITTE_STATUS_OK) {
+        return;
+    }
+    prefetch->items = (vitte_driver_prefetched_unit_t *)calloc(VITTE_DRIVER_MAX_IMPORTED_UNITS, sizeof(*prefetch->items));
+    workers = (vitte_driver_parse_worker_t *)calloc(jobs, sizeof(*workers));
+    if (prefetch->items == NULL || workers == NULL) {
+        free(prefetch->items);
+        free(workers);
+        prefetch->items = NULL;
+        return;
+    }
+    for (index = 0u; index < jobs && ready; index++) {
+        ready = vitte_diagnostic_bag_init(&workers[index].diagnostics, &driver->diagnostics.allocator, &driver->diagnostics.options) == VITTE_STATUS_OK;
+    }
+    if (!ready) {
+        for (index = 0u; index < jobs; index++) {
+            vitte_diagnostic_bag_destroy(&workers[index].diagnostics);
+        }
+        free(workers);
+        free(prefetch->items);
+        prefetch->items = NULL;
+        return;
+    }
+
+    for (index = 0u; index < module->import_count; index++) {
+        if (module->imports[index].resolved) {
+            vitte_driver_prefetch_add(driver, prefetch, module->imports[index].module_name, module->imports[index].resolved_path);
+        }
+    }
+    wave.driver = driver;
+    wave.workers = workers;
+    while (wave_start < prefetch->count) {
+        size_t wave_end = prefetch->count;
+
+        wave.items = &prefetch->items[wave_start];
+        (void)vitte_parallel_for(wave_end - wave_start, jobs, vitte_driver_parse_wave_task, &wave, NULL);
+        for (index = wave_start; index < wave_end; index++) {
+            vitte_module_t *unit_module = prefetch->items[index].unit->module;
+            size_t import_index;
+
+            if (prefetch->items[index].status != VITTE_STATUS_OK || unit_module->import_count == 0u ||
+                vitte_module_resolve_imports(unit_module, resolver) != VITTE_STATUS_OK) {
+                continue;
+            }
+            for (import_index = 0u; import_index < unit_module->import_count; import_index++) {
+                if (unit_module->imports[import_index].resolved) {
+                    vitte_driver_prefetch_add(
+                        driver,
+                        prefetch,
+                        unit_module->imports[import_index].module_name,
+                        unit_module->imports[import_index].resolved_path
+                    );
+                }
+            }
+        }
+        wave_start = wave_end;
+    }
+
+    for (index = 0u; index < jobs; index++) {
+        vitte_diagnostic_bag_destroy(&workers[index].diagnostics);
+    }
+    free(workers);
+}
+
+/*
+ * Hands the prefetched unit for `resolved_path` to the collection walk,
+ * replaying its diagnostics and, if parsing failed, its error. `*out` stays
+ * NULL when the unit was not prefetched.
+ */
+static vitte_status_t vitte_driver_take_prefetched_unit(
+    vitte_driver_t *driver,
+    vitte_driver_import_prefetch_t *prefetch,
+    const char *module_name,
+    const char *resolved_path,
+    vitte_driver_import_unit_t **out
+) {
+    vitte_driver_prefetched_unit_t *item;
+    size_t slot;
+
+    *out = NULL;
+    if (prefetch == NULL || prefetch->items == NULL) {
+        return VITTE_STATUS_OK;
+    }
+    slot = *vitte_driver_prefetch_slot(prefetch, resolved_path);
+    if (slot == 0u || prefetch->items[slot - 1u].unit == NULL ||
+        !vitte_driver_copy_text(prefetch->items[slot - 1u].unit->module_name, VITTE_IMPORT_MAX_MODULE_NAME, module_name)) {
+        return VITTE_STATUS_OK;
+    }
+    item = &prefetch->items[slot - 1u];
+    if (vitte_diagnostic_bag_is_initialized(&item->diagnostics)) {
+        (void)vitte_diagnostic_merge(&driver->diagnostics, &item->diagnostics);
+    }
+    if (item->status != VITTE_STATUS_OK) {
+        if (vitte_error_is_set(&item->error)) {
+            vitte_error_copy(&driver->last_error, &item->error);
+        }
+        vitte_driver_destroy_import_unit(item->unit);
+        item->unit = NULL;
+        return item->status;
+    }
+    *out = item->unit;
+    item->unit = NULL;
+    return VITTE_STATUS_OK;
+}
+
 static vitte_status_t vitte_driver_collect_import_unit(
     vitte_driver_t *driver,
     vitte_import_resolver_t *resolver,
+    vitte_driver_import_prefetch_t *prefetch,
     const char *module_name,
     const char *resolved_path,
     vitte_driver_import_unit_t **units,
-    size_t *unit_count
+    size_t *unit_count,
+    vitte_driver_unit_index_t *unit_index
 ) {
     vitte_driver_import_unit_t *unit;
     vitte_status_t status;
     size_t index;
 
     if (driver == NULL || resolver == NULL || module_name == NULL || resolved_path == NULL ||
-        units == NULL || unit_count == NULL) {
+        units == NULL || unit_count == NULL || unit_index == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
-    if (vitte_driver_find_import_unit_by_path(units, *unit_count, resolved_path) != NULL ||
-        vitte_driver_find_import_unit_by_module(units, *unit_count, module_name) != NULL) {
+    if (vitte_driver_find_import_unit_by_path(unit_index, resolved_path) != NULL ||
+        vitte_driver_find_import_unit_by_module(unit_index, module_name) != NULL) {
         return VITTE_STATUS_OK;
     }
     if (*unit_count >= VITTE_DRIVER_MAX_IMPORTED_UNITS) {
@@ -1788,26 +2998,29 @@ static vitte_status_t vitte_driver_collect_import_unit(
         return VITTE_STATUS_ERROR_INVALID_STATE;
     }
 
-    unit = (vitte_driver_import_unit_t *)calloc(1u, sizeof(*unit));
+    status = vitte_driver_take_prefetched_unit(driver, prefetch, module_name, resolved_path, &unit);
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
     if (unit == NULL) {
-        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_IMPORT", "failed to allocate transitive import unit", resolved_path);
-        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        unit = vitte_driver_create_import_unit(driver);
+        if (unit == NULL) {
+            vitte_driver_set_error(driver, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_IMPORT", "failed to allocate transitive import unit", resolved_path);
+            return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        }
+        status = vitte_driver_parse_imported_unit(driver, module_name, resolved_path, unit);
+        if (status != VITTE_STATUS_OK) {
+            vitte_driver_destroy_import_unit(unit);
+            return status;
+        }
     }
     units[*unit_count] = unit;
     (*unit_count)++;
-
-    status = vitte_driver_parse_imported_unit(driver, module_name, resolved_path, unit);
-    if (status != VITTE_STATUS_OK) {
-        units[*unit_count - 1u] = NULL;
-        (*unit_count)--;
-        vitte_driver_destroy_import_unit(unit);
-        return status;
-    }
-    if (unit->module.import_count > 0u) {
-        status = vitte_module_resolve_imports(&unit->module, resolver);
+    if (unit->module->import_count > 0u) {
+        status = vitte_module_resolve_imports(unit->module, resolver);
         if (status != VITTE_STATUS_OK) {
-            if (!vitte_driver_maybe_set_ambiguous_use_path_error(driver, resolver, &unit->module)) {
-                vitte_error_copy(&driver->last_error, vitte_module_last_error(&unit->module));
+            if (!vitte_driver_maybe_set_ambiguous_use_path_error(driver, resolver, unit->module)) {
+                vitte_error_copy(&driver->last_error, vitte_module_last_error(unit->module));
             }
             units[*unit_count - 1u] = NULL;
             (*unit_count)--;
@@ -1815,9 +3028,10 @@ static vitte_status_t vitte_driver_collect_import_unit(
             return status;
         }
     }
+    vitte_driver_unit_index_add(unit_index, unit);
 
-    for (index = 0u; index < unit->module.import_count; index++) {
-        const vitte_module_import_t *entry = &unit->module.imports[index];
+    for (index = 0u; index < unit->module->import_count; index++) {
+        const vitte_module_import_t *entry = &unit->module->imports[index];
 
         if (!entry->resolved || entry->resolved_path[0] == '\0') {
             continue;
@@ -1825,10 +3039,12 @@ static vitte_status_t vitte_driver_collect_import_unit(
         status = vitte_driver_collect_import_unit(
             driver,
             resolver,
+            prefetch,
             entry->module_name,
             entry->resolved_path,
             units,
-            unit_count
+            unit_count,
+            unit_index
         );
         if (status != VITTE_STATUS_OK) {
             return status;
@@ -2121,13 +3337,12 @@ static vitte_status_t vitte_driver_flatten_module_imports(
     const char *source_module_name,
     const vitte_ast_module_t *source_root,
     const vitte_module_t *source_module,
-    vitte_driver_import_unit_t *const *imported_units,
-    size_t imported_unit_count
+    const vitte_driver_unit_index_t *unit_index
 ) {
     const vitte_ast_node_t *import_decl;
 
     if (driver == NULL || ast == NULL || state == NULL || source_module_name == NULL || source_root == NULL ||
-        source_module == NULL || imported_units == NULL) {
+        source_module == NULL || unit_index == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
 
@@ -2141,12 +3356,12 @@ static vitte_status_t vitte_driver_flatten_module_imports(
             vitte_driver_set_error(driver, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_DRIVER_E_IMPORT", "invalid import dependency name", import_decl->as.import_decl.path);
             return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
         }
-        dependency = vitte_driver_find_module_import(source_module, dependency_name);
+        dependency = vitte_module_find_import(source_module, dependency_name);
         if (dependency == NULL || !dependency->resolved || dependency->resolved_path[0] == '\0') {
             vitte_driver_set_error(driver, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_DRIVER_E_IMPORT", "missing resolved module metadata for lowering", dependency_name);
             return VITTE_STATUS_ERROR_INVALID_STATE;
         }
-        imported_unit = vitte_driver_find_import_unit_by_path(imported_units, imported_unit_count, dependency->resolved_path);
+        imported_unit = vitte_driver_find_import_unit_by_path(unit_index, dependency->resolved_path);
         if (imported_unit == NULL || !vitte_ast_is_initialized(&imported_unit->ast) || imported_unit->ast.root == NULL) {
             vitte_driver_set_error(driver, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_DRIVER_E_IMPORT", "missing imported AST for lowering", dependency->resolved_path);
             return VITTE_STATUS_ERROR_INVALID_STATE;
@@ -2240,7 +3455,8 @@ static vitte_status_t vitte_driver_flatten_imported_modules(
     vitte_ast_t *ast,
     const vitte_module_t *module,
     vitte_driver_import_unit_t *const *imported_units,
-    size_t imported_unit_count
+    size_t imported_unit_count,
+    const vitte_driver_unit_index_t *unit_index
 ) {
     vitte_ast_module_t *module_root;
     vitte_driver_flatten_state_t state;
@@ -2321,8 +3537,7 @@ static vitte_status_t vitte_driver_flatten_imported_modules(
             root_module_name,
             module_root,
             module,
-            imported_units,
-            imported_unit_count
+            unit_index
         ) != VITTE_STATUS_OK) {
         if (vitte_error_is_ok(vitte_driver_last_error(driver))) {
             vitte_driver_set_error(driver, VITTE_STATUS_ERROR_INTERNAL, "VITTE_DRIVER_E_FLATTEN", "failed to flatten root module imports", root_module_name);
@@ -2342,9 +3557,8 @@ static vitte_status_t vitte_driver_flatten_imported_modules(
                 &state,
                 unit->module_name,
                 unit->ast.root,
-                &unit->module,
-                imported_units,
-                imported_unit_count
+                unit->module,
+                unit_index
         ) != VITTE_STATUS_OK) {
             if (vitte_error_is_ok(vitte_driver_last_error(driver))) {
                 vitte_driver_set_error(driver, VITTE_STATUS_ERROR_INTERNAL, "VITTE_DRIVER_E_FLATTEN", "failed to flatten imported module imports", unit->module_name);
@@ -2377,46 +3591,65 @@ static vitte_status_t vitte_driver_flatten_imported_modules(
     return VITTE_STATUS_OK;
 }
 
+/*
+ * Lowers `ast` to HIR and then to `ir`. The HIR lives only inside this call:
+ * once the IR validates it is detached from the HIR and AST and the HIR is
+ * freed, so the caller may free the AST as well. `counts` receives the arena
+ * use of both stages.
+ */
 static vitte_status_t vitte_driver_run_backend(
     vitte_driver_t *driver,
     const vitte_ast_t *ast,
-    vitte_hir_t *hir,
-    vitte_ir_t *ir
+    vitte_ir_t *ir,
+    vitte_trace_counts_t *counts
 ) {
+    vitte_arena_config_t arena_config;
+    vitte_hir_t hir;
     vitte_status_t status;
 
-    if (driver == NULL || ast == NULL || hir == NULL || ir == NULL) {
+    if (driver == NULL || ast == NULL || ir == NULL || counts == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
 
-    status = vitte_hir_init_owned(hir, NULL);
+    vitte_driver_arena_config(driver, VITTE_MEMORY_HIR, &arena_config);
+    status = vitte_hir_init_owned(&hir, &arena_config);
     if (status != VITTE_STATUS_OK) {
-        vitte_error_copy(&driver->last_error, vitte_hir_last_error(hir));
+        vitte_error_copy(&driver->last_error, vitte_hir_last_error(&hir));
         return status;
     }
 
-    status = vitte_hir_lower_ast(hir, ast);
+    status = vitte_hir_lower_ast(&hir, ast);
     if (status == VITTE_STATUS_OK) {
-        status = vitte_hir_validate(hir);
+        status = vitte_hir_validate(&hir);
     }
     if (status == VITTE_STATUS_OK) {
-        status = vitte_ir_init_owned(ir, NULL);
+        vitte_driver_arena_config(driver, VITTE_MEMORY_IR, &arena_config);
+        status = vitte_ir_init_owned(ir, &arena_config);
         if (status != VITTE_STATUS_OK) {
             vitte_error_copy(&driver->last_error, vitte_ir_last_error(ir));
-            vitte_hir_destroy(hir);
+            vitte_hir_destroy(&hir);
             return status;
         }
-        status = vitte_ir_lower_hir(ir, hir);
+        /* IR names share the lexer's interner, so the backend compares them by address. */
+        status = vitte_ir_use_interner(ir, vitte_context_interner(driver->context));
+        if (status == VITTE_STATUS_OK) {
+            status = vitte_ir_lower_hir(ir, &hir);
+        }
         if (status == VITTE_STATUS_OK) {
             status = vitte_ir_validate(ir);
         }
+        if (status == VITTE_STATUS_OK) {
+            status = vitte_ir_detach(ir);
+        }
         if (status != VITTE_STATUS_OK) {
             vitte_error_copy(&driver->last_error, vitte_ir_last_error(ir));
         }
     }
+    counts->arena_bytes = vitte_driver_arena_bytes(hir.arena) +
+        (vitte_ir_is_initialized(ir) ? vitte_driver_arena_bytes(ir->arena) : 0u);
     if (status != VITTE_STATUS_OK) {
         if (vitte_error_is_ok(&driver->last_error)) {
-            vitte_error_copy(&driver->last_error, vitte_hir_last_error(hir));
+            vitte_error_copy(&driver->last_error, vitte_hir_last_error(&hir));
         }
         if (vitte_error_is_ok(&driver->last_error)) {
             vitte_driver_set_error(driver, status, "VITTE_DRIVER_E_BACKEND", "backend validation failed without a diagnostic", NULL);
@@ -2424,12 +3657,10 @@ static vitte_status_t vitte_driver_run_backend(
         if (vitte_ir_is_initialized(ir)) {
             vitte_ir_destroy(ir);
         }
-        if (vitte_hir_is_initialized(hir)) {
-            vitte_hir_destroy(hir);
-        }
     } else {
         vitte_error_reset(&driver->last_error);
     }
+    vitte_hir_destroy(&hir);
 
     return status;
 }
@@ -2475,74 +3706,644 @@ static bool vitte_driver_shell_quote(char *buffer, size_t capacity, const char *
     return vitte_driver_append_text(buffer, capacity, "'");
 }
 
+/* Single-file builds emit `<output>.c`; separate compilation uses the `<output>.units` directory. */
 static vitte_status_t vitte_driver_make_c_path(
     const char *output_path,
+    bool separate_units,
     vitte_driver_result_t *result
 ) {
+    const char *suffix = separate_units ? ".units" : ".c";
+    int written;
+
     if (result == NULL || output_path == NULL || output_path[0] == '\0') {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
-    if (strlen(output_path) + 3u >= sizeof(result->generated_c_path)) {
+    written = snprintf(result->generated_c_path, sizeof(result->generated_c_path), "%s%s", output_path, suffix);
+    if (written < 0 || (size_t)written >= sizeof(result->generated_c_path)) {
+        result->generated_c_path[0] = '\0';
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
-    (void)snprintf(result->generated_c_path, sizeof(result->generated_c_path), "%s.c", output_path);
     return VITTE_STATUS_OK;
 }
 
+/*
+ * Identifies the C compiler for object cache keys without running it: the
+ * resolved executable's path, size and modification time change whenever the
+ * compiler is upgraded or replaced.
+ */
+static void vitte_driver_key_add_compiler(vitte_cache_key_t *key, const char *compiler) {
+#ifdef _WIN32
+    const char separator = ';';
+#else
+    const char separator = ':';
+#endif
+    char candidate[VITTE_DRIVER_MAX_PATH_LENGTH];
+    const char *search = strchr(compiler, '/') == NULL ? getenv("PATH") : NULL;
+    struct stat info;
+    bool found = false;
+
+    vitte_cache_key_add_text(key, compiler);
+    if (search == NULL) {
+        found = strlen(compiler) < sizeof(candidate) && stat(compiler, &info) == 0;
+        if (found) {
+            memcpy(candidate, compiler, strlen(compiler) + 1u);
+        }
+    }
+    while (search != NULL && !found) {
+        const char *end = strchr(search, separator);
+        size_t length = end != NULL ? (size_t)(end - search) : strlen(search);
+        int written = snprintf(candidate, sizeof(candidate), "%.*s/%s", (int)length, length != 0u ? search : ".", compiler);
+
+        found = written > 0 && (size_t)written < sizeof(candidate) &&
+            vitte_fs_is_file(candidate) && stat(candidate, &info) == 0;
+        search = end != NULL ? end + 1 : NULL;
+    }
+    if (found) {
+        vitte_cache_key_add_text(key, candidate);
+        vitte_cache_key_add_size(key, (size_t)info.st_size);
+        vitte_cache_key_add_size(key, (size_t)info.st_mtime);
+    }
+}
+
+static bool vitte_driver_key_add_file(vitte_cache_key_t *key, const char *path) {
+    FILE *stream = fopen(path, "rb");
+    unsigned char chunk[16384];
+    size_t size;
+    size_t total = 0u;
+
+    if (stream == NULL) {
+        return false;
+    }
+    while ((size = fread(chunk, 1u, sizeof(chunk), stream)) > 0u) {
+        vitte_cache_key_add(key, chunk, size);
+        total += size;
+    }
+    vitte_cache_key_add_size(key, total);
+    fclose(stream);
+    return true;
+}
+
+static void vitte_driver_key_add_flags(vitte_cache_key_t *key) {
+    size_t index;
+
+    for (index = 0u; index < VITTE_DRIVER_C_FLAG_COUNT; index++) {
+        vitte_cache_key_add_text(key, vitte_driver_c_flags[index]);
+    }
+}
+
+/* `cc <flags> [-c] <input> -o <output>`; an input of "-" reads C17 from stdin. */
+static void vitte_driver_compiler_argv(
+    const char **argv,
+    const char *compiler,
+    bool object_only,
+    const char *input,
+    const char *output
+) {
+    size_t count = 0u;
+    size_t index;
+
+    argv[count++] = compiler;
+    for (index = 0u; index < VITTE_DRIVER_C_FLAG_COUNT; index++) {
+        argv[count++] = vitte_driver_c_flags[index];
+    }
+    if (object_only) {
+        argv[count++] = "-c";
+    }
+    if (strcmp(input, "-") == 0) {
+        argv[count++] = "-x";
+        argv[count++] = "c";
+    }
+    argv[count++] = input;
+    argv[count++] = "-o";
+    argv[count++] = output;
+    argv[count] = NULL;
+}
+
+/*
+ * Runs a NULL-terminated command to completion. With posix_spawn no shell is
+ * involved and the command's stderr comes back in `error_output` (owned by
+ * the caller); elsewhere the arguments are quoted for system().
+ */
+static vitte_status_t vitte_driver_run_command(const char *const *argv, int *exit_code, char **error_output) {
+    vitte_process_t process;
+    vitte_status_t status;
+    size_t capacity = 1u;
+    size_t index;
+    char *command;
+    bool quoted = true;
+
+    *exit_code = -1;
+    *error_output = NULL;
+    if (vitte_process_is_supported()) {
+        vitte_process_init(&process);
+        status = vitte_process_spawn(&process, argv, false);
+        if (status == VITTE_STATUS_OK) {
+            status = vitte_process_wait(&process, exit_code);
+        }
+        *error_output = vitte_process_take_error_output(&process);
+        vitte_process_destroy(&process);
+        return status;
+    }
+
+    /* Quoting can at most quadruple an argument. */
+    for (index = 0u; argv[index] != NULL; index++) {
+        capacity += 4u * strlen(argv[index]) + 3u;
+    }
+    command = (char *)malloc(capacity);
+    if (command == NULL) {
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    command[0] = '\0';
+    for (index = 0u; quoted && argv[index] != NULL; index++) {
+        quoted = (index == 0u || vitte_driver_append_text(command, capacity, " ")) &&
+            vitte_driver_shell_quote(command, capacity, argv[index]);
+    }
+    *exit_code = quoted ? system(command) : -1;
+    free(command);
+    return quoted ? VITTE_STATUS_OK : VITTE_STATUS_ERROR_INTERNAL;
+}
+
+/* Reports a failed compiler run with its stderr as details; takes `error_output`. */
+static vitte_status_t vitte_driver_compiler_failed(
+    vitte_driver_t *driver,
+    const char *subject,
+    char *error_output
+) {
+    size_t length = error_output != NULL ? strlen(error_output) : 0u;
+
+    while (length > 0u && (error_output[length - 1u] == '\n' || error_output[length - 1u] == '\r')) {
+        error_output[--length] = '\0';
+    }
+    vitte_driver_add_diag(
+        driver,
+        VITTE_DIAGNOSTIC_FATAL,
+        "VITTE_DRIVER_E_LINK",
+        "C compiler failed",
+        length != 0u ? error_output : subject
+    );
+    free(error_output);
+    vitte_driver_set_error(driver, VITTE_STATUS_ERROR_BACKEND, "VITTE_DRIVER_E_LINK", "C compiler failed", subject);
+    return VITTE_STATUS_ERROR_BACKEND;
+}
+
+/*
+ * Hands the stderr of a successful compiler run to `c_warning_stream`, if the
+ * caller asked for it; takes `error_output`. Warnings about generated C are
+ * seldom actionable for Vitte users, so they are dropped by default.
+ */
+static void vitte_driver_compiler_succeeded(const vitte_driver_t *driver, char *error_output) {
+    size_t length = error_output != NULL ? strlen(error_output) : 0u;
+
+    if (driver->c_warning_stream != NULL && length != 0u) {
+        /* Output past VITTE_PROCESS_MAX_ERROR_OUTPUT is cut, possibly mid-line. */
+        (void)fputs(error_output, driver->c_warning_stream);
+        if (error_output[length - 1u] != '\n') {
+            (void)fputc('\n', driver->c_warning_stream);
+        }
+    }
+    free(error_output);
+}
+
+/*
+ * With a cache directory, the output of the C compiler is stored in the
+ * object cache under a key of the generated C, compiler identity and flags,
+ * so a build whose C did not change links the previous output into place.
+ */
 static vitte_status_t vitte_driver_compile_c(
     vitte_driver_t *driver,
     const char *c_path,
     const char *output_path
 ) {
-    char command[8192];
+    const char *argv[VITTE_DRIVER_COMPILER_ARGC];
+    vitte_cache_key_t key;
+    vitte_error_t cache_error;
+    char *error_output = NULL;
+    bool cached = driver != NULL && vitte_cache_has_directory(driver->module_cache);
+    bool hit = false;
     int exit_code;
+    vitte_status_t status;
 
     if (driver == NULL || c_path == NULL || output_path == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
-    command[0] = '\0';
-    if (!vitte_driver_shell_quote(command, sizeof(command), driver->config.codegen.c_compiler) ||
-        !vitte_driver_append_text(command, sizeof(command), " -std=c17 -Wall -Wextra -pedantic ") ||
-        !vitte_driver_shell_quote(command, sizeof(command), c_path) ||
-        !vitte_driver_append_text(command, sizeof(command), " -o ") ||
-        !vitte_driver_shell_quote(command, sizeof(command), output_path)) {
-        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_DRIVER_E_COMMAND", "C compiler command is too long", NULL);
-        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    if (cached) {
+        vitte_error_init(&cache_error);
+        vitte_cache_key_init(&key);
+        vitte_cache_key_add_text(&key, "executable");
+        vitte_driver_key_add_compiler(&key, driver->config.codegen.c_compiler);
+        vitte_driver_key_add_flags(&key);
+        cached = vitte_driver_key_add_file(&key, c_path);
+    }
+    if (cached) {
+        (void)vitte_cache_load_object(driver->module_cache, &key, output_path, &hit, &cache_error);
+        if (hit) {
+            return VITTE_STATUS_OK;
+        }
+        /* The previous output may be a hard link to a cache entry; never write through it. */
+        (void)remove(output_path);
+    }
+
+    vitte_driver_compiler_argv(argv, driver->config.codegen.c_compiler, false, c_path, output_path);
+    status = vitte_driver_run_command(argv, &exit_code, &error_output);
+    if (status != VITTE_STATUS_OK || exit_code != 0) {
+        return vitte_driver_compiler_failed(driver, output_path, error_output);
+    }
+    vitte_driver_compiler_succeeded(driver, error_output);
+    if (cached) {
+        /* A failed store only costs the next build a compile. */
+        (void)vitte_cache_store_object(driver->module_cache, &key, output_path, &cache_error);
     }
+    return VITTE_STATUS_OK;
+}
+
+/*
+ * Streamed builds pipe C17 straight into `cc -x c -` while it is emitted, so
+ * emission and compilation overlap and no intermediate file is written. They
+ * are used when posix_spawn is available, no object cache needs the C text
+ * up front and `--keep-c` was not requested.
+ */
+static bool vitte_driver_can_stream_c(const vitte_driver_t *driver) {
+    return vitte_process_is_supported() &&
+        !vitte_cache_has_directory(driver->module_cache) &&
+        !driver->config.codegen.keep_intermediate_c;
+}
 
-    exit_code = system(command);
-    if (exit_code != 0) {
-        vitte_driver_add_diag(driver, VITTE_DIAGNOSTIC_FATAL, "VITTE_DRIVER_E_LINK", "C compiler failed", output_path);
-        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_BACKEND, "VITTE_DRIVER_E_LINK", "C compiler failed", output_path);
+static vitte_status_t vitte_driver_emit_c_streamed(
+    vitte_driver_t *driver,
+    const vitte_ir_t *ir,
+    const char *output_path,
+    vitte_process_t *process,
+    vitte_driver_result_t *result
+) {
+    const char *argv[VITTE_DRIVER_COMPILER_ARGC];
+    vitte_codegen_options_t options;
+    vitte_codegen_t codegen;
+    vitte_codegen_result_t codegen_result;
+    vitte_status_t status;
+    int exit_code;
+
+    vitte_driver_compiler_argv(argv, driver->config.codegen.c_compiler, false, "-", output_path);
+    status = vitte_process_spawn(process, argv, true);
+    if (status != VITTE_STATUS_OK) {
+        vitte_driver_add_diag(driver, VITTE_DIAGNOSTIC_FATAL, "VITTE_DRIVER_E_LINK", "failed to start C compiler", driver->config.codegen.c_compiler);
+        vitte_error_copy(&driver->last_error, vitte_process_last_error(process));
+        return status;
+    }
+
+    vitte_config_to_codegen_options(&driver->config, &options, NULL, 0u);
+    options.output_kind = VITTE_CODEGEN_OUTPUT_STREAM;
+    options.output_stream = process->input;
+    status = vitte_codegen_init(&codegen, &options);
+    if (status == VITTE_STATUS_OK) {
+        status = vitte_codegen_emit_ir_to_stream(&codegen, ir, process->input, &codegen_result);
+    }
+    if (status != VITTE_STATUS_OK) {
+        /* A compiler that exits early breaks the pipe; its own error is the useful one. */
+        if (vitte_process_wait(process, &exit_code) == VITTE_STATUS_OK && exit_code != 0) {
+            vitte_codegen_destroy(&codegen);
+            return vitte_driver_compiler_failed(driver, output_path, vitte_process_take_error_output(process));
+        }
+        vitte_driver_add_diag(driver, VITTE_DIAGNOSTIC_FATAL, "VITTE_DRIVER_E_CODEGEN", "C17 emission failed", NULL);
+        vitte_error_copy(&driver->last_error, vitte_codegen_last_error(&codegen));
+        vitte_codegen_destroy(&codegen);
+        return status;
+    }
+    if (result != NULL) {
+        result->output.kind = VITTE_DRIVER_EMIT_C;
+        result->output.path = output_path;
+        result->output.c_path = NULL;
+        result->output.bytes_written = codegen_result.bytes_written;
+        result->output.lines_written = codegen_result.lines_written;
+        result->output.functions_emitted = codegen_result.functions_emitted;
+    }
+    vitte_codegen_destroy(&codegen);
+    return VITTE_STATUS_OK;
+}
+
+static vitte_status_t vitte_driver_finish_c_streamed(
+    vitte_driver_t *driver,
+    vitte_process_t *process,
+    const char *output_path
+) {
+    vitte_status_t status;
+    int exit_code;
+
+    if (!process->running) {
+        /* Already reaped after a failed emission. */
         return VITTE_STATUS_ERROR_BACKEND;
     }
+    status = vitte_process_wait(process, &exit_code);
+    if (status != VITTE_STATUS_OK || exit_code != 0) {
+        return vitte_driver_compiler_failed(driver, output_path, vitte_process_take_error_output(process));
+    }
+    vitte_driver_compiler_succeeded(driver, vitte_process_take_error_output(process));
     return VITTE_STATUS_OK;
 }
 
-static vitte_status_t vitte_driver_run_impl(
+/*
+ * Separate compilation. Every unit `U` of `<output>.units/` is compiled to
+ * `U.o` by its own C compiler process, on up to `config.limits.jobs` at once.
+ * `U.stamp` records the key of the inputs `U.o` was built from (compiler,
+ * flags, `vitte_program.h`, `U.h`, `U.c`); a unit whose stamp still matches
+ * keeps its object, so a rebuild only recompiles the modules that changed.
+ * Other units are looked up in the object cache under the same key first.
+ */
+typedef struct vitte_driver_object_job {
+    char source_path[VITTE_DRIVER_MAX_PATH_LENGTH];
+    char header_path[VITTE_DRIVER_MAX_PATH_LENGTH];
+    char object_path[VITTE_DRIVER_MAX_PATH_LENGTH];
+    char stamp_path[VITTE_DRIVER_MAX_PATH_LENGTH];
+    char *error_output;
+    bool reused;
+    bool failed;
+} vitte_driver_object_job_t;
+
+typedef struct vitte_driver_object_pool {
+    const vitte_driver_t *driver;
+    vitte_cache_key_t compiler_key;
+    const char *program_header_path;
+    vitte_driver_object_job_t *jobs;
+} vitte_driver_object_pool_t;
+
+static void vitte_driver_format_key(const vitte_cache_key_t *key, char text[33]) {
+    (void)snprintf(text, 33u, "%016llx%016llx", (unsigned long long)key->high, (unsigned long long)key->low);
+}
+
+static bool vitte_driver_object_is_current(const vitte_driver_object_job_t *job, const char *key_text) {
+    char stamp[40];
+    FILE *stream;
+    size_t size;
+
+    if (!vitte_fs_is_file(job->object_path)) {
+        return false;
+    }
+    stream = fopen(job->stamp_path, "rb");
+    if (stream == NULL) {
+        return false;
+    }
+    size = fread(stamp, 1u, sizeof(stamp) - 1u, stream);
+    fclose(stream);
+    stamp[size] = '\0';
+    return size == 32u && memcmp(stamp, key_text, 32u) == 0;
+}
+
+static void vitte_driver_write_stamp(const vitte_driver_object_job_t *job, const char *key_text) {
+    FILE *stream = fopen(job->stamp_path, "wb");
+
+    if (stream != NULL) {
+        (void)fwrite(key_text, 1u, 32u, stream);
+        fclose(stream);
+    }
+}
+
+static bool vitte_driver_object_task(size_t index, size_t worker, void *user) {
+    vitte_driver_object_pool_t *pool = (vitte_driver_object_pool_t *)user;
+    vitte_driver_object_job_t *job = &pool->jobs[index];
+    const char *compiler = pool->driver->config.codegen.c_compiler;
+    vitte_cache_t *cache = pool->driver->module_cache;
+    vitte_cache_key_t key;
+    vitte_error_t cache_error;
+    const char *argv[VITTE_DRIVER_COMPILER_ARGC];
+    char key_text[33];
+    bool hit = false;
+    int exit_code;
+
+    (void)worker;
+    vitte_cache_key_init(&key);
+    vitte_cache_key_add_text(&key, "object");
+    vitte_cache_key_add_key(&key, &pool->compiler_key);
+    vitte_driver_key_add_flags(&key);
+    if (!vitte_driver_key_add_file(&key, pool->program_header_path) ||
+        !vitte_driver_key_add_file(&key, job->header_path) ||
+        !vitte_driver_key_add_file(&key, job->source_path)) {
+        job->failed = true;
+        return false;
+    }
+    vitte_driver_format_key(&key, key_text);
+    if (vitte_driver_object_is_current(job, key_text)) {
+        job->reused = true;
+        return true;
+    }
+    if (vitte_cache_has_directory(cache)) {
+        vitte_error_init(&cache_error);
+        (void)vitte_cache_load_object(cache, &key, job->object_path, &hit, &cache_error);
+        if (!hit) {
+            (void)remove(job->object_path);
+        }
+    }
+    if (hit) {
+        job->reused = true;
+        vitte_driver_write_stamp(job, key_text);
+        return true;
+    }
+
+    vitte_driver_compiler_argv(argv, compiler, true, job->source_path, job->object_path);
+    if (vitte_driver_run_command(argv, &exit_code, &job->error_output) != VITTE_STATUS_OK || exit_code != 0) {
+        job->failed = true;
+        return false;
+    }
+    if (vitte_cache_has_directory(cache)) {
+        (void)vitte_cache_store_object(cache, &key, job->object_path, &cache_error);
+    }
+    vitte_driver_write_stamp(job, key_text);
+    return true;
+}
+
+static bool vitte_driver_unit_path(char *buffer, const char *directory, const char *stem, const char *extension) {
+    int written = snprintf(buffer, VITTE_DRIVER_MAX_PATH_LENGTH, "%s/%s%s", directory, stem, extension);
+
+    return written > 0 && (size_t)written < VITTE_DRIVER_MAX_PATH_LENGTH;
+}
+
+static vitte_status_t vitte_driver_emit_units(
+    vitte_driver_t *driver,
+    const vitte_ir_t *ir,
+    const char *directory,
+    vitte_codegen_unit_list_t *units,
+    vitte_driver_result_t *result
+) {
+    vitte_codegen_options_t options;
+    vitte_codegen_t codegen;
+    vitte_codegen_result_t codegen_result;
+    vitte_status_t status;
+
+    status = vitte_fs_create_directory(directory, &driver->last_error);
+    if (status != VITTE_STATUS_OK) {
+        vitte_driver_add_diag(driver, VITTE_DIAGNOSTIC_FATAL, "VITTE_DRIVER_E_OUTPUT", "failed to create unit directory", directory);
+        return status;
+    }
+    vitte_config_to_codegen_options(&driver->config, &options, NULL, 0u);
+    options.output_kind = VITTE_CODEGEN_OUTPUT_DIRECTORY;
+    options.output_path = directory;
+    status = vitte_codegen_init(&codegen, &options);
+    if (status == VITTE_STATUS_OK) {
+        status = vitte_codegen_emit_ir_to_directory(&codegen, ir, directory, units, &codegen_result);
+    }
+    if (status != VITTE_STATUS_OK) {
+        vitte_driver_add_diag(driver, VITTE_DIAGNOSTIC_FATAL, "VITTE_DRIVER_E_CODEGEN", "C17 emission failed", NULL);
+        vitte_error_copy(&driver->last_error, vitte_codegen_last_error(&codegen));
+        vitte_codegen_destroy(&codegen);
+        return status;
+    }
+    if (result != NULL) {
+        result->output.kind = VITTE_DRIVER_EMIT_C;
+        result->output.c_path = directory;
+        result->output.functions_emitted = codegen_result.functions_emitted;
+    }
+    vitte_codegen_destroy(&codegen);
+    return VITTE_STATUS_OK;
+}
+
+static void vitte_driver_free_object_jobs(vitte_driver_object_job_t *jobs, size_t count) {
+    size_t index;
+
+    for (index = 0u; index < count; index++) {
+        free(jobs[index].error_output);
+    }
+    free(jobs);
+}
+
+static vitte_status_t vitte_driver_compile_units(
+    vitte_driver_t *driver,
+    const char *directory,
+    const vitte_codegen_unit_list_t *units,
+    const char *output_path,
+    vitte_driver_result_t *result
+) {
+    vitte_driver_object_pool_t pool;
+    char program_header_path[VITTE_DRIVER_MAX_PATH_LENGTH];
+    const char **argv;
+    char *error_output = NULL;
+    size_t index;
+    int exit_code;
+    vitte_status_t status;
+
+    pool.driver = driver;
+    vitte_cache_key_init(&pool.compiler_key);
+    vitte_driver_key_add_compiler(&pool.compiler_key, driver->config.codegen.c_compiler);
+    pool.program_header_path = program_header_path;
+    pool.jobs = (vitte_driver_object_job_t *)calloc(units->count, sizeof(*pool.jobs));
+    if (pool.jobs == NULL) {
+        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_LINK", "failed to allocate object jobs", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    if (!vitte_driver_unit_path(program_header_path, directory, VITTE_C17_UNIT_PROGRAM_HEADER, "")) {
+        free(pool.jobs);
+        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_DRIVER_E_OUTPUT", "unit path is too long", directory);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    for (index = 0u; index < units->count; index++) {
+        vitte_driver_object_job_t *job = &pool.jobs[index];
+        const char *stem = units->stems[index];
+
+        if (!vitte_driver_unit_path(job->source_path, directory, stem, ".c") ||
+            !vitte_driver_unit_path(job->header_path, directory, stem, ".h") ||
+            !vitte_driver_unit_path(job->object_path, directory, stem, ".o") ||
+            !vitte_driver_unit_path(job->stamp_path, directory, stem, ".stamp")) {
+            free(pool.jobs);
+            vitte_driver_set_error(driver, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_DRIVER_E_OUTPUT", "unit path is too long", stem);
+            return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
+    (void)vitte_parallel_for(units->count, driver->config.limits.jobs, vitte_driver_object_task, &pool, NULL);
+    for (index = 0u; index < units->count; index++) {
+        vitte_driver_object_job_t *job = &pool.jobs[index];
+
+        if (job->failed) {
+            char *job_output = job->error_output;
+
+            job->error_output = NULL;
+            status = vitte_driver_compiler_failed(driver, job->source_path, job_output);
+            vitte_driver_free_object_jobs(pool.jobs, units->count);
+            return status;
+        }
+        /* Reported in unit order, whichever worker compiled the unit. */
+        vitte_driver_compiler_succeeded(driver, job->error_output);
+        job->error_output = NULL;
+        if (result != NULL) {
+            if (job->reused) {
+                result->objects_reused++;
+            } else {
+                result->objects_compiled++;
+            }
+        }
+    }
+
+    /* `cc -o <output> <objects...>` plus the terminating NULL. */
+    argv = (const char **)malloc((units->count + 4u) * sizeof(*argv));
+    if (argv == NULL) {
+        vitte_driver_free_object_jobs(pool.jobs, units->count);
+        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_LINK", "failed to allocate link command", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    argv[0] = driver->config.codegen.c_compiler;
+    argv[1] = "-o";
+    argv[2] = output_path;
+    for (index = 0u; index < units->count; index++) {
+        argv[index + 3u] = pool.jobs[index].object_path;
+    }
+    argv[units->count + 3u] = NULL;
+    status = vitte_driver_run_command(argv, &exit_code, &error_output);
+    free((void *)argv);
+    vitte_driver_free_object_jobs(pool.jobs, units->count);
+    if (status != VITTE_STATUS_OK || exit_code != 0) {
+        return vitte_driver_compiler_failed(driver, output_path, error_output);
+    }
+    vitte_driver_compiler_succeeded(driver, error_output);
+    return VITTE_STATUS_OK;
+}
+
+/*
+ * The root module record, import tables and resolver of one pipeline run.
+ * Together they run to a few megabytes, so the run takes them from the heap
+ * rather than from the stack of whichever (pool) thread drives it.
+ */
+typedef struct vitte_driver_pipeline_frame {
+    vitte_module_t module;
+    vitte_import_resolver_t resolver;
+    vitte_driver_import_prefetch_t prefetch;
+    vitte_driver_import_unit_t *imported_units[VITTE_DRIVER_MAX_IMPORTED_UNITS];
+    vitte_driver_unit_index_t unit_index;
+} vitte_driver_pipeline_frame_t;
+
+static vitte_status_t vitte_driver_run_pipeline_in(
     vitte_driver_t *driver,
+    vitte_driver_pipeline_frame_t *frame,
     const vitte_driver_input_t *input,
     vitte_driver_emit_kind_t kind,
     const char *output_path,
     vitte_driver_result_t *result
 ) {
     vitte_ast_t ast;
-    /* Imported ASTs are large; keep the bootstrap graph off the small process stack. */
-    static vitte_ast_t imported_asts[VITTE_MODULE_MAX_IMPORTS];
-    vitte_driver_import_unit_t *imported_units[VITTE_DRIVER_MAX_IMPORTED_UNITS];
-    vitte_hir_t hir;
+    vitte_arena_config_t arena_config;
+    vitte_ast_t *imported_asts = driver != NULL ? driver->imported_asts : NULL;
+    vitte_driver_import_unit_t **imported_units = frame->imported_units;
+    vitte_driver_unit_index_t *unit_index = &frame->unit_index;
     vitte_ir_t ir;
-    vitte_module_t module;
-    vitte_import_resolver_t resolver;
+    vitte_module_t *module = &frame->module;
+    vitte_import_resolver_t *resolver = &frame->resolver;
+    vitte_driver_import_prefetch_t *prefetch = &frame->prefetch;
+    vitte_cache_key_t root_source_key;
+    vitte_cache_key_t root_interface_key;
+    vitte_cache_key_t root_fingerprint;
+    vitte_trace_clock_t start;
+    vitte_trace_counts_t counts;
     vitte_status_t status;
     size_t imported_ast_count = 0u;
     size_t imported_unit_count = 0u;
     size_t imported_index;
     bool ast_initialized = false;
-    bool hir_initialized = false;
     bool ir_initialized = false;
+    bool separate_units = false;
+    bool streamed = false;
+    vitte_codegen_unit_list_t units;
+    vitte_process_t compiler;
     bool module_initialized = false;
     bool resolver_initialized = false;
+    bool incremental = false;
+    bool root_reused = false;
+    bool root_clean = false;
 
     if (result != NULL) {
         vitte_driver_result_reset(result);
@@ -2557,6 +4358,9 @@ static vitte_status_t vitte_driver_run_impl(
     vitte_diagnostic_bag_reset(&driver->diagnostics);
     vitte_driver_pipeline_reset(&driver->pipeline);
     vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_INIT, VITTE_STATUS_OK);
+    driver->analyzed_module_count = 0u;
+    driver->reused_module_count = 0u;
+    memset(&root_source_key, 0, sizeof(root_source_key));
 
     status = vitte_driver_validate_input(driver, input);
     if (status != VITTE_STATUS_OK) {
@@ -2577,7 +4381,8 @@ static vitte_status_t vitte_driver_run_impl(
         return status;
     }
     vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_LOAD_CONFIG, VITTE_STATUS_OK);
-    status = vitte_ast_init_owned(&ast, NULL);
+    vitte_driver_arena_config(driver, VITTE_MEMORY_AST, &arena_config);
+    status = vitte_ast_init_owned(&ast, &arena_config);
     if (status != VITTE_STATUS_OK) {
         vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_BUILD_AST, status);
         vitte_driver_add_diag(driver, VITTE_DIAGNOSTIC_FATAL, "VITTE_DRIVER_E_AST", "failed to initialize AST", NULL);
@@ -2586,17 +4391,19 @@ static vitte_status_t vitte_driver_run_impl(
         return status;
     }
     ast_initialized = true;
-    memset(imported_asts, 0, sizeof(imported_asts));
-    memset(imported_units, 0, sizeof(imported_units));
+    memset(imported_asts, 0, VITTE_MODULE_MAX_IMPORTS * sizeof(*imported_asts));
+    memset(frame->imported_units, 0, sizeof(frame->imported_units));
 
-    status = vitte_driver_parse_ast(driver, input, &ast, &module);
+    vitte_trace_clock_now(&start);
+    status = vitte_driver_parse_ast(driver, input, &ast, module, &root_source_key);
+    vitte_driver_trace_unit(driver, "parse", driver->config.paths.input_path, &start, input->size);
     if (status != VITTE_STATUS_OK) {
         vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_LEX, status);
         vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_PARSE, status);
         vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_BUILD_AST, status);
         vitte_driver_result_set_error(result, status, VITTE_DRIVER_STAGE_PARSE, "VITTE_DRIVER_E_PARSE", "failed to parse source", NULL);
-        if (vitte_module_is_initialized(&module)) {
-            vitte_module_destroy(&module);
+        if (vitte_module_is_initialized(module)) {
+            vitte_module_destroy(module);
         }
         vitte_ast_destroy(&ast);
         vitte_driver_update_counts(driver, result);
@@ -2607,27 +4414,27 @@ static vitte_status_t vitte_driver_run_impl(
     vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_PARSE, VITTE_STATUS_OK);
     vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_BUILD_AST, VITTE_STATUS_OK);
 
-    if (module.import_count > 0u) {
-        status = vitte_driver_configure_import_resolver(driver, input, &resolver);
+    if (module->import_count > 0u) {
+        status = vitte_driver_configure_import_resolver(driver, input, resolver);
         if (status != VITTE_STATUS_OK) {
             vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_SEMANTIC, status);
             vitte_driver_add_diag(driver, VITTE_DIAGNOSTIC_FATAL, "VITTE_DRIVER_E_IMPORT", "failed to initialize import resolver", input->source_name);
             vitte_driver_set_error(driver, status, "VITTE_DRIVER_E_IMPORT", "failed to initialize import resolver", input->source_name);
             vitte_driver_result_set_error(result, status, VITTE_DRIVER_STAGE_SEMANTIC, "VITTE_DRIVER_E_IMPORT", "failed to initialize import resolver", NULL);
-            vitte_module_destroy(&module);
+            vitte_module_destroy(module);
             vitte_ast_destroy(&ast);
             vitte_driver_update_counts(driver, result);
             return status;
         }
         resolver_initialized = true;
-        status = vitte_module_resolve_imports(&module, &resolver);
+        status = vitte_module_resolve_imports(module, resolver);
         if (status != VITTE_STATUS_OK) {
             const vitte_error_t *error;
 
-            if (vitte_driver_maybe_set_ambiguous_use_path_error(driver, &resolver, &module)) {
+            if (vitte_driver_maybe_set_ambiguous_use_path_error(driver, resolver, module)) {
                 error = vitte_driver_last_error(driver);
             } else {
-                error = vitte_module_last_error(&module);
+                error = vitte_module_last_error(module);
                 if (error != NULL) {
                     vitte_error_copy(&driver->last_error, error);
                 }
@@ -2641,36 +4448,41 @@ static vitte_status_t vitte_driver_run_impl(
                 vitte_driver_error_details_or(error, input->source_name)
             );
             vitte_driver_result_set_error(result, status, VITTE_DRIVER_STAGE_SEMANTIC, "VITTE_DRIVER_E_IMPORT", "failed to resolve module imports", NULL);
-            vitte_import_resolver_destroy(&resolver);
-            vitte_module_destroy(&module);
+            vitte_import_resolver_destroy(resolver);
+            vitte_module_destroy(module);
             vitte_ast_destroy(&ast);
             vitte_driver_update_counts(driver, result);
             return status;
         }
     }
 
-    status = vitte_ast_validate(&ast);
+    status = vitte_driver_validate_unit_ast(driver, driver->config.paths.input_path, &ast);
     if (status != VITTE_STATUS_OK) {
         vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_VALIDATE_AST, status);
         vitte_driver_add_diag(driver, VITTE_DIAGNOSTIC_FATAL, "VITTE_DRIVER_E_AST", "AST validation failed", vitte_ast_last_error(&ast)->details);
         vitte_driver_result_set_error(result, status, VITTE_DRIVER_STAGE_VALIDATE_AST, "VITTE_DRIVER_E_AST", "AST validation failed", NULL);
         if (resolver_initialized) {
-            vitte_import_resolver_destroy(&resolver);
+            vitte_import_resolver_destroy(resolver);
         }
-        vitte_module_destroy(&module);
+        vitte_module_destroy(module);
         vitte_ast_destroy(&ast);
         vitte_driver_update_counts(driver, result);
         return status;
     }
     vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_VALIDATE_AST, VITTE_STATUS_OK);
 
-    for (imported_index = 0u; imported_index < module.import_count; imported_index++) {
-        if (!module.imports[imported_index].resolved || module.imports[imported_index].resolved_path[0] == '\0') {
+    memset(prefetch, 0, sizeof(*prefetch));
+    memset(unit_index, 0, sizeof(*unit_index));
+    if (resolver_initialized) {
+        vitte_driver_prefetch_import_closure(driver, resolver, module, prefetch);
+    }
+    for (imported_index = 0u; imported_index < module->import_count; imported_index++) {
+        if (!module->imports[imported_index].resolved || module->imports[imported_index].resolved_path[0] == '\0') {
             continue;
         }
         status = vitte_driver_parse_imported_ast(
             driver,
-            module.imports[imported_index].resolved_path,
+            module->imports[imported_index].resolved_path,
             &imported_asts[imported_ast_count]
         );
         if (status != VITTE_STATUS_OK) {
@@ -2680,12 +4492,13 @@ static vitte_status_t vitte_driver_run_impl(
                 VITTE_DIAGNOSTIC_FATAL,
                 "VITTE_DRIVER_E_IMPORT",
                 "failed to parse imported module",
-                module.imports[imported_index].resolved_path
+                module->imports[imported_index].resolved_path
             );
+            vitte_driver_destroy_import_prefetch(prefetch);
             if (resolver_initialized) {
-                vitte_import_resolver_destroy(&resolver);
+                vitte_import_resolver_destroy(resolver);
             }
-            vitte_module_destroy(&module);
+            vitte_module_destroy(module);
             while (imported_ast_count > 0u) {
                 imported_ast_count--;
                 vitte_ast_destroy(&imported_asts[imported_ast_count]);
@@ -2699,15 +4512,17 @@ static vitte_status_t vitte_driver_run_impl(
         if (resolver_initialized) {
             status = vitte_driver_collect_import_unit(
                 driver,
-                &resolver,
-                module.imports[imported_index].module_name,
-                module.imports[imported_index].resolved_path,
+                resolver,
+                prefetch,
+                module->imports[imported_index].module_name,
+                module->imports[imported_index].resolved_path,
                 imported_units,
-                &imported_unit_count
+                &imported_unit_count,
+                unit_index
             );
             if (status != VITTE_STATUS_OK) {
                 if (vitte_error_is_ok(vitte_driver_last_error(driver))) {
-                    vitte_driver_set_error(driver, status, "VITTE_DRIVER_E_IMPORT", "failed to collect imported module graph", module.imports[imported_index].resolved_path);
+                    vitte_driver_set_error(driver, status, "VITTE_DRIVER_E_IMPORT", "failed to collect imported module graph", module->imports[imported_index].resolved_path);
                 }
                 const vitte_error_t *error = vitte_driver_last_error(driver);
                 vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_SEMANTIC, status);
@@ -2716,12 +4531,13 @@ static vitte_status_t vitte_driver_run_impl(
                     VITTE_DIAGNOSTIC_FATAL,
                     vitte_driver_error_code_or(error, "VITTE_DRIVER_E_IMPORT"),
                     vitte_driver_error_message_or(error, "failed to collect imported module graph"),
-                    vitte_driver_error_details_or(error, module.imports[imported_index].resolved_path)
+                    vitte_driver_error_details_or(error, module->imports[imported_index].resolved_path)
                 );
+                vitte_driver_destroy_import_prefetch(prefetch);
                 if (resolver_initialized) {
-                    vitte_import_resolver_destroy(&resolver);
+                    vitte_import_resolver_destroy(resolver);
                 }
-                vitte_module_destroy(&module);
+                vitte_module_destroy(module);
                 while (imported_ast_count > 0u) {
                     imported_ast_count--;
                     vitte_ast_destroy(&imported_asts[imported_ast_count]);
@@ -2733,9 +4549,40 @@ static vitte_status_t vitte_driver_run_impl(
             }
         }
     }
+    vitte_driver_destroy_import_prefetch(prefetch);
 
-    status = vitte_driver_run_import_graph_sema(driver, imported_units, imported_unit_count);
+    incremental = driver->module_cache != NULL && input->path != NULL && !vitte_cache_key_is_zero(&root_source_key);
+    if (incremental) {
+        status = vitte_driver_prepare_incremental(
+            driver,
+            input->path,
+            &ast,
+            module,
+            &root_source_key,
+            imported_units,
+            imported_unit_count,
+            unit_index,
+            &root_interface_key,
+            &root_fingerprint,
+            &root_reused
+        );
+        incremental = status == VITTE_STATUS_OK;
+    }
+    status = vitte_driver_run_import_graph_sema(driver, imported_units, imported_unit_count, unit_index);
     if (status != VITTE_STATUS_OK) {
+        if (incremental) {
+            vitte_driver_store_dependency_graph(
+                driver,
+                input->path,
+                module,
+                &root_interface_key,
+                &root_fingerprint,
+                false,
+                imported_units,
+                imported_unit_count,
+                unit_index
+            );
+        }
         vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_CONSTANTS, status);
         vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_SEMANTIC, status);
         vitte_driver_add_diag(
@@ -2754,9 +4601,9 @@ static vitte_status_t vitte_driver_run_impl(
             NULL
         );
         if (resolver_initialized) {
-            vitte_import_resolver_destroy(&resolver);
+            vitte_import_resolver_destroy(resolver);
         }
-        vitte_module_destroy(&module);
+        vitte_module_destroy(module);
         while (imported_ast_count > 0u) {
             imported_ast_count--;
             vitte_ast_destroy(&imported_asts[imported_ast_count]);
@@ -2767,15 +4614,37 @@ static vitte_status_t vitte_driver_run_impl(
         return status;
     }
 
-    status = vitte_driver_run_sema(driver, &ast, &module, imported_asts, imported_ast_count);
+    if (root_reused) {
+        driver->reused_module_count++;
+        status = VITTE_STATUS_OK;
+    } else {
+        size_t diagnostic_count = vitte_diagnostic_bag_total_count(&driver->diagnostics);
+
+        driver->analyzed_module_count++;
+        status = vitte_driver_run_sema(driver, &ast, module, imported_asts, imported_ast_count);
+        root_clean = status == VITTE_STATUS_OK && vitte_diagnostic_bag_total_count(&driver->diagnostics) == diagnostic_count;
+    }
+    if (incremental) {
+        vitte_driver_store_dependency_graph(
+            driver,
+            input->path,
+            module,
+            &root_interface_key,
+            &root_fingerprint,
+            root_reused || root_clean,
+            imported_units,
+            imported_unit_count,
+            unit_index
+        );
+    }
     if (status != VITTE_STATUS_OK) {
         vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_CONSTANTS, status);
         vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_SEMANTIC, status);
         vitte_driver_result_set_error(result, status, VITTE_DRIVER_STAGE_SEMANTIC, "VITTE_DRIVER_E_SEMA", "semantic analysis failed", NULL);
         if (resolver_initialized) {
-            vitte_import_resolver_destroy(&resolver);
+            vitte_import_resolver_destroy(resolver);
         }
-        vitte_module_destroy(&module);
+        vitte_module_destroy(module);
         while (imported_ast_count > 0u) {
             imported_ast_count--;
             vitte_ast_destroy(&imported_asts[imported_ast_count]);
@@ -2787,9 +4656,15 @@ static vitte_status_t vitte_driver_run_impl(
     }
     vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_CONSTANTS, VITTE_STATUS_OK);
     vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_SEMANTIC, VITTE_STATUS_OK);
+    /* The root's own parses of its imports only serve root sema. */
+    while (imported_ast_count > 0u) {
+        imported_ast_count--;
+        vitte_ast_destroy(&imported_asts[imported_ast_count]);
+    }
 
     if (kind != VITTE_DRIVER_EMIT_AST) {
-        status = vitte_driver_flatten_imported_modules(driver, &ast, &module, imported_units, imported_unit_count);
+        vitte_trace_clock_now(&start);
+        status = vitte_driver_flatten_imported_modules(driver, &ast, module, imported_units, imported_unit_count, unit_index);
         if (status != VITTE_STATUS_OK) {
             const vitte_error_t *error = vitte_driver_last_error(driver);
             vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_BACKEND, status);
@@ -2809,9 +4684,9 @@ static vitte_status_t vitte_driver_run_impl(
                 vitte_driver_error_details_or(error, NULL)
             );
             if (resolver_initialized) {
-                vitte_import_resolver_destroy(&resolver);
+                vitte_import_resolver_destroy(resolver);
             }
-            vitte_module_destroy(&module);
+            vitte_module_destroy(module);
             while (imported_ast_count > 0u) {
                 imported_ast_count--;
                 vitte_ast_destroy(&imported_asts[imported_ast_count]);
@@ -2821,15 +4696,26 @@ static vitte_status_t vitte_driver_run_impl(
             vitte_driver_update_counts(driver, result);
             return status;
         }
-        status = vitte_driver_run_backend(driver, &ast, &hir, &ir);
+        /* Flattening was the last reader of the module records and resolver-> */
+        for (imported_index = 0u; imported_index < imported_unit_count; imported_index++) {
+            vitte_driver_release_unit_module(imported_units[imported_index]);
+        }
+        vitte_module_destroy(module);
+        module_initialized = false;
+        if (resolver_initialized) {
+            vitte_import_resolver_destroy(resolver);
+            resolver_initialized = false;
+        }
+        memset(&counts, 0, sizeof(counts));
+        status = vitte_driver_run_backend(driver, &ast, &ir, &counts);
         if (status != VITTE_STATUS_OK) {
             vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_BACKEND, status);
             vitte_driver_add_diag(driver, VITTE_DIAGNOSTIC_FATAL, "VITTE_DRIVER_E_BACKEND", "backend lowering failed", vitte_driver_last_error(driver)->details);
             vitte_driver_result_set_error(result, status, VITTE_DRIVER_STAGE_BACKEND, "VITTE_DRIVER_E_BACKEND", "backend lowering failed", NULL);
             if (resolver_initialized) {
-                vitte_import_resolver_destroy(&resolver);
+                vitte_import_resolver_destroy(resolver);
             }
-            vitte_module_destroy(&module);
+            vitte_module_destroy(module);
             while (imported_ast_count > 0u) {
                 imported_ast_count--;
                 vitte_ast_destroy(&imported_asts[imported_ast_count]);
@@ -2839,8 +4725,12 @@ static vitte_status_t vitte_driver_run_impl(
             vitte_driver_update_counts(driver, result);
             return status;
         }
-        hir_initialized = true;
         ir_initialized = true;
+        /* The IR is detached, so no AST has a reader left. */
+        vitte_ast_destroy(&ast);
+        ast_initialized = false;
+        vitte_driver_destroy_import_units(imported_units, &imported_unit_count);
+        vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_BACKEND, driver->config.paths.input_path, &start, &counts);
         vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_BACKEND, VITTE_STATUS_OK);
     }
 
@@ -2851,16 +4741,25 @@ static vitte_status_t vitte_driver_run_impl(
         }
     } else if (kind == VITTE_DRIVER_EMIT_C || kind == VITTE_DRIVER_EMIT_BINARY || kind == VITTE_DRIVER_EMIT_OBJECT) {
         const char *c_output_path = output_path;
-        if (kind == VITTE_DRIVER_EMIT_BINARY || kind == VITTE_DRIVER_EMIT_OBJECT) {
-            status = vitte_driver_make_c_path(output_path, result);
+
+        separate_units = driver->config.codegen.separate_units &&
+            (kind == VITTE_DRIVER_EMIT_BINARY || kind == VITTE_DRIVER_EMIT_OBJECT);
+        streamed = !separate_units && (kind == VITTE_DRIVER_EMIT_BINARY || kind == VITTE_DRIVER_EMIT_OBJECT) &&
+            vitte_driver_can_stream_c(driver);
+        vitte_c17_unit_list_init(&units);
+        vitte_process_init(&compiler);
+        if (streamed) {
+            c_output_path = NULL;
+        } else if (kind == VITTE_DRIVER_EMIT_BINARY || kind == VITTE_DRIVER_EMIT_OBJECT) {
+            status = vitte_driver_make_c_path(output_path, separate_units, result);
             if (status != VITTE_STATUS_OK) {
                 vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_CODEGEN_C, status);
                 vitte_driver_set_error(driver, status, "VITTE_DRIVER_E_OUTPUT", "invalid build output path", output_path);
                 vitte_driver_result_set_error(result, status, VITTE_DRIVER_STAGE_CODEGEN_C, "VITTE_DRIVER_E_OUTPUT", "invalid build output path", output_path);
                 if (resolver_initialized) {
-                    vitte_import_resolver_destroy(&resolver);
+                    vitte_import_resolver_destroy(resolver);
                 }
-                vitte_module_destroy(&module);
+                vitte_module_destroy(module);
                 while (imported_ast_count > 0u) {
                     imported_ast_count--;
                     vitte_ast_destroy(&imported_asts[imported_ast_count]);
@@ -2872,20 +4771,26 @@ static vitte_status_t vitte_driver_run_impl(
             }
             c_output_path = result != NULL ? result->generated_c_path : NULL;
         }
-        status = vitte_driver_emit_c_impl(driver, VITTE_CODEGEN_INPUT_IR, &ir, c_output_path, result);
+        vitte_trace_clock_now(&start);
+        if (separate_units) {
+            status = vitte_driver_emit_units(driver, &ir, c_output_path, &units, result);
+        } else if (streamed) {
+            status = vitte_driver_emit_c_streamed(driver, &ir, output_path, &compiler, result);
+        } else {
+            status = vitte_driver_emit_c_impl(driver, VITTE_CODEGEN_INPUT_IR, &ir, c_output_path, result);
+        }
         if (status != VITTE_STATUS_OK) {
             vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_CODEGEN_C, status);
             vitte_driver_result_set_error(result, status, VITTE_DRIVER_STAGE_CODEGEN_C, "VITTE_DRIVER_E_CODEGEN", "failed to emit C17", NULL);
+            vitte_c17_unit_list_destroy(&units);
+            vitte_process_destroy(&compiler);
             if (ir_initialized) {
                 vitte_ir_destroy(&ir);
             }
-            if (hir_initialized) {
-                vitte_hir_destroy(&hir);
-            }
             if (resolver_initialized) {
-                vitte_import_resolver_destroy(&resolver);
+                vitte_import_resolver_destroy(resolver);
             }
-            vitte_module_destroy(&module);
+            vitte_module_destroy(module);
             while (imported_ast_count > 0u) {
                 imported_ast_count--;
                 vitte_ast_destroy(&imported_asts[imported_ast_count]);
@@ -2895,23 +4800,38 @@ static vitte_status_t vitte_driver_run_impl(
             vitte_driver_update_counts(driver, result);
             return status;
         }
+        memset(&counts, 0, sizeof(counts));
+        counts.bytes_out = result != NULL ? result->output.bytes_written : 0u;
+        vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_CODEGEN_C, driver->config.paths.input_path, &start, &counts);
         vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_CODEGEN_C, VITTE_STATUS_OK);
+        /* The C compiler only needs the emitted text. */
+        vitte_ir_destroy(&ir);
+        ir_initialized = false;
 
         if (kind == VITTE_DRIVER_EMIT_BINARY || kind == VITTE_DRIVER_EMIT_OBJECT) {
-            status = vitte_driver_compile_c(driver, c_output_path, output_path);
+            vitte_trace_clock_now(&start);
+            if (separate_units) {
+                status = vitte_driver_compile_units(driver, c_output_path, &units, output_path, result);
+            } else if (streamed) {
+                status = vitte_driver_finish_c_streamed(driver, &compiler, output_path);
+            } else {
+                status = vitte_driver_compile_c(driver, c_output_path, output_path);
+            }
+            vitte_c17_unit_list_destroy(&units);
+            vitte_process_destroy(&compiler);
+            counts.bytes_in = counts.bytes_out;
+            counts.bytes_out = 0u;
+            vitte_driver_profile_stage(driver, VITTE_DRIVER_STAGE_COMPILE_LINK, driver->config.paths.input_path, &start, &counts);
             if (status != VITTE_STATUS_OK) {
                 vitte_driver_pipeline_mark(&driver->pipeline, VITTE_DRIVER_STAGE_COMPILE_LINK, status);
                 vitte_driver_result_set_error(result, status, VITTE_DRIVER_STAGE_COMPILE_LINK, "VITTE_DRIVER_E_LINK", "failed to compile generated C", output_path);
                 if (ir_initialized) {
                     vitte_ir_destroy(&ir);
                 }
-                if (hir_initialized) {
-                    vitte_hir_destroy(&hir);
-                }
                 if (resolver_initialized) {
-                    vitte_import_resolver_destroy(&resolver);
+                    vitte_import_resolver_destroy(resolver);
                 }
-                vitte_module_destroy(&module);
+                vitte_module_destroy(module);
                 while (imported_ast_count > 0u) {
                     imported_ast_count--;
                     vitte_ast_destroy(&imported_asts[imported_ast_count]);
@@ -2937,10 +4857,10 @@ static vitte_status_t vitte_driver_run_impl(
         vitte_ast_destroy(&ast);
     }
     if (resolver_initialized) {
-        vitte_import_resolver_destroy(&resolver);
+        vitte_import_resolver_destroy(resolver);
     }
     if (module_initialized) {
-        vitte_module_destroy(&module);
+        vitte_module_destroy(module);
     }
     while (imported_ast_count > 0u) {
         imported_ast_count--;
@@ -2950,9 +4870,6 @@ static vitte_status_t vitte_driver_run_impl(
     if (ir_initialized) {
         vitte_ir_destroy(&ir);
     }
-    if (hir_initialized) {
-        vitte_hir_destroy(&hir);
-    }
     if (result != NULL) {
         result->status = vitte_diagnostic_status(&driver->diagnostics);
         if (result->status == VITTE_STATUS_OK) {
@@ -2970,6 +4887,75 @@ static vitte_status_t vitte_driver_run_impl(
     return result != NULL ? result->status : vitte_diagnostic_status(&driver->diagnostics);
 }
 
+static vitte_status_t vitte_driver_run_pipeline(
+    vitte_driver_t *driver,
+    const vitte_driver_input_t *input,
+    vitte_driver_emit_kind_t kind,
+    const char *output_path,
+    vitte_driver_result_t *result
+) {
+    vitte_driver_pipeline_frame_t *frame;
+    vitte_status_t status;
+
+    if (!vitte_driver_is_initialized(driver)) {
+        vitte_driver_result_set_error(result, VITTE_STATUS_ERROR_INVALID_STATE, VITTE_DRIVER_STAGE_INIT, "VITTE_DRIVER_E_STATE", "driver is not initialized", NULL);
+        return VITTE_STATUS_ERROR_INVALID_STATE;
+    }
+    frame = (vitte_driver_pipeline_frame_t *)vitte_driver_calloc(driver, VITTE_MEMORY_MODULES, 1u, sizeof(*frame));
+    if (frame == NULL) {
+        vitte_driver_set_error(driver, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_DRIVER_E_STATE", "failed to allocate pipeline state", NULL);
+        vitte_driver_result_set_error(result, VITTE_STATUS_ERROR_OUT_OF_MEMORY, VITTE_DRIVER_STAGE_INIT, "VITTE_DRIVER_E_STATE", "failed to allocate pipeline state", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    status = vitte_driver_run_pipeline_in(driver, frame, input, kind, output_path, result);
+    vitte_driver_free(driver, VITTE_MEMORY_MODULES, frame);
+    return status;
+}
+
+/* Runs the pipeline with a fresh stage profile and hands it to `result`. */
+static vitte_status_t vitte_driver_run_impl(
+    vitte_driver_t *driver,
+    const vitte_driver_input_t *input,
+    vitte_driver_emit_kind_t kind,
+    const char *output_path,
+    vitte_driver_result_t *result
+) {
+    vitte_trace_clock_t start;
+    vitte_trace_clock_t end;
+    size_t source_bytes;
+    vitte_status_t status;
+
+    if (!vitte_driver_is_initialized(driver)) {
+        return vitte_driver_run_pipeline(driver, input, kind, output_path, result);
+    }
+    memset(driver->profile->stages, 0, sizeof(driver->profile->stages));
+    vitte_driver_reset_unit_memory(driver->profile);
+    /* The root source belongs to the caller; it is charged while the run reads it. */
+    source_bytes = input != NULL ? input->size : 0u;
+    vitte_memory_account_charge(vitte_driver_memory(driver), VITTE_MEMORY_SOURCE, source_bytes, source_bytes);
+    vitte_trace_clock_now(&start);
+    status = vitte_driver_run_pipeline(driver, input, kind, output_path, result);
+    vitte_trace_clock_now(&end);
+    vitte_memory_account_release(vitte_driver_memory(driver), VITTE_MEMORY_SOURCE, source_bytes, source_bytes);
+    vitte_trace_record(
+        driver->trace,
+        "driver",
+        vitte_driver_emit_kind_name(kind),
+        input != NULL ? (input->path != NULL ? input->path : input->source_name) : NULL,
+        &start,
+        &end,
+        NULL
+    );
+    if (result != NULL) {
+        memcpy(result->stage_profiles, driver->profile->stages, sizeof(result->stage_profiles));
+        result->wall_ns = end.wall_ns - start.wall_ns;
+        result->cpu_ns = end.cpu_ns > start.cpu_ns ? end.cpu_ns - start.cpu_ns : 0u;
+        result->unit_memory = driver->profile->units;
+        result->unit_memory_count = driver->profile->unit_count;
+    }
+    return status;
+}
+
 vitte_status_t vitte_driver_run(
     vitte_driver_t *driver,
     const vitte_driver_input_t *input,
@@ -3,18 +3,22 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 
 #include "../api/context.h"
 #include "../api/error.h"
 #include "../ast/ast.h"
+#include "../cache/cache.h"
 #include "../config/config.h"
 #include "../diagnostic/diagnostic.h"
+#include "../filesystem/filesystem.h"
+#include "../trace/trace.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#define VITTE_DRIVER_DEFAULT_OUTPUT_BUFFER_SIZE ((size_t)256u * 1024u)
 #define VITTE_DRIVER_MAX_PATH_LENGTH ((size_t)4096u)
 
 typedef enum vitte_driver_emit_kind {
@@ -43,6 +47,34 @@ typedef enum vitte_driver_stage {
     VITTE_DRIVER_STAGE_COUNT
 } vitte_driver_stage_t;
 
+/*
+ * Time and work attributed to one stage over a run. Stages that run once per
+ * module (lex, parse, semantic, ...) sum over modules, so with more than one
+ * job their wall time can exceed the run's.
+ */
+typedef struct vitte_driver_stage_profile {
+    uint64_t wall_ns;
+    uint64_t cpu_ns;
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    uint64_t arena_bytes;
+    size_t runs;
+} vitte_driver_stage_profile_t;
+
+/*
+ * Memory one module held once parsed, summed over the times it was parsed in
+ * a run (the root's direct imports are parsed twice).
+ */
+typedef struct vitte_driver_unit_memory {
+    const char *path;
+    size_t parses;
+    size_t source_bytes;
+    size_t token_bytes_reserved;
+    size_t token_bytes_used;
+    size_t ast_bytes_reserved;
+    size_t ast_bytes_used;
+} vitte_driver_unit_memory_t;
+
 typedef struct vitte_driver_options {
     const char *input_path;
     const char *output_path;
@@ -51,16 +83,30 @@ typedef struct vitte_driver_options {
     const char *sysroot_path;
     const char *target_triple;
     const char *c_compiler;
+    const char *cache_path;
+    /* Borrowed cache used instead of `cache_path`, e.g. the compile server's resident one. */
+    vitte_cache_t *shared_cache;
+    /* Borrowed trace receiving per-stage and per-import-unit spans; may be NULL. */
+    vitte_trace_t *trace;
     vitte_driver_emit_kind_t emit_kind;
     size_t optimization_level;
     size_t max_source_bytes;
     size_t max_ast_depth;
+    size_t max_cache_bytes;
     size_t max_diagnostics;
+    size_t jobs;
     bool warnings_as_errors;
     bool color_diagnostics;
     bool dump_ast;
     bool verbose;
     bool keep_intermediate_c;
+    bool separate_compilation;
+    /* Map large AST, HIR and IR arena blocks with huge pages where the OS allows. */
+    bool huge_pages;
+    /* Receives emitted C when there is no output path; NULL means stdout. */
+    FILE *output_stream;
+    /* Receives the C compiler's warnings from successful compiles and links; NULL drops them. */
+    FILE *c_warning_stream;
 } vitte_driver_options_t;
 
 typedef enum vitte_driver_input_kind {
@@ -76,13 +122,13 @@ typedef struct vitte_driver_input {
     const char *buffer;
     size_t size;
     bool owns_buffer;
+    vitte_fs_source_storage_t storage;
 } vitte_driver_input_t;
 
 typedef struct vitte_driver_output {
     vitte_driver_emit_kind_t kind;
     const char *path;
     const char *c_path;
-    const char *buffer;
     size_t bytes_written;
     size_t lines_written;
     size_t functions_emitted;
@@ -96,8 +142,18 @@ typedef struct vitte_driver_result {
     size_t error_count;
     size_t diagnostic_count;
     size_t stages_completed;
+    size_t modules_analyzed;
+    size_t modules_reused;
+    size_t objects_compiled;
+    size_t objects_reused;
+    vitte_driver_stage_profile_t stage_profiles[VITTE_DRIVER_STAGE_COUNT];
+    /* Whole run: wall clock, and CPU time of the calling thread only. */
+    uint64_t wall_ns;
+    uint64_t cpu_ns;
+    /* Per parsed module, in parse order; owned by the driver until its next run. */
+    const vitte_driver_unit_memory_t *unit_memory;
+    size_t unit_memory_count;
     char generated_c_path[VITTE_DRIVER_MAX_PATH_LENGTH];
-    char output_buffer[VITTE_DRIVER_DEFAULT_OUTPUT_BUFFER_SIZE];
     vitte_error_t last_error;
 } vitte_driver_result_t;
 
@@ -112,9 +168,20 @@ typedef struct vitte_driver {
     vitte_context_t *context;
     vitte_config_t config;
     vitte_diagnostic_options_t diagnostic_options;
-    vitte_diagnostic_t diagnostic_storage[128];
     vitte_diagnostic_bag_t diagnostics;
     vitte_driver_pipeline_t pipeline;
+    vitte_cache_t *module_cache;
+    bool owns_module_cache;
+    vitte_trace_t *trace;
+    bool huge_pages;
+    FILE *output_stream;
+    FILE *c_warning_stream;
+    /* Stage totals of the current run, written from worker threads too. */
+    struct vitte_driver_profile *profile;
+    /* Root-level imported ASTs, `VITTE_MODULE_MAX_IMPORTS` slots reused by every run. */
+    vitte_ast_t *imported_asts;
+    size_t analyzed_module_count;
+    size_t reused_module_count;
     vitte_error_t last_error;
 } vitte_driver_t;
 
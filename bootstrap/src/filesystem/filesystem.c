@@ -12,6 +12,13 @@
 #define VITTE_FS_MKDIR(path) mkdir((path), 0777)
 #endif
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define VITTE_FS_HAVE_MMAP 1
+#endif
+
 static void vitte_fs_set_error(
     vitte_error_t *error,
     vitte_status_t status,
@@ -45,6 +52,7 @@ void vitte_fs_options_init(vitte_fs_options_t *options) {
     memset(options, 0, sizeof(*options));
     options->max_file_bytes = VITTE_FS_DEFAULT_MAX_FILE_BYTES;
     options->null_terminate_reads = true;
+    options->map_sources = true;
 }
 
 void vitte_fs_result_init(vitte_fs_result_t *result) {
@@ -601,6 +609,233 @@ void vitte_fs_free(void *pointer) {
     free(pointer);
 }
 
+#ifdef VITTE_FS_HAVE_MMAP
+/*
+ * Reads `fd` to EOF into a growing heap buffer. Used for pipes and other
+ * special files whose size is not known up front.
+ */
+static vitte_status_t vitte_fs_read_stream_fd(
+    int fd,
+    const char *path,
+    char **buffer,
+    size_t *bytes_read,
+    const vitte_fs_options_t *options,
+    vitte_error_t *error
+) {
+    char *data = NULL;
+    size_t size = 0u;
+    size_t capacity = 0u;
+
+    for (;;) {
+        ssize_t count;
+
+        if (capacity - size < VITTE_FS_READ_CHUNK_SIZE + 1u) {
+            size_t next_capacity = capacity == 0u ? VITTE_FS_READ_CHUNK_SIZE * 2u : capacity * 2u;
+            char *next = (char *)realloc(data, next_capacity);
+
+            if (next == NULL) {
+                free(data);
+                vitte_fs_set_error(error, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_FS_E_ALLOC", "failed to allocate file buffer", path);
+                return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+            }
+            data = next;
+            capacity = next_capacity;
+        }
+        count = read(fd, data + size, VITTE_FS_READ_CHUNK_SIZE);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            free(data);
+            vitte_fs_set_error(error, VITTE_STATUS_ERROR_IO, "VITTE_FS_E_READ", "failed to read complete file", path);
+            return VITTE_STATUS_ERROR_IO;
+        }
+        if (count == 0) {
+            break;
+        }
+        size += (size_t)count;
+        if (options->max_file_bytes != 0u && size > options->max_file_bytes) {
+            free(data);
+            vitte_fs_set_error(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_FS_E_TOO_LARGE", "file exceeds configured maximum size", path);
+            return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+        }
+    }
+    if (options->null_terminate_reads) {
+        data[size] = '\0';
+    }
+    *buffer = data;
+    *bytes_read = size;
+    return VITTE_STATUS_OK;
+}
+
+static vitte_status_t vitte_fs_read_regular_fd(
+    int fd,
+    const char *path,
+    size_t size,
+    char **buffer,
+    const vitte_fs_options_t *options,
+    vitte_error_t *error
+) {
+    char *data;
+    size_t offset = 0u;
+
+    data = (char *)malloc(size + 1u);
+    if (data == NULL) {
+        vitte_fs_set_error(error, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_FS_E_ALLOC", "failed to allocate file buffer", path);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    while (offset < size) {
+        ssize_t count = read(fd, data + offset, size - offset);
+
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            free(data);
+            vitte_fs_set_error(error, VITTE_STATUS_ERROR_IO, "VITTE_FS_E_READ", "failed to read complete file", path);
+            return VITTE_STATUS_ERROR_IO;
+        }
+        offset += (size_t)count;
+    }
+    if (options->null_terminate_reads) {
+        data[size] = '\0';
+    }
+    *buffer = data;
+    return VITTE_STATUS_OK;
+}
+#endif
+
+vitte_status_t vitte_fs_read_source(
+    const char *path,
+    char **buffer,
+    size_t *bytes_read,
+    vitte_fs_source_storage_t *storage,
+    const vitte_fs_options_t *options,
+    vitte_error_t *error
+) {
+    vitte_fs_options_t defaults;
+    const vitte_fs_options_t *effective_options = options;
+    vitte_status_t status;
+#ifdef VITTE_FS_HAVE_MMAP
+    struct stat info;
+    char *data = NULL;
+    size_t size = 0u;
+    int fd;
+#endif
+
+    if (buffer != NULL) {
+        *buffer = NULL;
+    }
+    if (bytes_read != NULL) {
+        *bytes_read = 0u;
+    }
+    if (storage != NULL) {
+        *storage = VITTE_FS_SOURCE_NONE;
+    }
+    if (!vitte_fs_text_is_valid_path(path) || buffer == NULL || bytes_read == NULL || storage == NULL) {
+        vitte_fs_set_error(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_FS_E_ARGUMENT", "invalid source read arguments", path);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    if (effective_options == NULL) {
+        vitte_fs_options_init(&defaults);
+        effective_options = &defaults;
+    }
+
+#ifdef VITTE_FS_HAVE_MMAP
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        vitte_fs_set_error(error, VITTE_STATUS_ERROR_IO, "VITTE_FS_E_OPEN", "failed to open file for reading", path);
+        return VITTE_STATUS_ERROR_IO;
+    }
+    if (fstat(fd, &info) != 0) {
+        (void)close(fd);
+        vitte_fs_set_error(error, VITTE_STATUS_ERROR_IO, "VITTE_FS_E_READ", "failed to stat open file", path);
+        return VITTE_STATUS_ERROR_IO;
+    }
+    if (!S_ISREG(info.st_mode)) {
+        status = vitte_fs_read_stream_fd(fd, path, &data, &size, effective_options, error);
+        (void)close(fd);
+        if (status != VITTE_STATUS_OK) {
+            return status;
+        }
+        *buffer = data;
+        *bytes_read = size;
+        *storage = VITTE_FS_SOURCE_HEAP;
+        if (error != NULL) {
+            vitte_error_reset(error);
+        }
+        return VITTE_STATUS_OK;
+    }
+
+    size = info.st_size < 0 ? 0u : (size_t)info.st_size;
+    if (effective_options->max_file_bytes != 0u && size > effective_options->max_file_bytes) {
+        (void)close(fd);
+        vitte_fs_set_error(error, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_FS_E_TOO_LARGE", "file exceeds configured maximum size", path);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    /*
+     * Map only when the zero fill past EOF in the last page can serve as the
+     * terminator; a page-aligned file has no such byte and is read instead.
+     */
+    if (effective_options->map_sources && size >= VITTE_FS_MIN_MAP_BYTES) {
+        long page_size = sysconf(_SC_PAGESIZE);
+
+        if (!effective_options->null_terminate_reads ||
+            (page_size > 0 && size % (size_t)page_size != 0u)) {
+            void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (mapping != MAP_FAILED) {
+                (void)close(fd);
+                *buffer = (char *)mapping;
+                *bytes_read = size;
+                *storage = VITTE_FS_SOURCE_MAPPED;
+                if (error != NULL) {
+                    vitte_error_reset(error);
+                }
+                return VITTE_STATUS_OK;
+            }
+        }
+    }
+
+    status = vitte_fs_read_regular_fd(fd, path, size, &data, effective_options, error);
+    (void)close(fd);
+    if (status != VITTE_STATUS_OK) {
+        return status;
+    }
+    *buffer = data;
+    *bytes_read = size;
+    *storage = VITTE_FS_SOURCE_HEAP;
+    if (error != NULL) {
+        vitte_error_reset(error);
+    }
+    return VITTE_STATUS_OK;
+#else
+    status = vitte_fs_read_all_alloc(path, buffer, bytes_read, effective_options, error);
+    if (status == VITTE_STATUS_OK) {
+        *storage = VITTE_FS_SOURCE_HEAP;
+    }
+    return status;
+#endif
+}
+
+void vitte_fs_free_source(void *pointer, size_t size, vitte_fs_source_storage_t storage) {
+    if (pointer == NULL) {
+        return;
+    }
+#ifdef VITTE_FS_HAVE_MMAP
+    if (storage == VITTE_FS_SOURCE_MAPPED) {
+        (void)munmap(pointer, size);
+        return;
+    }
+#else
+    (void)size;
+#endif
+    if (storage != VITTE_FS_SOURCE_NONE) {
+        free(pointer);
+    }
+}
+
 static vitte_status_t vitte_fs_write_all_mode(
     const char *path,
     const void *data,
@@ -16,6 +16,7 @@ extern "C" {
 #define VITTE_FS_MAX_EXT ((size_t)64u)
 #define VITTE_FS_READ_CHUNK_SIZE ((size_t)8192u)
 #define VITTE_FS_DEFAULT_MAX_FILE_BYTES ((size_t)64u * 1024u * 1024u)
+#define VITTE_FS_MIN_MAP_BYTES ((size_t)16u * 1024u)
 
 typedef struct vitte_fs_path {
     char text[VITTE_FS_MAX_PATH];
@@ -37,6 +38,12 @@ typedef struct vitte_fs_entry {
     bool exists;
 } vitte_fs_entry_t;
 
+typedef enum vitte_fs_source_storage {
+    VITTE_FS_SOURCE_NONE = 0,
+    VITTE_FS_SOURCE_HEAP,
+    VITTE_FS_SOURCE_MAPPED
+} vitte_fs_source_storage_t;
+
 typedef struct vitte_fs_stats {
     size_t bytes_read;
     size_t bytes_written;
@@ -49,6 +56,7 @@ typedef struct vitte_fs_options {
     size_t max_file_bytes;
     bool null_terminate_reads;
     bool create_parent_directories;
+    bool map_sources;
 } vitte_fs_options_t;
 
 typedef struct vitte_fs_result {
@@ -120,6 +128,15 @@ vitte_status_t vitte_fs_read_all_alloc(
     vitte_error_t *error
 );
 void vitte_fs_free(void *pointer);
+vitte_status_t vitte_fs_read_source(
+    const char *path,
+    char **buffer,
+    size_t *bytes_read,
+    vitte_fs_source_storage_t *storage,
+    const vitte_fs_options_t *options,
+    vitte_error_t *error
+);
+void vitte_fs_free_source(void *pointer, size_t size, vitte_fs_source_storage_t storage);
 
 vitte_status_t vitte_fs_write_all(
     const char *path,
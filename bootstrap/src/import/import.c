@@ -1,8 +1,12 @@
 #include "import.h"
 
 #include <ctype.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "../util/util.h"
+
 static void vitte_import_set_error(
     vitte_error_t *error,
     vitte_status_t status,
@@ -68,6 +72,7 @@ void vitte_import_options_init(vitte_import_options_t *options) {
     options->use_cache = true;
     options->max_depth = VITTE_IMPORT_MAX_DEPTH;
     options->max_source_bytes = VITTE_IMPORT_MAX_SOURCE_BYTES;
+    options->max_cache_bytes = VITTE_IMPORT_DEFAULT_CACHE_BYTES;
 }
 
 void vitte_import_request_init(vitte_import_request_t *request) {
@@ -92,7 +97,7 @@ void vitte_import_result_destroy(vitte_import_result_t *result) {
         return;
     }
     if (result->source_owned) {
-        vitte_fs_free(result->source);
+        vitte_fs_free_source(result->source, result->source_size, result->source_storage);
     }
     memset(result, 0, sizeof(*result));
 }
@@ -186,6 +191,9 @@ vitte_status_t vitte_import_resolver_init(
     if (resolver->options.max_source_bytes == 0u) {
         resolver->options.max_source_bytes = VITTE_IMPORT_MAX_SOURCE_BYTES;
     }
+    if (resolver->options.max_cache_bytes == 0u) {
+        resolver->options.max_cache_bytes = VITTE_IMPORT_DEFAULT_CACHE_BYTES;
+    }
     vitte_import_stats_init(&resolver->stats);
     vitte_error_init(&resolver->last_error);
     resolver->initialized = true;
@@ -200,19 +208,43 @@ const vitte_error_t *vitte_import_resolver_last_error(const vitte_import_resolve
     return resolver != NULL ? &resolver->last_error : vitte_error_last();
 }
 
+static void vitte_import_cache_entry_free(vitte_import_cache_entry_t *entry) {
+    if (entry->module.source != NULL) {
+        vitte_fs_free_source(entry->module.source, entry->module.source_size, entry->module.source_storage);
+    }
+    free(entry->module_name);
+    free(entry->base_path);
+    free(entry);
+}
+
 void vitte_import_resolver_clear_cache(vitte_import_resolver_t *resolver) {
+    vitte_import_cache_entry_t *entry;
     size_t index;
 
     if (resolver == NULL) {
         return;
     }
-    for (index = 0u; index < VITTE_IMPORT_MAX_CACHE_ENTRIES; index++) {
-        if (resolver->cache[index].occupied && resolver->cache[index].module.source != NULL) {
-            vitte_fs_free(resolver->cache[index].module.source);
-        }
-        memset(&resolver->cache[index], 0, sizeof(resolver->cache[index]));
-    }
+    entry = resolver->cache_newest;
+    while (entry != NULL) {
+        vitte_import_cache_entry_t *older = entry->older;
+
+        vitte_import_cache_entry_free(entry);
+        entry = older;
+    }
+    for (index = 0u; index < resolver->probe_capacity; index++) {
+        free(resolver->probes[index].path);
+    }
+    free(resolver->cache_slots);
+    free(resolver->probes);
+    resolver->cache_slots = NULL;
+    resolver->cache_capacity = 0u;
+    resolver->cache_newest = NULL;
+    resolver->cache_oldest = NULL;
+    resolver->probes = NULL;
+    resolver->probe_capacity = 0u;
+    resolver->probe_count = 0u;
     resolver->stats.cache_entry_count = 0u;
+    resolver->stats.cache_bytes = 0u;
 }
 
 void vitte_import_resolver_destroy(vitte_import_resolver_t *resolver) {
@@ -287,38 +319,223 @@ static const char *vitte_import_request_base_path(const vitte_import_request_t *
     return buffer;
 }
 
+static size_t vitte_import_cache_hash(const char *module_name, const char *base_path) {
+    /* The '/' joiner cannot appear at the end of a valid module name. */
+    return (size_t)vitte_util_hash_text(
+        vitte_util_hash_text(vitte_util_hash_text(VITTE_UTIL_HASH_SEED, module_name), "/"),
+        base_path
+    );
+}
+
+static char *vitte_import_strdup(const char *text) {
+    size_t length = strlen(text);
+    char *copy = (char *)malloc(length + 1u);
+
+    if (copy != NULL) {
+        (void)memcpy(copy, text, length + 1u);
+    }
+    return copy;
+}
+
+/* Returns the slot holding the entry keyed by (`module_name`, `base_path`), or
+ * the empty slot where it would be inserted. */
+static vitte_import_cache_entry_t **vitte_import_cache_probe(
+    const vitte_import_resolver_t *resolver,
+    const char *module_name,
+    const char *base_path,
+    size_t hash
+) {
+    size_t mask = resolver->cache_capacity - 1u;
+    size_t position = hash & mask;
+
+    while (resolver->cache_slots[position] != NULL) {
+        const vitte_import_cache_entry_t *entry = resolver->cache_slots[position];
+
+        if (entry->hash == hash &&
+            strcmp(entry->module_name, module_name) == 0 &&
+            strcmp(entry->base_path, base_path) == 0) {
+            break;
+        }
+        position = (position + 1u) & mask;
+    }
+    return &resolver->cache_slots[position];
+}
+
+static bool vitte_import_cache_grow(vitte_import_resolver_t *resolver) {
+    vitte_import_cache_entry_t **old_slots = resolver->cache_slots;
+    size_t old_capacity = resolver->cache_capacity;
+    size_t capacity = old_capacity == 0u ? VITTE_IMPORT_INITIAL_CACHE_CAPACITY : old_capacity * 2u;
+    size_t position;
+
+    if (capacity < old_capacity || capacity > SIZE_MAX / sizeof(*old_slots)) {
+        return false;
+    }
+    resolver->cache_slots = (vitte_import_cache_entry_t **)calloc(capacity, sizeof(*resolver->cache_slots));
+    if (resolver->cache_slots == NULL) {
+        resolver->cache_slots = old_slots;
+        return false;
+    }
+    resolver->cache_capacity = capacity;
+    for (position = 0u; position < old_capacity; position++) {
+        if (old_slots[position] != NULL) {
+            size_t target = old_slots[position]->hash & (capacity - 1u);
+            while (resolver->cache_slots[target] != NULL) {
+                target = (target + 1u) & (capacity - 1u);
+            }
+            resolver->cache_slots[target] = old_slots[position];
+        }
+    }
+    free(old_slots);
+    return true;
+}
+
+/* Removes `entry` from the slot table, shifting later members of its probe
+ * run back so lookups never need tombstones. */
+static void vitte_import_cache_unindex(vitte_import_resolver_t *resolver, const vitte_import_cache_entry_t *entry) {
+    size_t mask = resolver->cache_capacity - 1u;
+    size_t hole = entry->hash & mask;
+    size_t next;
+
+    while (resolver->cache_slots[hole] != entry) {
+        hole = (hole + 1u) & mask;
+    }
+    resolver->cache_slots[hole] = NULL;
+    next = (hole + 1u) & mask;
+    while (resolver->cache_slots[next] != NULL) {
+        size_t home = resolver->cache_slots[next]->hash & mask;
+
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            resolver->cache_slots[hole] = resolver->cache_slots[next];
+            resolver->cache_slots[next] = NULL;
+            hole = next;
+        }
+        next = (next + 1u) & mask;
+    }
+}
+
+static void vitte_import_cache_unlink(vitte_import_resolver_t *resolver, vitte_import_cache_entry_t *entry) {
+    if (entry->newer != NULL) {
+        entry->newer->older = entry->older;
+    } else {
+        resolver->cache_newest = entry->older;
+    }
+    if (entry->older != NULL) {
+        entry->older->newer = entry->newer;
+    } else {
+        resolver->cache_oldest = entry->newer;
+    }
+    entry->newer = NULL;
+    entry->older = NULL;
+}
+
+static void vitte_import_cache_touch(vitte_import_resolver_t *resolver, vitte_import_cache_entry_t *entry) {
+    if (resolver->cache_newest == entry) {
+        return;
+    }
+    if (entry->newer != NULL || entry->older != NULL || resolver->cache_oldest == entry) {
+        vitte_import_cache_unlink(resolver, entry);
+    }
+    entry->older = resolver->cache_newest;
+    if (resolver->cache_newest != NULL) {
+        resolver->cache_newest->newer = entry;
+    }
+    resolver->cache_newest = entry;
+    if (resolver->cache_oldest == NULL) {
+        resolver->cache_oldest = entry;
+    }
+}
+
+/* Evicts least recently used entries until the cache fits `max_cache_bytes`.
+ * `keep` is the entry the current request is about to return. */
+static void vitte_import_cache_evict(vitte_import_resolver_t *resolver, const vitte_import_cache_entry_t *keep) {
+    while (resolver->stats.cache_bytes > resolver->options.max_cache_bytes &&
+           resolver->cache_oldest != NULL && resolver->cache_oldest != keep) {
+        vitte_import_cache_entry_t *victim = resolver->cache_oldest;
+
+        vitte_import_cache_unindex(resolver, victim);
+        vitte_import_cache_unlink(resolver, victim);
+        resolver->stats.cache_bytes -= victim->bytes;
+        resolver->stats.cache_entry_count--;
+        resolver->stats.cache_eviction_count++;
+        vitte_import_cache_entry_free(victim);
+    }
+}
+
 static vitte_import_cache_entry_t *vitte_import_cache_find(
     vitte_import_resolver_t *resolver,
     const char *module_name,
     const char *base_path
 ) {
-    size_t index;
+    vitte_import_cache_entry_t *entry;
 
-    if (resolver == NULL || module_name == NULL || base_path == NULL || !resolver->options.use_cache) {
+    if (resolver == NULL || module_name == NULL || base_path == NULL ||
+        !resolver->options.use_cache || resolver->stats.cache_entry_count == 0u) {
         return NULL;
     }
-    for (index = 0u; index < VITTE_IMPORT_MAX_CACHE_ENTRIES; index++) {
-        if (resolver->cache[index].occupied &&
-            strcmp(resolver->cache[index].module_name, module_name) == 0 &&
-            strcmp(resolver->cache[index].base_path, base_path) == 0) {
-            return &resolver->cache[index];
-        }
+    entry = *vitte_import_cache_probe(resolver, module_name, base_path, vitte_import_cache_hash(module_name, base_path));
+    if (entry != NULL) {
+        vitte_import_cache_touch(resolver, entry);
     }
-    return NULL;
+    return entry;
 }
 
-static vitte_import_cache_entry_t *vitte_import_cache_slot(vitte_import_resolver_t *resolver) {
-    size_t index;
+/* Answers `vitte_fs_is_file` for a candidate path, remembering the result so
+ * every importer probing the same search path shares one stat call. */
+static bool vitte_import_is_file(vitte_import_resolver_t *resolver, const char *path) {
+    vitte_import_probe_t *probe;
+    size_t hash;
+    size_t mask;
+    bool is_file;
 
     if (resolver == NULL || !resolver->options.use_cache) {
-        return NULL;
+        return vitte_fs_is_file(path);
     }
-    for (index = 0u; index < VITTE_IMPORT_MAX_CACHE_ENTRIES; index++) {
-        if (!resolver->cache[index].occupied) {
-            return &resolver->cache[index];
+    if ((resolver->probe_count + 1u) * 2u > resolver->probe_capacity) {
+        vitte_import_probe_t *old_probes = resolver->probes;
+        size_t old_capacity = resolver->probe_capacity;
+        size_t capacity = old_capacity == 0u ? VITTE_IMPORT_INITIAL_CACHE_CAPACITY : old_capacity * 2u;
+        size_t position;
+
+        if (capacity < old_capacity || capacity > SIZE_MAX / sizeof(*old_probes)) {
+            return vitte_fs_is_file(path);
         }
+        resolver->probes = (vitte_import_probe_t *)calloc(capacity, sizeof(*resolver->probes));
+        if (resolver->probes == NULL) {
+            resolver->probes = old_probes;
+            return vitte_fs_is_file(path);
+        }
+        resolver->probe_capacity = capacity;
+        for (position = 0u; position < old_capacity; position++) {
+            if (old_probes[position].path != NULL) {
+                size_t target = old_probes[position].hash & (capacity - 1u);
+                while (resolver->probes[target].path != NULL) {
+                    target = (target + 1u) & (capacity - 1u);
+                }
+                resolver->probes[target] = old_probes[position];
+            }
+        }
+        free(old_probes);
+    }
+
+    hash = (size_t)vitte_util_hash_text(VITTE_UTIL_HASH_SEED, path);
+    mask = resolver->probe_capacity - 1u;
+    probe = &resolver->probes[hash & mask];
+    while (probe->path != NULL) {
+        if (probe->hash == hash && strcmp(probe->path, path) == 0) {
+            resolver->stats.probe_hit_count++;
+            return probe->is_file;
+        }
+        probe = &resolver->probes[((size_t)(probe - resolver->probes) + 1u) & mask];
+    }
+    resolver->stats.probe_miss_count++;
+    is_file = vitte_fs_is_file(path);
+    probe->path = vitte_import_strdup(path);
+    if (probe->path != NULL) {
+        probe->hash = hash;
+        probe->is_file = is_file;
+        resolver->probe_count++;
     }
-    return NULL;
+    return is_file;
 }
 
 static void vitte_import_result_from_cache(vitte_import_result_t *result, const vitte_import_cache_entry_t *entry) {
@@ -338,6 +555,7 @@ static void vitte_import_result_from_cache(vitte_import_result_t *result, const
 }
 
 static bool vitte_import_try_candidate(
+    vitte_import_resolver_t *resolver,
     const vitte_import_path_t *base,
     const vitte_import_path_t *relative,
     vitte_import_path_t *out
@@ -354,7 +572,7 @@ static bool vitte_import_try_candidate(
     if (vitte_fs_path_join(&fs_out, &fs_base, relative->text) != VITTE_STATUS_OK) {
         return false;
     }
-    if (!vitte_fs_is_file(fs_out.text)) {
+    if (!vitte_import_is_file(resolver, fs_out.text)) {
         vitte_import_path_t alternate = *relative;
         if (alternate.length < 4u || strcmp(alternate.text + alternate.length - 4u, ".vit") != 0 || alternate.length + 1u >= VITTE_FS_MAX_PATH) {
             return false;
@@ -364,7 +582,7 @@ static bool vitte_import_try_candidate(
         if (vitte_fs_path_join(&fs_out, &fs_base, alternate.text) != VITTE_STATUS_OK) {
             return false;
         }
-        if (!vitte_fs_is_file(fs_out.text)) {
+        if (!vitte_import_is_file(resolver, fs_out.text)) {
             return false;
         }
     }
@@ -403,7 +621,14 @@ static vitte_status_t vitte_import_read_source(
     options.max_file_bytes = resolver->options.max_source_bytes;
     options.null_terminate_reads = true;
     vitte_error_init(&fs_error);
-    status = vitte_fs_read_all_alloc(module->resolved_path.text, &module->source, &module->source_size, &options, &fs_error);
+    status = vitte_fs_read_source(
+        module->resolved_path.text,
+        &module->source,
+        &module->source_size,
+        &module->source_storage,
+        &options,
+        &fs_error
+    );
     if (status != VITTE_STATUS_OK) {
         vitte_import_resolver_set_error(resolver, status, "VITTE_IMPORT_E_READ", "failed to read imported module source", module->resolved_path.text);
         return status;
@@ -421,7 +646,7 @@ static vitte_status_t vitte_import_cache_store(
     bool read_source,
     vitte_import_cache_entry_t **stored
 ) {
-    vitte_import_cache_entry_t *slot;
+    vitte_import_cache_entry_t *entry;
     vitte_status_t status;
 
     if (stored != NULL) {
@@ -430,34 +655,37 @@ static vitte_status_t vitte_import_cache_store(
     if (resolver == NULL || module_name == NULL || base_path == NULL || resolved_path == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
-    slot = vitte_import_cache_slot(resolver);
-    if (slot == NULL) {
-        /* The bootstrap graph can contain more importer bases than the bounded cache.
-         * Reclaim the cache and continue resolving deterministically. */
-        vitte_import_resolver_clear_cache(resolver);
-        slot = &resolver->cache[0];
-    }
-    memset(slot, 0, sizeof(*slot));
-    slot->occupied = true;
-    if (!vitte_import_copy_text(slot->module_name, sizeof(slot->module_name), module_name) ||
-        !vitte_import_copy_text(slot->base_path, sizeof(slot->base_path), base_path) ||
-        !vitte_import_copy_text(slot->module.name, sizeof(slot->module.name), module_name)) {
-        /* Oversized names are still valid resolver inputs; disable caching for this entry. */
-        slot->module_name[0] = '\0';
-        slot->base_path[0] = '\0';
-        slot->module.name[0] = '\0';
-    }
-    slot->module.resolved_path = *resolved_path;
+    entry = (vitte_import_cache_entry_t *)calloc(1u, sizeof(*entry));
+    if (entry != NULL) {
+        entry->module_name = vitte_import_strdup(module_name);
+        entry->base_path = vitte_import_strdup(base_path);
+    }
+    if (entry == NULL || entry->module_name == NULL || entry->base_path == NULL ||
+        ((resolver->stats.cache_entry_count + 1u) * 2u > resolver->cache_capacity && !vitte_import_cache_grow(resolver))) {
+        if (entry != NULL) {
+            vitte_import_cache_entry_free(entry);
+        }
+        vitte_import_resolver_set_error(resolver, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_IMPORT_E_ALLOC", "failed to allocate import cache entry", module_name);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    entry->hash = vitte_import_cache_hash(module_name, base_path);
+    (void)vitte_import_copy_text(entry->module.name, sizeof(entry->module.name), module_name);
+    entry->module.resolved_path = *resolved_path;
     if (read_source) {
-        status = vitte_import_read_source(resolver, &slot->module);
+        status = vitte_import_read_source(resolver, &entry->module);
         if (status != VITTE_STATUS_OK) {
-            memset(slot, 0, sizeof(*slot));
+            vitte_import_cache_entry_free(entry);
             return status;
         }
     }
+    entry->bytes = sizeof(*entry) + strlen(module_name) + strlen(base_path) + 2u + entry->module.source_size;
+    *vitte_import_cache_probe(resolver, module_name, base_path, entry->hash) = entry;
     resolver->stats.cache_entry_count++;
+    resolver->stats.cache_bytes += entry->bytes;
+    vitte_import_cache_touch(resolver, entry);
+    vitte_import_cache_evict(resolver, entry);
     if (stored != NULL) {
-        *stored = slot;
+        *stored = entry;
     }
     return VITTE_STATUS_OK;
 }
@@ -485,7 +713,44 @@ static vitte_status_t vitte_import_result_from_module(
     return VITTE_STATUS_OK;
 }
 
+/* Without a cache the result owns its source buffer. */
+static vitte_status_t vitte_import_resolve_uncached(
+    vitte_import_resolver_t *resolver,
+    const char *module_name,
+    const vitte_import_path_t *resolved_path,
+    bool read_source,
+    vitte_import_result_t *result
+) {
+    vitte_import_module_t module;
+    vitte_status_t status;
+
+    memset(&module, 0, sizeof(module));
+    (void)vitte_import_copy_text(module.name, sizeof(module.name), module_name);
+    module.resolved_path = *resolved_path;
+    status = read_source ? vitte_import_read_source(resolver, &module) : VITTE_STATUS_OK;
+    if (status == VITTE_STATUS_OK) {
+        status = vitte_import_result_from_module(result, &module, false);
+        if (status != VITTE_STATUS_OK) {
+            vitte_import_resolver_set_error(resolver, status, "VITTE_IMPORT_E_RESULT", "failed to copy import result", module_name);
+        }
+    }
+    if (status != VITTE_STATUS_OK) {
+        if (module.source != NULL) {
+            vitte_fs_free_source(module.source, module.source_size, module.source_storage);
+        }
+        resolver->stats.failed_count++;
+        vitte_error_copy(&result->error, &resolver->last_error);
+        result->status = status;
+        return status;
+    }
+    result->source_owned = module.source != NULL;
+    result->source_storage = module.source_storage;
+    vitte_error_reset(&resolver->last_error);
+    return VITTE_STATUS_OK;
+}
+
 static bool vitte_import_resolve_relative(
+    vitte_import_resolver_t *resolver,
     const vitte_import_request_t *request,
     const vitte_import_path_t *module_path,
     vitte_import_path_t *resolved
@@ -501,12 +766,12 @@ static bool vitte_import_resolve_relative(
         return false;
     }
     if (vitte_fs_path_join(&candidate, &base, module_path->text) == VITTE_STATUS_OK &&
-        vitte_fs_is_file(candidate.text)) {
+        vitte_import_is_file(resolver, candidate.text)) {
         return vitte_import_path_from_fs(resolved, &candidate);
     }
     if (vitte_import_make_mod_candidate(module_path, &mod_candidate) &&
         vitte_fs_path_join(&candidate, &base, mod_candidate.text) == VITTE_STATUS_OK &&
-        vitte_fs_is_file(candidate.text)) {
+        vitte_import_is_file(resolver, candidate.text)) {
         return vitte_import_path_from_fs(resolved, &candidate);
     }
     return false;
@@ -524,11 +789,11 @@ static bool vitte_import_resolve_search_paths(
         return false;
     }
     for (index = 0u; index < resolver->search_path_count; index++) {
-        if (vitte_import_try_candidate(&resolver->search_paths[index].path, module_path, resolved)) {
+        if (vitte_import_try_candidate(resolver, &resolver->search_paths[index].path, module_path, resolved)) {
             return true;
         }
         if (vitte_import_make_mod_candidate(module_path, &mod_candidate) &&
-            vitte_import_try_candidate(&resolver->search_paths[index].path, &mod_candidate, resolved)) {
+            vitte_import_try_candidate(resolver, &resolver->search_paths[index].path, &mod_candidate, resolved)) {
             return true;
         }
     }
@@ -536,6 +801,7 @@ static bool vitte_import_resolve_search_paths(
 }
 
 static bool vitte_import_resolve_ancestor_paths(
+    vitte_import_resolver_t *resolver,
     const vitte_import_request_t *request,
     const vitte_import_path_t *module_path,
     vitte_import_path_t *resolved
@@ -559,8 +825,8 @@ static bool vitte_import_resolve_ancestor_paths(
         if (!vitte_import_path_from_fs(&base, &current)) {
             return false;
         }
-        if (vitte_import_try_candidate(&base, module_path, resolved) ||
-            (has_mod_candidate && vitte_import_try_candidate(&base, &mod_candidate, resolved))) {
+        if (vitte_import_try_candidate(resolver, &base, module_path, resolved) ||
+            (has_mod_candidate && vitte_import_try_candidate(resolver, &base, &mod_candidate, resolved))) {
             return true;
         }
         if (vitte_fs_parent_path(current.text, &parent) != VITTE_STATUS_OK ||
@@ -630,6 +896,9 @@ vitte_status_t vitte_import_resolve(
             result->status = status;
             return status;
         }
+        entry->bytes += entry->module.source_size;
+        resolver->stats.cache_bytes += entry->module.source_size;
+        vitte_import_cache_evict(resolver, entry);
         resolver->stats.cache_hit_count++;
         vitte_import_result_from_cache(result, entry);
         vitte_error_reset(&resolver->last_error);
@@ -637,11 +906,11 @@ vitte_status_t vitte_import_resolve(
     }
     resolver->stats.cache_miss_count++;
 
-    if (request->relative && vitte_import_resolve_relative(request, &module_path, &resolved_path)) {
+    if (request->relative && vitte_import_resolve_relative(resolver, request, &module_path, &resolved_path)) {
         /* resolved */
     } else if (vitte_import_resolve_search_paths(resolver, &module_path, &resolved_path)) {
         /* resolved */
-    } else if (vitte_import_resolve_ancestor_paths(request, &module_path, &resolved_path)) {
+    } else if (vitte_import_resolve_ancestor_paths(resolver, request, &module_path, &resolved_path)) {
         /* resolved */
     } else {
         resolver->stats.failed_count++;
@@ -651,6 +920,9 @@ vitte_status_t vitte_import_resolve(
         return VITTE_STATUS_ERROR_IO;
     }
 
+    if (!resolver->options.use_cache) {
+        return vitte_import_resolve_uncached(resolver, request->module_name, &resolved_path, should_read_source, result);
+    }
     status = vitte_import_cache_store(resolver, request->module_name, base_path, &resolved_path, should_read_source, &stored);
     if (status != VITTE_STATUS_OK) {
         resolver->stats.failed_count++;
@@ -13,7 +13,8 @@ extern "C" {
 
 #define VITTE_IMPORT_MAX_MODULE_NAME ((size_t)256u)
 #define VITTE_IMPORT_MAX_SEARCH_PATHS ((size_t)32u)
-#define VITTE_IMPORT_MAX_CACHE_ENTRIES ((size_t)128u)
+#define VITTE_IMPORT_INITIAL_CACHE_CAPACITY ((size_t)64u)
+#define VITTE_IMPORT_DEFAULT_CACHE_BYTES ((size_t)64u * 1024u * 1024u)
 #define VITTE_IMPORT_MAX_DEPTH ((size_t)64u)
 #define VITTE_IMPORT_MAX_SOURCE_BYTES VITTE_FS_DEFAULT_MAX_FILE_BYTES
 
@@ -31,6 +32,7 @@ typedef struct vitte_import_options {
     bool use_cache;
     size_t max_depth;
     size_t max_source_bytes;
+    size_t max_cache_bytes;
 } vitte_import_options_t;
 
 typedef struct vitte_import_request {
@@ -47,6 +49,7 @@ typedef struct vitte_import_module {
     char *source;
     size_t source_size;
     bool source_loaded;
+    vitte_fs_source_storage_t source_storage;
 } vitte_import_module_t;
 
 typedef struct vitte_import_result {
@@ -57,25 +60,45 @@ typedef struct vitte_import_result {
     size_t source_size;
     bool source_loaded;
     bool source_owned;
+    vitte_fs_source_storage_t source_storage;
     bool from_cache;
     vitte_error_t error;
 } vitte_import_result_t;
 
+/*
+ * Cache entries are allocated individually and keyed by (module name,
+ * importer base path). `newer`/`older` link them in recency order for LRU
+ * eviction; `bytes` is what the entry charges against `max_cache_bytes`.
+ */
 typedef struct vitte_import_cache_entry {
-    bool occupied;
-    char module_name[VITTE_IMPORT_MAX_MODULE_NAME];
-    char base_path[VITTE_FS_MAX_PATH];
+    size_t hash;
+    char *module_name;
+    char *base_path;
+    size_t bytes;
+    struct vitte_import_cache_entry *newer;
+    struct vitte_import_cache_entry *older;
     vitte_import_module_t module;
 } vitte_import_cache_entry_t;
 
+/* Memoized `vitte_fs_is_file` answer for one candidate path. */
+typedef struct vitte_import_probe {
+    size_t hash;
+    char *path;
+    bool is_file;
+} vitte_import_probe_t;
+
 typedef struct vitte_import_stats {
     size_t resolve_count;
     size_t cache_hit_count;
     size_t cache_miss_count;
+    size_t cache_eviction_count;
     size_t failed_count;
     size_t bytes_read;
     size_t search_path_count;
     size_t cache_entry_count;
+    size_t cache_bytes;
+    size_t probe_hit_count;
+    size_t probe_miss_count;
 } vitte_import_stats_t;
 
 typedef struct vitte_import_resolver {
@@ -83,7 +106,13 @@ typedef struct vitte_import_resolver {
     vitte_import_options_t options;
     vitte_import_search_path_t search_paths[VITTE_IMPORT_MAX_SEARCH_PATHS];
     size_t search_path_count;
-    vitte_import_cache_entry_t cache[VITTE_IMPORT_MAX_CACHE_ENTRIES];
+    vitte_import_cache_entry_t **cache_slots;
+    size_t cache_capacity;
+    vitte_import_cache_entry_t *cache_newest;
+    vitte_import_cache_entry_t *cache_oldest;
+    vitte_import_probe_t *probes;
+    size_t probe_capacity;
+    size_t probe_count;
     vitte_import_stats_t stats;
     vitte_error_t last_error;
 } vitte_import_resolver_t;
@@ -0,0 +1,211 @@
+#include "intern.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "../util/util.h"
+
+static void vitte_interner_set_error(
+    vitte_interner_t *interner,
+    vitte_status_t status,
+    const char *code,
+    const char *message,
+    const char *details
+) {
+    if (interner != NULL) {
+        vitte_error_set_details(&interner->last_error, status, code, message, details);
+    }
+}
+
+static size_t vitte_interner_hash(const char *text, size_t length) {
+    return (size_t)vitte_util_hash_bytes(VITTE_UTIL_HASH_SEED, text, length);
+}
+
+static vitte_interner_slot_t *vitte_interner_probe(
+    const vitte_interner_t *interner,
+    const char *text,
+    size_t length,
+    size_t hash
+) {
+    size_t mask = interner->capacity - 1u;
+    size_t position = hash & mask;
+
+    for (;;) {
+        vitte_interner_slot_t *slot = &interner->slots[position];
+        if (slot->text == NULL ||
+            (slot->hash == hash && slot->length == length && memcmp(slot->text, text, length) == 0)) {
+            return slot;
+        }
+        position = (position + 1u) & mask;
+    }
+}
+
+static bool vitte_interner_grow(vitte_interner_t *interner) {
+    vitte_interner_slot_t *old_slots = interner->slots;
+    size_t old_capacity = interner->capacity;
+    size_t capacity = old_capacity == 0u ? VITTE_INTERNER_INITIAL_CAPACITY : old_capacity * 2u;
+    vitte_allocator_t *allocator = &interner->arena.config.allocator;
+    size_t index;
+
+    if (capacity < old_capacity || capacity > SIZE_MAX / sizeof(*old_slots)) {
+        return false;
+    }
+    interner->slots = (vitte_interner_slot_t *)allocator->alloc(allocator->user, capacity * sizeof(*interner->slots));
+    if (interner->slots == NULL) {
+        interner->slots = old_slots;
+        return false;
+    }
+    memset(interner->slots, 0, capacity * sizeof(*interner->slots));
+    interner->capacity = capacity;
+    for (index = 0u; index < old_capacity; index++) {
+        if (old_slots[index].text != NULL) {
+            size_t position = old_slots[index].hash & (capacity - 1u);
+            while (interner->slots[position].text != NULL) {
+                position = (position + 1u) & (capacity - 1u);
+            }
+            interner->slots[position] = old_slots[index];
+        }
+    }
+    if (old_slots != NULL) {
+        allocator->free(allocator->user, old_slots);
+    }
+    return true;
+}
+
+vitte_status_t vitte_interner_init(vitte_interner_t *interner, const vitte_allocator_t *allocator) {
+    vitte_arena_config_t config;
+    vitte_status_t status;
+
+    if (interner == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    memset(interner, 0, sizeof(*interner));
+    vitte_error_init(&interner->last_error);
+
+    vitte_arena_config_init(&config);
+    if (allocator != NULL && vitte_allocator_is_valid(allocator)) {
+        config.allocator = *allocator;
+    }
+    config.initial_block_size = VITTE_INTERNER_BLOCK_SIZE;
+    config.max_block_size = VITTE_INTERNER_BLOCK_SIZE * 16u;
+    status = vitte_arena_init(&interner->arena, &config);
+    if (status != VITTE_STATUS_OK) {
+        vitte_error_copy(&interner->last_error, vitte_arena_last_error(&interner->arena));
+        return status;
+    }
+    if (!vitte_interner_grow(interner)) {
+        vitte_arena_destroy(&interner->arena);
+        vitte_interner_set_error(interner, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_INTERN_E_MEMORY", "cannot allocate interner table", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    interner->initialized = true;
+    return VITTE_STATUS_OK;
+}
+
+void vitte_interner_destroy(vitte_interner_t *interner) {
+    if (interner == NULL) {
+        return;
+    }
+    if (interner->slots != NULL) {
+        interner->arena.config.allocator.free(interner->arena.config.allocator.user, interner->slots);
+    }
+    vitte_parallel_mutex_destroy(&interner->lock);
+    vitte_arena_destroy(&interner->arena);
+    memset(interner, 0, sizeof(*interner));
+}
+
+bool vitte_interner_is_initialized(const vitte_interner_t *interner) {
+    return interner != NULL && interner->initialized;
+}
+
+const vitte_error_t *vitte_interner_last_error(const vitte_interner_t *interner) {
+    return interner != NULL ? &interner->last_error : vitte_error_last();
+}
+
+/*
+ * Once parsing runs on several threads the interner is shared by every lexer,
+ * so lookups and inserts are serialized. Single-threaded users never enable
+ * the lock and pay only a flag test.
+ */
+vitte_status_t vitte_interner_enable_locking(vitte_interner_t *interner) {
+    vitte_status_t status;
+
+    if (!vitte_interner_is_initialized(interner)) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    status = vitte_parallel_mutex_init(&interner->lock);
+    if (status != VITTE_STATUS_OK) {
+        vitte_interner_set_error(interner, status, "VITTE_INTERN_E_LOCK", "cannot initialize interner lock", NULL);
+    }
+    return status;
+}
+
+static const char *vitte_interner_insert(vitte_interner_t *interner, const char *text, size_t length, size_t hash) {
+    vitte_interner_slot_t *slot;
+    char *copy;
+
+    slot = vitte_interner_probe(interner, text, length, hash);
+    if (slot->text != NULL) {
+        return slot->text;
+    }
+    if ((interner->count + 1u) * 2u > interner->capacity) {
+        if (!vitte_interner_grow(interner)) {
+            vitte_interner_set_error(interner, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_INTERN_E_MEMORY", "cannot grow interner table", NULL);
+            return NULL;
+        }
+        slot = vitte_interner_probe(interner, text, length, hash);
+    }
+    copy = (char *)vitte_arena_alloc(&interner->arena, length + 1u, 1u);
+    if (copy == NULL) {
+        vitte_error_copy(&interner->last_error, vitte_arena_last_error(&interner->arena));
+        return NULL;
+    }
+    if (length > 0u) {
+        memcpy(copy, text, length);
+    }
+    copy[length] = '\0';
+    slot->text = copy;
+    slot->length = length;
+    slot->hash = hash;
+    interner->count++;
+    interner->bytes_interned += length + 1u;
+    return copy;
+}
+
+const char *vitte_interner_intern(vitte_interner_t *interner, const char *text, size_t length) {
+    const char *interned;
+    size_t hash;
+
+    if (!vitte_interner_is_initialized(interner) || text == NULL) {
+        return NULL;
+    }
+    hash = vitte_interner_hash(text, length);
+    vitte_parallel_mutex_lock(&interner->lock);
+    interned = vitte_interner_insert(interner, text, length, hash);
+    vitte_parallel_mutex_unlock(&interner->lock);
+    return interned;
+}
+
+const char *vitte_interner_intern_cstr(vitte_interner_t *interner, const char *text) {
+    return text != NULL ? vitte_interner_intern(interner, text, strlen(text)) : NULL;
+}
+
+const char *vitte_interner_find(const vitte_interner_t *interner, const char *text, size_t length) {
+    vitte_parallel_mutex_t *lock;
+    const char *found;
+    size_t hash;
+
+    if (!vitte_interner_is_initialized(interner) || text == NULL) {
+        return NULL;
+    }
+    hash = vitte_interner_hash(text, length);
+    lock = (vitte_parallel_mutex_t *)&interner->lock;
+    vitte_parallel_mutex_lock(lock);
+    found = vitte_interner_probe(interner, text, length, hash)->text;
+    vitte_parallel_mutex_unlock(lock);
+    return found;
+}
+
+size_t vitte_interner_count(const vitte_interner_t *interner) {
+    return vitte_interner_is_initialized(interner) ? interner->count : 0u;
+}
@@ -0,0 +1,50 @@
+#ifndef VITTE_BOOTSTRAP_INTERN_H
+#define VITTE_BOOTSTRAP_INTERN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "../api/error.h"
+#include "../arena/arena.h"
+#include "../parallel/parallel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VITTE_INTERNER_INITIAL_CAPACITY ((size_t)256u)
+#define VITTE_INTERNER_BLOCK_SIZE ((size_t)16u * 1024u)
+
+typedef struct vitte_interner_slot {
+    const char *text;
+    size_t length;
+    size_t hash;
+} vitte_interner_slot_t;
+
+typedef struct vitte_interner {
+    bool initialized;
+    vitte_arena_t arena;
+    vitte_interner_slot_t *slots;
+    size_t count;
+    size_t capacity;
+    size_t bytes_interned;
+    vitte_parallel_mutex_t lock;
+    vitte_error_t last_error;
+} vitte_interner_t;
+
+vitte_status_t vitte_interner_init(vitte_interner_t *interner, const vitte_allocator_t *allocator);
+void vitte_interner_destroy(vitte_interner_t *interner);
+bool vitte_interner_is_initialized(const vitte_interner_t *interner);
+const vitte_error_t *vitte_interner_last_error(const vitte_interner_t *interner);
+vitte_status_t vitte_interner_enable_locking(vitte_interner_t *interner);
+
+const char *vitte_interner_intern(vitte_interner_t *interner, const char *text, size_t length);
+const char *vitte_interner_intern_cstr(vitte_interner_t *interner, const char *text);
+const char *vitte_interner_find(const vitte_interner_t *interner, const char *text, size_t length);
+size_t vitte_interner_count(const vitte_interner_t *interner);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VITTE_BOOTSTRAP_INTERN_H */
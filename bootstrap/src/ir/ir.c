@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "../builtin/builtin.h"
+#include "../util/util.h"
 
 static void vitte_ir_set_error(vitte_ir_t *ir, vitte_status_t status, const char *code, const char *message, const char *details) {
     if (ir != NULL) {
@@ -25,23 +26,188 @@ struct vitte_ir_local_binding {
     vitte_ir_local_binding_t *next;
 };
 
-struct vitte_ir_function_binding {
-    const char *name;
-    vitte_ir_function_t *function;
-    vitte_ir_function_binding_t *next;
-};
-
-struct vitte_ir_global_binding {
-    const char *name;
-    vitte_ir_global_t *global;
-    vitte_ir_global_binding_t *next;
-};
-
 struct vitte_ir_scope_marker {
     vitte_ir_local_binding_t *locals;
     vitte_ir_scope_marker_t *next;
 };
 
+/* Names lowering tests for; interned once so each test is a pointer compare. */
+typedef enum vitte_ir_known_name {
+    VITTE_IR_NAME_INT = 0,
+    VITTE_IR_NAME_I32,
+    VITTE_IR_NAME_I64,
+    VITTE_IR_NAME_USIZE,
+    VITTE_IR_NAME_U64,
+    VITTE_IR_NAME_U32,
+    VITTE_IR_NAME_U8,
+    VITTE_IR_NAME_BOOL,
+    VITTE_IR_NAME_STRING,
+    VITTE_IR_NAME_STR,
+    VITTE_IR_NAME_VOID,
+    VITTE_IR_NAME_LEN,
+    VITTE_IR_NAME_SPLIT,
+    VITTE_IR_NAME_ADD,
+    VITTE_IR_NAME_SUB,
+    VITTE_IR_NAME_MUL,
+    VITTE_IR_NAME_DIV,
+    VITTE_IR_NAME_MOD,
+    VITTE_IR_NAME_EQ,
+    VITTE_IR_NAME_NE,
+    VITTE_IR_NAME_LT,
+    VITTE_IR_NAME_LE,
+    VITTE_IR_NAME_GT,
+    VITTE_IR_NAME_GE,
+    VITTE_IR_NAME_AND,
+    VITTE_IR_NAME_OR,
+    VITTE_IR_NAME_COUNT
+} vitte_ir_known_name_t;
+
+static const char *const vitte_ir_known_texts[VITTE_IR_NAME_COUNT] = {
+    "int", "i32", "i64", "usize", "u64", "u32", "u8", "bool", "string", "str", "void",
+    "len", "split",
+    "+", "-", "*", "/", "%", "==", "!=", "<", "<=", ">", ">=", "&&", "||"
+};
+
+static bool vitte_ir_prepare_names(vitte_ir_t *ir) {
+    const char **names;
+    size_t index;
+
+    if (ir->known_names != NULL) {
+        return true;
+    }
+    if (ir->interner == NULL) {
+        vitte_status_t status = vitte_interner_init(&ir->owned_interner, &ir->arena->config.allocator);
+
+        if (status != VITTE_STATUS_OK) {
+            vitte_ir_set_error(ir, status, "VITTE_IR_E_INTERN", "failed to initialize IR interner", NULL);
+            return false;
+        }
+        ir->owns_interner = true;
+        ir->interner = &ir->owned_interner;
+    }
+    names = (const char **)vitte_arena_alloc(ir->arena, sizeof(*names) * VITTE_IR_NAME_COUNT, _Alignof(const char *));
+    if (names == NULL) {
+        vitte_error_copy(&ir->last_error, vitte_arena_last_error(ir->arena));
+        return false;
+    }
+    for (index = 0u; index < (size_t)VITTE_IR_NAME_COUNT; index++) {
+        names[index] = vitte_interner_intern_cstr(ir->interner, vitte_ir_known_texts[index]);
+        if (names[index] == NULL) {
+            vitte_error_copy(&ir->last_error, vitte_interner_last_error(ir->interner));
+            return false;
+        }
+    }
+    ir->known_names = names;
+    return true;
+}
+
+/* Returns the canonical copy of `text`, adding it to the interner if needed. */
+static const char *vitte_ir_intern_range(vitte_ir_t *ir, const char *text, size_t length) {
+    const char *interned;
+
+    if (text == NULL || !vitte_ir_prepare_names(ir)) {
+        return NULL;
+    }
+    interned = vitte_interner_intern(ir->interner, text, length);
+    if (interned == NULL) {
+        vitte_error_copy(&ir->last_error, vitte_interner_last_error(ir->interner));
+    }
+    return interned;
+}
+
+static const char *vitte_ir_intern(vitte_ir_t *ir, const char *text) {
+    return text != NULL ? vitte_ir_intern_range(ir, text, strlen(text)) : NULL;
+}
+
+/*
+ * Returns the canonical copy of `text` without adding it: a name nothing has
+ * interned cannot be bound to anything, so NULL means "no match".
+ */
+static const char *vitte_ir_find_name(const vitte_ir_t *ir, const char *text, size_t length) {
+    return ir != NULL && text != NULL ? vitte_interner_find(ir->interner, text, length) : NULL;
+}
+
+static bool vitte_ir_is_name(const vitte_ir_t *ir, const char *name, vitte_ir_known_name_t known) {
+    return name != NULL && ir->known_names != NULL && name == ir->known_names[known];
+}
+
+static size_t vitte_ir_name_map_slot(const vitte_ir_name_map_t *map, const char *key) {
+    size_t mask = map->capacity - 1u;
+    size_t slot = vitte_util_hash_pointer(key) & mask;
+
+    while (map->keys[slot] != NULL && map->keys[slot] != key) {
+        slot = (slot + 1u) & mask;
+    }
+    return slot;
+}
+
+static void *vitte_ir_name_map_get(const vitte_ir_name_map_t *map, const char *key) {
+    size_t slot;
+
+    if (key == NULL || map->capacity == 0u) {
+        return NULL;
+    }
+    slot = vitte_ir_name_map_slot(map, key);
+    return map->keys[slot] != NULL ? map->values[slot] : NULL;
+}
+
+static bool vitte_ir_name_map_grow(vitte_ir_name_map_t *map, vitte_arena_t *arena) {
+    const char **old_keys = map->keys;
+    void **old_values = map->values;
+    size_t old_capacity = map->capacity;
+    size_t capacity = old_capacity != 0u ? old_capacity * 2u : 64u;
+    size_t index;
+
+    map->keys = (const char **)vitte_arena_alloc_zeroed(arena, capacity * sizeof(*map->keys), _Alignof(const char *));
+    map->values = (void **)vitte_arena_alloc(arena, capacity * sizeof(*map->values), _Alignof(void *));
+    if (map->keys == NULL || map->values == NULL) {
+        map->keys = old_keys;
+        map->values = old_values;
+        return false;
+    }
+    map->capacity = capacity;
+    for (index = 0u; index < old_capacity; index++) {
+        if (old_keys[index] != NULL) {
+            size_t slot = vitte_ir_name_map_slot(map, old_keys[index]);
+
+            map->keys[slot] = old_keys[index];
+            map->values[slot] = old_values[index];
+        }
+    }
+    return true;
+}
+
+/*
+ * Binds `key` to `value`. An existing binding is replaced when `replace` is
+ * set and kept otherwise; `*previous` receives it either way.
+ */
+static bool vitte_ir_name_map_put(
+    vitte_ir_name_map_t *map,
+    vitte_arena_t *arena,
+    const char *key,
+    void *value,
+    bool replace,
+    void **previous
+) {
+    size_t slot;
+
+    if ((map->count + 1u) * 2u > map->capacity && !vitte_ir_name_map_grow(map, arena)) {
+        return false;
+    }
+    slot = vitte_ir_name_map_slot(map, key);
+    if (previous != NULL) {
+        *previous = map->keys[slot] != NULL ? map->values[slot] : NULL;
+    }
+    if (map->keys[slot] == NULL) {
+        map->keys[slot] = key;
+        map->values[slot] = value;
+        map->count++;
+    } else if (replace) {
+        map->values[slot] = value;
+    }
+    return true;
+}
+
 static vitte_ir_type_t *vitte_ir_type_from_builtin(vitte_ir_t *ir, vitte_builtin_type_kind_t kind) {
     switch (kind) {
         case VITTE_BUILTIN_TYPE_VOID:
@@ -105,7 +271,7 @@ static bool vitte_ir_scope_push(vitte_ir_lowering_t *lowering) {
     if (lowering == NULL || !vitte_ir_is_initialized(lowering->ir)) {
         return false;
     }
-    marker = (vitte_ir_scope_marker_t *)vitte_arena_alloc_zeroed(lowering->ir->arena, sizeof(*marker), _Alignof(vitte_ir_scope_marker_t));
+    marker = (vitte_ir_scope_marker_t *)vitte_arena_slab_alloc(&lowering->scratch, sizeof(*marker));
     if (marker == NULL) {
         vitte_error_copy(&lowering->last_error, vitte_arena_last_error(lowering->ir->arena));
         vitte_error_copy(&lowering->ir->last_error, vitte_arena_last_error(lowering->ir->arena));
@@ -117,12 +283,22 @@ static bool vitte_ir_scope_push(vitte_ir_lowering_t *lowering) {
     return true;
 }
 
+/* Nothing keeps a binding past its scope, so they go back to the slab with the marker. */
 static void vitte_ir_scope_pop(vitte_ir_lowering_t *lowering) {
+    vitte_ir_scope_marker_t *marker;
+
     if (lowering == NULL || lowering->scopes == NULL) {
         return;
     }
-    lowering->locals = lowering->scopes->locals;
-    lowering->scopes = lowering->scopes->next;
+    marker = lowering->scopes;
+    while (lowering->locals != marker->locals) {
+        vitte_ir_local_binding_t *binding = lowering->locals;
+
+        lowering->locals = binding->next;
+        vitte_arena_slab_free(&lowering->scratch, binding, sizeof(*binding));
+    }
+    lowering->scopes = marker->next;
+    vitte_arena_slab_free(&lowering->scratch, marker, sizeof(*marker));
 }
 
 static bool vitte_ir_bind_local(vitte_ir_lowering_t *lowering, const char *name, vitte_ir_value_t *value) {
@@ -131,7 +307,12 @@ static bool vitte_ir_bind_local(vitte_ir_lowering_t *lowering, const char *name,
     if (lowering == NULL || name == NULL || value == NULL) {
         return false;
     }
-    binding = (vitte_ir_local_binding_t *)vitte_arena_alloc_zeroed(lowering->ir->arena, sizeof(*binding), _Alignof(vitte_ir_local_binding_t));
+    name = vitte_ir_intern(lowering->ir, name);
+    if (name == NULL) {
+        vitte_error_copy(&lowering->last_error, &lowering->ir->last_error);
+        return false;
+    }
+    binding = (vitte_ir_local_binding_t *)vitte_arena_slab_alloc(&lowering->scratch, sizeof(*binding));
     if (binding == NULL) {
         vitte_error_copy(&lowering->last_error, vitte_arena_last_error(lowering->ir->arena));
         vitte_error_copy(&lowering->ir->last_error, vitte_arena_last_error(lowering->ir->arena));
@@ -144,28 +325,35 @@ static bool vitte_ir_bind_local(vitte_ir_lowering_t *lowering, const char *name,
     return true;
 }
 
-static vitte_ir_value_t *vitte_ir_lookup_local(const vitte_ir_lowering_t *lowering, const char *name) {
+/* `name` is interned, so the innermost binding is found by address. */
+static vitte_ir_value_t *vitte_ir_find_local(const vitte_ir_lowering_t *lowering, const char *name) {
     const vitte_ir_local_binding_t *binding;
-    const char *dot;
 
-    if (lowering == NULL || name == NULL) {
+    if (name == NULL) {
         return NULL;
     }
     for (binding = lowering->locals; binding != NULL; binding = binding->next) {
-        if (binding->name != NULL && strcmp(binding->name, name) == 0) {
+        if (binding->name == name) {
             return binding->value;
         }
     }
+    return NULL;
+}
+
+static vitte_ir_value_t *vitte_ir_lookup_local(const vitte_ir_lowering_t *lowering, const char *name) {
+    vitte_ir_value_t *value;
+    const char *dot;
+
+    if (lowering == NULL || name == NULL) {
+        return NULL;
+    }
+    value = vitte_ir_find_local(lowering, vitte_ir_find_name(lowering->ir, name, strlen(name)));
+    if (value != NULL) {
+        return value;
+    }
     dot = strchr(name, '.');
     if (dot != NULL && dot != name) {
-        size_t prefix_length = (size_t)(dot - name);
-        for (binding = lowering->locals; binding != NULL; binding = binding->next) {
-            if (binding->name != NULL &&
-                strlen(binding->name) == prefix_length &&
-                strncmp(binding->name, name, prefix_length) == 0) {
-                return binding->value;
-            }
-        }
+        return vitte_ir_find_local(lowering, vitte_ir_find_name(lowering->ir, name, (size_t)(dot - name)));
     }
     return NULL;
 }
@@ -195,82 +383,78 @@ static vitte_status_t vitte_ir_bind_function_parameters(
 }
 
 static bool vitte_ir_bind_function(vitte_ir_lowering_t *lowering, const char *name, vitte_ir_function_t *function) {
-    vitte_ir_function_binding_t *binding;
+    vitte_arena_t *arena;
 
     if (lowering == NULL || name == NULL || function == NULL) {
         return false;
     }
-    binding = (vitte_ir_function_binding_t *)vitte_arena_alloc_zeroed(lowering->ir->arena, sizeof(*binding), _Alignof(vitte_ir_function_binding_t));
-    if (binding == NULL) {
-        vitte_error_copy(&lowering->last_error, vitte_arena_last_error(lowering->ir->arena));
-        vitte_error_copy(&lowering->ir->last_error, vitte_arena_last_error(lowering->ir->arena));
+    arena = lowering->ir->arena;
+    name = vitte_ir_intern(lowering->ir, name);
+    if (name == NULL) {
+        vitte_error_copy(&lowering->last_error, &lowering->ir->last_error);
+        return false;
+    }
+    if (!vitte_ir_name_map_put(&lowering->functions, arena, name, function, true, NULL) ||
+        (function->source_name != NULL &&
+            !vitte_ir_name_map_put(&lowering->function_sources, arena, function->source_name, function, true, NULL))) {
+        vitte_error_copy(&lowering->last_error, vitte_arena_last_error(arena));
+        vitte_error_copy(&lowering->ir->last_error, vitte_arena_last_error(arena));
         return false;
     }
-    binding->name = name;
-    binding->function = function;
-    binding->next = lowering->functions;
-    lowering->functions = binding;
     return true;
 }
 
+/*
+ * Exact names win; otherwise `module.name` falls back to whichever function
+ * was most recently declared as `name` before import qualification.
+ */
 static vitte_ir_function_t *vitte_ir_lookup_function(const vitte_ir_lowering_t *lowering, const char *name) {
-    const vitte_ir_function_binding_t *binding;
+    vitte_ir_function_t *function;
     const char *source_name;
 
     if (lowering == NULL || name == NULL) {
         return NULL;
     }
-    for (binding = lowering->functions; binding != NULL; binding = binding->next) {
-        if (binding->name != NULL && strcmp(binding->name, name) == 0) {
-            return binding->function;
-        }
+    function = (vitte_ir_function_t *)vitte_ir_name_map_get(&lowering->functions, vitte_ir_find_name(lowering->ir, name, strlen(name)));
+    if (function != NULL) {
+        return function;
     }
     source_name = strrchr(name, '.');
     if (source_name != NULL && source_name[1] != '\0') {
         source_name++;
-        for (binding = lowering->functions; binding != NULL; binding = binding->next) {
-            if (binding->function != NULL && binding->function->source != NULL &&
-                binding->function->source->kind == VITTE_HIR_FUNCTION &&
-                binding->function->source->as.function.source_name != NULL &&
-                strcmp(binding->function->source->as.function.source_name, source_name) == 0) {
-                return binding->function;
-            }
-        }
+        return (vitte_ir_function_t *)vitte_ir_name_map_get(
+            &lowering->function_sources,
+            vitte_ir_find_name(lowering->ir, source_name, strlen(source_name))
+        );
     }
     return NULL;
 }
 
 static bool vitte_ir_bind_global(vitte_ir_lowering_t *lowering, const char *name, vitte_ir_global_t *global) {
-    vitte_ir_global_binding_t *binding;
+    vitte_arena_t *arena;
 
     if (lowering == NULL || name == NULL || global == NULL) {
         return false;
     }
-    binding = (vitte_ir_global_binding_t *)vitte_arena_alloc_zeroed(lowering->ir->arena, sizeof(*binding), _Alignof(vitte_ir_global_binding_t));
-    if (binding == NULL) {
-        vitte_error_copy(&lowering->last_error, vitte_arena_last_error(lowering->ir->arena));
-        vitte_error_copy(&lowering->ir->last_error, vitte_arena_last_error(lowering->ir->arena));
+    arena = lowering->ir->arena;
+    name = vitte_ir_intern(lowering->ir, name);
+    if (name == NULL) {
+        vitte_error_copy(&lowering->last_error, &lowering->ir->last_error);
+        return false;
+    }
+    if (!vitte_ir_name_map_put(&lowering->globals, arena, name, global, true, NULL)) {
+        vitte_error_copy(&lowering->last_error, vitte_arena_last_error(arena));
+        vitte_error_copy(&lowering->ir->last_error, vitte_arena_last_error(arena));
         return false;
     }
-    binding->name = name;
-    binding->global = global;
-    binding->next = lowering->globals;
-    lowering->globals = binding;
     return true;
 }
 
 static vitte_ir_global_t *vitte_ir_lookup_global(const vitte_ir_lowering_t *lowering, const char *name) {
-    const vitte_ir_global_binding_t *binding;
-
     if (lowering == NULL || name == NULL) {
         return NULL;
     }
-    for (binding = lowering->globals; binding != NULL; binding = binding->next) {
-        if (binding->name != NULL && strcmp(binding->name, name) == 0) {
-            return binding->global;
-        }
-    }
-    return NULL;
+    return (vitte_ir_global_t *)vitte_ir_name_map_get(&lowering->globals, vitte_ir_find_name(lowering->ir, name, strlen(name)));
 }
 
 vitte_status_t vitte_ir_init(vitte_ir_t *ir, vitte_arena_t *arena) {
@@ -314,12 +498,27 @@ void vitte_ir_destroy(vitte_ir_t *ir) {
     if (ir == NULL) {
         return;
     }
+    if (ir->owns_interner) {
+        vitte_interner_destroy(&ir->owned_interner);
+    }
     if (ir->owns_arena) {
         vitte_arena_destroy(&ir->owned_arena);
     }
     memset(ir, 0, sizeof(*ir));
 }
 
+vitte_status_t vitte_ir_use_interner(vitte_ir_t *ir, vitte_interner_t *interner) {
+    if (!vitte_ir_is_initialized(ir) || !vitte_interner_is_initialized(interner)) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    if (ir->interner != NULL) {
+        vitte_ir_set_error(ir, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_IR_E_INTERN", "IR names are already interned", NULL);
+        return VITTE_STATUS_ERROR_INVALID_STATE;
+    }
+    ir->interner = interner;
+    return VITTE_STATUS_OK;
+}
+
 bool vitte_ir_is_initialized(const vitte_ir_t *ir) {
     return ir != NULL && ir->initialized && vitte_arena_is_initialized(ir->arena);
 }
@@ -363,19 +562,24 @@ vitte_ir_type_t *vitte_ir_make_named_type(vitte_ir_t *ir, vitte_ir_type_kind_t k
         return NULL;
     }
     type->kind = kind;
-    type->name = name;
+    if (name != NULL) {
+        type->name = vitte_ir_intern(ir, name);
+        if (type->name == NULL) {
+            return NULL;
+        }
+    }
     return type;
 }
 
-static const char *vitte_ir_symbol_tail(const char *name) {
+static const char *vitte_ir_symbol_tail_range(const char *name, size_t length) {
     const char *tail = name;
+    const char *end = name + length;
     const char *cursor;
 
-    if (name == NULL) return NULL;
-    for (cursor = name; *cursor != '\0'; cursor++) {
+    for (cursor = name; cursor < end; cursor++) {
         if (*cursor == '.' || *cursor == '/') {
             tail = cursor + 1;
-        } else if (cursor[0] == '_' && cursor[1] == '_') {
+        } else if (cursor + 1 < end && cursor[0] == '_' && cursor[1] == '_') {
             tail = cursor + 2;
             cursor++;
         }
@@ -383,24 +587,69 @@ static const char *vitte_ir_symbol_tail(const char *name) {
     return tail;
 }
 
-static vitte_ir_pick_t *vitte_ir_find_pick(vitte_ir_t *ir, const char *name) {
-    vitte_ir_pick_t *pick;
-    const char *wanted = vitte_ir_symbol_tail(name);
+static const char *vitte_ir_symbol_tail(const char *name) {
+    return name != NULL ? vitte_ir_symbol_tail_range(name, strlen(name)) : NULL;
+}
 
-    if (ir == NULL || ir->module == NULL || wanted == NULL) return NULL;
-    for (pick = ir->module->first_pick; pick != NULL; pick = pick->next) {
-        const char *candidate = vitte_ir_symbol_tail(pick->name);
-        if (candidate != NULL && strcmp(candidate, wanted) == 0) return pick;
+/* The interned tail of an interned name, or NULL when nothing interned that tail. */
+static const char *vitte_ir_tail_name(const vitte_ir_t *ir, const char *name) {
+    const char *tail = vitte_ir_symbol_tail(name);
+
+    return tail == name ? name : vitte_ir_find_name(ir, tail, strlen(tail));
+}
+
+/* Indexes the picks added since the last lookup; the first pick with a given tail wins. */
+static bool vitte_ir_index_picks(vitte_ir_t *ir) {
+    vitte_ir_pick_t *pick = ir->last_indexed_pick != NULL ? ir->last_indexed_pick->next : ir->module->first_pick;
+
+    for (; pick != NULL; pick = pick->next) {
+        const char *tail = vitte_ir_intern(ir, vitte_ir_symbol_tail(pick->name));
+
+        if (tail == NULL || !vitte_ir_name_map_put(&ir->pick_tails, ir->arena, tail, pick, false, NULL)) {
+            return false;
+        }
+        ir->last_indexed_pick = pick;
     }
-    return NULL;
+    return true;
+}
+
+/* Indexes the forms added since the last lookup, chaining forms that share a tail. */
+static bool vitte_ir_index_forms(vitte_ir_t *ir) {
+    vitte_ir_form_t *form = ir->last_indexed_form != NULL ? ir->last_indexed_form->next : ir->module->first_form;
+
+    for (; form != NULL; form = form->next) {
+        const char *tail = vitte_ir_intern(ir, vitte_ir_symbol_tail(form->name));
+        void *previous = NULL;
+
+        if (tail == NULL || !vitte_ir_name_map_put(&ir->form_tails, ir->arena, tail, form, false, &previous)) {
+            return false;
+        }
+        if (previous != NULL) {
+            vitte_ir_form_t *chain = (vitte_ir_form_t *)previous;
+
+            while (chain->next_same_tail != NULL) {
+                chain = chain->next_same_tail;
+            }
+            chain->next_same_tail = form;
+        }
+        ir->last_indexed_form = form;
+    }
+    return true;
+}
+
+static vitte_ir_pick_t *vitte_ir_find_pick(vitte_ir_t *ir, const char *name, size_t length) {
+    const char *tail;
+
+    if (ir == NULL || ir->module == NULL || name == NULL || !vitte_ir_index_picks(ir)) return NULL;
+    tail = vitte_ir_symbol_tail_range(name, length);
+    return (vitte_ir_pick_t *)vitte_ir_name_map_get(&ir->pick_tails, vitte_ir_find_name(ir, tail, (size_t)(name + length - tail)));
 }
 
 static bool vitte_ir_pick_variant_discriminant(vitte_ir_t *ir, const char *name, int64_t *value) {
     const char *separator;
     const char *cursor;
     const char *variant_name;
-    char type_name[256];
-    size_t type_length;
+    const char *wanted;
     vitte_ir_pick_t *pick;
     vitte_ir_pick_variant_t *variant;
     int64_t discriminant = 0;
@@ -415,16 +664,15 @@ static bool vitte_ir_pick_variant_discriminant(vitte_ir_t *ir, const char *name,
             cursor++;
         }
     }
-    if (separator == NULL) return false;
-    type_length = (size_t)(separator - name);
-    if (type_length == 0u || type_length >= sizeof(type_name)) return false;
-    memcpy(type_name, name, type_length);
-    type_name[type_length] = '\0';
+    if (separator == NULL || separator == name) return false;
     variant_name = separator + (separator[0] == '.' ? 1 : 2);
-    pick = vitte_ir_find_pick(ir, type_name);
+    pick = vitte_ir_find_pick(ir, name, (size_t)(separator - name));
     if (pick == NULL) return false;
+    wanted = vitte_ir_symbol_tail(variant_name);
+    wanted = vitte_ir_find_name(ir, wanted, strlen(wanted));
+    if (wanted == NULL) return false;
     for (variant = pick->first_variant; variant != NULL; variant = variant->next, discriminant++) {
-        if (variant->name != NULL && strcmp(vitte_ir_symbol_tail(variant->name), vitte_ir_symbol_tail(variant_name)) == 0) {
+        if (variant->name != NULL && vitte_ir_tail_name(ir, variant->name) == wanted) {
             *value = discriminant;
             return true;
         }
@@ -432,27 +680,40 @@ static bool vitte_ir_pick_variant_discriminant(vitte_ir_t *ir, const char *name,
     return false;
 }
 
+static const struct {
+    vitte_ir_known_name_t name;
+    vitte_ir_type_kind_t kind;
+} vitte_ir_builtin_type_names[] = {
+    {VITTE_IR_NAME_INT, VITTE_IR_TYPE_I32},
+    {VITTE_IR_NAME_I32, VITTE_IR_TYPE_I32},
+    {VITTE_IR_NAME_I64, VITTE_IR_TYPE_I64},
+    {VITTE_IR_NAME_USIZE, VITTE_IR_TYPE_USIZE},
+    {VITTE_IR_NAME_U64, VITTE_IR_TYPE_USIZE},
+    {VITTE_IR_NAME_U32, VITTE_IR_TYPE_USIZE},
+    {VITTE_IR_NAME_U8, VITTE_IR_TYPE_USIZE},
+    {VITTE_IR_NAME_BOOL, VITTE_IR_TYPE_BOOL},
+    {VITTE_IR_NAME_STRING, VITTE_IR_TYPE_STRING_PTR},
+    {VITTE_IR_NAME_STR, VITTE_IR_TYPE_STRING_PTR},
+    {VITTE_IR_NAME_VOID, VITTE_IR_TYPE_VOID}
+};
+
 static vitte_ir_type_t *vitte_ir_type_from_name(vitte_ir_t *ir, const char *name) {
-    if (name == NULL || strcmp(name, "int") == 0 || strcmp(name, "i32") == 0) {
+    const char *canonical;
+    size_t index;
+
+    if (name == NULL) {
         return vitte_ir_make_type(ir, VITTE_IR_TYPE_I32);
     }
-    if (strcmp(name, "i64") == 0) {
-        return vitte_ir_make_type(ir, VITTE_IR_TYPE_I64);
-    }
-    if (strcmp(name, "usize") == 0 || strcmp(name, "u64") == 0 ||
-        strcmp(name, "u32") == 0 || strcmp(name, "u8") == 0) {
-        return vitte_ir_make_type(ir, VITTE_IR_TYPE_USIZE);
-    }
-    if (strcmp(name, "bool") == 0) {
-        return vitte_ir_make_type(ir, VITTE_IR_TYPE_BOOL);
-    }
-    if (strcmp(name, "string") == 0 || strcmp(name, "str") == 0) {
-        return vitte_ir_make_type(ir, VITTE_IR_TYPE_STRING_PTR);
+    if (!vitte_ir_prepare_names(ir)) {
+        return NULL;
     }
-    if (strcmp(name, "void") == 0) {
-        return vitte_ir_make_type(ir, VITTE_IR_TYPE_VOID);
+    canonical = vitte_ir_find_name(ir, name, strlen(name));
+    for (index = 0u; index < sizeof(vitte_ir_builtin_type_names) / sizeof(vitte_ir_builtin_type_names[0]); index++) {
+        if (vitte_ir_is_name(ir, canonical, vitte_ir_builtin_type_names[index].name)) {
+            return vitte_ir_make_type(ir, vitte_ir_builtin_type_names[index].kind);
+        }
     }
-    if (vitte_ir_find_pick(ir, name) != NULL) {
+    if (vitte_ir_find_pick(ir, name, strlen(name)) != NULL) {
         return vitte_ir_make_type(ir, VITTE_IR_TYPE_I32);
     }
     return vitte_ir_make_named_type(ir, VITTE_IR_TYPE_AGGREGATE_PTR, name);
@@ -604,7 +865,11 @@ vitte_ir_module_t *vitte_ir_make_module(vitte_ir_builder_t *builder, const char
         vitte_error_copy(&builder->ir->last_error, vitte_arena_last_error(builder->ir->arena));
         return NULL;
     }
-    module->name = name != NULL ? name : "<module>";
+    module->name = vitte_ir_intern(builder->ir, name != NULL ? name : "<module>");
+    if (module->name == NULL) {
+        return NULL;
+    }
+    module->interner = builder->ir->interner;
     builder->ir->module = module;
     return module;
 }
@@ -623,7 +888,10 @@ vitte_ir_global_t *vitte_ir_make_global(vitte_ir_builder_t *builder, const char
         vitte_error_copy(&builder->ir->last_error, vitte_arena_last_error(builder->ir->arena));
         return NULL;
     }
-    global->name = name;
+    global->name = vitte_ir_intern(builder->ir, name);
+    if (global->name == NULL) {
+        return NULL;
+    }
     global->type = type;
     global->source = source;
     return global;
@@ -638,7 +906,10 @@ vitte_ir_pick_t *vitte_ir_make_pick(vitte_ir_builder_t *builder, const char *nam
     if (pick == NULL) {
         return NULL;
     }
-    pick->name = name;
+    pick->name = vitte_ir_intern(builder->ir, name);
+    if (pick->name == NULL) {
+        return NULL;
+    }
     pick->source = source;
     return pick;
 }
@@ -650,25 +921,25 @@ vitte_ir_pick_variant_t *vitte_ir_make_pick_variant(vitte_ir_builder_t *builder,
     }
     variant = (vitte_ir_pick_variant_t *)vitte_arena_alloc_zeroed(builder->ir->arena, sizeof(*variant), _Alignof(vitte_ir_pick_variant_t));
     if (variant != NULL) {
-        variant->name = name;
+        variant->name = vitte_ir_intern(builder->ir, name);
     }
-    return variant;
+    return variant != NULL && variant->name != NULL ? variant : NULL;
 }
 
 vitte_ir_form_t *vitte_ir_make_form(vitte_ir_builder_t *builder, const char *name, const vitte_hir_node_t *source) {
     vitte_ir_form_t *form;
     if (builder == NULL || builder->ir == NULL || name == NULL) return NULL;
     form = (vitte_ir_form_t *)vitte_arena_alloc_zeroed(builder->ir->arena, sizeof(*form), _Alignof(vitte_ir_form_t));
-    if (form != NULL) { form->name = name; form->source = source; }
-    return form;
+    if (form != NULL) { form->name = vitte_ir_intern(builder->ir, name); form->source = source; }
+    return form != NULL && form->name != NULL ? form : NULL;
 }
 
 vitte_ir_form_field_t *vitte_ir_make_form_field(vitte_ir_builder_t *builder, const char *name, vitte_ir_type_t *type) {
     vitte_ir_form_field_t *field;
     if (builder == NULL || builder->ir == NULL || name == NULL || type == NULL) return NULL;
     field = (vitte_ir_form_field_t *)vitte_arena_alloc_zeroed(builder->ir->arena, sizeof(*field), _Alignof(vitte_ir_form_field_t));
-    if (field != NULL) { field->name = name; field->type = type; }
-    return field;
+    if (field != NULL) { field->name = vitte_ir_intern(builder->ir, name); field->type = type; }
+    return field != NULL && field->name != NULL ? field : NULL;
 }
 
 bool vitte_ir_module_add_global(vitte_ir_module_t *module, vitte_ir_global_t *global) {
@@ -752,8 +1023,17 @@ vitte_ir_function_t *vitte_ir_make_function(vitte_ir_builder_t *builder, const c
         vitte_error_copy(&builder->ir->last_error, vitte_arena_last_error(builder->ir->arena));
         return NULL;
     }
+    function->name = vitte_ir_intern(builder->ir, name);
+    if (function->name == NULL) {
+        return NULL;
+    }
+    if (source != NULL && source->kind == VITTE_HIR_FUNCTION && source->as.function.source_name != NULL) {
+        function->source_name = vitte_ir_intern(builder->ir, source->as.function.source_name);
+        if (function->source_name == NULL) {
+            return NULL;
+        }
+    }
     function->id = builder->ir->next_function_id++;
-    function->name = name;
     function->return_type = return_type;
     function->source = source;
     builder->ir->function_count++;
@@ -815,8 +1095,11 @@ vitte_ir_block_t *vitte_ir_make_block(vitte_ir_builder_t *builder, const char *n
         vitte_error_copy(&builder->ir->last_error, vitte_arena_last_error(builder->ir->arena));
         return NULL;
     }
+    block->name = vitte_ir_intern(builder->ir, name != NULL ? name : "block");
+    if (block->name == NULL) {
+        return NULL;
+    }
     block->id = builder->ir->next_block_id++;
-    block->name = name != NULL ? name : "block";
     block->source = source;
     builder->ir->block_count++;
     return block;
@@ -827,6 +1110,7 @@ bool vitte_ir_function_add_block(vitte_ir_function_t *function, vitte_ir_block_t
         return false;
     }
     block->next = NULL;
+    block->function = function;
     if (function->last_block != NULL) {
         function->last_block->next = block;
     } else {
@@ -862,10 +1146,15 @@ vitte_ir_value_t *vitte_ir_make_value(vitte_ir_t *ir, vitte_ir_value_kind_t kind
         vitte_error_copy(&ir->last_error, vitte_arena_last_error(ir->arena));
         return NULL;
     }
+    if (name != NULL) {
+        value->name = vitte_ir_intern(ir, name);
+        if (value->name == NULL) {
+            return NULL;
+        }
+    }
     value->id = ir->next_value_id++;
     value->kind = kind;
     value->type = type;
-    value->name = name;
     ir->value_count++;
     return value;
 }
@@ -990,10 +1279,11 @@ vitte_ir_value_t *vitte_ir_emit_load(vitte_ir_builder_t *builder, vitte_ir_value
     if (instruction == NULL || local == NULL) {
         return NULL;
     }
-    result = vitte_ir_make_value(builder->ir, VITTE_IR_VALUE_INSTRUCTION, local->type, local->name);
+    result = vitte_ir_make_value(builder->ir, VITTE_IR_VALUE_INSTRUCTION, local->type, NULL);
     if (result == NULL) {
         return NULL;
     }
+    result->name = local->name;
     result->definition = instruction;
     instruction->operands[0] = local;
     instruction->operand_count = 1u;
@@ -1026,12 +1316,14 @@ vitte_ir_value_t *vitte_ir_emit_binary(vitte_ir_builder_t *builder, const char *
     if (instruction == NULL || operator_text == NULL || left == NULL || right == NULL) {
         return NULL;
     }
-    result = vitte_ir_make_value(builder->ir, VITTE_IR_VALUE_INSTRUCTION, left->type, NULL);
+    instruction->operator_text = vitte_ir_intern(builder->ir, operator_text);
+    result = instruction->operator_text != NULL ?
+        vitte_ir_make_value(builder->ir, VITTE_IR_VALUE_INSTRUCTION, left->type, NULL) :
+        NULL;
     if (result == NULL) {
         return NULL;
     }
     result->definition = instruction;
-    instruction->operator_text = operator_text;
     instruction->operands[0] = left;
     instruction->operands[1] = right;
     instruction->operand_count = 2u;
@@ -1109,7 +1401,10 @@ static vitte_ir_instruction_t *vitte_ir_emit_aggregate_write(
     instruction->operand_count = 1u;
     if (key != NULL) instruction->operands[instruction->operand_count++] = key;
     instruction->operands[instruction->operand_count++] = value;
-    instruction->operator_text = field;
+    if (field != NULL) {
+        instruction->operator_text = vitte_ir_intern(builder->ir, field);
+        if (instruction->operator_text == NULL) return NULL;
+    }
     return instruction;
 }
 
@@ -1125,6 +1420,10 @@ static vitte_ir_value_t *vitte_ir_emit_aggregate_read(
     vitte_ir_instruction_t *instruction = vitte_ir_emit_instruction(builder, opcode, result_type, source);
     vitte_ir_value_t *result;
     if (instruction == NULL || aggregate == NULL || result_type == NULL) return NULL;
+    if (field != NULL) {
+        instruction->operator_text = vitte_ir_intern(builder->ir, field);
+        if (instruction->operator_text == NULL) return NULL;
+    }
     result = vitte_ir_make_value(builder->ir, VITTE_IR_VALUE_INSTRUCTION, result_type, NULL);
     if (result == NULL) return NULL;
     result->definition = instruction;
@@ -1132,7 +1431,6 @@ static vitte_ir_value_t *vitte_ir_emit_aggregate_read(
     instruction->operands[0] = aggregate;
     instruction->operand_count = 1u;
     if (key != NULL) instruction->operands[instruction->operand_count++] = key;
-    instruction->operator_text = field;
     return result;
 }
 
@@ -1186,6 +1484,9 @@ void vitte_ir_lowering_init(vitte_ir_lowering_t *lowering, vitte_ir_t *ir) {
     memset(lowering, 0, sizeof(*lowering));
     lowering->ir = ir;
     lowering->max_depth = VITTE_IR_DEFAULT_MAX_DEPTH;
+    if (vitte_ir_is_initialized(ir)) {
+        (void)vitte_arena_slab_init(&lowering->scratch, ir->arena);
+    }
     vitte_ir_builder_init(&lowering->builder, ir);
     vitte_error_init(&lowering->last_error);
 }
@@ -1213,20 +1514,20 @@ static bool vitte_ir_depth_ok(vitte_ir_lowering_t *lowering, size_t depth) {
     return true;
 }
 
-static bool vitte_ir_operator_returns_bool(const char *operator_text) {
-    return operator_text != NULL &&
-        (strcmp(operator_text, "==") == 0 ||
-        strcmp(operator_text, "!=") == 0 ||
-        strcmp(operator_text, "<") == 0 ||
-        strcmp(operator_text, "<=") == 0 ||
-        strcmp(operator_text, ">") == 0 ||
-        strcmp(operator_text, ">=") == 0 ||
-        strcmp(operator_text, "&&") == 0 ||
-        strcmp(operator_text, "||") == 0);
+/* `operator_text` is interned. */
+static bool vitte_ir_operator_returns_bool(const vitte_ir_t *ir, const char *operator_text) {
+    return vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_EQ) ||
+        vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_NE) ||
+        vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_LT) ||
+        vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_LE) ||
+        vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_GT) ||
+        vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_GE) ||
+        vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_AND) ||
+        vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_OR);
 }
 
 static vitte_ir_type_t *vitte_ir_binary_result_type(vitte_ir_t *ir, const char *operator_text, const vitte_ir_type_t *left, const vitte_ir_type_t *right) {
-    if (vitte_ir_operator_returns_bool(operator_text)) {
+    if (vitte_ir_operator_returns_bool(ir, operator_text)) {
         return vitte_ir_make_type(ir, VITTE_IR_TYPE_BOOL);
     }
     if (left != NULL && right != NULL && left->kind == right->kind) {
@@ -1293,7 +1594,11 @@ static vitte_ir_value_t *vitte_ir_lower_constant_expr(vitte_ir_lowering_t *lower
         case VITTE_HIR_BINARY_EXPR: {
             vitte_ir_value_t *left = vitte_ir_lower_constant_expr(lowering, node->as.binary_expr.left, depth + 1u);
             vitte_ir_value_t *right = vitte_ir_lower_constant_expr(lowering, node->as.binary_expr.right, depth + 1u);
+            const vitte_ir_t *ir = lowering->ir;
+            const char *operator_text;
             vitte_ir_type_t *type;
+            int64_t a;
+            int64_t b;
 
             if (left == NULL || right == NULL) {
                 return NULL;
@@ -1302,39 +1607,42 @@ static vitte_ir_value_t *vitte_ir_lower_constant_expr(vitte_ir_lowering_t *lower
                 vitte_ir_lowering_set_error(lowering, VITTE_STATUS_ERROR_UNSUPPORTED, "VITTE_IR_E_CONST", "non-integer constant binary expression is not supported yet", node->as.binary_expr.operator_text);
                 return NULL;
             }
-            type = vitte_ir_binary_result_type(lowering->ir, node->as.binary_expr.operator_text, left->type, right->type);
-            if (strcmp(node->as.binary_expr.operator_text, "+") == 0) {
-                return vitte_ir_make_const_int_value(lowering->ir, left->as.int_value + right->as.int_value, type);
+            operator_text = vitte_ir_find_name(ir, node->as.binary_expr.operator_text, strlen(node->as.binary_expr.operator_text));
+            type = vitte_ir_binary_result_type(lowering->ir, operator_text, left->type, right->type);
+            a = left->as.int_value;
+            b = right->as.int_value;
+            if (vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_ADD)) {
+                return vitte_ir_make_const_int_value(lowering->ir, a + b, type);
             }
-            if (strcmp(node->as.binary_expr.operator_text, "-") == 0) {
-                return vitte_ir_make_const_int_value(lowering->ir, left->as.int_value - right->as.int_value, type);
+            if (vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_SUB)) {
+                return vitte_ir_make_const_int_value(lowering->ir, a - b, type);
             }
-            if (strcmp(node->as.binary_expr.operator_text, "*") == 0) {
-                return vitte_ir_make_const_int_value(lowering->ir, left->as.int_value * right->as.int_value, type);
+            if (vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_MUL)) {
+                return vitte_ir_make_const_int_value(lowering->ir, a * b, type);
             }
-            if (strcmp(node->as.binary_expr.operator_text, "/") == 0) {
-                return vitte_ir_make_const_int_value(lowering->ir, right->as.int_value != 0 ? left->as.int_value / right->as.int_value : 0, type);
+            if (vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_DIV)) {
+                return vitte_ir_make_const_int_value(lowering->ir, b != 0 ? a / b : 0, type);
             }
-            if (strcmp(node->as.binary_expr.operator_text, "%") == 0) {
-                return vitte_ir_make_const_int_value(lowering->ir, right->as.int_value != 0 ? left->as.int_value % right->as.int_value : 0, type);
+            if (vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_MOD)) {
+                return vitte_ir_make_const_int_value(lowering->ir, b != 0 ? a % b : 0, type);
             }
-            if (strcmp(node->as.binary_expr.operator_text, "==") == 0) {
-                return vitte_ir_make_const_int_value(lowering->ir, left->as.int_value == right->as.int_value ? 1 : 0, type);
+            if (vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_EQ)) {
+                return vitte_ir_make_const_int_value(lowering->ir, a == b ? 1 : 0, type);
             }
-            if (strcmp(node->as.binary_expr.operator_text, "!=") == 0) {
-                return vitte_ir_make_const_int_value(lowering->ir, left->as.int_value != right->as.int_value ? 1 : 0, type);
+            if (vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_NE)) {
+                return vitte_ir_make_const_int_value(lowering->ir, a != b ? 1 : 0, type);
             }
-            if (strcmp(node->as.binary_expr.operator_text, "<") == 0) {
-                return vitte_ir_make_const_int_value(lowering->ir, left->as.int_value < right->as.int_value ? 1 : 0, type);
+            if (vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_LT)) {
+                return vitte_ir_make_const_int_value(lowering->ir, a < b ? 1 : 0, type);
             }
-            if (strcmp(node->as.binary_expr.operator_text, "<=") == 0) {
-                return vitte_ir_make_const_int_value(lowering->ir, left->as.int_value <= right->as.int_value ? 1 : 0, type);
+            if (vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_LE)) {
+                return vitte_ir_make_const_int_value(lowering->ir, a <= b ? 1 : 0, type);
             }
-            if (strcmp(node->as.binary_expr.operator_text, ">") == 0) {
-                return vitte_ir_make_const_int_value(lowering->ir, left->as.int_value > right->as.int_value ? 1 : 0, type);
+            if (vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_GT)) {
+                return vitte_ir_make_const_int_value(lowering->ir, a > b ? 1 : 0, type);
             }
-            if (strcmp(node->as.binary_expr.operator_text, ">=") == 0) {
-                return vitte_ir_make_const_int_value(lowering->ir, left->as.int_value >= right->as.int_value ? 1 : 0, type);
+            if (vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_GE)) {
+                return vitte_ir_make_const_int_value(lowering->ir, a >= b ? 1 : 0, type);
             }
             vitte_ir_lowering_set_error(lowering, VITTE_STATUS_ERROR_UNSUPPORTED, "VITTE_IR_E_CONST", "unsupported constant binary operator", node->as.binary_expr.operator_text);
             return NULL;
@@ -1440,15 +1748,18 @@ static vitte_ir_value_t *vitte_ir_resolve_global_initializer(vitte_ir_lowering_t
     return global->initializer;
 }
 
+/* `field_name` is interned; forms are matched on the tail of the type's name. */
 static vitte_ir_type_t *vitte_ir_form_field_type(vitte_ir_lowering_t *lowering, const vitte_ir_type_t *base_type, const char *field_name) {
     const vitte_ir_form_t *form;
     const vitte_ir_form_field_t *field;
+    vitte_ir_t *ir;
     if (lowering == NULL || base_type == NULL || field_name == NULL) return NULL;
-    if (lowering->ir == NULL || lowering->ir->module == NULL || base_type->name == NULL) return NULL;
-    for (form = lowering->ir->module->first_form; form != NULL; form = form->next) {
-        if (form->name == NULL || strcmp(vitte_ir_symbol_tail(form->name), vitte_ir_symbol_tail(base_type->name)) != 0) continue;
+    ir = lowering->ir;
+    if (ir == NULL || ir->module == NULL || base_type->name == NULL || !vitte_ir_index_forms(ir)) return NULL;
+    form = (const vitte_ir_form_t *)vitte_ir_name_map_get(&ir->form_tails, vitte_ir_tail_name(ir, base_type->name));
+    for (; form != NULL; form = form->next_same_tail) {
         for (field = form->first_field; field != NULL; field = field->next) {
-            if (field->name != NULL && strcmp(field->name, field_name) == 0) return field->type;
+            if (field->name == field_name) return field->type;
         }
     }
     return NULL;
@@ -1467,12 +1778,12 @@ static char *vitte_ir_copy_text(vitte_ir_t *ir, const char *text, size_t length)
 static vitte_ir_type_t *vitte_ir_list_element_type(vitte_ir_lowering_t *lowering, const vitte_ir_type_t *list_type) {
     const char *open;
     const char *close;
-    char *name;
+    const char *name;
     if (lowering == NULL || list_type == NULL || list_type->name == NULL) return vitte_ir_make_type(lowering->ir, VITTE_IR_TYPE_I32);
     open = strchr(list_type->name, '[');
     close = strrchr(list_type->name, ']');
     if (open == NULL || close == NULL || close <= open + 1) return vitte_ir_make_type(lowering->ir, VITTE_IR_TYPE_I32);
-    name = vitte_ir_copy_text(lowering->ir, open + 1, (size_t)(close - open - 1));
+    name = vitte_ir_intern_range(lowering->ir, open + 1, (size_t)(close - open - 1));
     return name != NULL ? vitte_ir_type_from_name(lowering->ir, name) : NULL;
 }
 
@@ -1481,46 +1792,46 @@ static vitte_ir_value_t *vitte_ir_lower_dotted_local(
     const char *name,
     const vitte_hir_node_t *source
 ) {
-    const vitte_ir_local_binding_t *binding;
-    if (lowering == NULL || name == NULL || strchr(name, '.') == NULL) return NULL;
-    for (binding = lowering->locals; binding != NULL; binding = binding->next) {
-        size_t prefix_length;
-        const char *cursor;
-        vitte_ir_value_t *value;
-        if (binding->name == NULL) continue;
-        prefix_length = strlen(binding->name);
-        if (strncmp(name, binding->name, prefix_length) != 0 || name[prefix_length] != '.') continue;
-        value = binding->value->kind == VITTE_IR_VALUE_PARAMETER ?
-            binding->value : vitte_ir_emit_load(&lowering->builder, binding->value, source);
-        cursor = name + prefix_length + 1u;
-        while (value != NULL && *cursor != '\0') {
-            const char *dot = strchr(cursor, '.');
-            size_t length = dot != NULL ? (size_t)(dot - cursor) : strlen(cursor);
-            char *field = vitte_ir_copy_text(lowering->ir, cursor, length);
-            vitte_ir_type_t *field_type = field != NULL ? vitte_ir_form_field_type(lowering, value->type, field) : NULL;
-            if (field == NULL) return NULL;
-            if (field_type == NULL) field_type = vitte_ir_make_type(lowering->ir, VITTE_IR_TYPE_I32);
-            value = vitte_ir_emit_aggregate_read(&lowering->builder, VITTE_IR_OP_FIELD_GET, value, NULL, field, field_type, source);
-            cursor = dot != NULL ? dot + 1u : cursor + length;
-        }
-        return value;
+    const char *dot;
+    const char *cursor;
+    vitte_ir_value_t *local;
+    vitte_ir_value_t *value;
+    if (lowering == NULL || name == NULL) return NULL;
+    dot = strchr(name, '.');
+    if (dot == NULL) return NULL;
+    local = vitte_ir_find_local(lowering, vitte_ir_find_name(lowering->ir, name, (size_t)(dot - name)));
+    if (local == NULL) return NULL;
+    value = local->kind == VITTE_IR_VALUE_PARAMETER ? local : vitte_ir_emit_load(&lowering->builder, local, source);
+    cursor = dot + 1u;
+    while (value != NULL && *cursor != '\0') {
+        const char *next = strchr(cursor, '.');
+        size_t length = next != NULL ? (size_t)(next - cursor) : strlen(cursor);
+        const char *field = vitte_ir_intern_range(lowering->ir, cursor, length);
+        vitte_ir_type_t *field_type = field != NULL ? vitte_ir_form_field_type(lowering, value->type, field) : NULL;
+        if (field == NULL) return NULL;
+        if (field_type == NULL) field_type = vitte_ir_make_type(lowering->ir, VITTE_IR_TYPE_I32);
+        value = vitte_ir_emit_aggregate_read(&lowering->builder, VITTE_IR_OP_FIELD_GET, value, NULL, field, field_type, source);
+        cursor = next != NULL ? next + 1u : cursor + length;
     }
-    return NULL;
+    return value;
 }
 
 static const char *vitte_ir_qualified_name(vitte_ir_lowering_t *lowering, const char *base, const char *member) {
+    char buffer[256];
+    char *name = buffer;
     size_t base_length;
     size_t member_length;
-    char *name;
     if (lowering == NULL || base == NULL || member == NULL) return NULL;
     base_length = strlen(base);
     member_length = strlen(member);
-    name = (char *)vitte_arena_alloc(lowering->ir->arena, base_length + member_length + 2u, _Alignof(char));
-    if (name == NULL) return NULL;
+    if (base_length + member_length + 1u > sizeof(buffer)) {
+        name = (char *)vitte_arena_alloc(lowering->ir->arena, base_length + member_length + 1u, _Alignof(char));
+        if (name == NULL) return NULL;
+    }
     (void)memcpy(name, base, base_length);
     name[base_length] = '.';
-    (void)memcpy(name + base_length + 1u, member, member_length + 1u);
-    return name;
+    (void)memcpy(name + base_length + 1u, member, member_length);
+    return vitte_ir_intern_range(lowering->ir, name, base_length + member_length + 1u);
 }
 
 static vitte_ir_value_t *vitte_ir_lower_expr(vitte_ir_lowering_t *lowering, const vitte_hir_node_t *node, size_t depth) {
@@ -1557,9 +1868,9 @@ static vitte_ir_value_t *vitte_ir_lower_expr(vitte_ir_lowering_t *lowering, cons
         }
         case VITTE_HIR_VARIABLE: {
             vitte_ir_value_t *dotted_local = vitte_ir_lower_dotted_local(lowering, node->as.variable.name, node);
-            vitte_ir_value_t *local = vitte_ir_lookup_local(lowering, node->as.variable.name);
-            vitte_ir_global_t *global = vitte_ir_lookup_global(lowering, node->as.variable.name);
-            vitte_ir_function_t *function = vitte_ir_lookup_function(lowering, node->as.variable.name);
+            vitte_ir_value_t *local;
+            vitte_ir_global_t *global;
+            vitte_ir_function_t *function;
             vitte_ir_value_t *builtin_constant;
             vitte_ir_value_t *builtin_function;
             int64_t pick_discriminant;
@@ -1567,15 +1878,18 @@ static vitte_ir_value_t *vitte_ir_lower_expr(vitte_ir_lowering_t *lowering, cons
             if (dotted_local != NULL) {
                 return dotted_local;
             }
+            local = vitte_ir_lookup_local(lowering, node->as.variable.name);
             if (local != NULL) {
                 if (local->kind == VITTE_IR_VALUE_PARAMETER) {
                     return local;
                 }
                 return vitte_ir_emit_load(&lowering->builder, local, node);
             }
+            global = vitte_ir_lookup_global(lowering, node->as.variable.name);
             if (global != NULL) {
                 return vitte_ir_resolve_global_initializer(lowering, global);
             }
+            function = vitte_ir_lookup_function(lowering, node->as.variable.name);
             if (function != NULL) {
                 return vitte_ir_make_function_ref_value(lowering->ir, function->name, function, function->return_type);
             }
@@ -1603,7 +1917,7 @@ static vitte_ir_value_t *vitte_ir_lower_expr(vitte_ir_lowering_t *lowering, cons
             if (builtin_function != NULL) {
                 return builtin_function;
             }
-            if (strcmp(node->as.variable.name, "split") == 0) {
+            if (vitte_ir_is_name(lowering->ir, vitte_ir_find_name(lowering->ir, node->as.variable.name, strlen(node->as.variable.name)), VITTE_IR_NAME_SPLIT)) {
                 return vitte_ir_make_function_ref_value(
                     lowering->ir,
                     node->as.variable.name,
@@ -1630,8 +1944,9 @@ static vitte_ir_value_t *vitte_ir_lower_expr(vitte_ir_lowering_t *lowering, cons
         }
         case VITTE_HIR_MEMBER_EXPR: {
             vitte_ir_value_t *base = vitte_ir_lower_expr(lowering, node->as.member_expr.base, depth + 1u);
+            const char *member = vitte_ir_intern(lowering->ir, node->as.member_expr.member);
             vitte_ir_type_t *field_type;
-            if (base == NULL) return NULL;
+            if (base == NULL || member == NULL) return NULL;
             if (base->kind == VITTE_IR_VALUE_FUNCTION_REF && base->as.function == NULL) {
                 const char *qualified = vitte_ir_qualified_name(lowering, base->name, node->as.member_expr.member);
                 vitte_ir_function_t *function = vitte_ir_lookup_function(lowering, qualified);
@@ -1642,7 +1957,7 @@ static vitte_ir_value_t *vitte_ir_lower_expr(vitte_ir_lowering_t *lowering, cons
                     function != NULL ? function->return_type : vitte_ir_make_type(lowering->ir, VITTE_IR_TYPE_I32)
                 );
             }
-            if (strcmp(node->as.member_expr.member, "len") == 0 && base->type != NULL &&
+            if (vitte_ir_is_name(lowering->ir, member, VITTE_IR_NAME_LEN) && base->type != NULL &&
                 (base->type->kind == VITTE_IR_TYPE_STRING_PTR ||
                     (base->type->kind == VITTE_IR_TYPE_AGGREGATE_PTR && base->type->name != NULL &&
                         (strncmp(base->type->name, "list[", strlen("list[")) == 0 || base->type->name[0] == '[')))) {
@@ -1651,9 +1966,9 @@ static vitte_ir_value_t *vitte_ir_lower_expr(vitte_ir_lowering_t *lowering, cons
                 vitte_ir_value_t *arguments[1] = {base};
                 return callee != NULL ? vitte_ir_emit_call(&lowering->builder, callee, arguments, 1u, return_type, node) : NULL;
             }
-            field_type = vitte_ir_form_field_type(lowering, base->type, node->as.member_expr.member);
+            field_type = vitte_ir_form_field_type(lowering, base->type, member);
             if (field_type == NULL) field_type = vitte_ir_make_type(lowering->ir, VITTE_IR_TYPE_I32);
-            return vitte_ir_emit_aggregate_read(&lowering->builder, VITTE_IR_OP_FIELD_GET, base, NULL, node->as.member_expr.member, field_type, node);
+            return vitte_ir_emit_aggregate_read(&lowering->builder, VITTE_IR_OP_FIELD_GET, base, NULL, member, field_type, node);
         }
         case VITTE_HIR_BINARY_EXPR: {
             vitte_ir_value_t *left = vitte_ir_lower_expr(lowering, node->as.binary_expr.left, depth + 1u);
@@ -1690,7 +2005,7 @@ static vitte_ir_value_t *vitte_ir_lower_expr(vitte_ir_lowering_t *lowering, cons
             }
             result = vitte_ir_emit_binary(&lowering->builder, node->as.binary_expr.operator_text, left, right, node);
             if (result != NULL) {
-                result_type = vitte_ir_operator_returns_bool(node->as.binary_expr.operator_text) ?
+                result_type = vitte_ir_operator_returns_bool(lowering->ir, result->definition->operator_text) ?
                     vitte_ir_make_type(lowering->ir, VITTE_IR_TYPE_BOOL) :
                     operand_type;
                 result->type = result_type;
@@ -1803,9 +2118,9 @@ static void vitte_ir_discard_emitted_result(vitte_ir_value_t *value) {
     }
 }
 
-static bool vitte_ir_is_short_circuit_operator(const char *operator_text) {
-    return operator_text != NULL &&
-        (strcmp(operator_text, "&&") == 0 || strcmp(operator_text, "||") == 0);
+/* `operator_text` is interned. */
+static bool vitte_ir_is_short_circuit_operator(const vitte_ir_t *ir, const char *operator_text) {
+    return vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_AND) || vitte_ir_is_name(ir, operator_text, VITTE_IR_NAME_OR);
 }
 
 static vitte_ir_value_t *vitte_ir_coerce_value(
@@ -1881,8 +2196,10 @@ static vitte_status_t vitte_ir_lower_expr_discard(vitte_ir_lowering_t *lowering,
             vitte_ir_discard_emitted_result(value);
             return VITTE_STATUS_OK;
         }
-        case VITTE_HIR_BINARY_EXPR:
-            if (vitte_ir_is_short_circuit_operator(node->as.binary_expr.operator_text)) {
+        case VITTE_HIR_BINARY_EXPR: {
+            const char *operator_text = vitte_ir_find_name(lowering->ir, node->as.binary_expr.operator_text, strlen(node->as.binary_expr.operator_text));
+
+            if (vitte_ir_is_short_circuit_operator(lowering->ir, operator_text)) {
                 vitte_ir_function_t *function = lowering->builder.function;
                 vitte_ir_block_t *rhs_block;
                 vitte_ir_block_t *skip_block;
@@ -1907,7 +2224,7 @@ static vitte_status_t vitte_ir_lower_expr_discard(vitte_ir_lowering_t *lowering,
                     return VITTE_STATUS_ERROR_INVALID_STATE;
                 }
 
-                if (strcmp(node->as.binary_expr.operator_text, "&&") == 0) {
+                if (vitte_ir_is_name(lowering->ir, operator_text, VITTE_IR_NAME_AND)) {
                     if (vitte_ir_emit_cond_branch(&lowering->builder, condition, rhs_block, skip_block, node) == NULL) {
                         return VITTE_STATUS_ERROR_INVALID_STATE;
                     }
@@ -1938,6 +2255,7 @@ static vitte_status_t vitte_ir_lower_expr_discard(vitte_ir_lowering_t *lowering,
                 return lowering->last_error.status;
             }
             return vitte_ir_lower_expr_discard(lowering, node->as.binary_expr.right, depth + 1u);
+        }
         case VITTE_HIR_LIST_EXPR:
         case VITTE_HIR_RECORD_EXPR: {
             vitte_ir_value_t *value = vitte_ir_lower_expr(lowering, node, depth + 1u);
@@ -2033,12 +2351,13 @@ static vitte_status_t vitte_ir_lower_stmt(vitte_ir_lowering_t *lowering, const v
                     char *base_name = vitte_ir_copy_text(lowering->ir, target->as.variable.name, (size_t)(dot - target->as.variable.name));
                     vitte_ir_value_t *base = base_name != NULL && strchr(base_name, '.') != NULL ?
                         vitte_ir_lower_dotted_local(lowering, base_name, target) : vitte_ir_lookup_local(lowering, base_name);
+                    const char *field = vitte_ir_intern(lowering->ir, dot + 1u);
                     vitte_ir_type_t *field_type;
                     if (base != NULL && base->kind == VITTE_IR_VALUE_LOCAL) base = vitte_ir_emit_load(&lowering->builder, base, target);
-                    if (base == NULL) return VITTE_STATUS_ERROR_INVALID_STATE;
-                    field_type = vitte_ir_form_field_type(lowering, base->type, dot + 1u);
+                    if (base == NULL || field == NULL) return VITTE_STATUS_ERROR_INVALID_STATE;
+                    field_type = vitte_ir_form_field_type(lowering, base->type, field);
                     if (field_type != NULL) value = vitte_ir_coerce_value(lowering, value, field_type, node);
-                    return value != NULL && vitte_ir_emit_aggregate_write(&lowering->builder, VITTE_IR_OP_FIELD_SET, base, NULL, value, dot + 1u, node) != NULL ?
+                    return value != NULL && vitte_ir_emit_aggregate_write(&lowering->builder, VITTE_IR_OP_FIELD_SET, base, NULL, value, field, node) != NULL ?
                         VITTE_STATUS_OK : VITTE_STATUS_ERROR_INVALID_STATE;
                 }
                 vitte_ir_value_t *local = vitte_ir_lookup_local(lowering, target->as.variable.name);
@@ -2053,8 +2372,9 @@ static vitte_status_t vitte_ir_lower_stmt(vitte_ir_lowering_t *lowering, const v
             }
             if (target->kind == VITTE_HIR_MEMBER_EXPR) {
                 vitte_ir_value_t *base = vitte_ir_lower_expr(lowering, target->as.member_expr.base, depth + 1u);
-                vitte_ir_type_t *field_type = base != NULL ? vitte_ir_form_field_type(lowering, base->type, target->as.member_expr.member) : NULL;
-                if (base == NULL) return VITTE_STATUS_ERROR_INVALID_STATE;
+                const char *member = vitte_ir_intern(lowering->ir, target->as.member_expr.member);
+                vitte_ir_type_t *field_type = base != NULL ? vitte_ir_form_field_type(lowering, base->type, member) : NULL;
+                if (base == NULL || member == NULL) return VITTE_STATUS_ERROR_INVALID_STATE;
                 if (field_type != NULL) value = vitte_ir_coerce_value(lowering, value, field_type, node);
                 return value != NULL && vitte_ir_emit_aggregate_write(&lowering->builder, VITTE_IR_OP_FIELD_SET, base, NULL, value, target->as.member_expr.member, node) != NULL ?
                     VITTE_STATUS_OK : VITTE_STATUS_ERROR_INVALID_STATE;
@@ -2445,8 +2765,6 @@ static vitte_status_t vitte_ir_validate_value(
     return VITTE_STATUS_OK;
 }
 
-static bool vitte_ir_operator_returns_bool(const char *operator_text);
-
 static vitte_status_t vitte_ir_validate_call_signature(
     vitte_ir_t *ir,
     const vitte_ir_instruction_t *instruction
@@ -2498,17 +2816,7 @@ static vitte_status_t vitte_ir_validate_call_signature(
 }
 
 static bool vitte_ir_function_contains_block(const vitte_ir_function_t *function, const vitte_ir_block_t *target) {
-    const vitte_ir_block_t *block;
-
-    if (function == NULL || target == NULL) {
-        return false;
-    }
-    for (block = function->first_block; block != NULL; block = block->next) {
-        if (block == target) {
-            return true;
-        }
-    }
-    return false;
+    return function != NULL && target != NULL && target->function == function;
 }
 
 static vitte_status_t vitte_ir_validate_instruction(vitte_ir_t *ir, const vitte_ir_function_t *function, const vitte_ir_instruction_t *instruction) {
@@ -2612,7 +2920,7 @@ static vitte_status_t vitte_ir_validate_instruction(vitte_ir_t *ir, const vitte_
                 vitte_ir_set_error(ir, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_IR_E_BINARY", "IR binary instruction has invalid operands or result", instruction->operator_text);
                 return VITTE_STATUS_ERROR_INVALID_STATE;
             }
-            if (vitte_ir_operator_returns_bool(instruction->operator_text)) {
+            if (vitte_ir_operator_returns_bool(ir, instruction->operator_text)) {
                 if (instruction->result->type == NULL || instruction->result->type->kind != VITTE_IR_TYPE_BOOL) {
                     vitte_ir_set_error(ir, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_IR_E_BINARY", "IR comparison/logical result must be bool", instruction->operator_text);
                     return VITTE_STATUS_ERROR_INVALID_STATE;
@@ -2697,46 +3005,62 @@ static vitte_status_t vitte_ir_validate_instruction(vitte_ir_t *ir, const vitte_
     return VITTE_STATUS_OK;
 }
 
-static bool vitte_ir_global_name_exists_before(const vitte_ir_module_t *module, const vitte_ir_global_t *needle) {
-    const vitte_ir_global_t *global;
+static bool vitte_ir_parameter_name_exists_before(const vitte_ir_function_t *function, const vitte_ir_value_t *needle) {
+    const vitte_ir_value_t *parameter;
 
-    if (module == NULL || needle == NULL || needle->name == NULL) {
+    if (function == NULL || needle == NULL || needle->name == NULL) {
         return false;
     }
-    for (global = module->first_global; global != NULL && global != needle; global = global->next) {
-        if (global->name != NULL && strcmp(global->name, needle->name) == 0) {
+    for (parameter = function->first_parameter; parameter != NULL && parameter != needle; parameter = parameter->next) {
+        if (parameter->name == needle->name) {
             return true;
         }
     }
     return false;
 }
 
-static bool vitte_ir_function_name_exists_before(const vitte_ir_module_t *module, const vitte_ir_function_t *needle) {
+/* Names are interned, so duplicates are found with one pointer set per kind. */
+static vitte_status_t vitte_ir_validate_unique_names(vitte_ir_t *ir) {
+    vitte_arena_t scratch;
+    vitte_ir_name_map_t seen;
+    const vitte_ir_global_t *global;
     const vitte_ir_function_t *function;
+    vitte_status_t status;
+    void *previous;
 
-    if (module == NULL || needle == NULL || needle->name == NULL) {
-        return false;
+    status = vitte_arena_init(&scratch, &ir->arena->config);
+    if (status != VITTE_STATUS_OK) {
+        vitte_error_copy(&ir->last_error, vitte_arena_last_error(&scratch));
+        return status;
     }
-    for (function = module->first_function; function != NULL && function != needle; function = function->next) {
-        if (function->name != NULL && strcmp(function->name, needle->name) == 0) {
-            return true;
+    memset(&seen, 0, sizeof(seen));
+    for (global = ir->module->first_global; status == VITTE_STATUS_OK && global != NULL; global = global->next) {
+        if (global->name == NULL) {
+            continue;
+        }
+        if (!vitte_ir_name_map_put(&seen, &scratch, global->name, (void *)global, false, &previous)) {
+            vitte_error_copy(&ir->last_error, vitte_arena_last_error(&scratch));
+            status = VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        } else if (previous != NULL) {
+            vitte_ir_set_error(ir, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_IR_E_GLOBAL", "invalid IR global", global->name);
+            status = VITTE_STATUS_ERROR_INVALID_STATE;
         }
     }
-    return false;
-}
-
-static bool vitte_ir_parameter_name_exists_before(const vitte_ir_function_t *function, const vitte_ir_value_t *needle) {
-    const vitte_ir_value_t *parameter;
-
-    if (function == NULL || needle == NULL || needle->name == NULL) {
-        return false;
-    }
-    for (parameter = function->first_parameter; parameter != NULL && parameter != needle; parameter = parameter->next) {
-        if (parameter->name != NULL && strcmp(parameter->name, needle->name) == 0) {
-            return true;
+    memset(&seen, 0, sizeof(seen));
+    for (function = ir->module->first_function; status == VITTE_STATUS_OK && function != NULL; function = function->next) {
+        if (function->name == NULL) {
+            continue;
+        }
+        if (!vitte_ir_name_map_put(&seen, &scratch, function->name, (void *)function, false, &previous)) {
+            vitte_error_copy(&ir->last_error, vitte_arena_last_error(&scratch));
+            status = VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        } else if (previous != NULL) {
+            vitte_ir_set_error(ir, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_IR_E_FUNCTION", "invalid IR function", NULL);
+            status = VITTE_STATUS_ERROR_INVALID_STATE;
         }
     }
-    return false;
+    vitte_arena_destroy(&scratch);
+    return status;
 }
 
 vitte_status_t vitte_ir_validate(vitte_ir_t *ir) {
@@ -2753,6 +3077,12 @@ vitte_status_t vitte_ir_validate(vitte_ir_t *ir) {
         vitte_ir_set_error(ir, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_IR_E_STATE", "IR module is missing", NULL);
         return VITTE_STATUS_ERROR_INVALID_STATE;
     }
+    {
+        vitte_status_t status = vitte_ir_validate_unique_names(ir);
+        if (status != VITTE_STATUS_OK) {
+            return status;
+        }
+    }
     for (global = ir->module->first_global; global != NULL; global = global->next) {
         globals++;
         if (global->name == NULL ||
@@ -2760,7 +3090,6 @@ vitte_status_t vitte_ir_validate(vitte_ir_t *ir) {
             global->initializer == NULL ||
             !global->initialized ||
             global->resolving ||
-            vitte_ir_global_name_exists_before(ir->module, global) ||
             vitte_ir_validate_value(ir, global->initializer, "global", false) != VITTE_STATUS_OK ||
             !vitte_ir_type_equals(global->type, global->initializer->type)) {
             vitte_ir_set_error(ir, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_IR_E_GLOBAL", "invalid IR global", global != NULL ? global->name : NULL);
@@ -2814,8 +3143,7 @@ vitte_status_t vitte_ir_validate(vitte_ir_t *ir) {
             !vitte_ir_type_is_backend_stable(function->return_type) ||
             function->entry == NULL ||
             function->block_count == 0u ||
-            function->first_block != function->entry ||
-            vitte_ir_function_name_exists_before(ir->module, function)) {
+            function->first_block != function->entry) {
             vitte_ir_set_error(ir, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_IR_E_FUNCTION", "invalid IR function", NULL);
             return VITTE_STATUS_ERROR_INVALID_STATE;
         }
@@ -2867,6 +3195,161 @@ vitte_status_t vitte_ir_validate(vitte_ir_t *ir) {
     return VITTE_STATUS_OK;
 }
 
+/*
+ * String constants already copied by vitte_ir_detach, keyed by their borrowed
+ * address so literals shared across the module stay shared. Names need no
+ * copy: they live in the interner. The table lives in a scratch arena dropped
+ * when detaching ends.
+ */
+typedef struct vitte_ir_detach_state {
+    vitte_ir_t *ir;
+    vitte_arena_t scratch;
+    const char **keys;
+    const char **copies;
+    size_t capacity;
+    size_t count;
+} vitte_ir_detach_state_t;
+
+static size_t vitte_ir_detach_slot(const vitte_ir_detach_state_t *state, const char *key) {
+    size_t mask = state->capacity - 1u;
+    size_t slot = vitte_util_hash_pointer(key) & mask;
+
+    while (state->keys[slot] != NULL && state->keys[slot] != key) {
+        slot = (slot + 1u) & mask;
+    }
+    return slot;
+}
+
+static bool vitte_ir_detach_grow(vitte_ir_detach_state_t *state) {
+    const char **old_keys = state->keys;
+    const char **old_copies = state->copies;
+    size_t old_capacity = state->capacity;
+    size_t capacity = old_capacity != 0u ? old_capacity * 2u : 1024u;
+    size_t index;
+
+    state->keys = (const char **)vitte_arena_alloc_zeroed(&state->scratch, capacity * sizeof(*state->keys), _Alignof(const char *));
+    state->copies = (const char **)vitte_arena_alloc(&state->scratch, capacity * sizeof(*state->copies), _Alignof(const char *));
+    if (state->keys == NULL || state->copies == NULL) {
+        return false;
+    }
+    state->capacity = capacity;
+    for (index = 0u; index < old_capacity; index++) {
+        if (old_keys[index] != NULL) {
+            size_t slot = vitte_ir_detach_slot(state, old_keys[index]);
+
+            state->keys[slot] = old_keys[index];
+            state->copies[slot] = old_copies[index];
+        }
+    }
+    return true;
+}
+
+static bool vitte_ir_detach_text(vitte_ir_detach_state_t *state, const char **text) {
+    size_t slot;
+
+    if (*text == NULL || vitte_arena_contains(state->ir->arena, *text)) {
+        return true;
+    }
+    if ((state->count + 1u) * 2u > state->capacity && !vitte_ir_detach_grow(state)) {
+        return false;
+    }
+    slot = vitte_ir_detach_slot(state, *text);
+    if (state->keys[slot] == NULL) {
+        char *copy = vitte_ir_copy_text(state->ir, *text, strlen(*text));
+
+        if (copy == NULL) {
+            return false;
+        }
+        state->keys[slot] = *text;
+        state->copies[slot] = copy;
+        state->count++;
+    }
+    *text = state->copies[slot];
+    return true;
+}
+
+static bool vitte_ir_detach_value(vitte_ir_detach_state_t *state, vitte_ir_value_t *value) {
+    return value == NULL ||
+        value->kind != VITTE_IR_VALUE_CONST_STRING ||
+        vitte_ir_detach_text(state, &value->as.string_value);
+}
+
+static bool vitte_ir_detach_function(vitte_ir_detach_state_t *state, vitte_ir_function_t *function) {
+    vitte_ir_block_t *block;
+
+    function->source = NULL;
+    for (block = function->first_block; block != NULL; block = block->next) {
+        vitte_ir_instruction_t *instruction;
+
+        block->source = NULL;
+        for (instruction = block->first; instruction != NULL; instruction = instruction->next) {
+            size_t index;
+
+            if (!vitte_ir_detach_value(state, instruction->result)) {
+                return false;
+            }
+            for (index = 0u; index < instruction->operand_count; index++) {
+                if (!vitte_ir_detach_value(state, instruction->operands[index])) {
+                    return false;
+                }
+            }
+            instruction->source = NULL;
+        }
+    }
+    return true;
+}
+
+static bool vitte_ir_detach_module(vitte_ir_detach_state_t *state, vitte_ir_module_t *module) {
+    vitte_ir_global_t *global;
+    vitte_ir_pick_t *pick;
+    vitte_ir_form_t *form;
+    vitte_ir_function_t *function;
+
+    for (global = module->first_global; global != NULL; global = global->next) {
+        if (!vitte_ir_detach_value(state, global->initializer)) {
+            return false;
+        }
+        global->source = NULL;
+    }
+    for (pick = module->first_pick; pick != NULL; pick = pick->next) {
+        pick->source = NULL;
+    }
+    for (form = module->first_form; form != NULL; form = form->next) {
+        form->source = NULL;
+    }
+    for (function = module->first_function; function != NULL; function = function->next) {
+        if (!vitte_ir_detach_function(state, function)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+vitte_status_t vitte_ir_detach(vitte_ir_t *ir) {
+    vitte_ir_detach_state_t state;
+    vitte_status_t status;
+    bool detached;
+
+    if (!vitte_ir_is_initialized(ir) || ir->module == NULL) {
+        vitte_ir_set_error(ir, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_IR_E_STATE", "IR module is missing", NULL);
+        return VITTE_STATUS_ERROR_INVALID_STATE;
+    }
+    memset(&state, 0, sizeof(state));
+    state.ir = ir;
+    status = vitte_arena_init(&state.scratch, &ir->arena->config);
+    if (status != VITTE_STATUS_OK) {
+        vitte_error_copy(&ir->last_error, vitte_arena_last_error(&state.scratch));
+        return status;
+    }
+    detached = vitte_ir_detach_module(&state, ir->module);
+    vitte_arena_destroy(&state.scratch);
+    if (!detached) {
+        vitte_ir_set_error(ir, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_IR_E_DETACH", "failed to copy IR strings", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    return VITTE_STATUS_OK;
+}
+
 void vitte_ir_dump(const vitte_ir_t *ir, FILE *stream) {
     const vitte_ir_global_t *global;
     const vitte_ir_function_t *function;
@@ -8,7 +8,9 @@
 
 #include "../api/error.h"
 #include "../arena/arena.h"
+#include "../arena/slab.h"
 #include "../hir/hir.h"
+#include "../intern/intern.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -81,8 +83,6 @@ typedef struct vitte_ir_form_field vitte_ir_form_field_t;
 typedef struct vitte_ir_form vitte_ir_form_t;
 typedef struct vitte_ir_module vitte_ir_module_t;
 typedef struct vitte_ir_local_binding vitte_ir_local_binding_t;
-typedef struct vitte_ir_function_binding vitte_ir_function_binding_t;
-typedef struct vitte_ir_global_binding vitte_ir_global_binding_t;
 typedef struct vitte_ir_scope_marker vitte_ir_scope_marker_t;
 
 struct vitte_ir_type {
@@ -125,12 +125,16 @@ struct vitte_ir_block {
     size_t instruction_count;
     bool terminated;
     const vitte_hir_node_t *source;
+    /* The function the block was added to, so branch targets check in O(1). */
+    const vitte_ir_function_t *function;
     vitte_ir_block_t *next;
 };
 
 struct vitte_ir_function {
     vitte_ir_function_id_t id;
     const char *name;
+    /* The name the function was declared under, before import qualification. */
+    const char *source_name;
     vitte_ir_type_t *return_type;
     vitte_ir_value_t *first_parameter;
     vitte_ir_value_t *last_parameter;
@@ -180,10 +184,14 @@ struct vitte_ir_form {
     size_t field_count;
     const vitte_hir_node_t *source;
     vitte_ir_form_t *next;
+    /* Next form in module order whose name has the same symbol tail. */
+    vitte_ir_form_t *next_same_tail;
 };
 
 struct vitte_ir_module {
     const char *name;
+    /* Every name in the module is interned here, so names compare by pointer. */
+    vitte_interner_t *interner;
     vitte_ir_global_t *first_global;
     vitte_ir_global_t *last_global;
     size_t global_count;
@@ -198,12 +206,33 @@ struct vitte_ir_module {
     size_t function_count;
 };
 
+/*
+ * Open-addressed map from an interned name to an IR entity. Keys are
+ * canonical, so probes compare pointers; tables live in the IR arena.
+ */
+typedef struct vitte_ir_name_map {
+    const char **keys;
+    void **values;
+    size_t count;
+    size_t capacity;
+} vitte_ir_name_map_t;
+
 typedef struct vitte_ir {
     bool initialized;
     bool owns_arena;
+    bool owns_interner;
     vitte_arena_t *arena;
     vitte_arena_t owned_arena;
+    vitte_interner_t *interner;
+    vitte_interner_t owned_interner;
+    /* Interned spellings of the type names and operators lowering tests for. */
+    const char **known_names;
     vitte_ir_module_t *module;
+    /* Picks and forms keyed by interned symbol tail, indexed on the next lookup after they are added. */
+    vitte_ir_name_map_t pick_tails;
+    vitte_ir_name_map_t form_tails;
+    vitte_ir_pick_t *last_indexed_pick;
+    vitte_ir_form_t *last_indexed_form;
     vitte_ir_value_id_t next_value_id;
     vitte_ir_block_id_t next_block_id;
     vitte_ir_function_id_t next_function_id;
@@ -225,9 +254,13 @@ typedef struct vitte_ir_lowering {
     vitte_ir_builder_t builder;
     size_t max_depth;
     vitte_ir_local_binding_t *locals;
-    vitte_ir_function_binding_t *functions;
-    vitte_ir_global_binding_t *globals;
+    /* Later bindings replace earlier ones under the same name. */
+    vitte_ir_name_map_t functions;
+    vitte_ir_name_map_t function_sources;
+    vitte_ir_name_map_t globals;
     vitte_ir_scope_marker_t *scopes;
+    /* Scope markers and local bindings, recycled as scopes close. */
+    vitte_arena_slab_t scratch;
     vitte_ir_block_t *break_targets[64];
     vitte_ir_block_t *continue_targets[64];
     size_t loop_depth;
@@ -237,6 +270,11 @@ typedef struct vitte_ir_lowering {
 vitte_status_t vitte_ir_init(vitte_ir_t *ir, vitte_arena_t *arena);
 vitte_status_t vitte_ir_init_owned(vitte_ir_t *ir, const vitte_arena_config_t *config);
 void vitte_ir_destroy(vitte_ir_t *ir);
+/*
+ * Interns IR names in `interner` instead of an IR-owned one, so they share
+ * pointers with the lexer's identifiers. Must be called before lowering.
+ */
+vitte_status_t vitte_ir_use_interner(vitte_ir_t *ir, vitte_interner_t *interner);
 bool vitte_ir_is_initialized(const vitte_ir_t *ir);
 const vitte_error_t *vitte_ir_last_error(const vitte_ir_t *ir);
 void vitte_ir_clear_error(vitte_ir_t *ir);
@@ -300,6 +338,13 @@ vitte_status_t vitte_ir_lower_hir(vitte_ir_t *ir, const vitte_hir_t *hir);
 vitte_status_t vitte_ir_lower_hir_with_options(vitte_ir_lowering_t *lowering, const vitte_hir_t *hir);
 
 vitte_status_t vitte_ir_validate(vitte_ir_t *ir);
+
+/*
+ * Copies the strings the IR borrows from the AST into its arena and clears
+ * every `source` link, after which the AST and HIR it was lowered from may be
+ * destroyed. Interned names are left pointing into the interner.
+ */
+vitte_status_t vitte_ir_detach(vitte_ir_t *ir);
 void vitte_ir_dump(const vitte_ir_t *ir, FILE *stream);
 
 #ifdef __cplusplus
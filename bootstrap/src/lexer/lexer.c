@@ -1,9 +1,39 @@
 #include "lexer.h"
 
-#include <ctype.h>
 #include <limits.h>
 #include <string.h>
 
+#define VITTE_LEXER_CLASS_SPACE 1u
+#define VITTE_LEXER_CLASS_IDENT_START 2u
+#define VITTE_LEXER_CLASS_IDENT_CONTINUE 4u
+#define VITTE_LEXER_CLASS_DIGIT 8u
+#define VITTE_LEXER_CLASS_HEX 16u
+
+/*
+ * ASCII character classes, one byte per input byte: 1 space (' ', '\t', '\r',
+ * '\n'), 2 identifier start, 4 identifier continue, 8 decimal digit, 16 hex
+ * digit. Bytes >= 0x80 have no class, matching the "C" locale ctype calls this
+ * table replaces.
+ */
+static const unsigned char vitte_lexer_char_class[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  1,  0,  0,  1,  0,  0, /* 0x00 */
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x10 */
+     1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x20 */
+    28, 28, 28, 28, 28, 28, 28, 28, 28, 28,  0,  0,  0,  0,  0,  0, /* 0x30 */
+     0, 22, 22, 22, 22, 22, 22,  6,  6,  6,  6,  6,  6,  6,  6,  6, /* 0x40 */
+     6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  0,  0,  0,  0,  6, /* 0x50 */
+     0, 22, 22, 22, 22, 22, 22,  6,  6,  6,  6,  6,  6,  6,  6,  6, /* 0x60 */
+     6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  0,  0,  0,  0,  0, /* 0x70 */
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x80 */
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x90 */
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0xa0 */
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0xb0 */
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0xc0 */
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0xd0 */
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0xe0 */
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 /* 0xf0 */
+};
+
 static void vitte_lexer_set_error(
     vitte_lexer_t *lexer,
     vitte_status_t status,
@@ -30,6 +60,7 @@ void vitte_lexer_options_init(vitte_lexer_options_t *options) {
     }
     memset(options, 0, sizeof(*options));
     options->keywords_enabled = true;
+    options->track_positions = true;
     options->max_source_bytes = VITTE_LEXER_DEFAULT_MAX_SOURCE_BYTES;
     options->tab_width = VITTE_LEXER_DEFAULT_TAB_WIDTH;
 }
@@ -302,6 +333,9 @@ static char vitte_lexer_advance_char(vitte_lexer_t *lexer) {
     }
     value = lexer->source[lexer->cursor.offset];
     lexer->cursor.offset++;
+    if (!lexer->options.track_positions) {
+        return value;
+    }
     if (value == '\n') {
         lexer->cursor.line++;
         lexer->cursor.column = 1u;
@@ -311,10 +345,24 @@ static char vitte_lexer_advance_char(vitte_lexer_t *lexer) {
     } else {
         lexer->cursor.column++;
     }
-    lexer->stats.bytes_consumed = lexer->cursor.offset;
     return value;
 }
 
+static bool vitte_lexer_has_class(char value, unsigned int char_class) {
+    return (vitte_lexer_char_class[(unsigned char)value] & char_class) != 0u;
+}
+
+/* Moves the cursor to `offset`, replaying line/column tracking when enabled. */
+static void vitte_lexer_advance_to(vitte_lexer_t *lexer, size_t offset) {
+    if (lexer->options.track_positions) {
+        while (lexer->cursor.offset < offset) {
+            (void)vitte_lexer_advance_char(lexer);
+        }
+        return;
+    }
+    lexer->cursor.offset = offset;
+}
+
 static bool vitte_lexer_match_char(vitte_lexer_t *lexer, char expected) {
     if (vitte_lexer_peek_char(lexer) != expected) {
         return false;
@@ -332,7 +380,6 @@ static void vitte_lexer_fill_token(
     uint32_t start_column,
     const char *message
 ) {
-    vitte_token_init(token);
     token->kind = kind;
     token->source_name = lexer != NULL ? lexer->source_name : NULL;
     token->lexeme_start = lexer != NULL ? lexer->source + start_offset : NULL;
@@ -343,6 +390,10 @@ static void vitte_lexer_fill_token(
     token->start_column = start_column;
     token->end_line = lexer != NULL ? lexer->cursor.line : start_line;
     token->end_column = lexer != NULL ? lexer->cursor.column : start_column;
+    token->identifier = NULL;
+    token->integer_value = 0;
+    token->has_integer_value = false;
+    token->has_escape = false;
     token->message = message;
 }
 
@@ -351,6 +402,7 @@ static void vitte_lexer_count_token(vitte_lexer_t *lexer, const vitte_token_t *t
         return;
     }
     lexer->stats.token_count++;
+    lexer->stats.bytes_consumed = lexer->cursor.offset;
     if (token->kind == VITTE_TOKEN_ERROR) {
         lexer->stats.error_count++;
     } else if (token->kind == VITTE_TOKEN_COMMENT) {
@@ -360,82 +412,107 @@ static void vitte_lexer_count_token(vitte_lexer_t *lexer, const vitte_token_t *t
     }
 }
 
+static vitte_token_kind_t vitte_lexer_keyword_match(
+    const char *start,
+    size_t length,
+    const char *keyword,
+    vitte_token_kind_t kind
+) {
+    return memcmp(start + 1, keyword + 1, length - 1u) == 0 ? kind : VITTE_TOKEN_IDENTIFIER;
+}
+
+/* Keywords are unique by (length, first byte) except `else`/`elif`. */
 static vitte_token_kind_t vitte_lexer_keyword_kind(const char *start, size_t length) {
-    if (length == 5u && memcmp(start, "space", 5u) == 0) {
-        return VITTE_TOKEN_KW_SPACE;
-    }
-    if (length == 3u && memcmp(start, "use", 3u) == 0) {
-        return VITTE_TOKEN_KW_USE;
-    }
-    if (length == 6u && memcmp(start, "export", 6u) == 0) {
-        return VITTE_TOKEN_KW_EXPORT;
-    }
-    if (length == 2u && memcmp(start, "as", 2u) == 0) {
-        return VITTE_TOKEN_KW_AS;
-    }
-    if (length == 4u && memcmp(start, "proc", 4u) == 0) {
-        return VITTE_TOKEN_KW_PROC;
-    }
-    if (length == 5u && memcmp(start, "const", 5u) == 0) {
-        return VITTE_TOKEN_KW_CONST;
-    }
-    if (length == 3u && memcmp(start, "let", 3u) == 0) {
-        return VITTE_TOKEN_KW_LET;
-    }
-    if (length == 3u && memcmp(start, "set", 3u) == 0) {
-        return VITTE_TOKEN_KW_SET;
-    }
-    if (length == 3u && memcmp(start, "mut", 3u) == 0) {
-        return VITTE_TOKEN_KW_MUT;
-    }
-    if (length == 2u && memcmp(start, "if", 2u) == 0) {
-        return VITTE_TOKEN_KW_IF;
-    }
-    if (length == 4u && memcmp(start, "else", 4u) == 0) {
-        return VITTE_TOKEN_KW_ELSE;
-    }
-    if (length == 4u && memcmp(start, "elif", 4u) == 0) {
-        return VITTE_TOKEN_KW_ELIF;
-    }
-    if (length == 5u && memcmp(start, "while", 5u) == 0) {
-        return VITTE_TOKEN_KW_WHILE;
-    }
-    if (length == 5u && memcmp(start, "share", 5u) == 0) {
-        return VITTE_TOKEN_KW_SHARE;
-    }
-    if (length == 9u && memcmp(start, "intrinsic", 9u) == 0) {
-        return VITTE_TOKEN_KW_INTRINSIC;
-    }
-    if (length == 3u && memcmp(start, "for", 3u) == 0) return VITTE_TOKEN_KW_FOR;
-    if (length == 2u && memcmp(start, "in", 2u) == 0) return VITTE_TOKEN_KW_IN;
-    if (length == 5u && memcmp(start, "match", 5u) == 0) return VITTE_TOKEN_KW_MATCH;
-    if (length == 4u && memcmp(start, "give", 4u) == 0) {
-        return VITTE_TOKEN_KW_GIVE;
-    }
-    if (length == 4u && memcmp(start, "pick", 4u) == 0) {
-        return VITTE_TOKEN_KW_PICK;
-    }
-    if (length == 4u && memcmp(start, "form", 4u) == 0) {
-        return VITTE_TOKEN_KW_FORM;
-    }
-    if (length == 3u && memcmp(start, "and", 3u) == 0) {
-        return VITTE_TOKEN_KW_AND;
-    }
-    if (length == 2u && memcmp(start, "or", 2u) == 0) {
-        return VITTE_TOKEN_KW_OR;
-    }
-    if (length == 3u && memcmp(start, "not", 3u) == 0) {
-        return VITTE_TOKEN_KW_NOT;
+    switch (length) {
+        case 2u:
+            switch (start[0]) {
+                case 'a':
+                    return vitte_lexer_keyword_match(start, length, "as", VITTE_TOKEN_KW_AS);
+                case 'i':
+                    return start[1] == 'f' ? VITTE_TOKEN_KW_IF : start[1] == 'n' ? VITTE_TOKEN_KW_IN : VITTE_TOKEN_IDENTIFIER;
+                case 'o':
+                    return vitte_lexer_keyword_match(start, length, "or", VITTE_TOKEN_KW_OR);
+                default:
+                    return VITTE_TOKEN_IDENTIFIER;
+            }
+        case 3u:
+            switch (start[0]) {
+                case 'a':
+                    return vitte_lexer_keyword_match(start, length, "and", VITTE_TOKEN_KW_AND);
+                case 'f':
+                    return vitte_lexer_keyword_match(start, length, "for", VITTE_TOKEN_KW_FOR);
+                case 'l':
+                    return vitte_lexer_keyword_match(start, length, "let", VITTE_TOKEN_KW_LET);
+                case 'm':
+                    return vitte_lexer_keyword_match(start, length, "mut", VITTE_TOKEN_KW_MUT);
+                case 'n':
+                    return vitte_lexer_keyword_match(start, length, "not", VITTE_TOKEN_KW_NOT);
+                case 's':
+                    return vitte_lexer_keyword_match(start, length, "set", VITTE_TOKEN_KW_SET);
+                case 'u':
+                    return vitte_lexer_keyword_match(start, length, "use", VITTE_TOKEN_KW_USE);
+                default:
+                    return VITTE_TOKEN_IDENTIFIER;
+            }
+        case 4u:
+            switch (start[0]) {
+                case 'e':
+                    if (memcmp(start, "else", 4u) == 0) {
+                        return VITTE_TOKEN_KW_ELSE;
+                    }
+                    return vitte_lexer_keyword_match(start, length, "elif", VITTE_TOKEN_KW_ELIF);
+                case 'f':
+                    return vitte_lexer_keyword_match(start, length, "form", VITTE_TOKEN_KW_FORM);
+                case 'g':
+                    return vitte_lexer_keyword_match(start, length, "give", VITTE_TOKEN_KW_GIVE);
+                case 'p':
+                    if (start[1] == 'r') {
+                        return vitte_lexer_keyword_match(start, length, "proc", VITTE_TOKEN_KW_PROC);
+                    }
+                    return vitte_lexer_keyword_match(start, length, "pick", VITTE_TOKEN_KW_PICK);
+                default:
+                    return VITTE_TOKEN_IDENTIFIER;
+            }
+        case 5u:
+            switch (start[0]) {
+                case 'c':
+                    return vitte_lexer_keyword_match(start, length, "const", VITTE_TOKEN_KW_CONST);
+                case 'm':
+                    return vitte_lexer_keyword_match(start, length, "match", VITTE_TOKEN_KW_MATCH);
+                case 's':
+                    if (start[1] == 'p') {
+                        return vitte_lexer_keyword_match(start, length, "space", VITTE_TOKEN_KW_SPACE);
+                    }
+                    return vitte_lexer_keyword_match(start, length, "share", VITTE_TOKEN_KW_SHARE);
+                case 'w':
+                    return vitte_lexer_keyword_match(start, length, "while", VITTE_TOKEN_KW_WHILE);
+                default:
+                    return VITTE_TOKEN_IDENTIFIER;
+            }
+        case 6u:
+            return start[0] == 'e' ? vitte_lexer_keyword_match(start, length, "export", VITTE_TOKEN_KW_EXPORT) : VITTE_TOKEN_IDENTIFIER;
+        case 9u:
+            return start[0] == 'i' ? vitte_lexer_keyword_match(start, length, "intrinsic", VITTE_TOKEN_KW_INTRINSIC) : VITTE_TOKEN_IDENTIFIER;
+        default:
+            return VITTE_TOKEN_IDENTIFIER;
     }
-    return VITTE_TOKEN_IDENTIFIER;
 }
 
 static bool vitte_lexer_is_identifier_start(char value) {
-    return isalpha((unsigned char)value) != 0 || value == '_';
+    return vitte_lexer_has_class(value, VITTE_LEXER_CLASS_IDENT_START);
 }
 
 static bool vitte_lexer_is_identifier_continue(char value) {
-    return isalnum((unsigned char)value) != 0 || value == '_';
+    return vitte_lexer_has_class(value, VITTE_LEXER_CLASS_IDENT_CONTINUE);
+}
+
+static void vitte_lexer_skip_whitespace(vitte_lexer_t *lexer) {
+    size_t offset = lexer->cursor.offset;
+
+    while (offset < lexer->length && vitte_lexer_has_class(lexer->source[offset], VITTE_LEXER_CLASS_SPACE)) {
+        offset++;
+    }
+    vitte_lexer_advance_to(lexer, offset);
 }
 
 static vitte_status_t vitte_lexer_scan_whitespace(vitte_lexer_t *lexer, vitte_token_t *token) {
@@ -443,13 +520,7 @@ static vitte_status_t vitte_lexer_scan_whitespace(vitte_lexer_t *lexer, vitte_to
     uint32_t start_line = lexer->cursor.line;
     uint32_t start_column = lexer->cursor.column;
 
-    while (!vitte_lexer_at_end(lexer)) {
-        char value = vitte_lexer_peek_char(lexer);
-        if (value != ' ' && value != '\t' && value != '\r' && value != '\n') {
-            break;
-        }
-        (void)vitte_lexer_advance_char(lexer);
-    }
+    vitte_lexer_skip_whitespace(lexer);
     vitte_lexer_fill_token(lexer, token, VITTE_TOKEN_WHITESPACE, start_offset, start_line, start_column, NULL);
     return VITTE_STATUS_OK;
 }
@@ -458,12 +529,10 @@ static vitte_status_t vitte_lexer_scan_line_comment(vitte_lexer_t *lexer, vitte_
     size_t start_offset = lexer->cursor.offset;
     uint32_t start_line = lexer->cursor.line;
     uint32_t start_column = lexer->cursor.column;
+    const char *newline;
 
-    (void)vitte_lexer_advance_char(lexer);
-    (void)vitte_lexer_advance_char(lexer);
-    while (!vitte_lexer_at_end(lexer) && vitte_lexer_peek_char(lexer) != '\n') {
-        (void)vitte_lexer_advance_char(lexer);
-    }
+    newline = (const char *)memchr(lexer->source + start_offset, '\n', lexer->length - start_offset);
+    vitte_lexer_advance_to(lexer, newline != NULL ? (size_t)(newline - lexer->source) : lexer->length);
     vitte_lexer_fill_token(lexer, token, VITTE_TOKEN_COMMENT, start_offset, start_line, start_column, NULL);
     return VITTE_STATUS_OK;
 }
@@ -473,17 +542,21 @@ static vitte_status_t vitte_lexer_scan_block_comment(vitte_lexer_t *lexer, vitte
     uint32_t start_line = lexer->cursor.line;
     uint32_t start_column = lexer->cursor.column;
 
-    (void)vitte_lexer_advance_char(lexer);
-    (void)vitte_lexer_advance_char(lexer);
-    while (!vitte_lexer_at_end(lexer)) {
-        if (vitte_lexer_peek_char(lexer) == '*' && vitte_lexer_peek_next_char(lexer) == '/') {
-            (void)vitte_lexer_advance_char(lexer);
-            (void)vitte_lexer_advance_char(lexer);
+    size_t offset = start_offset + 2u;
+
+    while (offset < lexer->length) {
+        const char *star = (const char *)memchr(lexer->source + offset, '*', lexer->length - offset);
+        if (star == NULL) {
+            break;
+        }
+        offset = (size_t)(star - lexer->source) + 1u;
+        if (offset < lexer->length && lexer->source[offset] == '/') {
+            vitte_lexer_advance_to(lexer, offset + 1u);
             vitte_lexer_fill_token(lexer, token, VITTE_TOKEN_COMMENT, start_offset, start_line, start_column, NULL);
             return VITTE_STATUS_OK;
         }
-        (void)vitte_lexer_advance_char(lexer);
     }
+    vitte_lexer_advance_to(lexer, lexer->length);
     vitte_lexer_fill_token(lexer, token, VITTE_TOKEN_ERROR, start_offset, start_line, start_column, "unterminated block comment");
     vitte_lexer_set_error(lexer, VITTE_STATUS_ERROR_PARSE, "VITTE_LEXER_E_COMMENT", "unterminated block comment", lexer->source_name);
     return VITTE_STATUS_ERROR_PARSE;
@@ -495,15 +568,20 @@ static vitte_status_t vitte_lexer_scan_identifier(vitte_lexer_t *lexer, vitte_to
     uint32_t start_column = lexer->cursor.column;
     vitte_token_kind_t kind = VITTE_TOKEN_ERROR;
 
-    (void)vitte_lexer_advance_char(lexer);
-    while (vitte_lexer_is_identifier_continue(vitte_lexer_peek_char(lexer))) {
-        (void)vitte_lexer_advance_char(lexer);
+    size_t offset = start_offset + 1u;
+
+    while (offset < lexer->length && vitte_lexer_is_identifier_continue(lexer->source[offset])) {
+        offset++;
     }
+    vitte_lexer_advance_to(lexer, offset);
     kind = VITTE_TOKEN_IDENTIFIER;
     if (lexer->options.keywords_enabled) {
         kind = vitte_lexer_keyword_kind(lexer->source + start_offset, lexer->cursor.offset - start_offset);
     }
     vitte_lexer_fill_token(lexer, token, kind, start_offset, start_line, start_column, NULL);
+    if (kind == VITTE_TOKEN_IDENTIFIER && lexer->options.interner != NULL) {
+        token->identifier = vitte_interner_intern(lexer->options.interner, token->lexeme_start, token->lexeme_length);
+    }
     return VITTE_STATUS_OK;
 }
 
@@ -514,7 +592,7 @@ static vitte_status_t vitte_lexer_scan_number(vitte_lexer_t *lexer, vitte_token_
     int64_t value = 0;
     bool overflow = false;
 
-    while (isdigit((unsigned char)vitte_lexer_peek_char(lexer)) != 0) {
+    while (vitte_lexer_has_class(vitte_lexer_peek_char(lexer), VITTE_LEXER_CLASS_DIGIT)) {
         int digit = vitte_lexer_advance_char(lexer) - '0';
         if (!overflow) {
             if (value > (INT64_MAX - digit) / 10) {
@@ -524,9 +602,9 @@ static vitte_status_t vitte_lexer_scan_number(vitte_lexer_t *lexer, vitte_token_
             }
         }
     }
-    if (vitte_lexer_peek_char(lexer) == '.' && isdigit((unsigned char)vitte_lexer_peek_next_char(lexer)) != 0) {
+    if (vitte_lexer_peek_char(lexer) == '.' && vitte_lexer_has_class(vitte_lexer_peek_next_char(lexer), VITTE_LEXER_CLASS_DIGIT)) {
         (void)vitte_lexer_advance_char(lexer);
-        while (isdigit((unsigned char)vitte_lexer_peek_char(lexer)) != 0) (void)vitte_lexer_advance_char(lexer);
+        while (vitte_lexer_has_class(vitte_lexer_peek_char(lexer), VITTE_LEXER_CLASS_DIGIT)) (void)vitte_lexer_advance_char(lexer);
     }
     /* Keep oversized unsigned sentinels representable in the bootstrap AST. */
     vitte_lexer_fill_token(lexer, token, VITTE_TOKEN_INTEGER, start_offset, start_line, start_column, NULL);
@@ -575,7 +653,7 @@ static vitte_status_t vitte_lexer_scan_string(vitte_lexer_t *lexer, vitte_token_
                     (void)vitte_lexer_advance_char(lexer);
                     for (digit = 0u; digit < 4u; digit++) {
                         char hex = vitte_lexer_peek_char(lexer);
-                        if (!isxdigit((unsigned char)hex)) {
+                        if (!vitte_lexer_has_class(hex, VITTE_LEXER_CLASS_HEX)) {
                             vitte_lexer_fill_token(lexer, token, VITTE_TOKEN_ERROR, start_offset, start_line, start_column, "invalid unicode string escape");
                             vitte_lexer_set_error(lexer, VITTE_STATUS_ERROR_PARSE, "VITTE_LEXER_E_STRING", "invalid unicode string escape", lexer->source_name);
                             return VITTE_STATUS_ERROR_PARSE;
@@ -734,13 +812,16 @@ static vitte_status_t vitte_lexer_scan_one(vitte_lexer_t *lexer, vitte_token_t *
 
     while (!vitte_lexer_at_end(lexer)) {
         char value = vitte_lexer_peek_char(lexer);
-        if (value == ' ' || value == '\t' || value == '\r' || value == '\n') {
-            vitte_status_t status = vitte_lexer_scan_whitespace(lexer, token);
-            if (status != VITTE_STATUS_OK || lexer->options.emit_whitespace) {
-                vitte_lexer_count_token(lexer, token);
-                return status;
+        if (vitte_lexer_has_class(value, VITTE_LEXER_CLASS_SPACE)) {
+            vitte_status_t status;
+
+            if (!lexer->options.emit_whitespace) {
+                vitte_lexer_skip_whitespace(lexer);
+                continue;
             }
-            continue;
+            status = vitte_lexer_scan_whitespace(lexer, token);
+            vitte_lexer_count_token(lexer, token);
+            return status;
         }
         if (value == '/' && vitte_lexer_peek_next_char(lexer) == '/') {
             vitte_status_t status = vitte_lexer_scan_line_comment(lexer, token);
@@ -763,7 +844,7 @@ static vitte_status_t vitte_lexer_scan_one(vitte_lexer_t *lexer, vitte_token_t *
             vitte_lexer_count_token(lexer, token);
             return status;
         }
-        if (isdigit((unsigned char)value) != 0) {
+        if (vitte_lexer_has_class(value, VITTE_LEXER_CLASS_DIGIT)) {
             vitte_status_t status = vitte_lexer_scan_number(lexer, token);
             vitte_lexer_count_token(lexer, token);
             return status;
@@ -875,3 +956,132 @@ vitte_status_t vitte_lexer_lex_all(
     }
     return status;
 }
+
+bool vitte_token_compact(
+    const vitte_token_t *token,
+    vitte_compact_token_t *compact,
+    vitte_token_payload_t *payload
+) {
+    if (token == NULL || compact == NULL || payload == NULL ||
+        token->start_offset > UINT32_MAX || token->lexeme_length > UINT32_MAX) {
+        return false;
+    }
+    compact->kind = (uint16_t)token->kind;
+    compact->flags = 0u;
+    compact->start_offset = (uint32_t)token->start_offset;
+    compact->length = (uint32_t)token->lexeme_length;
+    if (token->has_escape) {
+        compact->flags |= VITTE_TOKEN_FLAG_HAS_ESCAPE;
+    }
+    if (token->has_integer_value) {
+        compact->flags |= VITTE_TOKEN_FLAG_HAS_INTEGER_VALUE;
+        payload->integer_value = token->integer_value;
+    } else if (token->identifier != NULL) {
+        compact->flags |= VITTE_TOKEN_FLAG_HAS_IDENTIFIER;
+        payload->identifier = token->identifier;
+    }
+    return true;
+}
+
+vitte_status_t vitte_line_table_build(
+    vitte_line_table_t *table,
+    vitte_arena_t *arena,
+    const char *source,
+    size_t length,
+    size_t tab_width
+) {
+    const char *cursor;
+    const char *end;
+    size_t line_count = 1u;
+
+    if (table == NULL || arena == NULL || source == NULL || length > UINT32_MAX) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    memset(table, 0, sizeof(*table));
+    end = source + length;
+    for (cursor = source; cursor < end; cursor++) {
+        cursor = (const char *)memchr(cursor, '\n', (size_t)(end - cursor));
+        if (cursor == NULL) {
+            break;
+        }
+        line_count++;
+    }
+
+    table->line_starts = (uint32_t *)vitte_arena_alloc(arena, line_count * sizeof(*table->line_starts), _Alignof(uint32_t));
+    if (table->line_starts == NULL) {
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    table->line_starts[0] = 0u;
+    table->line_count = 1u;
+    for (cursor = source; cursor < end; cursor++) {
+        cursor = (const char *)memchr(cursor, '\n', (size_t)(end - cursor));
+        if (cursor == NULL) {
+            break;
+        }
+        table->line_starts[table->line_count++] = (uint32_t)(cursor - source + 1);
+    }
+    table->source = source;
+    table->length = length;
+    table->tab_width = tab_width != 0u ? tab_width : VITTE_LEXER_DEFAULT_TAB_WIDTH;
+    return VITTE_STATUS_OK;
+}
+
+/*
+ * Resolves `offset` to the 1-based line and column the tracking lexer would
+ * report. `hint` (optional) carries the last line, offset and column between
+ * calls, so monotonic lookups walk forward from the previous position instead
+ * of bisecting and rescanning the line from its start.
+ */
+void vitte_line_table_position(
+    const vitte_line_table_t *table,
+    size_t offset,
+    vitte_line_hint_t *hint,
+    uint32_t *line,
+    uint32_t *column
+) {
+    size_t index;
+    size_t cursor;
+    uint32_t result_column = 1u;
+
+    if (table == NULL || table->line_starts == NULL) {
+        *line = 1u;
+        *column = 1u;
+        return;
+    }
+    if (offset > table->length) {
+        offset = table->length;
+    }
+    if (hint != NULL && hint->line < table->line_count && table->line_starts[hint->line] <= offset) {
+        index = hint->line;
+        while (index + 1u < table->line_count && table->line_starts[index + 1u] <= offset) {
+            index++;
+        }
+    } else {
+        size_t low = 0u;
+        size_t high = table->line_count;
+        while (high - low > 1u) {
+            size_t middle = low + (high - low) / 2u;
+            if (table->line_starts[middle] <= offset) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        index = low;
+    }
+    cursor = table->line_starts[index];
+    if (hint != NULL && hint->column != 0u && hint->line == index && hint->offset >= cursor && hint->offset <= offset) {
+        cursor = hint->offset;
+        result_column = hint->column;
+    }
+    for (; cursor < offset; cursor++) {
+        result_column += table->source[cursor] == '\t' ? (uint32_t)table->tab_width : 1u;
+    }
+    if (hint != NULL) {
+        hint->line = index;
+        hint->offset = offset;
+        hint->column = result_column;
+    }
+    *line = (uint32_t)(index + 1u);
+    *column = result_column;
+}
@@ -6,6 +6,8 @@
 #include <stdint.h>
 
 #include "../api/error.h"
+#include "../arena/arena.h"
+#include "../intern/intern.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -92,18 +94,62 @@ typedef struct vitte_token {
     uint32_t start_column;
     uint32_t end_line;
     uint32_t end_column;
+    const char *identifier;
     int64_t integer_value;
     bool has_integer_value;
     bool has_escape;
     const char *message;
 } vitte_token_t;
 
+#define VITTE_TOKEN_FLAG_HAS_ESCAPE ((uint16_t)1u)
+#define VITTE_TOKEN_FLAG_HAS_INTEGER_VALUE ((uint16_t)2u)
+#define VITTE_TOKEN_FLAG_HAS_IDENTIFIER ((uint16_t)4u)
+
+/*
+ * Compact token used by token buffers. Positions are byte offsets; lines and
+ * columns are resolved through a vitte_line_table_t when needed. Integer
+ * values and interned identifiers live out of line in a payload array, one
+ * entry per token carrying HAS_INTEGER_VALUE or HAS_IDENTIFIER, in token order.
+ */
+typedef struct vitte_compact_token {
+    uint16_t kind;
+    uint16_t flags;
+    uint32_t start_offset;
+    uint32_t length;
+} vitte_compact_token_t;
+
+typedef union vitte_token_payload {
+    int64_t integer_value;
+    const char *identifier;
+} vitte_token_payload_t;
+
+/* Start offset of every line of one source buffer, built in a single scan. */
+typedef struct vitte_line_table {
+    const char *source;
+    size_t length;
+    size_t tab_width;
+    uint32_t *line_starts;
+    size_t line_count;
+} vitte_line_table_t;
+
+/*
+ * Last position resolved through a line table. Zero-initialised hints are
+ * valid; `column` 0 means no position has been resolved yet.
+ */
+typedef struct vitte_line_hint {
+    size_t line;
+    size_t offset;
+    uint32_t column;
+} vitte_line_hint_t;
+
 typedef struct vitte_lexer_options {
     bool emit_comments;
     bool emit_whitespace;
     bool keywords_enabled;
+    bool track_positions;
     size_t max_source_bytes;
     size_t tab_width;
+    vitte_interner_t *interner;
 } vitte_lexer_options_t;
 
 typedef struct vitte_lexer_result {
@@ -170,6 +216,27 @@ vitte_status_t vitte_lexer_lex_all(
     vitte_lexer_result_t *result
 );
 
+bool vitte_token_compact(
+    const vitte_token_t *token,
+    vitte_compact_token_t *compact,
+    vitte_token_payload_t *payload
+);
+
+vitte_status_t vitte_line_table_build(
+    vitte_line_table_t *table,
+    vitte_arena_t *arena,
+    const char *source,
+    size_t length,
+    size_t tab_width
+);
+void vitte_line_table_position(
+    const vitte_line_table_t *table,
+    size_t offset,
+    vitte_line_hint_t *hint,
+    uint32_t *line,
+    uint32_t *column
+);
+
 #ifdef __cplusplus
 }
 #endif
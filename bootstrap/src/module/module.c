@@ -1,7 +1,10 @@
 #include "module.h"
 
+#include <stdint.h>
 #include <string.h>
 
+#include "../util/util.h"
+
 static void vitte_module_set_error(
     vitte_module_t *module,
     vitte_status_t status,
@@ -35,7 +38,7 @@ static void vitte_module_import_reset(vitte_module_import_t *entry) {
         return;
     }
     if (entry->source_owned && entry->source_buffer != NULL) {
-        vitte_fs_free(entry->source_buffer);
+        vitte_fs_free_source(entry->source_buffer, entry->source_size, entry->source_storage);
     }
     memset(entry, 0, sizeof(*entry));
     vitte_error_init(&entry->last_error);
@@ -46,12 +49,13 @@ static void vitte_module_import_release_source(vitte_module_import_t *entry) {
         return;
     }
     if (entry->source_owned && entry->source_buffer != NULL) {
-        vitte_fs_free(entry->source_buffer);
+        vitte_fs_free_source(entry->source_buffer, entry->source_size, entry->source_storage);
     }
     entry->source_buffer = NULL;
     entry->source_size = 0u;
     entry->source_loaded = false;
     entry->source_owned = false;
+    entry->source_storage = VITTE_FS_SOURCE_NONE;
 }
 
 static void vitte_module_release_source(vitte_module_t *module) {
@@ -59,14 +63,105 @@ static void vitte_module_release_source(vitte_module_t *module) {
         return;
     }
     if (module->source_owned && module->source_buffer != NULL) {
-        vitte_fs_free(module->source_buffer);
+        vitte_fs_free_source(module->source_buffer, module->source_size, module->source_storage);
     }
     module->source_buffer = NULL;
     module->source_size = 0u;
     module->source_owned = false;
+    module->source_storage = VITTE_FS_SOURCE_NONE;
     module->source_name = NULL;
 }
 
+void vitte_module_release_tokens(vitte_module_t *module) {
+    if (module == NULL) {
+        return;
+    }
+    if (vitte_arena_is_initialized(&module->token_arena)) {
+        vitte_arena_destroy(&module->token_arena);
+    }
+    memset(&module->token_arena, 0, sizeof(module->token_arena));
+    module->tokens = NULL;
+    module->token_capacity = 0u;
+    module->payloads = NULL;
+    module->payload_count = 0u;
+    module->payload_capacity = 0u;
+    memset(&module->lines, 0, sizeof(module->lines));
+    module->lex_errors = NULL;
+    module->lex_error_count = 0u;
+    module->lex_error_capacity = 0u;
+}
+
+/*
+ * Token and lex-error arrays live in the module token arena. Growing one
+ * allocates a doubled array and copies into it; the abandoned space is bounded
+ * by the final array size and is released with the arena.
+ */
+static void *vitte_module_grow_array(
+    vitte_module_t *module,
+    void *items,
+    size_t count,
+    size_t *capacity,
+    size_t minimum,
+    size_t item_size
+) {
+    size_t next = *capacity == 0u ? minimum : *capacity * 2u;
+    void *grown;
+
+    if (next < *capacity || next > SIZE_MAX / item_size) {
+        return NULL;
+    }
+    grown = vitte_arena_alloc(&module->token_arena, next * item_size, VITTE_ARENA_DEFAULT_ALIGNMENT);
+    if (grown == NULL) {
+        return NULL;
+    }
+    if (count != 0u) {
+        (void)memcpy(grown, items, count * item_size);
+    }
+    *capacity = next;
+    return grown;
+}
+
+static bool vitte_module_record_lex_error(
+    vitte_module_t *module,
+    size_t token_index,
+    const vitte_error_t *error
+) {
+    vitte_module_lex_error_t *entry;
+
+    if (module->lex_error_count == module->lex_error_capacity) {
+        vitte_module_lex_error_t *grown = (vitte_module_lex_error_t *)vitte_module_grow_array(
+            module,
+            module->lex_errors,
+            module->lex_error_count,
+            &module->lex_error_capacity,
+            8u,
+            sizeof(*module->lex_errors)
+        );
+        if (grown == NULL) {
+            return false;
+        }
+        module->lex_errors = grown;
+    }
+    entry = &module->lex_errors[module->lex_error_count];
+    entry->token_index = token_index;
+    entry->status = error->status;
+    entry->code = error->code;
+    entry->message = error->message;
+    entry->details = NULL;
+    if (error->details != NULL) {
+        size_t length = strlen(error->details);
+        char *details = (char *)vitte_arena_alloc(&module->token_arena, length + 1u, 1u);
+
+        if (details == NULL) {
+            return false;
+        }
+        (void)memcpy(details, error->details, length + 1u);
+        entry->details = details;
+    }
+    module->lex_error_count++;
+    return true;
+}
+
 static void vitte_module_update_stats(vitte_module_t *module) {
     if (module == NULL) {
         return;
@@ -86,6 +181,7 @@ void vitte_module_options_init(vitte_module_options_t *options) {
     options->max_source_bytes = VITTE_IMPORT_MAX_SOURCE_BYTES;
     options->max_imports = VITTE_MODULE_MAX_IMPORTS;
     vitte_lexer_options_init(&options->lexer_options);
+    vitte_allocator_default(&options->allocator);
 }
 
 void vitte_module_result_init(vitte_module_result_t *result) {
@@ -168,6 +264,7 @@ void vitte_module_destroy(vitte_module_t *module) {
         return;
     }
     vitte_module_release_source(module);
+    vitte_module_release_tokens(module);
     for (index = 0u; index < VITTE_MODULE_MAX_IMPORTS; index++) {
         vitte_module_import_reset(&module->imports[index]);
     }
@@ -242,9 +339,12 @@ vitte_status_t vitte_module_attach_source(
     }
 
     vitte_module_release_source(module);
+    vitte_module_release_tokens(module);
+    module->token_count = 0u;
     module->source_buffer = source;
     module->source_size = source_size;
     module->source_owned = take_ownership;
+    module->source_storage = take_ownership ? VITTE_FS_SOURCE_HEAP : VITTE_FS_SOURCE_NONE;
     module->source_name = source_name != NULL ? source_name : module->source_path;
     module->state = VITTE_MODULE_STATE_LOADED;
     module->stats.load_count++;
@@ -260,6 +360,7 @@ vitte_status_t vitte_module_attach_source(
 vitte_status_t vitte_module_load_source(vitte_module_t *module) {
     vitte_fs_options_t options;
     vitte_error_t fs_error;
+    vitte_fs_source_storage_t storage = VITTE_FS_SOURCE_NONE;
     char *buffer = NULL;
     size_t bytes_read = 0u;
     vitte_status_t status;
@@ -273,14 +374,20 @@ vitte_status_t vitte_module_load_source(vitte_module_t *module) {
     options.max_file_bytes = module->options.max_source_bytes;
     options.null_terminate_reads = true;
     vitte_error_init(&fs_error);
-    status = vitte_fs_read_all_alloc(module->source_path, &buffer, &bytes_read, &options, &fs_error);
+    status = vitte_fs_read_source(module->source_path, &buffer, &bytes_read, &storage, &options, &fs_error);
     if (status != VITTE_STATUS_OK) {
         vitte_error_copy(&module->last_error, &fs_error);
         module->state = VITTE_MODULE_STATE_FAILED;
         module->stats.error_count++;
         return status;
     }
-    return vitte_module_attach_source(module, module->source_path, buffer, bytes_read, true);
+    status = vitte_module_attach_source(module, module->source_path, buffer, bytes_read, true);
+    if (module->source_buffer == buffer) {
+        module->source_storage = storage;
+    } else {
+        vitte_fs_free_source(buffer, bytes_read, storage);
+    }
+    return status;
 }
 
 vitte_status_t vitte_module_resolve(
@@ -323,64 +430,227 @@ vitte_status_t vitte_module_resolve(
     return VITTE_STATUS_OK;
 }
 
+static vitte_status_t vitte_module_lex_fail(
+    vitte_module_t *module,
+    vitte_status_t status,
+    const char *message
+) {
+    vitte_module_release_tokens(module);
+    module->token_count = 0u;
+    vitte_module_set_error(module, status, "VITTE_MODULE_E_LEX", message, module->source_name);
+    return status;
+}
+
+static bool vitte_module_push_token(vitte_module_t *module, const vitte_token_t *token) {
+    vitte_token_payload_t payload;
+    vitte_compact_token_t *compact;
+
+    if (module->token_count == module->token_capacity) {
+        vitte_compact_token_t *grown = (vitte_compact_token_t *)vitte_module_grow_array(
+            module,
+            module->tokens,
+            module->token_count,
+            &module->token_capacity,
+            module->source_size / 4u + VITTE_MODULE_MIN_TOKEN_CAPACITY,
+            sizeof(*module->tokens)
+        );
+        if (grown == NULL) {
+            return false;
+        }
+        module->tokens = grown;
+    }
+    compact = &module->tokens[module->token_count];
+    if (!vitte_token_compact(token, compact, &payload)) {
+        return false;
+    }
+    if ((compact->flags & (VITTE_TOKEN_FLAG_HAS_INTEGER_VALUE | VITTE_TOKEN_FLAG_HAS_IDENTIFIER)) != 0u) {
+        if (module->payload_count == module->payload_capacity) {
+            vitte_token_payload_t *grown = (vitte_token_payload_t *)vitte_module_grow_array(
+                module,
+                module->payloads,
+                module->payload_count,
+                &module->payload_capacity,
+                module->source_size / 16u + VITTE_MODULE_MIN_TOKEN_CAPACITY,
+                sizeof(*module->payloads)
+            );
+            if (grown == NULL) {
+                return false;
+            }
+            module->payloads = grown;
+        }
+        module->payloads[module->payload_count++] = payload;
+    }
+    module->token_count++;
+    return true;
+}
+
 vitte_status_t vitte_module_lex(vitte_module_t *module) {
     vitte_lexer_t lexer;
+    vitte_lexer_options_t lexer_options;
+    vitte_arena_config_t arena_config;
     vitte_token_t token;
     vitte_status_t status;
-    size_t token_count = 0u;
+    vitte_status_t first_error = VITTE_STATUS_OK;
     size_t error_count = 0u;
 
     if (!vitte_module_is_initialized(module) || module->source_buffer == NULL) {
         vitte_module_set_error(module, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_MODULE_E_LEX", "module source is not loaded", NULL);
         return VITTE_STATUS_ERROR_INVALID_STATE;
     }
+    if (module->source_size > UINT32_MAX) {
+        vitte_module_set_error(module, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_MODULE_E_LEX", "module source exceeds token offset range", module->source_name);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
 
-    status = vitte_lexer_init(&lexer, module->source_name, module->source_buffer, module->source_size, &module->options.lexer_options);
+    /* Positions are recovered from the line table, so the lexer only tracks
+     * byte offsets during this pass. */
+    lexer_options = module->options.lexer_options;
+    lexer_options.track_positions = false;
+    status = vitte_lexer_init(&lexer, module->source_name, module->source_buffer, module->source_size, &lexer_options);
     if (status != VITTE_STATUS_OK) {
         vitte_module_set_error(module, status, "VITTE_MODULE_E_LEX", "failed to initialize module lexer", module->source_name);
         return status;
     }
 
+    vitte_module_release_tokens(module);
+    module->token_count = 0u;
+    vitte_arena_config_init(&arena_config);
+    arena_config.initial_block_size = VITTE_MODULE_TOKEN_BLOCK_SIZE;
+    if (vitte_allocator_is_valid(&module->options.allocator)) {
+        arena_config.allocator = module->options.allocator;
+    }
+    status = vitte_arena_init(&module->token_arena, &arena_config);
+    if (status != VITTE_STATUS_OK) {
+        vitte_module_set_error(module, status, "VITTE_MODULE_E_LEX", "cannot allocate module token arena", module->source_name);
+        return status;
+    }
+    status = vitte_line_table_build(&module->lines, &module->token_arena, lexer.source, lexer.length, lexer.options.tab_width);
+    if (status != VITTE_STATUS_OK) {
+        return vitte_module_lex_fail(module, status, "cannot build module line table");
+    }
+
+    /*
+     * Keep every token so the parser can consume the buffer instead of lexing
+     * again. Lexer errors are recorded next to their token and lexing resumes
+     * after them, matching what a streaming parser would observe.
+     */
     for (;;) {
         status = vitte_lexer_next(&lexer, &token);
-        token_count++;
-        module->last_token = token;
+        if (!vitte_module_push_token(module, &token)) {
+            return vitte_module_lex_fail(module, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "cannot grow module token buffer");
+        }
         if (token.kind == VITTE_TOKEN_ERROR) {
             error_count++;
+            if (first_error == VITTE_STATUS_OK) {
+                first_error = status != VITTE_STATUS_OK ? status : VITTE_STATUS_ERROR_PARSE;
+                vitte_error_copy(&module->last_error, vitte_lexer_last_error(&lexer));
+            }
+            if (!vitte_module_record_lex_error(module, module->token_count - 1u, vitte_lexer_last_error(&lexer))) {
+                return vitte_module_lex_fail(module, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "cannot record module lexer error");
+            }
+            continue;
+        }
+        if (status != VITTE_STATUS_OK) {
+            vitte_error_copy(&module->last_error, vitte_lexer_last_error(&lexer));
+            vitte_module_release_tokens(module);
+            module->token_count = 0u;
+            module->state = VITTE_MODULE_STATE_FAILED;
+            module->stats.error_count++;
+            return status;
         }
-        if (status != VITTE_STATUS_OK || token.kind == VITTE_TOKEN_EOF || token.kind == VITTE_TOKEN_ERROR) {
+        if (token.kind == VITTE_TOKEN_EOF) {
             break;
         }
     }
 
-    module->token_count = token_count;
+    module->last_token = token;
+    vitte_line_table_position(&module->lines, token.start_offset, NULL, &module->last_token.start_line, &module->last_token.start_column);
+    vitte_line_table_position(&module->lines, token.end_offset, NULL, &module->last_token.end_line, &module->last_token.end_column);
     module->stats.lex_count++;
     module->stats.error_count += error_count;
     vitte_module_update_stats(module);
-    if (status != VITTE_STATUS_OK) {
-        vitte_error_copy(&module->last_error, vitte_lexer_last_error(&lexer));
+    if (first_error != VITTE_STATUS_OK) {
         module->state = VITTE_MODULE_STATE_FAILED;
-        return status;
+        return first_error;
     }
     module->state = VITTE_MODULE_STATE_LEXED;
     vitte_error_reset(&module->last_error);
     return VITTE_STATUS_OK;
 }
 
+bool vitte_module_has_tokens(const vitte_module_t *module) {
+    return module != NULL && module->tokens != NULL && module->token_count != 0u &&
+        module->tokens[module->token_count - 1u].kind == VITTE_TOKEN_EOF;
+}
+
+const vitte_module_lex_error_t *vitte_module_find_lex_error(const vitte_module_t *module, size_t token_index) {
+    size_t low = 0u;
+    size_t high;
+
+    if (module == NULL || module->lex_errors == NULL) {
+        return NULL;
+    }
+    high = module->lex_error_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2u;
+        if (module->lex_errors[middle].token_index < token_index) {
+            low = middle + 1u;
+        } else {
+            high = middle;
+        }
+    }
+    return low < module->lex_error_count && module->lex_errors[low].token_index == token_index ?
+        &module->lex_errors[low] : NULL;
+}
+
+static size_t vitte_module_import_hash(const char *module_name) {
+    return (size_t)vitte_util_hash_text(VITTE_UTIL_HASH_SEED, module_name);
+}
+
+/*
+ * Import slots hold entry index + 1 keyed by module name; zero ends a probe
+ * chain. Entries sharing a name sit along the chain in insertion order.
+ */
+static size_t vitte_module_import_next(const vitte_module_t *module, size_t position, const char *module_name) {
+    size_t mask = VITTE_MODULE_MAX_IMPORTS * 2u - 1u;
+
+    while (module->import_slots[position] != 0u &&
+           strcmp(module->imports[module->import_slots[position] - 1u].module_name, module_name) != 0) {
+        position = (position + 1u) & mask;
+    }
+    return position;
+}
+
+const vitte_module_import_t *vitte_module_find_import(const vitte_module_t *module, const char *module_name) {
+    size_t position;
+
+    if (!vitte_module_is_initialized(module) || module_name == NULL) {
+        return NULL;
+    }
+    position = vitte_module_import_next(
+        module,
+        vitte_module_import_hash(module_name) & (VITTE_MODULE_MAX_IMPORTS * 2u - 1u),
+        module_name
+    );
+    return module->import_slots[position] != 0u ? &module->imports[module->import_slots[position] - 1u] : NULL;
+}
+
 vitte_status_t vitte_module_add_import(vitte_module_t *module, const char *module_name, bool relative) {
-    size_t index;
+    size_t mask = VITTE_MODULE_MAX_IMPORTS * 2u - 1u;
+    size_t position;
     vitte_module_import_t *entry;
 
     if (!vitte_module_is_initialized(module) || !vitte_import_validate_module_name(module_name)) {
         vitte_module_set_error(module, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_MODULE_E_IMPORT", "invalid module import name", module_name);
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
-    for (index = 0u; index < module->import_count; index++) {
-        if (strcmp(module->imports[index].module_name, module_name) == 0 &&
-            module->imports[index].relative == relative) {
+    position = vitte_module_import_next(module, vitte_module_import_hash(module_name) & mask, module_name);
+    while (module->import_slots[position] != 0u) {
+        if (module->imports[module->import_slots[position] - 1u].relative == relative) {
             vitte_error_reset(&module->last_error);
             return VITTE_STATUS_OK;
         }
+        position = vitte_module_import_next(module, (position + 1u) & mask, module_name);
     }
     if (module->import_count >= module->options.max_imports) {
         vitte_module_set_error(module, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_MODULE_E_IMPORT", "module import capacity exceeded", module_name);
@@ -394,6 +664,7 @@ vitte_status_t vitte_module_add_import(vitte_module_t *module, const char *modul
     }
     entry->relative = relative;
     module->import_count++;
+    module->import_slots[position] = (uint16_t)module->import_count;
     vitte_module_update_stats(module);
     vitte_error_reset(&module->last_error);
     return VITTE_STATUS_OK;
@@ -445,6 +716,7 @@ vitte_status_t vitte_module_resolve_imports(vitte_module_t *module, vitte_import
         if (module->options.read_source) {
             vitte_fs_options_t fs_options;
             vitte_error_t fs_error;
+            vitte_fs_source_storage_t storage = VITTE_FS_SOURCE_NONE;
             char *buffer = NULL;
             size_t bytes_read = 0u;
 
@@ -452,7 +724,7 @@ vitte_status_t vitte_module_resolve_imports(vitte_module_t *module, vitte_import
             fs_options.max_file_bytes = module->options.max_source_bytes;
             fs_options.null_terminate_reads = true;
             vitte_error_init(&fs_error);
-            status = vitte_fs_read_all_alloc(entry->resolved_path, &buffer, &bytes_read, &fs_options, &fs_error);
+            status = vitte_fs_read_source(entry->resolved_path, &buffer, &bytes_read, &storage, &fs_options, &fs_error);
             if (status != VITTE_STATUS_OK) {
                 vitte_error_copy(&entry->last_error, &fs_error);
                 vitte_error_copy(&module->last_error, &fs_error);
@@ -465,6 +737,7 @@ vitte_status_t vitte_module_resolve_imports(vitte_module_t *module, vitte_import
             entry->source_size = bytes_read;
             entry->source_loaded = true;
             entry->source_owned = true;
+            entry->source_storage = storage;
         }
 
         module->resolved_import_count++;
@@ -3,8 +3,10 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "../api/error.h"
+#include "../arena/arena.h"
 #include "../import/import.h"
 #include "../lexer/lexer.h"
 
@@ -13,6 +15,8 @@ extern "C" {
 #endif
 
 #define VITTE_MODULE_MAX_IMPORTS ((size_t)256u)
+#define VITTE_MODULE_TOKEN_BLOCK_SIZE ((size_t)64u * 1024u)
+#define VITTE_MODULE_MIN_TOKEN_CAPACITY ((size_t)64u)
 
 typedef struct vitte_ast vitte_ast_t;
 typedef struct vitte_hir vitte_hir_t;
@@ -38,6 +42,8 @@ typedef struct vitte_module_options {
     size_t max_source_bytes;
     size_t max_imports;
     vitte_lexer_options_t lexer_options;
+    /* Backs the token arena; the default allocator when left invalid. */
+    vitte_allocator_t allocator;
 } vitte_module_options_t;
 
 typedef struct vitte_module_import {
@@ -49,9 +55,22 @@ typedef struct vitte_module_import {
     bool resolved;
     bool source_loaded;
     bool source_owned;
+    vitte_fs_source_storage_t source_storage;
     vitte_error_t last_error;
 } vitte_module_import_t;
 
+/*
+ * Lexer error attached to the token at `token_index` of the module buffer.
+ * `details` is copied into the token arena; the lexer reuses its storage.
+ */
+typedef struct vitte_module_lex_error {
+    size_t token_index;
+    vitte_status_t status;
+    const char *code;
+    const char *message;
+    const char *details;
+} vitte_module_lex_error_t;
+
 typedef struct vitte_module_stats {
     size_t import_count;
     size_t resolved_import_count;
@@ -81,9 +100,21 @@ typedef struct vitte_module {
     char *source_buffer;
     size_t source_size;
     bool source_owned;
+    vitte_fs_source_storage_t source_storage;
     size_t token_count;
     vitte_token_t last_token;
+    vitte_arena_t token_arena;
+    vitte_compact_token_t *tokens;
+    size_t token_capacity;
+    vitte_token_payload_t *payloads;
+    size_t payload_count;
+    size_t payload_capacity;
+    vitte_line_table_t lines;
+    vitte_module_lex_error_t *lex_errors;
+    size_t lex_error_count;
+    size_t lex_error_capacity;
     vitte_module_import_t imports[VITTE_MODULE_MAX_IMPORTS];
+    uint16_t import_slots[VITTE_MODULE_MAX_IMPORTS * 2u];
     size_t import_count;
     size_t resolved_import_count;
     vitte_ast_t *ast;
@@ -121,7 +152,12 @@ vitte_status_t vitte_module_resolve(
 );
 vitte_status_t vitte_module_load_source(vitte_module_t *module);
 vitte_status_t vitte_module_lex(vitte_module_t *module);
+bool vitte_module_has_tokens(const vitte_module_t *module);
+/* Frees the token buffer and line table once parsing is done with them. */
+void vitte_module_release_tokens(vitte_module_t *module);
+const vitte_module_lex_error_t *vitte_module_find_lex_error(const vitte_module_t *module, size_t token_index);
 vitte_status_t vitte_module_add_import(vitte_module_t *module, const char *module_name, bool relative);
+const vitte_module_import_t *vitte_module_find_import(const vitte_module_t *module, const char *module_name);
 vitte_status_t vitte_module_resolve_imports(vitte_module_t *module, vitte_import_resolver_t *resolver);
 
 #ifdef __cplusplus
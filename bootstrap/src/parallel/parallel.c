@@ -0,0 +1,203 @@
+#include "parallel.h"
+
+#include <stdlib.h>
+
+#ifdef VITTE_PARALLEL_HAVE_PTHREADS
+#include <unistd.h>
+#endif
+
+typedef struct vitte_parallel_state {
+    vitte_parallel_task_fn task;
+    void *user;
+    size_t count;
+    size_t next;
+    size_t failed;
+#ifdef VITTE_PARALLEL_HAVE_PTHREADS
+    pthread_mutex_t lock;
+#endif
+} vitte_parallel_state_t;
+
+vitte_status_t vitte_parallel_mutex_init(vitte_parallel_mutex_t *mutex) {
+    if (mutex == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    if (mutex->initialized) {
+        return VITTE_STATUS_OK;
+    }
+#ifdef VITTE_PARALLEL_HAVE_PTHREADS
+    if (pthread_mutex_init(&mutex->handle, NULL) != 0) {
+        return VITTE_STATUS_ERROR_INTERNAL;
+    }
+#endif
+    mutex->initialized = true;
+    return VITTE_STATUS_OK;
+}
+
+void vitte_parallel_mutex_destroy(vitte_parallel_mutex_t *mutex) {
+    if (mutex == NULL || !mutex->initialized) {
+        return;
+    }
+#ifdef VITTE_PARALLEL_HAVE_PTHREADS
+    (void)pthread_mutex_destroy(&mutex->handle);
+#endif
+    mutex->initialized = false;
+}
+
+void vitte_parallel_mutex_lock(vitte_parallel_mutex_t *mutex) {
+#ifdef VITTE_PARALLEL_HAVE_PTHREADS
+    if (mutex != NULL && mutex->initialized) {
+        (void)pthread_mutex_lock(&mutex->handle);
+    }
+#else
+    (void)mutex;
+#endif
+}
+
+void vitte_parallel_mutex_unlock(vitte_parallel_mutex_t *mutex) {
+#ifdef VITTE_PARALLEL_HAVE_PTHREADS
+    if (mutex != NULL && mutex->initialized) {
+        (void)pthread_mutex_unlock(&mutex->handle);
+    }
+#else
+    (void)mutex;
+#endif
+}
+
+size_t vitte_parallel_hardware_jobs(void) {
+#ifdef VITTE_PARALLEL_HAVE_PTHREADS
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (online > 0) {
+        return (size_t)online < VITTE_PARALLEL_MAX_JOBS ? (size_t)online : VITTE_PARALLEL_MAX_JOBS;
+    }
+#endif
+    return 1u;
+}
+
+bool vitte_parallel_parse_jobs(const char *text, size_t *jobs) {
+    char *end = NULL;
+    unsigned long value;
+
+    if (text == NULL || jobs == NULL || text[0] < '0' || text[0] > '9') {
+        return false;
+    }
+    value = strtoul(text, &end, 10);
+    if (end == text || *end != '\0') {
+        return false;
+    }
+    if (value == 0ul) {
+        *jobs = vitte_parallel_hardware_jobs();
+    } else {
+        *jobs = value < (unsigned long)VITTE_PARALLEL_MAX_JOBS ? (size_t)value : VITTE_PARALLEL_MAX_JOBS;
+    }
+    return true;
+}
+
+#ifdef VITTE_PARALLEL_HAVE_PTHREADS
+typedef struct vitte_parallel_worker {
+    vitte_parallel_state_t *state;
+    size_t worker;
+} vitte_parallel_worker_t;
+
+/* Indices are handed out in increasing order, so every index below the first
+ * failure has been started by the time the loop drains. */
+static bool vitte_parallel_claim(vitte_parallel_state_t *state, size_t *index) {
+    bool claimed = false;
+
+    (void)pthread_mutex_lock(&state->lock);
+    if (state->next < state->count && state->next < state->failed) {
+        *index = state->next++;
+        claimed = true;
+    }
+    (void)pthread_mutex_unlock(&state->lock);
+    return claimed;
+}
+
+static void vitte_parallel_drain(vitte_parallel_state_t *state, size_t worker) {
+    size_t index;
+
+    while (vitte_parallel_claim(state, &index)) {
+        if (!state->task(index, worker, state->user)) {
+            (void)pthread_mutex_lock(&state->lock);
+            if (index < state->failed) {
+                state->failed = index;
+            }
+            (void)pthread_mutex_unlock(&state->lock);
+        }
+    }
+}
+
+static void *vitte_parallel_thread(void *argument) {
+    vitte_parallel_worker_t *worker = (vitte_parallel_worker_t *)argument;
+
+    vitte_parallel_drain(worker->state, worker->worker);
+    return NULL;
+}
+#endif
+
+vitte_status_t vitte_parallel_for(
+    size_t count,
+    size_t jobs,
+    vitte_parallel_task_fn task,
+    void *user,
+    size_t *failed_index
+) {
+    vitte_parallel_state_t state;
+    size_t index;
+
+    if (task == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    state.task = task;
+    state.user = user;
+    state.count = count;
+    state.next = 0u;
+    state.failed = count;
+    if (jobs > count) {
+        jobs = count;
+    }
+
+#ifdef VITTE_PARALLEL_HAVE_PTHREADS
+    if (jobs > 1u) {
+        pthread_t *threads = (pthread_t *)malloc((jobs - 1u) * sizeof(*threads));
+        vitte_parallel_worker_t *workers = (vitte_parallel_worker_t *)malloc((jobs - 1u) * sizeof(*workers));
+        size_t started = 0u;
+
+        if (threads != NULL && workers != NULL && pthread_mutex_init(&state.lock, NULL) == 0) {
+            /* A thread that cannot be created just leaves more work for the others. */
+            for (index = 0u; index + 1u < jobs; index++) {
+                workers[started].state = &state;
+                workers[started].worker = started + 1u;
+                if (pthread_create(&threads[started], NULL, vitte_parallel_thread, &workers[started]) != 0) {
+                    break;
+                }
+                started++;
+            }
+            vitte_parallel_drain(&state, 0u);
+            for (index = 0u; index < started; index++) {
+                (void)pthread_join(threads[index], NULL);
+            }
+            (void)pthread_mutex_destroy(&state.lock);
+            free(workers);
+            free(threads);
+            if (failed_index != NULL) {
+                *failed_index = state.failed;
+            }
+            return VITTE_STATUS_OK;
+        }
+        free(workers);
+        free(threads);
+    }
+#endif
+
+    for (index = 0u; index < count; index++) {
+        if (!task(index, 0u, user)) {
+            state.failed = index;
+            break;
+        }
+    }
+    if (failed_index != NULL) {
+        *failed_index = state.failed;
+    }
+    return VITTE_STATUS_OK;
+}
@@ -0,0 +1,63 @@
+#ifndef VITTE_BOOTSTRAP_PARALLEL_H
+#define VITTE_BOOTSTRAP_PARALLEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "../api/error.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define VITTE_PARALLEL_HAVE_PTHREADS 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VITTE_PARALLEL_MAX_JOBS ((size_t)256u)
+
+/*
+ * Runs one task. `worker` is in [0, jobs) and identifies the calling thread,
+ * so callers can keep per-worker scratch state. Returning false stops the
+ * loop: no index above the failed one is started afterwards.
+ */
+typedef bool (*vitte_parallel_task_fn)(size_t index, size_t worker, void *user);
+
+/* Lock and unlock are no-ops on a mutex that was never initialized, so owners
+ * can embed one and only pay for it once sharing begins. */
+typedef struct vitte_parallel_mutex {
+    bool initialized;
+#ifdef VITTE_PARALLEL_HAVE_PTHREADS
+    pthread_mutex_t handle;
+#endif
+} vitte_parallel_mutex_t;
+
+/* Static initializer for a file-scope mutex that is live from the start and never destroyed. */
+#ifdef VITTE_PARALLEL_HAVE_PTHREADS
+#define VITTE_PARALLEL_MUTEX_INITIALIZER { true, PTHREAD_MUTEX_INITIALIZER }
+#else
+#define VITTE_PARALLEL_MUTEX_INITIALIZER { false }
+#endif
+
+vitte_status_t vitte_parallel_mutex_init(vitte_parallel_mutex_t *mutex);
+void vitte_parallel_mutex_destroy(vitte_parallel_mutex_t *mutex);
+void vitte_parallel_mutex_lock(vitte_parallel_mutex_t *mutex);
+void vitte_parallel_mutex_unlock(vitte_parallel_mutex_t *mutex);
+
+size_t vitte_parallel_hardware_jobs(void);
+bool vitte_parallel_parse_jobs(const char *text, size_t *jobs);
+
+vitte_status_t vitte_parallel_for(
+    size_t count,
+    size_t jobs,
+    vitte_parallel_task_fn task,
+    void *user,
+    size_t *failed_index
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VITTE_BOOTSTRAP_PARALLEL_H */
@@ -184,10 +184,13 @@ static char *vitte_parser_copy_text(vitte_parser_t *parser, const char *text, si
     return copy;
 }
 
-static char *vitte_parser_copy_token_text(vitte_parser_t *parser, const vitte_token_t *token) {
+static const char *vitte_parser_copy_token_text(vitte_parser_t *parser, const vitte_token_t *token) {
     if (token == NULL || token->lexeme_start == NULL) {
         return NULL;
     }
+    if (token->identifier != NULL) {
+        return token->identifier;
+    }
     return vitte_parser_copy_text(parser, token->lexeme_start, token->lexeme_length);
 }
 
@@ -303,26 +306,105 @@ static const char *vitte_parser_operator_text(vitte_token_kind_t kind) {
     }
 }
 
+/*
+ * Pulls the next significant token from the module token buffer and expands it
+ * into `current`. The parser only moves forward, so payloads are consumed in
+ * order and line lookups walk the module line table from the previous hint.
+ */
+static vitte_status_t vitte_parser_next_buffered(
+    vitte_parser_t *parser,
+    vitte_error_t *lex_error
+) {
+    const vitte_module_t *module = parser->module;
+    const vitte_compact_token_t *compact;
+    const vitte_token_payload_t *payload;
+    const vitte_module_lex_error_t *entry;
+    vitte_token_t *token = &parser->current;
+    size_t index;
+
+    for (;;) {
+        index = parser->token_index;
+        compact = &parser->tokens[index];
+        payload = NULL;
+        if ((compact->flags & (VITTE_TOKEN_FLAG_HAS_INTEGER_VALUE | VITTE_TOKEN_FLAG_HAS_IDENTIFIER)) != 0u) {
+            payload = &module->payloads[parser->payload_index];
+        }
+        /* The buffer ends with EOF, which has no payload and is returned again
+         * once reached. */
+        if (index + 1u < parser->token_count) {
+            parser->token_index++;
+            parser->payload_index += payload != NULL ? 1u : 0u;
+        }
+        if (compact->kind != VITTE_TOKEN_WHITESPACE && compact->kind != VITTE_TOKEN_COMMENT) {
+            break;
+        }
+    }
+
+    vitte_token_init(token);
+    token->kind = (vitte_token_kind_t)compact->kind;
+    token->source_name = parser->lexer.source_name;
+    token->lexeme_start = module->source_buffer + compact->start_offset;
+    token->lexeme_length = compact->length;
+    token->start_offset = compact->start_offset;
+    token->end_offset = (size_t)compact->start_offset + compact->length;
+    vitte_line_table_position(&module->lines, token->start_offset, &parser->line_hint, &token->start_line, &token->start_column);
+    vitte_line_table_position(&module->lines, token->end_offset, &parser->line_hint, &token->end_line, &token->end_column);
+    token->has_escape = (compact->flags & VITTE_TOKEN_FLAG_HAS_ESCAPE) != 0u;
+    if ((compact->flags & VITTE_TOKEN_FLAG_HAS_INTEGER_VALUE) != 0u) {
+        token->integer_value = payload->integer_value;
+        token->has_integer_value = true;
+    } else if ((compact->flags & VITTE_TOKEN_FLAG_HAS_IDENTIFIER) != 0u) {
+        token->identifier = payload->identifier;
+    }
+    if (token->kind != VITTE_TOKEN_ERROR) {
+        return VITTE_STATUS_OK;
+    }
+    entry = vitte_module_find_lex_error(module, index);
+    if (entry == NULL) {
+        vitte_error_set_details(lex_error, VITTE_STATUS_ERROR_PARSE, "VITTE_PARSER_E_LEX", "lexer failed during parsing", NULL);
+        return VITTE_STATUS_ERROR_PARSE;
+    }
+    token->message = entry->message;
+    vitte_error_set_details(lex_error, entry->status, entry->code, entry->message, entry->details);
+    return entry->status;
+}
+
 static vitte_status_t vitte_parser_advance(vitte_parser_t *parser) {
+    vitte_error_t buffered_error;
+    const vitte_error_t *lexer_error;
     vitte_status_t status;
 
     if (parser == NULL || !parser->initialized) {
         return VITTE_STATUS_ERROR_INVALID_STATE;
     }
     parser->previous = parser->current;
-    status = vitte_lexer_next(&parser->lexer, &parser->current);
+    if (parser->tokens != NULL) {
+        vitte_error_init(&buffered_error);
+        status = vitte_parser_next_buffered(parser, &buffered_error);
+        lexer_error = &buffered_error;
+    } else {
+        status = vitte_lexer_next(&parser->lexer, &parser->current);
+        lexer_error = vitte_lexer_last_error(&parser->lexer);
+    }
     parser->stats.token_count++;
     if (status != VITTE_STATUS_OK) {
         vitte_ast_span_t span = vitte_parser_span_from_token(&parser->current);
-        const vitte_error_t *lexer_error = vitte_lexer_last_error(&parser->lexer);
-        return vitte_parser_fail(
+        const char *code = lexer_error != NULL && lexer_error->code != NULL ? lexer_error->code : "VITTE_PARSER_E_LEX";
+        const char *message = lexer_error != NULL && lexer_error->message != NULL ? lexer_error->message : "lexer failed during parsing";
+        const char *details = lexer_error != NULL ? lexer_error->details : parser->current.message;
+
+        /* Lexer details name the source file; the diagnostic span already shows it. */
+        parser->stats.error_count++;
+        vitte_parser_set_error(parser, status, code, message, details);
+        (void)vitte_parser_add_diagnostic(
             parser,
-            status,
-            lexer_error != NULL && lexer_error->code != NULL ? lexer_error->code : "VITTE_PARSER_E_LEX",
-            lexer_error != NULL && lexer_error->message != NULL ? lexer_error->message : "lexer failed during parsing",
-            lexer_error != NULL ? lexer_error->details : parser->current.message,
+            VITTE_DIAGNOSTIC_ERROR,
+            code,
+            message,
+            details != NULL && span.source_name != NULL && strcmp(details, span.source_name) == 0 ? NULL : details,
             &span
         );
+        return status;
     }
     return VITTE_STATUS_OK;
 }
@@ -438,7 +520,7 @@ static char *vitte_parser_join_with_dot_token(
     const char *left,
     const vitte_token_t *right
 ) {
-    char *segment;
+    const char *segment;
 
     if (parser == NULL || right == NULL) {
         return NULL;
@@ -536,7 +618,7 @@ static char *vitte_parser_parse_path_text(
     return vitte_parser_copy_text(parser, start, length);
 }
 
-static char *vitte_parser_parse_module_path_normalized(
+static const char *vitte_parser_parse_module_path_normalized(
     vitte_parser_t *parser,
     bool allow_slash,
     const char *code,
@@ -544,7 +626,7 @@ static char *vitte_parser_parse_module_path_normalized(
     vitte_ast_span_t *span_out
 ) {
     vitte_ast_span_t span;
-    char *path;
+    const char *path;
 
     if (parser == NULL || !vitte_parser_token_is_path_segment(parser->current.kind)) {
         (void)vitte_parser_fail_current(parser, code, message);
@@ -848,7 +930,7 @@ static vitte_ast_expr_t *vitte_parser_parse_primary(vitte_parser_t *parser) {
             if (record == NULL) return NULL;
             while (parser->current.kind != VITTE_TOKEN_RBRACE && parser->current.kind != VITTE_TOKEN_EOF) {
                 vitte_ast_span_t field_span = vitte_parser_span_from_token(&parser->current);
-                char *field_name;
+                const char *field_name;
                 vitte_ast_expr_t *value;
                 vitte_ast_node_t *field;
                 if (vitte_parser_match(parser, VITTE_TOKEN_COMMA)) continue;
@@ -913,7 +995,7 @@ static vitte_ast_expr_t *vitte_parser_parse_primary(vitte_parser_t *parser) {
                 if (expr == NULL) return NULL;
                 while (parser->current.kind != VITTE_TOKEN_RBRACE && parser->current.kind != VITTE_TOKEN_EOF) {
                     vitte_ast_span_t field_span = vitte_parser_span_from_token(&parser->current);
-                    char *field_name;
+                    const char *field_name;
                     vitte_ast_expr_t *value;
                     vitte_ast_node_t *field;
                     if (vitte_parser_match(parser, VITTE_TOKEN_COMMA)) continue;
@@ -1031,7 +1113,7 @@ static vitte_ast_expr_t *vitte_parser_parse_call(vitte_parser_t *parser) {
     while (parser->current.kind == VITTE_TOKEN_DOT) {
         vitte_ast_span_t span = callee->span;
         vitte_ast_span_t member_span;
-        char *member;
+        const char *member;
         (void)vitte_parser_advance(parser);
         if (parser->current.kind != VITTE_TOKEN_IDENTIFIER) {
             (void)vitte_parser_fail_current(parser, "VITTE_PARSER_E_MEMBER", "expected member name after '.'");
@@ -1070,7 +1152,7 @@ static vitte_ast_expr_t *vitte_parser_parse_call(vitte_parser_t *parser) {
     while (parser->current.kind == VITTE_TOKEN_DOT) {
         vitte_ast_span_t span = callee->span;
         vitte_ast_span_t member_span;
-        char *member;
+        const char *member;
         (void)vitte_parser_advance(parser);
         if (parser->current.kind != VITTE_TOKEN_IDENTIFIER) {
             (void)vitte_parser_fail_current(parser, "VITTE_PARSER_E_MEMBER", "expected member name after '.'");
@@ -1102,7 +1184,7 @@ static vitte_ast_expr_t *vitte_parser_parse_call(vitte_parser_t *parser) {
         while (parser->current.kind == VITTE_TOKEN_DOT) {
             vitte_ast_span_t span = callee->span;
             vitte_ast_span_t member_span;
-            char *member;
+            const char *member;
             (void)vitte_parser_advance(parser);
             if (parser->current.kind != VITTE_TOKEN_IDENTIFIER) return NULL;
             member = vitte_parser_copy_token_text(parser, &parser->current);
@@ -1518,7 +1600,7 @@ static vitte_ast_stmt_t *vitte_parser_parse_give(vitte_parser_t *parser) {
 static vitte_ast_stmt_t *vitte_parser_parse_let(vitte_parser_t *parser) {
     vitte_ast_span_t keyword_span;
     vitte_token_t name_token;
-    char *name;
+    const char *name;
     vitte_ast_type_ref_t *type = NULL;
     vitte_ast_expr_t *value = NULL;
     vitte_ast_stmt_t *stmt;
@@ -1593,7 +1675,7 @@ static vitte_ast_stmt_t *vitte_parser_parse_while(vitte_parser_t *parser) {
 
 static vitte_ast_stmt_t *vitte_parser_parse_for(vitte_parser_t *parser) {
     vitte_ast_span_t span = vitte_parser_span_from_token(&parser->current);
-    char *name;
+    const char *name;
     vitte_ast_expr_t *iterable;
     vitte_ast_stmt_t *body;
     (void)vitte_parser_advance(parser);
@@ -1942,8 +2024,8 @@ static vitte_status_t vitte_parser_parse_export_item(
     vitte_ast_span_t *item_span_out
 ) {
     vitte_ast_span_t span;
-    char *local_name;
-    char *export_name;
+    const char *local_name;
+    const char *export_name;
 
     if (parser == NULL || module_node == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
@@ -2080,8 +2162,8 @@ static vitte_status_t vitte_parser_parse_import_item(
     vitte_ast_span_t *item_span_out
 ) {
     vitte_ast_span_t span;
-    char *path = NULL;
-    char *alias = NULL;
+    const char *path = NULL;
+    const char *alias = NULL;
 
     if (parser == NULL || module_node == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
@@ -2237,7 +2319,7 @@ static vitte_status_t vitte_parser_parse_imports(
 static vitte_ast_node_t *vitte_parser_parse_param(vitte_parser_t *parser) {
     vitte_ast_span_t start_span;
     vitte_ast_span_t span;
-    char *name;
+    const char *name;
     vitte_ast_type_ref_t *type;
     bool mutable_value = false;
     bool by_ref = false;
@@ -2313,7 +2395,7 @@ static vitte_ast_node_t *vitte_parser_parse_param(vitte_parser_t *parser) {
 static vitte_ast_decl_t *vitte_parser_parse_proc(vitte_parser_t *parser, bool exported) {
     vitte_ast_span_t keyword_span;
     vitte_token_t name_token;
-    char *name;
+    const char *name;
     vitte_ast_type_ref_t *return_type = NULL;
     vitte_ast_stmt_t *body;
     vitte_ast_decl_t *decl;
@@ -2422,7 +2504,7 @@ static vitte_ast_decl_t *vitte_parser_parse_proc(vitte_parser_t *parser, bool ex
 static vitte_ast_decl_t *vitte_parser_parse_const(vitte_parser_t *parser, bool exported) {
     vitte_ast_span_t keyword_span;
     vitte_token_t name_token;
-    char *name;
+    const char *name;
     vitte_ast_type_ref_t *type = NULL;
     vitte_ast_expr_t *value;
     vitte_ast_decl_t *decl;
@@ -2491,7 +2573,7 @@ static vitte_ast_decl_t *vitte_parser_parse_pick(vitte_parser_t *parser, bool ex
     vitte_ast_span_t start_span;
     vitte_ast_span_t end_span;
     vitte_ast_span_t span;
-    char *name;
+    const char *name;
     vitte_ast_decl_t *decl;
 
     start_span = vitte_parser_span_from_token(&parser->current);
@@ -2524,7 +2606,7 @@ static vitte_ast_decl_t *vitte_parser_parse_pick(vitte_parser_t *parser, bool ex
     while (parser->current.kind != VITTE_TOKEN_RBRACE && parser->current.kind != VITTE_TOKEN_EOF) {
         vitte_ast_span_t variant_span;
         vitte_ast_node_t *variant;
-        char *variant_name;
+        const char *variant_name;
 
         if (parser->current.kind == VITTE_TOKEN_COMMA) {
             (void)vitte_parser_advance(parser);
@@ -2571,7 +2653,7 @@ static vitte_ast_decl_t *vitte_parser_parse_form(vitte_parser_t *parser, bool ex
     vitte_ast_span_t start_span;
     vitte_ast_span_t end_span;
     vitte_ast_span_t field_span;
-    char *name;
+    const char *name;
     vitte_ast_decl_t *decl;
 
     start_span = vitte_parser_span_from_token(&parser->current);
@@ -2595,7 +2677,7 @@ static vitte_ast_decl_t *vitte_parser_parse_form(vitte_parser_t *parser, bool ex
     decl = vitte_ast_make_form_decl(&parser->builder, name, exported, start_span);
     if (decl == NULL) return NULL;
     while (parser->current.kind != VITTE_TOKEN_RBRACE && parser->current.kind != VITTE_TOKEN_EOF) {
-        char *field_name;
+        const char *field_name;
         vitte_ast_type_ref_t *type;
         vitte_ast_node_t *field;
         if (parser->current.kind == VITTE_TOKEN_COMMA || parser->current.kind == VITTE_TOKEN_SEMICOLON) {
@@ -2759,8 +2841,8 @@ static vitte_status_t vitte_parser_parse_export_top_level(
     return VITTE_STATUS_OK;
 }
 
-static char *vitte_parser_parse_module_header(vitte_parser_t *parser, vitte_ast_span_t *header_span) {
-    char *name;
+static const char *vitte_parser_parse_module_header(vitte_parser_t *parser, vitte_ast_span_t *header_span) {
+    const char *name;
     vitte_ast_span_t span;
 
     if (parser == NULL || parser->current.kind != VITTE_TOKEN_KW_SPACE) {
@@ -2811,12 +2893,13 @@ void vitte_parser_result_init(vitte_parser_result_t *result) {
     vitte_error_init(&result->last_error);
 }
 
-vitte_status_t vitte_parser_init(
+static vitte_status_t vitte_parser_start(
     vitte_parser_t *parser,
     vitte_ast_t *ast,
     const char *source_name,
     const char *source,
     size_t source_size,
+    vitte_module_t *module,
     const vitte_parser_options_t *options,
     vitte_diagnostic_bag_t *diagnostics
 ) {
@@ -2860,6 +2943,15 @@ vitte_status_t vitte_parser_init(
         return status;
     }
 
+    /* A module that was already lexed hands its token buffer over; the lexer
+     * above then only carries the source name and is never advanced. */
+    parser->module = module;
+    if (vitte_module_has_tokens(module)) {
+        parser->tokens = module->tokens;
+        parser->token_count = module->token_count;
+        parser->token_index = 0u;
+    }
+
     parser->initialized = true;
     status = vitte_parser_advance(parser);
     if (status != VITTE_STATUS_OK) {
@@ -2869,6 +2961,18 @@ vitte_status_t vitte_parser_init(
     return VITTE_STATUS_OK;
 }
 
+vitte_status_t vitte_parser_init(
+    vitte_parser_t *parser,
+    vitte_ast_t *ast,
+    const char *source_name,
+    const char *source,
+    size_t source_size,
+    const vitte_parser_options_t *options,
+    vitte_diagnostic_bag_t *diagnostics
+) {
+    return vitte_parser_start(parser, ast, source_name, source, source_size, NULL, options, diagnostics);
+}
+
 vitte_status_t vitte_parser_init_module(
     vitte_parser_t *parser,
     vitte_module_t *module,
@@ -2877,7 +2981,6 @@ vitte_status_t vitte_parser_init_module(
     vitte_diagnostic_bag_t *diagnostics
 ) {
     vitte_ast_t *effective_ast = ast;
-    vitte_status_t status;
 
     if (parser == NULL || module == NULL || !vitte_module_is_initialized(module) || module->source_buffer == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
@@ -2889,19 +2992,16 @@ vitte_status_t vitte_parser_init_module(
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
 
-    status = vitte_parser_init(
+    return vitte_parser_start(
         parser,
         effective_ast,
         module->source_name != NULL ? module->source_name : module->source_path,
         module->source_buffer,
         module->source_size,
+        module,
         options,
         diagnostics
     );
-    if (status == VITTE_STATUS_OK) {
-        parser->module = module;
-    }
-    return status;
 }
 
 void vitte_parser_destroy(vitte_parser_t *parser) {
@@ -2927,7 +3027,7 @@ vitte_status_t vitte_parser_parse_module(vitte_parser_t *parser, vitte_parser_re
     vitte_ast_module_t *module_node;
     vitte_ast_span_t module_span;
     vitte_ast_span_t header_span;
-    char *module_name;
+    const char *module_name;
     vitte_status_t status = VITTE_STATUS_OK;
 
     if (result != NULL) {
@@ -3043,7 +3143,7 @@ vitte_status_t vitte_parser_parse_module(vitte_parser_t *parser, vitte_parser_re
                 vitte_ast_span_t share_span = vitte_parser_span_from_token(&parser->current);
                 vitte_ast_decl_t *share_decl;
                 vitte_ast_span_t name_span;
-                char *name;
+                const char *name;
                 (void)vitte_parser_advance(parser);
                 if (parser->current.kind != VITTE_TOKEN_IDENTIFIER) {
                     status = vitte_parser_fail_current(parser, "VITTE_PARSER_E_SHARE", "expected identifier after 'share'");
@@ -3057,6 +3157,8 @@ vitte_status_t vitte_parser_parse_module(vitte_parser_t *parser, vitte_parser_re
                 (void)share_decl;
                 vitte_ast_module_set_export_all(module_node, true);
                 vitte_parser_optional_semicolon(parser);
+                have_import_span = true;
+                import_span = share_span;
             } else {
                 decl = vitte_parser_parse_decl(parser);
                 if (decl == NULL) {
@@ -53,6 +53,11 @@ typedef struct vitte_parser {
     vitte_parser_stats_t stats;
     vitte_ast_builder_t builder;
     vitte_lexer_t lexer;
+    const vitte_compact_token_t *tokens;
+    size_t token_count;
+    size_t token_index;
+    size_t payload_index;
+    vitte_line_hint_t line_hint;
     vitte_token_t current;
     vitte_token_t previous;
     size_t depth;
@@ -0,0 +1,312 @@
+#if defined(__unix__) || defined(__APPLE__)
+/* fdopen, pipe and fcntl are POSIX, not C17. */
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "process.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../parallel/parallel.h"
+
+#ifdef VITTE_PROCESS_HAVE_SPAWN
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+/*
+ * Pipes are created and marked close-on-exec under one lock, so a child
+ * spawned by another thread never inherits the write end of someone else's
+ * stdin pipe (which would keep that compiler from ever seeing EOF).
+ */
+static vitte_parallel_mutex_t vitte_process_spawn_lock = VITTE_PARALLEL_MUTEX_INITIALIZER;
+#endif
+
+static void vitte_process_set_error(
+    vitte_process_t *process,
+    vitte_status_t status,
+    const char *code,
+    const char *message,
+    const char *details
+) {
+    if (process != NULL) {
+        vitte_error_set_details(&process->last_error, status, code, message, details);
+    }
+}
+
+bool vitte_process_is_supported(void) {
+#ifdef VITTE_PROCESS_HAVE_SPAWN
+    return true;
+#else
+    return false;
+#endif
+}
+
+void vitte_process_init(vitte_process_t *process) {
+    if (process == NULL) {
+        return;
+    }
+    memset(process, 0, sizeof(*process));
+#ifdef VITTE_PROCESS_HAVE_SPAWN
+    process->error_fd = -1;
+#endif
+    vitte_error_init(&process->last_error);
+}
+
+void vitte_process_destroy(vitte_process_t *process) {
+    if (process == NULL) {
+        return;
+    }
+    if (process->running) {
+        (void)vitte_process_wait(process, NULL);
+    }
+    free(process->error_output);
+    vitte_process_init(process);
+}
+
+const vitte_error_t *vitte_process_last_error(const vitte_process_t *process) {
+    return process != NULL ? &process->last_error : vitte_error_last();
+}
+
+char *vitte_process_take_error_output(vitte_process_t *process) {
+    char *output;
+
+    if (process == NULL || process->error_length == 0u) {
+        return NULL;
+    }
+    output = process->error_output;
+    process->error_output = NULL;
+    process->error_length = 0u;
+    process->error_capacity = 0u;
+    return output;
+}
+
+#ifdef VITTE_PROCESS_HAVE_SPAWN
+static void *vitte_process_drain(void *argument) {
+    vitte_process_t *process = (vitte_process_t *)argument;
+    char chunk[4096];
+
+    for (;;) {
+        ssize_t size = read(process->error_fd, chunk, sizeof(chunk));
+        size_t kept;
+
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        if (size <= 0) {
+            break;
+        }
+        kept = (size_t)size;
+        if (process->error_length + kept > VITTE_PROCESS_MAX_ERROR_OUTPUT) {
+            kept = VITTE_PROCESS_MAX_ERROR_OUTPUT - process->error_length;
+        }
+        if (kept == 0u) {
+            continue;
+        }
+        if (process->error_length + kept + 1u > process->error_capacity) {
+            size_t capacity = process->error_capacity == 0u ? sizeof(chunk) : process->error_capacity;
+            char *grown;
+
+            while (capacity < process->error_length + kept + 1u) {
+                capacity *= 2u;
+            }
+            grown = (char *)realloc(process->error_output, capacity);
+            if (grown == NULL) {
+                continue;
+            }
+            process->error_output = grown;
+            process->error_capacity = capacity;
+        }
+        memcpy(process->error_output + process->error_length, chunk, kept);
+        process->error_length += kept;
+        process->error_output[process->error_length] = '\0';
+    }
+    return NULL;
+}
+
+/*
+ * A child that exits early must surface as a failed write, not kill the
+ * compiler. SIGPIPE is blocked on the writing thread only, for as long as
+ * `input` is open, so the process-wide disposition (and what later children
+ * or embedders see) is never changed.
+ */
+static void vitte_process_block_sigpipe(vitte_process_t *process) {
+    sigset_t pipe_set;
+    sigset_t previous;
+    sigset_t pending;
+
+    (void)sigemptyset(&pipe_set);
+    (void)sigaddset(&pipe_set, SIGPIPE);
+    if (pthread_sigmask(SIG_BLOCK, &pipe_set, &previous) != 0 || sigismember(&previous, SIGPIPE)) {
+        return;
+    }
+    process->sigpipe_blocked = true;
+    process->sigpipe_pending = sigpending(&pending) == 0 && sigismember(&pending, SIGPIPE);
+}
+
+/* Discards the SIGPIPE our own writes raised, then unblocks it again. */
+static void vitte_process_restore_sigpipe(vitte_process_t *process) {
+    sigset_t pipe_set;
+    sigset_t pending;
+    int signal_number;
+
+    if (!process->sigpipe_blocked) {
+        return;
+    }
+    (void)sigemptyset(&pipe_set);
+    (void)sigaddset(&pipe_set, SIGPIPE);
+    if (!process->sigpipe_pending && sigpending(&pending) == 0 && sigismember(&pending, SIGPIPE)) {
+        (void)sigwait(&pipe_set, &signal_number);
+    }
+    (void)pthread_sigmask(SIG_UNBLOCK, &pipe_set, NULL);
+    process->sigpipe_blocked = false;
+    process->sigpipe_pending = false;
+}
+
+static bool vitte_process_make_pipe(int fds[2]) {
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    (void)fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    (void)fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+}
+#endif
+
+vitte_status_t vitte_process_spawn(vitte_process_t *process, const char *const *argv, bool pipe_input) {
+#ifdef VITTE_PROCESS_HAVE_SPAWN
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attributes;
+    sigset_t child_default;
+    sigset_t child_mask;
+    int error_pipe[2] = { -1, -1 };
+    int input_pipe[2] = { -1, -1 };
+    int spawn_status;
+
+    if (process == NULL || process->running || argv == NULL || argv[0] == NULL) {
+        vitte_process_set_error(process, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_PROCESS_E_ARGUMENT", "invalid process spawn arguments", NULL);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    vitte_parallel_mutex_lock(&vitte_process_spawn_lock);
+    if (!vitte_process_make_pipe(error_pipe) || (pipe_input && !vitte_process_make_pipe(input_pipe))) {
+        vitte_parallel_mutex_unlock(&vitte_process_spawn_lock);
+        if (error_pipe[0] >= 0) {
+            (void)close(error_pipe[0]);
+            (void)close(error_pipe[1]);
+        }
+        vitte_process_set_error(process, VITTE_STATUS_ERROR_IO, "VITTE_PROCESS_E_PIPE", "failed to create process pipe", argv[0]);
+        return VITTE_STATUS_ERROR_IO;
+    }
+    (void)posix_spawn_file_actions_init(&actions);
+    (void)posix_spawn_file_actions_adddup2(&actions, error_pipe[1], STDERR_FILENO);
+    if (pipe_input) {
+        (void)posix_spawn_file_actions_adddup2(&actions, input_pipe[0], STDIN_FILENO);
+    }
+    /* The child gets a default SIGPIPE whatever the host (or an embedder) set up. */
+    (void)posix_spawnattr_init(&attributes);
+    (void)sigemptyset(&child_default);
+    (void)sigaddset(&child_default, SIGPIPE);
+    (void)pthread_sigmask(SIG_BLOCK, NULL, &child_mask);
+    (void)sigdelset(&child_mask, SIGPIPE);
+    (void)posix_spawnattr_setsigdefault(&attributes, &child_default);
+    (void)posix_spawnattr_setsigmask(&attributes, &child_mask);
+    (void)posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK);
+    /* argv is never written by posix_spawnp; the cast only bridges its historical prototype. */
+    spawn_status = posix_spawnp(&process->pid, argv[0], &actions, &attributes, (char *const *)(void *)argv, environ);
+    (void)posix_spawnattr_destroy(&attributes);
+    (void)posix_spawn_file_actions_destroy(&actions);
+    vitte_parallel_mutex_unlock(&vitte_process_spawn_lock);
+
+    (void)close(error_pipe[1]);
+    if (pipe_input) {
+        (void)close(input_pipe[0]);
+    }
+    if (spawn_status != 0) {
+        (void)close(error_pipe[0]);
+        if (pipe_input) {
+            (void)close(input_pipe[1]);
+        }
+        vitte_process_set_error(process, VITTE_STATUS_ERROR_IO, "VITTE_PROCESS_E_SPAWN", "failed to start process", argv[0]);
+        return VITTE_STATUS_ERROR_IO;
+    }
+
+    process->running = true;
+    process->error_fd = error_pipe[0];
+    process->draining = pthread_create(&process->drain_thread, NULL, vitte_process_drain, process) == 0;
+    if (!process->draining) {
+        /* Without the helper thread stderr is left to the child's own pipe buffer. */
+        (void)close(process->error_fd);
+        process->error_fd = -1;
+    }
+    if (pipe_input) {
+        process->input = fdopen(input_pipe[1], "wb");
+        if (process->input == NULL) {
+            (void)close(input_pipe[1]);
+            (void)vitte_process_wait(process, NULL);
+            vitte_process_set_error(process, VITTE_STATUS_ERROR_IO, "VITTE_PROCESS_E_PIPE", "failed to open process input stream", argv[0]);
+            return VITTE_STATUS_ERROR_IO;
+        }
+        vitte_process_block_sigpipe(process);
+    }
+    vitte_error_reset(&process->last_error);
+    return VITTE_STATUS_OK;
+#else
+    (void)argv;
+    (void)pipe_input;
+    vitte_process_set_error(process, VITTE_STATUS_ERROR_UNSUPPORTED, "VITTE_PROCESS_E_UNSUPPORTED", "process spawning is not supported on this host", NULL);
+    return VITTE_STATUS_ERROR_UNSUPPORTED;
+#endif
+}
+
+vitte_status_t vitte_process_wait(vitte_process_t *process, int *exit_code) {
+#ifdef VITTE_PROCESS_HAVE_SPAWN
+    int wait_status = 0;
+    pid_t waited;
+    vitte_status_t status = VITTE_STATUS_OK;
+
+    if (exit_code != NULL) {
+        *exit_code = -1;
+    }
+    if (process == NULL || !process->running) {
+        vitte_process_set_error(process, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_PROCESS_E_STATE", "no running process to wait for", NULL);
+        return VITTE_STATUS_ERROR_INVALID_STATE;
+    }
+    if (process->input != NULL) {
+        /* A child that stopped reading makes this fail; its exit status tells why. */
+        (void)fclose(process->input);
+        process->input = NULL;
+    }
+    vitte_process_restore_sigpipe(process);
+    do {
+        waited = waitpid(process->pid, &wait_status, 0);
+    } while (waited < 0 && errno == EINTR);
+    if (process->draining) {
+        (void)pthread_join(process->drain_thread, NULL);
+        process->draining = false;
+    }
+    if (process->error_fd >= 0) {
+        (void)close(process->error_fd);
+        process->error_fd = -1;
+    }
+    process->running = false;
+    if (waited < 0) {
+        vitte_process_set_error(process, VITTE_STATUS_ERROR_IO, "VITTE_PROCESS_E_WAIT", "failed to wait for process", NULL);
+        status = VITTE_STATUS_ERROR_IO;
+    } else if (exit_code != NULL && WIFEXITED(wait_status)) {
+        *exit_code = WEXITSTATUS(wait_status);
+    }
+    return status;
+#else
+    if (exit_code != NULL) {
+        *exit_code = -1;
+    }
+    vitte_process_set_error(process, VITTE_STATUS_ERROR_UNSUPPORTED, "VITTE_PROCESS_E_UNSUPPORTED", "process spawning is not supported on this host", NULL);
+    return VITTE_STATUS_ERROR_UNSUPPORTED;
+#endif
+}
@@ -0,0 +1,77 @@
+#ifndef VITTE_BOOTSTRAP_PROCESS_H
+#define VITTE_BOOTSTRAP_PROCESS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "../api/error.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sys/types.h>
+#define VITTE_PROCESS_HAVE_SPAWN 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VITTE_PROCESS_MAX_ERROR_OUTPUT ((size_t)65536u)
+
+/*
+ * A child process started with posix_spawnp, without a shell. Its stderr is
+ * drained on a helper thread into `error_output` (at most
+ * `VITTE_PROCESS_MAX_ERROR_OUTPUT` bytes kept), so a chatty child never
+ * blocks on a full pipe while the parent is still writing its stdin.
+ */
+typedef struct vitte_process {
+    bool running;
+    FILE *input;
+    char *error_output;
+    size_t error_length;
+    size_t error_capacity;
+#ifdef VITTE_PROCESS_HAVE_SPAWN
+    pid_t pid;
+    int error_fd;
+    bool draining;
+    pthread_t drain_thread;
+    /* SIGPIPE was blocked on the spawning thread for `input`, and was already pending then. */
+    bool sigpipe_blocked;
+    bool sigpipe_pending;
+#endif
+    vitte_error_t last_error;
+} vitte_process_t;
+
+bool vitte_process_is_supported(void);
+
+void vitte_process_init(vitte_process_t *process);
+/* Waits for a child that is still running, then releases captured output. */
+void vitte_process_destroy(vitte_process_t *process);
+const vitte_error_t *vitte_process_last_error(const vitte_process_t *process);
+
+/*
+ * Starts `argv[0]` (searched in PATH) with the NULL-terminated `argv`. With
+ * `pipe_input`, `input` is a stream connected to the child's stdin; otherwise
+ * the child inherits stdin. Write `input` and wait on the spawning thread:
+ * SIGPIPE stays blocked on that thread until the wait. The child starts with
+ * SIGPIPE at its default action and unblocked. Returns
+ * VITTE_STATUS_ERROR_UNSUPPORTED on hosts without posix_spawn.
+ */
+vitte_status_t vitte_process_spawn(vitte_process_t *process, const char *const *argv, bool pipe_input);
+
+/*
+ * Closes `input`, waits for the child and for its stderr to reach EOF.
+ * `exit_code` receives the exit status, or -1 when the child was killed by a
+ * signal.
+ */
+vitte_status_t vitte_process_wait(vitte_process_t *process, int *exit_code);
+
+/* Hands the NUL-terminated stderr text (or NULL when empty) to the caller, who frees it. */
+char *vitte_process_take_error_output(vitte_process_t *process);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VITTE_BOOTSTRAP_PROCESS_H */
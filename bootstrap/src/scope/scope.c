@@ -1,7 +1,11 @@
 #include "scope.h"
 
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "../util/util.h"
+
 static void vitte_scope_set_error(
     vitte_scope_stack_t *stack,
     vitte_status_t status,
@@ -14,12 +18,107 @@ static void vitte_scope_set_error(
     }
 }
 
+static size_t vitte_scope_hash_name(const char *name) {
+    return (size_t)vitte_util_hash_text(VITTE_UTIL_HASH_SEED, name);
+}
+
+/* Returns the slot keyed by `name`, or the empty slot where it would be inserted. */
+static vitte_scope_index_slot_t *vitte_scope_index_probe(
+    const vitte_scope_stack_t *stack,
+    const char *name,
+    size_t hash
+) {
+    size_t mask = stack->index_capacity - 1u;
+    size_t position = hash & mask;
+
+    for (;;) {
+        vitte_scope_index_slot_t *slot = &stack->index[position];
+        if (slot->name == NULL || (slot->hash == hash && (slot->name == name || strcmp(slot->name, name) == 0))) {
+            return slot;
+        }
+        position = (position + 1u) & mask;
+    }
+}
+
+static bool vitte_scope_index_grow(vitte_scope_stack_t *stack) {
+    vitte_scope_index_slot_t *old_index = stack->index;
+    size_t old_capacity = stack->index_capacity;
+    size_t capacity = old_capacity == 0u ? VITTE_SCOPE_INITIAL_INDEX_CAPACITY : old_capacity * 2u;
+    size_t index;
+
+    if (capacity < old_capacity || capacity > SIZE_MAX / sizeof(*old_index)) {
+        return false;
+    }
+    stack->index = (vitte_scope_index_slot_t *)calloc(capacity, sizeof(*stack->index));
+    if (stack->index == NULL) {
+        stack->index = old_index;
+        return false;
+    }
+    stack->index_capacity = capacity;
+    for (index = 0u; index < old_capacity; index++) {
+        if (old_index[index].name != NULL) {
+            size_t position = old_index[index].hash & (capacity - 1u);
+            while (stack->index[position].name != NULL) {
+                position = (position + 1u) & (capacity - 1u);
+            }
+            stack->index[position] = old_index[index];
+        }
+    }
+    free(old_index);
+    return true;
+}
+
+static bool vitte_scope_reserve_frames(vitte_scope_stack_t *stack) {
+    size_t capacity;
+    vitte_scope_frame_t *frames;
+
+    if (stack->frame_count < stack->frame_capacity) {
+        return true;
+    }
+    capacity = stack->frame_capacity == 0u ? VITTE_SCOPE_INITIAL_FRAMES : stack->frame_capacity * 2u;
+    if (capacity > SIZE_MAX / sizeof(*frames)) {
+        return false;
+    }
+    frames = (vitte_scope_frame_t *)realloc(stack->frames, capacity * sizeof(*frames));
+    if (frames == NULL) {
+        return false;
+    }
+    stack->frames = frames;
+    stack->frame_capacity = capacity;
+    return true;
+}
+
+static bool vitte_scope_reserve_bindings(vitte_scope_stack_t *stack) {
+    size_t capacity;
+    vitte_scope_binding_t *bindings;
+
+    if (stack->binding_count < stack->binding_capacity) {
+        return true;
+    }
+    capacity = stack->binding_capacity == 0u ? VITTE_SCOPE_INITIAL_BINDINGS : stack->binding_capacity * 2u;
+    if (capacity > SIZE_MAX / sizeof(*bindings)) {
+        return false;
+    }
+    bindings = (vitte_scope_binding_t *)realloc(stack->bindings, capacity * sizeof(*bindings));
+    if (bindings == NULL) {
+        return false;
+    }
+    stack->bindings = bindings;
+    stack->binding_capacity = capacity;
+    return true;
+}
+
 void vitte_scope_stack_init(vitte_scope_stack_t *stack) {
     if (stack == NULL) {
         return;
     }
     memset(stack, 0, sizeof(*stack));
     vitte_error_init(&stack->last_error);
+    if (!vitte_scope_reserve_frames(stack)) {
+        vitte_scope_set_error(stack, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_SCOPE_E_MEMORY", "cannot allocate bootstrap global scope", NULL);
+        return;
+    }
+    memset(&stack->frames[0], 0, sizeof(stack->frames[0]));
     stack->initialized = true;
     stack->frame_count = 1u;
 }
@@ -28,9 +127,26 @@ void vitte_scope_stack_destroy(vitte_scope_stack_t *stack) {
     if (stack == NULL) {
         return;
     }
+    free(stack->frames);
+    free(stack->bindings);
+    free(stack->index);
     memset(stack, 0, sizeof(*stack));
 }
 
+void vitte_scope_stack_reset(vitte_scope_stack_t *stack) {
+    if (!vitte_scope_stack_is_initialized(stack)) {
+        return;
+    }
+    memset(&stack->frames[0], 0, sizeof(stack->frames[0]));
+    stack->frame_count = 1u;
+    stack->binding_count = 0u;
+    stack->index_count = 0u;
+    if (stack->index != NULL) {
+        memset(stack->index, 0, stack->index_capacity * sizeof(*stack->index));
+    }
+    vitte_error_reset(&stack->last_error);
+}
+
 bool vitte_scope_stack_is_initialized(const vitte_scope_stack_t *stack) {
     return stack != NULL && stack->initialized && stack->frame_count > 0u;
 }
@@ -55,9 +171,9 @@ vitte_status_t vitte_scope_push(vitte_scope_stack_t *stack, bool function_scope)
     if (!vitte_scope_stack_is_initialized(stack)) {
         return VITTE_STATUS_ERROR_INVALID_STATE;
     }
-    if (stack->frame_count >= VITTE_SCOPE_MAX_FRAMES) {
-        vitte_scope_set_error(stack, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_SCOPE_E_LIMIT", "scope frame stack is full", NULL);
-        return VITTE_STATUS_ERROR_INVALID_STATE;
+    if (!vitte_scope_reserve_frames(stack)) {
+        vitte_scope_set_error(stack, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_SCOPE_E_MEMORY", "cannot grow scope frame stack", NULL);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
     }
     frame = &stack->frames[stack->frame_count];
     memset(frame, 0, sizeof(*frame));
@@ -76,31 +192,39 @@ vitte_status_t vitte_scope_pop(vitte_scope_stack_t *stack) {
         return VITTE_STATUS_ERROR_INVALID_STATE;
     }
     frame = &stack->frames[stack->frame_count - 1u];
-    stack->binding_count = frame->binding_start;
+    while (stack->binding_count > frame->binding_start) {
+        const vitte_scope_binding_t *binding = &stack->bindings[stack->binding_count - 1u];
+        vitte_scope_index_slot_t *slot = vitte_scope_index_probe(stack, binding->name, vitte_scope_hash_name(binding->name));
+        slot->binding = binding->shadowed;
+        stack->binding_count--;
+    }
     memset(frame, 0, sizeof(*frame));
     stack->frame_count--;
     vitte_error_reset(&stack->last_error);
     return VITTE_STATUS_OK;
 }
 
+static vitte_scope_binding_t *vitte_scope_find_binding(const vitte_scope_stack_t *stack, const char *name) {
+    const vitte_scope_index_slot_t *slot;
+
+    if (stack->index_count == 0u) {
+        return NULL;
+    }
+    slot = vitte_scope_index_probe(stack, name, vitte_scope_hash_name(name));
+    return slot->binding != 0u ? &stack->bindings[slot->binding - 1u] : NULL;
+}
+
 const vitte_symbol_t *vitte_scope_lookup_current(
     const vitte_scope_stack_t *stack,
     const char *name
 ) {
-    size_t index;
-    const vitte_scope_frame_t *frame;
+    const vitte_scope_binding_t *binding;
 
     if (!vitte_scope_stack_is_initialized(stack) || name == NULL || name[0] == '\0') {
         return NULL;
     }
-    frame = &stack->frames[stack->frame_count - 1u];
-    for (index = stack->binding_count; index > frame->binding_start; index--) {
-        const vitte_scope_binding_t *binding = &stack->bindings[index - 1u];
-        if (binding->name != NULL && strcmp(binding->name, name) == 0) {
-            return binding->symbol;
-        }
-    }
-    return NULL;
+    binding = vitte_scope_find_binding(stack, name);
+    return binding != NULL && binding->frame_index == stack->frame_count - 1u ? binding->symbol : NULL;
 }
 
 vitte_status_t vitte_scope_define(
@@ -108,39 +232,41 @@ vitte_status_t vitte_scope_define(
     const char *name,
     const vitte_symbol_t *symbol
 ) {
-    vitte_scope_frame_t *frame;
     vitte_scope_binding_t *binding;
+    vitte_scope_index_slot_t *slot;
+    size_t hash;
 
     if (!vitte_scope_stack_is_initialized(stack) || name == NULL || name[0] == '\0' || symbol == NULL) {
         vitte_scope_set_error(stack, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_SCOPE_E_DEFINE", "invalid scope definition", name);
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
-    if (vitte_scope_lookup_current(stack, name) != NULL) {
-        size_t index;
-        frame = &stack->frames[stack->frame_count - 1u];
-        for (index = stack->binding_count; index > frame->binding_start; index--) {
-            vitte_scope_binding_t *current = &stack->bindings[index - 1u];
-            if (current->name != NULL && strcmp(current->name, name) == 0 && current->symbol != NULL) {
-                current->symbol = symbol;
-                vitte_error_reset(&stack->last_error);
-                return VITTE_STATUS_OK;
-            }
-        }
-        vitte_scope_set_error(stack, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_SCOPE_E_DUPLICATE", "duplicate symbol in current scope", name);
-        return VITTE_STATUS_ERROR_INVALID_STATE;
+    binding = vitte_scope_find_binding(stack, name);
+    if (binding != NULL && binding->frame_index == stack->frame_count - 1u) {
+        binding->symbol = symbol;
+        vitte_error_reset(&stack->last_error);
+        return VITTE_STATUS_OK;
     }
-    if (stack->binding_count >= VITTE_SCOPE_MAX_BINDINGS) {
-        vitte_scope_set_error(stack, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_SCOPE_E_LIMIT", "scope binding table is full", name);
-        return VITTE_STATUS_ERROR_INVALID_STATE;
+    if (!vitte_scope_reserve_bindings(stack) ||
+        ((stack->index_count + 1u) * 2u > stack->index_capacity && !vitte_scope_index_grow(stack))) {
+        vitte_scope_set_error(stack, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_SCOPE_E_MEMORY", "cannot grow scope binding table", name);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
     }
 
-    frame = &stack->frames[stack->frame_count - 1u];
+    hash = vitte_scope_hash_name(name);
+    slot = vitte_scope_index_probe(stack, name, hash);
+    if (slot->name == NULL) {
+        slot->name = name;
+        slot->hash = hash;
+        stack->index_count++;
+    }
     binding = &stack->bindings[stack->binding_count];
     binding->name = name;
     binding->symbol = symbol;
     binding->frame_index = stack->frame_count - 1u;
+    binding->shadowed = slot->binding;
+    slot->binding = stack->binding_count + 1u;
     stack->binding_count++;
-    frame->binding_count++;
+    stack->frames[stack->frame_count - 1u].binding_count++;
     vitte_error_reset(&stack->last_error);
     return VITTE_STATUS_OK;
 }
@@ -149,18 +275,13 @@ const vitte_symbol_t *vitte_scope_lookup(
     const vitte_scope_stack_t *stack,
     const char *name
 ) {
-    size_t index;
+    const vitte_scope_binding_t *binding;
 
     if (!vitte_scope_stack_is_initialized(stack) || name == NULL || name[0] == '\0') {
         return NULL;
     }
-    for (index = stack->binding_count; index > 0u; index--) {
-        const vitte_scope_binding_t *binding = &stack->bindings[index - 1u];
-        if (binding->name != NULL && strcmp(binding->name, name) == 0) {
-            return binding->symbol;
-        }
-    }
-    return NULL;
+    binding = vitte_scope_find_binding(stack, name);
+    return binding != NULL ? binding->symbol : NULL;
 }
 
 bool vitte_scope_is_function_boundary(const vitte_scope_stack_t *stack) {
@@ -11,8 +11,9 @@
 extern "C" {
 #endif
 
-#define VITTE_SCOPE_MAX_FRAMES ((size_t)128u)
-#define VITTE_SCOPE_MAX_BINDINGS ((size_t)65536u)
+#define VITTE_SCOPE_INITIAL_FRAMES ((size_t)16u)
+#define VITTE_SCOPE_INITIAL_BINDINGS ((size_t)64u)
+#define VITTE_SCOPE_INITIAL_INDEX_CAPACITY ((size_t)64u)
 
 typedef struct vitte_scope_frame {
     size_t binding_start;
@@ -24,19 +25,33 @@ typedef struct vitte_scope_binding {
     const char *name;
     const vitte_symbol_t *symbol;
     size_t frame_index;
+    size_t shadowed;
 } vitte_scope_binding_t;
 
+/* One slot per distinct name; `binding` is the innermost visible binding + 1, or 0. */
+typedef struct vitte_scope_index_slot {
+    const char *name;
+    size_t hash;
+    size_t binding;
+} vitte_scope_index_slot_t;
+
 typedef struct vitte_scope_stack {
     bool initialized;
-    vitte_scope_frame_t frames[VITTE_SCOPE_MAX_FRAMES];
+    vitte_scope_frame_t *frames;
     size_t frame_count;
-    vitte_scope_binding_t bindings[VITTE_SCOPE_MAX_BINDINGS];
+    size_t frame_capacity;
+    vitte_scope_binding_t *bindings;
     size_t binding_count;
+    size_t binding_capacity;
+    vitte_scope_index_slot_t *index;
+    size_t index_count;
+    size_t index_capacity;
     vitte_error_t last_error;
 } vitte_scope_stack_t;
 
 void vitte_scope_stack_init(vitte_scope_stack_t *stack);
 void vitte_scope_stack_destroy(vitte_scope_stack_t *stack);
+void vitte_scope_stack_reset(vitte_scope_stack_t *stack);
 bool vitte_scope_stack_is_initialized(const vitte_scope_stack_t *stack);
 const vitte_error_t *vitte_scope_stack_last_error(const vitte_scope_stack_t *stack);
 void vitte_scope_stack_clear_error(vitte_scope_stack_t *stack);
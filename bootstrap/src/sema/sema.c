@@ -1,8 +1,12 @@
 #include "sema.h"
 
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "../util/util.h"
+
 static const char *vitte_sema_last_name_segment(const char *name);
 
 static bool vitte_sema_expr_path(const vitte_ast_expr_t *expr, char *buffer, size_t capacity) {
@@ -108,11 +112,22 @@ static const vitte_type_t *vitte_sema_resolve_type_ref(
     const vitte_ast_type_ref_t *type_ref
 );
 static const vitte_ast_decl_t *vitte_sema_find_exported_decl_recursive(
-    const vitte_sema_t *sema,
-    const vitte_ast_module_t *module,
+    vitte_sema_t *sema,
+    vitte_sema_import_module_t *entry,
     const char *name,
     size_t depth
 );
+static const vitte_sema_name_slot_t *vitte_sema_name_index_find(
+    const vitte_sema_name_index_t *index,
+    const char *name
+);
+static const vitte_ast_decl_t *vitte_sema_find_local_decl(
+    const vitte_sema_export_summary_t *summary,
+    const char *name
+) {
+    const vitte_sema_name_slot_t *slot = vitte_sema_name_index_find(&summary->decls, name);
+    return slot != NULL ? slot->decl : NULL;
+}
 
 static const vitte_ast_decl_t *vitte_sema_find_nominal_decl(
     vitte_sema_t *sema,
@@ -123,25 +138,25 @@ static const vitte_ast_decl_t *vitte_sema_find_nominal_decl(
     size_t index;
 
     if (sema == NULL || type_name == NULL) return NULL;
-    decl = vitte_ast_module_find_decl(sema->ast->root, type_name);
+    decl = vitte_sema_find_local_decl(&sema->local_summary, type_name);
     if (decl == NULL && leaf != NULL) {
-        decl = vitte_ast_module_find_decl(sema->ast->root, leaf + 1);
+        decl = vitte_sema_find_local_decl(&sema->local_summary, leaf + 1);
     }
     if (decl != NULL && (decl->kind == VITTE_AST_NODE_FORM_DECL || decl->kind == VITTE_AST_NODE_PICK_DECL)) {
         return decl;
     }
     for (index = 0u; index < sema->imported_module_count; index++) {
-        const vitte_ast_module_t *module = sema->imported_modules[index].root;
-        decl = vitte_ast_module_find_decl(module, type_name);
+        vitte_sema_import_module_t *entry = &sema->imported_modules[index];
+        decl = vitte_sema_find_local_decl(entry->summary, type_name);
         if (decl == NULL && leaf != NULL) {
-            decl = vitte_ast_module_find_decl(module, leaf + 1);
+            decl = vitte_sema_find_local_decl(entry->summary, leaf + 1);
         }
         if (decl != NULL && (decl->kind == VITTE_AST_NODE_FORM_DECL || decl->kind == VITTE_AST_NODE_PICK_DECL)) {
             return decl;
         }
-        decl = vitte_sema_find_exported_decl_recursive(sema, module, type_name, 0u);
+        decl = vitte_sema_find_exported_decl_recursive(sema, entry, type_name, 0u);
         if (decl == NULL && leaf != NULL) {
-            decl = vitte_sema_find_exported_decl_recursive(sema, module, leaf + 1, 0u);
+            decl = vitte_sema_find_exported_decl_recursive(sema, entry, leaf + 1, 0u);
         }
         if (decl != NULL && (decl->kind == VITTE_AST_NODE_FORM_DECL || decl->kind == VITTE_AST_NODE_PICK_DECL)) {
             return decl;
@@ -164,10 +179,12 @@ static const vitte_ast_type_ref_t *vitte_sema_find_form_field_type(
         size_t module_index;
         const char *leaf = vitte_sema_last_name_segment(vitte_type_name(base_type));
         for (module_index = 0u; module_index < sema->imported_module_count; module_index++) {
-            const vitte_ast_module_t *module = sema->imported_modules[module_index].root;
-            const vitte_ast_decl_t *candidate = module != NULL ? vitte_ast_module_find_exported_decl(module, leaf) : NULL;
-            if (candidate != NULL && candidate->kind == VITTE_AST_NODE_FORM_DECL) {
-                decl = candidate;
+            const vitte_sema_name_slot_t *candidate = vitte_sema_name_index_find(
+                &sema->imported_modules[module_index].summary->exported,
+                leaf
+            );
+            if (candidate != NULL && candidate->decl->kind == VITTE_AST_NODE_FORM_DECL) {
+                decl = candidate->decl;
                 break;
             }
         }
@@ -175,7 +192,7 @@ static const vitte_ast_type_ref_t *vitte_sema_find_form_field_type(
     if (decl == NULL || decl->kind != VITTE_AST_NODE_FORM_DECL) return NULL;
     for (field = decl->as.form_decl.fields.first; field != NULL; field = field->next) {
         if (field->kind == VITTE_AST_NODE_FORM_FIELD && field->as.form_field.name != NULL &&
-            strcmp(field->as.form_field.name, member) == 0) {
+            (field->as.form_field.name == member || strcmp(field->as.form_field.name, member) == 0)) {
             return field->as.form_field.type;
         }
     }
@@ -308,20 +325,253 @@ static char *vitte_sema_join_qualified_name(
     return joined;
 }
 
-static const vitte_ast_module_t *vitte_sema_find_import_module(
-    const vitte_sema_t *sema,
+static size_t vitte_sema_hash_name(const char *name) {
+    return (size_t)vitte_util_hash_text(VITTE_UTIL_HASH_SEED, name);
+}
+
+/* Returns the slot keyed by `name`, or the empty slot where it would be inserted. */
+static vitte_sema_name_slot_t *vitte_sema_name_index_probe(
+    const vitte_sema_name_index_t *index,
+    const char *name,
+    size_t hash
+) {
+    size_t mask = index->capacity - 1u;
+    size_t position = hash & mask;
+
+    for (;;) {
+        vitte_sema_name_slot_t *slot = &index->slots[position];
+        if (slot->name == NULL || (slot->hash == hash && (slot->name == name || strcmp(slot->name, name) == 0))) {
+            return slot;
+        }
+        position = (position + 1u) & mask;
+    }
+}
+
+static bool vitte_sema_name_index_grow(vitte_sema_name_index_t *index) {
+    vitte_sema_name_slot_t *old_slots = index->slots;
+    size_t old_capacity = index->capacity;
+    size_t capacity = old_capacity == 0u ? VITTE_SEMA_INITIAL_NAME_INDEX_CAPACITY : old_capacity * 2u;
+    size_t position;
+
+    if (capacity < old_capacity || capacity > SIZE_MAX / sizeof(*old_slots)) {
+        return false;
+    }
+    index->slots = (vitte_sema_name_slot_t *)calloc(capacity, sizeof(*index->slots));
+    if (index->slots == NULL) {
+        index->slots = old_slots;
+        return false;
+    }
+    index->capacity = capacity;
+    for (position = 0u; position < old_capacity; position++) {
+        if (old_slots[position].name != NULL) {
+            size_t target = old_slots[position].hash & (capacity - 1u);
+            while (index->slots[target].name != NULL) {
+                target = (target + 1u) & (capacity - 1u);
+            }
+            index->slots[target] = old_slots[position];
+        }
+    }
+    free(old_slots);
+    return true;
+}
+
+/* Keeps the first binding of `name`, matching the AST's first-declaration lookups. */
+static bool vitte_sema_name_index_insert(
+    vitte_sema_name_index_t *index,
+    const char *name,
+    const vitte_ast_decl_t *decl,
+    bool exported
+) {
+    vitte_sema_name_slot_t *slot;
+    size_t hash;
+
+    if ((index->count + 1u) * 2u > index->capacity && !vitte_sema_name_index_grow(index)) {
+        return false;
+    }
+    hash = vitte_sema_hash_name(name);
+    slot = vitte_sema_name_index_probe(index, name, hash);
+    if (slot->name == NULL) {
+        slot->hash = hash;
+        slot->name = name;
+        slot->decl = decl;
+        slot->exported = exported;
+        index->count++;
+    }
+    return true;
+}
+
+static const vitte_sema_name_slot_t *vitte_sema_name_index_find(
+    const vitte_sema_name_index_t *index,
+    const char *name
+) {
+    const vitte_sema_name_slot_t *slot;
+
+    if (index == NULL || name == NULL || index->count == 0u) {
+        return NULL;
+    }
+    slot = vitte_sema_name_index_probe(index, name, vitte_sema_hash_name(name));
+    return slot->name != NULL ? slot : NULL;
+}
+
+static void vitte_sema_name_index_clear(vitte_sema_name_index_t *index) {
+    if (index->slots != NULL) {
+        memset(index->slots, 0, index->capacity * sizeof(*index->slots));
+    }
+    index->count = 0u;
+}
+
+void vitte_sema_export_summary_init(vitte_sema_export_summary_t *summary) {
+    if (summary != NULL) {
+        memset(summary, 0, sizeof(*summary));
+    }
+}
+
+void vitte_sema_export_summary_destroy(vitte_sema_export_summary_t *summary) {
+    if (summary == NULL) {
+        return;
+    }
+    free(summary->exports);
+    free(summary->reexport_imports);
+    free(summary->decls.slots);
+    free(summary->exported.slots);
+    memset(summary, 0, sizeof(*summary));
+}
+
+static bool vitte_sema_summary_record_export(
+    const vitte_ast_decl_t *decl,
+    const char *public_name,
+    void *user
+) {
+    vitte_sema_export_summary_t *summary = (vitte_sema_export_summary_t *)user;
+
+    if (summary->export_count == summary->export_capacity) {
+        size_t capacity = summary->export_capacity == 0u ? 16u : summary->export_capacity * 2u;
+        vitte_sema_export_entry_t *exports;
+
+        if (capacity > SIZE_MAX / sizeof(*exports)) {
+            return false;
+        }
+        exports = (vitte_sema_export_entry_t *)realloc(summary->exports, capacity * sizeof(*exports));
+        if (exports == NULL) {
+            return false;
+        }
+        summary->exports = exports;
+        summary->export_capacity = capacity;
+    }
+    summary->exports[summary->export_count].public_name = public_name;
+    summary->exports[summary->export_count].decl = decl;
+    summary->export_count++;
+    return true;
+}
+
+static bool vitte_sema_summary_record_reexport(
+    vitte_sema_export_summary_t *summary,
+    const vitte_ast_decl_t *import_decl
+) {
+    if (summary->reexport_import_count == summary->reexport_import_capacity) {
+        size_t capacity = summary->reexport_import_capacity == 0u ? 8u : summary->reexport_import_capacity * 2u;
+        const vitte_ast_decl_t **imports;
+
+        if (capacity > SIZE_MAX / sizeof(*imports)) {
+            return false;
+        }
+        imports = (const vitte_ast_decl_t **)realloc((void *)summary->reexport_imports, capacity * sizeof(*imports));
+        if (imports == NULL) {
+            return false;
+        }
+        summary->reexport_imports = imports;
+        summary->reexport_import_capacity = capacity;
+    }
+    summary->reexport_imports[summary->reexport_import_count++] = import_decl;
+    return true;
+}
+
+vitte_status_t vitte_sema_export_summary_build(
+    vitte_sema_export_summary_t *summary,
+    const vitte_ast_t *ast
+) {
+    const vitte_ast_module_t *module;
+    const vitte_ast_node_t *node;
+    size_t visited;
+
+    if (summary == NULL || ast == NULL || !vitte_ast_is_initialized(ast) || ast->root == NULL ||
+        ast->root->kind != VITTE_AST_NODE_MODULE) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    module = ast->root;
+    summary->initialized = false;
+    summary->root = module;
+    summary->export_count = 0u;
+    summary->reexport_import_count = 0u;
+    vitte_sema_name_index_clear(&summary->decls);
+    vitte_sema_name_index_clear(&summary->exported);
+
+    for (node = module->as.module.declarations.first; node != NULL; node = node->next) {
+        const char *name = vitte_ast_decl_name(node);
+
+        if (name == NULL || vitte_sema_name_index_find(&summary->decls, name) != NULL) {
+            continue;
+        }
+        if (!vitte_sema_name_index_insert(&summary->decls, name, node, vitte_ast_module_decl_is_exported(module, node))) {
+            return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    /* Explicit `export` entries win over implicitly exported declarations. */
+    for (node = module->as.module.exports.first; node != NULL; node = node->next) {
+        const vitte_sema_name_slot_t *target;
+
+        if (node->kind != VITTE_AST_NODE_EXPORT_DECL || node->as.export_decl.export_name == NULL) {
+            continue;
+        }
+        target = vitte_sema_name_index_find(&summary->decls, node->as.export_decl.local_name);
+        if (target != NULL &&
+            !vitte_sema_name_index_insert(&summary->exported, node->as.export_decl.export_name, target->decl, true)) {
+            return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        }
+    }
+    for (node = module->as.module.declarations.first; node != NULL; node = node->next) {
+        const vitte_sema_name_slot_t *slot = vitte_sema_name_index_find(&summary->decls, vitte_ast_decl_name(node));
+
+        if (slot != NULL && slot->decl == node && slot->exported &&
+            !vitte_sema_name_index_insert(&summary->exported, slot->name, node, true)) {
+            return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    visited = vitte_ast_module_visit_exports(module, vitte_sema_summary_record_export, summary);
+    if (visited != summary->export_count) {
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (module->as.module.export_all) {
+        for (node = module->as.module.imports.first; node != NULL; node = node->next) {
+            if (node->kind == VITTE_AST_NODE_IMPORT_DECL && !vitte_sema_summary_record_reexport(summary, node)) {
+                return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+            }
+        }
+    }
+    summary->initialized = true;
+    return VITTE_STATUS_OK;
+}
+
+static vitte_sema_import_module_t *vitte_sema_find_import_module(
+    vitte_sema_t *sema,
     const char *module_name
 ) {
-    size_t index;
+    size_t mask = VITTE_SEMA_MAX_IMPORT_MODULES * 2u - 1u;
+    size_t position;
 
-    if (sema == NULL || module_name == NULL) {
+    if (sema == NULL || module_name == NULL || sema->imported_module_count == 0u) {
         return NULL;
     }
-    for (index = 0u; index < sema->imported_module_count; index++) {
-        if (sema->imported_modules[index].module_name != NULL &&
-            strcmp(sema->imported_modules[index].module_name, module_name) == 0) {
-            return sema->imported_modules[index].root;
+    position = vitte_sema_hash_name(module_name) & mask;
+    while (sema->imported_module_slots[position] != 0u) {
+        vitte_sema_import_module_t *entry = &sema->imported_modules[sema->imported_module_slots[position] - 1u];
+        if (strcmp(entry->module_name, module_name) == 0) {
+            return entry;
         }
+        position = (position + 1u) & mask;
     }
     return NULL;
 }
@@ -332,48 +582,82 @@ static bool vitte_sema_import_module_name(
     size_t buffer_capacity
 );
 
-static const vitte_ast_decl_t *vitte_sema_find_exported_decl_recursive(
-    const vitte_sema_t *sema,
-    const vitte_ast_module_t *module,
-    const char *name,
-    size_t depth
+/*
+ * Lists the modules searched for an export of `entry`: the module itself, then
+ * breadth-first through the imports of modules declared with `export *`. The
+ * walk depends on the importing unit's module set, so it is cached per import
+ * entry and dropped whenever that set changes.
+ */
+static const size_t *vitte_sema_import_closure(
+    vitte_sema_t *sema,
+    vitte_sema_import_module_t *entry,
+    size_t *scratch,
+    size_t *count
 ) {
-    const vitte_ast_decl_t *decl;
-    const vitte_ast_module_t *queue[256];
+    const vitte_sema_import_module_t *queue[256];
     const vitte_ast_module_t *visited[256];
     size_t queue_count = 0u;
     size_t queue_index = 0u;
     size_t visited_count = 0u;
 
-    (void)depth;
-    if (sema == NULL || module == NULL || name == NULL) return NULL;
-    queue[queue_count++] = module;
+    if (entry->closure != NULL) {
+        *count = entry->closure_count;
+        return entry->closure;
+    }
+    queue[queue_count++] = entry;
     while (queue_index < queue_count) {
-        const vitte_ast_module_t *current = queue[queue_index++];
-        const vitte_ast_node_t *import_node;
+        const vitte_sema_import_module_t *current = queue[queue_index++];
         size_t index;
         bool already_seen = false;
 
         for (index = 0u; index < visited_count; index++) {
-            if (visited[index] == current) {
+            if (visited[index] == current->root) {
                 already_seen = true;
                 break;
             }
         }
-        if (already_seen || current == NULL || visited_count >= 256u) continue;
-        visited[visited_count++] = current;
-        decl = vitte_ast_module_find_exported_decl(current, name);
-        if (decl != NULL) return decl;
-        if (!current->as.module.export_all) continue;
-        for (import_node = current->as.module.imports.first; import_node != NULL; import_node = import_node->next) {
-            const vitte_ast_module_t *child;
+        if (already_seen || visited_count >= 256u) continue;
+        scratch[visited_count] = (size_t)(current - sema->imported_modules);
+        visited[visited_count++] = current->root;
+        for (index = 0u; index < current->summary->reexport_import_count; index++) {
+            const vitte_sema_import_module_t *child;
             char child_name[VITTE_IMPORT_MAX_MODULE_NAME];
-            if (import_node->kind != VITTE_AST_NODE_IMPORT_DECL ||
-                !vitte_sema_import_module_name(import_node, child_name, sizeof(child_name))) continue;
+            if (!vitte_sema_import_module_name(current->summary->reexport_imports[index], child_name, sizeof(child_name))) continue;
             child = vitte_sema_find_import_module(sema, child_name);
             if (child != NULL && queue_count < 256u) queue[queue_count++] = child;
         }
     }
+    *count = visited_count;
+    entry->closure = (size_t *)malloc(visited_count * sizeof(*entry->closure));
+    if (entry->closure == NULL) {
+        return scratch;
+    }
+    (void)memcpy(entry->closure, scratch, visited_count * sizeof(*entry->closure));
+    entry->closure_count = visited_count;
+    return entry->closure;
+}
+
+static const vitte_ast_decl_t *vitte_sema_find_exported_decl_recursive(
+    vitte_sema_t *sema,
+    vitte_sema_import_module_t *entry,
+    const char *name,
+    size_t depth
+) {
+    const size_t *closure;
+    size_t scratch[256];
+    size_t count = 0u;
+    size_t index;
+
+    (void)depth;
+    if (sema == NULL || entry == NULL || name == NULL) return NULL;
+    closure = vitte_sema_import_closure(sema, entry, scratch, &count);
+    for (index = 0u; index < count; index++) {
+        const vitte_sema_name_slot_t *slot = vitte_sema_name_index_find(
+            &sema->imported_modules[closure[index]].summary->exported,
+            name
+        );
+        if (slot != NULL) return slot->decl;
+    }
     return NULL;
 }
 
@@ -397,7 +681,7 @@ static const vitte_ast_decl_t *vitte_sema_find_reexport_import(
         path = import_decl->as.import_decl.path;
         if (import_decl->as.import_decl.import_kind == VITTE_AST_IMPORT_GLOB) {
             char module_name[VITTE_IMPORT_MAX_MODULE_NAME];
-            const vitte_ast_module_t *imported_module;
+            vitte_sema_import_module_t *imported_module;
             size_t length;
 
             if (path == NULL || path[0] == '\0') {
@@ -422,7 +706,7 @@ static const vitte_ast_decl_t *vitte_sema_find_reexport_import(
         } else {
             visible_name = vitte_sema_last_name_segment(path);
         }
-        if (visible_name != NULL && strcmp(visible_name, name) == 0) {
+        if (visible_name != NULL && (visible_name == name || strcmp(visible_name, name) == 0)) {
             return import_decl;
         }
     }
@@ -568,37 +852,30 @@ static bool vitte_sema_define_imported_export(
 
 static size_t vitte_sema_visit_reexported_modules(
     vitte_sema_t *sema,
-    const vitte_ast_module_t *module,
+    vitte_sema_import_module_t *entry,
     vitte_sema_import_export_context_t *context
 ) {
-    const vitte_ast_module_t *queue[256];
-    const vitte_ast_module_t *visited[256];
-    size_t queue_count = 0u;
-    size_t queue_index = 0u;
-    size_t visited_count = 0u;
+    const size_t *closure;
+    size_t scratch[256];
+    size_t closure_count = 0u;
+    size_t index;
     size_t count = 0u;
 
-    if (sema == NULL || module == NULL || context == NULL) return 0u;
-    queue[queue_count++] = module;
-    while (queue_index < queue_count && context->status == VITTE_STATUS_OK) {
-        const vitte_ast_module_t *current = queue[queue_index++];
-        const vitte_ast_node_t *import_node;
-        size_t index;
-        bool seen = false;
-        for (index = 0u; index < visited_count; index++) {
-            if (visited[index] == current) { seen = true; break; }
-        }
-        if (seen || current == NULL || visited_count >= 256u) continue;
-        visited[visited_count++] = current;
-        count += vitte_ast_module_visit_exports(current, vitte_sema_define_imported_export, context);
-        if (!current->as.module.export_all) continue;
-        for (import_node = current->as.module.imports.first; import_node != NULL; import_node = import_node->next) {
-            const vitte_ast_module_t *child;
-            char child_name[VITTE_IMPORT_MAX_MODULE_NAME];
-            if (import_node->kind != VITTE_AST_NODE_IMPORT_DECL ||
-                !vitte_sema_import_module_name(import_node, child_name, sizeof(child_name))) continue;
-            child = vitte_sema_find_import_module(sema, child_name);
-            if (child != NULL && queue_count < 256u) queue[queue_count++] = child;
+    if (sema == NULL || entry == NULL || context == NULL) return 0u;
+    closure = vitte_sema_import_closure(sema, entry, scratch, &closure_count);
+    for (index = 0u; index < closure_count && context->status == VITTE_STATUS_OK; index++) {
+        const vitte_sema_export_summary_t *summary = sema->imported_modules[closure[index]].summary;
+        size_t export_index;
+
+        for (export_index = 0u; export_index < summary->export_count; export_index++) {
+            if (!vitte_sema_define_imported_export(
+                    summary->exports[export_index].decl,
+                    summary->exports[export_index].public_name,
+                    context
+                )) {
+                break;
+            }
+            count++;
         }
     }
     return count;
@@ -702,8 +979,8 @@ static bool vitte_sema_report_private_import_use(
         for (import_decl = module->as.module.imports.first; import_decl != NULL; import_decl = import_decl->next) {
             char module_name[VITTE_IMPORT_MAX_MODULE_NAME];
             const char *visible_name;
-            const vitte_ast_module_t *imported_module;
-            const vitte_ast_decl_t *decl;
+            vitte_sema_import_module_t *imported_module;
+            const vitte_sema_name_slot_t *decl;
 
             if (import_decl->kind != VITTE_AST_NODE_IMPORT_DECL ||
                 import_decl->as.import_decl.import_kind != VITTE_AST_IMPORT_MODULE) {
@@ -722,8 +999,8 @@ static bool vitte_sema_report_private_import_use(
             if (imported_module == NULL) {
                 continue;
             }
-            decl = vitte_ast_module_find_decl(imported_module, member);
-            if (decl != NULL && !vitte_ast_module_decl_is_exported(imported_module, decl)) {
+            decl = vitte_sema_name_index_find(&imported_module->summary->decls, member);
+            if (decl != NULL && !decl->exported) {
                 (void)vitte_sema_fail(
                     sema,
                     VITTE_STATUS_ERROR_PARSE,
@@ -740,8 +1017,8 @@ static bool vitte_sema_report_private_import_use(
 
     for (import_decl = module->as.module.imports.first; import_decl != NULL; import_decl = import_decl->next) {
         char module_name[VITTE_IMPORT_MAX_MODULE_NAME];
-        const vitte_ast_module_t *imported_module;
-        const vitte_ast_decl_t *decl;
+        vitte_sema_import_module_t *imported_module;
+        const vitte_sema_name_slot_t *decl;
 
         if (import_decl->kind != VITTE_AST_NODE_IMPORT_DECL) {
             continue;
@@ -750,7 +1027,7 @@ static bool vitte_sema_report_private_import_use(
             const char *visible_name = vitte_sema_import_visible_name(import_decl);
             const char *decl_name;
 
-            if (visible_name == NULL || strcmp(visible_name, name) != 0 ||
+            if (visible_name == NULL || (visible_name != name && strcmp(visible_name, name) != 0) ||
                 !vitte_sema_import_module_name(import_decl, module_name, sizeof(module_name))) {
                 continue;
             }
@@ -759,8 +1036,8 @@ static bool vitte_sema_report_private_import_use(
                 continue;
             }
             decl_name = vitte_sema_last_name_segment(import_decl->as.import_decl.path);
-            decl = vitte_ast_module_find_decl(imported_module, decl_name);
-            if (decl != NULL && !vitte_ast_module_decl_is_exported(imported_module, decl)) {
+            decl = vitte_sema_name_index_find(&imported_module->summary->decls, decl_name);
+            if (decl != NULL && !decl->exported) {
                 (void)vitte_sema_fail(
                     sema,
                     VITTE_STATUS_ERROR_PARSE,
@@ -779,8 +1056,8 @@ static bool vitte_sema_report_private_import_use(
             if (imported_module == NULL) {
                 continue;
             }
-            decl = vitte_ast_module_find_decl(imported_module, name);
-            if (decl != NULL && !vitte_ast_module_decl_is_exported(imported_module, decl)) {
+            decl = vitte_sema_name_index_find(&imported_module->summary->decls, name);
+            if (decl != NULL && !decl->exported) {
                 (void)vitte_sema_fail(
                     sema,
                     VITTE_STATUS_ERROR_PARSE,
@@ -837,7 +1114,7 @@ static vitte_status_t vitte_sema_validate_import_decl(
         }
         if (visible_name != NULL &&
             previous_visible_name != NULL &&
-            strcmp(visible_name, previous_visible_name) == 0) {
+            (visible_name == previous_visible_name || strcmp(visible_name, previous_visible_name) == 0)) {
             return vitte_sema_fail(
                 sema,
                 VITTE_STATUS_ERROR_PARSE,
@@ -1019,7 +1296,7 @@ static vitte_status_t vitte_sema_predeclare_imports(
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
     for (import_decl = module->as.module.imports.first; import_decl != NULL; import_decl = import_decl->next) {
-        const vitte_ast_module_t *imported_module;
+        vitte_sema_import_module_t *imported_module;
         const char *path;
         const char *last_dot;
         const char *leaf_name;
@@ -1097,7 +1374,7 @@ static vitte_status_t vitte_sema_predeclare_imports(
                 leaf_name;
 
             if (decl == NULL) {
-                const vitte_ast_decl_t *private_decl = vitte_ast_module_find_decl(imported_module, leaf_name);
+                const vitte_ast_decl_t *private_decl = vitte_sema_find_local_decl(imported_module->summary, leaf_name);
 
                 if (private_decl != NULL) {
                     return vitte_sema_fail(
@@ -1158,7 +1435,7 @@ static const vitte_type_t *vitte_sema_resolve_type_ref(
         type_ref->as.type_name.name != NULL) {
         size_t module_index;
         for (module_index = 0u; module_index < sema->imported_module_count && type == NULL; module_index++) {
-            const vitte_ast_module_t *imported = sema->imported_modules[module_index].root;
+            vitte_sema_import_module_t *imported = &sema->imported_modules[module_index];
             const vitte_ast_decl_t *decl = vitte_sema_find_exported_decl_recursive(
                 sema,
                 imported,
@@ -1250,6 +1527,7 @@ void vitte_sema_options_init(vitte_sema_options_t *options) {
     options->max_depth = 256u;
     options->allow_shadowing = true;
     options->enable_constant_folding = true;
+    vitte_allocator_default(&options->allocator);
 }
 
 void vitte_sema_stats_init(vitte_sema_stats_t *stats) {
@@ -1294,7 +1572,7 @@ vitte_status_t vitte_sema_init(
         sema->options.max_depth = 256u;
     }
 
-    if (vitte_type_registry_init(&sema->types) != VITTE_STATUS_OK) {
+    if (vitte_type_registry_init(&sema->types, &sema->options.allocator) != VITTE_STATUS_OK) {
         vitte_error_copy(&sema->last_error, vitte_type_registry_last_error(&sema->types));
         return VITTE_STATUS_ERROR_INTERNAL;
     }
@@ -1316,13 +1594,62 @@ vitte_status_t vitte_sema_init(
     return VITTE_STATUS_OK;
 }
 
+static void vitte_sema_drop_import_closures(vitte_sema_t *sema) {
+    size_t index;
+
+    for (index = 0u; index < sema->imported_module_count; index++) {
+        free(sema->imported_modules[index].closure);
+        sema->imported_modules[index].closure = NULL;
+        sema->imported_modules[index].closure_count = 0u;
+    }
+}
+
+static void vitte_sema_release_imports(vitte_sema_t *sema) {
+    size_t index;
+
+    vitte_sema_drop_import_closures(sema);
+    for (index = 0u; index < sema->imported_module_count; index++) {
+        vitte_sema_export_summary_t *owned = sema->imported_modules[index].owned_summary;
+        if (owned != NULL) {
+            vitte_sema_export_summary_destroy(owned);
+            free(owned);
+        }
+    }
+    memset(sema->imported_modules, 0, sema->imported_module_count * sizeof(sema->imported_modules[0]));
+    memset(sema->imported_module_slots, 0, sizeof(sema->imported_module_slots));
+    sema->imported_module_count = 0u;
+}
+
 void vitte_sema_destroy(vitte_sema_t *sema) {
     if (sema == NULL) {
         return;
     }
+    vitte_sema_release_imports(sema);
+    vitte_sema_export_summary_destroy(&sema->local_summary);
+    vitte_symbol_table_destroy(&sema->symbols);
+    vitte_scope_stack_destroy(&sema->scopes);
+    vitte_type_registry_destroy(&sema->types);
     memset(sema, 0, sizeof(*sema));
 }
 
+void vitte_sema_reset(vitte_sema_t *sema, vitte_diagnostic_bag_t *diagnostics) {
+    if (!vitte_sema_is_initialized(sema)) {
+        return;
+    }
+    vitte_sema_release_imports(sema);
+    vitte_type_registry_reset(&sema->types);
+    vitte_symbol_table_reset(&sema->symbols);
+    vitte_scope_stack_reset(&sema->scopes);
+    sema->diagnostics = diagnostics;
+    sema->ast = NULL;
+    sema->current_return_type = NULL;
+    sema->current_function = NULL;
+    sema->depth = 0u;
+    sema->main_found = false;
+    vitte_sema_stats_init(&sema->stats);
+    vitte_error_reset(&sema->last_error);
+}
+
 bool vitte_sema_is_initialized(const vitte_sema_t *sema) {
     return sema != NULL && sema->initialized;
 }
@@ -1335,23 +1662,81 @@ const vitte_sema_stats_t *vitte_sema_stats(const vitte_sema_t *sema) {
     return sema != NULL ? &sema->stats : NULL;
 }
 
+static vitte_status_t vitte_sema_append_import_module(
+    vitte_sema_t *sema,
+    const char *module_name,
+    const vitte_sema_export_summary_t *summary,
+    vitte_sema_export_summary_t *owned_summary
+) {
+    size_t mask = VITTE_SEMA_MAX_IMPORT_MODULES * 2u - 1u;
+    size_t position;
+    vitte_sema_import_module_t *entry;
+
+    if (sema->imported_module_count >= VITTE_SEMA_MAX_IMPORT_MODULES) {
+        vitte_sema_set_error(sema, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_SEMA_E_IMPORT", "semantic import module table is full", module_name);
+        return VITTE_STATUS_ERROR_INVALID_STATE;
+    }
+    /* Re-export walks depend on the visible module set. */
+    vitte_sema_drop_import_closures(sema);
+    entry = &sema->imported_modules[sema->imported_module_count];
+    entry->module_name = module_name;
+    entry->root = summary->root;
+    entry->summary = summary;
+    entry->owned_summary = owned_summary;
+    sema->imported_module_count++;
+
+    /* The first module registered under a name stays visible, as with a linear scan. */
+    position = vitte_sema_hash_name(module_name) & mask;
+    while (sema->imported_module_slots[position] != 0u) {
+        if (strcmp(sema->imported_modules[sema->imported_module_slots[position] - 1u].module_name, module_name) == 0) {
+            return VITTE_STATUS_OK;
+        }
+        position = (position + 1u) & mask;
+    }
+    sema->imported_module_slots[position] = sema->imported_module_count;
+    return VITTE_STATUS_OK;
+}
+
 vitte_status_t vitte_sema_add_import_module(
     vitte_sema_t *sema,
     const char *module_name,
     const vitte_ast_t *ast
 ) {
+    vitte_sema_export_summary_t *summary;
+    vitte_status_t status;
+
     if (!vitte_sema_is_initialized(sema) || module_name == NULL || ast == NULL ||
         !vitte_ast_is_initialized(ast) || ast->root == NULL || ast->root->kind != VITTE_AST_NODE_MODULE) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
-    if (sema->imported_module_count >= VITTE_SEMA_MAX_IMPORT_MODULES) {
-        vitte_sema_set_error(sema, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_SEMA_E_IMPORT", "semantic import module table is full", module_name);
-        return VITTE_STATUS_ERROR_INVALID_STATE;
+    summary = (vitte_sema_export_summary_t *)malloc(sizeof(*summary));
+    if (summary == NULL) {
+        vitte_sema_set_error(sema, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_SEMA_E_IMPORT", "failed to allocate import export summary", module_name);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
     }
-    sema->imported_modules[sema->imported_module_count].module_name = module_name;
-    sema->imported_modules[sema->imported_module_count].root = ast->root;
-    sema->imported_module_count++;
-    return VITTE_STATUS_OK;
+    vitte_sema_export_summary_init(summary);
+    status = vitte_sema_export_summary_build(summary, ast);
+    if (status == VITTE_STATUS_OK) {
+        status = vitte_sema_append_import_module(sema, module_name, summary, summary);
+    } else {
+        vitte_sema_set_error(sema, status, "VITTE_SEMA_E_IMPORT", "failed to summarize imported module exports", module_name);
+    }
+    if (status != VITTE_STATUS_OK) {
+        vitte_sema_export_summary_destroy(summary);
+        free(summary);
+    }
+    return status;
+}
+
+vitte_status_t vitte_sema_add_import_summary(
+    vitte_sema_t *sema,
+    const char *module_name,
+    const vitte_sema_export_summary_t *summary
+) {
+    if (!vitte_sema_is_initialized(sema) || module_name == NULL || summary == NULL || !summary->initialized) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    return vitte_sema_append_import_module(sema, module_name, summary, NULL);
 }
 
 static const vitte_symbol_t *vitte_sema_lookup_symbol(
@@ -1737,7 +2122,7 @@ static const vitte_type_t *vitte_sema_analyze_expr(
                         size_t module_index;
                         for (module_index = 0u; module_index < sema->imported_module_count && proc_decl == NULL; module_index++) {
                             proc_decl = vitte_sema_find_exported_decl_recursive(
-                                sema, sema->imported_modules[module_index].root, leaf, 0u
+                                sema, &sema->imported_modules[module_index], leaf, 0u
                             );
                         }
                         if (proc_decl != NULL && proc_decl->kind == VITTE_AST_NODE_PROC_DECL) {
@@ -2630,8 +3015,18 @@ vitte_status_t vitte_sema_analyze(
     sema->current_return_type = NULL;
     vitte_sema_stats_init(&sema->stats);
     vitte_error_reset(&sema->last_error);
-    vitte_symbol_table_init(&sema->symbols);
-    vitte_scope_stack_init(&sema->scopes);
+    vitte_symbol_table_reset(&sema->symbols);
+    vitte_scope_stack_reset(&sema->scopes);
+
+    status = vitte_sema_export_summary_build(&sema->local_summary, ast);
+    if (status != VITTE_STATUS_OK) {
+        vitte_sema_set_error(sema, status, "VITTE_SEMA_E_MEMORY", "failed to index module declarations", NULL);
+        if (result != NULL) {
+            result->status = status;
+            vitte_error_copy(&result->last_error, &sema->last_error);
+        }
+        return status;
+    }
 
     status = vitte_sema_load_builtins(sema);
     if (status != VITTE_STATUS_OK) {
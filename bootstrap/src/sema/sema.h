@@ -19,10 +19,52 @@ extern "C" {
 #endif
 
 #define VITTE_SEMA_MAX_IMPORT_MODULES ((size_t)256u)
+#define VITTE_SEMA_INITIAL_NAME_INDEX_CAPACITY ((size_t)64u)
+
+typedef struct vitte_sema_name_slot {
+    size_t hash;
+    const char *name;
+    const vitte_ast_decl_t *decl;
+    bool exported;
+} vitte_sema_name_slot_t;
+
+typedef struct vitte_sema_name_index {
+    vitte_sema_name_slot_t *slots;
+    size_t capacity;
+    size_t count;
+} vitte_sema_name_index_t;
+
+typedef struct vitte_sema_export_entry {
+    const char *public_name;
+    const vitte_ast_decl_t *decl;
+} vitte_sema_export_entry_t;
+
+/*
+ * Export summary of one parsed module. It only depends on the module AST, so a
+ * driver can build it once and attach it to every unit importing the module.
+ * `decls` maps a name to its first declaration, `exported` resolves public
+ * names, and `exports` lists the public surface in declaration order.
+ */
+typedef struct vitte_sema_export_summary {
+    bool initialized;
+    const vitte_ast_module_t *root;
+    vitte_sema_export_entry_t *exports;
+    size_t export_count;
+    size_t export_capacity;
+    const vitte_ast_decl_t **reexport_imports;
+    size_t reexport_import_count;
+    size_t reexport_import_capacity;
+    vitte_sema_name_index_t decls;
+    vitte_sema_name_index_t exported;
+} vitte_sema_export_summary_t;
 
 typedef struct vitte_sema_import_module {
     const char *module_name;
     const vitte_ast_module_t *root;
+    const vitte_sema_export_summary_t *summary;
+    vitte_sema_export_summary_t *owned_summary;
+    size_t *closure;
+    size_t closure_count;
 } vitte_sema_import_module_t;
 
 typedef struct vitte_sema_options {
@@ -30,6 +72,8 @@ typedef struct vitte_sema_options {
     bool require_main_proc;
     bool allow_shadowing;
     bool enable_constant_folding;
+    /* Backs the type arena; the default allocator when left invalid. */
+    vitte_allocator_t allocator;
 } vitte_sema_options_t;
 
 typedef struct vitte_sema_stats {
@@ -65,6 +109,8 @@ typedef struct vitte_sema {
     const vitte_symbol_t *current_function;
     vitte_sema_import_module_t imported_modules[VITTE_SEMA_MAX_IMPORT_MODULES];
     size_t imported_module_count;
+    size_t imported_module_slots[VITTE_SEMA_MAX_IMPORT_MODULES * 2u];
+    vitte_sema_export_summary_t local_summary;
     size_t depth;
     bool main_found;
     vitte_sema_stats_t stats;
@@ -81,6 +127,7 @@ vitte_status_t vitte_sema_init(
     vitte_diagnostic_bag_t *diagnostics
 );
 void vitte_sema_destroy(vitte_sema_t *sema);
+void vitte_sema_reset(vitte_sema_t *sema, vitte_diagnostic_bag_t *diagnostics);
 bool vitte_sema_is_initialized(const vitte_sema_t *sema);
 const vitte_error_t *vitte_sema_last_error(const vitte_sema_t *sema);
 const vitte_sema_stats_t *vitte_sema_stats(const vitte_sema_t *sema);
@@ -89,6 +136,18 @@ vitte_status_t vitte_sema_add_import_module(
     const char *module_name,
     const vitte_ast_t *ast
 );
+vitte_status_t vitte_sema_add_import_summary(
+    vitte_sema_t *sema,
+    const char *module_name,
+    const vitte_sema_export_summary_t *summary
+);
+
+void vitte_sema_export_summary_init(vitte_sema_export_summary_t *summary);
+void vitte_sema_export_summary_destroy(vitte_sema_export_summary_t *summary);
+vitte_status_t vitte_sema_export_summary_build(
+    vitte_sema_export_summary_t *summary,
+    const vitte_ast_t *ast
+);
 
 vitte_status_t vitte_sema_analyze(
     vitte_sema_t *sema,
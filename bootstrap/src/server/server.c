@@ -0,0 +1,704 @@
+#if defined(__unix__) || defined(__APPLE__)
+/* Sockets, sigaction, setenv and fchdir are POSIX, not C17. */
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "server.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../api/version.h"
+
+#ifdef VITTE_SERVER_HAVE_SOCKETS
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define VITTE_SERVER_RECEIVE_TIMEOUT_SECONDS 10
+
+/*
+ * Wire format, client to server: a 4-byte payload length sent together with
+ * the client's stdout and stderr (SCM_RIGHTS), then the payload as
+ * NUL-terminated strings: protocol line, working directory, variable count,
+ * variables, argument count, arguments. The server answers with the 4-byte
+ * exit code; closing without an answer tells the client to compile locally.
+ */
+static volatile sig_atomic_t vitte_server_stop_requested;
+
+static void vitte_server_on_signal(int signal_number) {
+    (void)signal_number;
+    vitte_server_stop_requested = 1;
+}
+#endif
+
+static void vitte_server_set_error(
+    vitte_server_t *server,
+    vitte_status_t status,
+    const char *code,
+    const char *message,
+    const char *details
+) {
+    if (server != NULL) {
+        vitte_error_set_details(&server->last_error, status, code, message, details);
+    }
+}
+
+bool vitte_server_is_supported(void) {
+#ifdef VITTE_SERVER_HAVE_SOCKETS
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool vitte_server_default_socket_path(char *buffer, size_t capacity) {
+    const char *configured = getenv("VITTE_SERVER_SOCKET");
+    const char *runtime_directory = getenv("XDG_RUNTIME_DIR");
+    int written;
+
+    if (buffer == NULL || capacity == 0u) {
+        return false;
+    }
+    if (configured != NULL && configured[0] != '\0') {
+        written = snprintf(buffer, capacity, "%s", configured);
+    } else if (runtime_directory != NULL && runtime_directory[0] != '\0') {
+        written = snprintf(buffer, capacity, "%s/vitte-bootstrap.sock", runtime_directory);
+    } else {
+#ifdef VITTE_SERVER_HAVE_SOCKETS
+        written = snprintf(buffer, capacity, "/tmp/vitte-bootstrap-%lu.sock", (unsigned long)getuid());
+#else
+        written = snprintf(buffer, capacity, "vitte-bootstrap.sock");
+#endif
+    }
+    return written > 0 && (size_t)written < capacity;
+}
+
+const vitte_error_t *vitte_server_last_error(const vitte_server_t *server) {
+    return server != NULL ? &server->last_error : vitte_error_last();
+}
+
+#ifdef VITTE_SERVER_HAVE_SOCKETS
+/* The build id makes a server from any other compiler binary refuse the request. */
+static void vitte_server_protocol_line(char *buffer, size_t capacity) {
+    (void)snprintf(
+        buffer,
+        capacity,
+        "vitte-serve %u %s %s",
+        (unsigned)VITTE_SERVER_PROTOCOL_VERSION,
+        vitte_version_string(),
+        vitte_build_id()
+    );
+}
+
+static bool vitte_server_socket_address(const char *path, struct sockaddr_un *address) {
+    size_t length = strlen(path);
+
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    if (length == 0u || length >= sizeof(address->sun_path)) {
+        return false;
+    }
+    memcpy(address->sun_path, path, length + 1u);
+    return true;
+}
+
+static bool vitte_server_write_all(int fd, const void *data, size_t size) {
+    const char *cursor = (const char *)data;
+
+    while (size > 0u) {
+        ssize_t written = write(fd, cursor, size);
+
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        cursor += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+static bool vitte_server_read_all(int fd, void *data, size_t size) {
+    char *cursor = (char *)data;
+
+    while (size > 0u) {
+        ssize_t got = read(fd, cursor, size);
+
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            return false;
+        }
+        cursor += got;
+        size -= (size_t)got;
+    }
+    return true;
+}
+
+/*
+ * A peer that goes away mid-request must not kill this process. SIGPIPE is
+ * blocked on the calling thread, and on any worker it starts meanwhile,
+ * instead of ignored process-wide. A SIGPIPE raised while blocked is
+ * consumed before the old mask comes back, so it is never delivered late.
+ */
+static void vitte_server_block_sigpipe(sigset_t *previous) {
+    sigset_t pipe_set;
+
+    sigemptyset(&pipe_set);
+    sigaddset(&pipe_set, SIGPIPE);
+    (void)pthread_sigmask(SIG_BLOCK, &pipe_set, previous);
+}
+
+static void vitte_server_discard_sigpipe(void) {
+    sigset_t pipe_set;
+    sigset_t pending;
+    int signal_number;
+
+    sigemptyset(&pipe_set);
+    sigaddset(&pipe_set, SIGPIPE);
+    while (sigpending(&pending) == 0 && sigismember(&pending, SIGPIPE) == 1) {
+        (void)sigwait(&pipe_set, &signal_number);
+    }
+}
+
+static void vitte_server_restore_sigpipe(const sigset_t *previous) {
+    if (sigismember(previous, SIGPIPE) != 1) {
+        vitte_server_discard_sigpipe();
+    }
+    (void)pthread_sigmask(SIG_SETMASK, previous, NULL);
+}
+
+static void vitte_server_set_cloexec(int fd) {
+    int flags = fcntl(fd, F_GETFD);
+
+    if (flags >= 0) {
+        (void)fcntl(fd, F_SETFD, flags | FD_CLOEXEC);
+    }
+}
+#endif
+
+vitte_status_t vitte_server_init(vitte_server_t *server, const char *socket_path) {
+#ifdef VITTE_SERVER_HAVE_SOCKETS
+    struct sockaddr_un address;
+    struct stat info;
+    mode_t previous_mask;
+    int probe;
+    int written;
+
+    if (server == NULL || socket_path == NULL || socket_path[0] == '\0') {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+    vitte_error_init(&server->last_error);
+
+    /* Requests change the working directory, so the socket is removed by absolute path. */
+    if (socket_path[0] == '/') {
+        written = snprintf(server->socket_path, sizeof(server->socket_path), "%s", socket_path);
+    } else {
+        char directory[VITTE_SERVER_MAX_SOCKET_PATH];
+
+        if (getcwd(directory, sizeof(directory)) == NULL) {
+            directory[0] = '\0';
+        }
+        written = directory[0] != '\0' ?
+            snprintf(server->socket_path, sizeof(server->socket_path), "%s/%s", directory, socket_path) :
+            -1;
+    }
+    if (written <= 0 || (size_t)written >= sizeof(server->socket_path) ||
+        !vitte_server_socket_address(server->socket_path, &address)) {
+        vitte_server_set_error(server, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_SERVER_E_PATH", "socket path is too long", socket_path);
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (lstat(server->socket_path, &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            vitte_server_set_error(server, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_SERVER_E_PATH", "socket path exists and is not a socket", server->socket_path);
+            return VITTE_STATUS_ERROR_INVALID_STATE;
+        }
+        probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (probe >= 0 && connect(probe, (const struct sockaddr *)&address, sizeof(address)) == 0) {
+            close(probe);
+            vitte_server_set_error(server, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_SERVER_E_RUNNING", "a compile server is already listening", server->socket_path);
+            return VITTE_STATUS_ERROR_INVALID_STATE;
+        }
+        if (probe >= 0) {
+            close(probe);
+        }
+        (void)unlink(server->socket_path);
+    }
+
+    server->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server->listen_fd < 0) {
+        vitte_server_set_error(server, VITTE_STATUS_ERROR_IO, "VITTE_SERVER_E_SOCKET", "failed to create socket", strerror(errno));
+        return VITTE_STATUS_ERROR_IO;
+    }
+    vitte_server_set_cloexec(server->listen_fd);
+    previous_mask = umask(0177);
+    if (bind(server->listen_fd, (const struct sockaddr *)&address, sizeof(address)) != 0) {
+        umask(previous_mask);
+        vitte_server_set_error(server, VITTE_STATUS_ERROR_IO, "VITTE_SERVER_E_SOCKET", "failed to bind socket", server->socket_path);
+        close(server->listen_fd);
+        server->listen_fd = -1;
+        return VITTE_STATUS_ERROR_IO;
+    }
+    umask(previous_mask);
+    if (listen(server->listen_fd, 16) != 0) {
+        vitte_server_set_error(server, VITTE_STATUS_ERROR_IO, "VITTE_SERVER_E_SOCKET", "failed to listen on socket", server->socket_path);
+        close(server->listen_fd);
+        server->listen_fd = -1;
+        (void)unlink(server->socket_path);
+        return VITTE_STATUS_ERROR_IO;
+    }
+    server->initialized = true;
+    return VITTE_STATUS_OK;
+#else
+    if (server == NULL || socket_path == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+    vitte_error_init(&server->last_error);
+    vitte_server_set_error(server, VITTE_STATUS_ERROR_UNSUPPORTED, "VITTE_SERVER_E_UNSUPPORTED", "compile server needs Unix domain sockets", NULL);
+    return VITTE_STATUS_ERROR_UNSUPPORTED;
+#endif
+}
+
+void vitte_server_destroy(vitte_server_t *server) {
+    if (server == NULL) {
+        return;
+    }
+#ifdef VITTE_SERVER_HAVE_SOCKETS
+    if (server->listen_fd >= 0) {
+        close(server->listen_fd);
+        (void)unlink(server->socket_path);
+    }
+#endif
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+}
+
+#ifdef VITTE_SERVER_HAVE_SOCKETS
+/* Receives the length header with the client's two descriptors, then the payload. */
+static bool vitte_server_receive(int client, char **payload, size_t *size, int descriptors[2]) {
+    union {
+        struct cmsghdr header;
+        char space[CMSG_SPACE(2u * sizeof(int))];
+    } control;
+    struct cmsghdr *message_header;
+    struct msghdr message;
+    struct iovec vector;
+    uint32_t length;
+    ssize_t got;
+
+    memset(&message, 0, sizeof(message));
+    memset(&control, 0, sizeof(control));
+    vector.iov_base = &length;
+    vector.iov_len = sizeof(length);
+    message.msg_iov = &vector;
+    message.msg_iovlen = 1;
+    message.msg_control = control.space;
+    message.msg_controllen = sizeof(control.space);
+    do {
+        got = recvmsg(client, &message, 0);
+    } while (got < 0 && errno == EINTR);
+
+    message_header = got > 0 ? CMSG_FIRSTHDR(&message) : NULL;
+    if (message_header == NULL || message_header->cmsg_level != SOL_SOCKET || message_header->cmsg_type != SCM_RIGHTS ||
+        message_header->cmsg_len != CMSG_LEN(2u * sizeof(int))) {
+        return false;
+    }
+    memcpy(descriptors, CMSG_DATA(message_header), 2u * sizeof(int));
+    vitte_server_set_cloexec(descriptors[0]);
+    vitte_server_set_cloexec(descriptors[1]);
+    if ((size_t)got != sizeof(length) && !vitte_server_read_all(client, (char *)&length + got, sizeof(length) - (size_t)got)) {
+        return false;
+    }
+    if (length == 0u || length > VITTE_SERVER_MAX_REQUEST_BYTES) {
+        return false;
+    }
+    *payload = (char *)malloc(length);
+    if (*payload == NULL || !vitte_server_read_all(client, *payload, length) || (*payload)[length - 1u] != '\0') {
+        return false;
+    }
+    *size = length;
+    return true;
+}
+
+static bool vitte_server_next_string(char **cursor, const char *end, char **text) {
+    if (*cursor >= end) {
+        return false;
+    }
+    *text = *cursor;
+    *cursor += strlen(*cursor) + 1u;
+    return true;
+}
+
+static bool vitte_server_next_count(char **cursor, const char *end, size_t *count) {
+    char *text;
+    char *digits_end = NULL;
+    unsigned long value;
+
+    if (!vitte_server_next_string(cursor, end, &text)) {
+        return false;
+    }
+    value = strtoul(text, &digits_end, 10);
+    if (digits_end == text || *digits_end != '\0' || value > VITTE_SERVER_MAX_ARGUMENTS) {
+        return false;
+    }
+    *count = (size_t)value;
+    return true;
+}
+
+static bool vitte_server_parse_request(char *payload, size_t size, vitte_server_request_t *request) {
+    char expected[128];
+    char *cursor = payload;
+    const char *end = payload + size;
+    char *text;
+    size_t index;
+
+    memset(request, 0, sizeof(*request));
+    vitte_server_protocol_line(expected, sizeof(expected));
+    if (!vitte_server_next_string(&cursor, end, &text) || strcmp(text, expected) != 0 ||
+        !vitte_server_next_string(&cursor, end, &text) || text[0] != '/') {
+        return false;
+    }
+    request->working_directory = text;
+    if (!vitte_server_next_count(&cursor, end, &request->env_count)) {
+        return false;
+    }
+    for (index = 0u; index < request->env_count; index++) {
+        if (!vitte_server_next_string(&cursor, end, &text) || text[0] == '\0' || text[0] == '=') {
+            return false;
+        }
+        request->env[index] = text;
+    }
+    if (!vitte_server_next_count(&cursor, end, &request->argc)) {
+        return false;
+    }
+    for (index = 0u; index < request->argc; index++) {
+        if (!vitte_server_next_string(&cursor, end, &request->argv[index])) {
+            return false;
+        }
+    }
+    request->argv[request->argc] = NULL;
+    return cursor == end;
+}
+
+static void vitte_server_apply_env(const vitte_server_request_t *request) {
+    size_t index;
+
+    for (index = 0u; index < request->env_count; index++) {
+        const char *entry = request->env[index];
+        const char *separator = strchr(entry, '=');
+        char name[256];
+        size_t length = separator != NULL ? (size_t)(separator - entry) : strlen(entry);
+
+        if (length >= sizeof(name)) {
+            continue;
+        }
+        memcpy(name, entry, length);
+        name[length] = '\0';
+        if (separator != NULL) {
+            (void)setenv(name, separator + 1, 1);
+        } else {
+            (void)unsetenv(name);
+        }
+    }
+}
+
+/*
+ * Runs the handler with the client's working directory, variables and
+ * output streams. Returns false, leaving the server untouched, when the
+ * client's directory cannot be entered.
+ */
+static bool vitte_server_run_request(
+    const vitte_server_request_t *request,
+    const int descriptors[2],
+    vitte_server_handler_fn handler,
+    void *user,
+    int *exit_code
+) {
+    int saved_output;
+    int saved_error;
+
+    if (chdir(request->working_directory) != 0) {
+        return false;
+    }
+    vitte_server_apply_env(request);
+    fflush(stdout);
+    fflush(stderr);
+    saved_output = dup(STDOUT_FILENO);
+    saved_error = dup(STDERR_FILENO);
+    (void)dup2(descriptors[0], STDOUT_FILENO);
+    (void)dup2(descriptors[1], STDERR_FILENO);
+    *exit_code = handler(request, user);
+    fflush(stdout);
+    fflush(stderr);
+    if (saved_output >= 0) {
+        (void)dup2(saved_output, STDOUT_FILENO);
+        close(saved_output);
+    }
+    if (saved_error >= 0) {
+        (void)dup2(saved_error, STDERR_FILENO);
+        close(saved_error);
+    }
+    return true;
+}
+#endif
+
+vitte_status_t vitte_server_serve(vitte_server_t *server, vitte_server_handler_fn handler, void *user) {
+#ifdef VITTE_SERVER_HAVE_SOCKETS
+    struct sigaction action;
+    struct sigaction previous_interrupt;
+    struct sigaction previous_terminate;
+    sigset_t previous_mask;
+    vitte_status_t status = VITTE_STATUS_OK;
+
+    if (server == NULL || !server->initialized || handler == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    /* No SA_RESTART: a signal interrupts accept() so the loop can stop. */
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_handler = vitte_server_on_signal;
+    vitte_server_stop_requested = 0;
+    (void)sigaction(SIGINT, &action, &previous_interrupt);
+    (void)sigaction(SIGTERM, &action, &previous_terminate);
+    vitte_server_block_sigpipe(&previous_mask);
+
+    while (!vitte_server_stop_requested) {
+        vitte_server_request_t request;
+        struct timeval timeout;
+        int descriptors[2] = { -1, -1 };
+        char *payload = NULL;
+        size_t size = 0u;
+        int exit_code = 0;
+        int client = accept(server->listen_fd, NULL, NULL);
+
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            vitte_server_set_error(server, VITTE_STATUS_ERROR_IO, "VITTE_SERVER_E_SOCKET", "failed to accept connection", strerror(errno));
+            status = VITTE_STATUS_ERROR_IO;
+            break;
+        }
+        vitte_server_set_cloexec(client);
+        /* A client that connects and never sends must not stall the queue. */
+        timeout.tv_sec = VITTE_SERVER_RECEIVE_TIMEOUT_SECONDS;
+        timeout.tv_usec = 0;
+        (void)setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        if (vitte_server_receive(client, &payload, &size, descriptors) &&
+            vitte_server_parse_request(payload, size, &request) &&
+            vitte_server_run_request(&request, descriptors, handler, user, &exit_code)) {
+            int32_t answer = (int32_t)exit_code;
+
+            (void)vitte_server_write_all(client, &answer, sizeof(answer));
+            server->request_count++;
+        }
+        free(payload);
+        if (descriptors[0] >= 0) {
+            close(descriptors[0]);
+        }
+        if (descriptors[1] >= 0) {
+            close(descriptors[1]);
+        }
+        close(client);
+        vitte_server_discard_sigpipe();
+    }
+
+    (void)sigaction(SIGINT, &previous_interrupt, NULL);
+    (void)sigaction(SIGTERM, &previous_terminate, NULL);
+    vitte_server_restore_sigpipe(&previous_mask);
+    return status;
+#else
+    (void)handler;
+    (void)user;
+    vitte_server_set_error(server, VITTE_STATUS_ERROR_UNSUPPORTED, "VITTE_SERVER_E_UNSUPPORTED", "compile server needs Unix domain sockets", NULL);
+    return VITTE_STATUS_ERROR_UNSUPPORTED;
+#endif
+}
+
+#ifdef VITTE_SERVER_HAVE_SOCKETS
+typedef struct vitte_server_payload {
+    char *data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} vitte_server_payload_t;
+
+static void vitte_server_payload_put(vitte_server_payload_t *payload, const char *text) {
+    size_t length = strlen(text) + 1u;
+
+    if (payload->failed) {
+        return;
+    }
+    if (payload->size + length > payload->capacity) {
+        size_t capacity = payload->capacity == 0u ? 1024u : payload->capacity;
+        char *data;
+
+        while (capacity < payload->size + length) {
+            capacity *= 2u;
+        }
+        data = (char *)realloc(payload->data, capacity);
+        if (data == NULL) {
+            payload->failed = true;
+            return;
+        }
+        payload->data = data;
+        payload->capacity = capacity;
+    }
+    memcpy(payload->data + payload->size, text, length);
+    payload->size += length;
+}
+
+static void vitte_server_payload_put_count(vitte_server_payload_t *payload, size_t count) {
+    char text[32];
+
+    (void)snprintf(text, sizeof(text), "%lu", (unsigned long)count);
+    vitte_server_payload_put(payload, text);
+}
+
+static bool vitte_server_send_request(int fd, const vitte_server_payload_t *payload) {
+    union {
+        struct cmsghdr header;
+        char space[CMSG_SPACE(2u * sizeof(int))];
+    } control;
+    const int descriptors[2] = { STDOUT_FILENO, STDERR_FILENO };
+    struct cmsghdr *message_header;
+    struct msghdr message;
+    struct iovec vector;
+    uint32_t length = (uint32_t)payload->size;
+    ssize_t sent;
+
+    memset(&message, 0, sizeof(message));
+    memset(&control, 0, sizeof(control));
+    vector.iov_base = &length;
+    vector.iov_len = sizeof(length);
+    message.msg_iov = &vector;
+    message.msg_iovlen = 1;
+    message.msg_control = control.space;
+    message.msg_controllen = sizeof(control.space);
+    message_header = CMSG_FIRSTHDR(&message);
+    message_header->cmsg_level = SOL_SOCKET;
+    message_header->cmsg_type = SCM_RIGHTS;
+    message_header->cmsg_len = CMSG_LEN(sizeof(descriptors));
+    memcpy(CMSG_DATA(message_header), descriptors, sizeof(descriptors));
+    do {
+        sent = sendmsg(fd, &message, 0);
+    } while (sent < 0 && errno == EINTR);
+    if (sent <= 0) {
+        return false;
+    }
+    if ((size_t)sent != sizeof(length) &&
+        !vitte_server_write_all(fd, (const char *)&length + sent, sizeof(length) - (size_t)sent)) {
+        return false;
+    }
+    return vitte_server_write_all(fd, payload->data, payload->size);
+}
+#endif
+
+bool vitte_server_forward(
+    const char *socket_path,
+    int argc,
+    char **argv,
+    const char *const *env_names,
+    size_t env_name_count,
+    int *exit_code
+) {
+#ifdef VITTE_SERVER_HAVE_SOCKETS
+    vitte_server_payload_t payload;
+    struct sockaddr_un address;
+    struct stat info;
+    sigset_t previous_mask;
+    char line[128];
+    char directory[4096];
+    int32_t answer;
+    int index;
+    size_t env_index;
+    int fd;
+    bool answered;
+
+    if (socket_path == NULL || argc < 0 || (size_t)argc > VITTE_SERVER_MAX_ARGUMENTS ||
+        env_name_count > VITTE_SERVER_MAX_ARGUMENTS || exit_code == NULL ||
+        !vitte_server_socket_address(socket_path, &address)) {
+        return false;
+    }
+    /* Only a socket owned by this user may receive our output streams. */
+    if (lstat(socket_path, &info) != 0 || !S_ISSOCK(info.st_mode) || info.st_uid != getuid() ||
+        getcwd(directory, sizeof(directory)) == NULL) {
+        return false;
+    }
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    if (connect(fd, (const struct sockaddr *)&address, sizeof(address)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    memset(&payload, 0, sizeof(payload));
+    vitte_server_protocol_line(line, sizeof(line));
+    vitte_server_payload_put(&payload, line);
+    vitte_server_payload_put(&payload, directory);
+    vitte_server_payload_put_count(&payload, env_name_count);
+    for (env_index = 0u; env_index < env_name_count; env_index++) {
+        const char *value = getenv(env_names[env_index]);
+
+        if (value != NULL) {
+            char *entry = (char *)malloc(strlen(env_names[env_index]) + strlen(value) + 2u);
+
+            if (entry == NULL) {
+                payload.failed = true;
+                break;
+            }
+            (void)sprintf(entry, "%s=%s", env_names[env_index], value);
+            vitte_server_payload_put(&payload, entry);
+            free(entry);
+        } else {
+            vitte_server_payload_put(&payload, env_names[env_index]);
+        }
+    }
+    vitte_server_payload_put_count(&payload, (size_t)argc);
+    for (index = 0; index < argc; index++) {
+        vitte_server_payload_put(&payload, argv[index]);
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+    /* A server that rejects the request may close before reading all of it. */
+    vitte_server_block_sigpipe(&previous_mask);
+    answered = !payload.failed && payload.size <= VITTE_SERVER_MAX_REQUEST_BYTES &&
+        vitte_server_send_request(fd, &payload) &&
+        vitte_server_read_all(fd, &answer, sizeof(answer));
+    vitte_server_restore_sigpipe(&previous_mask);
+    free(payload.data);
+    close(fd);
+    if (answered) {
+        *exit_code = (int)answer;
+    }
+    return answered;
+#else
+    (void)socket_path;
+    (void)argc;
+    (void)argv;
+    (void)env_names;
+    (void)env_name_count;
+    (void)exit_code;
+    return false;
+#endif
+}
@@ -0,0 +1,94 @@
+#ifndef VITTE_BOOTSTRAP_SERVER_H
+#define VITTE_BOOTSTRAP_SERVER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "../api/error.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define VITTE_SERVER_HAVE_SOCKETS 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VITTE_SERVER_PROTOCOL_VERSION 1u
+#define VITTE_SERVER_MAX_SOCKET_PATH ((size_t)104u)
+#define VITTE_SERVER_MAX_REQUEST_BYTES ((size_t)1024u * 1024u)
+#define VITTE_SERVER_MAX_ARGUMENTS ((size_t)256u)
+
+/*
+ * One forwarded command line. `env` holds `NAME=VALUE` entries for variables
+ * the client has set and bare `NAME` entries for those it has not; the
+ * server applies both before calling the handler. All strings point into the
+ * request buffer and live until the handler returns.
+ */
+typedef struct vitte_server_request {
+    const char *working_directory;
+    char *argv[VITTE_SERVER_MAX_ARGUMENTS + 1u];
+    size_t argc;
+    const char *env[VITTE_SERVER_MAX_ARGUMENTS];
+    size_t env_count;
+} vitte_server_request_t;
+
+/*
+ * Runs one request inside the server process, with stdout and stderr
+ * redirected to the client's and the working directory set to the client's.
+ * Returns the exit code handed back to the client.
+ */
+typedef int (*vitte_server_handler_fn)(const vitte_server_request_t *request, void *user);
+
+typedef struct vitte_server {
+    bool initialized;
+    char socket_path[VITTE_SERVER_MAX_SOCKET_PATH];
+    int listen_fd;
+    size_t request_count;
+    vitte_error_t last_error;
+} vitte_server_t;
+
+bool vitte_server_is_supported(void);
+
+/*
+ * `VITTE_SERVER_SOCKET`, else `$XDG_RUNTIME_DIR/vitte-bootstrap.sock`, else
+ * `/tmp/vitte-bootstrap-<uid>.sock`. Returns false when the path does not fit.
+ */
+bool vitte_server_default_socket_path(char *buffer, size_t capacity);
+
+/*
+ * Binds and listens on `socket_path`, readable by the current user only. A
+ * stale socket left by a dead server is replaced; a live one is an error.
+ */
+vitte_status_t vitte_server_init(vitte_server_t *server, const char *socket_path);
+/* Stops listening and removes the socket. */
+void vitte_server_destroy(vitte_server_t *server);
+const vitte_error_t *vitte_server_last_error(const vitte_server_t *server);
+
+/*
+ * Accepts and handles connections one at a time until SIGINT or SIGTERM.
+ * Malformed requests and requests from another compiler version are closed
+ * without an answer, which makes their client compile locally.
+ */
+vitte_status_t vitte_server_serve(vitte_server_t *server, vitte_server_handler_fn handler, void *user);
+
+/*
+ * Sends `argv` (without the program name), the working directory, the
+ * variables named in `env_names` and this process's stdout/stderr to the
+ * server on `socket_path` and waits for its exit code. Returns false when no
+ * server owned by the current user answered, so the caller compiles locally.
+ */
+bool vitte_server_forward(
+    const char *socket_path,
+    int argc,
+    char **argv,
+    const char *const *env_names,
+    size_t env_name_count,
+    int *exit_code
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VITTE_BOOTSTRAP_SERVER_H */
@@ -1,7 +1,11 @@
 #include "symbol.h"
 
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "../util/util.h"
+
 static void vitte_symbol_set_error(
     vitte_symbol_table_t *table,
     vitte_status_t status,
@@ -24,12 +28,37 @@ void vitte_symbol_table_init(vitte_symbol_table_t *table) {
 }
 
 void vitte_symbol_table_destroy(vitte_symbol_table_t *table) {
+    size_t index;
+
     if (table == NULL) {
         return;
     }
+    for (index = 0u; index < table->block_count; index++) {
+        free(table->blocks[index]);
+    }
+    free(table->blocks);
+    free(table->index);
+    if (vitte_arena_is_initialized(&table->parameter_arena)) {
+        vitte_arena_destroy(&table->parameter_arena);
+    }
     memset(table, 0, sizeof(*table));
 }
 
+void vitte_symbol_table_reset(vitte_symbol_table_t *table) {
+    if (!vitte_symbol_table_is_initialized(table)) {
+        return;
+    }
+    table->count = 0u;
+    table->index_count = 0u;
+    if (table->index != NULL) {
+        memset(table->index, 0, table->index_capacity * sizeof(*table->index));
+    }
+    if (vitte_arena_is_initialized(&table->parameter_arena)) {
+        vitte_arena_reset(&table->parameter_arena);
+    }
+    vitte_error_reset(&table->last_error);
+}
+
 bool vitte_symbol_table_is_initialized(const vitte_symbol_table_t *table) {
     return table != NULL && table->initialized;
 }
@@ -48,23 +77,101 @@ size_t vitte_symbol_count(const vitte_symbol_table_t *table) {
     return vitte_symbol_table_is_initialized(table) ? table->count : 0u;
 }
 
-const vitte_symbol_t *vitte_symbol_at(const vitte_symbol_table_t *table, size_t index) {
-    return vitte_symbol_table_is_initialized(table) && index < table->count ? &table->entries[index] : NULL;
+static vitte_symbol_t *vitte_symbol_entry(const vitte_symbol_table_t *table, size_t index) {
+    return &table->blocks[index / VITTE_SYMBOL_BLOCK_ENTRIES][index % VITTE_SYMBOL_BLOCK_ENTRIES];
 }
 
-const vitte_symbol_t *vitte_symbol_lookup(const vitte_symbol_table_t *table, const char *name) {
+static size_t vitte_symbol_hash_name(const char *name) {
+    return (size_t)vitte_util_hash_text(VITTE_UTIL_HASH_SEED, name);
+}
+
+/* Returns the slot holding `name`, or the empty slot where it would be inserted. */
+static vitte_symbol_index_slot_t *vitte_symbol_index_probe(
+    const vitte_symbol_table_t *table,
+    const char *name,
+    size_t hash
+) {
+    size_t mask = table->index_capacity - 1u;
+    size_t position = hash & mask;
+
+    for (;;) {
+        vitte_symbol_index_slot_t *slot = &table->index[position];
+        if (slot->entry == 0u) {
+            return slot;
+        }
+        if (slot->hash == hash) {
+            const char *entry_name = vitte_symbol_entry(table, slot->entry - 1u)->name;
+            if (entry_name == name || strcmp(entry_name, name) == 0) {
+                return slot;
+            }
+        }
+        position = (position + 1u) & mask;
+    }
+}
+
+static bool vitte_symbol_index_grow(vitte_symbol_table_t *table) {
+    vitte_symbol_index_slot_t *old_index = table->index;
+    size_t old_capacity = table->index_capacity;
+    size_t capacity = old_capacity == 0u ? VITTE_SYMBOL_INITIAL_INDEX_CAPACITY : old_capacity * 2u;
     size_t index;
 
-    if (!vitte_symbol_table_is_initialized(table) || name == NULL || name[0] == '\0') {
-        return NULL;
+    if (capacity < old_capacity || capacity > SIZE_MAX / sizeof(*old_index)) {
+        return false;
+    }
+    table->index = (vitte_symbol_index_slot_t *)calloc(capacity, sizeof(*table->index));
+    if (table->index == NULL) {
+        table->index = old_index;
+        return false;
+    }
+    table->index_capacity = capacity;
+    for (index = 0u; index < old_capacity; index++) {
+        if (old_index[index].entry != 0u) {
+            size_t position = old_index[index].hash & (capacity - 1u);
+            while (table->index[position].entry != 0u) {
+                position = (position + 1u) & (capacity - 1u);
+            }
+            table->index[position] = old_index[index];
+        }
     }
-    for (index = table->count; index > 0u; index--) {
-        const vitte_symbol_t *symbol = &table->entries[index - 1u];
-        if (symbol->initialized && symbol->name != NULL && strcmp(symbol->name, name) == 0) {
-            return symbol;
+    free(old_index);
+    return true;
+}
+
+static vitte_symbol_t *vitte_symbol_reserve_entry(vitte_symbol_table_t *table) {
+    size_t block_index = table->count / VITTE_SYMBOL_BLOCK_ENTRIES;
+
+    if (block_index == table->block_count) {
+        vitte_symbol_t *block;
+        if (table->block_count == table->block_capacity) {
+            size_t capacity = table->block_capacity == 0u ? 8u : table->block_capacity * 2u;
+            vitte_symbol_t **blocks = (vitte_symbol_t **)realloc(table->blocks, capacity * sizeof(*blocks));
+            if (blocks == NULL) {
+                return NULL;
+            }
+            table->blocks = blocks;
+            table->block_capacity = capacity;
+        }
+        block = (vitte_symbol_t *)malloc(VITTE_SYMBOL_BLOCK_ENTRIES * sizeof(*block));
+        if (block == NULL) {
+            return NULL;
         }
+        table->blocks[table->block_count++] = block;
+    }
+    return vitte_symbol_entry(table, table->count);
+}
+
+const vitte_symbol_t *vitte_symbol_at(const vitte_symbol_table_t *table, size_t index) {
+    return vitte_symbol_table_is_initialized(table) && index < table->count ? vitte_symbol_entry(table, index) : NULL;
+}
+
+const vitte_symbol_t *vitte_symbol_lookup(const vitte_symbol_table_t *table, const char *name) {
+    const vitte_symbol_index_slot_t *slot;
+
+    if (!vitte_symbol_table_is_initialized(table) || name == NULL || name[0] == '\0' || table->index_count == 0u) {
+        return NULL;
     }
-    return NULL;
+    slot = vitte_symbol_index_probe(table, name, vitte_symbol_hash_name(name));
+    return slot->entry != 0u ? vitte_symbol_entry(table, slot->entry - 1u) : NULL;
 }
 
 static vitte_status_t vitte_symbol_append(
@@ -73,20 +180,33 @@ static vitte_status_t vitte_symbol_append(
     const vitte_symbol_t **out_symbol
 ) {
     vitte_symbol_t *stored;
+    vitte_symbol_index_slot_t *slot;
+    size_t hash;
 
-    if (!vitte_symbol_table_is_initialized(table) || symbol == NULL) {
+    if (!vitte_symbol_table_is_initialized(table) || symbol == NULL || symbol->name == NULL) {
         vitte_symbol_set_error(table, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_SYMBOL_E_ARGUMENT", "invalid symbol append", NULL);
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
-    if (table->count >= VITTE_SYMBOL_MAX_ENTRIES) {
-        vitte_symbol_set_error(table, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_SYMBOL_E_LIMIT", "symbol table is full", symbol->name);
-        return VITTE_STATUS_ERROR_INVALID_STATE;
+    if ((table->index_count + 1u) * 2u > table->index_capacity && !vitte_symbol_index_grow(table)) {
+        vitte_symbol_set_error(table, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_SYMBOL_E_MEMORY", "cannot grow symbol index", symbol->name);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+    stored = vitte_symbol_reserve_entry(table);
+    if (stored == NULL) {
+        vitte_symbol_set_error(table, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_SYMBOL_E_MEMORY", "cannot grow symbol table", symbol->name);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
     }
-    table->entries[table->count] = *symbol;
-    stored = &table->entries[table->count];
+    *stored = *symbol;
     if (symbol->type == &symbol->owned_type) {
         stored->type = &stored->owned_type;
     }
+    hash = vitte_symbol_hash_name(symbol->name);
+    slot = vitte_symbol_index_probe(table, symbol->name, hash);
+    if (slot->entry == 0u) {
+        slot->hash = hash;
+        table->index_count++;
+    }
+    slot->entry = table->count + 1u;
     if (out_symbol != NULL) {
         *out_symbol = stored;
     }
@@ -120,6 +240,33 @@ vitte_status_t vitte_symbol_define(
     return vitte_symbol_append(table, &symbol, out_symbol);
 }
 
+/* Copies a procedure parameter list into table-owned storage. */
+static const vitte_type_t *const *vitte_symbol_copy_parameters(
+    vitte_symbol_table_t *table,
+    const vitte_type_t *const *parameter_types,
+    size_t arity
+) {
+    const vitte_type_t **copy;
+
+    if (parameter_types == NULL || arity == 0u) {
+        return NULL;
+    }
+    if (!vitte_arena_is_initialized(&table->parameter_arena)) {
+        vitte_arena_config_t config;
+
+        vitte_arena_config_init(&config);
+        config.initial_block_size = VITTE_SYMBOL_PARAMETER_BLOCK_SIZE;
+        if (vitte_arena_init(&table->parameter_arena, &config) != VITTE_STATUS_OK) {
+            return NULL;
+        }
+    }
+    copy = (const vitte_type_t **)vitte_arena_alloc(&table->parameter_arena, arity * sizeof(*copy), VITTE_ARENA_DEFAULT_ALIGNMENT);
+    if (copy != NULL) {
+        (void)memcpy(copy, parameter_types, arity * sizeof(*copy));
+    }
+    return copy;
+}
+
 vitte_status_t vitte_symbol_define_proc(
     vitte_symbol_table_t *table,
     const char *name,
@@ -131,18 +278,24 @@ vitte_status_t vitte_symbol_define_proc(
     const vitte_symbol_t **out_symbol
 ) {
     vitte_symbol_t symbol;
+    const vitte_type_t *const *parameters;
 
     if (!vitte_symbol_table_is_initialized(table) || name == NULL || name[0] == '\0' ||
         !vitte_type_is_valid(return_type) || arity > VITTE_TYPE_MAX_PROC_PARAMETERS) {
         vitte_symbol_set_error(table, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_SYMBOL_E_PROC", "invalid procedure symbol definition", name);
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
     }
+    parameters = vitte_symbol_copy_parameters(table, parameter_types, arity);
+    if (parameters == NULL && parameter_types != NULL && arity > 0u) {
+        vitte_symbol_set_error(table, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_SYMBOL_E_MEMORY", "cannot store procedure parameters", name);
+        return VITTE_STATUS_ERROR_OUT_OF_MEMORY;
+    }
     memset(&symbol, 0, sizeof(symbol));
     symbol.kind = VITTE_SYMBOL_KIND_PROC;
     symbol.name = name;
     symbol.declaration = declaration;
     symbol.initialized = true;
-    vitte_type_init_proc(&symbol.owned_type, name, return_type, parameter_types, arity, variadic);
+    vitte_type_init_proc(&symbol.owned_type, name, return_type, parameters, arity, variadic);
     symbol.type = &symbol.owned_type;
     return vitte_symbol_append(table, &symbol, out_symbol);
 }
@@ -176,7 +329,6 @@ vitte_status_t vitte_symbol_define_builtin_function(
     const vitte_symbol_t **out_symbol
 ) {
     vitte_symbol_t symbol;
-    const vitte_type_t *parameter_types[1];
 
     if (!vitte_symbol_table_is_initialized(table) || builtin_function == NULL || !vitte_type_is_valid(return_type)) {
         vitte_symbol_set_error(table, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_SYMBOL_E_BUILTIN", "invalid builtin function symbol definition", NULL);
@@ -188,12 +340,11 @@ vitte_status_t vitte_symbol_define_builtin_function(
     symbol.builtin_function = builtin_function;
     symbol.builtin = true;
     symbol.initialized = true;
-    parameter_types[0] = NULL;
     vitte_type_init_proc(
         &symbol.owned_type,
         builtin_function->name,
         return_type,
-        parameter_types,
+        NULL,
         builtin_function->max_arity,
         builtin_function->variadic
     );
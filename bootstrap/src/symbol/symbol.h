@@ -13,7 +13,9 @@
 extern "C" {
 #endif
 
-#define VITTE_SYMBOL_MAX_ENTRIES ((size_t)65536u)
+#define VITTE_SYMBOL_BLOCK_ENTRIES ((size_t)128u)
+#define VITTE_SYMBOL_INITIAL_INDEX_CAPACITY ((size_t)64u)
+#define VITTE_SYMBOL_PARAMETER_BLOCK_SIZE ((size_t)4096u)
 
 typedef enum vitte_symbol_kind {
     VITTE_SYMBOL_KIND_UNKNOWN = 0,
@@ -38,15 +40,27 @@ typedef struct vitte_symbol {
     bool initialized;
 } vitte_symbol_t;
 
+typedef struct vitte_symbol_index_slot {
+    size_t hash;
+    size_t entry;
+} vitte_symbol_index_slot_t;
+
 typedef struct vitte_symbol_table {
     bool initialized;
-    vitte_symbol_t entries[VITTE_SYMBOL_MAX_ENTRIES];
+    vitte_symbol_t **blocks;
+    size_t block_count;
+    size_t block_capacity;
     size_t count;
+    vitte_symbol_index_slot_t *index;
+    size_t index_capacity;
+    size_t index_count;
+    vitte_arena_t parameter_arena;
     vitte_error_t last_error;
 } vitte_symbol_table_t;
 
 void vitte_symbol_table_init(vitte_symbol_table_t *table);
 void vitte_symbol_table_destroy(vitte_symbol_table_t *table);
+void vitte_symbol_table_reset(vitte_symbol_table_t *table);
 bool vitte_symbol_table_is_initialized(const vitte_symbol_table_t *table);
 const vitte_error_t *vitte_symbol_table_last_error(const vitte_symbol_table_t *table);
 void vitte_symbol_table_clear_error(vitte_symbol_table_t *table);
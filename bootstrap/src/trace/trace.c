@@ -0,0 +1,264 @@
+#if defined(__unix__) || defined(__APPLE__)
+/* clock_gettime and its CPU clocks are POSIX, not C17. */
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "trace.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* The trace that assigned this thread its id, and that id. */
+static _Thread_local const vitte_trace_t *vitte_trace_thread_owner;
+static _Thread_local unsigned vitte_trace_thread_id;
+
+static void vitte_trace_set_error(
+    vitte_trace_t *trace,
+    vitte_status_t status,
+    const char *code,
+    const char *message,
+    const char *details
+) {
+    if (trace != NULL) {
+        vitte_error_set_details(&trace->last_error, status, code, message, details);
+    }
+}
+
+void vitte_trace_clock_now(vitte_trace_clock_t *clock) {
+    struct timespec now;
+
+    if (clock == NULL) {
+        return;
+    }
+    clock->wall_ns = 0u;
+    clock->cpu_ns = 0u;
+#if defined(CLOCK_MONOTONIC)
+    if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+        clock->wall_ns = (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+    }
+#else
+    if (timespec_get(&now, TIME_UTC) == TIME_UTC) {
+        clock->wall_ns = (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+    }
+#endif
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0) {
+        clock->cpu_ns = (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+    }
+#else
+    /* Process CPU time: only meaningful while a single thread is busy. */
+    clock->cpu_ns = (uint64_t)((double)clock() * (1e9 / (double)CLOCKS_PER_SEC));
+#endif
+}
+
+vitte_status_t vitte_trace_init(vitte_trace_t *trace) {
+    vitte_trace_clock_t origin;
+    vitte_status_t status;
+
+    if (trace == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    memset(trace, 0, sizeof(*trace));
+    vitte_error_init(&trace->last_error);
+    status = vitte_parallel_mutex_init(&trace->lock);
+    if (status != VITTE_STATUS_OK) {
+        vitte_trace_set_error(trace, status, "VITTE_TRACE_E_LOCK", "failed to initialize trace lock", NULL);
+        return status;
+    }
+    vitte_trace_clock_now(&origin);
+    trace->origin_ns = origin.wall_ns;
+    trace->initialized = true;
+    return VITTE_STATUS_OK;
+}
+
+void vitte_trace_destroy(vitte_trace_t *trace) {
+    size_t index;
+
+    if (trace == NULL || !trace->initialized) {
+        return;
+    }
+    for (index = 0u; index < trace->count; index++) {
+        free(trace->events[index].detail);
+    }
+    free(trace->events);
+    vitte_parallel_mutex_destroy(&trace->lock);
+    memset(trace, 0, sizeof(*trace));
+}
+
+const vitte_error_t *vitte_trace_last_error(const vitte_trace_t *trace) {
+    return trace != NULL ? &trace->last_error : vitte_error_last();
+}
+
+void vitte_trace_record(
+    vitte_trace_t *trace,
+    const char *category,
+    const char *name,
+    const char *detail,
+    const vitte_trace_clock_t *start,
+    const vitte_trace_clock_t *end,
+    const vitte_trace_counts_t *counts
+) {
+    vitte_trace_event_t *event;
+    char *copy = NULL;
+
+    if (trace == NULL || !trace->initialized || start == NULL || end == NULL) {
+        return;
+    }
+    if (detail != NULL) {
+        size_t length = strlen(detail);
+
+        copy = (char *)malloc(length + 1u);
+        if (copy == NULL) {
+            return;
+        }
+        memcpy(copy, detail, length + 1u);
+    }
+
+    vitte_parallel_mutex_lock(&trace->lock);
+    if (trace->count == trace->capacity) {
+        size_t capacity = trace->capacity != 0u ? trace->capacity * 2u : 256u;
+        vitte_trace_event_t *grown = (vitte_trace_event_t *)realloc(trace->events, capacity * sizeof(*grown));
+
+        if (grown == NULL) {
+            vitte_parallel_mutex_unlock(&trace->lock);
+            free(copy);
+            return;
+        }
+        trace->events = grown;
+        trace->capacity = capacity;
+    }
+    if (vitte_trace_thread_owner != trace) {
+        vitte_trace_thread_owner = trace;
+        vitte_trace_thread_id = ++trace->thread_count;
+    }
+    event = &trace->events[trace->count++];
+    memset(event, 0, sizeof(*event));
+    event->category = category;
+    event->name = name;
+    event->detail = copy;
+    event->start_ns = start->wall_ns > trace->origin_ns ? start->wall_ns - trace->origin_ns : 0u;
+    event->wall_ns = end->wall_ns > start->wall_ns ? end->wall_ns - start->wall_ns : 0u;
+    event->cpu_ns = end->cpu_ns > start->cpu_ns ? end->cpu_ns - start->cpu_ns : 0u;
+    if (counts != NULL) {
+        event->bytes_in = counts->bytes_in;
+        event->bytes_out = counts->bytes_out;
+        event->arena_bytes = counts->arena_bytes;
+    }
+    event->thread = vitte_trace_thread_id;
+    vitte_parallel_mutex_unlock(&trace->lock);
+}
+
+static void vitte_trace_write_escaped(FILE *file, const char *text) {
+    const unsigned char *cursor;
+
+    for (cursor = (const unsigned char *)text; *cursor != '\0'; cursor++) {
+        if (*cursor == '"' || *cursor == '\\') {
+            fputc('\\', file);
+            fputc(*cursor, file);
+        } else if (*cursor < 0x20u) {
+            fprintf(file, "\\u%04x", (unsigned)*cursor);
+        } else {
+            fputc(*cursor, file);
+        }
+    }
+}
+
+static void vitte_trace_write_string(FILE *file, const char *text) {
+    fputc('"', file);
+    vitte_trace_write_escaped(file, text);
+    fputc('"', file);
+}
+
+/* Parents before children: by thread, then start time, then longest first. */
+static int vitte_trace_compare_events(const void *left, const void *right) {
+    const vitte_trace_event_t *a = (const vitte_trace_event_t *)left;
+    const vitte_trace_event_t *b = (const vitte_trace_event_t *)right;
+
+    if (a->thread != b->thread) {
+        return a->thread < b->thread ? -1 : 1;
+    }
+    if (a->start_ns != b->start_ns) {
+        return a->start_ns < b->start_ns ? -1 : 1;
+    }
+    if (a->wall_ns != b->wall_ns) {
+        return a->wall_ns > b->wall_ns ? -1 : 1;
+    }
+    return 0;
+}
+
+vitte_status_t vitte_trace_write_json(vitte_trace_t *trace, const char *path) {
+    FILE *file;
+    size_t index;
+    unsigned thread;
+    bool failed;
+
+    if (trace == NULL || !trace->initialized || path == NULL) {
+        return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+    file = fopen(path, "w");
+    if (file == NULL) {
+        vitte_trace_set_error(trace, VITTE_STATUS_ERROR_IO, "VITTE_TRACE_E_WRITE", "failed to open trace file", strerror(errno));
+        return VITTE_STATUS_ERROR_IO;
+    }
+
+    vitte_parallel_mutex_lock(&trace->lock);
+    qsort(trace->events, trace->count, sizeof(*trace->events), vitte_trace_compare_events);
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    for (thread = 1u; thread <= trace->thread_count; thread++) {
+        fprintf(
+            file,
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}},\n",
+            thread,
+            thread
+        );
+    }
+    for (index = 0u; index < trace->count; index++) {
+        const vitte_trace_event_t *event = &trace->events[index];
+
+        /* Spans about one module are named after it so timelines stay readable. */
+        fputs("{\"name\":\"", file);
+        vitte_trace_write_escaped(file, event->name);
+        if (event->detail != NULL) {
+            fputc(' ', file);
+            vitte_trace_write_escaped(file, event->detail);
+        }
+        fputc('"', file);
+        fputs(",\"cat\":", file);
+        vitte_trace_write_string(file, event->category);
+        fprintf(
+            file,
+            ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu.%03u,\"dur\":%llu.%03u,\"args\":{",
+            event->thread,
+            (unsigned long long)(event->start_ns / 1000u),
+            (unsigned)(event->start_ns % 1000u),
+            (unsigned long long)(event->wall_ns / 1000u),
+            (unsigned)(event->wall_ns % 1000u)
+        );
+        if (event->detail != NULL) {
+            fputs("\"module\":", file);
+            vitte_trace_write_string(file, event->detail);
+            fputc(',', file);
+        }
+        fprintf(
+            file,
+            "\"cpu_us\":%llu,\"bytes_in\":%llu,\"bytes_out\":%llu,\"arena_bytes\":%llu}}%s\n",
+            (unsigned long long)(event->cpu_ns / 1000u),
+            (unsigned long long)event->bytes_in,
+            (unsigned long long)event->bytes_out,
+            (unsigned long long)event->arena_bytes,
+            index + 1u < trace->count ? "," : ""
+        );
+    }
+    fputs("]}\n", file);
+    vitte_parallel_mutex_unlock(&trace->lock);
+
+    failed = ferror(file) != 0;
+    if (fclose(file) != 0 || failed) {
+        vitte_trace_set_error(trace, VITTE_STATUS_ERROR_IO, "VITTE_TRACE_E_WRITE", "failed to write trace file", strerror(errno));
+        return VITTE_STATUS_ERROR_IO;
+    }
+    return VITTE_STATUS_OK;
+}
@@ -0,0 +1,91 @@
+#ifndef VITTE_BOOTSTRAP_TRACE_H
+#define VITTE_BOOTSTRAP_TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../api/error.h"
+#include "../parallel/parallel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A point in time: monotonic wall clock and the calling thread's CPU clock. */
+typedef struct vitte_trace_clock {
+    uint64_t wall_ns;
+    uint64_t cpu_ns;
+} vitte_trace_clock_t;
+
+/*
+ * One completed span. `name` and `category` must outlive the trace (string
+ * literals in practice); `detail`, usually a module path, is copied.
+ */
+typedef struct vitte_trace_event {
+    const char *category;
+    const char *name;
+    char *detail;
+    uint64_t start_ns;
+    uint64_t wall_ns;
+    uint64_t cpu_ns;
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    uint64_t arena_bytes;
+    unsigned thread;
+} vitte_trace_event_t;
+
+/* Work measured by a span, reported alongside its timing. */
+typedef struct vitte_trace_counts {
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    uint64_t arena_bytes;
+} vitte_trace_counts_t;
+
+/*
+ * Collects spans from any number of threads. Each recording thread gets a
+ * small stable id, used as the trace-event `tid`, the first time it records.
+ */
+typedef struct vitte_trace {
+    bool initialized;
+    uint64_t origin_ns;
+    vitte_trace_event_t *events;
+    size_t count;
+    size_t capacity;
+    unsigned thread_count;
+    vitte_parallel_mutex_t lock;
+    vitte_error_t last_error;
+} vitte_trace_t;
+
+void vitte_trace_clock_now(vitte_trace_clock_t *clock);
+
+vitte_status_t vitte_trace_init(vitte_trace_t *trace);
+void vitte_trace_destroy(vitte_trace_t *trace);
+const vitte_error_t *vitte_trace_last_error(const vitte_trace_t *trace);
+
+/*
+ * Records the span from `start` to `end`. A NULL trace is a no-op, so
+ * instrumented code does not need to check whether tracing is on. Events
+ * that cannot be stored are dropped.
+ */
+void vitte_trace_record(
+    vitte_trace_t *trace,
+    const char *category,
+    const char *name,
+    const char *detail,
+    const vitte_trace_clock_t *start,
+    const vitte_trace_clock_t *end,
+    const vitte_trace_counts_t *counts
+);
+
+/*
+ * Writes the events as Chrome trace-event JSON (complete "X" events, times in
+ * microseconds), which chrome://tracing and Perfetto load directly.
+ */
+vitte_status_t vitte_trace_write_json(vitte_trace_t *trace, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VITTE_BOOTSTRAP_TRACE_H */
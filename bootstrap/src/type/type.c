@@ -1,7 +1,11 @@
 #include "type.h"
 
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "../util/util.h"
+
 static void vitte_type_registry_set_error(
     vitte_type_registry_t *registry,
     vitte_status_t status,
@@ -32,8 +36,6 @@ void vitte_type_init_proc(
     size_t arity,
     bool variadic
 ) {
-    size_t index;
-
     if (type == NULL) {
         return;
     }
@@ -42,12 +44,14 @@ void vitte_type_init_proc(
     type->name = name != NULL ? name : "<proc>";
     type->builtin_kind = VITTE_BUILTIN_TYPE_ERROR;
     type->return_type = return_type;
+    type->parameter_types = parameter_types;
     type->arity = arity;
     type->variadic = variadic;
     type->valid = true;
-    for (index = 0u; index < arity && index < VITTE_TYPE_MAX_PROC_PARAMETERS; index++) {
-        type->parameter_types[index] = parameter_types != NULL ? parameter_types[index] : NULL;
-    }
+}
+
+static const vitte_type_t *vitte_type_parameter_at(const vitte_type_t *type, size_t index) {
+    return type->parameter_types != NULL ? type->parameter_types[index] : NULL;
 }
 
 static void vitte_type_init_builtin(
@@ -65,8 +69,10 @@ static void vitte_type_init_builtin(
     type->error = builtin->error;
 }
 
-vitte_status_t vitte_type_registry_init(vitte_type_registry_t *registry) {
+vitte_status_t vitte_type_registry_init(vitte_type_registry_t *registry, const vitte_allocator_t *allocator) {
+    vitte_arena_config_t arena_config;
     size_t index;
+    vitte_status_t status;
 
     if (registry == NULL) {
         return VITTE_STATUS_ERROR_INVALID_ARGUMENT;
@@ -89,6 +95,17 @@ vitte_status_t vitte_type_registry_init(vitte_type_registry_t *registry) {
         vitte_type_init_builtin(&registry->builtin_types[index], builtin);
     }
 
+    vitte_arena_config_init(&arena_config);
+    arena_config.initial_block_size = VITTE_TYPE_BLOCK_SIZE;
+    if (allocator != NULL && vitte_allocator_is_valid(allocator)) {
+        arena_config.allocator = *allocator;
+    }
+    status = vitte_arena_init(&registry->arena, &arena_config);
+    if (status != VITTE_STATUS_OK) {
+        vitte_type_registry_set_error(registry, status, "VITTE_TYPE_E_MEMORY", "cannot allocate type arena", NULL);
+        return status;
+    }
+
     registry->initialized = true;
     return VITTE_STATUS_OK;
 }
@@ -97,9 +114,29 @@ void vitte_type_registry_destroy(vitte_type_registry_t *registry) {
     if (registry == NULL) {
         return;
     }
+    if (vitte_arena_is_initialized(&registry->arena)) {
+        vitte_arena_destroy(&registry->arena);
+    }
+    free(registry->index);
     memset(registry, 0, sizeof(*registry));
 }
 
+void vitte_type_registry_reset(vitte_type_registry_t *registry) {
+    if (!vitte_type_registry_is_initialized(registry)) {
+        return;
+    }
+    vitte_arena_reset(&registry->arena);
+    if (registry->index != NULL) {
+        memset(registry->index, 0, registry->index_capacity * sizeof(*registry->index));
+    }
+    registry->index_count = 0u;
+    registry->pick_type_count = 0u;
+    registry->form_type_count = 0u;
+    registry->list_type_count = 0u;
+    registry->proc_type_count = 0u;
+    vitte_error_reset(&registry->last_error);
+}
+
 bool vitte_type_registry_is_initialized(const vitte_type_registry_t *registry) {
     return registry != NULL && registry->initialized;
 }
@@ -108,6 +145,200 @@ const vitte_error_t *vitte_type_registry_last_error(const vitte_type_registry_t
     return registry != NULL ? &registry->last_error : vitte_error_last();
 }
 
+static size_t vitte_type_hash_named(vitte_type_kind_t kind, const char *name, size_t length) {
+    unsigned char tag = (unsigned char)kind;
+    uint64_t hash = vitte_util_hash_bytes(VITTE_UTIL_HASH_SEED, &tag, 1u);
+
+    return (size_t)vitte_util_hash_bytes(hash, name, length);
+}
+
+static size_t vitte_type_hash_proc(
+    const char *name,
+    const vitte_type_t *return_type,
+    const vitte_type_t *const *parameter_types,
+    size_t arity,
+    bool variadic
+) {
+    unsigned char tag = (unsigned char)VITTE_TYPE_KIND_PROC;
+    uint64_t hash = vitte_util_hash_bytes(VITTE_UTIL_HASH_SEED, &tag, 1u);
+    size_t index;
+
+    hash = vitte_util_hash_bytes(hash, name, strlen(name));
+    hash = vitte_util_hash_bytes(hash, &return_type, sizeof(return_type));
+    hash = vitte_util_hash_bytes(hash, &arity, sizeof(arity));
+    tag = variadic ? 1u : 0u;
+    hash = vitte_util_hash_bytes(hash, &tag, 1u);
+    for (index = 0u; index < arity; index++) {
+        const vitte_type_t *parameter = parameter_types != NULL ? parameter_types[index] : NULL;
+        hash = vitte_util_hash_bytes(hash, &parameter, sizeof(parameter));
+    }
+    return (size_t)hash;
+}
+
+static bool vitte_type_name_matches(const vitte_type_t *type, const char *name, size_t length) {
+    return strncmp(type->name, name, length) == 0 && type->name[length] == '\0';
+}
+
+/* Returns the slot holding the `kind` type spelled `name[0..length)`, or the empty slot where it would go. */
+static vitte_type_index_slot_t *vitte_type_index_probe_named(
+    const vitte_type_registry_t *registry,
+    vitte_type_kind_t kind,
+    const char *name,
+    size_t length,
+    size_t hash
+) {
+    size_t mask = registry->index_capacity - 1u;
+    size_t position = hash & mask;
+
+    for (;;) {
+        vitte_type_index_slot_t *slot = &registry->index[position];
+
+        if (slot->type == NULL ||
+            (slot->hash == hash && slot->type->kind == kind && vitte_type_name_matches(slot->type, name, length))) {
+            return slot;
+        }
+        position = (position + 1u) & mask;
+    }
+}
+
+static vitte_type_index_slot_t *vitte_type_index_probe_proc(
+    const vitte_type_registry_t *registry,
+    const char *name,
+    const vitte_type_t *return_type,
+    const vitte_type_t *const *parameter_types,
+    size_t arity,
+    bool variadic,
+    size_t hash
+) {
+    size_t mask = registry->index_capacity - 1u;
+    size_t position = hash & mask;
+
+    for (;;) {
+        vitte_type_index_slot_t *slot = &registry->index[position];
+        const vitte_type_t *type = slot->type;
+
+        if (type == NULL) {
+            return slot;
+        }
+        if (slot->hash == hash && type->kind == VITTE_TYPE_KIND_PROC && type->return_type == return_type &&
+            type->arity == arity && type->variadic == variadic && strcmp(type->name, name) == 0) {
+            size_t index;
+
+            for (index = 0u; index < arity; index++) {
+                const vitte_type_t *parameter = parameter_types != NULL ? parameter_types[index] : NULL;
+                if (vitte_type_parameter_at(type, index) != parameter) {
+                    break;
+                }
+            }
+            if (index == arity) {
+                return slot;
+            }
+        }
+        position = (position + 1u) & mask;
+    }
+}
+
+static bool vitte_type_index_reserve(vitte_type_registry_t *registry) {
+    vitte_type_index_slot_t *grown;
+    size_t capacity;
+    size_t index;
+
+    if ((registry->index_count + 1u) * 2u <= registry->index_capacity) {
+        return true;
+    }
+    capacity = registry->index_capacity == 0u ? VITTE_TYPE_INITIAL_INDEX_CAPACITY : registry->index_capacity * 2u;
+    grown = (vitte_type_index_slot_t *)calloc(capacity, sizeof(*grown));
+    if (grown == NULL) {
+        return false;
+    }
+    for (index = 0u; index < registry->index_capacity; index++) {
+        const vitte_type_index_slot_t *slot = &registry->index[index];
+        size_t position;
+
+        if (slot->type == NULL) {
+            continue;
+        }
+        position = slot->hash & (capacity - 1u);
+        while (grown[position].type != NULL) {
+            position = (position + 1u) & (capacity - 1u);
+        }
+        grown[position] = *slot;
+    }
+    free(registry->index);
+    registry->index = grown;
+    registry->index_capacity = capacity;
+    return true;
+}
+
+static const vitte_type_t *vitte_type_find_named(
+    const vitte_type_registry_t *registry,
+    vitte_type_kind_t kind,
+    const char *name,
+    size_t length
+) {
+    if (registry->index_count == 0u) {
+        return NULL;
+    }
+    return vitte_type_index_probe_named(registry, kind, name, length, vitte_type_hash_named(kind, name, length))->type;
+}
+
+/* Copies a type name into the registry arena; callers may pass stack buffers. */
+static const char *vitte_type_copy_name(vitte_type_registry_t *registry, const char *name, size_t length) {
+    char *copy = (char *)vitte_arena_alloc(&registry->arena, length + 1u, 1u);
+
+    if (copy != NULL) {
+        memcpy(copy, name, length);
+        copy[length] = '\0';
+    }
+    return copy;
+}
+
+/*
+ * Interns a pick, form, or list type under its full name. Callers look the
+ * name up first, so an existing slot here only holds a type that lookup
+ * cannot reach (a generic spelling, or a form shadowed by a pick).
+ */
+static const vitte_type_t *vitte_type_register_named(
+    vitte_type_registry_t *registry,
+    vitte_type_kind_t kind,
+    const char *name,
+    size_t *count,
+    const char *code
+) {
+    vitte_type_index_slot_t *slot;
+    vitte_type_t *type;
+    const char *name_copy;
+    size_t length = strlen(name);
+    size_t hash = vitte_type_hash_named(kind, name, length);
+
+    if (!vitte_type_index_reserve(registry)) {
+        vitte_type_registry_set_error(registry, VITTE_STATUS_ERROR_OUT_OF_MEMORY, code, "cannot grow type index", name);
+        return NULL;
+    }
+    slot = vitte_type_index_probe_named(registry, kind, name, length, hash);
+    if (slot->type != NULL) {
+        vitte_error_reset(&registry->last_error);
+        return slot->type;
+    }
+    type = (vitte_type_t *)vitte_arena_alloc(&registry->arena, sizeof(*type), VITTE_ARENA_DEFAULT_ALIGNMENT);
+    name_copy = type != NULL ? vitte_type_copy_name(registry, name, length) : NULL;
+    if (name_copy == NULL) {
+        vitte_type_registry_set_error(registry, VITTE_STATUS_ERROR_OUT_OF_MEMORY, code, "cannot allocate type", name);
+        return NULL;
+    }
+    memset(type, 0, sizeof(*type));
+    type->kind = kind;
+    type->name = name_copy;
+    type->builtin_kind = VITTE_BUILTIN_TYPE_ERROR;
+    type->valid = true;
+    slot->hash = hash;
+    slot->type = type;
+    registry->index_count++;
+    (*count)++;
+    vitte_error_reset(&registry->last_error);
+    return type;
+}
+
 const vitte_type_t *vitte_type_builtin(
     vitte_type_registry_t *registry,
     vitte_builtin_type_kind_t kind
@@ -125,37 +356,30 @@ const vitte_type_t *vitte_type_lookup(
     const char *name
 ) {
     const vitte_builtin_type_t *builtin;
-    size_t index;
-    size_t query_length = strlen(name);
-    const char *generic_start = strchr(name, '[');
-
-    if (generic_start != NULL && generic_start > name) {
-        query_length = (size_t)(generic_start - name);
-    }
+    const vitte_type_t *type;
+    const char *generic_start;
+    size_t query_length;
 
     if (!vitte_type_registry_is_initialized(registry) || name == NULL || name[0] == '\0') {
         vitte_type_registry_set_error(registry, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_TYPE_E_LOOKUP", "invalid type lookup name", name);
         return NULL;
     }
-    for (index = 0u; index < registry->pick_type_count; index++) {
-        if (strlen(registry->pick_types[index].name) == query_length &&
-            strncmp(registry->pick_types[index].name, name, query_length) == 0) {
-            vitte_error_reset(&registry->last_error);
-            return &registry->pick_types[index];
-        }
+    query_length = strlen(name);
+    generic_start = strchr(name, '[');
+    if (generic_start != NULL && generic_start > name) {
+        query_length = (size_t)(generic_start - name);
     }
-    for (index = 0u; index < registry->form_type_count; index++) {
-        if (strlen(registry->form_types[index].name) == query_length &&
-            strncmp(registry->form_types[index].name, name, query_length) == 0) {
-            vitte_error_reset(&registry->last_error);
-            return &registry->form_types[index];
-        }
+    /* Picks shadow forms, and both match on the name before any generic arguments. */
+    type = vitte_type_find_named(registry, VITTE_TYPE_KIND_PICK, name, query_length);
+    if (type == NULL) {
+        type = vitte_type_find_named(registry, VITTE_TYPE_KIND_FORM, name, query_length);
     }
-    for (index = 0u; index < registry->list_type_count; index++) {
-        if (strcmp(registry->list_types[index].name, name) == 0) {
-            vitte_error_reset(&registry->last_error);
-            return &registry->list_types[index];
-        }
+    if (type == NULL) {
+        type = vitte_type_find_named(registry, VITTE_TYPE_KIND_LIST, name, strlen(name));
+    }
+    if (type != NULL) {
+        vitte_error_reset(&registry->last_error);
+        return type;
     }
     /* The bootstrap ABI currently represents narrow integers and isize using
      * the closest available machine-width builtin until their dedicated
@@ -179,67 +403,36 @@ const vitte_type_t *vitte_type_lookup(
 }
 
 const vitte_type_t *vitte_type_register_pick(vitte_type_registry_t *registry, const char *name) {
-    vitte_type_t *type;
+    const vitte_type_t *type;
 
     if (!vitte_type_registry_is_initialized(registry) || name == NULL || name[0] == '\0') {
         vitte_type_registry_set_error(registry, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_TYPE_E_PICK", "invalid pick type name", name);
         return NULL;
     }
-    type = (vitte_type_t *)vitte_type_lookup(registry, name);
+    type = vitte_type_lookup(registry, name);
     if (type != NULL && type->kind == VITTE_TYPE_KIND_PICK) {
         return type;
     }
-    if (registry->pick_type_count >= VITTE_TYPE_MAX_PICK_TYPES) {
-        vitte_type_registry_set_error(registry, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_TYPE_E_PICK", "pick type registry is full", name);
-        return NULL;
-    }
-    type = &registry->pick_types[registry->pick_type_count++];
-    memset(type, 0, sizeof(*type));
-    type->kind = VITTE_TYPE_KIND_PICK;
-    type->name = name;
-    type->builtin_kind = VITTE_BUILTIN_TYPE_ERROR;
-    type->valid = true;
-    type->error = false;
-    vitte_error_reset(&registry->last_error);
-    return type;
+    return vitte_type_register_named(registry, VITTE_TYPE_KIND_PICK, name, &registry->pick_type_count, "VITTE_TYPE_E_PICK");
 }
 
 const vitte_type_t *vitte_type_register_form(vitte_type_registry_t *registry, const char *name) {
-    vitte_type_t *type;
+    const vitte_type_t *type;
     if (!vitte_type_registry_is_initialized(registry) || name == NULL || name[0] == '\0') {
         vitte_type_registry_set_error(registry, VITTE_STATUS_ERROR_INVALID_ARGUMENT, "VITTE_TYPE_E_FORM", "invalid form type name", name);
         return NULL;
     }
-    type = (vitte_type_t *)vitte_type_lookup(registry, name);
+    type = vitte_type_lookup(registry, name);
     if (type != NULL && type->kind == VITTE_TYPE_KIND_FORM) return type;
-    if (registry->form_type_count >= VITTE_TYPE_MAX_FORM_TYPES) {
-        vitte_type_registry_set_error(registry, VITTE_STATUS_ERROR_INVALID_STATE, "VITTE_TYPE_E_FORM", "form type registry is full", name);
-        return NULL;
-    }
-    type = &registry->form_types[registry->form_type_count++];
-    memset(type, 0, sizeof(*type));
-    type->kind = VITTE_TYPE_KIND_FORM;
-    type->name = name;
-    type->builtin_kind = VITTE_BUILTIN_TYPE_ERROR;
-    type->valid = true;
-    vitte_error_reset(&registry->last_error);
-    return type;
+    return vitte_type_register_named(registry, VITTE_TYPE_KIND_FORM, name, &registry->form_type_count, "VITTE_TYPE_E_FORM");
 }
 
 const vitte_type_t *vitte_type_register_list(vitte_type_registry_t *registry, const char *name) {
-    vitte_type_t *type;
+    const vitte_type_t *type;
     if (!vitte_type_registry_is_initialized(registry) || name == NULL || name[0] == '\0') return NULL;
-    type = (vitte_type_t *)vitte_type_lookup(registry, name);
+    type = vitte_type_lookup(registry, name);
     if (type != NULL && type->kind == VITTE_TYPE_KIND_LIST) return type;
-    if (registry->list_type_count >= VITTE_TYPE_MAX_LIST_TYPES) return NULL;
-    type = &registry->list_types[registry->list_type_count++];
-    memset(type, 0, sizeof(*type));
-    type->kind = VITTE_TYPE_KIND_LIST;
-    type->name = name;
-    type->builtin_kind = VITTE_BUILTIN_TYPE_ERROR;
-    type->valid = true;
-    vitte_error_reset(&registry->last_error);
-    return type;
+    return vitte_type_register_named(registry, VITTE_TYPE_KIND_LIST, name, &registry->list_type_count, "VITTE_TYPE_E_LIST");
 }
 
 const vitte_type_t *vitte_type_register_proc(
@@ -250,11 +443,43 @@ const vitte_type_t *vitte_type_register_proc(
     size_t arity,
     bool variadic
 ) {
+    vitte_type_index_slot_t *slot;
     vitte_type_t *type;
-    if (!vitte_type_registry_is_initialized(registry) || return_type == NULL || arity > VITTE_TYPE_MAX_PROC_PARAMETERS ||
-        registry->proc_type_count >= VITTE_TYPE_MAX_PROC_TYPES) return NULL;
-    type = &registry->proc_types[registry->proc_type_count++];
-    vitte_type_init_proc(type, name != NULL ? name : "<proc>", return_type, parameter_types, arity, variadic);
+    const vitte_type_t **parameters = NULL;
+    const char *name_copy = NULL;
+    size_t hash;
+    size_t index;
+
+    if (!vitte_type_registry_is_initialized(registry) || return_type == NULL || arity > VITTE_TYPE_MAX_PROC_PARAMETERS) return NULL;
+    name = name != NULL ? name : "<proc>";
+    if (!vitte_type_index_reserve(registry)) {
+        vitte_type_registry_set_error(registry, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_TYPE_E_PROC", "cannot grow type index", name);
+        return NULL;
+    }
+    hash = vitte_type_hash_proc(name, return_type, parameter_types, arity, variadic);
+    slot = vitte_type_index_probe_proc(registry, name, return_type, parameter_types, arity, variadic, hash);
+    if (slot->type != NULL) {
+        return slot->type;
+    }
+    type = (vitte_type_t *)vitte_arena_alloc(&registry->arena, sizeof(*type), VITTE_ARENA_DEFAULT_ALIGNMENT);
+    if (type != NULL) {
+        name_copy = vitte_type_copy_name(registry, name, strlen(name));
+    }
+    if (name_copy != NULL && arity > 0u) {
+        parameters = (const vitte_type_t **)vitte_arena_alloc(&registry->arena, arity * sizeof(*parameters), VITTE_ARENA_DEFAULT_ALIGNMENT);
+    }
+    if (name_copy == NULL || (arity > 0u && parameters == NULL)) {
+        vitte_type_registry_set_error(registry, VITTE_STATUS_ERROR_OUT_OF_MEMORY, "VITTE_TYPE_E_PROC", "cannot allocate proc type", name);
+        return NULL;
+    }
+    for (index = 0u; index < arity; index++) {
+        parameters[index] = parameter_types != NULL ? parameter_types[index] : NULL;
+    }
+    vitte_type_init_proc(type, name_copy, return_type, parameters, arity, variadic);
+    slot->hash = hash;
+    slot->type = type;
+    registry->index_count++;
+    registry->proc_type_count++;
     return type;
 }
 
@@ -356,7 +581,7 @@ bool vitte_type_equals(const vitte_type_t *left, const vitte_type_t *right) {
             return false;
         }
         for (index = 0u; index < left->arity; index++) {
-            if (!vitte_type_equals(left->parameter_types[index], right->parameter_types[index])) {
+            if (!vitte_type_equals(vitte_type_parameter_at(left, index), vitte_type_parameter_at(right, index))) {
                 return false;
             }
         }
@@ -417,8 +642,8 @@ bool vitte_type_is_condition(const vitte_type_t *type) {
 }
 
 const vitte_type_t *vitte_type_proc_parameter(const vitte_type_t *type, size_t index) {
-    if (!vitte_type_is_proc(type) || index >= type->arity || index >= VITTE_TYPE_MAX_PROC_PARAMETERS) {
+    if (!vitte_type_is_proc(type) || index >= type->arity) {
         return NULL;
     }
-    return type->parameter_types[index];
+    return vitte_type_parameter_at(type, index);
 }
@@ -5,6 +5,7 @@
 #include <stddef.h>
 
 #include "../api/error.h"
+#include "../arena/arena.h"
 #include "../ast/ast.h"
 #include "../builtin/builtin.h"
 
@@ -13,10 +14,8 @@ extern "C" {
 #endif
 
 #define VITTE_TYPE_MAX_PROC_PARAMETERS ((size_t)64u)
-#define VITTE_TYPE_MAX_PICK_TYPES ((size_t)1024u)
-#define VITTE_TYPE_MAX_FORM_TYPES ((size_t)16384u)
-#define VITTE_TYPE_MAX_LIST_TYPES ((size_t)8192u)
-#define VITTE_TYPE_MAX_PROC_TYPES ((size_t)4096u)
+#define VITTE_TYPE_BLOCK_SIZE ((size_t)16u * 1024u)
+#define VITTE_TYPE_INITIAL_INDEX_CAPACITY ((size_t)64u)
 
 typedef enum vitte_type_kind {
     VITTE_TYPE_KIND_INVALID = 0,
@@ -32,24 +31,34 @@ typedef struct vitte_type {
     const char *name;
     vitte_builtin_type_kind_t builtin_kind;
     const struct vitte_type *return_type;
-    const struct vitte_type *parameter_types[VITTE_TYPE_MAX_PROC_PARAMETERS];
+    const struct vitte_type *const *parameter_types;
     size_t arity;
     bool variadic;
     bool valid;
     bool error;
 } vitte_type_t;
 
+/*
+ * One open-addressing index covers every registered type. Pick, form, and
+ * list types are keyed by kind and name; proc types are hash-consed on their
+ * name, return type, parameter types, and variadic flag.
+ */
+typedef struct vitte_type_index_slot {
+    size_t hash;
+    vitte_type_t *type;
+} vitte_type_index_slot_t;
+
 typedef struct vitte_type_registry {
     bool initialized;
     vitte_builtin_registry_t builtins;
     vitte_type_t builtin_types[VITTE_BUILTIN_TYPE_COUNT];
-    vitte_type_t pick_types[VITTE_TYPE_MAX_PICK_TYPES];
+    vitte_arena_t arena;
+    vitte_type_index_slot_t *index;
+    size_t index_capacity;
+    size_t index_count;
     size_t pick_type_count;
-    vitte_type_t form_types[VITTE_TYPE_MAX_FORM_TYPES];
     size_t form_type_count;
-    vitte_type_t list_types[VITTE_TYPE_MAX_LIST_TYPES];
     size_t list_type_count;
-    vitte_type_t proc_types[VITTE_TYPE_MAX_PROC_TYPES];
     size_t proc_type_count;
     vitte_error_t last_error;
 } vitte_type_registry_t;
@@ -64,8 +73,10 @@ void vitte_type_init_proc(
     bool variadic
 );
 
-vitte_status_t vitte_type_registry_init(vitte_type_registry_t *registry);
+/* `allocator` backs the type arena; NULL selects the default one. */
+vitte_status_t vitte_type_registry_init(vitte_type_registry_t *registry, const vitte_allocator_t *allocator);
 void vitte_type_registry_destroy(vitte_type_registry_t *registry);
+void vitte_type_registry_reset(vitte_type_registry_t *registry);
 bool vitte_type_registry_is_initialized(const vitte_type_registry_t *registry);
 const vitte_error_t *vitte_type_registry_last_error(const vitte_type_registry_t *registry);
 
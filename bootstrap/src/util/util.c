@@ -45,3 +45,38 @@ bool vitte_bootstrap_src_util_util_h_self_test(void) {
         vitte_bootstrap_src_util_util_h_purpose() != (const char *)0 &&
         vitte_bootstrap_src_util_util_h_checksum(vitte_bootstrap_src_util_util_h_name(), 0u) == 2166136261u;
 }
+
+uint64_t vitte_util_hash_bytes(uint64_t hash, const void *data, size_t length) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    size_t index;
+
+    for (index = 0u; index < length; index++) {
+        hash ^= bytes[index];
+        hash *= UINT64_C(1099511628211);
+    }
+    return hash;
+}
+
+uint64_t vitte_util_hash_text(uint64_t hash, const char *text) {
+    const unsigned char *cursor = (const unsigned char *)text;
+
+    while (*cursor != '\0') {
+        hash ^= *cursor++;
+        hash *= UINT64_C(1099511628211);
+    }
+    return hash;
+}
+
+uint64_t vitte_util_hash_value(uint64_t hash, uint64_t value) {
+    hash ^= value;
+    return hash * UINT64_C(1099511628211);
+}
+
+size_t vitte_util_hash_pointer(const void *pointer) {
+    uint64_t value = (uint64_t)(uintptr_t)pointer;
+
+    value ^= value >> 33;
+    value *= UINT64_C(0xff51afd7ed558ccd);
+    value ^= value >> 33;
+    return (size_t)value;
+}
@@ -23,6 +23,19 @@ const char *vitte_bootstrap_src_util_util_h_purpose(void);
 uint32_t vitte_bootstrap_src_util_util_h_checksum(const char *text, size_t length);
 bool vitte_bootstrap_src_util_util_h_self_test(void);
 
+/*
+ * 64-bit FNV-1a. Start from VITTE_UTIL_HASH_SEED and chain calls to hash
+ * several fields; add a terminator with vitte_util_hash_value between
+ * variable-length fields that must not run together.
+ */
+#define VITTE_UTIL_HASH_SEED UINT64_C(14695981039346656037)
+
+uint64_t vitte_util_hash_bytes(uint64_t hash, const void *data, size_t length);
+uint64_t vitte_util_hash_text(uint64_t hash, const char *text);
+uint64_t vitte_util_hash_value(uint64_t hash, uint64_t value);
+/* Mixes a pointer for identity-keyed tables; pointer low bits are mostly zero. */
+size_t vitte_util_hash_pointer(const void *pointer);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,53 @@
+#!/usr/bin/env sh
+# `batch` over bootstrap/tests must print the same JSON lines (timing fields
+# removed), exit with the same code and emit the same C for --jobs 1 and
+# --jobs N.
+set -eu
+
+ROOT_DIR=$(CDPATH= cd -- "$(dirname -- "$0")/.." && pwd)
+. "$ROOT_DIR/tools/bootstrap_smoke_lib.sh"
+smoke_init bootstrap-batch-smoke "${1:-$ROOT_DIR/target/bootstrap-c17/vitte-bootstrap}"
+JOBS=${2:-4}
+cd "$ROOT_DIR"
+unset VITTE_JOBS || true
+
+find bootstrap/tests -name '*.vit' | sort >"$OUT_DIR/manifest"
+inputs=$(wc -l <"$OUT_DIR/manifest" | tr -d ' ')
+
+# batch <tag> <jobs> [options...]: JSON without "ns" and the exit code.
+batch() {
+  tag=$1 jobs=$2
+  shift 2
+  set +e
+  "$BIN" batch --manifest "$OUT_DIR/manifest" --jobs "$jobs" "$@" >"$OUT_DIR/$tag.raw" 2>"$OUT_DIR/$tag.err"
+  printf '%s\n' "$?" >"$OUT_DIR/$tag.exit"
+  set -e
+  sed 's/"ns":[0-9]*,//' "$OUT_DIR/$tag.raw" >"$OUT_DIR/$tag.json"
+  [ "$(wc -l <"$OUT_DIR/$tag.json" | tr -d ' ')" -eq "$inputs" ] ||
+    die "$tag printed $(wc -l <"$OUT_DIR/$tag.json" | tr -d ' ') lines for $inputs inputs"
+}
+
+same() {
+  cmp -s "$OUT_DIR/$1" "$OUT_DIR/$2" || {
+    diff "$OUT_DIR/$1" "$OUT_DIR/$2" | head -n 20 >&2 || true
+    die "$1 and $2 differ"
+  }
+}
+
+batch check-1 1
+batch check-n "$JOBS"
+same check-1.json check-n.json
+same check-1.exit check-n.exit
+
+# Both runs write to the same directory, so paths in the JSON match too.
+mkdir -p "$OUT_DIR/c"
+batch c-1 1 --emit c -o "$OUT_DIR/c"
+mv "$OUT_DIR/c" "$OUT_DIR/c-1"
+mkdir -p "$OUT_DIR/c"
+batch c-n "$JOBS" --emit c -o "$OUT_DIR/c"
+mv "$OUT_DIR/c" "$OUT_DIR/c-n"
+same c-1.json c-n.json
+same c-1.exit c-n.exit
+diff -r "$OUT_DIR/c-1" "$OUT_DIR/c-n" >/dev/null || die "--emit c wrote different C for --jobs 1 and --jobs $JOBS"
+
+printf '[bootstrap-batch-smoke] OK inputs=%s jobs=1,%s exit=%s\n' "$inputs" "$JOBS" "$(cat "$OUT_DIR/check-1.exit")"
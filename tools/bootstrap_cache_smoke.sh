@@ -0,0 +1,94 @@
+#!/usr/bin/env sh
+# Cold and warm --cache-dir runs of `check` and `emit-c` over bootstrap/tests
+# must match an uncached run; corrupted or truncated module entries must be
+# rejected, re-parsed and rewritten.
+set -eu
+
+ROOT_DIR=$(CDPATH= cd -- "$(dirname -- "$0")/.." && pwd)
+. "$ROOT_DIR/tools/bootstrap_smoke_lib.sh"
+smoke_init bootstrap-cache-smoke "${1:-$ROOT_DIR/target/bootstrap-c17/vitte-bootstrap}"
+CACHE=$OUT_DIR/cache
+cd "$ROOT_DIR"
+
+# run <tag> <command> <input> [options...]: keeps stdout, stderr without the
+# --cache-stats line, the exit code and any emitted C under $OUT_DIR/<tag>.
+run() {
+  tag=$1 command=$2 input=$3
+  shift 3
+  dir=$OUT_DIR/$tag/$(printf '%s' "$input" | tr '/' '_')
+  mkdir -p "$dir"
+  set +e
+  if [ "$command" = emit-c ]; then
+    "$BIN" emit-c "$input" -o "$OUT_DIR/out.c" "$@" >"$dir/emit-c.out" 2>"$dir/emit-c.raw"
+    printf '%s\n' "$?" >"$dir/emit-c.exit"
+    if [ -f "$OUT_DIR/out.c" ]; then mv "$OUT_DIR/out.c" "$dir/emit-c.c"; fi
+  else
+    "$BIN" check "$input" "$@" >"$dir/check.out" 2>"$dir/check.raw"
+    printf '%s\n' "$?" >"$dir/check.exit"
+  fi
+  set -e
+  grep -v '^\[vitte-bootstrap\] cache: ' "$dir/$command.raw" >"$dir/$command.err" || true
+  grep '^\[vitte-bootstrap\] cache: ' "$dir/$command.raw" >>"$OUT_DIR/$tag.stats" || true
+}
+
+# parsed <tag>: total modules parsed instead of loaded during a pass.
+parsed() {
+  awk '{ total += $5 } END { print total + 0 }' "$OUT_DIR/$1.stats"
+}
+
+pass() {
+  tag=$1
+  shift
+  : >"$OUT_DIR/$tag.stats"
+  for input in $(find bootstrap/tests -name '*.vit' | sort); do
+    run "$tag" check "$input" "$@"
+    run "$tag" emit-c "$input" "$@"
+  done
+}
+
+compare() {
+  for file in $(cd "$OUT_DIR/reference" && find . -type f | sort); do
+    case "$file" in *.raw) continue ;; esac
+    cmp -s "$OUT_DIR/reference/$file" "$OUT_DIR/$1/$file" ||
+      die "$1 run differs from an uncached run: $file"
+  done
+}
+
+pass reference
+pass cold --cache-dir "$CACHE" --cache-stats
+compare cold
+pass warm --cache-dir "$CACHE" --cache-stats
+compare warm
+
+entries=$(find "$CACHE/modules" -name '*.vmc' | sort)
+[ -n "$entries" ] || die "no module entries were written to $CACHE/modules"
+
+# Truncate every other entry and flip one byte in the middle of the rest.
+index=0
+for entry in $entries; do
+  size=$(wc -c <"$entry")
+  if [ $((index % 2)) -eq 0 ]; then
+    head -c $((size / 2)) "$entry" >"$OUT_DIR/entry.tmp"
+  else
+    python3 -c 'import sys
+data = bytearray(open(sys.argv[1], "rb").read())
+data[len(data) // 2] ^= 0xff
+sys.stdout.buffer.write(data)' "$entry" >"$OUT_DIR/entry.tmp"
+  fi
+  cat "$OUT_DIR/entry.tmp" >"$entry"
+  index=$((index + 1))
+done
+rm -f "$OUT_DIR/entry.tmp"
+
+pass corrupt --cache-dir "$CACHE" --cache-stats
+compare corrupt
+pass rewritten --cache-dir "$CACHE" --cache-stats
+compare rewritten
+
+[ "$(parsed corrupt)" -gt "$(parsed warm)" ] ||
+  die "corrupted entries were loaded instead of re-parsed"
+[ "$(parsed rewritten)" -eq "$(parsed warm)" ] ||
+  die "re-parsed entries were not written back to the cache"
+
+printf '[bootstrap-cache-smoke] OK entries=%s parsed warm=%s corrupt=%s\n' \
+  "$(printf '%s\n' "$entries" | wc -l | tr -d ' ')" "$(parsed warm)" "$(parsed corrupt)"
@@ -0,0 +1,62 @@
+#!/usr/bin/env sh
+# Incremental `check --cache-dir` runs of the bootstrap compiler. A warm run
+# of src/vitte/compiler/main.vit and of a three-module import chain must
+# neither parse nor analyse anything; a body-only edit to the chain's leaf
+# must re-analyse that module alone; a signature change to it must also
+# re-analyse every module that imports it, directly or not.
+set -eu
+
+ROOT_DIR=$(CDPATH= cd -- "$(dirname -- "$0")/.." && pwd)
+. "$ROOT_DIR/tools/bootstrap_smoke_lib.sh"
+smoke_init bootstrap-incremental-smoke "${1:-$ROOT_DIR/target/bootstrap-c17/vitte-bootstrap}"
+FIXTURES=$ROOT_DIR/bootstrap/tests/import_export_coverage
+LEAF=coverage_chain_source.vit
+
+# check <tag> <input>: a cached check whose stdout, cache line and exit code
+# land in $OUT_DIR/<tag>.*; a failed check is fatal.
+check() {
+  "$BIN" check "$2" --cache-dir "$OUT_DIR/cache" --cache-stats >"$OUT_DIR/$1.out" 2>"$OUT_DIR/$1.raw" ||
+    die "$1: check $2 failed: $(cat "$OUT_DIR/$1.raw")"
+  grep '^\[vitte-bootstrap\] cache: ' "$OUT_DIR/$1.raw" >"$OUT_DIR/$1.stats" ||
+    die "$1: no cache line from --cache-stats"
+}
+
+# expect <tag> <parsed> <analysed>
+expect() {
+  grep -q " $2 parsed, $3 analysed," "$OUT_DIR/$1.stats" ||
+    die "$1: expected $2 parsed, $3 analysed; got: $(cat "$OUT_DIR/$1.stats")"
+}
+
+edit() {
+  sed "$1" "$LEAF" >"$OUT_DIR/leaf.tmp"
+  cmp -s "$OUT_DIR/leaf.tmp" "$LEAF" && die "edit '$1' did not apply to $LEAF"
+  mv "$OUT_DIR/leaf.tmp" "$LEAF"
+}
+
+cd "$ROOT_DIR"
+check compiler-cold src/vitte/compiler/main.vit
+check compiler-warm src/vitte/compiler/main.vit
+cmp -s "$OUT_DIR/compiler-cold.out" "$OUT_DIR/compiler-warm.out" ||
+  die "warm check of main.vit printed different output"
+expect compiler-warm 0 0
+
+mkdir "$OUT_DIR/chain"
+cp "$FIXTURES"/coverage_chain_*.vit "$OUT_DIR/chain/"
+cd "$OUT_DIR/chain"
+check chain-cold coverage_chain_main.vit
+expect chain-cold 3 3
+check chain-warm coverage_chain_main.vit
+expect chain-warm 0 0
+
+# Same exported signatures, different body.
+edit 's/give 4;/give 2 + 2;/'
+check chain-body coverage_chain_main.vit
+expect chain-body 1 1
+
+# The exported `number` now returns i64: coverage_chain_mid imports it and
+# coverage_chain_main imports from coverage_chain_mid.
+edit 's/^proc seed() -> int {/proc seed() -> i64 {/'
+check chain-signature coverage_chain_main.vit
+expect chain-signature 1 3
+
+printf '[bootstrap-incremental-smoke] OK warm=0 body=1 signature=3 analysed\n'
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""
+Lexer throughput benchmark for the C17 bootstrap compiler.
+
+Runs `vitte-bootstrap lex-bench` over every .vit and .vitl file of the given
+roots (default: src/vitte/compiler and src/vitte/stdlib) and reports aggregate MB/s
+of the module lexing pass used by the driver.
+
+Usage:
+  ./tools/bootstrap_lexer_bench.py [--bin PATH] [--repeat N] [--json OUT] [ROOT...]
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import re
+import subprocess
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parents[1]
+DEFAULT_BIN = ROOT / "target/bootstrap-c17/vitte-bootstrap"
+DEFAULT_ROOTS = ("src/vitte/compiler", "src/vitte/stdlib")
+LINE_RE = re.compile(r"bytes=(\d+) tokens=(\d+) repeat=(\d+) ns=(\d+)")
+
+
+def collect_sources(roots: list[str]) -> list[Path]:
+    files: list[Path] = []
+    for root in roots:
+        path = Path(root)
+        if not path.is_absolute():
+            path = ROOT / path
+        if path.is_file():
+            files.append(path)
+        elif path.is_dir():
+            files.extend(sorted([*path.rglob("*.vit"), *path.rglob("*.vitl")]))
+        else:
+            print(f"[lexer-bench][warn] missing root: {root}", file=sys.stderr)
+    return files
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("roots", nargs="*", default=list(DEFAULT_ROOTS))
+    parser.add_argument("--bin", default=str(DEFAULT_BIN))
+    parser.add_argument("--repeat", type=int, default=20)
+    parser.add_argument("--json", dest="json_out")
+    args = parser.parse_args()
+
+    binary = Path(args.bin)
+    if not binary.exists():
+        print(f"[lexer-bench][error] missing binary: {binary} (run make -C bootstrap)", file=sys.stderr)
+        return 1
+
+    files = collect_sources(args.roots)
+    if not files:
+        print("[lexer-bench][error] no .vit sources found", file=sys.stderr)
+        return 1
+
+    total_bytes = 0
+    total_tokens = 0
+    total_ns = 0
+    failures: list[str] = []
+    for path in files:
+        proc = subprocess.run(
+            [str(binary), "lex-bench", str(path), "--repeat", str(args.repeat)],
+            capture_output=True,
+            text=True,
+        )
+        match = LINE_RE.search(proc.stdout)
+        if proc.returncode != 0 or match is None:
+            failures.append(f"{path.relative_to(ROOT) if path.is_relative_to(ROOT) else path}: {proc.stderr.strip()}")
+            continue
+        size, tokens, repeat, ns = (int(value) for value in match.groups())
+        total_bytes += size * repeat
+        total_tokens += tokens * repeat
+        total_ns += ns
+
+    seconds = total_ns / 1e9 if total_ns else 0.0
+    mb_per_s = (total_bytes / (1024 * 1024)) / seconds if seconds else 0.0
+    tokens_per_s = total_tokens / seconds if seconds else 0.0
+    print(f"[lexer-bench] files={len(files) - len(failures)} bytes={total_bytes // args.repeat} repeat={args.repeat}")
+    print(f"[lexer-bench] throughput={mb_per_s:.1f} MB/s tokens={tokens_per_s / 1e6:.2f} M/s")
+    for failure in failures:
+        print(f"[lexer-bench][warn] {failure}", file=sys.stderr)
+
+    if args.json_out:
+        out = Path(args.json_out)
+        out.parent.mkdir(parents=True, exist_ok=True)
+        out.write_text(
+            json.dumps(
+                {
+                    "files": len(files) - len(failures),
+                    "failures": len(failures),
+                    "bytes": total_bytes // args.repeat,
+                    "repeat": args.repeat,
+                    "seconds": seconds,
+                    "mb_per_s": mb_per_s,
+                    "tokens_per_s": tokens_per_s,
+                },
+                indent=2,
+            )
+            + "\n",
+            encoding="utf-8",
+        )
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
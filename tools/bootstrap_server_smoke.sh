@@ -0,0 +1,75 @@
+#!/usr/bin/env sh
+# Starts `vitte-bootstrap serve` on a temporary socket and requires `check`,
+# `emit-c` and `build` forwarded to it to print the same stdout and stderr,
+# exit with the same code and write the same files as `--no-server` runs over
+# bootstrap/tests.
+set -eu
+
+ROOT_DIR=$(CDPATH= cd -- "$(dirname -- "$0")/.." && pwd)
+. "$ROOT_DIR/tools/bootstrap_smoke_lib.sh"
+smoke_init bootstrap-server-smoke "${1:-$ROOT_DIR/target/bootstrap-c17/vitte-bootstrap}"
+cd "$ROOT_DIR"
+# Every run below picks forwarding or --no-server explicitly.
+unset VITTE_NO_SERVER
+
+SERVER_PID=
+smoke_cleanup() {
+  if [ -n "$SERVER_PID" ]; then
+    kill -INT "$SERVER_PID" 2>/dev/null || true
+    wait "$SERVER_PID" 2>/dev/null || true
+  fi
+}
+
+# OUT_DIR is under $TMPDIR, short enough for the ~100-byte socket path limit.
+SOCKET=$OUT_DIR/serve.sock
+"$BIN" serve --socket "$SOCKET" >"$OUT_DIR/serve.out" 2>"$OUT_DIR/serve.err" &
+SERVER_PID=$!
+
+tries=0
+while [ ! -S "$SOCKET" ]; do
+  kill -0 "$SERVER_PID" 2>/dev/null || die "server exited: $(cat "$OUT_DIR/serve.err")"
+  tries=$((tries + 1))
+  [ "$tries" -le 100 ] || die "server did not create $SOCKET"
+  sleep 0.1
+done
+
+# run <tag> <command> <input> [options...]: keeps stdout, stderr, the exit
+# code and the written file under $OUT_DIR/<tag>.
+run() {
+  tag=$1 command=$2 input=$3
+  shift 3
+  dir=$OUT_DIR/$tag/$(printf '%s' "$input" | tr '/' '_')
+  mkdir -p "$dir"
+  rm -f "$OUT_DIR/output"
+  set +e
+  case "$command" in
+    check) "$BIN" check "$input" "$@" >"$dir/$command.out" 2>"$dir/$command.err" ;;
+    *) "$BIN" "$command" "$input" -o "$OUT_DIR/output" "$@" >"$dir/$command.out" 2>"$dir/$command.err" ;;
+  esac
+  printf '%s\n' "$?" >"$dir/$command.exit"
+  set -e
+  if [ -f "$OUT_DIR/output" ]; then mv "$OUT_DIR/output" "$dir/$command.file"; fi
+}
+
+for input in $(find bootstrap/tests -name '*.vit' | sort); do
+  for command in check emit-c build; do
+    run local "$command" "$input" --no-server
+    run forwarded "$command" "$input" --socket "$SOCKET"
+  done
+done
+
+compared=0
+for file in $(cd "$OUT_DIR/local" && find . -type f | sort); do
+  cmp -s "$OUT_DIR/local/$file" "$OUT_DIR/forwarded/$file" ||
+    die "forwarded run differs from --no-server: $file"
+  compared=$((compared + 1))
+done
+
+# The resident report only comes from the server, so this proves forwarding.
+"$BIN" check examples/hello.vit --socket "$SOCKET" --cache-stats >/dev/null 2>"$OUT_DIR/resident.err" ||
+  die "forwarded check of examples/hello.vit failed"
+grep -q '^\[vitte-bootstrap\] resident: ' "$OUT_DIR/resident.err" ||
+  die "requests were compiled locally instead of by the server"
+kill -0 "$SERVER_PID" 2>/dev/null || die "server exited while answering requests"
+
+printf '[bootstrap-server-smoke] OK compared=%s\n' "$compared"
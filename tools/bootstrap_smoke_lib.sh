@@ -0,0 +1,33 @@
+# Shared setup for the bootstrap_*_smoke.sh scripts; source it after setting
+# ROOT_DIR. `smoke_init <name> <bin>` checks the compiler binary, makes BIN
+# absolute, keeps local runs off any compile server and creates OUT_DIR with
+# mktemp -d. OUT_DIR is removed on exit, so nothing is left in the tree; a
+# script that starts more (a server) redefines smoke_cleanup, which runs first.
+
+die() {
+  printf '[%s][error] %s\n' "$SMOKE_NAME" "$1" >&2
+  exit 1
+}
+
+smoke_cleanup() {
+  :
+}
+
+smoke_exit() {
+  smoke_cleanup
+  rm -rf "$OUT_DIR"
+}
+
+smoke_init() {
+  SMOKE_NAME=$1
+  BIN=$2
+  OUT_DIR=
+  [ -x "$BIN" ] || die "missing bootstrap binary: $BIN"
+  BIN=$(CDPATH= cd -- "$(dirname -- "$BIN")" && pwd)/$(basename -- "$BIN")
+  OUT_DIR=$(mktemp -d "${TMPDIR:-/tmp}/vitte-$SMOKE_NAME.XXXXXX")
+  trap smoke_exit EXIT
+  trap 'exit 130' INT
+  trap 'exit 143' TERM
+  export VITTE_NO_SERVER=1
+  unset VITTE_CACHE_DIR VITTE_SERVER_SOCKET || true
+}
@@ -0,0 +1,54 @@
+#!/usr/bin/env sh
+# `build --separate-compilation` of a two-module program: a rebuild without
+# edits compiles no unit, and a body-only edit to the library recompiles only
+# the library's unit while the program's exit code stays the same.
+set -eu
+
+ROOT_DIR=$(CDPATH= cd -- "$(dirname -- "$0")/.." && pwd)
+. "$ROOT_DIR/tools/bootstrap_smoke_lib.sh"
+smoke_init bootstrap-units-smoke "${1:-$ROOT_DIR/target/bootstrap-c17/vitte-bootstrap}"
+FIXTURES=$ROOT_DIR/bootstrap/tests/import_export_coverage
+UNITS=$OUT_DIR/program.units
+EXPECTED_EXIT=15
+
+cp "$FIXTURES/multi_decl_main.vit" "$FIXTURES/multi_decl_lib.vit" "$OUT_DIR/"
+cd "$OUT_DIR"
+
+build() {
+  "$BIN" build multi_decl_main.vit -o program --separate-compilation >/dev/null ||
+    die "separate compilation build failed"
+  set +e
+  ./program
+  actual_exit=$?
+  set -e
+  [ "$actual_exit" -eq "$EXPECTED_EXIT" ] ||
+    die "program returned $actual_exit, expected $EXPECTED_EXIT"
+}
+
+# rebuilt_since <marker>: unit objects written after <marker>, by name.
+rebuilt_since() {
+  find "$UNITS" -name '*.o' -newer "$1" | sed 's|.*/||' | sort | tr '\n' ' ' | sed 's/ $//'
+}
+
+build
+[ -f "$UNITS/root.o" ] && [ -f "$UNITS/m_multi_decl_lib.o" ] ||
+  die "expected one object per module under $UNITS"
+
+sleep 1
+touch marker
+build
+rebuilt=$(rebuilt_since marker)
+[ -z "$rebuilt" ] || die "rebuild without edits recompiled: $rebuilt"
+
+# Same signature and result, different body.
+sed 's/give 4;/give 2 + 2;/' multi_decl_lib.vit >lib.tmp
+cmp -s lib.tmp multi_decl_lib.vit && die "body edit did not apply"
+mv lib.tmp multi_decl_lib.vit
+sleep 1
+touch marker
+build
+rebuilt=$(rebuilt_since marker)
+[ "$rebuilt" = "m_multi_decl_lib.o" ] ||
+  die "body-only edit recompiled '$rebuilt', expected only m_multi_decl_lib.o"
+
+printf '[bootstrap-units-smoke] OK expected_exit=%s rebuilt=%s\n' "$EXPECTED_EXIT" "$rebuilt"